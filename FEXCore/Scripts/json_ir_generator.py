@@ -86,12 +86,40 @@ class OpDefinition:
         attrs = vars(self)
         print(", ".join("%s: %s" % item for item in attrs.items()))
 
+@dataclass
+class SuperOpElement:
+    Op: OpDefinition
+    DefName: str
+    Args: list
+    UseCount: int
+
+    def __init__(self):
+        self.Op = None
+        self.DefName = None
+        self.Args = []
+        self.UseCount = 0
+        return
+
+@dataclass
+class SuperOpDefinition:
+    Op: OpDefinition
+    Elements: list
+    ResultDef: str
+
+    def __init__(self):
+        self.Op = None
+        self.Elements = []
+        self.ResultDef = None
+        return
+
 IRTypesToCXX = {}
 CXXTypeToIR = {}
 IROps = []
 
 IROpNameMap = {}
 
+SuperOps = []
+
 def is_ssa_type(type):
     if (type == "SSA" or
        type == "GPR" or
@@ -267,7 +295,130 @@ def parse_ops(ops):
                 ExitError("Duplicate Op defined! {}".format(OpDef.Name))
 
             IROps.append(OpDef)
-            IROpNameMap[OpDef.Name] = 1
+            IROpNameMap[OpDef.Name] = OpDef
+
+def find_op_argument(OpDef, Name):
+    for Arg in OpDef.Arguments:
+        if Arg.Name == Name:
+            return Arg
+    return None
+
+# Superops are fused IR ops declared together with the instruction pattern they
+# replace. The op itself goes through the standard op parsing so it picks up
+# structs, emitter helpers, printers and JIT dispatch like a hand-written op.
+# The pattern additionally generates a matching and a fusing helper consumed by
+# the superop fusion pass, so a new fusion is a declaration plus the backend
+# lowering and nothing else.
+#
+# Pattern elements name an existing op plus constraints on its stored fields:
+#   $Name   - binds the field to the superop argument of that name. The first
+#             occurrence captures the value, later occurrences must compare equal.
+#   #Name   - same, for temporary (emitter call time) superop arguments.
+#             Only valid against the special "Size" field (IROp_Header::Size).
+#   %name   - the field must be the SSA value produced by the earlier pattern
+#             element that declared "Def": "name".
+#   Invalid - the field must hold an invalid (unset) SSA reference.
+#   others  - literal C++ expression the field must compare equal to.
+def parse_superops(superops):
+    for op_class, opslist in superops.items():
+        if op_class == "Docs":
+            continue
+
+        parse_ops({op_class: opslist})
+
+        for op, op_val in opslist.items():
+            if "Ignore" in op_val:
+                continue
+
+            Name = op.split("=", 1)[-1].strip().split(" ", 1)[0]
+            OpDef = IROpNameMap[Name]
+
+            if not "Pattern" in op_val:
+                ExitError("Superop {} is missing its Pattern".format(Name))
+
+            SuperOp = SuperOpDefinition()
+            SuperOp.Op = OpDef
+            SuperOp.ResultDef = op_val.get("Result")
+
+            DefNames = {}
+            BoundArgs = {}
+
+            for Element in op_val["Pattern"]:
+                if not "Op" in Element:
+                    ExitError("Superop {} has a pattern element without an op name".format(Name))
+
+                PatName = Element["Op"]
+                if not PatName in IROpNameMap:
+                    ExitError("Superop {} pattern references unknown op {}".format(Name, PatName))
+
+                Elem = SuperOpElement()
+                Elem.Op = IROpNameMap[PatName]
+                if Elem.Op is OpDef:
+                    ExitError("Superop {} can't match itself".format(Name))
+
+                Elem.DefName = Element.get("Def")
+                if Elem.DefName != None:
+                    if not Elem.Op.HasDest:
+                        ExitError("Superop {} pattern op {} has no destination to bind def %{} to".format(Name, PatName, Elem.DefName))
+                    if Elem.DefName in DefNames:
+                        ExitError("Superop {} declares def %{} twice".format(Name, Elem.DefName))
+                    DefNames[Elem.DefName] = Elem
+
+                for Field, Binding in Element.get("Args", {}).items():
+                    FieldArg = None
+                    if Field != "Size":
+                        FieldArg = find_op_argument(Elem.Op, Field)
+                        if FieldArg == None or FieldArg.Temporary:
+                            ExitError("Superop {} pattern op {} has no stored argument {}".format(Name, PatName, Field))
+
+                    if Binding[0] == "$" or Binding[0] == "#":
+                        BindArg = find_op_argument(OpDef, Binding[1:])
+                        if BindArg == None:
+                            ExitError("Superop {} binds {} but has no such argument".format(Name, Binding))
+                        if (Binding[0] == "#") != BindArg.Temporary:
+                            ExitError("Superop {} argument binding {} has the wrong prefix for its storage".format(Name, Binding))
+                        if BindArg.Temporary and Field != "Size":
+                            ExitError("Superop {} temporary argument {} can only bind the Size field".format(Name, Binding))
+                        if not BindArg.Temporary and Field == "Size":
+                            ExitError("Superop {} stored argument {} can't bind a header size".format(Name, Binding))
+                        if not Binding[1:] in BoundArgs:
+                            BoundArgs[Binding[1:]] = (Elem, Field)
+                    elif Binding[0] == "%":
+                        if Field == "Size" or not FieldArg.IsSSA:
+                            ExitError("Superop {} binds def {} to non-SSA field {}".format(Name, Binding, Field))
+                        if not Binding[1:] in DefNames:
+                            ExitError("Superop {} references def {} before its defining element".format(Name, Binding))
+                        DefNames[Binding[1:]].UseCount = DefNames[Binding[1:]].UseCount + 1
+
+                    Elem.Args.append((Field, Binding))
+
+                SuperOp.Elements.append(Elem)
+
+            if len(SuperOp.Elements) < 2:
+                ExitError("Superop {} needs at least two pattern elements to fuse".format(Name))
+
+            for Arg in OpDef.Arguments:
+                if not Arg.Name in BoundArgs:
+                    ExitError("Superop {} argument {} is never bound by the pattern".format(Name, Arg.Name))
+
+            if OpDef.HasDest and SuperOp.ResultDef == None:
+                ExitError("Superop {} has a destination but no Result def".format(Name))
+            if SuperOp.ResultDef != None and not SuperOp.ResultDef in DefNames:
+                ExitError("Superop {} Result names unknown def %{}".format(Name, SuperOp.ResultDef))
+
+            for DefName, Elem in DefNames.items():
+                if DefName != SuperOp.ResultDef and Elem.UseCount == 0:
+                    ExitError("Superop {} def %{} is never consumed by the pattern".format(Name, DefName))
+
+            SuperOp.BoundArgs = BoundArgs
+            SuperOps.append(SuperOp)
+
+    # Keep the Last sentinel terminating the enum no matter what order the
+    # superop declarations appended their fused ops in.
+    for i in range(len(IROps)):
+        if IROps[i].Name == "Last":
+            IROps.append(IROps.pop(i))
+            break
 
 # Print out enum values
 def print_enums():
@@ -758,6 +909,185 @@ def print_ir_parser_switch_helper():
     output_file.write("#undef IROP_PARSER_SWITCH_HELPERS\n")
     output_file.write("#endif\n")
 
+# Per-element match checks and bind commits. Checks gate accepting a candidate
+# op, commits only run once every check on the element passed.
+def superop_element_checks(SuperOp, Elem):
+    checks = []
+    commits = []
+    for Field, Binding in Elem.Args:
+        access = "Op->Header.Size" if Field == "Size" else "Op->{}".format(Field)
+        if Binding[0] == "$" or Binding[0] == "#":
+            ArgName = Binding[1:]
+            Source = SuperOp.BoundArgs[ArgName]
+            if Source[0] is Elem and Source[1] == Field:
+                commits.append("Bind_{} = {};".format(ArgName, access))
+            else:
+                checks.append("{} == Bind_{}".format(access, ArgName))
+        elif Binding[0] == "%":
+            checks.append("{} == Def_{}".format(access, Binding[1:]))
+        elif Binding == "Invalid":
+            checks.append("{}.IsInvalid()".format(access))
+        else:
+            checks.append("{} == {}".format(access, Binding))
+    return checks, commits
+
+def print_superop_helpers():
+    output_file.write("#ifdef IROP_SUPEROP_HELPERS\n")
+
+    for SuperOp in SuperOps:
+        Op = SuperOp.Op
+        NumElements = len(SuperOp.Elements)
+        ResultIndex = -1
+        for i in range(NumElements):
+            if SuperOp.Elements[i].DefName != None and SuperOp.Elements[i].DefName == SuperOp.ResultDef:
+                ResultIndex = i
+
+        output_file.write("// Generated from the {} superop declaration in IR.json\n".format(Op.Name))
+        output_file.write("struct SuperOpMatch_{} {{\n".format(Op.Name))
+        output_file.write("\tOrderedNode *MatchedOps[{}];\n".format(NumElements))
+        output_file.write("};\n\n")
+
+        # Matcher. Iter points at the candidate for the first pattern element,
+        # later elements are scanned for over side-effect free gaps.
+        output_file.write("static bool MatchSuperOp_{}(IRListView &CurrentIR, NodeIterator Iter, NodeIterator End, SuperOpMatch_{} &Match) {{\n".format(Op.Name, Op.Name))
+
+        for Arg in Op.Arguments:
+            if Arg.Temporary:
+                output_file.write("\tuint8_t Bind_{} {{}};\n".format(Arg.Name))
+            elif Arg.IsSSA:
+                output_file.write("\tOrderedNodeWrapper Bind_{} {{}};\n".format(Arg.Name))
+            else:
+                output_file.write("\t{} Bind_{} {{}};\n".format(IRTypesToCXX[Arg.Type].CXXName, Arg.Name))
+
+        for Elem in SuperOp.Elements:
+            if Elem.DefName != None:
+                output_file.write("\tOrderedNodeWrapper Def_{} {{}};\n".format(Elem.DefName))
+
+        output_file.write("\n")
+
+        for Index in range(NumElements):
+            Elem = SuperOp.Elements[Index]
+            checks, commits = superop_element_checks(SuperOp, Elem)
+            cond = " &&\n\t\t\t    ".join(checks) if len(checks) else "true"
+            NeedsCast = len(Elem.Args) != 0
+
+            if Index == 0:
+                output_file.write("\t{\n")
+                output_file.write("\t\tauto [CodeNode, IROp] = Iter();\n")
+                output_file.write("\t\tif (IROp->Op != OP_{}) {{\n".format(Elem.Op.Name.upper()))
+                output_file.write("\t\t\treturn false;\n")
+                output_file.write("\t\t}\n")
+                if NeedsCast:
+                    output_file.write("\t\tauto Op = IROp->C<IROp_{}>();\n".format(Elem.Op.Name))
+                if len(checks):
+                    output_file.write("\t\tif (!({})) {{\n".format(cond))
+                    output_file.write("\t\t\treturn false;\n")
+                    output_file.write("\t\t}\n")
+                for commit in commits:
+                    output_file.write("\t\t{}\n".format(commit))
+                output_file.write("\t\tMatch.MatchedOps[0] = CodeNode;\n")
+                if Elem.DefName != None:
+                    output_file.write("\t\tDef_{} = CurrentIR.WrapNode(CodeNode);\n".format(Elem.DefName))
+                output_file.write("\t}\n\n")
+            else:
+                DefsSoFar = [E.DefName for E in SuperOp.Elements[:Index] if E.DefName != None]
+                output_file.write("\tfor (;;) {\n")
+                output_file.write("\t\t++Iter;\n")
+                output_file.write("\t\tif (!(Iter != End)) {\n")
+                output_file.write("\t\t\treturn false;\n")
+                output_file.write("\t\t}\n")
+                output_file.write("\t\tauto [CodeNode, IROp] = Iter();\n")
+                output_file.write("\t\tif (IROp->Op == OP_{}) {{\n".format(Elem.Op.Name.upper()))
+                if NeedsCast:
+                    output_file.write("\t\t\tauto Op = IROp->C<IROp_{}>();\n".format(Elem.Op.Name))
+                output_file.write("\t\t\tif ({}) {{\n".format(cond))
+                for commit in commits:
+                    output_file.write("\t\t\t\t{}\n".format(commit))
+                output_file.write("\t\t\t\tMatch.MatchedOps[{}] = CodeNode;\n".format(Index))
+                if Elem.DefName != None:
+                    output_file.write("\t\t\t\tDef_{} = CurrentIR.WrapNode(CodeNode);\n".format(Elem.DefName))
+                output_file.write("\t\t\t\tbreak;\n")
+                output_file.write("\t\t\t}\n")
+                output_file.write("\t\t}\n")
+                output_file.write("\t\t// Anything with side effects can order against the matched ops.\n")
+                output_file.write("\t\tif (HasSideEffects(IROp->Op)) {\n")
+                output_file.write("\t\t\treturn false;\n")
+                output_file.write("\t\t}\n")
+                if len(DefsSoFar):
+                    output_file.write("\t\t// A skipped consumer of a matched def would end up ahead of the\n")
+                    output_file.write("\t\t// fused op that replaces it.\n")
+                    output_file.write("\t\tconst uint8_t NumArgs = GetArgs(IROp->Op);\n")
+                    output_file.write("\t\tfor (uint8_t Arg = 0; Arg < NumArgs; ++Arg) {\n")
+                    DefCond = " || ".join(["IROp->Args[Arg] == Def_{}".format(DefName) for DefName in DefsSoFar])
+                    output_file.write("\t\t\tif ({}) {{\n".format(DefCond))
+                    output_file.write("\t\t\t\treturn false;\n")
+                    output_file.write("\t\t\t}\n")
+                    output_file.write("\t\t}\n")
+                output_file.write("\t}\n\n")
+
+        for Elem in SuperOp.Elements:
+            if Elem.DefName == None or Elem.DefName == SuperOp.ResultDef:
+                continue
+            output_file.write("\t// %{} dies with the pattern, external consumers would be left dangling.\n".format(Elem.DefName))
+            output_file.write("\tif (CurrentIR.GetNode(Def_{})->GetUses() != {}) {{\n".format(Elem.DefName, Elem.UseCount))
+            output_file.write("\t\treturn false;\n")
+            output_file.write("\t}\n")
+
+        output_file.write("\treturn true;\n")
+        output_file.write("}\n\n")
+
+        # Fuser. Emits the fused op at the last matched op's position and
+        # removes the pattern, consumers before producers.
+        CastIndices = []
+        for ArgName, Source in SuperOp.BoundArgs.items():
+            Index = SuperOp.Elements.index(Source[0])
+            if not Index in CastIndices:
+                CastIndices.append(Index)
+        CastIndices.sort()
+
+        output_file.write("static OrderedNode *FuseSuperOp_{}(IREmitter *IREmit, IRListView &CurrentIR, const SuperOpMatch_{} &Match) {{\n".format(Op.Name, Op.Name))
+        for Index in CastIndices:
+            output_file.write("\tauto Op{} = CurrentIR.GetOp<IROp_{}>(Match.MatchedOps[{}]);\n".format(Index, SuperOp.Elements[Index].Op.Name, Index))
+        output_file.write("\tIREmit->SetWriteCursor(Match.MatchedOps[{}]);\n".format(NumElements - 1))
+
+        ArgExprs = []
+        for Arg in Op.Arguments:
+            Source = SuperOp.BoundArgs[Arg.Name]
+            Index = SuperOp.Elements.index(Source[0])
+            access = "Op{}->Header.Size".format(Index) if Source[1] == "Size" else "Op{}->{}".format(Index, Source[1])
+            if Arg.Temporary:
+                ArgExprs.append("static_cast<{}>({})".format(IRTypesToCXX[Arg.Type].CXXName, access))
+            elif Arg.IsSSA:
+                ArgExprs.append("CurrentIR.GetNode({})".format(access))
+            else:
+                ArgExprs.append(access)
+
+        output_file.write("\tOrderedNode *Fused = IREmit->_{}({});\n".format(Op.Name, ", ".join(ArgExprs)))
+
+        if Op.HasDest:
+            output_file.write("\t// ReplaceAllUsesWith removes a side-effect free op once its uses hit\n")
+            output_file.write("\t// zero, so the result producer needs no explicit Remove below.\n")
+            output_file.write("\tIREmit->ReplaceAllUsesWith(Match.MatchedOps[{}], Fused);\n".format(ResultIndex))
+
+        for Index in reversed(range(NumElements)):
+            if Op.HasDest and Index == ResultIndex and not SuperOp.Elements[Index].Op.HasSideEffects:
+                continue
+            output_file.write("\tIREmit->Remove(Match.MatchedOps[{}]);\n".format(Index))
+
+        output_file.write("\treturn Fused;\n")
+        output_file.write("}\n\n")
+
+    output_file.write("// X-macro over the declared superops, drives the fusion pass dispatch.\n")
+    if len(SuperOps):
+        output_file.write("#define FOREACH_SUPEROP(HANDLE) \\\n")
+        output_file.write(" \\\n".join(["\tHANDLE({})".format(SuperOp.Op.Name) for SuperOp in SuperOps]))
+        output_file.write("\n")
+    else:
+        output_file.write("#define FOREACH_SUPEROP(HANDLE)\n")
+
+    output_file.write("#undef IROP_SUPEROP_HELPERS\n")
+    output_file.write("#endif\n\n")
+
 def print_ir_dispatcher_defs():
     output_dispatch_file.write("#ifdef IROP_DISPATCH_DEFS\n")
     for op in IROps:
@@ -803,6 +1133,7 @@ defines = json_object["DEFINES"]
 
 parse_irtypes(irtypes)
 parse_ops(ops)
+parse_superops(json_object.get("SUPEROPS", {}))
 
 output_file = open(output_filename, "w")
 
@@ -817,6 +1148,7 @@ print_ir_gethasdest()
 print_ir_arg_printer()
 print_ir_allocator_helpers()
 print_ir_parser_switch_helper()
+print_superop_helpers()
 
 output_file.close()
 
@@ -1,12 +1,58 @@
 // SPDX-License-Identifier: MIT
+#include <FEXCore/Utils/AllocatorHooks.h>
 #include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/vector.h>
 
 #include "Common/JitSymbols.h"
 
+#include <cstring>
+#include <elf.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace FEXCore {
+  // perf jitdump format, consumed by `perf inject --jit`.
+  // See tools/perf/Documentation/jitdump-specification.txt in the kernel tree.
+  namespace JITDump {
+    constexpr uint32_t MAGIC = 0x4A695444; // "JiTD"
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t JIT_CODE_LOAD = 0;
+
+    struct FileHeader {
+      uint32_t Magic;
+      uint32_t Version;
+      uint32_t TotalSize;
+      uint32_t ELFMach;
+      uint32_t Pad1;
+      uint32_t PID;
+      uint64_t Timestamp;
+      uint64_t Flags;
+    };
+
+    struct CodeLoadRecord {
+      uint32_t ID;
+      uint32_t TotalSize;
+      uint64_t Timestamp;
+      uint32_t PID;
+      uint32_t TID;
+      uint64_t VMA;
+      uint64_t CodeAddr;
+      uint64_t CodeSize;
+      uint64_t CodeIndex;
+      // Followed by the nul-terminated symbol name and the code bytes
+    };
+
+    // Timestamps must match the clock perf records with (`perf record -k mono`)
+    static uint64_t Timestamp() {
+      struct timespec ts{};
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+    }
+  }
+
   JITSymbols::JITSymbols() {
   }
 
@@ -14,6 +60,12 @@ namespace FEXCore {
     if (fd != -1) {
       close(fd);
     }
+    if (JITDumpMarker) {
+      FEXCore::Allocator::munmap(JITDumpMarker, sysconf(_SC_PAGESIZE));
+    }
+    if (jitdump_fd != -1) {
+      close(jitdump_fd);
+    }
   }
 
   void JITSymbols::InitFile() {
@@ -27,7 +79,83 @@ namespace FEXCore {
     fd = open(PerfMap.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0644);
   }
 
+  void JITSymbols::InitJITDump() {
+#ifdef __ANDROID__
+    const auto DumpPath = fextl::fmt::format("/data/local/tmp/jit-{}.dump", getpid());
+#else
+    const auto DumpPath = fextl::fmt::format("/tmp/jit-{}.dump", getpid());
+#endif
+    // Needs to be readable as well since the file gets mapped executable below
+    jitdump_fd = open(DumpPath.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (jitdump_fd == -1) {
+      return;
+    }
+
+    JITDumpPID = getpid();
+
+    JITDump::FileHeader Header {
+      .Magic = JITDump::MAGIC,
+      .Version = JITDump::VERSION,
+      .TotalSize = sizeof(JITDump::FileHeader),
+#ifdef _M_ARM_64
+      .ELFMach = EM_AARCH64,
+#else
+      .ELFMach = EM_X86_64,
+#endif
+      .Pad1 = 0,
+      .PID = JITDumpPID,
+      .Timestamp = JITDump::Timestamp(),
+      .Flags = 0,
+    };
+
+    if (write(jitdump_fd, &Header, sizeof(Header)) != sizeof(Header)) {
+      close(jitdump_fd);
+      jitdump_fd = -1;
+      return;
+    }
+
+    // perf inject discovers the jitdump file through an executable mapping of
+    // it showing up in the mmap events of the recording.
+    JITDumpMarker = FEXCore::Allocator::mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, jitdump_fd, 0);
+    if (JITDumpMarker == MAP_FAILED) {
+      JITDumpMarker = nullptr;
+      close(jitdump_fd);
+      jitdump_fd = -1;
+    }
+  }
+
+  void JITSymbols::WriteJITDumpRecord(const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+    JITDump::CodeLoadRecord Record {
+      .ID = JITDump::JIT_CODE_LOAD,
+      .TotalSize = static_cast<uint32_t>(sizeof(Record) + Name.size() + 1 + CodeSize),
+      .Timestamp = JITDump::Timestamp(),
+      .PID = JITDumpPID,
+      .TID = static_cast<uint32_t>(::syscall(SYS_gettid)),
+      .VMA = reinterpret_cast<uint64_t>(HostAddr),
+      .CodeAddr = reinterpret_cast<uint64_t>(HostAddr),
+      .CodeSize = CodeSize,
+      .CodeIndex = JITDumpCodeIndex.fetch_add(1, std::memory_order_relaxed),
+    };
+
+    // Assembled up front so the record hits the file in one write, keeping
+    // records from multiple compile threads from interleaving.
+    fextl::vector<uint8_t> Buffer(Record.TotalSize);
+    memcpy(Buffer.data(), &Record, sizeof(Record));
+    memcpy(Buffer.data() + sizeof(Record), Name.data(), Name.size());
+    Buffer[sizeof(Record) + Name.size()] = 0;
+    memcpy(Buffer.data() + sizeof(Record) + Name.size() + 1, HostAddr, CodeSize);
+
+    auto Result = write(jitdump_fd, Buffer.data(), Buffer.size());
+    if (Result == -1 && errno == EBADF) {
+      jitdump_fd = -1;
+    }
+  }
+
   void JITSymbols::RegisterNamedRegion(const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+    if (jitdump_fd != -1) {
+      WriteJITDumpRecord(HostAddr, CodeSize, Name);
+    }
+
     if (fd == -1) return;
 
     // Linux perf format is very straightforward
@@ -40,6 +168,9 @@ namespace FEXCore {
   }
 
   void JITSymbols::RegisterJITSpace(const void *HostAddr, uint32_t CodeSize) {
+    // The JIT space is only registered as a fallback region for the perf map.
+    // Individual blocks cover it in the jitdump, and code bytes for the whole
+    // space would bloat the file for no attribution benefit.
     if (fd == -1) return;
 
     // Linux perf format is very straightforward
@@ -53,69 +184,84 @@ namespace FEXCore {
 
   // Buffered JIT symbols.
   void JITSymbols::Register(Core::JITSymbolBuffer *Buffer, const void *HostAddr, uint64_t GuestAddr, uint32_t CodeSize) {
+    if (jitdump_fd != -1) {
+      WriteJITDumpRecord(HostAddr, CodeSize, fextl::fmt::format("JIT_0x{:x}", GuestAddr));
+    }
+
     if (fd == -1) return;
 
-    // Calculate remaining sizes.
-    const auto RemainingSize = Buffer->BUFFER_SIZE - Buffer->Offset;
-    const auto CurrentBufferOffset = &Buffer->Buffer[Buffer->Offset];
+    while (true) {
+      // Calculate remaining sizes.
+      const auto RemainingSize = Buffer->BUFFER_SIZE - Buffer->Offset;
+      const auto CurrentBufferOffset = &Buffer->Buffer[Buffer->Offset];
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto FMTResult = fmt::format_to_n(CurrentBufferOffset, RemainingSize, "{} {:x} JIT_0x{:x}_{}\n", HostAddr, CodeSize, GuestAddr, HostAddr);
-    if (FMTResult.out >= &Buffer->Buffer[Buffer->BUFFER_SIZE]) {
-      // Couldn't fit, need to force a write.
-      WriteBuffer(Buffer, true);
-      // Rerun
-      Register(Buffer, HostAddr, GuestAddr, CodeSize);
-      return;
-    }
+      // Linux perf format is very straightforward
+      // `<HostPtr> <Size> <Name>\n`
+      const auto FMTResult = fmt::format_to_n(CurrentBufferOffset, RemainingSize, "{} {:x} JIT_0x{:x}_{}\n", HostAddr, CodeSize, GuestAddr, HostAddr);
+      if (FMTResult.out >= &Buffer->Buffer[Buffer->BUFFER_SIZE]) {
+        // Couldn't fit, need to force a write and rerun.
+        WriteBuffer(Buffer, true);
+        continue;
+      }
 
-    Buffer->Offset += FMTResult.size;
-    WriteBuffer(Buffer);
+      Buffer->Offset += FMTResult.size;
+      WriteBuffer(Buffer);
+      break;
+    }
   }
 
   void JITSymbols::Register(Core::JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name, uintptr_t Offset) {
+    if (jitdump_fd != -1) {
+      WriteJITDumpRecord(HostAddr, CodeSize, fextl::fmt::format("{}+0x{:x}", Name, Offset));
+    }
+
     if (fd == -1) return;
 
-    // Calculate remaining sizes.
-    const auto RemainingSize = Buffer->BUFFER_SIZE - Buffer->Offset;
-    const auto CurrentBufferOffset = &Buffer->Buffer[Buffer->Offset];
+    while (true) {
+      // Calculate remaining sizes.
+      const auto RemainingSize = Buffer->BUFFER_SIZE - Buffer->Offset;
+      const auto CurrentBufferOffset = &Buffer->Buffer[Buffer->Offset];
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto FMTResult = fmt::format_to_n(CurrentBufferOffset, RemainingSize, "{} {:x} {}+0x{:x} ({})\n", HostAddr, CodeSize, Name, Offset, HostAddr);
-    if (FMTResult.out >= &Buffer->Buffer[Buffer->BUFFER_SIZE]) {
-      // Couldn't fit, need to force a write.
-      WriteBuffer(Buffer, true);
-      // Rerun
-      Register(Buffer, HostAddr, CodeSize, Name, Offset);
-      return;
-    }
+      // Linux perf format is very straightforward
+      // `<HostPtr> <Size> <Name>\n`
+      const auto FMTResult = fmt::format_to_n(CurrentBufferOffset, RemainingSize, "{} {:x} {}+0x{:x} ({})\n", HostAddr, CodeSize, Name, Offset, HostAddr);
+      if (FMTResult.out >= &Buffer->Buffer[Buffer->BUFFER_SIZE]) {
+        // Couldn't fit, need to force a write and rerun.
+        WriteBuffer(Buffer, true);
+        continue;
+      }
 
-    Buffer->Offset += FMTResult.size;
-    WriteBuffer(Buffer);
+      Buffer->Offset += FMTResult.size;
+      WriteBuffer(Buffer);
+      break;
+    }
   }
 
   void JITSymbols::RegisterNamedRegion(Core::JITSymbolBuffer *Buffer, const void *HostAddr, uint32_t CodeSize, std::string_view Name) {
+    if (jitdump_fd != -1) {
+      WriteJITDumpRecord(HostAddr, CodeSize, Name);
+    }
+
     if (fd == -1) return;
 
-    // Calculate remaining sizes.
-    const auto RemainingSize = Buffer->BUFFER_SIZE - Buffer->Offset;
-    const auto CurrentBufferOffset = &Buffer->Buffer[Buffer->Offset];
+    while (true) {
+      // Calculate remaining sizes.
+      const auto RemainingSize = Buffer->BUFFER_SIZE - Buffer->Offset;
+      const auto CurrentBufferOffset = &Buffer->Buffer[Buffer->Offset];
 
-    // Linux perf format is very straightforward
-    // `<HostPtr> <Size> <Name>\n`
-    const auto FMTResult = fmt::format_to_n(CurrentBufferOffset, RemainingSize, "{} {:x} {}\n", HostAddr, CodeSize, Name);
-    if (FMTResult.out >= &Buffer->Buffer[Buffer->BUFFER_SIZE]) {
-      // Couldn't fit, need to force a write.
-      WriteBuffer(Buffer, true);
-      // Rerun
-      RegisterNamedRegion(Buffer, HostAddr, CodeSize, Name);
-      return;
-    }
+      // Linux perf format is very straightforward
+      // `<HostPtr> <Size> <Name>\n`
+      const auto FMTResult = fmt::format_to_n(CurrentBufferOffset, RemainingSize, "{} {:x} {}\n", HostAddr, CodeSize, Name);
+      if (FMTResult.out >= &Buffer->Buffer[Buffer->BUFFER_SIZE]) {
+        // Couldn't fit, need to force a write and rerun.
+        WriteBuffer(Buffer, true);
+        continue;
+      }
 
-    Buffer->Offset += FMTResult.size;
-    WriteBuffer(Buffer);
+      Buffer->Offset += FMTResult.size;
+      WriteBuffer(Buffer);
+      break;
+    }
   }
 
   void JITSymbols::WriteBuffer(Core::JITSymbolBuffer *Buffer, bool ForceWrite) {
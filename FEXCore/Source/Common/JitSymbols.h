@@ -4,6 +4,7 @@
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/Debug/InternalThreadState.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <cstdio>
@@ -17,6 +18,7 @@ public:
   ~JITSymbols();
 
   void InitFile();
+  void InitJITDump();
   void RegisterNamedRegion(const void *HostAddr, uint32_t CodeSize, std::string_view Name);
   void RegisterJITSpace(const void *HostAddr, uint32_t CodeSize);
 
@@ -32,5 +34,13 @@ public:
 private:
   int fd{-1};
   void WriteBuffer(Core::JITSymbolBuffer *Buffer, bool ForceWrite = false);
+
+  // perf jitdump file. Unlike the perf map this carries the host code bytes,
+  // letting `perf inject --jit` attribute samples at instruction granularity.
+  int jitdump_fd{-1};
+  uint32_t JITDumpPID{};
+  void *JITDumpMarker{};
+  std::atomic<uint64_t> JITDumpCodeIndex{};
+  void WriteJITDumpRecord(const void *HostAddr, uint32_t CodeSize, std::string_view Name);
 };
 }
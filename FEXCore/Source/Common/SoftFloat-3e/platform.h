@@ -38,6 +38,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *----------------------------------------------------------------------------*/
 #define LITTLEENDIAN 1
 
+/*----------------------------------------------------------------------------
+| Define INLINE so "opts-GCC.h" and "primitives.h" provide their inlined
+| primitives.  Without it the leading-zero count and 64x64->128 multiply
+| helpers fall back to the out-of-line table and 32-bit schoolbook versions,
+| instead of single CLZ and MUL/UMULH instruction sequences.
+*----------------------------------------------------------------------------*/
+#define INLINE static inline
+#define INLINE_LEVEL 5
+
 /*----------------------------------------------------------------------------
 *----------------------------------------------------------------------------*/
 #define SOFTFLOAT_BUILTIN_CLZ 1
@@ -406,9 +406,7 @@ struct FEX_PACKED X80SoftFloat {
 
     return Result;
 #else
-    LIBRARY_PRECISION Src_d = lhs;
-    Src_d = sinl(Src_d);
-    return Src_d;
+    return SinCosEvaluate(lhs, true);
 #endif
   }
 
@@ -429,9 +427,7 @@ struct FEX_PACKED X80SoftFloat {
 
     return Result;
 #else
-    LIBRARY_PRECISION Src_d = lhs;
-    Src_d = cosl(Src_d);
-    return Src_d;
+    return SinCosEvaluate(lhs, false);
 #endif
   }
 
@@ -590,6 +586,65 @@ private:
   static constexpr uint64_t IntegerBit = (1ULL << 63);
   static constexpr uint64_t Bottom62Significand = ((1ULL << 62) - 1);
   static constexpr uint32_t ExponentBias = 16383;
+
+  // FSINCOS reaches the fallbacks as an FSIN/FCOS pair on the same value, and
+  // the argument reduction inside the library sin/cos dominates both calls.
+  // Evaluate sine and cosine together, keeping the partner result per thread
+  // and handing it out when the matching call on the same bit pattern arrives.
+  struct SinCosCacheEntry {
+    uint64_t Significand;
+    uint32_t SignExp;
+    bool SinValid;
+    bool CosValid;
+    LIBRARY_PRECISION Sin;
+    LIBRARY_PRECISION Cos;
+  };
+  static inline thread_local SinCosCacheEntry SinCosCache {};
+
+  FEXCORE_PRESERVE_ALL_ATTR
+  static X80SoftFloat SinCosEvaluate(X80SoftFloat const &lhs, bool WantSin) {
+    const uint32_t SignExp = (lhs.Sign << 15) | lhs.Exponent;
+    auto &Cache = SinCosCache;
+
+    if (Cache.Significand == lhs.Significand && Cache.SignExp == SignExp) {
+      // Consume the cached result so a partner call with a different rounding
+      // mode still converts with its own FCW.
+      if (WantSin && Cache.SinValid) {
+        Cache.SinValid = false;
+        return Cache.Sin;
+      }
+      if (!WantSin && Cache.CosValid) {
+        Cache.CosValid = false;
+        return Cache.Cos;
+      }
+    }
+
+    LIBRARY_PRECISION Src_d = lhs;
+    LIBRARY_PRECISION SinRes;
+    LIBRARY_PRECISION CosRes;
+#ifndef _WIN32
+    long double SinTmp;
+    long double CosTmp;
+    sincosl(Src_d, &SinTmp, &CosTmp);
+    SinRes = SinTmp;
+    CosRes = CosTmp;
+#else
+    // Mingw Win32 libraries don't have the combined evaluation helper
+    SinRes = sin(Src_d);
+    CosRes = cos(Src_d);
+#endif
+
+    Cache = SinCosCacheEntry {
+      .Significand = lhs.Significand,
+      .SignExp = SignExp,
+      .SinValid = !WantSin,
+      .CosValid = WantSin,
+      .Sin = SinRes,
+      .Cos = CosRes,
+    };
+
+    return WantSin ? X80SoftFloat(SinRes) : X80SoftFloat(CosRes);
+  }
 };
 
 #ifndef _WIN32
@@ -231,6 +231,30 @@ namespace DefaultValues {
     }
   }
 
+  void ReloadFileLayers() {
+    // Only the file-backed layers can change behind a running process.
+    // Arguments and environment are fixed for the process lifetime and the
+    // meta layer is re-merged afterwards through ReloadMetaLayer.
+    constexpr static std::array<FEXCore::Config::LayerType, 6> FileLayers = {
+      FEXCore::Config::LayerType::LAYER_GLOBAL_MAIN,
+      FEXCore::Config::LayerType::LAYER_MAIN,
+      FEXCore::Config::LayerType::LAYER_GLOBAL_STEAM_APP,
+      FEXCore::Config::LayerType::LAYER_GLOBAL_APP,
+      FEXCore::Config::LayerType::LAYER_LOCAL_STEAM_APP,
+      FEXCore::Config::LayerType::LAYER_LOCAL_APP,
+    };
+
+    for (auto LayerType : FileLayers) {
+      auto it = ConfigLayers.find(LayerType);
+      if (it != ConfigLayers.end()) {
+        it->second->Clear();
+        it->second->Load();
+      }
+    }
+
+    ReloadMetaLayer();
+  }
+
   fextl::string ExpandPath(fextl::string const &ContainerPrefix, fextl::string PathName) {
     if (PathName.empty()) {
       return {};
@@ -16,7 +16,9 @@
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/SignalScopeGuards.h>
+#include <FEXCore/fextl/deque.h>
 #include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/robin_map.h>
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_map.h>
@@ -24,7 +26,9 @@
 #include <FEXHeaderUtils/Syscalls.h>
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <istream>
@@ -36,6 +40,7 @@
 
 namespace FEXCore {
 class CodeLoader;
+class PMUTuner;
 class ThunkHandler;
 
 namespace CodeSerialize {
@@ -46,6 +51,9 @@ namespace CPU {
   class Arm64JITCore;
   class Dispatcher;
 }
+namespace Frontend {
+  struct DecodeCache;
+}
 namespace HLE {
 struct SyscallArguments;
 class SyscallHandler;
@@ -82,6 +90,7 @@ namespace FEXCore::Context {
 
       void CompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) override;
       void CompileRIPCount(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t MaxInst) override;
+      void PretranslateRIP(uint64_t GuestRIP) override;
 
       void SetCustomCPUBackendFactory(CustomCPUFactoryType Factory) override;
 
@@ -90,6 +99,7 @@ namespace FEXCore::Context {
       void HandleCallback(FEXCore::Core::InternalThreadState *Thread, uint64_t RIP) override;
 
       uint64_t RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) override;
+      void RecordTSOFaultBackpatch(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) override;
       uint32_t ReconstructCompactedEFLAGS(FEXCore::Core::InternalThreadState *Thread, bool WasInJIT, uint64_t *HostGPRs, uint64_t PSTATE) override;
       void SetFlagsFromCompactedEFLAGS(FEXCore::Core::InternalThreadState *Thread, uint32_t EFLAGS) override;
 
@@ -126,6 +136,12 @@ namespace FEXCore::Context {
       // Public for threading
       void ExecutionThread(FEXCore::Core::InternalThreadState *Thread) override;
 
+      // Public for threading
+      void SpeculativeCompilerThread();
+
+      // Public for threading
+      void RSSGovernorThread();
+
       /**
        * @brief Destroys this FEX thread object and stops tracking it internally
        *
@@ -156,6 +172,9 @@ namespace FEXCore::Context {
       void SetAOTIRRenamer(AOTIRRenamerCBFn CacheRenamer) override {
         IRCaptureCache.SetAOTIRRenamer(std::move(CacheRenamer));
       }
+      void SetLibraryPriorityQuery(LibraryPriorityCBFn Query) override {
+        IRCaptureCache.SetLibraryPriorityQuery(std::move(Query));
+      }
 
       void FinalizeAOTIRCache() override {
         IRCaptureCache.FinalizeAOTIRCache();
@@ -163,12 +182,17 @@ namespace FEXCore::Context {
       void WriteFilesWithCode(AOTIRCodeFileWriterFn Writer) override {
         IRCaptureCache.WriteFilesWithCode(Writer);
       }
+      int32_t GetTunedTraceBudget() const override;
+      int64_t GetTunerSessionScore() const override;
 
       void ClearCodeCache(FEXCore::Core::InternalThreadState *Thread) override;
       void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) override;
       void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn callback) override;
       void MarkMemoryShared(FEXCore::Core::InternalThreadState *Thread) override;
 
+      bool SetGuestWatchpoint(uint64_t Address, uint64_t Size, FEXCore::Context::WatchpointType Type) override;
+      bool ClearGuestWatchpoint(uint64_t Address, uint64_t Size) override;
+
       void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress) override;
       // returns false if a handler was already registered
       CustomIRResult AddCustomIREntrypoint(uintptr_t Entrypoint, CustomIREntrypointHandler Handler, void *Creator = nullptr, void *Data = nullptr);
@@ -194,11 +218,19 @@ namespace FEXCore::Context {
       bool NeedsPendingInterruptFaultCheck { false };
 
       FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+      FEX_CONFIG_OPT(TieredCompilation, TIEREDCOMPILATION);
+      FEX_CONFIG_OPT(SharedCodeCache, SHAREDCODECACHE);
+      FEX_CONFIG_OPT(SpeculativeCompilation, SPECULATIVECOMPILATION);
+      FEX_CONFIG_OPT(ShadowValidation, SHADOWVALIDATION);
       FEX_CONFIG_OPT(SingleStepConfig, SINGLESTEP);
+      FEX_CONFIG_OPT(CompileTimeTelemetry, COMPILETIMETELEMETRY);
+      FEX_CONFIG_OPT(FlightRecorderSampleInterval, FLIGHTRECORDERSAMPLEINTERVAL);
+      FEX_CONFIG_OPT(AuxiliaryThreadAffinity, AUXILIARYTHREADAFFINITY);
       FEX_CONFIG_OPT(GdbServer, GDBSERVER);
       FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
       FEX_CONFIG_OPT(TSOEnabled, TSOENABLED);
       FEX_CONFIG_OPT(TSOAutoMigration, TSOAUTOMIGRATION);
+      FEX_CONFIG_OPT(FramePointerTSOEnabled, FRAMEPOINTERTSOENABLED);
       FEX_CONFIG_OPT(ABILocalFlags, ABILOCALFLAGS);
       FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
       FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
@@ -206,6 +238,12 @@ namespace FEXCore::Context {
       FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
       FEX_CONFIG_OPT(Core, CORE);
       FEX_CONFIG_OPT(MaxInstPerBlock, MAXINST);
+      FEX_CONFIG_OPT(MultiblockTraceInst, MULTIBLOCKTRACEINST);
+      FEX_CONFIG_OPT(MultiblockLoopRange, MULTIBLOCKLOOPRANGE);
+      FEX_CONFIG_OPT(InlineLeafCalls, INLINELEAFCALLS);
+      FEX_CONFIG_OPT(PMUTuning, PMUTUNING);
+      FEX_CONFIG_OPT(HeterogeneousTuning, HETEROGENEOUSTUNING);
+      FEX_CONFIG_OPT(DecodeCache, DECODECACHE);
       FEX_CONFIG_OPT(RootFSPath, ROOTFS);
       FEX_CONFIG_OPT(ThunkHostLibsPath, THUNKHOSTLIBS);
       FEX_CONFIG_OPT(ThunkHostLibsPath32, THUNKHOSTLIBS32);
@@ -214,11 +252,18 @@ namespace FEXCore::Context {
       FEX_CONFIG_OPT(GlobalJITNaming, GLOBALJITNAMING);
       FEX_CONFIG_OPT(LibraryJITNaming, LIBRARYJITNAMING);
       FEX_CONFIG_OPT(BlockJITNaming, BLOCKJITNAMING);
+      FEX_CONFIG_OPT(JITDump, JITDUMP);
+      FEX_CONFIG_OPT(NUMALocalPlacement, NUMALOCALPLACEMENT);
+      FEX_CONFIG_OPT(CoopPreempt, COOPPREEMPT);
+      FEX_CONFIG_OPT(HugePageJITBuffers, HUGEPAGEJITBUFFERS);
       FEX_CONFIG_OPT(GDBSymbols, GDBSYMBOLS);
       FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
       FEX_CONFIG_OPT(CacheObjectCodeCompilation, CACHEOBJECTCODECOMPILATION);
       FEX_CONFIG_OPT(x87ReducedPrecision, X87REDUCEDPRECISION);
       FEX_CONFIG_OPT(DisableTelemetry, DISABLETELEMETRY);
+      FEX_CONFIG_OPT(CallGraphExport, CALLGRAPHEXPORT);
+      FEX_CONFIG_OPT(RSSLimit, RSSLIMIT);
+      FEX_CONFIG_OPT(BootProfileReplay, BOOTPROFILEREPLAY);
       FEX_CONFIG_OPT(DisableVixlIndirectCalls, DISABLE_VIXL_INDIRECT_RUNTIME_CALLS);
     } Config;
 
@@ -227,6 +272,46 @@ namespace FEXCore::Context {
 
     FEXCore::ForkableSharedMutex CodeInvalidationMutex;
 
+    // Global journal of invalidated guest code ranges. An invalidating thread
+    // appends here and scrubs only its own caches; every other thread catches
+    // up lazily at its next dispatcher entry by replaying the entries it
+    // hasn't seen yet. Steady state with no SMC costs one epoch load.
+    struct CodeInvalidationJournal {
+      struct Entry {
+        uint64_t Start;
+        uint64_t Length;
+      };
+      // Bounds a lagging thread's catch-up work. Anything further behind than
+      // a full ring resynchronizes with a lookup cache clear instead of
+      // replaying history the ring no longer holds.
+      constexpr static size_t NumEntries = 128;
+      std::array<Entry, NumEntries> Ring;
+      // Count of entries ever appended. Slots are written before the epoch
+      // advances, and replaying readers hold CodeInvalidationMutex at least
+      // shared while appenders hold it unique, so slot reads are stable.
+      std::atomic<uint64_t> Epoch{};
+    };
+    CodeInvalidationJournal InvalidationJournal;
+
+    // Pages whose code has ever been invalidated while live. Exits that
+    // branch into one of these compile to guard-stamped links, so the next
+    // invalidation severs them with a stamp write instead of code patching.
+    // Written under CodeInvalidationMutex unique, read under at least shared.
+    fextl::set<uint64_t> VolatileCodePages;
+
+    bool IsVolatileCodePage(uint64_t GuestAddr) const {
+      return VolatileCodePages.contains(GuestAddr >> 12);
+    }
+
+    // Replays journal entries this thread hasn't applied to its LookupCache
+    // yet. Must be called with CodeInvalidationMutex held, shared is enough.
+    void SyncThreadLookupCache(FEXCore::Core::InternalThreadState *Thread);
+
+    // Drops this thread's compiled multiblock regions that outgrew the PMU
+    // tuner's narrowed trace budget so they recompile split. Takes the
+    // invalidation lock uniquely when there is work to do.
+    void SplitOversizedRegions(FEXCore::Core::InternalThreadState *Thread);
+
     FEXCore::HostFeatures HostFeatures;
     // CPUID depends on HostFeatures so needs to be initialized after that.
     FEXCore::CPUIDEmu CPUID;
@@ -245,6 +330,19 @@ namespace FEXCore::Context {
     SignalDelegator *SignalDelegation{};
     X86GeneratedCode X86CodeGen;
 
+    // Debugger data watchpoints, modelled after the four x86 debug registers.
+    // The OpDispatcher instruments guest memory accesses against these while any
+    // are active, so the frontend must invalidate translated code around changes.
+    struct GuestWatchpoint {
+      uint64_t Address;
+      uint64_t Size;
+      FEXCore::Context::WatchpointType Type;
+      bool Enabled;
+    };
+    constexpr static size_t MAX_GUEST_WATCHPOINTS = 4;
+    std::array<GuestWatchpoint, MAX_GUEST_WATCHPOINTS> GuestWatchpoints {};
+    std::atomic<uint32_t> ActiveGuestWatchpoints {};
+
     ContextImpl();
     ~ContextImpl();
 
@@ -254,7 +352,15 @@ namespace FEXCore::Context {
     struct ExitFunctionLinkData {
       uint64_t HostBranch;
       uint64_t GuestRIP;
+      // The two fields below only exist for guard-stamped link sites, which
+      // tag their GuestRIP literal with GUARDED_LINK_FLAG. Plain sites end at
+      // GuestRIP.
+      uint64_t EpochPointer;
+      uint64_t EpochStamp;
     };
+    // Set in the GuestRIP literal of an exit site that carries a generation
+    // stamp guard. Guest RIPs are canonical so the bit can't occur naturally.
+    constexpr static uint64_t GUARDED_LINK_FLAG = 1ULL << 63;
 
     template<auto Fn>
     static uint64_t ThreadExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, ExitFunctionLinkData *Record) {
@@ -264,6 +370,25 @@ namespace FEXCore::Context {
       return Fn(Frame, Record);
     }
 
+    // Inline prediction chain for computed branches.
+    // Slots live as data literals inside the stub's code, newest prediction first.
+    struct IndirectPredictionSlot {
+      uint64_t HostCode;
+      uint64_t GuestRIP;
+    };
+    constexpr static size_t IndirectPredictionChainLength = 2;
+    struct IndirectPredictionStub {
+      IndirectPredictionSlot Slots[IndirectPredictionChainLength];
+    };
+
+    template<auto Fn>
+    static uint64_t ThreadIndirectBranchPredictorLink(FEXCore::Core::CpuStateFrame *Frame, IndirectPredictionStub *Stub) {
+      auto Thread = Frame->Thread;
+      auto lk = GuardSignalDeferringSection<std::shared_lock>(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
+
+      return Fn(Frame, Stub);
+    }
+
     // Wrapper which takes CpuStateFrame instead of InternalThreadState and unique_locks CodeInvalidationMutex
     // Must be called from owning thread
     static void ThreadRemoveCodeEntryFromJit(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP) {
@@ -285,7 +410,7 @@ namespace FEXCore::Context {
       uint64_t StartAddr;
       uint64_t Length;
     };
-    [[nodiscard]] GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst);
+    [[nodiscard]] GenerateIRResult GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst, bool BaselineTier = false);
 
     struct CompileCodeResult {
       void* CompiledCode;
@@ -295,8 +420,10 @@ namespace FEXCore::Context {
       bool GeneratedIR;
       uint64_t StartAddr;
       uint64_t Length;
+      // Guest instructions in the compiled region, zero unless IR was generated.
+      uint64_t TotalInstructions;
     };
-    [[nodiscard]] CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t MaxInst = 0);
+    [[nodiscard]] CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t MaxInst = 0, bool BaselineTier = false);
     uintptr_t CompileBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP, uint64_t MaxInst = 0);
 
     // Used for thread creation from syscalls
@@ -329,6 +456,19 @@ namespace FEXCore::Context {
     // If Atomic-based TSO emulation is enabled or not.
     bool IsAtomicTSOEnabled() const { return AtomicTSOEmulationEnabled; }
 
+    // If guest atomic ops may drop their acquire-release ordering.
+    // Deliberately not the inverse of IsAtomicTSOEnabled: hardware TSO orders
+    // plain loads and stores, but x86 locked ops are full barriers which TSO
+    // mode alone doesn't provide, so atomics stay ordered on those hosts.
+    bool IsAtomicRelaxedEnabled() const { return AtomicRelaxedEnabled; }
+
+    // Returns true if this block faulted on unaligned atomics often enough that it
+    // should be compiled with the split-barrier TSO lowering directly.
+    bool BlockUsesSplitTSOBarriers(uint64_t GuestRIP) {
+      std::shared_lock lk(TSOFaultMutex);
+      return SplitTSOBlocks.contains(GuestRIP);
+    }
+
     void SetHardwareTSOSupport(bool HardwareTSOSupported) override {
       SupportsHardwareTSO = HardwareTSOSupported;
       UpdateAtomicTSOEmulationConfig();
@@ -350,12 +490,20 @@ namespace FEXCore::Context {
 
     void EnableExitOnHLT() override { ExitOnHLT = true; }
 
+    void ReloadLiveTunables() override;
+
     bool ExitOnHLTEnabled() const { return ExitOnHLT; }
 
     FEXCore::CPU::CPUBackendFeatures BackendFeatures;
 
   protected:
     void UpdateAtomicTSOEmulationConfig() {
+      // Atomics may only relax once the rest of the memory model already has:
+      // a single thread under auto-migration, or TSO explicitly disabled.
+      // Migrating to a second thread clears the lookup cache, same as for the
+      // relaxed TSO loadstores.
+      AtomicRelaxedEnabled = !((IsMemoryShared || !Config.TSOAutoMigration) && Config.TSOEnabled);
+
       if (SupportsHardwareTSO) {
         // If the hardware supports TSO then we don't need to emulate it through atomics.
         AtomicTSOEmulationEnabled = false;
@@ -378,13 +526,174 @@ namespace FEXCore::Context {
 
     void AddBlockMapping(FEXCore::Core::InternalThreadState *Thread, uint64_t Address, void *Ptr);
 
+    // Process-wide Guest RIP -> Host code mapping, shared between guest threads.
+    // Only consulted on a full LookupCache miss so the per-thread L1 stays the hot path.
+    // Host code pointers stay valid as long as the publishing thread's code buffer is alive,
+    // which is why this is opt-in through the SharedCodeCache config option.
+    struct SharedCodeCacheEntry {
+      uint64_t HostCode;
+      uint64_t StartAddr;
+      uint64_t Length;
+    };
+    std::shared_mutex SharedCodeCacheMutex;
+    fextl::robin_map<uint64_t, SharedCodeCacheEntry> SharedCodeCacheMap;
+
+    // The speculative compiler hands its blocks to executing threads through the
+    // shared map above, so the map is live whenever any option compiling in the
+    // background is set.
+    bool SharedCodeCacheActive() const { return Config.SharedCodeCache() || Config.SpeculativeCompilation() || Config.BootProfileReplay(); }
+
+    // Host frame registry: sorted begin addresses of every live compiled block.
+    // Blocks already carry their size and RIP reconstruction entries inline
+    // behind the JITCodeHeader, so eight bytes per block is enough to resolve
+    // an arbitrary host PC back to a guest RIP in logarithmic time. Lets crash
+    // and profiling paths attribute host backtrace frames that point in to
+    // blocks other than the currently executing one.
+    void RegisterJITFrameRegion(uint64_t BlockBegin);
+    void UnregisterJITFrameRegions(uint64_t Start, uint64_t End);
+    // Returns 0 when the PC doesn't land inside a registered block.
+    uint64_t ResolveGuestRIPFromHostPC(uint64_t HostPC);
+    std::shared_mutex JITFrameRegistryMutex;
+    fextl::set<uint64_t> JITFrameRegistry;
+
+    // Speculative background compilation. Guest threads drop the statically known
+    // branch targets the frontend discovered while decoding in here, and a
+    // low-priority worker thread compiles them before execution reaches them.
+    // The worker publishes through the shared code cache like any other thread.
+    void EnqueueSpeculativeTargets(FEXCore::Core::InternalThreadState *Thread);
+    // Hands a single hot block to the worker. Used by latency critical threads
+    // that refuse to run the optimized compile on their own time.
+    void EnqueueBackgroundCompile(uint64_t Target);
+    void InvalidateSpeculativeThreadCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length);
+
+    // Appends a range to the invalidation journal and scrubs the shared code
+    // cache map for it. Requires CodeInvalidationMutex held uniquely.
+    void AppendInvalidatedRangeToJournal(uint64_t Start, uint64_t Length);
+
+    // Targets are dropped once the queue is full, speculation is best-effort.
+    constexpr static size_t MaxSpeculativeQueueDepth = 4096;
+    std::mutex SpeculativeQueueMutex;
+    fextl::deque<uint64_t> SpeculativeQueue;
+
+    // Blocks the worker compiled but hasn't made reachable yet. They become
+    // visible in batches so one ranged instruction-cache flush covers many
+    // blocks instead of one broadcast per block, which is a visible slice of
+    // compile-storm time on many-core hosts. Guarded by SharedCodeCacheMutex.
+    void DrainSpeculativePublishes(FEXCore::Core::InternalThreadState *Thread);
+    constexpr static size_t SpeculativePublishBatch = 8;
+    fextl::vector<std::pair<uint64_t, SharedCodeCacheEntry>> SpeculativePendingPublish;
+
+    // Retired thread states parked for reuse by the next guest clone.
+    // Building an InternalThreadState from scratch pays for the lookup cache
+    // backing, the JIT code buffer, the pass pipeline and the decoder on every
+    // guest pthread_create; thread-per-request guests create threads far
+    // faster than that. A parked state keeps those allocations and only has
+    // its guest-visible and lifecycle state scrubbed. Capped so a one-time
+    // thread burst doesn't pin the memory forever.
+    // Scrubs the thread state and parks it for reuse, false if the pool is full.
+    bool ParkRetiredThreadState(FEXCore::Core::InternalThreadState *Thread);
+    constexpr static size_t MaxRetiredThreadStates = 8;
+    std::mutex RetiredThreadStatesMutex;
+    fextl::vector<FEXCore::Core::InternalThreadState*> RetiredThreadStates;
+    Event SpeculativeWorkAvailable;
+    std::atomic_bool SpeculativeShuttingDown {false};
+    // Guarded by SpeculativeQueueMutex. The worker starts lazily on the first
+    // enqueue so its compiler state is created after the frontend is fully wired up.
+    bool SpeculativeThreadStarted {false};
+    fextl::unique_ptr<FEXCore::Threads::Thread> SpeculativeThreadHandle;
+    // The worker's own compile-only thread state. Invalidation scrubs its lookup
+    // cache through this since no thread manager tracks the worker.
+    std::atomic<FEXCore::Core::InternalThreadState *> SpeculativeThreadState {};
+
+    // Shadow validation. When ShadowValidation is set to N, one in every N
+    // compilations has its IR and allocation map captured and revalidated on a
+    // low priority worker thread. The validation passes record violations to
+    // telemetry; the synchronous compile path only ever pays for the sampled
+    // copies.
+    void MaybeCaptureShadowValidation(FEXCore::IR::IRListView *IRList, const FEXCore::IR::RegisterAllocationData *RAData);
+    void ShadowValidationThread();
+    struct ShadowValidationJob {
+      fextl::unique_ptr<FEXCore::IR::IRListView> IR;
+      FEXCore::IR::RegisterAllocationData::UniquePtr RAData;
+    };
+    // Jobs are dropped once the queue is full, sampling is best-effort.
+    constexpr static size_t MaxShadowValidationQueueDepth = 64;
+    std::mutex ShadowValidationQueueMutex;
+    fextl::deque<ShadowValidationJob> ShadowValidationQueue;
+    std::atomic<uint64_t> ShadowValidationCounter {};
+    Event ShadowValidationWorkAvailable;
+    std::atomic_bool ShadowValidationShuttingDown {false};
+    // Guarded by ShadowValidationQueueMutex. The worker starts lazily on the
+    // first captured compilation.
+    bool ShadowValidationThreadStarted {false};
+    fextl::unique_ptr<FEXCore::Threads::Thread> ShadowValidationThreadHandle;
+
+    // RSS governor. When RSSLimit is set, a low priority thread samples the
+    // process resident set size and sheds reclaimable memory once over budget:
+    // the parked retired-thread-state pool first, then a heap trim so the
+    // allocator's dirty pages go back to the kernel. Compiled code is never
+    // evicted; the governor only targets memory nothing is actively using.
+    Event RSSGovernorWake;
+    std::atomic_bool RSSGovernorShuttingDown {false};
+    fextl::unique_ptr<FEXCore::Threads::Thread> RSSGovernorHandle;
+
+    // Boot profile replay. The first session of a binary records the order its
+    // blocks were first compiled in during the startup window; the next session
+    // feeds that list to the background compile thread immediately, so the
+    // deterministic part of startup is compiled just ahead of execution.
+    void RecordBootProfileBlock(uint64_t GuestRIP);
+    void ReplayBootProfile();
+    // Requires BootProfileMutex held
+    void WriteBootProfile();
+    fextl::string BootProfilePath();
+    // File format: cookie followed by a flat array of guest RIPs in first-compile order
+    constexpr static uint64_t BOOTPROFILE_COOKIE = FEXCore::IR::COOKIE_VERSION("FXBP", 0);
+    constexpr static std::chrono::seconds BootProfileWindow {30};
+    std::chrono::steady_clock::time_point BootProfileStart;
+    std::mutex BootProfileMutex;
+    bool BootProfileWindowClosed {false};
+    fextl::vector<uint64_t> BootProfileBlocks;
+    fextl::set<uint64_t> BootProfileSeen;
+
+    // Block-transition edge export for offline PGO tooling. Edges are observed
+    // when the dispatcher patches a block-to-block link, buffered, and appended
+    // to a per-process file under the data directory. Best effort: a crashed
+    // process loses at most one buffer worth of edges.
+    void RecordCallGraphEdge(uint64_t SourceRIP, uint64_t TargetRIP);
+    struct CallGraphEdge {
+      uint64_t SourceRIP;
+      uint64_t TargetRIP;
+    };
+    // File format: cookie followed by a flat CallGraphEdge array
+    constexpr static uint64_t CALLGRAPH_COOKIE = FEXCore::IR::COOKIE_VERSION("FXCG", 0);
+    constexpr static size_t CallGraphFlushThreshold = 4096;
+    std::mutex CallGraphMutex;
+    fextl::vector<CallGraphEdge> CallGraphBuffer;
+    int CallGraphFD {-1};
+    bool CallGraphExportFailed {false};
+    // Requires CallGraphMutex held
+    void FlushCallGraphBuffer();
+
+    // Tracks blocks that fault on unaligned atomics under TSO emulation.
+    // Backpatching fixes one instruction per SIGBUS, so once a block crosses the
+    // threshold it's cheaper to recompile the whole thing with explicit barriers.
+    constexpr static uint32_t TSOFaultDowngradeThreshold = 8;
+    std::shared_mutex TSOFaultMutex;
+    fextl::unordered_map<uint64_t, uint32_t> TSOFaultCounts;
+    fextl::set<uint64_t> SplitTSOBlocks;
+
     IR::AOTIRCaptureCache IRCaptureCache;
     fextl::unique_ptr<FEXCore::CodeSerialize::CodeObjectSerializeService> CodeObjectCacheService;
+    // Content-hash validated decode results, shared by every thread's decoder
+    fextl::unique_ptr<FEXCore::Frontend::DecodeCache> FrontendDecodeCache;
+    // PMU-driven multiblock trace budget controller, only when PMUTuning is set
+    fextl::unique_ptr<FEXCore::PMUTuner> Tuner;
 
     bool StartPaused = false;
     bool IsMemoryShared = false;
     bool SupportsHardwareTSO = false;
     bool AtomicTSOEmulationEnabled = true;
+    bool AtomicRelaxedEnabled = false;
     bool ExitOnHLT = false;
     FEX_CONFIG_OPT(AppFilename, APP_FILENAME);
 
@@ -1,11 +1,15 @@
 // SPDX-License-Identifier: MIT
 #include "FEXCore/IR/IR.h"
+#include "FEXCore/Utils/Allocator.h"
 #include "FEXCore/Utils/AllocatorHooks.h"
 #include "Interface/Context/Context.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
 #include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Statistics.h>
 
 #ifndef _WIN32
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #endif
 
@@ -27,6 +31,12 @@ constexpr static uint64_t NamedVectorConstants[FEXCore::IR::NamedVectorConstant:
   {0x0706'0504'0302'0100ULL, 0x0F0E'0D0C'FFFF'FFFFULL}, // NAMED_VECTOR_BLENDPS_1011B
   {0xFFFF'FFFF'0302'0100ULL, 0x0F0E'0D0C'0B0A'0908ULL}, // NAMED_VECTOR_BLENDPS_1101B
   {0x0706'0504'FFFF'FFFFULL, 0x0F0E'0D0C'0B0A'0908ULL}, // NAMED_VECTOR_BLENDPS_1110B
+  {0x8040'2010'0804'0201ULL, 0x8040'2010'0804'0201ULL}, // NAMED_VECTOR_MOVMSKB_MASK
+  {0x8040'2010'0804'0201ULL, 0x8040'2010'0804'0201ULL}, // NAMED_VECTOR_MOVMSKB_MASK_UPPER
+  {0x8000'0000'8000'0000ULL, 0x8000'0000'8000'0000ULL}, // NAMED_VECTOR_SIGN_MASK_PS
+  {0x8000'0000'8000'0000ULL, 0x8000'0000'8000'0000ULL}, // NAMED_VECTOR_SIGN_MASK_PS_UPPER
+  {0x8000'0000'0000'0000ULL, 0x8000'0000'0000'0000ULL}, // NAMED_VECTOR_SIGN_MASK_PD
+  {0x8000'0000'0000'0000ULL, 0x8000'0000'0000'0000ULL}, // NAMED_VECTOR_SIGN_MASK_PD_UPPER
 };
 
 constexpr static auto PSHUFLW_LUT {
@@ -276,6 +286,96 @@ constexpr static auto PBLENDW_LUT {
 }()
 };
 
+constexpr static auto VPERMQ_LUT {
+[]() consteval {
+  struct LUTType {
+    uint64_t Val[4];
+  };
+  // 64-bit elements in a 256-bit destination are picked from any of the four
+  // source elements using two selector bits per element.
+  // Expectation for this LUT is to simulate VPERMQ/VPERMPD with a single
+  // full-width TBL instruction.
+  // VPERMQ behaviour:
+  // Dest[63:0]    = Src[<Selector[1:0]>]
+  // Dest[127:64]  = Src[<Selector[3:2]>]
+  // Dest[191:128] = Src[<Selector[5:4]>]
+  // Dest[255:192] = Src[<Selector[7:6]>]
+
+  std::array<LUTType, 256> TotalLUT{};
+  for (size_t i = 0; i < 256; ++i) {
+    auto &LUT = TotalLUT[i];
+    for (size_t j = 0; j < 4; ++j) {
+      const uint64_t Element = (i >> (j * 2)) & 0b11;
+      LUT.Val[j] = 0x07'06'05'04'03'02'01'00ULL + (0x01'01'01'01'01'01'01'01ULL * (Element * 8));
+    }
+  }
+  return TotalLUT;
+}()
+};
+
+constexpr static auto VPERMILPS_LUT {
+[]() consteval {
+  struct LUTType {
+    uint32_t Val[8];
+  };
+  // 32-bit elements are picked from the four elements of the same 128-bit lane
+  // using two selector bits per element, with the selector reused for both lanes.
+  // Expectation for this LUT is to simulate VPERMILPS (immediate form) with a
+  // single TBL instruction.
+  // The 128-bit form only loads the first half of an entry, so the byte indices
+  // for the upper lane live in the second half with a 16-byte offset baked in.
+  // VPERMILPS behaviour:
+  // Dest[31:0]    = Src[<Selector[1:0]>]
+  // Dest[63:32]   = Src[<Selector[3:2]>]
+  // Dest[95:64]   = Src[<Selector[5:4]>]
+  // Dest[127:96]  = Src[<Selector[7:6]>]
+  // Dest[159:128] = Src[<Selector[1:0]> + 4]
+  // Dest[191:160] = Src[<Selector[3:2]> + 4]
+  // Dest[223:192] = Src[<Selector[5:4]> + 4]
+  // Dest[255:224] = Src[<Selector[7:6]> + 4]
+
+  std::array<LUTType, 256> TotalLUT{};
+  for (size_t i = 0; i < 256; ++i) {
+    auto &LUT = TotalLUT[i];
+    for (size_t j = 0; j < 4; ++j) {
+      const uint32_t Element = (i >> (j * 2)) & 0b11;
+      LUT.Val[j] = 0x03'02'01'00U + (0x04'04'04'04U * Element);
+      LUT.Val[j + 4] = LUT.Val[j] + 0x10'10'10'10U;
+    }
+  }
+  return TotalLUT;
+}()
+};
+
+constexpr static auto VPERMILPD_LUT {
+[]() consteval {
+  struct LUTType {
+    uint64_t Val[4];
+  };
+  // 64-bit elements are picked from the two elements of the same 128-bit lane
+  // using one selector bit per element.
+  // Expectation for this LUT is to simulate VPERMILPD (immediate form) with a
+  // single TBL instruction, the 128-bit form only loads the first half of an entry.
+  // VPERMILPD behaviour:
+  // Dest[63:0]    = Src[<Selector[0]>]
+  // Dest[127:64]  = Src[<Selector[1]>]
+  // Dest[191:128] = Src[<Selector[2]> + 2]
+  // Dest[255:192] = Src[<Selector[3]> + 2]
+
+  std::array<LUTType, 256> TotalLUT{};
+  for (size_t i = 0; i < 256; ++i) {
+    auto &LUT = TotalLUT[i];
+    for (size_t j = 0; j < 2; ++j) {
+      const uint64_t LowElement = (i >> j) & 1;
+      const uint64_t HighElement = ((i >> (j + 2)) & 1) + 2;
+      LUT.Val[j] = 0x07'06'05'04'03'02'01'00ULL + (0x01'01'01'01'01'01'01'01ULL * (LowElement * 8));
+      LUT.Val[j + 2] = 0x07'06'05'04'03'02'01'00ULL + (0x01'01'01'01'01'01'01'01ULL * (HighElement * 8));
+    }
+  }
+  return TotalLUT;
+}()
+};
+
 CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t InitialCodeSize, size_t MaxCodeSize)
     : ThreadState(ThreadState), InitialCodeSize(InitialCodeSize), MaxCodeSize(MaxCodeSize) {
 
@@ -297,6 +397,9 @@ CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t I
   Common.IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_DPPS_MASK] = reinterpret_cast<uint64_t>(DPPS_MASK.data());
   Common.IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_DPPD_MASK] = reinterpret_cast<uint64_t>(DPPD_MASK.data());
   Common.IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_PBLENDW] = reinterpret_cast<uint64_t>(PBLENDW_LUT.data());
+  Common.IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_VPERMQ] = reinterpret_cast<uint64_t>(VPERMQ_LUT.data());
+  Common.IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_VPERMILPS] = reinterpret_cast<uint64_t>(VPERMILPS_LUT.data());
+  Common.IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_VPERMILPD] = reinterpret_cast<uint64_t>(VPERMILPD_LUT.data());
 
 #ifndef FEX_DISABLE_TELEMETRY
   // Fill in telemetry values
@@ -305,6 +408,9 @@ CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t I
     Common.TelemetryValueAddresses[i] = reinterpret_cast<uint64_t>(Telem.GetAddr());
   }
 #endif
+
+  Common.StatStrexFailureCounter =
+    reinterpret_cast<uint64_t>(FEXCore::Statistics::GetStat(FEXCore::Statistics::STAT_STREX_FAILURES).GetAddr());
 }
 
 CPUBackend::~CPUBackend() {
@@ -314,6 +420,34 @@ CPUBackend::~CPUBackend() {
   CodeBuffers.clear();
 }
 
+auto CPUBackend::TryExpandCodeBuffer(size_t MinimumSize) -> CodeBuffer * {
+  size_t TotalSize = 0;
+  for (auto &Buffer : CodeBuffers) {
+    TotalSize += Buffer.Size;
+  }
+
+  if (TotalSize >= MaxCodeSize) {
+    // Max resident code reached, the caller needs to do a full clear
+    return nullptr;
+  }
+
+  // Grow the same way a full clear would, but capped to the remaining budget
+  size_t NewSize = std::min<size_t>(CurrentCodeBuffer->Size * 1.5, MaxCodeSize - TotalSize);
+  if (NewSize < MinimumSize) {
+    return nullptr;
+  }
+
+  auto NewCodeBuffer = AllocateNewCodeBuffer(NewSize);
+  EmplaceNewCodeBuffer(NewCodeBuffer);
+  return CurrentCodeBuffer;
+}
+
+void CPUBackend::BindCodeBuffersToLocalNode() {
+  for (auto &Buffer : CodeBuffers) {
+    FEXCore::Allocator::BindToLocalNode(Buffer.Ptr, Buffer.Size);
+  }
+}
+
 auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
   if (ThreadState->CurrentFrame->SignalHandlerRefCounter == 0) {
     if (CodeBuffers.empty()) {
@@ -380,9 +514,46 @@ auto CPUBackend::AllocateNewCodeBuffer(size_t Size) -> CodeBuffer {
 
   CodeBuffer Buffer;
   Buffer.Size = Size;
-  Buffer.Ptr = static_cast<uint8_t *>(
-      FEXCore::Allocator::VirtualAlloc(Buffer.Size, true));
-  LOGMAN_THROW_AA_FMT(!!Buffer.Ptr, "Couldn't allocate code buffer");
+  Buffer.Ptr = nullptr;
+
+#ifndef _WIN32
+  if (static_cast<Context::ContextImpl*>(ThreadState->CTX)->Config.HugePageJITBuffers()) {
+    // Explicitly reserved 2M pages guarantee large iTLB entries where the
+    // transparent hint below depends on khugepaged getting around to them.
+    // Needs pages reserved by the admin through vm.nr_hugepages.
+    constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    const size_t AlignedSize = FEXCore::AlignUp(Buffer.Size, HUGE_PAGE_SIZE);
+    void *Ptr = FEXCore::Allocator::mmap(nullptr, AlignedSize,
+        PROT_READ | PROT_WRITE | PROT_EXEC,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (Ptr != MAP_FAILED && Ptr != nullptr) {
+      // The rounded up tail is usable code space, keep it.
+      Buffer.Size = AlignedSize;
+      Buffer.Ptr = static_cast<uint8_t *>(Ptr);
+    }
+    // Fall back to regular pages when the huge page pool is empty.
+  }
+#endif
+
+  if (!Buffer.Ptr) {
+    Buffer.Ptr = static_cast<uint8_t *>(
+        FEXCore::Allocator::VirtualAlloc(Buffer.Size, true));
+    LOGMAN_THROW_AA_FMT(!!Buffer.Ptr, "Couldn't allocate code buffer");
+
+#ifndef _WIN32
+    // This enables the kernel to use transparent large pages in the code buffer.
+    // Blocks are appended densely, so hot code chains spanning multiple 4K pages
+    // collapse into a handful of iTLB entries instead of one per page.
+    ::madvise(Buffer.Ptr, Buffer.Size, MADV_HUGEPAGE);
+#endif
+  }
+
+  if (static_cast<Context::ContextImpl*>(ThreadState->CTX)->Config.NUMALocalPlacement()) {
+    // Growth allocations happen on the thread that executes from the buffer, so
+    // the current node is the right one. The initial buffer is allocated by the
+    // parent thread and gets rebound once the execution thread is running.
+    FEXCore::Allocator::BindToLocalNode(Buffer.Ptr, Buffer.Size);
+  }
 
   if (static_cast<Context::ContextImpl*>(ThreadState->CTX)->Config.GlobalJITNaming()) {
     static_cast<Context::ContextImpl*>(ThreadState->CTX)->Symbols.RegisterJITSpace(Buffer.Ptr, Buffer.Size);
@@ -391,6 +562,11 @@ auto CPUBackend::AllocateNewCodeBuffer(size_t Size) -> CodeBuffer {
 }
 
 void CPUBackend::FreeCodeBuffer(CodeBuffer Buffer) {
+  // Drop frame registry entries covering this buffer before the mapping goes
+  // away, lookups chase the block headers living inside it.
+  static_cast<Context::ContextImpl*>(ThreadState->CTX)->UnregisterJITFrameRegions(
+    reinterpret_cast<uint64_t>(Buffer.Ptr), reinterpret_cast<uint64_t>(Buffer.Ptr) + Buffer.Size);
+
   FEXCore::Allocator::VirtualFree(Buffer.Ptr, Buffer.Size);
 }
 
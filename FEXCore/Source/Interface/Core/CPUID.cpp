@@ -448,7 +448,7 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_01h(uint32_t Leaf) const {
     (SupportsAVX() << 26) | // XSAVE
     (SupportsAVX() << 27) | // OSXSAVE
     (SupportsAVX() << 28) | // AVX
-    (0 << 29) | // F16C
+    (SupportsAVX() << 29) | // F16C
     (CTX->HostFeatures.SupportsRAND << 30) | // RDRAND
     (Hypervisor << 31);
 
@@ -743,6 +743,46 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_07h(uint32_t Leaf) const {
   return Res;
 }
 
+// Extended topology enumeration
+FEXCore::CPUID::FunctionResults CPUIDEmu::Function_0Bh(uint32_t Leaf) const {
+  FEXCore::CPUID::FunctionResults Res{};
+
+  // We present a flat topology: one socket, one thread per core, one core per
+  // logical processor. Guest schedulers and thread pools use this leaf to size
+  // themselves, so surfacing it matters even without SMT to enumerate.
+  //
+  // EDX must return the x2APIC ID of the logical processor executing the
+  // query on every sub-leaf, including invalid ones.
+  Res.edx = GetCPUID();
+
+  if (Leaf == 0) {
+    // SMT level. No SMT, so zero bits of APIC ID distinguish threads in a core.
+    Res.eax = 0; // Number of bits to shift right to get the next level APIC ID
+    Res.ebx = 1; // Number of logical processors at this level
+    Res.ecx =
+      (1 << 8) | // Level type: SMT
+      Leaf;      // Level number
+  }
+  else if (Leaf == 1) {
+    // Core level, covers every logical processor in the package.
+    uint32_t CoreBits{};
+    while ((1U << CoreBits) < Cores) {
+      ++CoreBits;
+    }
+    Res.eax = CoreBits;
+    Res.ebx = Cores;
+    Res.ecx =
+      (2 << 8) | // Level type: Core
+      Leaf;      // Level number
+  }
+  else {
+    // Invalid level, EAX and EBX are zero with the level type marked invalid.
+    Res.ecx = Leaf;
+  }
+
+  return Res;
+}
+
 FEXCore::CPUID::FunctionResults CPUIDEmu::Function_0Dh(uint32_t Leaf) const {
   // Leaf 0
   FEXCore::CPUID::FunctionResults Res{};
@@ -857,6 +897,13 @@ FEXCore::CPUID::FunctionResults CPUIDEmu::Function_4000_0001h(uint32_t Leaf) con
 #else
     // EAX[3:0] = 0 = Unknown architecture
 #endif
+
+    // EBX = Paravirtual feature bits for FEX-aware guests
+    // EBX[0] = madvise(MADV_DONTNEED/MADV_FREE/MADV_REMOVE) over executable
+    //          ranges invalidates translated code for exactly that range.
+    //          Guest JITs can use it to drop patched code regions without the
+    //          mprotect+write+mprotect dance through the full SMC machinery.
+    Res.ebx = (1 << 0);
   }
 
   return Res;
@@ -1235,7 +1282,10 @@ FEXCore::CPUID::XCRResults CPUIDEmu::XCRFunction_0h() const {
 
 CPUIDEmu::CPUIDEmu(FEXCore::Context::ContextImpl const *ctx)
   : CTX {ctx} {
-  Cores = FEXCore::CPUInfo::CalculateNumberOfCPUs();
+  // Advertise the virtualized CPU count when configured, so the topology
+  // leaves agree with the emulated procfs/sysfs surface on dense hosts.
+  FEX_CONFIG_OPT(VirtualCPUCount, VIRTUALCPUCOUNT);
+  Cores = VirtualCPUCount() ? VirtualCPUCount() : FEXCore::CPUInfo::CalculateNumberOfCPUs();
 
   // Setup some state tracking
   SetupHostHybridFlag();
@@ -34,6 +34,17 @@ public:
   // if we report anything differently then applications are likely to break
   constexpr static uint64_t CACHELINE_SIZE = 64;
 
+  // Host hybrid-topology queries, used by compile-time tuning decisions on
+  // big.LITTLE hosts in addition to the guest-visible hybrid CPUID leaf.
+  bool IsHostHybrid() const { return Hybrid; }
+  bool IsBigCore(uint32_t CPU) const {
+    return PerCPUData.empty() ? true : PerCPUData[CPU % PerCPUData.size()].IsBig;
+  }
+
+  // The JIT calls these entry points directly, so they are compiled with the
+  // restricted clobber ABI where the compiler supports it. The call site then
+  // only needs to spill the small caller-saved subset instead of full state.
+  FEXCORE_PRESERVE_ALL_ATTR
   FEXCore::CPUID::FunctionResults RunFunction(uint32_t Function, uint32_t Leaf) const {
     if (Function < Primary.size()) {
       const auto Handler = Primary[Function];
@@ -64,6 +75,7 @@ public:
       return Function_8000_0004h(Leaf, CPU % PerCPUData.size());
   }
 
+  FEXCORE_PRESERVE_ALL_ATTR
   FEXCore::CPUID::XCRResults RunXCRFunction(uint32_t Function) const {
     if (Function >= 1) {
       // XCR function 1 is not yet supported.
@@ -172,6 +184,7 @@ private:
   FEXCore::CPUID::FunctionResults Function_04h(uint32_t Leaf) const;
   FEXCore::CPUID::FunctionResults Function_06h(uint32_t Leaf) const;
   FEXCore::CPUID::FunctionResults Function_07h(uint32_t Leaf) const;
+  FEXCore::CPUID::FunctionResults Function_0Bh(uint32_t Leaf) const;
   FEXCore::CPUID::FunctionResults Function_0Dh(uint32_t Leaf) const;
   FEXCore::CPUID::FunctionResults Function_15h(uint32_t Leaf) const;
   FEXCore::CPUID::FunctionResults Function_1Ah(uint32_t Leaf) const;
@@ -230,7 +243,7 @@ private:
     // 0x0A: Architectural performance monitoring
     &CPUIDEmu::Function_Reserved,
     // 0x0B: Extended topology enumeration
-    &CPUIDEmu::Function_Reserved,
+    &CPUIDEmu::Function_0Bh,
     // 0x0C: Reserved?
     &CPUIDEmu::Function_Reserved,
     // 0x0D: Processor extended state enumeration
@@ -301,7 +314,8 @@ private:
     // 0x0A: Architectural performance monitoring
     { SupportsConstant::CONSTANT, NeedsLeafConstant::NOLEAFCONSTANT },
     // 0x0B: Extended topology enumeration
-    { SupportsConstant::CONSTANT, NeedsLeafConstant::NOLEAFCONSTANT },
+    // EDX returns the executing core's APIC ID, so it can't be constant folded.
+    { SupportsConstant::NONCONSTANT, NeedsLeafConstant::NOLEAFCONSTANT },
     // 0x0C: Reserved?
     { SupportsConstant::CONSTANT, NeedsLeafConstant::NOLEAFCONSTANT },
     // 0x0D: Processor extended state enumeration
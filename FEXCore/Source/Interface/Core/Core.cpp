@@ -15,6 +15,7 @@ $end_info$
 #include "Interface/Core/CPUID.h"
 #include "Interface/Core/Frontend.h"
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
+#include "Interface/Core/PMUTuner.h"
 #include "Interface/Core/OpcodeDispatcher.h"
 #include "Interface/Core/JIT/JITCore.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
@@ -43,19 +44,26 @@ $end_info$
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/CPUInfo.h>
 #include <FEXCore/Utils/Event.h>
 #include <FEXCore/Utils/File.h>
+#include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/LogManager.h>
 #include "FEXCore/Utils/SignalScopeGuards.h"
 #include <FEXCore/Utils/Threads.h>
+#include <FEXCore/Utils/CompileTimeTelemetry.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Statistics.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/sstream.h>
 #include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Filesystem.h>
 #include <FEXHeaderUtils/Syscalls.h>
 #include <FEXHeaderUtils/TodoDefines.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
 #include <algorithm>
 #include <array>
@@ -71,6 +79,11 @@ $end_info$
 #include <stdio.h>
 #include <string_view>
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
 #include <type_traits>
 #include <unistd.h>
 #include <unordered_map>
@@ -78,6 +91,13 @@ $end_info$
 #include <xxhash.h>
 
 namespace FEXCore::Context {
+#ifndef _WIN32
+  static void* RSSGovernorHandler(void *Arg) {
+    reinterpret_cast<ContextImpl*>(Arg)->RSSGovernorThread();
+    return nullptr;
+  }
+#endif
+
   ContextImpl::ContextImpl()
   : CPUID {this}
   , IRCaptureCache {this} {
@@ -87,6 +107,13 @@ namespace FEXCore::Context {
     if (Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE) {
       CodeObjectCacheService = fextl::make_unique<FEXCore::CodeSerialize::CodeObjectSerializeService>(this);
     }
+    if (Config.DecodeCache()) {
+      FrontendDecodeCache = fextl::make_unique<FEXCore::Frontend::DecodeCache>();
+    }
+    if (Config.PMUTuning() && Config.Multiblock()) {
+      const int32_t InitialBudget = Config.MultiblockTraceInst() != 0 ? Config.MultiblockTraceInst : Config.MaxInstPerBlock;
+      Tuner = fextl::make_unique<FEXCore::PMUTuner>(InitialBudget);
+    }
     if (!Config.Is64BitMode()) {
       // When operating in 32-bit mode, the virtual memory we care about is only the lower 32-bits.
       Config.VirtualMemSize = 1ULL << 32;
@@ -99,15 +126,77 @@ namespace FEXCore::Context {
       Symbols.InitFile();
     }
 
+    if (Config.JITDump()) {
+      Symbols.InitJITDump();
+    }
+
     // Track atomic TSO emulation configuration.
     UpdateAtomicTSOEmulationConfig();
+
+    BootProfileStart = std::chrono::steady_clock::now();
+
+#ifndef _WIN32
+    if (Config.RSSLimit() > 0) {
+      uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+      RSSGovernorHandle = FEXCore::Threads::Thread::Create(RSSGovernorHandler, this);
+      FEXCore::Threads::SetSignalMask(OldMask);
+    }
+#endif
   }
 
   ContextImpl::~ContextImpl() {
     {
+      if (RSSGovernorHandle) {
+        RSSGovernorShuttingDown = true;
+        RSSGovernorWake.NotifyAll();
+        if (RSSGovernorHandle->joinable()) {
+          RSSGovernorHandle->join(nullptr);
+        }
+      }
+
+      if (SpeculativeThreadHandle) {
+        SpeculativeShuttingDown = true;
+        SpeculativeWorkAvailable.NotifyAll();
+        if (SpeculativeThreadHandle->joinable()) {
+          SpeculativeThreadHandle->join(nullptr);
+        }
+        if (auto *Thread = SpeculativeThreadState.load()) {
+          DestroyThread(Thread, false);
+        }
+      }
+
+      if (ShadowValidationThreadHandle) {
+        ShadowValidationShuttingDown = true;
+        ShadowValidationWorkAvailable.NotifyAll();
+        if (ShadowValidationThreadHandle->joinable()) {
+          ShadowValidationThreadHandle->join(nullptr);
+        }
+      }
+
       if (CodeObjectCacheService) {
         CodeObjectCacheService->Shutdown();
       }
+
+      {
+        std::lock_guard lk(CallGraphMutex);
+        if (!CallGraphBuffer.empty()) {
+          FlushCallGraphBuffer();
+        }
+        if (CallGraphFD != -1) {
+          close(CallGraphFD);
+        }
+      }
+
+      if (Config.BootProfileReplay()) {
+        std::lock_guard lk(BootProfileMutex);
+        WriteBootProfile();
+      }
+    }
+
+    // Free thread states parked for reuse
+    for (auto *Thread : RetiredThreadStates) {
+      FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096);
+      delete Thread;
     }
   }
 
@@ -126,6 +215,14 @@ namespace FEXCore::Context {
       if (HostPC >= reinterpret_cast<uint64_t>(BlockBegin) &&
           HostPC < reinterpret_cast<uint64_t>(BlockBegin + InlineTail->Size)) {
 
+        // Fault-heavy guests (managed runtimes using null-check traps) hit the
+        // same few host instructions repeatedly, so check the thread's decoded
+        // fault-site cache before walking the delta-encoded entries.
+        auto &FaultSite = Thread->FaultSiteCache[(HostPC >> 2) % Core::InternalThreadState::FaultSiteCacheSize];
+        if (FaultSite.HostPC == HostPC) {
+          return FaultSite.GuestRIP;
+        }
+
         // Reconstruct RIP from JIT entries for this block.
         uint64_t StartingHostPC = BlockBegin;
         uint64_t StartingGuestRIP = InlineTail->RIP;
@@ -142,14 +239,104 @@ namespace FEXCore::Context {
             break;
           }
         }
+
+        FaultSite = { .HostPC = HostPC, .GuestRIP = StartingGuestRIP };
         return StartingGuestRIP;
       }
     }
 
+    // The PC didn't land inside the currently executing block. The frame
+    // registry covers every live block, so PCs reached through backtraces or
+    // samples can still be attributed.
+    if (const uint64_t GuestRIP = ResolveGuestRIPFromHostPC(HostPC)) {
+      return GuestRIP;
+    }
+
     // Fallback to what is stored in the RIP currently.
     return Frame->State.rip;
   }
 
+  void ContextImpl::RegisterJITFrameRegion(uint64_t BlockBegin) {
+    std::unique_lock lk(JITFrameRegistryMutex);
+    JITFrameRegistry.insert(BlockBegin);
+  }
+
+  void ContextImpl::UnregisterJITFrameRegions(uint64_t Start, uint64_t End) {
+    std::unique_lock lk(JITFrameRegistryMutex);
+    JITFrameRegistry.erase(JITFrameRegistry.lower_bound(Start), JITFrameRegistry.lower_bound(End));
+  }
+
+  uint64_t ContextImpl::ResolveGuestRIPFromHostPC(uint64_t HostPC) {
+    // Called from signal handlers. The faulting thread was executing JIT code
+    // or walking a backtrace, so it can't be holding the registry lock itself.
+    std::shared_lock lk(JITFrameRegistryMutex);
+
+    auto it = JITFrameRegistry.upper_bound(HostPC);
+    if (it == JITFrameRegistry.begin()) {
+      return 0;
+    }
+    --it;
+
+    const uint64_t BlockBegin = *it;
+    auto InlineHeader = reinterpret_cast<const CPU::CPUBackend::JITCodeHeader *>(BlockBegin);
+    auto InlineTail = reinterpret_cast<const CPU::CPUBackend::JITCodeTail *>(BlockBegin + InlineHeader->OffsetToBlockTail);
+    if (HostPC >= BlockBegin + InlineTail->Size) {
+      // Between the end of the preceding block and the start of the next.
+      return 0;
+    }
+
+    // Accumulate the delta-encoded RIP entries the same way the inline header
+    // path above does.
+    auto RIPEntries = reinterpret_cast<const CPU::CPUBackend::JITRIPReconstructEntries *>(BlockBegin + InlineHeader->OffsetToBlockTail + InlineTail->OffsetToRIPEntries);
+    uint64_t StartingHostPC = BlockBegin;
+    uint64_t StartingGuestRIP = InlineTail->RIP;
+    for (uint32_t i = 0; i < InlineTail->NumberOfRIPEntries; ++i) {
+      const auto &RIPEntry = RIPEntries[i];
+      if (HostPC < (StartingHostPC + RIPEntry.HostPCOffset)) {
+        break;
+      }
+      StartingHostPC += RIPEntry.HostPCOffset;
+      StartingGuestRIP += RIPEntry.GuestRIPOffset;
+    }
+
+    return StartingGuestRIP;
+  }
+
+  void ContextImpl::RecordTSOFaultBackpatch(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) {
+    // Attribute the fault to the block's entry RIP through the inline block header,
+    // the same mechanism RestoreRIPFromHostPC uses.
+    const uint64_t BlockBegin = Thread->CurrentFrame->State.InlineJITBlockHeader;
+    auto InlineHeader = reinterpret_cast<const CPU::CPUBackend::JITCodeHeader *>(BlockBegin);
+    if (!InlineHeader) {
+      return;
+    }
+
+    auto InlineTail = reinterpret_cast<const CPU::CPUBackend::JITCodeTail *>(BlockBegin + InlineHeader->OffsetToBlockTail);
+    if (HostPC < BlockBegin || HostPC >= BlockBegin + InlineTail->Size) {
+      return;
+    }
+    const uint64_t BlockRIP = InlineTail->RIP;
+
+    // This runs from the SIGBUS handler, but the fault always comes from inside JIT
+    // code, so this thread can't be holding allocator or cache locks.
+    bool Downgrade = false;
+    {
+      std::unique_lock lk(TSOFaultMutex);
+      if (++TSOFaultCounts[BlockRIP] == TSOFaultDowngradeThreshold) {
+        SplitTSOBlocks.insert(BlockRIP);
+        Downgrade = true;
+      }
+    }
+
+    if (Downgrade) {
+      // Backpatching already fixed the instruction that faulted, but a block full of
+      // unaligned accesses pays one SIGBUS round-trip per instruction. Drop the
+      // mapping so the next dispatch recompiles the whole block with the
+      // split-barrier lowering up front.
+      Thread->LookupCache->Erase(BlockRIP);
+    }
+  }
+
   uint32_t ContextImpl::ReconstructCompactedEFLAGS(FEXCore::Core::InternalThreadState *Thread, bool WasInJIT, uint64_t *HostGPRs, uint64_t PSTATE) {
     const auto Frame = Thread->CurrentFrame;
     uint32_t EFLAGS{};
@@ -309,6 +496,12 @@ namespace FEXCore::Context {
     Config.NeedsPendingInterruptFaultCheck = true;
 #endif
 
+    if (Config.CoopPreempt) {
+      // Cooperative preemption parks threads through the interrupt fault page,
+      // so every block entry needs to poll it.
+      Config.NeedsPendingInterruptFaultCheck = true;
+    }
+
     if (Config.GdbServer) {
       // If gdbserver is enabled then this needs to be enabled.
       Config.NeedsPendingInterruptFaultCheck = true;
@@ -324,6 +517,12 @@ namespace FEXCore::Context {
   }
 
   FEXCore::Context::ExitReason ContextImpl::RunUntilExit(FEXCore::Core::InternalThreadState *Thread) {
+    // The guest image is mapped by now, so a previous session's boot profile
+    // can start compiling ahead of execution.
+    if (Config.BootProfileReplay()) {
+      ReplayBootProfile();
+    }
+
     ExecutionThread(Thread);
     while(true) {
       auto reason = Thread->ExitReason;
@@ -368,8 +567,17 @@ namespace FEXCore::Context {
     Thread->FrontendDecoder = fextl::make_unique<FEXCore::Frontend::Decoder>(this);
     Thread->PassManager = fextl::make_unique<FEXCore::IR::PassManager>();
 
+    if (Config.SpeculativeCompilation()) {
+      // Collect statically known branch targets during decode so CompileBlock
+      // can hand them to the speculative compile thread.
+      Thread->FrontendDecoder->SetExternalBranches(&Thread->SpeculativeBranchTargets);
+    }
+
     Thread->CurrentFrame->Pointers.Common.L1Pointer = Thread->LookupCache->GetL1Pointer();
+    Thread->CurrentFrame->Pointers.Common.L1EntriesMask = Thread->LookupCache->GetL1Mask();
     Thread->CurrentFrame->Pointers.Common.L2Pointer = Thread->LookupCache->GetPagePointer();
+    // Grows of the L1 table retarget the dispatcher through the frame
+    Thread->LookupCache->RegisterCpuStateFrame(Thread->CurrentFrame);
 
     Dispatcher->InitThreadPointers(Thread);
 
@@ -400,7 +608,22 @@ namespace FEXCore::Context {
   }
 
   FEXCore::Core::InternalThreadState* ContextImpl::CreateThread(uint64_t InitialRIP, uint64_t StackPointer, FEXCore::Core::CPUState *NewThreadState, uint64_t ParentTID) {
-    FEXCore::Core::InternalThreadState *Thread = new FEXCore::Core::InternalThreadState{};
+    FEXCore::Core::InternalThreadState *Thread{};
+
+    // Reuse a parked thread state when one is available. It was scrubbed when
+    // it was parked, so only the expensive compiler objects carry over.
+    {
+      std::lock_guard lk(RetiredThreadStatesMutex);
+      if (!RetiredThreadStates.empty()) {
+        Thread = RetiredThreadStates.back();
+        RetiredThreadStates.pop_back();
+      }
+    }
+
+    const bool Recycled = Thread != nullptr;
+    if (!Recycled) {
+      Thread = new FEXCore::Core::InternalThreadState{};
+    }
 
     Thread->CurrentFrame->State.gregs[X86State::REG_RSP] = StackPointer;
     Thread->CurrentFrame->State.rip = InitialRIP;
@@ -414,14 +637,106 @@ namespace FEXCore::Context {
     Thread->ThreadManager.parent_tid = ParentTID;
     Thread->CurrentFrame->Thread = Thread;
 
-    InitializeCompiler(Thread);
-
     Thread->CurrentFrame->State.DeferredSignalRefCount.Store(0);
-    Thread->CurrentFrame->State.DeferredSignalFaultAddress = reinterpret_cast<Core::NonAtomicRefCounter<uint64_t>*>(FEXCore::Allocator::VirtualAlloc(4096));
+    if (!Recycled) {
+      InitializeCompiler(Thread);
+      Thread->CurrentFrame->State.DeferredSignalFaultAddress = reinterpret_cast<Core::NonAtomicRefCounter<uint64_t>*>(FEXCore::Allocator::VirtualAlloc(4096));
+    }
+
+    if (Config.FlightRecorderSampleInterval() > 0) {
+      Thread->FlightRecorderStorage.resize(Core::CpuStateFrame::FLIGHT_RECORDER_ENTRIES);
+      Thread->CurrentFrame->FlightRecorderRing = Thread->FlightRecorderStorage.data();
+      Thread->CurrentFrame->FlightRecorderIndex = 0;
+      Thread->CurrentFrame->FlightRecorderCountdown = Config.FlightRecorderSampleInterval();
+    }
 
     return Thread;
   }
 
+  bool ContextImpl::ParkRetiredThreadState(FEXCore::Core::InternalThreadState *Thread) {
+    {
+      // Racing parkers can both pass this check and momentarily overshoot the
+      // cap, the recheck before the insert below keeps the pool bounded.
+      std::lock_guard lk(RetiredThreadStatesMutex);
+      if (RetiredThreadStates.size() >= MaxRetiredThreadStates) {
+        return false;
+      }
+    }
+
+    if (SharedCodeCacheActive()) {
+      // The code buffer reset below kills any host pointers this thread
+      // published. Conservative for the same reason as ClearCodeCache, the
+      // map doesn't track the publishing thread.
+      std::unique_lock unlk(SharedCodeCacheMutex);
+      SharedCodeCacheMap.clear();
+      SpeculativePendingPublish.clear();
+    }
+
+    // Drop all translations. A parked thread is invisible to code
+    // invalidation, so nothing compiled against current guest memory may
+    // survive into the next thread. The mappings themselves stay allocated,
+    // which is the bulk of the construction cost being avoided.
+    {
+      // Dead threads destroyed after a fork can still hold their own cache
+      // lock from the parent. The delete path tolerates that, parking can't,
+      // so fall back to deletion rather than deadlocking.
+      std::unique_lock<std::recursive_mutex> lk(Thread->LookupCache->WriteLock, std::try_to_lock);
+      if (!lk.owns_lock()) {
+        return false;
+      }
+      Thread->LookupCache->ClearCache();
+      Thread->CPUBackend->ClearCache();
+      Thread->DebugStore.clear();
+      Thread->FaultSiteCache.fill({});
+    }
+    Thread->BaselineCompileCount.clear();
+    Thread->OversizedRegions.clear();
+    Thread->SpeculativeBranchTargets.clear();
+    Thread->DeferredSignalFrames.clear();
+    Thread->CompileService.reset();
+    // Same destruction point the delete path had, the host thread is already
+    // joined or detached by the frontend.
+    Thread->ExecutionThread.reset();
+    Thread->IsBackgroundCompileThread = false;
+
+    // Scrub the guest-visible state, keeping the deferred signal fault page
+    auto Frame = Thread->CurrentFrame;
+    auto FaultAddress = Frame->State.DeferredSignalFaultAddress;
+    Frame->State = FEXCore::Core::CPUState{};
+    Frame->State.DeferredSignalFaultAddress = FaultAddress;
+    Frame->ReturningStackLocation = 0;
+    Frame->InSyscallInfo = 0;
+    Frame->SignalHandlerRefCounter = 0;
+    Frame->PauseSpinCount = 0;
+    Frame->SynchronousFaultData = {};
+    memset(Frame->ReturnPredictionStack, 0, sizeof(Frame->ReturnPredictionStack));
+    Frame->ReturnPredictionIndex = 0;
+
+    // Back to the just-constructed lifecycle state
+    Thread->StatusCode = 0;
+    Thread->ExitReason = FEXCore::Context::ExitReason::EXIT_WAITING;
+    Thread->StartPaused = false;
+    Thread->RunningEvents.Running = false;
+    Thread->RunningEvents.WaitingToStart = true;
+    Thread->RunningEvents.EarlyExit = false;
+    Thread->RunningEvents.ThreadSleeping = false;
+    Thread->SignalReason = FEXCore::Core::SignalEvent::Nothing;
+    Thread->StartRunning.Reset();
+    Thread->ThreadWaiting.Reset();
+    Thread->ThreadManager.TID = 1;
+    Thread->ThreadManager.parent_tid = 0;
+    Thread->ThreadManager.set_child_tid = nullptr;
+    Thread->ThreadManager.clear_child_tid = nullptr;
+    Thread->ThreadManager.robust_list_head = 0;
+
+    std::lock_guard lk(RetiredThreadStatesMutex);
+    if (RetiredThreadStates.size() >= MaxRetiredThreadStates) {
+      return false;
+    }
+    RetiredThreadStates.emplace_back(Thread);
+    return true;
+  }
+
   void ContextImpl::DestroyThread(FEXCore::Core::InternalThreadState *Thread, bool NeedsTLSUninstall) {
     if (NeedsTLSUninstall) {
 #ifndef _WIN32
@@ -430,6 +745,11 @@ namespace FEXCore::Context {
       SignalDelegation->UninstallTLSState(Thread);
     }
 
+    // Park the state for the next guest clone instead of tearing it down
+    if (ParkRetiredThreadState(Thread)) {
+      return;
+    }
+
     FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096);
     delete Thread;
   }
@@ -440,8 +760,14 @@ namespace FEXCore::Context {
 
     if (Child) {
       CodeInvalidationMutex.StealAndDropActiveLocks();
+      if (FrontendDecodeCache) {
+        FrontendDecodeCache->Mutex.StealAndDropActiveLocks();
+      }
     }
     else {
+      if (FrontendDecodeCache) {
+        FrontendDecodeCache->Mutex.unlock();
+      }
       CodeInvalidationMutex.unlock();
       return;
     }
@@ -449,6 +775,9 @@ namespace FEXCore::Context {
 
   void ContextImpl::LockBeforeFork(FEXCore::Core::InternalThreadState *Thread) {
     CodeInvalidationMutex.lock();
+    if (FrontendDecodeCache) {
+      FrontendDecodeCache->Mutex.lock();
+    }
     Allocator::LockBeforeFork(Thread);
   }
 #endif
@@ -467,9 +796,24 @@ namespace FEXCore::Context {
     }
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
+    if (SharedCodeCacheActive()) {
+      // This thread's code buffer is getting reset, drop all shared entries.
+      // Entries published by other threads get dropped as well. Conservative, but
+      // the map doesn't track the publishing thread.
+      std::unique_lock unlk(SharedCodeCacheMutex);
+      SharedCodeCacheMap.clear();
+      SpeculativePendingPublish.clear();
+    }
+
     Thread->LookupCache->ClearCache();
     Thread->CPUBackend->ClearCache();
     Thread->DebugStore.clear();
+
+    // The code buffer reset reuses host addresses for unrelated guest code
+    Thread->FaultSiteCache.fill({});
+
+    // Host pointers in the shadow return-address stack died with the code buffer
+    memset(Thread->CurrentFrame->ReturnPredictionStack, 0, sizeof(Thread->CurrentFrame->ReturnPredictionStack));
   }
 
   static void IRDumper(FEXCore::Core::InternalThreadState *Thread, IR::IREmitter *IREmitter, uint64_t GuestRIP, IR::RegisterAllocationData* RA) {
@@ -504,7 +848,7 @@ namespace FEXCore::Context {
     }
   }
 
-  ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst) {
+  ContextImpl::GenerateIRResult ContextImpl::GenerateIR(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, bool ExtendedDebugInfo, uint64_t MaxInst, bool BaselineTier) {
     FEXCORE_PROFILE_SCOPED("GenerateIR");
 
     Thread->OpDispatcher->ReownOrClaimBuffer();
@@ -532,6 +876,11 @@ namespace FEXCore::Context {
 
       bool HadDispatchError {false};
 
+      // Leaf call inlining is profile driven through the compile tiers.
+      // Baseline compiles skip the callee probing entirely, blocks that run hot
+      // enough to earn a full recompile get their leaf calls pulled in-region.
+      Thread->FrontendDecoder->SetAllowLeafCallInlining(Config.InlineLeafCalls() && Config.Multiblock() && !BaselineTier);
+
       Thread->FrontendDecoder->DecodeInstructionsAtEntry(GuestCode, GuestRIP, MaxInst, [Thread](uint64_t BlockEntry, uint64_t Start, uint64_t Length) {
         if (Thread->LookupCache->AddBlockExecutableRange(BlockEntry, Start, Length)) {
           static_cast<ContextImpl*>(Thread->CTX)->SyscallHandler->MarkGuestExecutableRange(Thread, Start, Length);
@@ -541,6 +890,7 @@ namespace FEXCore::Context {
       auto BlockInfo = Thread->FrontendDecoder->GetDecodedBlockInfo();
       auto CodeBlocks = &BlockInfo->Blocks;
 
+      Thread->OpDispatcher->SetLeafCallInlineInfo(&BlockInfo->InlinedCallSites, &BlockInfo->PredictedReturnTargets);
       Thread->OpDispatcher->BeginFunction(GuestRIP, CodeBlocks, BlockInfo->TotalInstructionCount);
 
       const uint8_t GPRSize = GetGPRSize();
@@ -570,6 +920,10 @@ namespace FEXCore::Context {
           }
 
           if (Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) {
+            // The invalidation path below leaves the block mid-instruction with a raw
+            // branch, so any cached x87 TOP update must reach the context first.
+            Thread->OpDispatcher->FlushX87Top();
+
             auto ExistingCodePtr = reinterpret_cast<uint64_t*>(Block.Entry + BlockInstructionsLength);
 
             auto CodeChanged = Thread->OpDispatcher->_ValidateCode(ExistingCodePtr[0], ExistingCodePtr[1], (uintptr_t)ExistingCodePtr - GuestRIP, DecodedInfo->InstSize);
@@ -662,7 +1016,8 @@ namespace FEXCore::Context {
     }
 
     // Run the passmanager over the IR from the dispatcher
-    Thread->PassManager->Run(IREmitter);
+    // The baseline tier skips the optimization passes for compile latency
+    Thread->PassManager->Run(IREmitter, BaselineTier);
 
     // Debug
     {
@@ -686,7 +1041,7 @@ namespace FEXCore::Context {
     };
   }
 
-  ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t MaxInst) {
+  ContextImpl::CompileCodeResult ContextImpl::CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t MaxInst, bool BaselineTier) {
     FEXCore::IR::IRListView *IRList {};
     FEXCore::Core::DebugData *DebugData {};
     FEXCore::IR::RegisterAllocationData::UniquePtr RAData {};
@@ -735,14 +1090,18 @@ namespace FEXCore::Context {
       }
     }
 
+    uint64_t RegionInstructions {};
+
     if (IRList == nullptr) {
       // Generate IR + Meta Info
-      auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols(), MaxInst);
+      auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols(), MaxInst, BaselineTier);
+      RegionInstructions = TotalInstructions;
 
       // Setup pointers to internal structures
       IRList = IRCopy;
       RAData = std::move(RACopy);
-      DebugData = new FEXCore::Core::DebugData();
+      Thread->ScratchDebugData.Reset();
+      DebugData = &Thread->ScratchDebugData;
       StartAddr = _StartAddr;
       Length = _Length;
 
@@ -765,22 +1124,113 @@ namespace FEXCore::Context {
       .GeneratedIR = GeneratedIR,
       .StartAddr = StartAddr,
       .Length = Length,
+      .TotalInstructions = RegionInstructions,
     };
   }
 
+  int32_t ContextImpl::GetTunedTraceBudget() const {
+    return Tuner ? Tuner->TraceInstBudget() : 0;
+  }
+
+  int64_t ContextImpl::GetTunerSessionScore() const {
+    return Tuner ? Tuner->SessionScore() : -1;
+  }
+
   uintptr_t ContextImpl::CompileBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP, uint64_t MaxInst) {
     FEXCORE_PROFILE_SCOPED("CompileBlock");
     auto Thread = Frame->Thread;
 
+    if (Tuner) {
+      Tuner->Pulse();
+      SplitOversizedRegions(Thread);
+    }
+
     // Invalidate might take a unique lock on this, to guarantee that during invalidation no code gets compiled
     auto lk = GuardSignalDeferringSection<std::shared_lock>(CodeInvalidationMutex, Thread);
 
+    // Catch up on code other threads invalidated before consulting any cache
+    // below. Costs a single epoch load when nothing changed.
+    SyncThreadLookupCache(Thread);
+
     // Is the code in the cache?
     // The backends only check L1 and L2, not L3
     if (auto HostCode = Thread->LookupCache->FindBlock(GuestRIP)) {
+      // Only counts lookups that missed the backend's fast caches; the JIT
+      // resolves L1/L2 hits without ever leaving the dispatcher.
+      FEXCORE_STATS_STATIC_INIT(StatCacheHits, STAT_CODE_CACHE_HITS);
+      FEXCORE_STATS_INC(StatCacheHits);
       return HostCode;
     }
 
+    // Record the demand order before the shared-cache check, so a session
+    // whose replay already compiled a block still re-records it for the next
+    // session's profile.
+    if (Config.BootProfileReplay() && !Thread->IsBackgroundCompileThread) {
+      RecordBootProfileBlock(GuestRIP);
+    }
+
+    // Check the process-wide shared cache before compiling the block ourselves.
+    // Another thread may already have paid for the compile.
+    if (SharedCodeCacheActive()) {
+      std::shared_lock shlk(SharedCodeCacheMutex);
+      auto SharedEntry = SharedCodeCacheMap.find(GuestRIP);
+      if (SharedEntry != SharedCodeCacheMap.end()) {
+        const auto &Entry = SharedEntry->second;
+        // Mirror what GenerateIR would have done so invalidation still works on this thread.
+        if (Thread->LookupCache->AddBlockExecutableRange(GuestRIP, Entry.StartAddr, Entry.Length)) {
+          SyscallHandler->MarkGuestExecutableRange(Thread, Entry.StartAddr, Entry.Length);
+        }
+        AddBlockMapping(Thread, GuestRIP, reinterpret_cast<void*>(Entry.HostCode));
+        return Entry.HostCode;
+      }
+    }
+
+    // Tier selection. Cold blocks get a fast baseline compile that skips the
+    // optimization passes. Baseline blocks only live in the L1 cache; if a block
+    // is still being executed once its entry has been evicted then we end up
+    // back here and eventually promote it to the full tier.
+    // High priority regions (the guest unwinders) go straight to the full
+    // tier. Their blocks are cold right up until an exception throw makes
+    // them the critical path, so the warm-up that tiering relies on never
+    // happens before it matters. Full tier code is also what the object
+    // cache serializes, so these regions persist from their first touch.
+    // Latency critical threads keep their bounded baseline compile.
+    const bool HighPriorityRegion = Config.TieredCompilation() && !Thread->IsBackgroundCompileThread &&
+        !Thread->LatencyCriticalCompile && SyscallHandler &&
+        [&] {
+          auto Lookup = SyscallHandler->LookupAOTIRCacheEntry(Thread, GuestRIP);
+          return Lookup.Entry && Lookup.Entry->HighPriorityRegion;
+        }();
+
+    bool BaselineTier = false;
+    if (Config.TieredCompilation() && !Thread->IsBackgroundCompileThread && !HighPriorityRegion) {
+      constexpr uint32_t TierUpThreshold = 2;
+      auto &HitCount = Thread->BaselineCompileCount[GuestRIP];
+      if (Thread->LatencyCriticalCompile) {
+        // Latency critical threads never run the optimized compile on their
+        // own time. Once a block proves hot it's handed to the background
+        // compile thread and the full tier copy arrives through the shared
+        // code cache checked above. Without the shared cache active, blocks
+        // simply stay at the baseline tier; the latency bound holds either way.
+        BaselineTier = true;
+        if (HitCount < TierUpThreshold) {
+          ++HitCount;
+        }
+        else if (SharedCodeCacheActive()) {
+          EnqueueBackgroundCompile(GuestRIP);
+        }
+      }
+      else {
+        BaselineTier = HitCount < TierUpThreshold;
+        if (BaselineTier) {
+          ++HitCount;
+        }
+        else {
+          Thread->BaselineCompileCount.erase(GuestRIP);
+        }
+      }
+    }
+
     void *CodePtr {};
     FEXCore::IR::IRListView *IRList {};
     FEXCore::Core::DebugData *DebugData {};
@@ -788,7 +1238,10 @@ namespace FEXCore::Context {
     bool GeneratedIR {};
     uint64_t StartAddr {}, Length {};
 
-    auto [Code, IR, Data, RAData, Generated, _StartAddr, _Length] = CompileCode(Thread, GuestRIP, MaxInst);
+    const bool TimeCompile = Config.CompileTimeTelemetry();
+    const uint64_t CompileStart = TimeCompile ? CompileTime::Now() : 0;
+
+    auto [Code, IR, Data, RAData, Generated, _StartAddr, _Length, _TotalInstructions] = CompileCode(Thread, GuestRIP, MaxInst, BaselineTier);
     CodePtr = Code;
     IRList = IR;
     DebugData = Data;
@@ -800,8 +1253,40 @@ namespace FEXCore::Context {
       return 0;
     }
 
+    // Make the emitted instructions visible to this core before the dispatcher
+    // can jump to them. The background worker defers this instead: its blocks
+    // only become reachable through the batched shared-cache drain, which
+    // flushes once for the whole batch.
+    if (!Thread->IsBackgroundCompileThread) {
+      Thread->CPUBackend->FlushCodePublishWindow();
+    }
+
+    // Hand any statically known successors the frontend found to the speculative
+    // compiler. The set only fills up when SpeculativeCompilation is enabled.
+    if (!Thread->SpeculativeBranchTargets.empty()) {
+      EnqueueSpeculativeTargets(Thread);
+    }
+
+    if (TimeCompile) {
+      // Covers frontend decode, passes and the backend, so a block that's slow
+      // outside any single pass still shows up.
+      CompileTime::RecordBlockCompile(GuestRIP, CompileTime::Now() - CompileStart);
+    }
+
+    FEXCORE_STATS_STATIC_INIT(StatBlocksCompiled, STAT_BLOCKS_COMPILED);
+    FEXCORE_STATS_INC(StatBlocksCompiled);
+
+    if (!GeneratedIR && DebugData == nullptr && IRList == nullptr) {
+      // Came from the object code cache, which always contains full tier code.
+      BaselineTier = false;
+    }
+
+    // Register the block with the host frame registry. The JITCodeHeader sits
+    // directly in front of the entry point.
+    RegisterJITFrameRegion(reinterpret_cast<uint64_t>(CodePtr) - sizeof(CPU::CPUBackend::JITCodeHeader));
+
     // The core managed to compile the code.
-    if (Config.BlockJITNaming()) {
+    if (Config.BlockJITNaming() || Config.JITDump()) {
       auto FragmentBasePtr = reinterpret_cast<uint8_t *>(CodePtr);
 
       if (DebugData) {
@@ -827,17 +1312,22 @@ namespace FEXCore::Context {
     }
 
     // Tell the object cache service to serialize the code if enabled
+    // Baseline tier code is never serialized, only the final full tier compile is worth caching
     if (CodeObjectCacheService &&
+        !BaselineTier &&
         Config.CacheObjectCodeCompilation == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_READWRITE &&
         DebugData) {
+      // The serialized host code covers the whole block, beginning at the JITCodeHeader in front of the entry point
+      auto BlockBegin = reinterpret_cast<uint8_t*>(CodePtr) - sizeof(CPU::CPUBackend::JITCodeHeader);
       CodeObjectCacheService->AsyncAddSerializationJob(fextl::make_unique<CodeSerialize::AsyncJobHandler::SerializationJobData>(
         CodeSerialize::AsyncJobHandler::SerializationJobData {
           .GuestRIP = GuestRIP,
+          .GuestCodeStart = StartAddr,
           .GuestCodeLength = Length,
-          .GuestCodeHash = 0,
-          .HostCodeBegin = CodePtr,
+          .GuestCodeHash = XXH3_64bits(reinterpret_cast<const void*>(StartAddr), Length),
+          .HostCodeBegin = BlockBegin,
           .HostCodeLength = DebugData->HostCodeSize,
-          .HostCodeHash = 0,
+          .HostCodeHash = XXH3_64bits(BlockBegin, DebugData->HostCodeSize),
           .ThreadJobRefCount = &Thread->ObjectCacheRefCounter,
           .Relocations = std::move(*DebugData->Relocations),
         }
@@ -847,6 +1337,12 @@ namespace FEXCore::Context {
     // Clear any relocations that might have been generated
     Thread->CPUBackend->ClearRelocations();
 
+    // Hand a sampled copy of this compilation to the shadow validation worker
+    // before the capture cache takes ownership of the IR below.
+    if (Config.ShadowValidation() && IRList) {
+      MaybeCaptureShadowValidation(IRList, RAData.get());
+    }
+
     if (IRCaptureCache.PostCompileCode(
         Thread,
         CodePtr,
@@ -861,18 +1357,96 @@ namespace FEXCore::Context {
       return (uintptr_t)CodePtr;
     }
 
+    // Publish full tier blocks to the shared cache for other threads.
+    // Baseline blocks are transient and not worth sharing.
+    if (SharedCodeCacheActive() && !BaselineTier && GeneratedIR) {
+      std::unique_lock unlk(SharedCodeCacheMutex);
+      const SharedCodeCacheEntry Entry {
+        .HostCode = reinterpret_cast<uint64_t>(CodePtr),
+        .StartAddr = StartAddr,
+        .Length = Length,
+      };
+      if (Thread->IsBackgroundCompileThread) {
+        // Not reachable yet; the worker drains its batch with one ranged
+        // instruction-cache flush before these hit the map.
+        SpeculativePendingPublish.emplace_back(GuestRIP, Entry);
+      }
+      else {
+        SharedCodeCacheMap.insert_or_assign(GuestRIP, Entry);
+      }
+    }
+
+    // Remember full tier multiblock regions that consumed more than half the
+    // trace budget. If PMU feedback later narrows the budget below their size,
+    // SplitOversizedRegions drops them so they recompile as a budget-sized hot
+    // head with the tail reached through the dispatcher.
+    if (Tuner && !BaselineTier && GeneratedIR && !Thread->IsBackgroundCompileThread &&
+        _TotalInstructions * 2 > static_cast<uint64_t>(Tuner->TraceInstBudget())) {
+      Thread->OversizedRegions.emplace_back(GuestRIP, _TotalInstructions);
+    }
+
     // Insert to lookup cache
     // Pages containing this block are added via AddBlockExecutableRange before each page gets accessed in the frontend
-    AddBlockMapping(Thread, GuestRIP, CodePtr);
+    if (BaselineTier) {
+      // Baseline blocks are only visible through L1 so that hot blocks come back for a full tier compile
+      Thread->LookupCache->AddBlockMappingL1Only(GuestRIP, CodePtr);
+    }
+    else {
+      AddBlockMapping(Thread, GuestRIP, CodePtr);
+    }
 
     return (uintptr_t)CodePtr;
   }
 
+#if !defined(_WIN32) && defined(SYS_rseq)
+  // Registers the frame's rseq area with the host kernel so it tracks this
+  // thread's current CPU for us. On failure the area's CPUId stays negative
+  // and the JIT's ProcessorID lowering keeps using the getcpu syscall.
+  static void RegisterHostRSeq(FEXCore::Core::InternalThreadState *Thread) {
+    auto Frame = Thread->CurrentFrame;
+    // The signature is only validated on a critical-section abort, which we
+    // never set up. Match glibc's value so a debugger recognizes the area.
+    constexpr uint32_t RSEQ_SIG = 0x53053053;
+    ::syscall(SYS_rseq, &Frame->RSeq, sizeof(Frame->RSeq), 0, RSEQ_SIG);
+
+    // Seed the node cache so the fast path reports the correct node even if
+    // the syscall fallback never runs to refresh it
+    uint32_t CPU{};
+    uint32_t Node{};
+    if (::syscall(SYS_getcpu, &CPU, &Node) == 0) {
+      Frame->RSeqNodeId = Node;
+    }
+  }
+
+  static void UnregisterHostRSeq(FEXCore::Core::InternalThreadState *Thread) {
+    auto Frame = Thread->CurrentFrame;
+    constexpr uint32_t RSEQ_SIG = 0x53053053;
+    constexpr int RSEQ_FLAG_UNREGISTER = 1;
+    // The thread state can outlive this execution thread, so hand the area
+    // back before the kernel can write to freed memory. Harmless no-op if
+    // registration failed.
+    ::syscall(SYS_rseq, &Frame->RSeq, sizeof(Frame->RSeq), RSEQ_FLAG_UNREGISTER, RSEQ_SIG);
+    Frame->RSeq.CPUId = ~0U;
+  }
+#endif
+
   void ContextImpl::ExecutionThread(FEXCore::Core::InternalThreadState *Thread) {
     Thread->ExitReason = FEXCore::Context::ExitReason::EXIT_WAITING;
 
     InitializeThreadTLSData(Thread);
 
+#if !defined(_WIN32) && defined(SYS_rseq)
+    RegisterHostRSeq(Thread);
+#endif
+
+    if (Config.NUMALocalPlacement()) {
+      // The thread's lookup cache and initial code buffer were allocated by the parent
+      // thread, which may be running on a different node. Their pages are still mostly
+      // unfaulted at this point, so rebinding from this thread steers them local.
+      Thread->CPUBackend->BindCodeBuffersToLocalNode();
+      Thread->LookupCache->BindToLocalNode();
+    }
+
     // Now notify the thread that we are initialized
     Thread->ThreadWaiting.NotifyAll();
 
@@ -911,6 +1485,10 @@ namespace FEXCore::Context {
       }
     }
 
+#if !defined(_WIN32) && defined(SYS_rseq)
+    UnregisterHostRSeq(Thread);
+#endif
+
 #ifndef _WIN32
     Alloc::OSAllocator::UninstallTLSData(Thread);
 #endif
@@ -920,14 +1498,137 @@ namespace FEXCore::Context {
   static void InvalidateGuestThreadCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) {
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
+    FEXCORE_STATS_STATIC_INIT(StatSMCInvalidations, STAT_SMC_INVALIDATIONS);
+    FEXCORE_STATS_INC(StatSMCInvalidations);
+
+    const uint64_t End = Start + Length - 1;
     auto lower = Thread->LookupCache->CodePages.lower_bound(Start >> 12);
-    auto upper = Thread->LookupCache->CodePages.upper_bound((Start + Length - 1) >> 12);
+    auto upper = Thread->LookupCache->CodePages.upper_bound(End >> 12);
 
     for (auto it = lower; it != upper; it++) {
-      for (auto Address: it->second) {
-        ContextImpl::ThreadRemoveCodeEntry(Thread, Address);
+      // Only blocks overlapping the written 256-byte chunks are removed, so a
+      // guest JIT patching one call site doesn't take out every block that
+      // happens to share the page.
+      const uint64_t PageBase = it->first << 12;
+      const uint64_t FirstOffset = std::max(Start, PageBase) - PageBase;
+      const uint64_t LastOffset = std::min(End, PageBase + 0x0FFF) - PageBase;
+      const uint16_t WrittenMask = LookupCache::ChunkMaskForRange(FirstOffset, LastOffset);
+
+      auto &Blocks = it->second;
+      Blocks.erase(std::remove_if(Blocks.begin(), Blocks.end(), [&](const LookupCache::PageCoverage &Block) {
+        if ((Block.ChunkMask & WrittenMask) == 0) {
+          return false;
+        }
+        ContextImpl::ThreadRemoveCodeEntry(Thread, Block.Address);
+        return true;
+      }), Blocks.end());
+    }
+  }
+
+  void ContextImpl::AppendInvalidatedRangeToJournal(uint64_t Start, uint64_t Length) {
+    // CodeInvalidationMutex is held uniquely here, so there is exactly one
+    // appender and nobody can be replaying the ring concurrently.
+    const uint64_t Epoch = InvalidationJournal.Epoch.load(std::memory_order_relaxed);
+    InvalidationJournal.Ring[Epoch % CodeInvalidationJournal::NumEntries] = {Start, Length};
+
+    // Remember which pages invalidate while live; future links into them get
+    // a generation-stamp guard instead of a plain direct branch. Whole-region
+    // teardowns don't predict future SMC, so only writer-sized ranges mark.
+    constexpr uint64_t MaxVolatileRangePages = 16;
+    const uint64_t FirstPage = Start >> 12;
+    const uint64_t LastPage = (Start + Length - 1) >> 12;
+    if (LastPage - FirstPage < MaxVolatileRangePages) {
+      for (uint64_t Page = FirstPage; Page <= LastPage; ++Page) {
+        VolatileCodePages.insert(Page);
+      }
+    }
+
+    // The shared map isn't owned by any thread, so per-thread lazy replay
+    // can't cover it. Scrub overlapping entries now or a catching-up thread
+    // would simply republish the stale code from here.
+    if (SharedCodeCacheActive()) {
+      std::unique_lock unlk(SharedCodeCacheMutex);
+      const uint64_t End = Start + Length;
+      auto Overlaps = [Start, End](const SharedCodeCacheEntry &Entry) {
+        return Entry.StartAddr < End && Start < Entry.StartAddr + Entry.Length;
+      };
+      for (auto it = SharedCodeCacheMap.begin(); it != SharedCodeCacheMap.end();) {
+        if (Overlaps(it->second)) {
+          it = SharedCodeCacheMap.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      std::erase_if(SpeculativePendingPublish, [&](const auto &Pending) {
+        return Overlaps(Pending.second);
+      });
+    }
+
+    InvalidationJournal.Epoch.store(Epoch + 1, std::memory_order_release);
+  }
+
+  void ContextImpl::SyncThreadLookupCache(FEXCore::Core::InternalThreadState *Thread) {
+    const uint64_t Current = InvalidationJournal.Epoch.load(std::memory_order_acquire);
+    uint64_t &Seen = Thread->LookupCache->InvalidationJournalEpoch;
+    if (Current == Seen) {
+      // Steady state: no SMC anywhere since this thread last dispatched.
+      return;
+    }
+
+    if (Current - Seen > CodeInvalidationJournal::NumEntries) {
+      // The ring wrapped past this thread; the missed entries are gone.
+      // Resynchronize wholesale with the same single-thread lookup cache
+      // clear MarkMemoryShared relies on.
+      std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
+      Thread->LookupCache->ClearCache();
+      Thread->DebugStore.clear();
+      memset(Thread->CurrentFrame->ReturnPredictionStack, 0, sizeof(Thread->CurrentFrame->ReturnPredictionStack));
+    } else {
+      for (uint64_t Entry = Seen; Entry != Current; ++Entry) {
+        const auto &Range = InvalidationJournal.Ring[Entry % CodeInvalidationJournal::NumEntries];
+        InvalidateGuestThreadCodeRange(Thread, Range.Start, Range.Length);
+      }
+    }
+
+    Seen = Current;
+  }
+
+  void ContextImpl::SplitOversizedRegions(FEXCore::Core::InternalThreadState *Thread) {
+    const uint32_t Generation = Tuner->NarrowGeneration();
+    if (Generation == Thread->ReconciledNarrowGeneration) {
+      // Steady state: the tuner hasn't narrowed since this thread last checked.
+      return;
+    }
+    Thread->ReconciledNarrowGeneration = Generation;
+
+    const auto Budget = static_cast<uint64_t>(Tuner->TraceInstBudget());
+
+    // Entry removal requires the invalidation lock held uniquely, the same as
+    // the SMC paths. Only reached on an actual narrowing event.
+    auto lk = GuardSignalDeferringSection<std::unique_lock>(CodeInvalidationMutex, Thread);
+    std::erase_if(Thread->OversizedRegions, [&](const auto &Region) {
+      if (Region.second <= Budget) {
+        // Still within budget; keep it tracked in case the budget narrows further.
+        return false;
       }
-      it->second.clear();
+      // Dropping the entry forces a fresh compile at the narrowed budget,
+      // which forms the hot head. Tail blocks that still execute reach the
+      // dispatcher as side exits and compile as their own linked regions,
+      // while tails that never run are never recompiled at all - region
+      // growth past this point is paid for only by code that proves itself.
+      ThreadRemoveCodeEntry(Thread, Region.first);
+      return true;
+    });
+  }
+
+  void ContextImpl::InvalidateSpeculativeThreadCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) {
+    // The speculative thread's blocks live in its own lookup cache, which no
+    // thread manager iterates on invalidation. Scrub it here so a stale block
+    // can't be republished through the shared cache after the guest code changed.
+    // CodeInvalidationMutex is held uniquely here so the worker can't be mid-compile.
+    auto *SpecThread = SpeculativeThreadState.load();
+    if (SpecThread && SpecThread != Thread) {
+      InvalidateGuestThreadCodeRange(SpecThread, Start, Length);
     }
   }
 
@@ -937,7 +1638,19 @@ namespace FEXCore::Context {
     // To be more optimal the frontend should provide this code with a valid Thread object earlier.
     auto lk = GuardSignalDeferringSectionWithFallback(CodeInvalidationMutex, Thread);
 
-    InvalidateGuestThreadCodeRange(Thread, Start, Length);
+    // Only the calling thread and the speculative worker get scrubbed
+    // eagerly; everyone else picks the journal entry up at their next
+    // dispatcher entry. Catch up on other writers' entries first so the
+    // epoch stamp below doesn't skip them.
+    if (Thread) {
+      SyncThreadLookupCache(Thread);
+      InvalidateGuestThreadCodeRange(Thread, Start, Length);
+    }
+    InvalidateSpeculativeThreadCodeRange(Thread, Start, Length);
+    AppendInvalidatedRangeToJournal(Start, Length);
+    if (Thread) {
+      Thread->LookupCache->InvalidationJournalEpoch = InvalidationJournal.Epoch.load(std::memory_order_relaxed);
+    }
   }
 
   void ContextImpl::InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn CallAfter) {
@@ -946,10 +1659,54 @@ namespace FEXCore::Context {
     // To be more optimal the frontend should provide this code with a valid Thread object earlier.
     auto lk = GuardSignalDeferringSectionWithFallback(CodeInvalidationMutex, Thread);
 
-    InvalidateGuestThreadCodeRange(Thread, Start, Length);
+    if (Thread) {
+      SyncThreadLookupCache(Thread);
+      InvalidateGuestThreadCodeRange(Thread, Start, Length);
+    }
+    InvalidateSpeculativeThreadCodeRange(Thread, Start, Length);
+    AppendInvalidatedRangeToJournal(Start, Length);
+    if (Thread) {
+      Thread->LookupCache->InvalidationJournalEpoch = InvalidationJournal.Epoch.load(std::memory_order_relaxed);
+    }
     CallAfter(Start, Length);
   }
 
+  bool ContextImpl::SetGuestWatchpoint(uint64_t Address, uint64_t Size, FEXCore::Context::WatchpointType Type) {
+    for (auto &Watchpoint : GuestWatchpoints) {
+      if (Watchpoint.Enabled) {
+        continue;
+      }
+
+      Watchpoint = {
+        .Address = Address,
+        .Size = Size,
+        .Type = Type,
+        .Enabled = true,
+      };
+      ActiveGuestWatchpoints.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    // All slots in use, matching the four hardware debug registers
+    return false;
+  }
+
+  bool ContextImpl::ClearGuestWatchpoint(uint64_t Address, uint64_t Size) {
+    for (auto &Watchpoint : GuestWatchpoints) {
+      if (!Watchpoint.Enabled ||
+          Watchpoint.Address != Address ||
+          Watchpoint.Size != Size) {
+        continue;
+      }
+
+      Watchpoint.Enabled = false;
+      ActiveGuestWatchpoints.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    return false;
+  }
+
   void ContextImpl::MarkMemoryShared(FEXCore::Core::InternalThreadState *Thread) {
     if (!IsMemoryShared) {
       IsMemoryShared = true;
@@ -966,6 +1723,126 @@ namespace FEXCore::Context {
     }
   }
 
+  void ContextImpl::ReloadLiveTunables() {
+    // Only the options consumed per-compile and safe to flip under running
+    // threads. TSO mode is deliberately absent: already-compiled blocks would
+    // keep the old memory model and mix with new ones.
+    Config.Multiblock = decltype(Config.Multiblock) {FEXCore::Config::CONFIG_MULTIBLOCK, FEXCore::Config::DefaultValues::MULTIBLOCK};
+    Config.MaxInstPerBlock = decltype(Config.MaxInstPerBlock) {FEXCore::Config::CONFIG_MAXINST, FEXCore::Config::DefaultValues::MAXINST};
+    Config.MultiblockTraceInst = decltype(Config.MultiblockTraceInst) {FEXCore::Config::CONFIG_MULTIBLOCKTRACEINST, FEXCore::Config::DefaultValues::MULTIBLOCKTRACEINST};
+    Config.MultiblockLoopRange = decltype(Config.MultiblockLoopRange) {FEXCore::Config::CONFIG_MULTIBLOCKLOOPRANGE, FEXCore::Config::DefaultValues::MULTIBLOCKLOOPRANGE};
+    Config.InlineLeafCalls = decltype(Config.InlineLeafCalls) {FEXCore::Config::CONFIG_INLINELEAFCALLS, FEXCore::Config::DefaultValues::INLINELEAFCALLS};
+    Config.DisableTelemetry = decltype(Config.DisableTelemetry) {FEXCore::Config::CONFIG_DISABLETELEMETRY, FEXCore::Config::DefaultValues::DISABLETELEMETRY};
+  }
+
+  void ContextImpl::RecordCallGraphEdge(uint64_t SourceRIP, uint64_t TargetRIP) {
+    std::lock_guard lk(CallGraphMutex);
+    if (CallGraphExportFailed) {
+      return;
+    }
+
+    CallGraphBuffer.emplace_back(CallGraphEdge { SourceRIP, TargetRIP });
+    if (CallGraphBuffer.size() >= CallGraphFlushThreshold) {
+      FlushCallGraphBuffer();
+    }
+  }
+
+  void ContextImpl::FlushCallGraphBuffer() {
+    if (CallGraphFD == -1) {
+      const auto Dir = fextl::fmt::format("{}/callgraph", FEXCore::Config::GetDataDirectory());
+      if (!FHU::Filesystem::CreateDirectories(Dir)) {
+        CallGraphExportFailed = true;
+        return;
+      }
+
+      const auto Filename = fextl::fmt::format("{}/{}.fexcg", Dir, ::getpid());
+      CallGraphFD = open(Filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (CallGraphFD == -1) {
+        CallGraphExportFailed = true;
+        return;
+      }
+
+      const uint64_t Cookie = CALLGRAPH_COOKIE;
+      write(CallGraphFD, &Cookie, sizeof(Cookie));
+    }
+
+    write(CallGraphFD, CallGraphBuffer.data(), CallGraphBuffer.size() * sizeof(CallGraphEdge));
+    CallGraphBuffer.clear();
+  }
+
+  fextl::string ContextImpl::BootProfilePath() {
+    // Keyed on the full executable path so same-named binaries in different
+    // prefixes keep separate profiles, while staying readable in the directory.
+    const fextl::string Program = AppFilename();
+    return fextl::fmt::format("{}bootprofile/{}-{:016x}.fexbp", FEXCore::Config::GetDataDirectory(),
+                              FHU::Filesystem::GetFilename(Program), XXH3_64bits(Program.data(), Program.size()));
+  }
+
+  void ContextImpl::RecordBootProfileBlock(uint64_t GuestRIP) {
+    std::lock_guard lk(BootProfileMutex);
+    if (BootProfileWindowClosed) {
+      return;
+    }
+    if (std::chrono::steady_clock::now() - BootProfileStart > BootProfileWindow) {
+      // Startup is over; whatever compiles from here on is workload, not boot.
+      BootProfileWindowClosed = true;
+      return;
+    }
+
+    if (BootProfileSeen.insert(GuestRIP).second) {
+      BootProfileBlocks.push_back(GuestRIP);
+    }
+  }
+
+  void ContextImpl::ReplayBootProfile() {
+    fextl::vector<char> Data;
+    if (!FEXCore::FileLoading::LoadFile(Data, BootProfilePath())) {
+      // First session of this binary, nothing to replay yet.
+      return;
+    }
+
+    if (Data.size() < sizeof(uint64_t) ||
+        (Data.size() - sizeof(uint64_t)) % sizeof(uint64_t) != 0) {
+      return;
+    }
+
+    uint64_t Cookie{};
+    memcpy(&Cookie, Data.data(), sizeof(Cookie));
+    if (Cookie != BOOTPROFILE_COOKIE) {
+      return;
+    }
+
+    // Feed the whole list in recorded order. The background queue caps its
+    // depth and drops the tail; those blocks compile on demand like before.
+    const size_t Count = (Data.size() - sizeof(uint64_t)) / sizeof(uint64_t);
+    for (size_t i = 0; i < Count; ++i) {
+      uint64_t GuestRIP{};
+      memcpy(&GuestRIP, Data.data() + sizeof(uint64_t) * (i + 1), sizeof(GuestRIP));
+      EnqueueBackgroundCompile(GuestRIP);
+    }
+  }
+
+  void ContextImpl::WriteBootProfile() {
+    if (BootProfileBlocks.empty()) {
+      return;
+    }
+
+    const auto Dir = fextl::fmt::format("{}bootprofile", FEXCore::Config::GetDataDirectory());
+    if (!FHU::Filesystem::CreateDirectories(Dir)) {
+      return;
+    }
+
+    const int FD = open(BootProfilePath().c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (FD == -1) {
+      return;
+    }
+
+    const uint64_t Cookie = BOOTPROFILE_COOKIE;
+    write(FD, &Cookie, sizeof(Cookie));
+    write(FD, BootProfileBlocks.data(), BootProfileBlocks.size() * sizeof(uint64_t));
+    close(FD);
+  }
+
   void ContextImpl::ThreadAddBlockLink(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestDestination, uintptr_t HostLink, const std::function<void()> &delinker) {
     auto lk = GuardSignalDeferringSection<std::shared_lock>(static_cast<ContextImpl*>(Thread->CTX)->CodeInvalidationMutex, Thread);
 
@@ -977,8 +1854,21 @@ namespace FEXCore::Context {
 
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
+    auto CTX = static_cast<ContextImpl*>(Thread->CTX);
+    if (CTX->SharedCodeCacheActive()) {
+      std::unique_lock unlk(CTX->SharedCodeCacheMutex);
+      CTX->SharedCodeCacheMap.erase(GuestRIP);
+      // The worker may hold an unpublished copy of the same block.
+      std::erase_if(CTX->SpeculativePendingPublish, [GuestRIP](const auto &Pending) {
+        return Pending.first == GuestRIP;
+      });
+    }
+
     Thread->DebugStore.erase(GuestRIP);
     Thread->LookupCache->Erase(GuestRIP);
+
+    // Cached host pointers in the shadow return-address stack may now be stale
+    memset(Thread->CurrentFrame->ReturnPredictionStack, 0, sizeof(Thread->CurrentFrame->ReturnPredictionStack));
   }
 
   CustomIRResult ContextImpl::AddCustomIREntrypoint(uintptr_t Entrypoint, CustomIREntrypointHandler Handler, void *Creator, void *Data) {
@@ -1035,4 +1925,332 @@ namespace FEXCore::Context {
     Thread->FrontendDecoder->SetExternalBranches(ExternalBranches);
     Thread->FrontendDecoder->SetSectionMaxAddress(SectionMaxAddress);
   }
+
+  static void* SpeculativeThreadHandler(void *Arg) {
+    reinterpret_cast<ContextImpl*>(Arg)->SpeculativeCompilerThread();
+    return nullptr;
+  }
+
+  void ContextImpl::EnqueueSpeculativeTargets(FEXCore::Core::InternalThreadState *Thread) {
+    std::lock_guard lk(SpeculativeQueueMutex);
+
+    if (!SpeculativeThreadStarted) {
+      uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+      SpeculativeThreadHandle = FEXCore::Threads::Thread::Create(SpeculativeThreadHandler, this);
+      FEXCore::Threads::SetSignalMask(OldMask);
+      SpeculativeThreadStarted = true;
+    }
+
+    bool Queued = false;
+    for (auto Target : Thread->SpeculativeBranchTargets) {
+      if (SpeculativeQueue.size() >= MaxSpeculativeQueueDepth) {
+        // Queue is saturated, drop the rest. Execution will compile them on demand.
+        break;
+      }
+
+      // Skip targets this thread has already compiled. The worker rechecks
+      // against its own cache and the shared map before compiling.
+      if (Thread->LookupCache->FindBlock(Target)) {
+        continue;
+      }
+
+      SpeculativeQueue.push_back(Target);
+      Queued = true;
+    }
+
+    Thread->SpeculativeBranchTargets.clear();
+
+    if (Queued) {
+      SpeculativeWorkAvailable.NotifyOne();
+    }
+  }
+
+  void ContextImpl::PretranslateRIP(uint64_t GuestRIP) {
+    // Without a background compile consumer the shared cache is never
+    // consulted, so there is nobody to hand the block to. The first execution
+    // then compiles it like any other block.
+    if (!SharedCodeCacheActive() || GuestRIP == 0) {
+      return;
+    }
+
+    EnqueueBackgroundCompile(GuestRIP);
+  }
+
+  void ContextImpl::EnqueueBackgroundCompile(uint64_t Target) {
+    std::lock_guard lk(SpeculativeQueueMutex);
+
+    if (!SpeculativeThreadStarted) {
+      uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+      SpeculativeThreadHandle = FEXCore::Threads::Thread::Create(SpeculativeThreadHandler, this);
+      FEXCore::Threads::SetSignalMask(OldMask);
+      SpeculativeThreadStarted = true;
+    }
+
+    if (SpeculativeQueue.size() >= MaxSpeculativeQueueDepth) {
+      // Saturated. The requesting thread keeps running its baseline copy and
+      // will re-enqueue on its next lookup miss.
+      return;
+    }
+
+    SpeculativeQueue.push_back(Target);
+    SpeculativeWorkAvailable.NotifyOne();
+  }
+
+  void ContextImpl::DrainSpeculativePublishes(FEXCore::Core::InternalThreadState *Thread) {
+    {
+      std::shared_lock shlk(SharedCodeCacheMutex);
+      if (SpeculativePendingPublish.empty()) {
+        return;
+      }
+    }
+
+    // One ranged maintenance operation covers every block compiled since the
+    // previous drain. It must land before the map inserts below make the
+    // blocks reachable from executing threads.
+    Thread->CPUBackend->FlushCodePublishWindow();
+
+    std::unique_lock unlk(SharedCodeCacheMutex);
+    for (const auto &[GuestRIP, Entry] : SpeculativePendingPublish) {
+      SharedCodeCacheMap.insert_or_assign(GuestRIP, Entry);
+    }
+    SpeculativePendingPublish.clear();
+  }
+
+  void ContextImpl::SpeculativeCompilerThread() {
+    FEXCore::Threads::SetThreadName("SpeculativeJIT\0");
+
+#ifndef _WIN32
+    // Stay out of the way of threads actually running guest code
+    setpriority(PRIO_PROCESS, FHU::Syscalls::gettid(), 19);
+
+    if (Config.AuxiliaryThreadAffinity()) {
+      // Keep the worker off the cores guest threads want: efficiency cores
+      // when the host has them, an SMT sibling otherwise.
+      FEXCore::CPUInfo::PinThisThreadToAuxiliaryCPUs();
+    }
+#endif
+
+    // The worker compiles with its own backing FEX thread, like AOT generation does.
+    // Its blocks only become reachable once published to the shared code cache.
+    auto Thread = CreateThread(0, 0, nullptr, 0);
+    Thread->IsBackgroundCompileThread = true;
+    SpeculativeThreadState.store(Thread);
+
+    while (!SpeculativeShuttingDown.load()) {
+      uint64_t Target{};
+      bool HasWork = false;
+
+      {
+        std::lock_guard lk(SpeculativeQueueMutex);
+        if (!SpeculativeQueue.empty()) {
+          Target = SpeculativeQueue.front();
+          SpeculativeQueue.pop_front();
+          HasWork = true;
+        }
+      }
+
+      if (!HasWork) {
+        // Publish whatever is still batched before sleeping so the last few
+        // blocks of a burst don't sit invisible until the next wakeup.
+        DrainSpeculativePublishes(Thread);
+        SpeculativeWorkAvailable.Wait();
+        continue;
+      }
+
+      // Already compiled here, or an executing thread beat us to it.
+      if (Thread->LookupCache->FindBlock(Target)) {
+        continue;
+      }
+      {
+        std::shared_lock shlk(SharedCodeCacheMutex);
+        if (SharedCodeCacheMap.find(Target) != SharedCodeCacheMap.end()) {
+          continue;
+        }
+      }
+
+#ifndef _WIN32
+      // The target may have been unmapped since it was queued and CompileBlock
+      // would fault decoding it. mincore answers without touching the memory.
+      // An unmap can still race in afterwards, but that is the same window
+      // executing threads already have between lookup miss and decode.
+      unsigned char Resident{};
+      if (mincore(reinterpret_cast<void*>(Target & ~uint64_t(FHU::FEX_PAGE_SIZE - 1)), 1, &Resident) == -1) {
+        continue;
+      }
+#endif
+
+      // Compiles the block and batches it for shared-cache publication.
+      // Successors the frontend discovers get queued right back here, so
+      // speculation walks ahead of execution through statically reachable code.
+      CompileRIP(Thread, Target);
+
+      // Broadcast instruction-cache maintenance is expensive on many-core
+      // hosts, so it's amortized: the freshly compiled blocks stay batched
+      // until enough accumulate for one ranged flush to cover them all.
+      bool BatchFull{};
+      {
+        std::shared_lock shlk(SharedCodeCacheMutex);
+        BatchFull = SpeculativePendingPublish.size() >= SpeculativePublishBatch;
+      }
+      if (BatchFull) {
+        DrainSpeculativePublishes(Thread);
+      }
+    }
+
+    // The context destructor joins this thread and then destroys Thread, so the
+    // shared cache entries pointing into its code buffer die with the context.
+  }
+
+  namespace {
+    // Sits in the "RA" slot of the shadow validation pass manager so
+    // RAValidation finds the captured allocation map through its usual pass
+    // lookup. Never runs as a pass and never allocates anything itself.
+    class ShadowRADataHolder final : public FEXCore::IR::RegisterAllocationPass {
+    public:
+      bool Run(FEXCore::IR::IREmitter *IREmit) override { return false; }
+      void AllocateRegisterSet(uint32_t ClassCount) override {}
+      void AddRegisters(FEXCore::IR::RegisterClassType Class, uint32_t RegisterCount) override {}
+      void AddRegisterConflict(FEXCore::IR::RegisterClassType ClassConflict, uint32_t RegConflict, FEXCore::IR::RegisterClassType Class, uint32_t Reg) override {}
+      FEXCore::IR::RegisterAllocationData *GetAllocationData() override { return Data; }
+      std::unique_ptr<FEXCore::IR::RegisterAllocationData, FEXCore::IR::RegisterAllocationDataDeleter> PullAllocationData() override { return nullptr; }
+
+      FEXCore::IR::RegisterAllocationData *Data {};
+    };
+  }
+
+  static void* ShadowValidationThreadHandler(void *Arg) {
+    reinterpret_cast<ContextImpl*>(Arg)->ShadowValidationThread();
+    return nullptr;
+  }
+
+  void ContextImpl::MaybeCaptureShadowValidation(FEXCore::IR::IRListView *IRList, const FEXCore::IR::RegisterAllocationData *RAData) {
+    if (ShadowValidationCounter.fetch_add(1, std::memory_order_relaxed) % Config.ShadowValidation() != 0) {
+      return;
+    }
+
+    std::lock_guard lk(ShadowValidationQueueMutex);
+    if (ShadowValidationQueue.size() >= MaxShadowValidationQueueDepth) {
+      // Saturated, drop the sample. The counter keeps ticking so the samples
+      // stay spread across the whole compile stream.
+      return;
+    }
+
+    if (!ShadowValidationThreadStarted) {
+      uint64_t OldMask = FEXCore::Threads::SetSignalMask(~0ULL);
+      ShadowValidationThreadHandle = FEXCore::Threads::Thread::Create(ShadowValidationThreadHandler, this);
+      FEXCore::Threads::SetSignalMask(OldMask);
+      ShadowValidationThreadStarted = true;
+    }
+
+    ShadowValidationQueue.push_back(ShadowValidationJob {
+      .IR = fextl::unique_ptr<FEXCore::IR::IRListView>(IRList->CreateCopy()),
+      .RAData = RAData ? RAData->CreateCopy() : nullptr,
+    });
+    ShadowValidationWorkAvailable.NotifyOne();
+  }
+
+  void ContextImpl::ShadowValidationThread() {
+    FEXCore::Threads::SetThreadName("ShadowValidate\0");
+
+#ifndef _WIN32
+    // Validation runs strictly on spare cycles.
+    setpriority(PRIO_PROCESS, FHU::Syscalls::gettid(), 19);
+#endif
+
+    // The worker replays captured compilations through its own emitter and a
+    // pass manager holding only the validation passes. Loading a capture into
+    // the emitter is enough for them: they walk the IR through ViewIR() and
+    // never emit anything.
+    FEXCore::Utils::PooledAllocatorVirtual Allocator;
+    FEXCore::IR::IREmitter Emitter {Allocator};
+    FEXCore::IR::PassManager Validation{};
+    auto *RAHolder = static_cast<ShadowRADataHolder*>(Validation.InsertPass(fextl::make_unique<ShadowRADataHolder>(), "RA"));
+    Validation.InsertPass(FEXCore::IR::Validation::CreateIRValidation(), "IRValidation");
+    Validation.InsertPass(FEXCore::IR::Validation::CreateRAValidation());
+    Validation.InsertPass(FEXCore::IR::Validation::CreateValueDominanceValidation());
+
+    FEXCORE_TELEMETRY_STATIC_INIT(ValidatedBlocks, TYPE_SHADOW_VALIDATED_BLOCKS);
+
+    while (!ShadowValidationShuttingDown.load()) {
+      ShadowValidationJob Job{};
+      bool HasWork = false;
+
+      {
+        std::lock_guard lk(ShadowValidationQueueMutex);
+        if (!ShadowValidationQueue.empty()) {
+          Job = std::move(ShadowValidationQueue.front());
+          ShadowValidationQueue.pop_front();
+          HasWork = true;
+        }
+      }
+
+      if (!HasWork) {
+        ShadowValidationWorkAvailable.Wait();
+        continue;
+      }
+
+      Emitter.LoadFromView(*Job.IR);
+      RAHolder->Data = Job.RAData.get();
+      Validation.Run(&Emitter);
+      RAHolder->Data = nullptr;
+
+      FEXCORE_TELEMETRY_INC(ValidatedBlocks);
+    }
+  }
+
+#ifndef _WIN32
+  void ContextImpl::RSSGovernorThread() {
+    FEXCore::Threads::SetThreadName("FEX:RSSGovernor\0");
+
+    // Only ever burns cycles when the process is already over budget.
+    setpriority(PRIO_PROCESS, FHU::Syscalls::gettid(), 19);
+
+    const uint64_t RSSBudget = uint64_t(Config.RSSLimit()) << 20;
+    const uint64_t PageSize = sysconf(_SC_PAGESIZE);
+
+    while (!RSSGovernorShuttingDown.load()) {
+      RSSGovernorWake.WaitFor(std::chrono::seconds(10));
+      if (RSSGovernorShuttingDown.load()) {
+        break;
+      }
+
+      // statm field two is the resident page count.
+      uint64_t ResidentPages{};
+      {
+        int FD = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+        if (FD == -1) {
+          continue;
+        }
+        char Buffer[64]{};
+        ssize_t Result = pread(FD, Buffer, sizeof(Buffer) - 1, 0);
+        close(FD);
+        if (Result <= 0 ||
+            sscanf(Buffer, "%*lu %lu", &ResidentPages) != 1) {
+          continue;
+        }
+      }
+
+      if (ResidentPages * PageSize <= RSSBudget) {
+        continue;
+      }
+
+      // Over budget. Drop the parked thread states first; they pin a JIT code
+      // buffer and lookup cache each and only exist to speed up the next guest
+      // clone, which will simply pay the full construction cost again.
+      {
+        std::lock_guard lk(RetiredThreadStatesMutex);
+        for (auto *Thread : RetiredThreadStates) {
+          FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(Thread->CurrentFrame->State.DeferredSignalFaultAddress), 4096);
+          delete Thread;
+        }
+        RetiredThreadStates.clear();
+      }
+
+      // Then return the allocator's dirty pages. Freed IR, decoder scratch and
+      // retired code buffers sit in the heap as dirty-but-unused pages that
+      // count against RSS until purged.
+      FEXCore::Allocator::TrimHeap();
+    }
+  }
+#endif
 }
@@ -99,9 +99,18 @@ void Dispatcher::EmitDispatcher() {
   ldr(RipReg, STATE_PTR(CpuStateFrame, State.rip));
 
   // L1 Cache
+  // The mask is loaded rather than baked in since the L1 table can grow at runtime
   ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.L1Pointer));
+  ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.Common.L1EntriesMask));
 
-  and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg.R(), LookupCache::L1_ENTRIES_MASK);
+  // The index computation must match LookupCache::HashRIP
+  if (CTX->HostFeatures.SupportsCRC) {
+    crc32cx(ARMEmitter::XReg::x1, ARMEmitter::XReg::zr, RipReg);
+    and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, ARMEmitter::Reg::r1, ARMEmitter::Reg::r3);
+  }
+  else {
+    and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg.R(), ARMEmitter::Reg::r3);
+  }
   add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, ARMEmitter::Reg::r3, ARMEmitter::ShiftType::LSL , 4);
   ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x3, ARMEmitter::XReg::x0, ARMEmitter::Reg::r0, 0);
   sub(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, RipReg);
@@ -109,7 +118,12 @@ void Dispatcher::EmitDispatcher() {
 
   br(ARMEmitter::Reg::r3);
 
-  // L1C check failed, do a full lookup
+  // L1C check failed, do a full lookup.
+  // This entry is a branch target on every unlinked transition that misses
+  // the L1, align it to a fetch-window boundary like the loop top. The
+  // padding lands in the taken-branch shadow of the br above so it never
+  // executes.
+  Align16B();
   Bind(&FullLookup);
 
   // This is the block cache lookup routine
@@ -159,9 +173,17 @@ void Dispatcher::EmitDispatcher() {
     // If we've made it here then we have a real compiled block
     {
       // update L1 cache
+      ldr(ARMEmitter::XReg::x1, STATE_PTR(CpuStateFrame, Pointers.Common.L1EntriesMask));
+
+      // The index computation must match LookupCache::HashRIP
+      if (CTX->HostFeatures.SupportsCRC) {
+        crc32cx(ARMEmitter::XReg::x0, ARMEmitter::XReg::zr, RipReg);
+        and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, ARMEmitter::Reg::r0, ARMEmitter::Reg::r1);
+      }
+      else {
+        and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, RipReg.R(), ARMEmitter::Reg::r1);
+      }
       ldr(ARMEmitter::XReg::x0, STATE_PTR(CpuStateFrame, Pointers.Common.L1Pointer));
-
-      and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, RipReg.R(), LookupCache::L1_ENTRIES_MASK);
       add(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::ShiftType::LSL, 4);
       stp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x3, ARMEmitter::XReg::x2, ARMEmitter::Reg::r0);
 
@@ -218,6 +240,41 @@ void Dispatcher::EmitDispatcher() {
     br(ARMEmitter::Reg::r0);
   }
 
+  {
+    // Guest RIP is in State.rip, LR points at the stub's prediction slots
+    IndirectBranchPredictorLinkerAddress = GetCursorAddress<uint64_t>();
+    if (config.StaticRegisterAllocation)
+      SpillStaticRegs(TMP1);
+
+    ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalRefCount));
+    add(ARMEmitter::Size::i64Bit, ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, 1);
+    str(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalRefCount));
+
+    mov(ARMEmitter::XReg::x0, STATE);
+    mov(ARMEmitter::XReg::x1, ARMEmitter::XReg::lr);
+
+    ldr(ARMEmitter::XReg::x2, STATE_PTR(CpuStateFrame, Pointers.Common.IndirectBranchPredictorLink));
+    if (!CTX->Config.DisableVixlIndirectCalls) [[unlikely]] {
+      GenerateIndirectRuntimeCall<uintptr_t, void *, void *>(ARMEmitter::Reg::r2);
+    }
+    else {
+      blr(ARMEmitter::Reg::r2);
+    }
+
+    if (config.StaticRegisterAllocation)
+      FillStaticRegs();
+
+    ldr(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalRefCount));
+    sub(ARMEmitter::Size::i64Bit, ARMEmitter::XReg::x1, ARMEmitter::XReg::x1, 1);
+    str(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalRefCount));
+
+    // Trigger segfault if any deferred signals are pending
+    ldr(ARMEmitter::XReg::x1, STATE, offsetof(FEXCore::Core::CPUState, DeferredSignalFaultAddress));
+    str(ARMEmitter::XReg::zr, ARMEmitter::XReg::x1, 0);
+
+    br(ARMEmitter::Reg::r0);
+  }
+
   // Need to create the block
   {
     Bind(&NoBlock);
@@ -398,8 +455,9 @@ void Dispatcher::EmitDispatcher() {
   {
     LUDIVHandlerAddress = GetCursorAddress<uint64_t>();
 
-    PushDynamicRegsAndLR(ARMEmitter::Reg::r3);
-    SpillStaticRegs(ARMEmitter::Reg::r3);
+    // The helper carries the restricted clobber annotation when the compiler
+    // supports it, so only the caller-saved subset needs to spill here.
+    SpillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, ARMEmitter::Reg::r3, true);
 
     ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.AArch64.LUDIV));
     if (!CTX->Config.DisableVixlIndirectCalls) [[unlikely]] {
@@ -408,11 +466,9 @@ void Dispatcher::EmitDispatcher() {
     else {
       blr(ARMEmitter::Reg::r3);
     }
-    FillStaticRegs();
-
     // Result is now in x0
     // Fix the stack and any values that were stepped on
-    PopDynamicRegsAndLR();
+    FillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, true);
 
     // Go back to our code block
     ret();
@@ -421,8 +477,9 @@ void Dispatcher::EmitDispatcher() {
   {
     LDIVHandlerAddress = GetCursorAddress<uint64_t>();
 
-    PushDynamicRegsAndLR(ARMEmitter::Reg::r3);
-    SpillStaticRegs(ARMEmitter::Reg::r3);
+    // The helper carries the restricted clobber annotation when the compiler
+    // supports it, so only the caller-saved subset needs to spill here.
+    SpillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, ARMEmitter::Reg::r3, true);
 
     ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.AArch64.LDIV));
     if (!CTX->Config.DisableVixlIndirectCalls) [[unlikely]] {
@@ -431,11 +488,9 @@ void Dispatcher::EmitDispatcher() {
     else {
       blr(ARMEmitter::Reg::r3);
     }
-    FillStaticRegs();
-
     // Result is now in x0
     // Fix the stack and any values that were stepped on
-    PopDynamicRegsAndLR();
+    FillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, true);
 
     // Go back to our code block
     ret();
@@ -444,8 +499,9 @@ void Dispatcher::EmitDispatcher() {
   {
     LUREMHandlerAddress = GetCursorAddress<uint64_t>();
 
-    PushDynamicRegsAndLR(ARMEmitter::Reg::r3);
-    SpillStaticRegs(ARMEmitter::Reg::r3);
+    // The helper carries the restricted clobber annotation when the compiler
+    // supports it, so only the caller-saved subset needs to spill here.
+    SpillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, ARMEmitter::Reg::r3, true);
 
     ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.AArch64.LUREM));
     if (!CTX->Config.DisableVixlIndirectCalls) [[unlikely]] {
@@ -454,11 +510,9 @@ void Dispatcher::EmitDispatcher() {
     else {
       blr(ARMEmitter::Reg::r3);
     }
-    FillStaticRegs();
-
     // Result is now in x0
     // Fix the stack and any values that were stepped on
-    PopDynamicRegsAndLR();
+    FillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, true);
 
     // Go back to our code block
     ret();
@@ -467,8 +521,9 @@ void Dispatcher::EmitDispatcher() {
   {
     LREMHandlerAddress = GetCursorAddress<uint64_t>();
 
-    PushDynamicRegsAndLR(ARMEmitter::Reg::r3);
-    SpillStaticRegs(ARMEmitter::Reg::r3);
+    // The helper carries the restricted clobber annotation when the compiler
+    // supports it, so only the caller-saved subset needs to spill here.
+    SpillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, ARMEmitter::Reg::r3, true);
 
     ldr(ARMEmitter::XReg::x3, STATE_PTR(CpuStateFrame, Pointers.AArch64.LREM));
 
@@ -478,11 +533,9 @@ void Dispatcher::EmitDispatcher() {
     else {
       blr(ARMEmitter::Reg::r3);
     }
-    FillStaticRegs();
-
     // Result is now in x0
     // Fix the stack and any values that were stepped on
-    PopDynamicRegsAndLR();
+    FillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, true);
 
     // Go back to our code block
     ret();
@@ -542,6 +595,7 @@ void Dispatcher::InitThreadPointers(FEXCore::Core::InternalThreadState *Thread)
     Common.DispatcherLoopTop = AbsoluteLoopTopAddress;
     Common.DispatcherLoopTopFillSRA = AbsoluteLoopTopAddressFillSRA;
     Common.ExitFunctionLinker = ExitFunctionLinkerAddress;
+    Common.IndirectBranchPredictorLinker = IndirectBranchPredictorLinkerAddress;
     Common.ThreadStopHandlerSpillSRA = ThreadStopHandlerAddressSpillSRA;
     Common.ThreadPauseHandlerSpillSRA = ThreadPauseHandlerAddressSpillSRA;
     Common.GuestSignal_SIGILL = GuestSignal_SIGILL;
@@ -8,11 +8,13 @@ $end_info$
 
 #include "Interface/Context/Context.h"
 #include "Interface/Core/Frontend.h"
+#include "Interface/Core/PMUTuner.h"
 #include "Interface/Core/X86Tables/X86Tables.h"
 
 #include <array>
 #include <algorithm>
 #include <cstring>
+#include <sched.h>
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/HLE/SyscallHandler.h>
@@ -22,6 +24,8 @@ $end_info$
 #include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/set.h>
 #include <FEXHeaderUtils/TypeDefines.h>
+#include <string_view>
+#include <xxhash.h>
 
 namespace FEXCore::Frontend {
 #include "Interface/Core/VSyscall/VSyscall.inc"
@@ -91,7 +95,6 @@ Decoder::~Decoder() {
 uint8_t Decoder::ReadByte() {
   uint8_t Byte = InstStream[InstructionSize];
   LOGMAN_THROW_AA_FMT(InstructionSize < MAX_INST_SIZE, "Max instruction size exceeded!");
-  Instruction[InstructionSize] = Byte;
   InstructionSize++;
   return Byte;
 }
@@ -762,9 +765,53 @@ bool Decoder::NormalOpHeader(FEXCore::X86Tables::X86InstInfo const *Info, uint16
   FEX_UNREACHABLE;
 }
 
+namespace {
+// Flattened per-byte classification driving the decode loop. One cache line
+// wide, so the hot path - a plain opcode byte - costs a single table load and
+// one well-predicted branch straight into the primary dispatch instead of a
+// sparse 256-way switch. Prefix runs stay inside the compact action switch.
+enum PrefixAction : uint8_t {
+  PREFIX_NONE = 0, // Plain opcode byte, dispatch to the primary table
+  PREFIX_ESCAPE,   // 0x0F, two/three byte table escape
+  PREFIX_OPSIZE,   // 0x66
+  PREFIX_ADDRSIZE, // 0x67
+  PREFIX_SEGMENT,  // 0x26/0x2E/0x36/0x3E, only honored in 32-bit mode
+  PREFIX_FS,       // 0x64
+  PREFIX_GS,       // 0x65
+  PREFIX_LOCK,     // 0xF0
+  PREFIX_REPNE,    // 0xF2
+  PREFIX_REP,      // 0xF3
+  PREFIX_REX,      // 0x40-0x4F, INC/DEC opcodes in 32-bit mode
+};
+
+alignas(64) constexpr std::array<uint8_t, 256> PrefixActionTable = []() {
+  std::array<uint8_t, 256> Table{};
+  Table[0x0F] = PREFIX_ESCAPE;
+  Table[0x26] = Table[0x2E] = Table[0x36] = Table[0x3E] = PREFIX_SEGMENT;
+  for (size_t Op = 0x40; Op <= 0x4F; ++Op) {
+    Table[Op] = PREFIX_REX;
+  }
+  Table[0x64] = PREFIX_FS;
+  Table[0x65] = PREFIX_GS;
+  Table[0x66] = PREFIX_OPSIZE;
+  Table[0x67] = PREFIX_ADDRSIZE;
+  Table[0xF0] = PREFIX_LOCK;
+  Table[0xF2] = PREFIX_REPNE;
+  Table[0xF3] = PREFIX_REP;
+  return Table;
+}();
+
+// 0x26/0x2E/0x36/0x3E map to ES/CS/SS/DS through bits [4:3] of the byte.
+constexpr std::array<uint32_t, 4> LegacySegmentFlag = {
+  FEXCore::X86Tables::DecodeFlags::FLAG_ES_PREFIX,
+  FEXCore::X86Tables::DecodeFlags::FLAG_CS_PREFIX,
+  FEXCore::X86Tables::DecodeFlags::FLAG_SS_PREFIX,
+  FEXCore::X86Tables::DecodeFlags::FLAG_DS_PREFIX,
+};
+}
+
 bool Decoder::DecodeInstruction(uint64_t PC) {
   InstructionSize = 0;
-  Instruction.fill(0);
 
   DecodeInst = &DecodedBuffer[DecodedSize];
   memset(DecodeInst, 0, sizeof(DecodedInst));
@@ -774,8 +821,14 @@ bool Decoder::DecodeInstruction(uint64_t PC) {
     if (InstructionSize >= MAX_INST_SIZE)
       return false;
     uint8_t Op = ReadByte();
-    switch (Op) {
-    case 0x0F: {// Escape Op
+    const uint8_t Action = PrefixActionTable[Op];
+
+    if (Action == PREFIX_NONE) [[likely]] {
+      return NormalOpHeader(&FEXCore::X86Tables::BaseOps[Op], Op);
+    }
+
+    switch (Action) {
+    case PREFIX_ESCAPE: {
       uint8_t EscapeOp = ReadByte();
       switch (EscapeOp) {
         case 0x0F: [[unlikely]] { // 3DNow!
@@ -890,94 +943,69 @@ bool Decoder::DecodeInstruction(uint64_t PC) {
       }
     break;
     }
-    case 0x66: // Operand Size prefix
+    case PREFIX_OPSIZE:
       DecodeInst->Flags |= DecodeFlags::FLAG_OPERAND_SIZE;
       DecodeInst->LastEscapePrefix = Op;
       DecodeFlags::PushOpAddr(&DecodeInst->Flags, DecodeFlags::FLAG_OPERAND_SIZE_LAST);
     break;
-    case 0x67: // Address Size override prefix
+    case PREFIX_ADDRSIZE:
       DecodeInst->Flags |= DecodeFlags::FLAG_ADDRESS_SIZE;
     break;
-    case 0x26: // ES legacy prefix
-      if (!CTX->Config.Is64BitMode) {
-        DecodeInst->Flags |= DecodeFlags::FLAG_ES_PREFIX;
-      }
-      break;
-    case 0x2E: // CS legacy prefix
-      if (!CTX->Config.Is64BitMode) {
-        DecodeInst->Flags |= DecodeFlags::FLAG_CS_PREFIX;
-      }
-      break;
-    case 0x36: // SS legacy prefix
-      if (!CTX->Config.Is64BitMode) {
-        DecodeInst->Flags |= DecodeFlags::FLAG_SS_PREFIX;
-      }
-      break;
-    case 0x3E: // DS legacy prefix
-      // Annoyingly GCC generates NOP ops with these prefixes
-      // Just ignore them for now
+    case PREFIX_SEGMENT:
+      // Annoyingly GCC generates NOP ops with these prefixes, so they show up
+      // in 64-bit code where they are otherwise meaningless
       // eg. 66 2e 0f 1f 84 00 00 00 00 00 nop    WORD PTR cs:[rax+rax*1+0x0]
       if (!CTX->Config.Is64BitMode) {
-        DecodeInst->Flags |= DecodeFlags::FLAG_DS_PREFIX;
+        DecodeInst->Flags |= LegacySegmentFlag[(Op >> 3) & 0b11];
       }
-      break;
     break;
-    case 0xF0: // LOCK prefix
+    case PREFIX_LOCK:
       DecodeInst->Flags |= DecodeFlags::FLAG_LOCK;
     break;
-    case 0xF2: // REPNE prefix
+    case PREFIX_REPNE:
       DecodeInst->Flags |= DecodeFlags::FLAG_REPNE_PREFIX;
       DecodeInst->LastEscapePrefix = Op;
     break;
-    case 0xF3: // REP prefix
+    case PREFIX_REP:
       DecodeInst->Flags |= DecodeFlags::FLAG_REP_PREFIX;
       DecodeInst->LastEscapePrefix = Op;
     break;
-    case 0x64: // FS prefix
+    case PREFIX_FS:
       DecodeInst->Flags |= DecodeFlags::FLAG_FS_PREFIX;
     break;
-    case 0x65: // GS prefix
+    case PREFIX_GS:
       DecodeInst->Flags |= DecodeFlags::FLAG_GS_PREFIX;
     break;
-    default: [[likely]] { // Default base table
-      auto Info = &FEXCore::X86Tables::BaseOps[Op];
+    case PREFIX_REX: {
+      if (!CTX->Config.Is64BitMode) {
+        // 0x40-0x4F are the short INC/DEC encodings outside of 64-bit mode
+        return NormalOpHeader(&FEXCore::X86Tables::BaseOps[Op], Op);
+      }
 
-      if (Info->Type == FEXCore::X86Tables::TYPE_REX_PREFIX) {
-        LOGMAN_THROW_A_FMT(CTX->Config.Is64BitMode, "Got REX prefix in 32bit mode");
-        DecodeInst->Flags |= DecodeFlags::FLAG_REX_PREFIX;
+      DecodeInst->Flags |= DecodeFlags::FLAG_REX_PREFIX;
 
-        // Widening displacement
-        if (Op & 0b1000) {
-          DecodeInst->Flags |= DecodeFlags::FLAG_REX_WIDENING;
-          DecodeFlags::PushOpAddr(&DecodeInst->Flags, DecodeFlags::FLAG_WIDENING_SIZE_LAST);
-        }
+      // Widening displacement
+      if (Op & 0b1000) {
+        DecodeInst->Flags |= DecodeFlags::FLAG_REX_WIDENING;
+        DecodeFlags::PushOpAddr(&DecodeInst->Flags, DecodeFlags::FLAG_WIDENING_SIZE_LAST);
+      }
 
-        // XGPR_B bit set
-        if (Op & 0b0001)
-          DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_B;
+      // XGPR_B bit set
+      if (Op & 0b0001)
+        DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_B;
 
-        // XGPR_X bit set
-        if (Op & 0b0010)
-          DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_X;
+      // XGPR_X bit set
+      if (Op & 0b0010)
+        DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_X;
 
-        // XGPR_R bit set
-        if (Op & 0b0100)
-          DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_R;
-      } else {
-        return NormalOpHeader(Info, Op);
-      }
+      // XGPR_R bit set
+      if (Op & 0b0100)
+        DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_R;
 
       break;
     }
     }
-
-  }
-
-  if (DecodeInst->Dest.IsGPR()) {
-    LOGMAN_THROW_A_FMT(DecodeInst->Dest.Data.GPR.GPR != FEXCore::X86State::REG_INVALID, "Destination GPR was invalid");
   }
-
-  return true;
 }
 
 void Decoder::BranchTargetInMultiblockRange() {
@@ -1006,11 +1034,33 @@ void Decoder::BranchTargetInMultiblockRange() {
       TargetRIP = DecodeInst->PC + DecodeInst->InstSize + DecodeInst->Src[0].Data.Literal.Value;
       Conditional = false;
     break;
-    case 0xE8: // Call - Immediate target, We don't want to inline calls
+    case 0xE8: { // Call - Immediate target, calls are only inlined when the callee is a provable leaf
+      LOGMAN_THROW_A_FMT(DecodeInst->Src[0].IsLiteral(), "Had wrong operand type");
+      const uint64_t ReturnRIP = DecodeInst->PC + DecodeInst->InstSize;
+      TargetRIP = DecodeInst->PC + DecodeInst->InstSize + DecodeInst->Src[0].Data.Literal.Value;
+      if (GPRSize == 4) {
+        TargetRIP &= 0xFFFFFFFFU;
+      }
+
       if (ExternalBranches) {
-        ExternalBranches->insert(DecodeInst->PC + DecodeInst->InstSize);
+        // Both the return address and the call target are blocks that are known to exist
+        ExternalBranches->insert(ReturnRIP);
+        ExternalBranches->insert(TargetRIP);
       }
-      [[fallthrough]];
+
+      if (AllowLeafCallInlining && TryInlineLeafCall(TargetRIP, ReturnRIP)) {
+        // The callee is a small leaf, pull it and the return point in to the region.
+        // The OpDispatcher turns the call in to an intra-region jump and guards the
+        // matching RET with a predicted return target.
+        if (!HasBlocks.contains(TargetRIP)) {
+          BlocksToDecode.insert(TargetRIP);
+        }
+        if (!HasBlocks.contains(ReturnRIP)) {
+          BlocksToDecode.insert(ReturnRIP);
+        }
+      }
+      return;
+    }
     case 0xC2: // RET imm
     case 0xC3: // RET
     default:
@@ -1023,8 +1073,17 @@ void Decoder::BranchTargetInMultiblockRange() {
     TargetRIP &= 0xFFFFFFFFU;
   }
 
+  // Conditional backward branches within the loop-follow range are considered
+  // part of the trace even when they target below the entry point.
+  // This pulls whole loop bodies in to one trace when entering at the condition.
+  uint64_t MinAddress = SymbolMinAddress;
+  if (Conditional && TargetRIP < MinAddress) {
+    const uint64_t LoopRange = CTX->Config.MultiblockLoopRange;
+    MinAddress -= std::min(MinAddress, LoopRange);
+  }
+
   // If the target RIP is within the symbol ranges then we are golden
-  if (TargetRIP >= SymbolMinAddress && TargetRIP < SymbolMaxAddress) {
+  if (TargetRIP >= MinAddress && TargetRIP < SymbolMaxAddress) {
     // Update our conditional branch ranges before we return
     if (Conditional) {
       MaxCondBranchForward = std::max(MaxCondBranchForward, TargetRIP);
@@ -1076,6 +1135,81 @@ bool Decoder::BranchTargetCanContinue(bool FinalInstruction) const {
   return false;
 }
 
+bool Decoder::TryInlineLeafCall(uint64_t TargetRIP, uint64_t ReturnRIP) {
+  if (TargetRIP == ReturnRIP) {
+    // Call to the next instruction is a GOT calculation, handled in the OpDispatcher
+    return false;
+  }
+
+  if (DecodedSize >= DefaultDecodedBufferSize) {
+    // No scratch slot left to probe with
+    return false;
+  }
+
+  // Probe the callee with a bounded straight-line decode. Only accept a run of
+  // non-branching instructions ending in a RET, anything else stays a real call.
+  // The probe decodes in to DecodedBuffer[DecodedSize] which is unclaimed scratch
+  // at this point, the caller's DecodeInst was already accounted for.
+  constexpr uint64_t MaxLeafInstructions = 24;
+
+  const uint64_t CallPC = DecodeInst->PC;
+  uint8_t const *SavedInstStream = InstStream;
+  FEXCore::X86Tables::DecodedInst *SavedDecodeInst = DecodeInst;
+
+  // Back-calculate the stream base so we can aim the stream at the callee.
+  // If the pointer math doesn't round trip then we are decoding out of a special
+  // region (vsyscall) where linear adjustment is invalid
+  uint8_t const *StreamBase = InstStream - (CallPC - EntryPoint);
+  if (AdjustAddrForSpecialRegion(StreamBase, EntryPoint, CallPC) != InstStream) {
+    return false;
+  }
+
+  InstStream = AdjustAddrForSpecialRegion(StreamBase, EntryPoint, TargetRIP);
+
+  bool IsLeaf = false;
+  uint64_t RetPC = 0;
+  uint64_t PCOffset = 0;
+
+  for (uint64_t i = 0; i < MaxLeafInstructions; ++i) {
+    if (!DecodeInstruction(TargetRIP + PCOffset)) {
+      break;
+    }
+
+    if (DecodeInst->OP == 0xC2 ||
+        DecodeInst->OP == 0xC3) {
+      RetPC = TargetRIP + PCOffset;
+      IsLeaf = true;
+      break;
+    }
+
+    if (DecodeInst->TableInfo->Flags &
+        (FEXCore::X86Tables::InstFlags::FLAGS_BLOCK_END | FEXCore::X86Tables::InstFlags::FLAGS_SETS_RIP)) {
+      // Callee branches somewhere, not a straight-line leaf
+      break;
+    }
+
+    PCOffset += DecodeInst->InstSize;
+    InstStream += DecodeInst->InstSize;
+  }
+
+  InstStream = SavedInstStream;
+  DecodeInst = SavedDecodeInst;
+
+  if (!IsLeaf) {
+    return false;
+  }
+
+  if (auto [it, Inserted] = BlockInfo.PredictedReturnTargets.try_emplace(RetPC, ReturnRIP);
+      !Inserted && it->second != ReturnRIP) {
+    // Same leaf inlined from multiple call sites, its RET can't predict a single
+    // return target. Those returns fall back to the dispatcher
+    it->second = 0;
+  }
+
+  BlockInfo.InlinedCallSites.insert(CallPC);
+  return true;
+}
+
 const uint8_t *Decoder::AdjustAddrForSpecialRegion(uint8_t const* _InstStream, uint64_t EntryPoint, uint64_t RIP) {
   constexpr uint64_t VSyscall_Base = 0xFFFF'FFFF'FF60'0000ULL;
   constexpr uint64_t VSyscall_End = VSyscall_Base + 0x1000;
@@ -1095,10 +1229,90 @@ const uint8_t *Decoder::AdjustAddrForSpecialRegion(uint8_t const* _InstStream, u
   return _InstStream - EntryPoint + RIP;
 }
 
+namespace {
+struct StatusFlagSummary {
+  uint8_t Read;
+  uint8_t Written;
+};
+
+// Status flag behaviour for the instructions common enough to matter, keyed by
+// table name so every encoding of an op shares one entry. Anything not listed
+// is treated as reading every flag, which forces liveness and keeps the
+// summary conservative - shifts and rotates land here on purpose since their
+// flag writes are conditional on the count.
+StatusFlagSummary ClassifyStatusFlags(const FEXCore::X86Tables::DecodedInst &Inst) {
+  using namespace FEXCore::X86Tables;
+
+  // Invalid decode, assume the worst.
+  if (!Inst.TableInfo || !Inst.TableInfo->Name) {
+    return { .Read = StatusFlags::ALL, .Written = 0 };
+  }
+
+  // LOCK and REP prefixed forms can fail to lower, which truncates the block
+  // at the failing instruction and exits with the flags the context holds.
+  // Keep everything live across them so a skipped calculation can't be the
+  // state that exit exposes.
+  if (Inst.Flags & (DecodeFlags::FLAG_LOCK | DecodeFlags::FLAG_REP_PREFIX | DecodeFlags::FLAG_REPNE_PREFIX)) {
+    return { .Read = StatusFlags::ALL, .Written = 0 };
+  }
+
+  const std::string_view Name = Inst.TableInfo->Name;
+
+  // The ALU ops that define every status flag without reading any.
+  if (Name == "ADD" || Name == "SUB" || Name == "AND" || Name == "OR" ||
+      Name == "XOR" || Name == "CMP" || Name == "TEST" || Name == "NEG") {
+    return { .Read = 0, .Written = StatusFlags::ALL };
+  }
+
+  // Consume carry, define everything.
+  if (Name == "ADC" || Name == "SBB") {
+    return { .Read = StatusFlags::CF, .Written = StatusFlags::ALL };
+  }
+
+  // Define everything except carry, which passes through untouched.
+  if (Name == "INC" || Name == "DEC") {
+    return { .Read = 0, .Written = static_cast<uint8_t>(StatusFlags::ALL & ~StatusFlags::CF) };
+  }
+
+  // Common data movement that doesn't interact with flags at all. The segment
+  // register MOV forms are excluded - their lowering can fail for selectors we
+  // don't support, truncating the block the same way the prefixes above do.
+  if (Name == "MOV") {
+    const bool SegmentForm = Inst.OP == 0x8C || Inst.OP == 0x8E;
+    return { .Read = SegmentForm ? StatusFlags::ALL : uint8_t{0}, .Written = 0 };
+  }
+  if (Name == "LEA" || Name == "PUSH" || Name == "POP" ||
+      Name == "MOVZX" || Name == "MOVSX" || Name == "MOVSXD" ||
+      Name == "XCHG" || Name == "NOT" || Name == "NOP") {
+    return { .Read = 0, .Written = 0 };
+  }
+
+  return { .Read = StatusFlags::ALL, .Written = 0 };
+}
+}
+
+// Backward scan over one decoded block, marking for each instruction the
+// status flags that a later instruction in the same block is guaranteed to
+// overwrite before any possible read. Everything is assumed live at the block
+// exit since execution continues in code we haven't seen.
+void Decoder::CalculateDeadStatusFlags(DecodedBlocks &Block) {
+  uint8_t Live = FEXCore::X86Tables::StatusFlags::ALL;
+
+  for (size_t i = Block.NumInstructions; i > 0; --i) {
+    auto &Inst = Block.DecodedInstructions[i - 1];
+    Inst.DeadStatusFlags = ~Live & FEXCore::X86Tables::StatusFlags::ALL;
+
+    const auto Summary = ClassifyStatusFlags(Inst);
+    Live = (Live & ~Summary.Written) | Summary.Read;
+  }
+}
+
 void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC, uint64_t MaxInst, std::function<void(uint64_t BlockEntry, uint64_t Start, uint64_t Length)> AddContainedCodePage) {
   FEXCORE_PROFILE_SCOPED("DecodeInstructions");
   BlockInfo.TotalInstructionCount = 0;
   BlockInfo.Blocks.clear();
+  BlockInfo.InlinedCallSites.clear();
+  BlockInfo.PredictedReturnTargets.clear();
   BlocksToDecode.clear();
   HasBlocks.clear();
   // Reset internal state management
@@ -1124,6 +1338,40 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   DecodedMinAddress = EntryPoint;
   DecodedMaxAddress = EntryPoint;
 
+  if (MaxInst == 0) {
+    MaxInst = CTX->Config.MaxInstPerBlock;
+
+    if (CTX->Config.Multiblock && CTX->Config.MultiblockTraceInst() != 0) {
+      // Multiblock traces get their own total instruction budget so they can
+      // grow past the single-block limit without raising it globally
+      MaxInst = CTX->Config.MultiblockTraceInst;
+    }
+
+    if (CTX->Tuner) {
+      // The PMU controller owns the trace budget when tuning is enabled
+      MaxInst = CTX->Tuner->TraceInstBudget();
+    }
+
+    if (CTX->Config.HeterogeneousTuning() && CTX->CPUID.IsHostHybrid()) {
+      // On hybrid hosts, a thread compiling from an efficiency core is most
+      // likely scheduled to keep running there; its smaller front end wants
+      // shorter traces. getcpu is a vDSO read, cheap against a compile.
+      const int CPU = sched_getcpu();
+      if (CPU >= 0 && !CTX->CPUID.IsBigCore(CPU)) {
+        MaxInst = std::max<uint64_t>(MaxInst / 2, 1);
+      }
+    }
+  }
+
+  // The cache can't capture external branch recording and the vsyscall region
+  // decodes from a synthetic stream, both fall back to a fresh decode.
+  const bool DecodeCacheUsable = CTX->Config.DecodeCache() && !ExternalBranches &&
+      AdjustAddrForSpecialRegion(_InstStream, EntryPoint, PC) == _InstStream;
+
+  if (DecodeCacheUsable && FillFromDecodeCache(_InstStream, PC, MaxInst, AddContainedCodePage)) {
+    return;
+  }
+
   // Entry is a jump target
   BlocksToDecode.emplace(PC);
 
@@ -1133,10 +1381,6 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
 
   AddContainedCodePage(PC, CurrentCodePage, FHU::FEX_PAGE_SIZE);
 
-  if (MaxInst == 0) {
-    MaxInst = CTX->Config.MaxInstPerBlock;
-  }
-
   while (!BlocksToDecode.empty()) {
     auto BlockDecodeIt = BlocksToDecode.begin();
     uint64_t RIPToDecode = *BlockDecodeIt;
@@ -1228,6 +1472,12 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
     CurrentBlockDecoding.NumInstructions = BlockNumberOfInstructions;
     CurrentBlockDecoding.DecodedInstructions = &DecodedBuffer[BlockStartOffset];
     BlockInfo.TotalInstructionCount += BlockNumberOfInstructions;
+
+    // Summarize flag liveness now that the block is complete, so lowering can
+    // pick flag-free forms without waiting for the IR passes to prove it.
+    // Runs before the decode cache snapshots the buffer, so cached blocks keep
+    // their summaries.
+    CalculateDeadStatusFlags(CurrentBlockDecoding);
   }
 
   for (auto CodePage : CodePages) {
@@ -1238,6 +1488,92 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   std::sort(BlockInfo.Blocks.begin(), BlockInfo.Blocks.end(), [](const FEXCore::Frontend::Decoder::DecodedBlocks& a, const FEXCore::Frontend::Decoder::DecodedBlocks& b) {
     return a.Entry < b.Entry;
   });
+
+  if (DecodeCacheUsable) {
+    AddToDecodeCache(_InstStream, PC, MaxInst, CodePages);
+  }
+}
+
+bool Decoder::FillFromDecodeCache(uint8_t const* InstStreamBase, uint64_t PC, uint64_t MaxInst,
+                                  const std::function<void(uint64_t BlockEntry, uint64_t Start, uint64_t Length)> &AddContainedCodePage) {
+  auto &Cache = *CTX->FrontendDecodeCache;
+  std::shared_lock lk {Cache.Mutex};
+
+  auto it = Cache.Entries.find(PC);
+  if (it == Cache.Entries.end()) {
+    return false;
+  }
+
+  const auto &Entry = it->second;
+  if (Entry.MaxInst != MaxInst) {
+    // Different instruction budget, likely a different compile tier
+    return false;
+  }
+
+  // The guest bytes must still match what was decoded. This is what makes the
+  // entry safe to reuse after an SMC invalidation or a full cache clear.
+  const uint8_t *Code = InstStreamBase - PC + Entry.MinAddress;
+  if (XXH3_64bits(Code, Entry.MaxAddress - Entry.MinAddress) != Entry.CodeHash) {
+    return false;
+  }
+
+  memcpy(DecodedBuffer, Entry.Instructions.data(), Entry.Instructions.size() * sizeof(FEXCore::X86Tables::DecodedInst));
+  DecodedSize = Entry.Instructions.size();
+  DecodedMinAddress = Entry.MinAddress;
+  DecodedMaxAddress = Entry.MaxAddress;
+
+  BlockInfo.TotalInstructionCount = Entry.TotalInstructionCount;
+  BlockInfo.Blocks.reserve(Entry.Blocks.size());
+  for (const auto &Block : Entry.Blocks) {
+    BlockInfo.Blocks.emplace_back(DecodedBlocks {
+      .Entry = Block.Entry,
+      .NumInstructions = Block.NumInstructions,
+      .DecodedInstructions = &DecodedBuffer[Block.FirstInstruction],
+    });
+  }
+  BlockInfo.InlinedCallSites = Entry.InlinedCallSites;
+  BlockInfo.PredictedReturnTargets = Entry.PredictedReturnTargets;
+
+  for (auto CodePage : Entry.CodePages) {
+    AddContainedCodePage(PC, CodePage, FHU::FEX_PAGE_SIZE);
+  }
+
+  return true;
+}
+
+void Decoder::AddToDecodeCache(uint8_t const* InstStreamBase, uint64_t PC, uint64_t MaxInst, const fextl::set<uint64_t> &CodePages) {
+  for (const auto &Block : BlockInfo.Blocks) {
+    // Decode failures depend on the mapping that faulted, never cache those
+    if (Block.HasInvalidInstruction) {
+      return;
+    }
+  }
+
+  DecodeCache::CacheEntry Entry{};
+  Entry.MinAddress = DecodedMinAddress;
+  Entry.MaxAddress = DecodedMaxAddress;
+  Entry.MaxInst = MaxInst;
+  Entry.TotalInstructionCount = BlockInfo.TotalInstructionCount;
+  Entry.CodeHash = XXH3_64bits(InstStreamBase - PC + DecodedMinAddress, DecodedMaxAddress - DecodedMinAddress);
+  Entry.Instructions.assign(DecodedBuffer, DecodedBuffer + DecodedSize);
+  Entry.Blocks.reserve(BlockInfo.Blocks.size());
+  for (const auto &Block : BlockInfo.Blocks) {
+    Entry.Blocks.emplace_back(DecodeCache::CachedBlock {
+      .Entry = Block.Entry,
+      .NumInstructions = Block.NumInstructions,
+      .FirstInstruction = static_cast<size_t>(Block.DecodedInstructions - DecodedBuffer),
+    });
+  }
+  Entry.CodePages = CodePages;
+  Entry.InlinedCallSites = BlockInfo.InlinedCallSites;
+  Entry.PredictedReturnTargets = BlockInfo.PredictedReturnTargets;
+
+  auto &Cache = *CTX->FrontendDecodeCache;
+  std::unique_lock lk {Cache.Mutex};
+  if (Cache.Entries.size() >= DecodeCache::MaxEntries) {
+    Cache.Entries.clear();
+  }
+  Cache.Entries.insert_or_assign(PC, std::move(Entry));
 }
 
 }
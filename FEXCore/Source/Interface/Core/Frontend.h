@@ -4,12 +4,18 @@
 #include "Interface/Core/X86Tables/X86Tables.h"
 
 #include <FEXCore/HLE/SyscallHandler.h>
+#include <FEXCore/Utils/SignalScopeGuards.h>
 #include <FEXCore/Utils/Telemetry.h>
+#include <FEXCore/fextl/inline_vector.h>
+#include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/vector.h>
 
 #include <array>
 #include <cstdint>
+#include <mutex>
+#include <shared_mutex>
 #include <stddef.h>
 
 namespace FEXCore::Context {
@@ -17,6 +23,39 @@ class ContextImpl;
 }
 
 namespace FEXCore::Frontend {
+// Decoded-block cache shared between every thread's Decoder.
+// Entries are keyed by entry RIP and validated against a hash of the guest
+// bytes they were decoded from, so they stay reusable across cache clears and
+// SMC invalidations as long as the code bytes are unchanged.
+struct DecodeCache final {
+  struct CachedBlock final {
+    uint64_t Entry;
+    uint64_t NumInstructions;
+    // Index in to CacheEntry::Instructions, turned back in to a pointer on reuse
+    size_t FirstInstruction;
+  };
+
+  struct CacheEntry final {
+    uint64_t CodeHash;
+    uint64_t MinAddress;
+    uint64_t MaxAddress;
+    uint64_t MaxInst;
+    uint64_t TotalInstructionCount;
+    fextl::vector<FEXCore::X86Tables::DecodedInst> Instructions;
+    fextl::vector<CachedBlock> Blocks;
+    fextl::set<uint64_t> CodePages;
+    fextl::set<uint64_t> InlinedCallSites;
+    fextl::map<uint64_t, uint64_t> PredictedReturnTargets;
+  };
+
+  FEXCore::ForkableSharedMutex Mutex;
+  fextl::unordered_map<uint64_t, CacheEntry> Entries;
+
+  // Wholesale eviction once full - recompile storms refill the hot entries
+  // immediately and it keeps stale code from pinning memory forever.
+  constexpr static size_t MaxEntries = 4096;
+};
+
 class Decoder final {
 public:
   // New Frontend decoding
@@ -27,9 +66,19 @@ public:
     bool HasInvalidInstruction{};
   };
 
+  // Inline storage covers the common multiblock region, decoding then runs
+  // allocation-free. Large regions spill to the heap as before.
+  using DecodedBlockVector = fextl::inline_vector<DecodedBlocks, 32>;
+
   struct DecodedBlockInformation final {
     uint64_t TotalInstructionCount;
-    fextl::vector<DecodedBlocks> Blocks;
+    DecodedBlockVector Blocks;
+    // Call sites where a leaf callee was pulled in to the region
+    fextl::set<uint64_t> InlinedCallSites;
+    // RET PC -> return address for leaves inlined at a single call site.
+    // Zero when the same leaf was inlined at multiple call sites, those
+    // returns leave through the dispatcher as usual.
+    fextl::map<uint64_t, uint64_t> PredictedReturnTargets;
   };
 
   Decoder(FEXCore::Context::ContextImpl *ctx);
@@ -45,6 +94,7 @@ public:
 
   void SetSectionMaxAddress(uint64_t v) { SectionMaxAddress = v; }
   void SetExternalBranches(fextl::set<uint64_t> *v) { ExternalBranches = v; }
+  void SetAllowLeafCallInlining(bool v) { AllowLeafCallInlining = v; }
 
   void DelayedDisownBuffer() {
     PoolObject.DelayedDisownBuffer();
@@ -64,8 +114,15 @@ private:
 
   bool DecodeInstruction(uint64_t PC);
 
+  void CalculateDeadStatusFlags(DecodedBlocks &Block);
+
   void BranchTargetInMultiblockRange();
   bool BranchTargetCanContinue(bool FinalInstruction) const;
+  bool TryInlineLeafCall(uint64_t TargetRIP, uint64_t ReturnRIP);
+
+  bool FillFromDecodeCache(uint8_t const* InstStreamBase, uint64_t PC, uint64_t MaxInst,
+                           const std::function<void(uint64_t BlockEntry, uint64_t Start, uint64_t Length)> &AddContainedCodePage);
+  void AddToDecodeCache(uint8_t const* InstStreamBase, uint64_t PC, uint64_t MaxInst, const fextl::set<uint64_t> &CodePages);
 
   uint8_t ReadByte();
   uint8_t PeekByte(uint8_t Offset) const;
@@ -84,11 +141,11 @@ private:
 
   static constexpr size_t MAX_INST_SIZE = 15;
   uint8_t InstructionSize;
-  std::array<uint8_t, MAX_INST_SIZE> Instruction;
   FEXCore::X86Tables::DecodedInst *DecodeInst;
 
   // This is for multiblock data tracking
   bool SymbolAvailable {false};
+  bool AllowLeafCallInlining {false};
   uint64_t EntryPoint {};
   uint64_t MaxCondBranchForward {};
   uint64_t MaxCondBranchBackwards {~0ULL};
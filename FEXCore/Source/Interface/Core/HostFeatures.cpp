@@ -104,6 +104,12 @@ static void OverrideFeatures(HostFeatures *Features) {
 #undef ENABLE_DISABLE_OPTION
 #undef GET_SINGLE_OPTION
 
+  if (!Features->SupportsSVE) {
+    // SVE2 rides on top of SVE, disabling the base disables it too.
+    Features->SupportsSVE2 = false;
+    Features->SupportsSVEBitPerm = false;
+  }
+
   if (EnableCrypto) {
     Features->SupportsAES = true;
     Features->SupportsCRC = true;
@@ -155,9 +161,13 @@ HostFeatures::HostFeatures() {
 #ifdef VIXL_SIMULATOR
   // Hardcode enable SVE with 256-bit wide registers.
   SupportsSVE = true;
+  SupportsSVE2 = true;
+  SupportsSVEBitPerm = true;
   SupportsAVX = true;
 #else
   SupportsSVE = Features.Has(vixl::CPUFeatures::Feature::kSVE);
+  SupportsSVE2 = Features.Has(vixl::CPUFeatures::Feature::kSVE2);
+  SupportsSVEBitPerm = Features.Has(vixl::CPUFeatures::Feature::kSVEBitPerm);
   SupportsAVX = Features.Has(vixl::CPUFeatures::Feature::kSVE2) &&
                 vixl::aarch64::CPU::ReadSVEVectorLengthInBits() >= 256;
 #endif
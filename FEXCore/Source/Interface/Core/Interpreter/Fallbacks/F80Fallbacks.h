@@ -308,6 +308,7 @@ struct OpHandlers<IR::OP_F80SCALE> {
 
 template<>
 struct OpHandlers<IR::OP_F64SIN> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src) {
     LoadDeferredFCW(NewFCW);
     return sin(src);
@@ -316,6 +317,7 @@ struct OpHandlers<IR::OP_F64SIN> {
 
 template<>
 struct OpHandlers<IR::OP_F64COS> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src) {
     LoadDeferredFCW(NewFCW);
     return cos(src);
@@ -324,6 +326,7 @@ struct OpHandlers<IR::OP_F64COS> {
 
 template<>
 struct OpHandlers<IR::OP_F64TAN> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src) {
     LoadDeferredFCW(NewFCW);
     return tan(src);
@@ -332,6 +335,7 @@ struct OpHandlers<IR::OP_F64TAN> {
 
 template<>
 struct OpHandlers<IR::OP_F64F2XM1> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src) {
     LoadDeferredFCW(NewFCW);
     return exp2(src) - 1.0;
@@ -340,6 +344,7 @@ struct OpHandlers<IR::OP_F64F2XM1> {
 
 template<>
 struct OpHandlers<IR::OP_F64ATAN> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src1, double src2) {
     LoadDeferredFCW(NewFCW);
     return atan2(src1, src2);
@@ -348,6 +353,7 @@ struct OpHandlers<IR::OP_F64ATAN> {
 
 template<>
 struct OpHandlers<IR::OP_F64FPREM> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src1, double src2) {
     LoadDeferredFCW(NewFCW);
     return fmod(src1, src2);
@@ -356,6 +362,7 @@ struct OpHandlers<IR::OP_F64FPREM> {
 
 template<>
 struct OpHandlers<IR::OP_F64FPREM1> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src1, double src2) {
     LoadDeferredFCW(NewFCW);
     return remainder(src1, src2);
@@ -364,6 +371,7 @@ struct OpHandlers<IR::OP_F64FPREM1> {
 
 template<>
 struct OpHandlers<IR::OP_F64FYL2X> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src1, double src2) {
     LoadDeferredFCW(NewFCW);
     return src2 * log2(src1);
@@ -372,6 +380,7 @@ struct OpHandlers<IR::OP_F64FYL2X> {
 
 template<>
 struct OpHandlers<IR::OP_F64SCALE> {
+  FEXCORE_PRESERVE_ALL_ATTR
   static double handle(uint16_t NewFCW, double src1, double src2) {
     LoadDeferredFCW(NewFCW);
     double trunc = (double)(int64_t)(src2); //truncate
@@ -16,12 +16,12 @@ static FallbackInfo GetFallbackInfo(R(*fn)(Args...), FEXCore::Core::FallbackHand
 
 template<>
 FallbackInfo GetFallbackInfo(double(*fn)(uint16_t, double), FEXCore::Core::FallbackHandlerIndex HandlerIndex) {
-  return {FABI_F64_I16_F64, (void*)fn, HandlerIndex, false};
+  return {FABI_F64_I16_F64, (void*)fn, HandlerIndex, FEXCORE_HAS_PRESERVE_ALL_ATTR};
 }
 
 template<>
 FallbackInfo GetFallbackInfo(double(*fn)(uint16_t, double,double), FEXCore::Core::FallbackHandlerIndex HandlerIndex) {
-  return {FABI_F64_I16_F64_F64, (void*)fn, HandlerIndex, false};
+  return {FABI_F64_I16_F64_F64, (void*)fn, HandlerIndex, FEXCORE_HAS_PRESERVE_ALL_ATTR};
 }
 
 void InterpreterOps::FillFallbackIndexPointers(uint64_t *Info) {
@@ -130,6 +130,26 @@ DEF_OP(SbbNZCV) {
   sbcs(EmitSize, ARMEmitter::Reg::zr, GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
 }
 
+DEF_OP(AdcWithFlags) {
+  auto Op = IROp->C<IR::IROp_AdcWithFlags>();
+  const auto OpSize = IROp->Size;
+
+  LOGMAN_THROW_AA_FMT(OpSize == IR::i32Bit || OpSize == IR::i64Bit, "Unsupported {} size: {}", __func__, OpSize);
+  const auto EmitSize = OpSize == IR::i64Bit ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  adcs(EmitSize, GetReg(Node), GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
+}
+
+DEF_OP(SbbWithFlags) {
+  auto Op = IROp->C<IR::IROp_SbbWithFlags>();
+  const auto OpSize = IROp->Size;
+
+  LOGMAN_THROW_AA_FMT(OpSize == IR::i32Bit || OpSize == IR::i64Bit, "Unsupported {} size: {}", __func__, OpSize);
+  const auto EmitSize = OpSize == IR::i64Bit ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+
+  sbcs(EmitSize, GetReg(Node), GetReg(Op->Src1.ID()), GetReg(Op->Src2.ID()));
+}
+
 DEF_OP(TestNZ) {
   auto Op = IROp->C<IR::IROp_TestNZ>();
   const uint8_t OpSize = IROp->Size;
@@ -717,6 +737,23 @@ DEF_OP(PDep) {
   const auto Mask = GetReg(Op->Mask.ID());
   const auto Dest = GetReg(Node);
 
+  if (HostSupportsSVEBitPerm) {
+    // SVE2 BITPERM computes the whole deposit in the bottom lane of one
+    // instruction - no loop, no static register spills.
+    if (OpSize == 8) {
+      fmov(ARMEmitter::Size::i64Bit, VTMP1.D(), Input);
+      fmov(ARMEmitter::Size::i64Bit, VTMP2.D(), Mask);
+      bdep(ARMEmitter::SubRegSize::i64Bit, VTMP1.Z(), VTMP1.Z(), VTMP2.Z());
+      fmov(ARMEmitter::Size::i64Bit, Dest, VTMP1.D());
+    } else {
+      fmov(ARMEmitter::Size::i32Bit, VTMP1.S(), Input);
+      fmov(ARMEmitter::Size::i32Bit, VTMP2.S(), Mask);
+      bdep(ARMEmitter::SubRegSize::i32Bit, VTMP1.Z(), VTMP1.Z(), VTMP2.Z());
+      fmov(ARMEmitter::Size::i32Bit, Dest, VTMP1.S());
+    }
+    return;
+  }
+
   const auto ShiftedBitReg = TMP1.R();
   const auto BitReg        = TMP2.R();
   const auto SubMaskReg    = TMP3.R();
@@ -788,6 +825,22 @@ DEF_OP(PExt) {
   const auto Mask = GetReg(Op->Mask.ID());
   const auto Dest = GetReg(Node);
 
+  if (HostSupportsSVEBitPerm) {
+    // As with PDep above, BITPERM expresses the extract directly.
+    if (OpSize == 8) {
+      fmov(ARMEmitter::Size::i64Bit, VTMP1.D(), Input);
+      fmov(ARMEmitter::Size::i64Bit, VTMP2.D(), Mask);
+      bext(ARMEmitter::SubRegSize::i64Bit, VTMP1.Z(), VTMP1.Z(), VTMP2.Z());
+      fmov(ARMEmitter::Size::i64Bit, Dest, VTMP1.D());
+    } else {
+      fmov(ARMEmitter::Size::i32Bit, VTMP1.S(), Input);
+      fmov(ARMEmitter::Size::i32Bit, VTMP2.S(), Mask);
+      bext(ARMEmitter::SubRegSize::i32Bit, VTMP1.Z(), VTMP1.Z(), VTMP2.Z());
+      fmov(ARMEmitter::Size::i32Bit, Dest, VTMP1.S());
+    }
+    return;
+  }
+
   const auto MaskReg  = TMP1;
   const auto BitReg   = TMP2;
   const auto ValueReg = TMP3;
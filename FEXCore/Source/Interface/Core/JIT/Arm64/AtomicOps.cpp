@@ -11,6 +11,56 @@ $end_info$
 #include "Interface/Core/JIT/Arm64/JITClass.h"
 
 namespace FEXCore::CPU {
+// Guest locked RMW ops compile to acquire-release forms by default since an
+// x86 locked op is a full barrier. Once the process is already running with
+// relaxed memory ordering - single guest thread under TSO auto-migration, or
+// TSO disabled outright - IsAtomicRelaxedEnabled lets these drop to the
+// unordered forms. Uncontended reference counting dominates guest atomic
+// traffic and the barrier is pure cost there. Thread migration recompiles
+// through the same lookup cache clear that re-orders the TSO loadstores.
+//
+// The LL/SC fallback loops used to retry a failed store-exclusive
+// back-to-back, which keeps hammering a contended line and can starve the
+// competing writer that just stole it. On failure, count the event into the
+// process-wide strex-failure statistic so guest atomic contention shows up in
+// the stats export, and yield once before retrying so the owner gets a chance
+// to drain. Hosts with LSE never reach these loops - their single-instruction
+// atomics can't fail.
+void Arm64JITCore::EmitStrexRetry(ARMEmitter::Size EmitSize, ARMEmitter::XRegister Status, ARMEmitter::XRegister Scratch, ARMEmitter::BackwardLabel *LoopTop) {
+  ARMEmitter::ForwardLabel Done{};
+  cbz(EmitSize, Status, &Done);
+
+  // Plain load/add/store: losing an increment to the very race being measured
+  // is fine for a profiling counter, and an atomic increment here would need
+  // its own exclusive pair.
+  ldr(Status, STATE_PTR(CpuStateFrame, Pointers.Common.StatStrexFailureCounter));
+  ldr(Scratch, Status, 0);
+  add(ARMEmitter::Size::i64Bit, Scratch, Scratch, 1);
+  str(Scratch, Status, 0);
+
+  yield();
+  b(LoopTop);
+  Bind(&Done);
+}
+
+void Arm64JITCore::EmitExclusiveLoad(ARMEmitter::SubRegSize Size, ARMEmitter::Register Dst, ARMEmitter::Register Addr) {
+  if (CTX->IsAtomicRelaxedEnabled()) {
+    ldxr(Size, Dst, Addr);
+  }
+  else {
+    ldaxr(Size, Dst, Addr);
+  }
+}
+
+void Arm64JITCore::EmitExclusiveStore(ARMEmitter::SubRegSize Size, ARMEmitter::Register Status, ARMEmitter::Register Src, ARMEmitter::Register Addr) {
+  if (CTX->IsAtomicRelaxedEnabled()) {
+    stxr(Size, Status, Src, Addr);
+  }
+  else {
+    stlxr(Size, Status, Src, Addr);
+  }
+}
+
 #define DEF_OP(x) void Arm64JITCore::Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
 DEF_OP(CASPair) {
   auto Op = IROp->C<IR::IROp_CASPair>();
@@ -22,11 +72,17 @@ DEF_OP(CASPair) {
   auto MemSrc = GetReg(Op->Addr.ID());
 
   const auto EmitSize = IROp->ElementSize == 8 ? ARMEmitter::Size::i64Bit : ARMEmitter::Size::i32Bit;
+  const bool Relaxed = CTX->IsAtomicRelaxedEnabled();
   if (CTX->HostFeatures.SupportsAtomics) {
     mov(EmitSize, TMP3, Expected.first);
     mov(EmitSize, TMP4, Expected.second);
 
-    caspal(EmitSize, TMP3, TMP4, Desired.first, Desired.second, MemSrc);
+    if (Relaxed) {
+      casp(EmitSize, TMP3, TMP4, Desired.first, Desired.second, MemSrc);
+    }
+    else {
+      caspal(EmitSize, TMP3, TMP4, Desired.first, Desired.second, MemSrc);
+    }
     mov(EmitSize, Dst.first, TMP3.R());
     mov(EmitSize, Dst.second, TMP4.R());
   }
@@ -36,12 +92,22 @@ DEF_OP(CASPair) {
     ARMEmitter::ForwardLabel LoopExpected;
     Bind(&LoopTop);
 
-    ldaxp(EmitSize, TMP2, TMP3, MemSrc);
+    if (Relaxed) {
+      ldxp(EmitSize, TMP2, TMP3, MemSrc);
+    }
+    else {
+      ldaxp(EmitSize, TMP2, TMP3, MemSrc);
+    }
     cmp(EmitSize, TMP2, Expected.first);
     ccmp(EmitSize, TMP3, Expected.second, ARMEmitter::StatusFlags::None, ARMEmitter::Condition::CC_EQ);
     b(ARMEmitter::Condition::CC_NE, &LoopNotExpected);
-    stlxp(EmitSize, TMP2, Desired.first, Desired.second, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    if (Relaxed) {
+      stxp(EmitSize, TMP2, Desired.first, Desired.second, MemSrc);
+    }
+    else {
+      stlxp(EmitSize, TMP2, Desired.first, Desired.second, MemSrc);
+    }
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
     mov(EmitSize, Dst.first, Expected.first);
     mov(EmitSize, Dst.second, Expected.second);
 
@@ -75,9 +141,15 @@ DEF_OP(CAS) {
     OpSize == 2 ? ARMEmitter::SubRegSize::i16Bit :
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
+  const bool Relaxed = CTX->IsAtomicRelaxedEnabled();
   if (CTX->HostFeatures.SupportsAtomics) {
     mov(EmitSize, TMP2, Expected);
-    casal(SubEmitSize, TMP2, Desired, MemSrc);
+    if (Relaxed) {
+      cas(SubEmitSize, TMP2, Desired, MemSrc);
+    }
+    else {
+      casal(SubEmitSize, TMP2, Desired, MemSrc);
+    }
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
   else {
@@ -85,7 +157,7 @@ DEF_OP(CAS) {
     ARMEmitter::ForwardLabel LoopNotExpected;
     ARMEmitter::ForwardLabel LoopExpected;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     if (OpSize == 1) {
       cmp(EmitSize, TMP2, Expected, ARMEmitter::ExtendedType::UXTB, 0);
     }
@@ -96,8 +168,8 @@ DEF_OP(CAS) {
       cmp(EmitSize, TMP2, Expected);
     }
     b(ARMEmitter::Condition::CC_NE, &LoopNotExpected);
-    stlxr(SubEmitSize, TMP3, Desired, MemSrc);
-    cbnz(EmitSize, TMP3, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP3, Desired, MemSrc);
+    EmitStrexRetry(EmitSize, TMP3, TMP2, &LoopTop);
     mov(EmitSize, GetReg(Node), Expected);
     b(&LoopExpected);
 
@@ -125,15 +197,20 @@ DEF_OP(AtomicAdd) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    staddl(SubEmitSize, Src, MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      stadd(SubEmitSize, Src, MemSrc);
+    }
+    else {
+      staddl(SubEmitSize, Src, MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     add(EmitSize, TMP2, TMP2, Src);
-    stlxr(SubEmitSize, TMP2, TMP2, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP2, TMP2, MemSrc);
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
   }
 }
 
@@ -153,15 +230,20 @@ DEF_OP(AtomicSub) {
 
   if (CTX->HostFeatures.SupportsAtomics) {
     neg(EmitSize, TMP2, Src);
-    staddl(SubEmitSize, TMP2, MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      stadd(SubEmitSize, TMP2, MemSrc);
+    }
+    else {
+      staddl(SubEmitSize, TMP2, MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     sub(EmitSize, TMP2, TMP2, Src);
-    stlxr(SubEmitSize, TMP2, TMP2, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP2, TMP2, MemSrc);
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
   }
 }
 
@@ -181,15 +263,20 @@ DEF_OP(AtomicAnd) {
 
   if (CTX->HostFeatures.SupportsAtomics) {
     mvn(EmitSize, TMP2, Src);
-    stclrl(SubEmitSize, TMP2, MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      stclr(SubEmitSize, TMP2, MemSrc);
+    }
+    else {
+      stclrl(SubEmitSize, TMP2, MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     and_(EmitSize, TMP2, TMP2, Src);
-    stlxr(SubEmitSize, TMP2, TMP2, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP2, TMP2, MemSrc);
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
   }
 }
 
@@ -208,15 +295,20 @@ DEF_OP(AtomicCLR) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    stclrl(SubEmitSize, Src, MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      stclr(SubEmitSize, Src, MemSrc);
+    }
+    else {
+      stclrl(SubEmitSize, Src, MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     bic(EmitSize, TMP2, TMP2, Src);
-    stlxr(SubEmitSize, TMP2, TMP2, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP2, TMP2, MemSrc);
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
   }
 }
 
@@ -235,15 +327,20 @@ DEF_OP(AtomicOr) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    stsetl(SubEmitSize, Src, MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      stset(SubEmitSize, Src, MemSrc);
+    }
+    else {
+      stsetl(SubEmitSize, Src, MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     orr(EmitSize, TMP2, TMP2, Src);
-    stlxr(SubEmitSize, TMP2, TMP2, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP2, TMP2, MemSrc);
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
   }
 }
 
@@ -262,15 +359,20 @@ DEF_OP(AtomicXor) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    steorl(SubEmitSize, Src, MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      steor(SubEmitSize, Src, MemSrc);
+    }
+    else {
+      steorl(SubEmitSize, Src, MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     eor(EmitSize, TMP2, TMP2, Src);
-    stlxr(SubEmitSize, TMP2, TMP2, MemSrc);
-    cbnz(EmitSize, TMP2, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP2, TMP2, MemSrc);
+    EmitStrexRetry(EmitSize, TMP2, TMP3, &LoopTop);
   }
 }
 
@@ -289,10 +391,10 @@ DEF_OP(AtomicNeg) {
 
   ARMEmitter::BackwardLabel LoopTop;
   Bind(&LoopTop);
-  ldaxr(SubEmitSize, TMP2, MemSrc);
+  EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
   neg(EmitSize, TMP3, TMP2);
-  stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-  cbnz(EmitSize, TMP4, &LoopTop);
+  EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+  EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
 }
 
 DEF_OP(AtomicSwap) {
@@ -311,14 +413,19 @@ DEF_OP(AtomicSwap) {
 
   if (CTX->HostFeatures.SupportsAtomics) {
     mov(EmitSize, TMP2, Src);
-    ldswpal(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldswp(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    }
+    else {
+      ldswpal(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
-    stlxr(SubEmitSize, TMP4, Src, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveStore(SubEmitSize, TMP4, Src, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     ubfm(EmitSize, GetReg(Node), TMP2, 0, OpSize * 8 - 1);
   }
 }
@@ -338,15 +445,20 @@ DEF_OP(AtomicFetchAdd) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    ldaddal(SubEmitSize, Src, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldadd(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
+    else {
+      ldaddal(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     add(EmitSize, TMP3, TMP2, Src);
-    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
 }
@@ -367,15 +479,20 @@ DEF_OP(AtomicFetchSub) {
 
   if (CTX->HostFeatures.SupportsAtomics) {
     neg(EmitSize, TMP2, Src);
-    ldaddal(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldadd(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    }
+    else {
+      ldaddal(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     sub(EmitSize, TMP3, TMP2, Src);
-    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
 }
@@ -396,15 +513,20 @@ DEF_OP(AtomicFetchAnd) {
 
   if (CTX->HostFeatures.SupportsAtomics) {
     mvn(EmitSize, TMP2, Src);
-    ldclral(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldclr(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    }
+    else {
+      ldclral(SubEmitSize, TMP2, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     and_(EmitSize, TMP3, TMP2, Src);
-    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
 }
@@ -424,15 +546,20 @@ DEF_OP(AtomicFetchCLR) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    ldclral(SubEmitSize, Src, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldclr(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
+    else {
+      ldclral(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     bic(EmitSize, TMP3, TMP2, Src);
-    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
 }
@@ -452,15 +579,20 @@ DEF_OP(AtomicFetchOr) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    ldsetal(SubEmitSize, Src, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldset(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
+    else {
+      ldsetal(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     orr(EmitSize, TMP3, TMP2, Src);
-    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
 }
@@ -480,15 +612,20 @@ DEF_OP(AtomicFetchXor) {
     OpSize == 1 ? ARMEmitter::SubRegSize::i8Bit : ARMEmitter::SubRegSize::i8Bit;
 
   if (CTX->HostFeatures.SupportsAtomics) {
-    ldeoral(SubEmitSize, Src, GetReg(Node), MemSrc);
+    if (CTX->IsAtomicRelaxedEnabled()) {
+      ldeor(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
+    else {
+      ldeoral(SubEmitSize, Src, GetReg(Node), MemSrc);
+    }
   }
   else {
     ARMEmitter::BackwardLabel LoopTop;
     Bind(&LoopTop);
-    ldaxr(SubEmitSize, TMP2, MemSrc);
+    EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
     eor(EmitSize, TMP3, TMP2, Src);
-    stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-    cbnz(EmitSize, TMP4, &LoopTop);
+    EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+    EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
     mov(EmitSize, GetReg(Node), TMP2.R());
   }
 }
@@ -508,10 +645,10 @@ DEF_OP(AtomicFetchNeg) {
 
   ARMEmitter::BackwardLabel LoopTop;
   Bind(&LoopTop);
-  ldaxr(SubEmitSize, TMP2, MemSrc);
+  EmitExclusiveLoad(SubEmitSize, TMP2, MemSrc);
   neg(EmitSize, TMP3, TMP2);
-  stlxr(SubEmitSize, TMP4, TMP3, MemSrc);
-  cbnz(EmitSize, TMP4, &LoopTop);
+  EmitExclusiveStore(SubEmitSize, TMP4, TMP3, MemSrc);
+  EmitStrexRetry(EmitSize, TMP4, TMP3, &LoopTop);
   mov(EmitSize, GetReg(Node), TMP2.R());
 }
 
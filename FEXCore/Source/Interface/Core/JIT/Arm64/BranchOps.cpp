@@ -16,8 +16,11 @@ $end_info$
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Statistics.h>
 #include <Interface/HLE/Thunks/Thunks.h>
 
+#include <bit>
+
 namespace FEXCore::CPU {
 #define DEF_OP(x) void Arm64JITCore::Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
 
@@ -56,36 +59,177 @@ DEF_OP(ExitFunction) {
     ARMEmitter::ForwardLabel l_BranchHost;
     ARMEmitter::ForwardLabel l_BranchGuest;
 
-    ldr(ARMEmitter::XReg::x0, &l_BranchHost);
-    blr(ARMEmitter::Reg::r0);
-
-    Bind(&l_BranchHost);
-    dc64(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
-    Bind(&l_BranchGuest);
-    dc64(NewRIP);
+    // Links into pages that have already invalidated once get a generation
+    // stamp ahead of the direct branch: the fast path compares the global
+    // invalidation epoch against the epoch stamped at link time and only
+    // takes the patched branch on a match. Severing such a link is a single
+    // stamp write with no code patching, and a relink after unrelated SMC is
+    // just a restamp, so churny guest JIT regions stop paying the
+    // delink/repatch icache dance on every invalidation. Stable pages keep
+    // the plain two-instruction site and the unconditional patched branch.
+    const bool GuardedLink = ((Entry ^ NewRIP) >> 12) != 0 && CTX->IsVolatileCodePage(NewRIP);
+
+    if (GuardedLink) {
+      ARMEmitter::ForwardLabel l_Slow;
+      ARMEmitter::ForwardLabel l_EpochPtr;
+      ARMEmitter::ForwardLabel l_EpochStamp;
+
+      ldr(ARMEmitter::XReg::x0, &l_EpochPtr);
+      ldr(ARMEmitter::XReg::x0, ARMEmitter::Reg::r0, 0);
+      ldr(ARMEmitter::XReg::x1, &l_EpochStamp);
+      sub(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, ARMEmitter::XReg::x1);
+      cbnz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, &l_Slow);
+      // Patched to branch directly to the host block once linked.
+      b(&l_Slow);
+
+      Bind(&l_Slow);
+      ldr(ARMEmitter::XReg::x0, &l_BranchHost);
+      blr(ARMEmitter::Reg::r0);
+
+      Bind(&l_BranchHost);
+      dc64(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
+      Bind(&l_BranchGuest);
+      dc64(NewRIP | FEXCore::Context::ContextImpl::GUARDED_LINK_FLAG);
+      Bind(&l_EpochPtr);
+      dc64(reinterpret_cast<uint64_t>(&CTX->InvalidationJournal.Epoch));
+      Bind(&l_EpochStamp);
+      // No epoch can ever match until the linker stamps the site.
+      dc64(~0ULL);
+    } else {
+      ldr(ARMEmitter::XReg::x0, &l_BranchHost);
+      blr(ARMEmitter::Reg::r0);
+
+      Bind(&l_BranchHost);
+      dc64(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
+      Bind(&l_BranchGuest);
+      dc64(NewRIP);
+    }
 
   } else {
 
     ARMEmitter::ForwardLabel FullLookup;
+    ARMEmitter::ForwardLabel SecondSlot;
+    ARMEmitter::ForwardLabel L1Lookup;
+    ARMEmitter::ForwardLabel NoReturnPrediction;
+    ARMEmitter::ForwardLabel l_Slot0Host;
+    ARMEmitter::ForwardLabel l_Slot0Guest;
+    ARMEmitter::ForwardLabel l_Slot1Host;
+    ARMEmitter::ForwardLabel l_Slot1Guest;
     auto RipReg = GetReg(Op->NewRIP.ID());
 
+    if (Op->Return) {
+      // Pop the shadow return-address stack pushed by the CALL lowering.
+      // The pop is speculative, a mismatch only costs the lookup below.
+      ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnPredictionIndex));
+      add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, STATE.R(), offsetof(FEXCore::Core::CpuStateFrame, ReturnPredictionStack));
+      add(ARMEmitter::XReg::x3, ARMEmitter::XReg::x3, ARMEmitter::XReg::x0, ARMEmitter::ShiftType::LSL, 4);
+      sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, 1);
+      and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, ARMEmitter::Reg::r0, FEXCore::Core::CpuStateFrame::RETURN_PREDICTION_STACK_MASK);
+      str(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnPredictionIndex));
+
+      ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x0, ARMEmitter::XReg::x1, ARMEmitter::Reg::r3, 0);
+      cbz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r1, &NoReturnPrediction);
+      sub(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, RipReg.X());
+      cbnz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, &NoReturnPrediction);
+      br(ARMEmitter::Reg::r1);
+
+      Bind(&NoReturnPrediction);
+    }
+
+    // Chained target prediction. Compare against the last targets this exit
+    // branched to before falling back to the L1 cache. The slots start out
+    // invalid and get trained by the predictor linker on the full lookup path.
+    // Note: sub+cbnz used over cmp+br to preserve flags.
+    ldr(ARMEmitter::XReg::x0, &l_Slot0Guest);
+    sub(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, RipReg.X());
+    cbnz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, &SecondSlot);
+    ldr(ARMEmitter::XReg::x1, &l_Slot0Host);
+    br(ARMEmitter::Reg::r1);
+
+    Bind(&SecondSlot);
+    ldr(ARMEmitter::XReg::x0, &l_Slot1Guest);
+    sub(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, RipReg.X());
+    cbnz(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, &L1Lookup);
+    ldr(ARMEmitter::XReg::x1, &l_Slot1Host);
+    br(ARMEmitter::Reg::r1);
+
+    Bind(&L1Lookup);
     // L1 Cache
+    // The mask is loaded rather than baked in since the L1 table can grow at runtime
     ldr(ARMEmitter::XReg::x0, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1Pointer));
-
-    and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg, LookupCache::L1_ENTRIES_MASK);
+    ldr(ARMEmitter::XReg::x3, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1EntriesMask));
+
+    // The index computation must match LookupCache::HashRIP
+    if (CTX->HostFeatures.SupportsCRC) {
+      crc32cx(ARMEmitter::XReg::x1, ARMEmitter::XReg::zr, RipReg.X());
+      and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, ARMEmitter::Reg::r1, ARMEmitter::Reg::r3);
+    } else {
+      and_(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r3, RipReg, ARMEmitter::Reg::r3);
+    }
     add(ARMEmitter::XReg::x0, ARMEmitter::XReg::x0, ARMEmitter::XReg::x3, ARMEmitter::ShiftType::LSL, 4);
 
-    // Note: sub+cbnz used over cmp+br to preserve flags.
     ldp<ARMEmitter::IndexType::OFFSET>(ARMEmitter::XReg::x1, ARMEmitter::XReg::x0, ARMEmitter::Reg::r0, 0);
     sub(TMP1, ARMEmitter::XReg::x0, RipReg.X());
     cbnz(ARMEmitter::Size::i64Bit, TMP1, &FullLookup);
     br(ARMEmitter::Reg::r1);
 
     Bind(&FullLookup);
-    ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.DispatcherLoopTop));
+    // Full lookup goes through the predictor linker so the chain gets trained.
+    // It handles the dispatcher round trip when the block doesn't exist yet.
     str(RipReg.X(), STATE, offsetof(FEXCore::Core::CpuStateFrame, State.rip));
-    br(TMP1);
+    ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.IndirectBranchPredictorLinker));
+    blr(TMP1.R());
+
+    // Prediction slots. These must directly follow the blr, the linker finds
+    // them through LR. Layout matches ContextImpl::IndirectPredictionStub.
+    Bind(&l_Slot0Host);
+    dc64(0);
+    Bind(&l_Slot0Guest);
+    dc64(~0ULL);
+    Bind(&l_Slot1Host);
+    dc64(0);
+    Bind(&l_Slot1Guest);
+    dc64(~0ULL);
+  }
+}
+
+DEF_OP(PushReturnPrediction) {
+  auto Op = IROp->C<IR::IROp_PushReturnPrediction>();
+  auto ReturnRIP = GetReg(Op->ReturnRIP.ID());
+
+  ARMEmitter::ForwardLabel Store;
+
+  // Advance the ring index
+  ldr(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnPredictionIndex));
+  add(ARMEmitter::Size::i64Bit, TMP1.R(), TMP1.R(), 1);
+  and_(ARMEmitter::Size::i64Bit, TMP1.R(), TMP1.R(), FEXCore::Core::CpuStateFrame::RETURN_PREDICTION_STACK_MASK);
+  str(TMP1, STATE, offsetof(FEXCore::Core::CpuStateFrame, ReturnPredictionIndex));
+
+  // TMP2 = &ReturnPredictionStack[Index]
+  add(ARMEmitter::Size::i64Bit, TMP2.R(), STATE.R(), offsetof(FEXCore::Core::CpuStateFrame, ReturnPredictionStack));
+  add(TMP2, TMP2, TMP1, ARMEmitter::ShiftType::LSL, 4);
+
+  // Probe the L1 cache for the return target's host block. On a miss store
+  // zero, the matching RET then falls back to the normal lookup path.
+  // Note: sub+cbz used over cmp+br to preserve flags.
+  ldr(TMP3, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1Pointer));
+  ldr(TMP4, STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.L1EntriesMask));
+  // The index computation must match LookupCache::HashRIP. TMP1 held the ring
+  // index, which is dead once the slot address is formed above.
+  if (CTX->HostFeatures.SupportsCRC) {
+    crc32cx(TMP1, ARMEmitter::XReg::zr, ReturnRIP.X());
+    and_(ARMEmitter::Size::i64Bit, TMP4.R(), TMP1.R(), TMP4.R());
+  } else {
+    and_(ARMEmitter::Size::i64Bit, TMP4.R(), ReturnRIP, TMP4.R());
   }
+  add(TMP3, TMP3, TMP4, ARMEmitter::ShiftType::LSL, 4);
+  ldp<ARMEmitter::IndexType::OFFSET>(TMP4, TMP3, TMP3.R(), 0);
+  sub(TMP3, TMP3, ReturnRIP.X());
+  cbz(ARMEmitter::Size::i64Bit, TMP3.R(), &Store);
+  mov(TMP4, 0);
+
+  Bind(&Store);
+  stp<ARMEmitter::IndexType::OFFSET>(ReturnRIP.X(), TMP4, TMP2.R(), 0);
 }
 
 DEF_OP(Jump) {
@@ -131,24 +275,34 @@ DEF_OP(CondJump) {
   if (Op->FromNZCV) {
     b(MapBranchCC(Op->Cond), TrueTargetLabel);
   } else {
-    [[maybe_unused]] uint64_t Const;
+    uint64_t Const{};
     [[maybe_unused]] const bool isConst = IsInlineConstant(Op->Cmp2, &Const);
 
     const auto Size = Op->CompareSize == 4 ? ARMEmitter::Size::i32Bit : ARMEmitter::Size::i64Bit;
 
     LOGMAN_THROW_A_FMT(IsGPR(Op->Cmp1.ID()), "CondJump: Expected GPR");
-    LOGMAN_THROW_A_FMT(isConst && Const == 0, "CondJump: Expected 0 source");
+    LOGMAN_THROW_A_FMT(isConst && (Const == 0 || std::popcount(Const) == 1),
+                       "CondJump: Expected 0 or single bit source");
     LOGMAN_THROW_A_FMT(Op->Cond.Val == FEXCore::IR::COND_EQ ||
                        Op->Cond.Val == FEXCore::IR::COND_NEQ,
                        "CondJump: Expected simple condition");
 
-    if (Op->Cond.Val == FEXCore::IR::COND_EQ) {
-      cbz(Size, GetReg(Op->Cmp1.ID()), TrueTargetLabel);
-    } else  {
-      cbnz(Size, GetReg(Op->Cmp1.ID()), TrueTargetLabel);
+    if (Const == 0) {
+      if (Op->Cond.Val == FEXCore::IR::COND_EQ) {
+        cbz(Size, GetReg(Op->Cmp1.ID()), TrueTargetLabel);
+      } else  {
+        cbnz(Size, GetReg(Op->Cmp1.ID()), TrueTargetLabel);
+      }
+    } else {
+      // A single bit constant is a bit test against zero, ConstProp only
+      // generates these with EQ/NEQ conditions
+      const auto Bit = std::countr_zero(Const);
+      if (Op->Cond.Val == FEXCore::IR::COND_EQ) {
+        tbz(GetReg(Op->Cmp1.ID()), Bit, TrueTargetLabel);
+      } else {
+        tbnz(GetReg(Op->Cmp1.ID()), Bit, TrueTargetLabel);
+      }
     }
-
-    // TODO: Wire up tbz/tbnz
   }
 
   PendingTargetLabel = &JumpTargets.try_emplace(Op->FalseBlock.ID()).first->second;
@@ -330,6 +484,17 @@ DEF_OP(Thunk) {
 
   PushDynamicRegsAndLR(TMP1);
 
+  if (CTX->HostFeatures.SupportsAtomics) {
+    // Count the crossing for live statistics. This is the only place thunk
+    // calls pass through once compiled, and the full spill/fill around the
+    // call dwarfs a single atomic add. Skipped without LSE rather than
+    // emitting an exclusive loop for a diagnostics counter.
+    auto CounterAddr = FEXCore::Statistics::GetStat(FEXCore::Statistics::STAT_THUNK_CROSSINGS).GetAddr();
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP1, reinterpret_cast<uintptr_t>(CounterAddr));
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP2, 1);
+    staddl(ARMEmitter::SubRegSize::i64Bit, TMP2, TMP1);
+  }
+
   mov(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::r0, GetReg(Op->ArgPtr.ID()));
 
   auto thunkFn = static_cast<Context::ContextImpl*>(ThreadState->CTX)->ThunkHandler->LookupThunk(Op->ThunkNameHash);
@@ -423,8 +588,9 @@ DEF_OP(ThreadRemoveCodeEntry) {
 DEF_OP(CPUID) {
   auto Op = IROp->C<IR::IROp_CPUID>();
 
-  PushDynamicRegsAndLR(TMP1);
-  SpillStaticRegs(TMP1);
+  // RunFunction carries the restricted clobber annotation when the compiler
+  // supports it, so only the caller-saved subset needs to hit memory.
+  SpillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, TMP1, true);
 
   // x0 = CPUID Handler
   // x1 = CPUID Function
@@ -440,9 +606,7 @@ DEF_OP(CPUID) {
     blr(ARMEmitter::Reg::r3);
   }
 
-  FillStaticRegs();
-
-  PopDynamicRegsAndLR();
+  FillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, true);
 
   // Results are in x0, x1
   // Results want to be in a i64v2 vector
@@ -454,8 +618,8 @@ DEF_OP(CPUID) {
 DEF_OP(XGetBV) {
   auto Op = IROp->C<IR::IROp_XGetBV>();
 
-  PushDynamicRegsAndLR(TMP1);
-  SpillStaticRegs(TMP1);
+  // As with CPUID, the handler only clobbers the restricted ABI subset.
+  SpillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, TMP1, true);
 
   // x0 = CPUID Handler
   // x1 = XCR Function
@@ -469,9 +633,7 @@ DEF_OP(XGetBV) {
     blr(ARMEmitter::Reg::r2);
   }
 
-  FillStaticRegs();
-
-  PopDynamicRegsAndLR();
+  FillForABICall(FEXCORE_HAS_PRESERVE_ALL_ATTR, true);
 
   // Results are in x0
   // Results want to be in a i32v2 vector
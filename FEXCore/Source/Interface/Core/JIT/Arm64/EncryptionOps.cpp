@@ -17,6 +17,110 @@ DEF_OP(VAESImc) {
   aesimc(GetVReg(Node), GetVReg(Op->Vector.ID()));
 }
 
+// Decides whether an AES op can skip its trailing round key EOR and hand the
+// key to the consuming AES op instead.
+//
+// The x86 rounds XOR the round key at the end while AESE/AESD XOR their key
+// operand at the start, which is why each op normally burns an EOR bridging
+// the two conventions. When one round feeds the next directly the two cancel
+// out: the consumer's AESE picks up our key operand and lands at the exact
+// same point in the cipher. This turns long AES-GCM round chains in to the
+// AESE+AESMC pairs that hardware fuses.
+//
+// Requires the result to have exactly one use, that use to be the State input
+// of a later AES op in the same block, and nothing in between that could
+// overwrite the key's register once its live-range has been released.
+bool Arm64JITCore::TryDeferAESKeyEOR(IR::NodeID Node, ARMEmitter::VRegister Dst, IR::OrderedNodeWrapper Key) {
+  const auto KeyReg = GetVReg(Key.ID());
+
+  // The fused form leaves the pre-EOR state in Dst, so the key needs to
+  // survive in a different register until the consumer reads it.
+  if (Dst == KeyReg) {
+    return false;
+  }
+
+  auto [CodeNode, HeaderOp] = IR->at(Node)();
+  if (CodeNode->GetUses() != 1) {
+    return false;
+  }
+
+  // A static key register can additionally be rewritten by a guest register
+  // store, which carries no SSA destination we could check below.
+  const bool KeyIsStatic = GetPhys(Key.ID()).Class == IR::FPRFixedClass.Val;
+
+  // Round chains sit back-to-back; give up early instead of walking the
+  // remainder of a large block.
+  constexpr uint32_t MaxScanLength = 32;
+
+  auto It = IR->at(Node);
+  for (uint32_t i = 0; i < MaxScanLength; ++i) {
+    ++It;
+    auto [ScanNode, ScanOp] = It();
+
+    const bool IsAES = ScanOp->Op == IR::OP_VAESENC || ScanOp->Op == IR::OP_VAESENCLAST ||
+                       ScanOp->Op == IR::OP_VAESDEC || ScanOp->Op == IR::OP_VAESDECLAST;
+
+    if (IsAES) {
+      // All four AES ops share the VAESEnc operand layout.
+      if (ScanOp->C<IR::IROp_VAESEnc>()->State.ID() == Node) {
+        DeferredAESKeys[Node] = KeyReg;
+        return true;
+      }
+    }
+    else {
+      switch (ScanOp->Op) {
+        case IR::OP_LOADREGISTER:
+        case IR::OP_LOADCONTEXT:
+        case IR::OP_LOADMEM:
+        case IR::OP_LOADMEMTSO:
+        case IR::OP_STORECONTEXT:
+        case IR::OP_STOREMEM:
+        case IR::OP_STOREMEMTSO:
+        case IR::OP_CONSTANT:
+        case IR::OP_LOADNAMEDVECTORCONSTANT:
+          break;
+        case IR::OP_STOREREGISTER:
+          if (KeyIsStatic) {
+            return false;
+          }
+          break;
+        default:
+          // Anything else may clobber registers in ways this scan doesn't track.
+          return false;
+      }
+    }
+
+    // Any other consumer needs the post-EOR value.
+    const uint8_t NumArgs = IR::GetRAArgs(ScanOp->Op);
+    for (uint8_t Arg = 0; Arg < NumArgs; ++Arg) {
+      if (ScanOp->Args[Arg].ID() == Node) {
+        return false;
+      }
+    }
+
+    // The key's register is free for reuse past this op, so any result landing
+    // in it would corrupt the deferred key.
+    if (IR::GetHasDest(ScanOp->Op) && IsFPR(It.ID()) && GetVReg(It.ID()) == KeyReg) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+// Returns the AESE/AESD key operand for an AES op: the round key deferred by
+// the producer of State when rounds fused, otherwise the zero register.
+ARMEmitter::VRegister Arm64JITCore::TakeDeferredAESKey(IR::OrderedNodeWrapper State, ARMEmitter::VRegister ZeroReg) {
+  auto Deferred = DeferredAESKeys.find(State.ID());
+  if (Deferred == DeferredAESKeys.end()) {
+    return ZeroReg;
+  }
+
+  const auto KeyReg = Deferred->second;
+  DeferredAESKeys.erase(Deferred);
+  return KeyReg;
+}
+
 DEF_OP(VAESEnc) {
   const auto Op = IROp->C<IR::IROp_VAESEnc>();
   const auto OpSize = IROp->Size;
@@ -29,18 +133,30 @@ DEF_OP(VAESEnc) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
+  // Fuse back-to-back rounds where possible: a fused producer handed us its
+  // round key in place of the zero register, and we try to hand ours forward.
+  const auto RoundKey = TakeDeferredAESKey(Op->State, ZeroReg);
+  const bool DeferEOR = TryDeferAESKeyEOR(Node, Dst, Op->Key);
+
   if (Dst == State && Dst != Key) {
     // Optimal case in which Dst already contains the starting state.
     // This matches the common case of XMM AES.
-    aese(Dst.Q(), ZeroReg.Q());
+    aese(Dst.Q(), RoundKey.Q());
     aesmc(Dst.Q(), Dst.Q());
-    eor(Dst.Q(), Dst.Q(), Key.Q());
+    if (!DeferEOR) {
+      eor(Dst.Q(), Dst.Q(), Key.Q());
+    }
   }
   else {
     mov(VTMP1.Q(), State.Q());
-    aese(VTMP1, ZeroReg.Q());
+    aese(VTMP1, RoundKey.Q());
     aesmc(VTMP1, VTMP1);
-    eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    if (DeferEOR) {
+      mov(Dst.Q(), VTMP1.Q());
+    }
+    else {
+      eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    }
   }
 }
 
@@ -56,16 +172,26 @@ DEF_OP(VAESEncLast) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
+  const auto RoundKey = TakeDeferredAESKey(Op->State, ZeroReg);
+  const bool DeferEOR = TryDeferAESKeyEOR(Node, Dst, Op->Key);
+
   if (Dst == State && Dst != Key) {
     // Optimal case in which Dst already contains the starting state.
     // This matches the common case of XMM AES.
-    aese(Dst.Q(), ZeroReg.Q());
-    eor(Dst.Q(), Dst.Q(), Key.Q());
+    aese(Dst.Q(), RoundKey.Q());
+    if (!DeferEOR) {
+      eor(Dst.Q(), Dst.Q(), Key.Q());
+    }
   }
   else {
     mov(VTMP1.Q(), State.Q());
-    aese(VTMP1, ZeroReg.Q());
-    eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    aese(VTMP1, RoundKey.Q());
+    if (DeferEOR) {
+      mov(Dst.Q(), VTMP1.Q());
+    }
+    else {
+      eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    }
   }
 }
 
@@ -81,18 +207,28 @@ DEF_OP(VAESDec) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
+  const auto RoundKey = TakeDeferredAESKey(Op->State, ZeroReg);
+  const bool DeferEOR = TryDeferAESKeyEOR(Node, Dst, Op->Key);
+
   if (Dst == State && Dst != Key) {
     // Optimal case in which Dst already contains the starting state.
     // This matches the common case of XMM AES.
-    aesd(Dst.Q(), ZeroReg.Q());
+    aesd(Dst.Q(), RoundKey.Q());
     aesimc(Dst.Q(), Dst.Q());
-    eor(Dst.Q(), Dst.Q(), Key.Q());
+    if (!DeferEOR) {
+      eor(Dst.Q(), Dst.Q(), Key.Q());
+    }
   }
   else {
     mov(VTMP1.Q(), State.Q());
-    aesd(VTMP1, ZeroReg.Q());
+    aesd(VTMP1, RoundKey.Q());
     aesimc(VTMP1, VTMP1);
-    eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    if (DeferEOR) {
+      mov(Dst.Q(), VTMP1.Q());
+    }
+    else {
+      eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    }
   }
 }
 
@@ -108,16 +244,26 @@ DEF_OP(VAESDecLast) {
   LOGMAN_THROW_AA_FMT(OpSize == Core::CPUState::XMM_SSE_REG_SIZE,
                       "Currently only supports 128-bit operations.");
 
+  const auto RoundKey = TakeDeferredAESKey(Op->State, ZeroReg);
+  const bool DeferEOR = TryDeferAESKeyEOR(Node, Dst, Op->Key);
+
   if (Dst == State && Dst != Key) {
     // Optimal case in which Dst already contains the starting state.
     // This matches the common case of XMM AES.
-    aesd(Dst.Q(), ZeroReg.Q());
-    eor(Dst.Q(), Dst.Q(), Key.Q());
+    aesd(Dst.Q(), RoundKey.Q());
+    if (!DeferEOR) {
+      eor(Dst.Q(), Dst.Q(), Key.Q());
+    }
   }
   else {
     mov(VTMP1.Q(), State.Q());
-    aesd(VTMP1, ZeroReg.Q());
-    eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    aesd(VTMP1, RoundKey.Q());
+    if (DeferEOR) {
+      mov(Dst.Q(), VTMP1.Q());
+    }
+    else {
+      eor(Dst.Q(), VTMP1.Q(), Key.Q());
+    }
   }
 }
 
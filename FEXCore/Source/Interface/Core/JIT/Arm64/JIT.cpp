@@ -32,33 +32,41 @@ $end_info$
 
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 
+#include <algorithm>
 #include <stdio.h>
 #include <unistd.h>
 #include <string.h>
+#include <xxhash.h>
 
 static constexpr size_t INITIAL_CODE_SIZE = 1024 * 1024 * 16;
 // We don't want to move above 128MB atm because that means we will have to encode longer jumps
 static constexpr size_t MAX_CODE_SIZE = 1024 * 1024 * 128;
 
 namespace {
+// The long divide helpers are compiled with the restricted clobber ABI where
+// available so the dispatcher trampolines can skip most of the register spill.
+FEXCORE_PRESERVE_ALL_ATTR
 static uint64_t LUDIV(uint64_t SrcHigh, uint64_t SrcLow, uint64_t Divisor) {
   __uint128_t Source = (static_cast<__uint128_t>(SrcHigh) << 64) | SrcLow;
   __uint128_t Res = Source / Divisor;
   return Res;
 }
 
+FEXCORE_PRESERVE_ALL_ATTR
 static int64_t LDIV(int64_t SrcHigh, int64_t SrcLow, int64_t Divisor) {
   __int128_t Source = (static_cast<__int128_t>(SrcHigh) << 64) | SrcLow;
   __int128_t Res = Source / Divisor;
   return Res;
 }
 
+FEXCORE_PRESERVE_ALL_ATTR
 static uint64_t LUREM(uint64_t SrcHigh, uint64_t SrcLow, uint64_t Divisor) {
   __uint128_t Source = (static_cast<__uint128_t>(SrcHigh) << 64) | SrcLow;
   __uint128_t Res = Source % Divisor;
   return Res;
 }
 
+FEXCORE_PRESERVE_ALL_ATTR
 static int64_t LREM(int64_t SrcHigh, int64_t SrcLow, int64_t Divisor) {
   __int128_t Source = (static_cast<__int128_t>(SrcHigh) << 64) | SrcLow;
   __int128_t Res = Source % Divisor;
@@ -83,6 +91,18 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
     LOGMAN_MSG_A_FMT("Unhandled IR Op: {}", FEXCore::IR::GetName(IROp->Op));
 #endif
   } else {
+    if (ThreadState->CurrentFrame->Pointers.Common.FallbackCensusCounters) {
+      // Census bump ahead of the call so the telemetry dump can rank which
+      // fallback handlers the binary actually leans on. Plain load/add/store:
+      // the counters are shared between threads and a lost increment under a
+      // race doesn't matter for a ranking. The call itself dwarfs these three
+      // instructions.
+      ldr(TMP1, STATE_PTR(CpuStateFrame, Pointers.Common.FallbackCensusCounters));
+      ldr(TMP2, TMP1.R(), Info.HandlerIndex * sizeof(uint64_t));
+      add(ARMEmitter::Size::i64Bit, TMP2, TMP2, 1);
+      str(TMP2, TMP1.R(), Info.HandlerIndex * sizeof(uint64_t));
+    }
+
     switch(Info.ABI) {
       case FABI_F80_I16_F32:{
         SpillForABICall(Info.SupportsPreserveAllABI, TMP1, true);
@@ -438,10 +458,15 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
         break;
       }
       case FABI_I32_I128_I128_I16: {
-        SpillForABICall(Info.SupportsPreserveAllABI, TMP1, true);
-
         const auto Op = IROp->C<IR::IROp_VPCMPISTRX>();
 
+        // The common control modes lower natively on SVE2 hosts.
+        if (Emit_VPCMPISTRX_SVE(Node, Op)) {
+          break;
+        }
+
+        SpillForABICall(Info.SupportsPreserveAllABI, TMP1, true);
+
         const auto Src1 = GetVReg(Op->LHS.ID());
         const auto Src2 = GetVReg(Op->RHS.ID());
         const auto Control = Op->Control;
@@ -482,7 +507,8 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header const *IROp, IR::NodeID Node) {
 
 static uint64_t Arm64JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, FEXCore::Context::ContextImpl::ExitFunctionLinkData *Record) {
   auto Thread = Frame->Thread;
-  auto GuestRip = Record->GuestRIP;
+  const bool Guarded = (Record->GuestRIP & FEXCore::Context::ContextImpl::GUARDED_LINK_FLAG) != 0;
+  auto GuestRip = Record->GuestRIP & ~FEXCore::Context::ContextImpl::GUARDED_LINK_FLAG;
 
   auto HostCode = Thread->LookupCache->FindBlock(GuestRip);
 
@@ -494,6 +520,44 @@ static uint64_t Arm64JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Fram
   uintptr_t branch = (uintptr_t)(Record) - 8;
   auto LinkerAddress = Frame->Pointers.Common.ExitFunctionLinker;
 
+  if (Guarded) {
+    // Guard-stamped site: the patch slot is the branch right before the slow
+    // path, three instructions ahead of the literals.
+    branch = (uintptr_t)(Record) - 12;
+    auto GuardOffset = HostCode/4 - branch/4;
+    if (vixl::IsInt26(GuardOffset)) {
+      FEXCore::ARMEmitter::Emitter emit((uint8_t*)(branch), 4);
+      emit.b(GuardOffset);
+      FEXCore::ARMEmitter::Emitter::ClearICache((void*)branch, 4);
+
+      // Stamp once the branch is in place. The epoch can't move while this
+      // holds CodeInvalidationMutex shared since appenders hold it uniquely.
+      // The stamp is only ever read with data loads, so severing the link
+      // later is this store with no icache upkeep.
+      auto CTX = static_cast<FEXCore::Context::ContextImpl *>(Thread->CTX);
+      Record->EpochStamp = CTX->InvalidationJournal.Epoch.load(std::memory_order_relaxed);
+
+      Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)Record, [Record]{
+        Record->EpochStamp = ~0ULL;
+      });
+    } else {
+      // Out of direct-branch range. Degrade to the soft link: the stamp stays
+      // unset so every pass takes the slow path through the patched pointer.
+      Record->HostBranch = HostCode;
+
+      Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)Record, [Record, LinkerAddress]{
+        Record->HostBranch = LinkerAddress;
+      });
+    }
+
+    auto CTX = static_cast<FEXCore::Context::ContextImpl *>(Thread->CTX);
+    if (CTX->Config.CallGraphExport()) {
+      CTX->RecordCallGraphEdge(CTX->RestoreRIPFromHostPC(Thread, branch), GuestRip);
+    }
+
+    return HostCode;
+  }
+
   auto offset = HostCode/4 - branch/4;
   if (vixl::IsInt26(offset)) {
     // optimal case - can branch directly
@@ -522,6 +586,44 @@ static uint64_t Arm64JITCore_ExitFunctionLink(FEXCore::Core::CpuStateFrame *Fram
     });
   }
 
+  auto CTX = static_cast<FEXCore::Context::ContextImpl *>(Thread->CTX);
+  if (CTX->Config.CallGraphExport()) {
+    // The patch site sits in the source block, so the RIP reconstruction walk
+    // recovers the guest RIP the edge leaves from. One record per link, not
+    // per execution; the trampoline never runs again once patched.
+    CTX->RecordCallGraphEdge(CTX->RestoreRIPFromHostPC(Thread, branch), GuestRip);
+  }
+
+  return HostCode;
+}
+
+static uint64_t Arm64JITCore_IndirectBranchPredictorLink(FEXCore::Core::CpuStateFrame *Frame, FEXCore::Context::ContextImpl::IndirectPredictionStub *Stub) {
+  auto Thread = Frame->Thread;
+  auto GuestRip = Frame->State.rip;
+
+  auto HostCode = Thread->LookupCache->FindBlock(GuestRip);
+
+  if (!HostCode) {
+    return Frame->Pointers.Common.DispatcherLoopTop;
+  }
+
+  // Train the prediction chain. Newest target sits in slot zero, the oldest
+  // slot falls off the end. Slots are only ever read with data loads from the
+  // stub so no icache maintenance is required.
+  for (size_t i = FEXCore::Context::ContextImpl::IndirectPredictionChainLength - 1; i != 0; --i) {
+    Stub->Slots[i] = Stub->Slots[i - 1];
+  }
+  Stub->Slots[0] = { .HostCode = HostCode, .GuestRIP = GuestRip };
+
+  // Drop any slot predicting this target if the block gets invalidated
+  Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)Stub, [Stub, GuestRip]{
+    for (auto &Slot : Stub->Slots) {
+      if (Slot.GuestRIP == GuestRip) {
+        Slot = { .HostCode = 0, .GuestRIP = ~0ULL };
+      }
+    }
+  });
+
   return HostCode;
 }
 
@@ -532,6 +634,8 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::In
   : CPUBackend(Thread, INITIAL_CODE_SIZE, MAX_CODE_SIZE)
   , Arm64Emitter(ctx)
   , HostSupportsSVE128{ctx->HostFeatures.SupportsSVE}
+  , HostSupportsSVE2{ctx->HostFeatures.SupportsSVE2}
+  , HostSupportsSVEBitPerm{ctx->HostFeatures.SupportsSVEBitPerm}
   , HostSupportsSVE256{ctx->HostFeatures.SupportsAVX}
   , HostSupportsRPRES{ctx->HostFeatures.SupportsRPRES}
   , HostSupportsAFP{ctx->HostFeatures.SupportsAFP}
@@ -539,6 +643,9 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::In
 
   RAPass = Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA");
 
+  // Without SVE256 the widest spillable value is a 128-bit vector
+  SpillSlotSize = HostSupportsSVE256 ? MaxSpillSlotSize : 16;
+
   RAPass->AllocateRegisterSet(RegisterClasses);
 
   RAPass->AddRegisters(FEXCore::IR::GPRClass, GeneralRegisters.size());
@@ -577,9 +684,11 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::In
     Common.SyscallHandlerObj = reinterpret_cast<uint64_t>(CTX->SyscallHandler);
     Common.SyscallHandlerFunc = reinterpret_cast<uint64_t>(FEXCore::Context::HandleSyscall);
     Common.ExitFunctionLink = reinterpret_cast<uintptr_t>(&Context::ContextImpl::ThreadExitFunctionLink<Arm64JITCore_ExitFunctionLink>);
+    Common.IndirectBranchPredictorLink = reinterpret_cast<uintptr_t>(&Context::ContextImpl::ThreadIndirectBranchPredictorLink<Arm64JITCore_IndirectBranchPredictorLink>);
 
     // Fill in the fallback handlers
     InterpreterOps::FillFallbackIndexPointers(Common.FallbackHandlerPointers);
+    Common.FallbackCensusCounters = reinterpret_cast<uint64_t>(FEXCore::Telemetry::GetFallbackCensusCounters());
 
     // Platform Specific
     auto &AArch64 = ThreadState->CurrentFrame->Pointers.AArch64;
@@ -607,9 +716,17 @@ Arm64JITCore::Arm64JITCore(FEXCore::Context::ContextImpl *ctx, FEXCore::Core::In
     RT_LoadMemTSO = &Arm64JITCore::Op_ParanoidLoadMemTSO;
     RT_StoreMemTSO = &Arm64JITCore::Op_ParanoidStoreMemTSO;
   }
+  else if (CTX->HostFeatures.SupportsTSOImm9) {
+    RT_LoadMemTSO = &Arm64JITCore::Op_LoadMemTSOStyled<MemoryTSOStyle::Imm9>;
+    RT_StoreMemTSO = &Arm64JITCore::Op_StoreMemTSOStyled<MemoryTSOStyle::Imm9>;
+  }
+  else if (CTX->HostFeatures.SupportsRCPC) {
+    RT_LoadMemTSO = &Arm64JITCore::Op_LoadMemTSOStyled<MemoryTSOStyle::RCPC>;
+    RT_StoreMemTSO = &Arm64JITCore::Op_StoreMemTSOStyled<MemoryTSOStyle::RCPC>;
+  }
   else {
-    RT_LoadMemTSO = &Arm64JITCore::Op_LoadMemTSO;
-    RT_StoreMemTSO = &Arm64JITCore::Op_StoreMemTSO;
+    RT_LoadMemTSO = &Arm64JITCore::Op_LoadMemTSOStyled<MemoryTSOStyle::Atomic>;
+    RT_StoreMemTSO = &Arm64JITCore::Op_StoreMemTSOStyled<MemoryTSOStyle::Atomic>;
   }
 }
 
@@ -619,12 +736,43 @@ void Arm64JITCore::EmitDetectionString() {
   Align();
 }
 
+void Arm64JITCore::AddToPublishWindow(uint8_t *Begin, size_t Size) {
+  if (PendingPublishBegin != nullptr &&
+      Begin >= PendingPublishBegin && Begin <= PendingPublishEnd) {
+    // Contiguous with the pending range, usually exactly adjacent. A content
+    // dedup rollback can land the new block inside the range; the ranged
+    // flush covers the rewritten bytes either way.
+    PendingPublishEnd = std::max(PendingPublishEnd, Begin + Size);
+    return;
+  }
+
+  FlushCodePublishWindow();
+  PendingPublishBegin = Begin;
+  PendingPublishEnd = Begin + Size;
+}
+
+void Arm64JITCore::FlushCodePublishWindow() {
+  if (PendingPublishBegin == nullptr) {
+    return;
+  }
+
+  ClearICache(PendingPublishBegin, PendingPublishEnd - PendingPublishBegin);
+  PendingPublishBegin = nullptr;
+  PendingPublishEnd = nullptr;
+}
+
 void Arm64JITCore::ClearCache() {
+  // The window may point into a buffer about to be recycled.
+  FlushCodePublishWindow();
+
   // Get the backing code buffer
 
   auto CodeBuffer = GetEmptyCodeBuffer();
   SetBuffer(CodeBuffer->Ptr, CodeBuffer->Size);
   EmitDetectionString();
+
+  // The canonical copies lived in the freed buffers
+  BlockContentMap.clear();
 }
 
 Arm64JITCore::~Arm64JITCore() {
@@ -693,6 +841,7 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
   FEXCORE_PROFILE_SCOPED("Arm64::CompileCode");
 
   JumpTargets.clear();
+  DeferredAESKeys.clear();
   uint32_t SSACount = IR->GetSSACount();
 
   this->Entry = Entry;
@@ -700,12 +849,28 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
   this->DebugData = DebugData;
   this->IR = IR;
 
+  // Blocks that kept faulting on unaligned atomics get the split-barrier TSO
+  // lowering up front instead of eating a SIGBUS per backpatched instruction.
+  SplitTSOBlockBarriers = CTX->BlockUsesSplitTSOBarriers(Entry);
+
   // Fairly excessive buffer range to make sure we don't overflow
   uint32_t BufferRange = SSACount * 16;
   if ((GetCursorOffset() + BufferRange) > CurrentCodeBuffer->Size) {
-    CTX->ClearCodeCache(ThreadState);
+    // Try switching to a fresh buffer first, keeping the filled ones resident.
+    // Existing blocks stay valid that way, avoiding the recompile storm of a
+    // full clear. Only when the code size budget is exhausted does the full
+    // clear happen.
+    if (auto *NewBuffer = TryExpandCodeBuffer(BufferRange)) {
+      // The pending window can't span buffers.
+      FlushCodePublishWindow();
+      SetBuffer(NewBuffer->Ptr, NewBuffer->Size);
+      EmitDetectionString();
+    } else {
+      CTX->ClearCodeCache(ThreadState);
+    }
   }
 
+  const auto BlockStartOffset = GetCursorOffset();
   CodeData.BlockBegin = GetCursorAddress<uint8_t*>();
 
   // Put the code header at the start of the data block.
@@ -752,12 +917,43 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
                                       offsetof(FEXCore::Core::InternalThreadState, BaseFrameState));
   }
 
+  if (CTX->Config.FlightRecorderSampleInterval() > 0) {
+    // Flight recorder sampling. Counts down once per block entry and records
+    // the block's guest RIP plus the raw cycle counter every Nth pass. The
+    // fast path is four instructions with a well-predicted not-taken branch.
+    ARMEmitter::ForwardLabel SkipRecord{};
+    ldr(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, FlightRecorderCountdown));
+    sub(ARMEmitter::Size::i32Bit, TMP1, TMP1, 1);
+    str(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, FlightRecorderCountdown));
+    cbnz(ARMEmitter::Size::i32Bit, TMP1, &SkipRecord);
+
+    // Reset the countdown for the next sample.
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP1, CTX->Config.FlightRecorderSampleInterval());
+    str(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, FlightRecorderCountdown));
+
+    // Claim the next ring slot.
+    ldr(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, FlightRecorderIndex));
+    add(ARMEmitter::Size::i32Bit, TMP2, TMP1, 1);
+    and_(ARMEmitter::Size::i32Bit, TMP2, TMP2, FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_MASK);
+    str(TMP2.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, FlightRecorderIndex));
+
+    // entry = &Ring[Index]
+    ldr(TMP2, STATE, offsetof(FEXCore::Core::CpuStateFrame, FlightRecorderRing));
+    add(ARMEmitter::Size::i64Bit, TMP2, TMP2, TMP1, ARMEmitter::ShiftType::LSL, 4);
+
+    LoadConstant(ARMEmitter::Size::i64Bit, TMP1, Entry);
+    mrs(TMP3, ARMEmitter::SystemRegister::CNTVCT_EL0);
+    stp<ARMEmitter::IndexType::OFFSET>(TMP1, TMP3, TMP2.R(), 0);
+
+    Bind(&SkipRecord);
+  }
+
   //LOGMAN_THROW_A_FMT(RAData->HasFullRA(), "Arm64 JIT only works with RA");
 
   SpillSlots = RAData->SpillSlots();
 
   if (SpillSlots) {
-    const auto TotalSpillSlotsSize = SpillSlots * MaxSpillSlotSize;
+    const auto TotalSpillSlotsSize = SpillSlots * SpillSlotSize;
 
     if (vixl::aarch64::Assembler::IsImmAddSub(TotalSpillSlotsSize)) {
       sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, TotalSpillSlotsSize);
@@ -769,7 +965,31 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
   PendingTargetLabel = nullptr;
 
-  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+  // Partition blocks in to hot and cold before emission. Blocks that raise a
+  // guest fault (Break - ud2, int3, watchpoint hits and friends) only ever run
+  // on their first and final execution, yet get lowered inline with hot code.
+  // Sinking them behind the rest of the block keeps loop bodies dense in the
+  // instruction cache instead of spending fetch bandwidth skipping over them.
+  // The entry block always stays first, branch labels make order irrelevant
+  // for correctness.
+  BlockEmissionOrder.clear();
+  for (auto Block : IR->GetBlocks()) {
+    BlockEmissionOrder.emplace_back(Block);
+  }
+
+  if (BlockEmissionOrder.size() > 2) {
+    // Cold blocks sink to the end, hot blocks keep their relative order
+    std::stable_partition(BlockEmissionOrder.begin() + 1, BlockEmissionOrder.end(), [this](auto const &Block) {
+      for (auto [CodeNode, IROp] : IR->GetCode(std::get<0>(Block))) {
+        if (IROp->Op == FEXCore::IR::OP_BREAK) {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+
+  for (auto [BlockNode, BlockHeader] : BlockEmissionOrder) {
     using namespace FEXCore::IR;
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
     auto BlockIROp = BlockHeader->CW<FEXCore::IR::IROp_CodeBlock>();
@@ -863,7 +1083,58 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
 
   JITBlockTail->Size = CodeData.Size;
 
-  ClearICache(CodeData.BlockBegin, CodeOnlySize);
+  // Content-addressed publishing. Blocks whose emitted instructions and RIP
+  // reconstruction deltas are byte-identical share one host copy; the bytes
+  // only match when every embedded guest-address literal matches too, so the
+  // candidates are blocks with indirect exits: PLT stubs, shared epilogues and
+  // identical template instantiations. Template-heavy binaries waste tens of
+  // MB of code buffer on those duplicates otherwise.
+  // The alias inherits the canonical copy's tail, so a fault inside shared
+  // code reconstructs RIP relative to the canonical entry.
+  // Blocks carrying relocations embed values the object cache fixes up per
+  // entry, and serialization would capture the wrong tail, so both are
+  // excluded.
+  if (DedupBlocks() && Relocations.empty() && !CTX->CodeObjectCacheService) {
+    const auto CodeSize = CodeOnlySize - sizeof(JITCodeHeader);
+    const auto RIPEntriesSize = sizeof(JITRIPReconstructEntries) * JITBlockTail->NumberOfRIPEntries;
+    const auto CodeHash = XXH3_64bits(CodeData.BlockEntry, CodeSize);
+    const auto ContentHash = XXH3_64bits_withSeed(JITRIPEntriesLocation, RIPEntriesSize, CodeHash);
+
+    const auto [Canonical, Inserted] = BlockContentMap.try_emplace(ContentHash, CodeData.BlockBegin);
+    if (!Inserted) {
+      uint8_t *CanonicalBegin = Canonical->second;
+      auto CanonicalHeader = reinterpret_cast<const JITCodeHeader*>(CanonicalBegin);
+      auto CanonicalTail = reinterpret_cast<const JITCodeTail*>(CanonicalBegin + CanonicalHeader->OffsetToBlockTail);
+
+      // A matching hash isn't proof, verify the bytes before aliasing.
+      if (CanonicalTail->Size == CodeData.Size &&
+          CanonicalHeader->OffsetToBlockTail == CodeHeader->OffsetToBlockTail &&
+          CanonicalTail->NumberOfRIPEntries == JITBlockTail->NumberOfRIPEntries &&
+          memcmp(CanonicalBegin + sizeof(JITCodeHeader), CodeData.BlockEntry, CodeSize) == 0 &&
+          memcmp(CanonicalBegin + CanonicalHeader->OffsetToBlockTail + CanonicalTail->OffsetToRIPEntries,
+                 JITRIPEntriesLocation, RIPEntriesSize) == 0) {
+        // Roll the cursor back, reclaiming the duplicate's buffer space.
+        SetCursorOffset(BlockStartOffset);
+
+        if (DebugData) {
+          DebugData->HostCodeSize = CanonicalTail->Size;
+          DebugData->Relocations = &Relocations;
+        }
+
+        this->IR = nullptr;
+
+        return CompiledCode {
+          .BlockBegin = CanonicalBegin,
+          .BlockEntry = CanonicalBegin + sizeof(JITCodeHeader),
+          .Size = CanonicalTail->Size,
+        };
+      }
+    }
+  }
+
+  // Maintenance is batched; the caller flushes the window before this block
+  // becomes reachable.
+  AddToPublishWindow(CodeData.BlockBegin, CodeOnlySize);
 
 #ifdef VIXL_DISASSEMBLER
   if (Disassemble() & FEXCore::Config::Disassemble::STATS) {
@@ -898,12 +1169,47 @@ CPUBackend::CompiledCode Arm64JITCore::CompileCode(uint64_t Entry,
   return CodeData;
 }
 
+void *Arm64JITCore::RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) {
+  FEXCORE_PROFILE_SCOPED("Arm64::RelocateJITObjectCode");
+
+  // The serialized data contains the whole block: JITCodeHeader, code, and the tail data.
+  const auto BlockSize = SerializationData->HostCodeLength;
+
+  if ((GetCursorOffset() + BlockSize) > CurrentCodeBuffer->Size) {
+    if (auto *NewBuffer = TryExpandCodeBuffer(BlockSize)) {
+      FlushCodePublishWindow();
+      SetBuffer(NewBuffer->Ptr, NewBuffer->Size);
+      EmitDetectionString();
+    } else {
+      CTX->ClearCodeCache(ThreadState);
+    }
+  }
+
+  const auto CursorEntry = GetCursorOffset();
+  auto BlockBegin = GetCursorAddress<uint8_t*>();
+  memcpy(BlockBegin, SerializationData->HostCode, BlockSize);
+
+  if (!ApplyRelocations(Entry, reinterpret_cast<uint64_t>(BlockBegin), CursorEntry, SerializationData->NumRelocations, SerializationData->Relocations)) {
+    // Couldn't resolve every relocation, roll the cursor back and fall back to a fresh compile
+    SetCursorOffset(CursorEntry);
+    return nullptr;
+  }
+
+  SetCursorOffset(CursorEntry + BlockSize);
+  Align();
+
+  AddToPublishWindow(BlockBegin, BlockSize);
+
+  // The block entry lives directly behind the code header, matching CompileCode
+  return BlockBegin + sizeof(JITCodeHeader);
+}
+
 void Arm64JITCore::ResetStack() {
   if (SpillSlots == 0) {
     return;
   }
 
-  const auto TotalSpillSlotsSize = SpillSlots * MaxSpillSlotSize;
+  const auto TotalSpillSlotsSize = SpillSlots * SpillSlotSize;
 
   if (vixl::aarch64::Assembler::IsImmAddSub(TotalSpillSlotsSize)) {
     add(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, TotalSpillSlotsSize);
@@ -21,10 +21,12 @@ $end_info$
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/vector.h>
 
 #include <array>
 #include <cstdint>
+#include <tuple>
 #include <utility>
 #include <variant>
 
@@ -46,6 +48,8 @@ public:
                                   FEXCore::Core::DebugData *DebugData,
                                   FEXCore::IR::RegisterAllocationData *RAData) override;
 
+  [[nodiscard]] void *RelocateJITObjectCode(uint64_t Entry, CodeSerialize::CodeObjectFileSection const *SerializationData) override;
+
   [[nodiscard]] void *MapRegion(void* HostPtr, uint64_t, uint64_t) override { return HostPtr; }
 
   [[nodiscard]] bool NeedsOpDispatch() override { return true; }
@@ -54,10 +58,15 @@ public:
 
   void ClearRelocations() override { Relocations.clear(); }
 
+  void FlushCodePublishWindow() override;
+
 private:
   FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
+  FEX_CONFIG_OPT(DedupBlocks, DEDUPBLOCKS);
 
   const bool HostSupportsSVE128{};
+  const bool HostSupportsSVE2{};
+  const bool HostSupportsSVEBitPerm{};
   const bool HostSupportsSVE256{};
   const bool HostSupportsRPRES{};
   const bool HostSupportsAFP{};
@@ -68,8 +77,30 @@ private:
   uint64_t Entry;
   CPUBackend::CompiledCode CodeData{};
 
+  // Whether the current block lowers TSO memory accesses with explicit barriers
+  // instead of atomics, because it kept faulting on unaligned accesses.
+  bool SplitTSOBlockBarriers{};
+
   fextl::map<IR::NodeID, ARMEmitter::BiDirectionalLabel> JumpTargets;
 
+  // Content-addressed block publishing. Keyed by a hash of the emitted
+  // instructions and RIP reconstruction deltas, value is the canonical copy's
+  // BlockBegin. Canonical copies stay valid until the full cache clear that
+  // reclaims the code buffers, which also clears this map.
+  fextl::unordered_map<uint64_t, uint8_t*> BlockContentMap;
+
+  // Batched code publication. Freshly emitted blocks are contiguous in the
+  // code buffer, so their instruction-cache maintenance is accumulated into
+  // one range and performed by a single ranged flush instead of one broadcast
+  // per block. The window must be flushed before any block in it becomes
+  // reachable, and before the emitter moves to a different buffer.
+  void AddToPublishWindow(uint8_t *Begin, size_t Size);
+  uint8_t *PendingPublishBegin{};
+  uint8_t *PendingPublishEnd{};
+
+  // Hot/cold block emission ordering, rebuilt per compile
+  fextl::vector<std::tuple<IR::OrderedNode*, IR::IROp_Header*>> BlockEmissionOrder;
+
   [[nodiscard]] FEXCore::ARMEmitter::Register GetReg(IR::NodeID Node) const {
     const auto Reg = GetPhys(Node);
 
@@ -149,6 +180,18 @@ private:
   [[nodiscard]] bool IsInlineConstant(const IR::OrderedNodeWrapper& Node, uint64_t* Value = nullptr) const;
   [[nodiscard]] bool IsInlineEntrypointOffset(const IR::OrderedNodeWrapper& WNode, uint64_t* Value) const;
 
+  // Emits the retry tail of an LL/SC atomic loop: success falls through, a
+  // failed store-exclusive counts into the strex-failure statistic and yields
+  // before branching back to LoopTop. Status holds the store-exclusive result
+  // and Scratch must be dead across a loop iteration; both are clobbered on
+  // the retry path.
+  void EmitStrexRetry(ARMEmitter::Size EmitSize, ARMEmitter::XRegister Status, ARMEmitter::XRegister Scratch, ARMEmitter::BackwardLabel *LoopTop);
+
+  // Exclusive pair of an LL/SC atomic loop: acquire-release normally, plain
+  // exclusives once the context runs with relaxed guest atomics.
+  void EmitExclusiveLoad(ARMEmitter::SubRegSize Size, ARMEmitter::Register Dst, ARMEmitter::Register Addr);
+  void EmitExclusiveStore(ARMEmitter::SubRegSize Size, ARMEmitter::Register Status, ARMEmitter::Register Src, ARMEmitter::Register Addr);
+
   struct LiveRange {
     uint32_t Begin;
     uint32_t End;
@@ -218,6 +261,11 @@ private:
   /**  @} */
 
   uint32_t SpillSlots{};
+  // Stride between spill slots on the host stack. Only needs to fit a 256-bit
+  // value when SVE256 is emulating AVX, otherwise packing slots at 16 bytes
+  // halves the spill frame and keeps short-lived spill round trips inside
+  // fewer cache lines.
+  uint32_t SpillSlotSize {MaxSpillSlotSize};
   using OpType = void (Arm64JITCore::*)(IR::IROp_Header const *IROp, IR::NodeID Node);
 
   using ScalarBinaryOpCaller = std::function<void(ARMEmitter::VRegister Dst, ARMEmitter::VRegister Src1, ARMEmitter::VRegister Src2)>;
@@ -225,6 +273,18 @@ private:
   using ScalarUnaryOpCaller = std::function<void(ARMEmitter::VRegister Dst, std::variant<ARMEmitter::VRegister, ARMEmitter::Register> SrcVar)>;
   void VFScalarUnaryOperation(uint8_t OpSize, uint8_t ElementSize, bool ZeroUpperBits, ScalarUnaryOpCaller ScalarEmit, ARMEmitter::VRegister Dst, ARMEmitter::VRegister Vector1, std::variant<ARMEmitter::VRegister, ARMEmitter::Register> Vector2);
 
+  // Native SVE2 lowering for the common PCMPISTRI/PCMPISTRM control modes.
+  // Returns false when the control word needs the interpreter fallback.
+  [[nodiscard]] bool Emit_VPCMPISTRX_SVE(IR::NodeID Node, const IR::IROp_VPCMPISTRX *Op);
+
+  // Back-to-back AES round fusion.
+  // An AES op whose only consumer is the State input of a later AES op skips
+  // its trailing round key EOR and records the key register here instead; the
+  // consumer folds it in to its AESE/AESD key operand.
+  fextl::map<IR::NodeID, ARMEmitter::VRegister> DeferredAESKeys;
+  [[nodiscard]] bool TryDeferAESKeyEOR(IR::NodeID Node, ARMEmitter::VRegister Dst, IR::OrderedNodeWrapper Key);
+  [[nodiscard]] ARMEmitter::VRegister TakeDeferredAESKey(IR::OrderedNodeWrapper State, ARMEmitter::VRegister ZeroReg);
+
   // Runtime selection;
   // Load and store register style.
   OpType RT_LoadRegister;
@@ -233,6 +293,16 @@ private:
   OpType RT_LoadMemTSO;
   OpType RT_StoreMemTSO;
 
+  // Host feature bundle for the TSO memory emitters. The variant matching the
+  // host is stamped out at compile time and installed into the RT_ pointers
+  // once at backend construction, so the emitter bodies are branch-free on
+  // host features during block compilation.
+  enum class MemoryTSOStyle { Imm9, RCPC, Atomic };
+  template<MemoryTSOStyle Style>
+  void Op_LoadMemTSOStyled(IR::IROp_Header const *IROp, IR::NodeID Node);
+  template<MemoryTSOStyle Style>
+  void Op_StoreMemTSOStyled(IR::IROp_Header const *IROp, IR::NodeID Node);
+
 #define DEF_OP(x) void Op_##x(IR::IROp_Header const *IROp, IR::NodeID Node)
 
   // Dynamic Dispatcher supporting operations
@@ -843,7 +843,7 @@ DEF_OP(StoreContextIndexed) {
 DEF_OP(SpillRegister) {
   const auto Op = IROp->C<IR::IROp_SpillRegister>();
   const uint8_t OpSize = IROp->Size;
-  const uint32_t SlotOffset = Op->Slot * MaxSpillSlotSize;
+  const uint32_t SlotOffset = Op->Slot * SpillSlotSize;
 
   if (Op->Class == FEXCore::IR::GPRClass) {
     const auto Src = GetReg(Op->Value.ID());
@@ -943,7 +943,7 @@ DEF_OP(SpillRegister) {
 DEF_OP(FillRegister) {
   const auto Op = IROp->C<IR::IROp_FillRegister>();
   const uint8_t OpSize = IROp->Size;
-  const uint32_t SlotOffset = Op->Slot * MaxSpillSlotSize;
+  const uint32_t SlotOffset = Op->Slot * SpillSlotSize;
 
   if (Op->Class == FEXCore::IR::GPRClass) {
     const auto Dst = GetReg(Node);
@@ -1215,91 +1215,128 @@ DEF_OP(LoadMem) {
   }
 }
 
-DEF_OP(LoadMemTSO) {
+template<Arm64JITCore::MemoryTSOStyle Style>
+void Arm64JITCore::Op_LoadMemTSOStyled(IR::IROp_Header const *IROp, IR::NodeID Node) {
   const auto Op = IROp->C<IR::IROp_LoadMemTSO>();
   const auto OpSize = IROp->Size;
 
+  // ConstProp proved natural alignment for this access, the atomic form
+  // can't alignment-fault so the backpatch pad is unnecessary.
+  const bool ProvenAligned = Op->Align >= OpSize;
+
   const auto MemReg = GetReg(Op->Addr.ID());
 
-  if (CTX->HostFeatures.SupportsTSOImm9 && Op->Class == FEXCore::IR::GPRClass) {
+  if (SplitTSOBlockBarriers && Op->Class == FEXCore::IR::GPRClass) {
+    // This block kept faulting on unaligned atomics. Emit the same sequence the
+    // SIGBUS handler would backpatch to, without taking the faults first.
     const auto Dst = GetReg(Node);
-    uint64_t Offset = 0;
-    if (!Op->Offset.IsInvalid()) {
-      (void)IsInlineConstant(Op->Offset, &Offset);
-    }
-
-    if (OpSize == 1) {
-      // 8bit load is always aligned to natural alignment
-      const auto Dst = GetReg(Node);
-      ldapurb(Dst, MemReg, Offset);
-    }
-    else {
-      switch (OpSize) {
-        case 2:
-          ldapurh(Dst, MemReg, Offset);
-          break;
-        case 4:
-          ldapur(Dst.W(), MemReg, Offset);
-          break;
-        case 8:
-          ldapur(Dst.X(), MemReg, Offset);
-          break;
-        default:
-          LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
-          break;
-      }
-      // Half-barrier once back-patched.
-      nop();
+    const auto MemSrc = GenerateMemOperand(OpSize, MemReg, Op->Offset, Op->OffsetType, Op->OffsetScale);
+    switch (OpSize) {
+      case 1:
+        ldrb(Dst, MemSrc);
+        break;
+      case 2:
+        ldrh(Dst, MemSrc);
+        break;
+      case 4:
+        ldr(Dst.W(), MemSrc);
+        break;
+      case 8:
+        ldr(Dst.X(), MemSrc);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
+        break;
     }
+    // Half-barrier.
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISHLD);
+    return;
   }
-  else if (CTX->HostFeatures.SupportsRCPC && Op->Class == FEXCore::IR::GPRClass) {
+
+  if (Op->Class == FEXCore::IR::GPRClass) {
     const auto Dst = GetReg(Node);
-    if (OpSize == 1) {
-      // 8bit load is always aligned to natural alignment
-      ldaprb(Dst.W(), MemReg);
-    }
-    else {
-      switch (OpSize) {
-        case 2:
-          ldaprh(Dst.W(), MemReg);
-          break;
-        case 4:
-          ldapr(Dst.W(), MemReg);
-          break;
-        case 8:
-          ldapr(Dst.X(), MemReg);
-          break;
-        default:
-          LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
-          break;
+    if constexpr (Style == MemoryTSOStyle::Imm9) {
+      uint64_t Offset = 0;
+      if (!Op->Offset.IsInvalid()) {
+        (void)IsInlineConstant(Op->Offset, &Offset);
+      }
+
+      if (OpSize == 1) {
+        // 8bit load is always aligned to natural alignment
+        ldapurb(Dst, MemReg, Offset);
+      }
+      else {
+        switch (OpSize) {
+          case 2:
+            ldapurh(Dst, MemReg, Offset);
+            break;
+          case 4:
+            ldapur(Dst.W(), MemReg, Offset);
+            break;
+          case 8:
+            ldapur(Dst.X(), MemReg, Offset);
+            break;
+          default:
+            LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
+            break;
+        }
+        if (!ProvenAligned) {
+          // Half-barrier once back-patched.
+          nop();
+        }
       }
-      // Half-barrier once back-patched.
-      nop();
     }
-  }
-  else if (Op->Class == FEXCore::IR::GPRClass) {
-    const auto Dst = GetReg(Node);
-    if (OpSize == 1) {
-      // 8bit load is always aligned to natural alignment
-      ldarb(Dst, MemReg);
+    else if constexpr (Style == MemoryTSOStyle::RCPC) {
+      if (OpSize == 1) {
+        // 8bit load is always aligned to natural alignment
+        ldaprb(Dst.W(), MemReg);
+      }
+      else {
+        switch (OpSize) {
+          case 2:
+            ldaprh(Dst.W(), MemReg);
+            break;
+          case 4:
+            ldapr(Dst.W(), MemReg);
+            break;
+          case 8:
+            ldapr(Dst.X(), MemReg);
+            break;
+          default:
+            LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
+            break;
+        }
+        if (!ProvenAligned) {
+          // Half-barrier once back-patched.
+          nop();
+        }
+      }
     }
     else {
-      switch (OpSize) {
-        case 2:
-          ldarh(Dst, MemReg);
-          break;
-        case 4:
-          ldar(Dst.W(), MemReg);
-          break;
-        case 8:
-          ldar(Dst.X(), MemReg);
-          break;
-        default:
-          LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
-          break;
+      if (OpSize == 1) {
+        // 8bit load is always aligned to natural alignment
+        ldarb(Dst, MemReg);
+      }
+      else {
+        switch (OpSize) {
+          case 2:
+            ldarh(Dst, MemReg);
+            break;
+          case 4:
+            ldar(Dst.W(), MemReg);
+            break;
+          case 8:
+            ldar(Dst.X(), MemReg);
+            break;
+          default:
+            LOGMAN_MSG_A_FMT("Unhandled LoadMemTSO size: {}", OpSize);
+            break;
+        }
+        if (!ProvenAligned) {
+          // Half-barrier once back-patched.
+          nop();
+        }
       }
-      // Half-barrier once back-patched.
-      nop();
     }
   }
   else {
@@ -1335,6 +1372,10 @@ DEF_OP(LoadMemTSO) {
   }
 }
 
+template void Arm64JITCore::Op_LoadMemTSOStyled<Arm64JITCore::MemoryTSOStyle::Imm9>(IR::IROp_Header const *IROp, IR::NodeID Node);
+template void Arm64JITCore::Op_LoadMemTSOStyled<Arm64JITCore::MemoryTSOStyle::RCPC>(IR::IROp_Header const *IROp, IR::NodeID Node);
+template void Arm64JITCore::Op_LoadMemTSOStyled<Arm64JITCore::MemoryTSOStyle::Atomic>(IR::IROp_Header const *IROp, IR::NodeID Node);
+
 DEF_OP(VLoadVectorMasked) {
   LOGMAN_THROW_A_FMT(HostSupportsSVE256, "Need SVE support in order to use VLoadVectorMasked");
 
@@ -1754,65 +1795,173 @@ DEF_OP(StoreMem) {
   }
 }
 
-DEF_OP(StoreMemTSO) {
+DEF_OP(StoreMemPair) {
+  const auto Op = IROp->C<IR::IROp_StoreMemPair>();
+  const auto OpSize = IROp->Size;
+
+  const auto Addr = GetReg(Op->Addr.ID());
+  const auto Offset = static_cast<int32_t>(Op->Offset);
+
+  if (Op->Class == FEXCore::IR::GPRClass) {
+    const auto Src1 = GetReg(Op->Value1.ID());
+    const auto Src2 = GetReg(Op->Value2.ID());
+    switch (OpSize) {
+      case 4:
+        stp<ARMEmitter::IndexType::OFFSET>(Src1.W(), Src2.W(), Addr, Offset);
+        break;
+      case 8:
+        stp<ARMEmitter::IndexType::OFFSET>(Src1.X(), Src2.X(), Addr, Offset);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled StoreMemPair size: {}", OpSize);
+        break;
+    }
+  }
+  else {
+    const auto Src1 = GetVReg(Op->Value1.ID());
+    const auto Src2 = GetVReg(Op->Value2.ID());
+    switch (OpSize) {
+      case 4:
+        stp<ARMEmitter::IndexType::OFFSET>(Src1.S(), Src2.S(), Addr, Offset);
+        break;
+      case 8:
+        stp<ARMEmitter::IndexType::OFFSET>(Src1.D(), Src2.D(), Addr, Offset);
+        break;
+      case 16:
+        stp<ARMEmitter::IndexType::OFFSET>(Src1.Q(), Src2.Q(), Addr, Offset);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled StoreMemPair size: {}", OpSize);
+        break;
+    }
+  }
+}
+
+DEF_OP(AddMemRMW) {
+  const auto Op = IROp->C<IR::IROp_AddMemRMW>();
+  const auto OpSize = IROp->Size;
+
+  const auto Dst = GetReg(Node);
+  const auto MemReg = GetReg(Op->Addr.ID());
+  const auto Src = GetReg(Op->Src.ID());
+
+  // Plain (non-TSO) fused read-modify-write. The sum builds in a temporary
+  // since the destination may share a register with the address or source.
+  switch (OpSize) {
+    case 4:
+      ldr(TMP1.W(), MemReg);
+      add(TMP1.W(), TMP1.W(), Src.W());
+      str(TMP1.W(), MemReg);
+      mov(Dst.W(), TMP1.W());
+      break;
+    case 8:
+      ldr(TMP1, MemReg);
+      add(TMP1, TMP1, Src.X());
+      str(TMP1, MemReg);
+      mov(Dst.X(), TMP1);
+      break;
+    default:
+      LOGMAN_MSG_A_FMT("Unhandled AddMemRMW size: {}", OpSize);
+      break;
+  }
+}
+
+template<Arm64JITCore::MemoryTSOStyle Style>
+void Arm64JITCore::Op_StoreMemTSOStyled(IR::IROp_Header const *IROp, IR::NodeID Node) {
   const auto Op = IROp->C<IR::IROp_StoreMemTSO>();
   const auto OpSize = IROp->Size;
 
+  // ConstProp proved natural alignment for this access, the atomic form
+  // can't alignment-fault so the backpatch pad is unnecessary.
+  const bool ProvenAligned = Op->Align >= OpSize;
+
   const auto MemReg = GetReg(Op->Addr.ID());
 
-  if (CTX->HostFeatures.SupportsTSOImm9 && Op->Class == FEXCore::IR::GPRClass) {
+  if (SplitTSOBlockBarriers && Op->Class == FEXCore::IR::GPRClass) {
+    // Same idea as the load case: explicit barrier plus plain store rather than STLR.
     const auto Src = GetReg(Op->Value.ID());
-    uint64_t Offset = 0;
-    if (!Op->Offset.IsInvalid()) {
-      (void)IsInlineConstant(Op->Offset, &Offset);
-    }
-
-    if (OpSize == 1) {
-      // 8bit load is always aligned to natural alignment
-      stlurb(Src, MemReg, Offset);
-    }
-    else {
-      // Half-barrier once back-patched.
-      nop();
-      switch (OpSize) {
-        case 2:
-          stlurh(Src, MemReg, Offset);
-          break;
-        case 4:
-          stlur(Src.W(), MemReg, Offset);
-          break;
-        case 8:
-          stlur(Src.X(), MemReg, Offset);
-          break;
-        default:
-          LOGMAN_MSG_A_FMT("Unhandled StoreMemTSO size: {}", OpSize);
-          break;
-      }
+    const auto MemSrc = GenerateMemOperand(OpSize, MemReg, Op->Offset, Op->OffsetType, Op->OffsetScale);
+    // Half-barrier.
+    dmb(FEXCore::ARMEmitter::BarrierScope::ISH);
+    switch (OpSize) {
+      case 1:
+        strb(Src, MemSrc);
+        break;
+      case 2:
+        strh(Src, MemSrc);
+        break;
+      case 4:
+        str(Src.W(), MemSrc);
+        break;
+      case 8:
+        str(Src.X(), MemSrc);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unhandled StoreMemTSO size: {}", OpSize);
+        break;
     }
+    return;
   }
-  else if (Op->Class == FEXCore::IR::GPRClass) {
+
+  if (Op->Class == FEXCore::IR::GPRClass) {
     const auto Src = GetReg(Op->Value.ID());
+    // RCPC has no release-store form beyond the baseline STLR, so only the
+    // Imm9 style diverges here.
+    if constexpr (Style == MemoryTSOStyle::Imm9) {
+      uint64_t Offset = 0;
+      if (!Op->Offset.IsInvalid()) {
+        (void)IsInlineConstant(Op->Offset, &Offset);
+      }
 
-    if (OpSize == 1) {
-      // 8bit load is always aligned to natural alignment
-      stlrb(Src, MemReg);
+      if (OpSize == 1) {
+        // 8bit load is always aligned to natural alignment
+        stlurb(Src, MemReg, Offset);
+      }
+      else {
+        if (!ProvenAligned) {
+          // Half-barrier once back-patched.
+          nop();
+        }
+        switch (OpSize) {
+          case 2:
+            stlurh(Src, MemReg, Offset);
+            break;
+          case 4:
+            stlur(Src.W(), MemReg, Offset);
+            break;
+          case 8:
+            stlur(Src.X(), MemReg, Offset);
+            break;
+          default:
+            LOGMAN_MSG_A_FMT("Unhandled StoreMemTSO size: {}", OpSize);
+            break;
+        }
+      }
     }
     else {
-      // Half-barrier once back-patched.
-      nop();
-      switch (OpSize) {
-        case 2:
-          stlrh(Src, MemReg);
-          break;
-        case 4:
-          stlr(Src.W(), MemReg);
-          break;
-        case 8:
-          stlr(Src.X(), MemReg);
-          break;
-        default:
-          LOGMAN_MSG_A_FMT("Unhandled StoreMemTSO size: {}", OpSize);
-          break;
+      if (OpSize == 1) {
+        // 8bit load is always aligned to natural alignment
+        stlrb(Src, MemReg);
+      }
+      else {
+        if (!ProvenAligned) {
+          // Half-barrier once back-patched.
+          nop();
+        }
+        switch (OpSize) {
+          case 2:
+            stlrh(Src, MemReg);
+            break;
+          case 4:
+            stlr(Src.W(), MemReg);
+            break;
+          case 8:
+            stlr(Src.X(), MemReg);
+            break;
+          default:
+            LOGMAN_MSG_A_FMT("Unhandled StoreMemTSO size: {}", OpSize);
+            break;
+        }
       }
     }
   }
@@ -1849,6 +1998,10 @@ DEF_OP(StoreMemTSO) {
   }
 }
 
+template void Arm64JITCore::Op_StoreMemTSOStyled<Arm64JITCore::MemoryTSOStyle::Imm9>(IR::IROp_Header const *IROp, IR::NodeID Node);
+template void Arm64JITCore::Op_StoreMemTSOStyled<Arm64JITCore::MemoryTSOStyle::RCPC>(IR::IROp_Header const *IROp, IR::NodeID Node);
+template void Arm64JITCore::Op_StoreMemTSOStyled<Arm64JITCore::MemoryTSOStyle::Atomic>(IR::IROp_Header const *IROp, IR::NodeID Node);
+
 DEF_OP(MemSet) {
   // TODO: A future looking task would be to support this with ARM's MOPS instructions.
   // The 8-bit non-atomic forward path directly matches ARM's SETP/SETM/SETE instruction,
@@ -1948,6 +2101,12 @@ DEF_OP(MemSet) {
     }
   };
 
+  auto SubRegSize =
+    Size == 1 ? ARMEmitter::SubRegSize::i8Bit :
+    Size == 2 ? ARMEmitter::SubRegSize::i16Bit :
+    Size == 4 ? ARMEmitter::SubRegSize::i32Bit :
+    Size == 8 ? ARMEmitter::SubRegSize::i64Bit : ARMEmitter::SubRegSize::i8Bit;
+
   auto EmitMemset = [&](int32_t Direction) {
     const int32_t OpSize = Size;
     const int32_t SizeDirection = Size * Direction;
@@ -1958,15 +2117,52 @@ DEF_OP(MemSet) {
     // Early exit if zero count.
     cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
-    Bind(&AgainInternal);
-    if (Op->IsAtomic) {
-      MemStoreTSO(Value, OpSize, SizeDirection);
+    if (Direction == 1 && !Op->IsAtomic) {
+      // Forward non-atomic path can use wide stores instead of storing an
+      // element at a time. Only the set of bytes stored is architecturally
+      // visible, so chunking is fine regardless of element size or alignment.
+      ARMEmitter::BackwardLabel BulkLoop{};
+      ARMEmitter::ForwardLabel BulkCheck{};
+      ARMEmitter::BackwardLabel TailLoop{};
+
+      // TMP4 = set size in bytes
+      if (OpSize == 1) {
+        mov(TMP4, TMP1);
+      }
+      else {
+        lsl(ARMEmitter::Size::i64Bit, TMP4, TMP1, FEXCore::ilog2(OpSize));
+      }
+
+      // Broadcast the value across a vector pair for 32 bytes per iteration
+      dup(SubRegSize, VTMP1.Q(), Value);
+      mov(VTMP2.Q(), VTMP1.Q());
+
+      b(&BulkCheck);
+      Bind(&BulkLoop);
+      stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP2, 32);
+      sub(ARMEmitter::Size::i64Bit, TMP4, TMP4, 32);
+      Bind(&BulkCheck);
+      lsr(ARMEmitter::Size::i64Bit, TMP3, TMP4, 5);
+      cbnz(ARMEmitter::Size::i64Bit, TMP3, &BulkLoop);
+
+      // Remaining 0-31 bytes, still a multiple of the element size
+      cbz(ARMEmitter::Size::i64Bit, TMP4, &DoneInternal);
+      Bind(&TailLoop);
+      MemStore(Value, OpSize, SizeDirection);
+      sub(ARMEmitter::Size::i64Bit, TMP4, TMP4, OpSize);
+      cbnz(ARMEmitter::Size::i64Bit, TMP4, &TailLoop);
     }
     else {
-      MemStore(Value, OpSize, SizeDirection);
+      Bind(&AgainInternal);
+      if (Op->IsAtomic) {
+        MemStoreTSO(Value, OpSize, SizeDirection);
+      }
+      else {
+        MemStore(Value, OpSize, SizeDirection);
+      }
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
+      cbnz(ARMEmitter::Size::i64Bit, TMP1, &AgainInternal);
     }
-    sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, 1);
-    cbnz(ARMEmitter::Size::i64Bit, TMP1, &AgainInternal);
 
     Bind(&DoneInternal);
 
@@ -2219,6 +2415,64 @@ DEF_OP(MemCpy) {
     // Early exit if zero count.
     cbz(ARMEmitter::Size::i64Bit, TMP1, &DoneInternal);
 
+    if (Direction == 1 && !Op->IsAtomic) {
+      // The forward non-atomic path can copy in 32-byte chunks instead of an
+      // element at a time, as long as the ranges don't overlap in a way that
+      // the element-by-element copy would be observable. Guest code uses the
+      // overlapping forward copy as a pattern fill, so that case stays on the
+      // element loop.
+      ARMEmitter::ForwardLabel ElementLoop{};
+      ARMEmitter::ForwardLabel BulkPath{};
+      ARMEmitter::BackwardLabel BulkLoop{};
+      ARMEmitter::ForwardLabel BulkCheck{};
+      ARMEmitter::BackwardLabel TailLoop{};
+
+      // TMP4 = copy size in bytes
+      if (OpSize == 1) {
+        mov(TMP4, TMP1);
+      }
+      else {
+        lsl(ARMEmitter::Size::i64Bit, TMP4, TMP1, FEXCore::ilog2(OpSize));
+      }
+
+      // A forward chunked copy is safe when Dest < Src, or when the ranges
+      // don't intersect at all: (Dest - Src) unsigned >= byte count.
+      // Checked with sign tests rather than a compare to preserve NZCV.
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP2, TMP3);
+      tbnz(TMP1, 63, &BulkPath);
+      sub(ARMEmitter::Size::i64Bit, TMP1, TMP1, TMP4);
+      tbnz(TMP1, 63, &ElementLoop);
+
+      Bind(&BulkPath);
+      b(&BulkCheck);
+      Bind(&BulkLoop);
+      ldp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP3, 32);
+      stp<ARMEmitter::IndexType::POST>(VTMP1.Q(), VTMP2.Q(), TMP2, 32);
+      sub(ARMEmitter::Size::i64Bit, TMP4, TMP4, 32);
+      Bind(&BulkCheck);
+      lsr(ARMEmitter::Size::i64Bit, TMP1, TMP4, 5);
+      cbnz(ARMEmitter::Size::i64Bit, TMP1, &BulkLoop);
+
+      // Remaining 0-31 bytes, non-overlapping so bytewise is fine
+      cbz(ARMEmitter::Size::i64Bit, TMP4, &DoneInternal);
+      Bind(&TailLoop);
+      ldrb<ARMEmitter::IndexType::POST>(TMP1.W(), TMP3, 1);
+      strb<ARMEmitter::IndexType::POST>(TMP1.W(), TMP2, 1);
+      sub(ARMEmitter::Size::i64Bit, TMP4, TMP4, 1);
+      cbnz(ARMEmitter::Size::i64Bit, TMP4, &TailLoop);
+      b(&DoneInternal);
+
+      // Overlapping, element at a time. The element count needs restoring
+      // since TMP1 was used for the overlap check.
+      Bind(&ElementLoop);
+      if (OpSize == 1) {
+        mov(TMP1, TMP4);
+      }
+      else {
+        lsr(ARMEmitter::Size::i64Bit, TMP1, TMP4, FEXCore::ilog2(OpSize));
+      }
+    }
+
     Bind(&AgainInternal);
     if (Op->IsAtomic) {
       MemCpyTSO(OpSize, SizeDirection);
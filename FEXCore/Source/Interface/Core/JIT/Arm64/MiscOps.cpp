@@ -161,6 +161,22 @@ DEF_OP(Print) {
 
 #ifndef _WIN32
 DEF_OP(ProcessorID) {
+  // Fast path: while the thread's rseq area is registered the kernel keeps
+  // CPUId current across migrations, so rdtscp's TSC_AUX read is two loads.
+  // A negative CPUId means registration failed and we take the getcpu
+  // syscall below, which is also what refreshes the node cache.
+  ARMEmitter::ForwardLabel SlowPath{};
+  ARMEmitter::ForwardLabel Done{};
+
+  ldr(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, RSeq.CPUId));
+  tbnz(TMP1, 31, &SlowPath);
+  ldr(TMP2.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, RSeqNodeId));
+  // uint32_t Res = (node << 12) | cpu;
+  orr(ARMEmitter::Size::i64Bit, GetReg(Node), TMP1.R(), TMP2.R(), ARMEmitter::ShiftType::LSL, 12);
+  b(&Done);
+
+  Bind(&SlowPath);
+
   // We always need to spill x8 since we can't know if it is live at this SSA location
   uint32_t SpillMask = 1U << 8;
 
@@ -202,6 +218,9 @@ DEF_OP(ProcessorID) {
   // Deallocate stack space
   sub(ARMEmitter::Size::i64Bit, ARMEmitter::Reg::rsp, ARMEmitter::Reg::rsp, 16);
 
+  // Keep the fast path's node cache current while we have the fresh value
+  str(ARMEmitter::WReg::w1, STATE, offsetof(FEXCore::Core::CpuStateFrame, RSeqNodeId));
+
   // Now that we are done in the syscall we need to carefully peel back the state
   // First unspill the registers from before
   FillStaticRegs(false, SpillMask);
@@ -215,6 +234,8 @@ DEF_OP(ProcessorID) {
   // CPU is in w0
   // Node is in w1
   orr(ARMEmitter::Size::i64Bit, GetReg(Node), ARMEmitter::Reg::r0, ARMEmitter::Reg::r1, ARMEmitter::ShiftType::LSL, 12);
+
+  Bind(&Done);
 }
 #else
 DEF_OP(ProcessorID) {
@@ -241,7 +262,30 @@ DEF_OP(RDRAND) {
 }
 
 DEF_OP(Yield) {
+  // A yield hint is close to a no-op on most cores, so lowering PAUSE to just
+  // `yield` leaves a guest spin-wait loop burning its entire host core. Count
+  // executed pauses in the frame and periodically escalate to a WFE: with the
+  // kernel's event stream enabled the wait wakes within ~100us, which bounds
+  // the added wakeup latency while giving the core real idle time. The counter
+  // never resets - a sparse pause hits the WFE path at most once per period,
+  // which is noise, while a tight spin loop hits it on every wrap.
+  constexpr uint32_t SpinEscalationPeriodMask = 64 - 1;
+
+  ldr(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, PauseSpinCount));
+  add(ARMEmitter::Size::i32Bit, TMP1.R(), TMP1.R(), 1);
+  str(TMP1.W(), STATE, offsetof(FEXCore::Core::CpuStateFrame, PauseSpinCount));
+
+  ARMEmitter::ForwardLabel Escalate{};
+  ARMEmitter::ForwardLabel Done{};
+  and_(ARMEmitter::Size::i32Bit, TMP2.R(), TMP1.R(), SpinEscalationPeriodMask);
+  cbz(ARMEmitter::Size::i32Bit, TMP2.R(), &Escalate);
   yield();
+  b(&Done);
+
+  Bind(&Escalate);
+  wfe();
+
+  Bind(&Done);
 }
 
 #undef DEF_OP
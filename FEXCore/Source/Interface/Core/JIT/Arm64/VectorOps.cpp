@@ -5190,6 +5190,95 @@ DEF_OP(VFCADD) {
   }
 }
 
+bool Arm64JITCore::Emit_VPCMPISTRX_SVE(IR::NodeID Node, const IR::IROp_VPCMPISTRX *Op) {
+  const uint16_t Control = Op->Control;
+  const auto Aggregation = (Control >> 2) & 0b11;
+  const bool ByteElements = (Control & 1) == 0;
+
+  // SVE2 gives us a direct lowering of the equality based aggregation modes on
+  // byte strings: "equal any" maps onto MATCH and "equal each" onto a
+  // predicated compare. The ordered modes (ranges, equal ordered) have no
+  // predicate primitive and stay on the interpreter fallback, as do word
+  // strings, which are rare in practice.
+  if (!HostSupportsSVE2 || !ByteElements || (Aggregation != 0b00 && Aggregation != 0b10)) {
+    return false;
+  }
+
+  const auto Dst = GetReg(Node);
+  const auto Src1 = GetVReg(Op->LHS.ID());
+  const auto Src2 = GetVReg(Op->RHS.ID());
+
+  // Governing predicate limiting everything to the low 16 bytes.
+  const auto P16 = PRED_TMP_16B;
+  // Scratch predicates; nothing else allocates these.
+  const auto PNull1 = ARMEmitter::PReg::p0;
+  const auto PNull2 = ARMEmitter::PReg::p1;
+  const auto PValid1 = ARMEmitter::PReg::p2;
+  const auto PValid2 = ARMEmitter::PReg::p3;
+  const auto PResult = ARMEmitter::PReg::p4;
+  const auto PTmp = ARMEmitter::PReg::p5;
+
+  // Implicit length: every element strictly before the first null is valid.
+  cmpeq(ARMEmitter::SubRegSize::i8Bit, PNull1, P16.Zeroing(), Src1.Z(), 0);
+  brkb(PValid1, P16.Zeroing(), PNull1);
+  cmpeq(ARMEmitter::SubRegSize::i8Bit, PNull2, P16.Zeroing(), Src2.Z(), 0);
+  brkb(PValid2, P16.Zeroing(), PNull2);
+
+  if (Aggregation == 0b00) {
+    // Equal any: IntRes1[i] set when any valid Src1 element equals Src2[i].
+    // MATCH checks against every element of its 128-bit segment, so clear the
+    // invalid Src1 tail first. Valid string bytes are never zero, meaning they
+    // can't falsely match the cleared lanes.
+    movi(ARMEmitter::SubRegSize::i64Bit, VTMP1.Q(), 0);
+    mov(ARMEmitter::SubRegSize::i8Bit, VTMP1.Z(), PValid1.Merging(), Src1.Z());
+    match(ARMEmitter::SubRegSize::i8Bit, PResult, PValid2.Zeroing(), Src2.Z(), VTMP1.Z());
+  } else {
+    // Equal each: pairwise equality where both elements are valid, and a
+    // forced match where both strings have already ended.
+    cmpeq(ARMEmitter::SubRegSize::i8Bit, PTmp, P16.Zeroing(), Src1.Z(), Src2.Z());
+    and_(PResult, PValid1.Zeroing(), PTmp, PValid2);
+    nor(PTmp, P16.Zeroing(), PValid1, PValid2);
+    orr(PResult, P16.Zeroing(), PResult, PTmp);
+  }
+
+  // Polarity control[5:4]: flip everything, or only the valid Src2 elements.
+  if ((Control & 0b01'0000) != 0) {
+    if ((Control & 0b10'0000) != 0) {
+      eor(PResult, P16.Zeroing(), PResult, PValid2);
+    } else {
+      eor(PResult, P16.Zeroing(), PResult, P16);
+    }
+  }
+
+  // IntRes2 as a GPR bitmask: widen the active lanes to all-ones bytes, then
+  // the usual shift-accumulate movemask.
+  cpy(ARMEmitter::SubRegSize::i8Bit, VTMP1.Z(), PResult.Zeroing(), -1);
+  ushr(ARMEmitter::SubRegSize::i8Bit, VTMP1.Q(), VTMP1.Q(), 7);
+  usra(ARMEmitter::SubRegSize::i16Bit, VTMP1.Q(), VTMP1.Q(), 7);
+  usra(ARMEmitter::SubRegSize::i32Bit, VTMP1.Q(), VTMP1.Q(), 14);
+  usra(ARMEmitter::SubRegSize::i64Bit, VTMP1.Q(), VTMP1.Q(), 28);
+  umov<ARMEmitter::SubRegSize::i8Bit>(Dst, VTMP1, 0);
+  umov<ARMEmitter::SubRegSize::i8Bit>(TMP1, VTMP1, 8);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP1, ARMEmitter::ShiftType::LSL, 8);
+
+  // Flag bits ride in the upper 16 bits of the result:
+  // ZF[16]: any Src2 element invalid, SF[17]: any Src1 element invalid,
+  // CF[18]: IntRes2 non-zero, OF[19]: IntRes2 bit 0.
+  ptest(P16, PNull2);
+  cset(ARMEmitter::Size::i32Bit, TMP1, ARMEmitter::Condition::CC_NE);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP1, ARMEmitter::ShiftType::LSL, 16);
+  ptest(P16, PNull1);
+  cset(ARMEmitter::Size::i32Bit, TMP1, ARMEmitter::Condition::CC_NE);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP1, ARMEmitter::ShiftType::LSL, 17);
+  ptest(P16, PResult);
+  cset(ARMEmitter::Size::i32Bit, TMP1, ARMEmitter::Condition::CC_NE);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP1, ARMEmitter::ShiftType::LSL, 18);
+  ubfx(ARMEmitter::Size::i32Bit, TMP1, Dst, 0, 1);
+  orr(ARMEmitter::Size::i32Bit, Dst, Dst, TMP1, ARMEmitter::ShiftType::LSL, 19);
+
+  return true;
+}
+
 #undef DEF_OP
 }
 
@@ -17,6 +17,13 @@ LookupCache::LookupCache(FEXCore::Context::ContextImpl *CTX)
   : BlockLinks_mbr { fextl::pmr::get_default_resource() }
   , ctx {CTX} {
 
+  UseCRCHash = ctx->HostFeatures.SupportsCRC;
+
+  // An empty cache holds nothing any journaled invalidation could refer to,
+  // so it is born in sync. A stale-looking stamp here would only cost a
+  // wasted replay over nothing on the first dispatch.
+  InvalidationJournalEpoch = ctx->InvalidationJournal.Epoch.load(std::memory_order_relaxed);
+
   TotalCacheSize = ctx->Config.VirtualMemSize / 4096 * 8 + CODE_SIZE + L1_SIZE;
   BlockLinks_pma = fextl::make_unique<std::pmr::polymorphic_allocator<std::byte>>(&BlockLinks_mbr);
   // Setup our PMR map.
@@ -55,10 +62,73 @@ LookupCache::~LookupCache() {
   const size_t TotalCacheSize = ctx->Config.VirtualMemSize / 4096 * 8 + CODE_SIZE + L1_SIZE;
   FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(PagePointer), TotalCacheSize);
 
+  if (L1SeparateAllocation) {
+    FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(L1Pointer), L1Entries * sizeof(LookupCacheEntry));
+  }
+
   // No need to free BlockLinks map.
   // These will get freed when their memory allocators are deallocated.
 }
 
+void LookupCache::BindToLocalNode() {
+  // The whole cache is one allocation starting at PagePointer.
+  FEXCore::Allocator::BindToLocalNode(reinterpret_cast<void*>(PagePointer), TotalCacheSize);
+
+  if (L1SeparateAllocation) {
+    FEXCore::Allocator::BindToLocalNode(reinterpret_cast<void*>(L1Pointer), L1Entries * sizeof(LookupCacheEntry));
+  }
+}
+
+void LookupCache::GrowL1IfNeeded() {
+  // A direct-mapped table starts losing entries to conflicts well before it
+  // is full, half load factor is the sweet spot between misses and memory.
+  if (BlockList.size() < L1Entries / 2 || L1Entries >= MAX_L1_ENTRIES) {
+    return;
+  }
+
+  size_t NewEntries = L1Entries;
+  while (BlockList.size() >= NewEntries / 2 && NewEntries < MAX_L1_ENTRIES) {
+    NewEntries *= 2;
+  }
+
+  auto NewL1 = reinterpret_cast<LookupCacheEntry*>(FEXCore::Allocator::VirtualAlloc(NewEntries * sizeof(LookupCacheEntry)));
+  if (!NewL1) {
+    // Keep the current geometry, the map path still works
+    return;
+  }
+
+  // Rehash the L3 block list into the new table. On a conflict the last writer
+  // wins, the same as insertion order did in the old table. Baseline-tier
+  // blocks only ever lived in L1 and are dropped here, they recompile at the
+  // full tier the same way an eviction would have triggered.
+  for (const auto &[Address, HostCode] : BlockList) {
+    auto &Entry = NewL1[HashRIP(Address) & (NewEntries - 1)];
+    Entry.GuestCode = Address;
+    Entry.HostCode = HostCode;
+  }
+
+  if (L1SeparateAllocation) {
+    FEXCore::Allocator::VirtualFree(reinterpret_cast<void*>(L1Pointer), L1Entries * sizeof(LookupCacheEntry));
+  }
+
+  L1Pointer = reinterpret_cast<uintptr_t>(NewL1);
+  L1Entries = NewEntries;
+  L1Mask = NewEntries - 1;
+  L1SeparateAllocation = true;
+  L1Generation++;
+
+  // Retarget the dispatcher at the new table. This is safe because the grow
+  // runs on the owning thread while it is out of the JIT, and every other
+  // L1 writer holds WriteLock like we do.
+  if (Frame) {
+    Frame->Pointers.Common.L1Pointer = L1Pointer;
+    Frame->Pointers.Common.L1EntriesMask = L1Mask;
+  }
+
+  FEXCORE_STATS_STATIC_INIT(StatL1Rehashes, STAT_LOOKUP_L1_REHASHES);
+  FEXCORE_STATS_INC(StatL1Rehashes);
+}
+
 void LookupCache::ClearL2Cache() {
   std::lock_guard<std::recursive_mutex> lk(WriteLock);
   // Clear out the page memory
@@ -72,6 +142,11 @@ void LookupCache::ClearCache() {
 
   // Clear L1 and L2 by clearing the full cache.
   FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(PagePointer), TotalCacheSize);
+  if (L1SeparateAllocation) {
+    // A grown L1 lives outside the main allocation. Keep the geometry, the
+    // block count that justified it tends to come right back.
+    FEXCore::Allocator::VirtualDontNeed(reinterpret_cast<void*>(L1Pointer), L1Entries * sizeof(LookupCacheEntry));
+  }
   // Allocate a new pointer from the BlockLinks pma again.
   BlockLinks = BlockLinks_pma->new_object<BlockLinksMapType>();
   // All code is gone, clear the block list
@@ -2,12 +2,14 @@
 #pragma once
 #include "Interface/Context/Context.h"
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/Statistics.h>
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/memory_resource.h>
 #include <FEXCore/fextl/robin_map.h>
 #include <FEXCore/fextl/vector.h>
 #include <FEXCore/fextl/memory_resource.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <stddef.h>
@@ -26,21 +28,47 @@ public:
   LookupCache(FEXCore::Context::ContextImpl *CTX);
   ~LookupCache();
 
+  // Index hash for the direct-mapped L1. Guest RIPs cluster heavily (16-byte
+  // function alignment, hot code sharing page-offset strides), so plain
+  // low-bit indexing wastes entries on conflicts. CRC32C mixes the whole
+  // address for a single instruction on hosts that have it. The inlined L1
+  // lookups the JIT emits must compute exactly the same index, so this
+  // selects on the same host feature flag and falls back to the identity.
+  uint64_t HashRIP(uint64_t Address) const {
+    if (UseCRCHash) {
+#if defined(_M_ARM_64)
+      uint64_t Hash{};
+      __asm__(".arch_extension crc\n\tcrc32cx %w0, wzr, %x1" : "=r"(Hash) : "r"(Address));
+      return Hash;
+#elif defined(_M_X86_64)
+      // x86 CRC32 uses the same CRC32-C polynomial as the ARM instruction
+      uint64_t Hash{};
+      __asm__("crc32q %1, %0" : "+r"(Hash) : "r"(Address));
+      return Hash;
+#endif
+    }
+    return Address;
+  }
+
   uintptr_t FindBlock(uint64_t Address) {
     // Try L1, no lock needed
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[HashRIP(Address) & L1Mask];
     if (L1Entry.GuestCode == Address) {
       return L1Entry.HostCode;
     }
 
     // L2 and L3 need to be locked
-    std::lock_guard<std::recursive_mutex> lk(WriteLock);
-
-    // Try L2
     const auto PageIndex = (Address & (VirtualMemSize -1)) >> 12;
     const auto PageOffset = Address & (0x0FFF);
 
+    // The L2 probe happens under the lock, start pulling its page pointer in
+    // while the lock is acquired
     const auto Pointers = reinterpret_cast<uintptr_t*>(PagePointer);
+    __builtin_prefetch(&Pointers[PageIndex]);
+
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+    // Try L2
     auto LocalPagePointer = Pointers[PageIndex];
 
     // Do we a page pointer for this address?
@@ -50,6 +78,8 @@ public:
 
       if (BlockPointers[PageOffset].GuestCode == Address)
       {
+        FEXCORE_STATS_STATIC_INIT(StatL2Hits, STAT_LOOKUP_L2_HITS);
+        FEXCORE_STATS_INC(StatL2Hits);
         L1Entry.GuestCode = Address;
         L1Entry.HostCode = BlockPointers[PageOffset].HostCode;
         return L1Entry.HostCode;
@@ -60,15 +90,38 @@ public:
     auto HostCode = BlockList.find(Address);
 
     if (HostCode != BlockList.end()) {
+      FEXCORE_STATS_STATIC_INIT(StatL3Hits, STAT_LOOKUP_L3_HITS);
+      FEXCORE_STATS_INC(StatL3Hits);
       CacheBlockMapping(Address, HostCode->second);
       return HostCode->second;
     }
 
     // Failed to find
+    FEXCORE_STATS_STATIC_INIT(StatMisses, STAT_LOOKUP_MISSES);
+    FEXCORE_STATS_INC(StatMisses);
     return 0;
   }
 
-  fextl::map<uint64_t, fextl::vector<uint64_t>> CodePages;
+  // Sub-page granularity for SMC invalidation. Each block records which
+  // 256-byte chunks of a page its guest code decodes from, so a write only
+  // invalidates blocks overlapping the written chunks instead of everything
+  // on the 4K page.
+  constexpr static uint64_t CHUNK_SHIFT = 8;
+
+  struct PageCoverage {
+    uint64_t Address;
+    // One bit per 256-byte chunk of the page the block's code touches
+    uint16_t ChunkMask;
+  };
+
+  // Chunk mask covering [FirstOffset, LastOffset], both page offsets inclusive
+  static uint16_t ChunkMaskForRange(uint64_t FirstOffset, uint64_t LastOffset) {
+    const uint32_t FirstChunk = FirstOffset >> CHUNK_SHIFT;
+    const uint32_t NumChunks = (LastOffset >> CHUNK_SHIFT) - FirstChunk + 1;
+    return static_cast<uint16_t>(((1U << NumChunks) - 1) << FirstChunk);
+  }
+
+  fextl::map<uint64_t, fextl::vector<PageCoverage>> CodePages;
 
   // Appends Block {Address} to CodePages [Start, Start + Length)
   // Returns true if new pages are marked as containing code
@@ -77,10 +130,15 @@ public:
 
     bool rv = false;
 
-    for (auto CurrentPage = Start >> 12, EndPage = (Start + Length -1) >> 12; CurrentPage <= EndPage; CurrentPage++) {
+    const uint64_t End = Start + Length - 1;
+    for (auto CurrentPage = Start >> 12, EndPage = End >> 12; CurrentPage <= EndPage; CurrentPage++) {
       auto &CodePage = CodePages[CurrentPage];
       rv |= CodePage.size() == 0;
-      CodePage.push_back(Address);
+
+      const uint64_t PageBase = CurrentPage << 12;
+      const uint64_t FirstOffset = std::max(Start, PageBase) - PageBase;
+      const uint64_t LastOffset = std::min(End, PageBase + 0x0FFF) - PageBase;
+      CodePage.push_back(PageCoverage { Address, ChunkMaskForRange(FirstOffset, LastOffset) });
     }
 
     return rv;
@@ -93,9 +151,24 @@ public:
     [[maybe_unused]] auto Inserted = BlockList.emplace(Address, (uintptr_t)HostCode).second;
     LOGMAN_THROW_AA_FMT(Inserted, "Duplicate block mapping added");
 
+    // The block count just changed, see if the L1 table is still a good fit
+    GrowL1IfNeeded();
+
     // There is no need to update L1 or L2, they will get updated on first lookup
     // However, adding to L1 here increases performance
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[HashRIP(Address) & L1Mask];
+    L1Entry.GuestCode = Address;
+    L1Entry.HostCode = (uintptr_t)HostCode;
+  }
+
+  // Adds to the L1 cache only, skipping L2 and the L3 BlockList.
+  // Used for baseline-tier blocks: once the entry is evicted from L1 the
+  // dispatcher falls back to CompileBlock, giving us a natural point to
+  // recompile still-live blocks at the full tier.
+  void AddBlockMappingL1Only(uint64_t Address, void *HostCode) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[HashRIP(Address) & L1Mask];
     L1Entry.GuestCode = Address;
     L1Entry.HostCode = (uintptr_t)HostCode;
   }
@@ -115,7 +188,7 @@ public:
     BlockList.erase(Address);
 
     // Do L1
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[HashRIP(Address) & L1Mask];
     if (L1Entry.GuestCode == Address) {
       L1Entry.GuestCode = 0;
       // Leave L1Entry.HostCode as is, so that concurrent lookups won't read a null pointer
@@ -151,12 +224,33 @@ public:
   void ClearCache();
   void ClearL2Cache();
 
+  // Binds the cache arrays to the NUMA node of the calling thread.
+  // Must be called from the owning thread, ideally before the arrays are touched.
+  void BindToLocalNode();
+
   uintptr_t GetL1Pointer() const { return L1Pointer; }
+  uintptr_t GetL1Mask() const { return L1Mask; }
   uintptr_t GetPagePointer() const { return PagePointer; }
   uintptr_t GetVirtualMemorySize() const { return VirtualMemSize; }
 
+  // Bumped every time the L1 table is regrown, for telemetry
+  uint32_t GetL1Generation() const { return L1Generation; }
+
+  // Lets the cache retarget the dispatcher's L1 pointer and mask when the
+  // table grows. Must be the frame of the owning thread.
+  void RegisterCpuStateFrame(FEXCore::Core::CpuStateFrame *frame) { Frame = frame; }
+
+  // Initial direct-mapped L1 geometry. The table is grown in powers of two up
+  // to MAX_L1_ENTRIES once the compiled block count outgrows it, so large
+  // applications don't pay the map lookup path for a long tail of blocks.
   constexpr static size_t L1_ENTRIES = 1 * 1024 * 1024; // Must be a power of 2
-  constexpr static size_t L1_ENTRIES_MASK = L1_ENTRIES - 1;
+  constexpr static size_t MAX_L1_ENTRIES = 8 * 1024 * 1024;
+
+  // Epoch of the last ContextImpl::InvalidationJournal entry applied to this
+  // cache. Only touched by the owning thread (or with CodeInvalidationMutex
+  // held uniquely); stamped at construction so a fresh, empty cache doesn't
+  // replay journal history it can't contain anything from.
+  uint64_t InvalidationJournalEpoch {};
 
   // This needs to be taken before reads or writes to L2, L3, CodePages, Thread::DebugStore,
   // and before writes to L1. Concurrent access from a thread that this LookupCache doesn't belong to
@@ -170,7 +264,7 @@ public:
 private:
   void CacheBlockMapping(uint64_t Address, uintptr_t HostCode) {
     // Do L1
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[HashRIP(Address) & L1Mask];
     L1Entry.GuestCode = Address;
     L1Entry.HostCode = HostCode;
 
@@ -204,6 +298,10 @@ private:
     BlockPointers[PageOffset].HostCode = HostCode;
   }
 
+  // Grows the L1 table once the block count passes half its capacity, the
+  // point where a direct-mapped table starts losing entries to conflicts.
+  void GrowL1IfNeeded();
+
   uintptr_t AllocateBackingForPage() {
     uintptr_t NewBase = AllocateOffset;
     uintptr_t NewEnd = AllocateOffset + SIZE_PER_PAGE;
@@ -220,7 +318,20 @@ private:
 
   uintptr_t PagePointer;
   uintptr_t PageMemory;
+
+  // Current L1 geometry. Starts embedded in the main cache allocation at
+  // L1_ENTRIES and moves to its own allocation when grown.
   uintptr_t L1Pointer;
+  size_t L1Entries {L1_ENTRIES};
+  uintptr_t L1Mask {L1_ENTRIES - 1};
+  bool L1SeparateAllocation {false};
+  uint32_t L1Generation {};
+
+  // Whether HashRIP uses CRC32C. Mirrors HostFeatures.SupportsCRC, which the
+  // JIT also keys its inlined L1 index computation on.
+  bool UseCRCHash {false};
+
+  FEXCore::Core::CpuStateFrame *Frame {};
 
   struct BlockLinkTag {
     uint64_t GuestDestination;
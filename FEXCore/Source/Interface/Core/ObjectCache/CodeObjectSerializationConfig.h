@@ -47,9 +47,13 @@ namespace FEXCore::CodeSerialize {
     // x87 reduced precision
     unsigned x87ReducedPrecision : 1;
 
+    // Object cache files may contain zstd compressed records
+    // A build without zstd can't load them, so this is part of the file key
+    unsigned ZstdCompressed : 1;
+
     // Padding to remove uninitialized data warning from asan
     // Shows remaining amount of bits available for config
-    unsigned _Pad : 18;
+    unsigned _Pad : 17;
 
     bool operator==(CodeObjectSerializationConfig const &other) const {
       return Cookie == other.Cookie &&
@@ -63,7 +67,8 @@ namespace FEXCore::CodeSerialize {
         ParanoidTSO == other.ParanoidTSO &&
         Is64BitMode == other.Is64BitMode &&
         SMCChecks == other.SMCChecks &&
-        x87ReducedPrecision == other.x87ReducedPrecision;
+        x87ReducedPrecision == other.x87ReducedPrecision &&
+        ZstdCompressed == other.ZstdCompressed;
     }
     static uint64_t GetHash(CodeObjectSerializationConfig const &other) {
       // For < 64-bits of data just pack directly
@@ -80,6 +85,7 @@ namespace FEXCore::CodeSerialize {
       Hash <<= 1;  Hash |= other.Is64BitMode;
       Hash <<= 2;  Hash |= other.SMCChecks;
       Hash <<= 1;  Hash |= other.x87ReducedPrecision;
+      Hash <<= 1;  Hash |= other.ZstdCompressed;
       return Hash;
     }
   };
@@ -125,6 +125,11 @@ namespace FEXCore::CodeSerialize {
   }
 
   void AsyncJobHandler::AsyncAddSerializationJob(fextl::unique_ptr<SerializationJobData> Data) {
-    // XXX: Actually add serialization job
+    // Hold a shared lock on the thread's job ref counter until the job completes.
+    // Thread shutdown and code cache clears pull a unique lock to drain their jobs.
+    Data->ThreadJobRefCount->lock_shared();
+
+    CodeObjectCacheService->QueueSerializationJob(std::move(Data));
+    CodeObjectCacheService->NotifyWork();
   }
 }
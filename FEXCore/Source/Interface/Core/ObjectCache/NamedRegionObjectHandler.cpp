@@ -2,11 +2,111 @@
 #include "Interface/Context/Context.h"
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 
-
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#ifndef _WIN32
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <xxhash.h>
 
 namespace FEXCore::CodeSerialize {
+#ifndef _WIN32
+  // Walks the PT_NOTE segments of an ELF on disk looking for the GNU build-id note.
+  // Returns an XXH3 hash of the build-id bytes, or zero if the file doesn't carry one.
+  static uint64_t CalculateELFBuildIdHash(int FD) {
+    uint8_t Ident[EI_NIDENT];
+    if (pread(FD, Ident, sizeof(Ident), 0) != sizeof(Ident)) {
+      return 0;
+    }
+
+    if (memcmp(Ident, ELFMAG, SELFMAG) != 0) {
+      return 0;
+    }
+
+    auto HashNotes = [FD](uint64_t NoteOffset, uint64_t NoteSize) -> uint64_t {
+      fextl::vector<char> Notes(NoteSize);
+      if (pread(FD, Notes.data(), NoteSize, NoteOffset) != static_cast<ssize_t>(NoteSize)) {
+        return 0;
+      }
+
+      // Note headers share a layout between ELFCLASS32 and ELFCLASS64
+      size_t Offset{};
+      while (Offset + sizeof(Elf64_Nhdr) <= NoteSize) {
+        auto Note = reinterpret_cast<const Elf64_Nhdr*>(&Notes[Offset]);
+        const size_t NameSize = FEXCore::AlignUp(Note->n_namesz, 4);
+        const size_t DescSize = FEXCore::AlignUp(Note->n_descsz, 4);
+        const size_t NoteEnd = Offset + sizeof(Elf64_Nhdr) + NameSize + DescSize;
+        if (NoteEnd > NoteSize) {
+          break;
+        }
+
+        if (Note->n_type == NT_GNU_BUILD_ID &&
+            Note->n_namesz == 4 &&
+            memcmp(&Notes[Offset + sizeof(Elf64_Nhdr)], "GNU", 4) == 0) {
+          return XXH3_64bits(&Notes[Offset + sizeof(Elf64_Nhdr) + NameSize], Note->n_descsz);
+        }
+
+        Offset = NoteEnd;
+      }
+      return 0;
+    };
+
+    if (Ident[EI_CLASS] == ELFCLASS64) {
+      Elf64_Ehdr Header;
+      if (pread(FD, &Header, sizeof(Header), 0) != sizeof(Header)) {
+        return 0;
+      }
+
+      for (size_t i = 0; i < Header.e_phnum; ++i) {
+        Elf64_Phdr Phdr;
+        if (pread(FD, &Phdr, sizeof(Phdr), Header.e_phoff + i * Header.e_phentsize) != sizeof(Phdr)) {
+          return 0;
+        }
+        if (Phdr.p_type == PT_NOTE) {
+          if (auto Hash = HashNotes(Phdr.p_offset, Phdr.p_filesz)) {
+            return Hash;
+          }
+        }
+      }
+    }
+    else if (Ident[EI_CLASS] == ELFCLASS32) {
+      Elf32_Ehdr Header;
+      if (pread(FD, &Header, sizeof(Header), 0) != sizeof(Header)) {
+        return 0;
+      }
+
+      for (size_t i = 0; i < Header.e_phnum; ++i) {
+        Elf32_Phdr Phdr;
+        if (pread(FD, &Phdr, sizeof(Phdr), Header.e_phoff + i * Header.e_phentsize) != sizeof(Phdr)) {
+          return 0;
+        }
+        if (Phdr.p_type == PT_NOTE) {
+          if (auto Hash = HashNotes(Phdr.p_offset, Phdr.p_filesz)) {
+            return Hash;
+          }
+        }
+      }
+    }
+
+    return 0;
+  }
+#endif
+
   NamedRegionObjectHandler::NamedRegionObjectHandler(FEXCore::Context::ContextImpl *ctx) {
     DefaultSerializationConfig.Cookie = CODE_COOKIE;
 
@@ -23,19 +123,177 @@ namespace FEXCore::CodeSerialize {
     DefaultSerializationConfig.Is64BitMode = ctx->Config.Is64BitMode;
     DefaultSerializationConfig.SMCChecks = ctx->Config.SMCChecks;
     DefaultSerializationConfig.x87ReducedPrecision = ctx->Config.x87ReducedPrecision;
+#ifdef OBJCACHE_HAS_ZSTD
+    // Builds without zstd can't read compressed records, keep the caches apart
+    DefaultSerializationConfig.ZstdCompressed = 1;
+#endif
   }
 
   void NamedRegionObjectHandler::AddNamedRegionObject(CodeRegionMapType::iterator Entry, const fextl::string &base_filename, const fextl::string &filename, bool Executable) {
-    // XXX: Add named region objects
+#ifndef _WIN32
+    auto RegionEntry = Entry->second.get();
+
+    // Named region loading happens in three steps
+    // 1) Hash the guest binary's build-id so the cache file is keyed by content
+    // 2) Open or create the cache file for this region and validate its header
+    // 3) Map the file and populate the section lookup map for JIT fetches
+    const int GuestFD = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (GuestFD != -1) {
+      RegionEntry->BuildIdHash = CalculateELFBuildIdHash(GuestFD);
+      close(GuestFD);
+    }
+
+    if (!RegionEntry->BuildIdHash) {
+      // Without a build-id we can't validate the cache across binary updates.
+      // Don't serialize this region at all.
+      RegionEntry->StillSerializing = false;
+      Entry->second->NamedJobRefCountMutex.unlock();
+      return;
+    }
+
+    const auto CacheDir = fextl::fmt::format("{}/objcache", FEXCore::Config::GetDataDirectory());
+    FHU::Filesystem::CreateDirectory(CacheDir);
+
+    RegionEntry->ObjectEntrySourceFilename = fextl::fmt::format("{}/{}-{:x}-{:x}.focd",
+      CacheDir,
+      base_filename,
+      RegionEntry->BuildIdHash,
+      CodeObjectSerializationConfig::GetHash(DefaultSerializationConfig));
+
+    const int FD = open(RegionEntry->ObjectEntrySourceFilename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (FD == -1) {
+      RegionEntry->StillSerializing = false;
+      Entry->second->NamedJobRefCountMutex.unlock();
+      return;
+    }
+
+    // Multiple processes can be launching with the same cache file, serialize header access
+    flock(FD, LOCK_EX);
 
-    // XXX: Until entry loading is complete just claim it is loaded
+    struct stat Stat{};
+    fstat(FD, &Stat);
+
+    if (Stat.st_size == 0) {
+      // Fresh cache file, write out our header
+      auto Header = RegionEntry->EntryHeader;
+      Header.BuildIdHash = RegionEntry->BuildIdHash;
+      if (pwrite(FD, &Header, sizeof(Header), 0) != sizeof(Header)) {
+        // Couldn't even write the header, give up on this region
+        ftruncate(FD, 0);
+        flock(FD, LOCK_UN);
+        close(FD);
+        RegionEntry->StillSerializing = false;
+        Entry->second->NamedJobRefCountMutex.unlock();
+        return;
+      }
+      RegionEntry->CurrentSerializedFD = FD;
+      flock(FD, LOCK_UN);
+      Entry->second->NamedJobRefCountMutex.unlock();
+      return;
+    }
+
+    CodeObjectSerializationHeader Header{};
+    bool Valid = Stat.st_size >= static_cast<off_t>(sizeof(Header)) &&
+      pread(FD, &Header, sizeof(Header), 0) == sizeof(Header) &&
+      Header.Config == DefaultSerializationConfig &&
+      Header.BuildIdHash == RegionEntry->BuildIdHash;
+
+    if (!Valid) {
+      // Stale or corrupt cache. The file name is keyed by build-id and config so
+      // this should only happen on cookie bumps or corruption; start over.
+      ftruncate(FD, 0);
+      auto NewHeader = RegionEntry->EntryHeader;
+      NewHeader.BuildIdHash = RegionEntry->BuildIdHash;
+      if (pwrite(FD, &NewHeader, sizeof(NewHeader), 0) == sizeof(NewHeader)) {
+        RegionEntry->CurrentSerializedFD = FD;
+      }
+      else {
+        close(FD);
+        RegionEntry->StillSerializing = false;
+      }
+      flock(FD, LOCK_UN);
+      Entry->second->NamedJobRefCountMutex.unlock();
+      return;
+    }
+
+    // Valid cache data, map it and build the section lookup map
+    RegionEntry->FileSize = Stat.st_size;
+    RegionEntry->CodeData = reinterpret_cast<char*>(
+      FEXCore::Allocator::mmap(nullptr, RegionEntry->FileSize, PROT_READ, MAP_PRIVATE, FD, 0));
+    flock(FD, LOCK_UN);
+
+    if (RegionEntry->CodeData == MAP_FAILED) {
+      RegionEntry->CodeData = nullptr;
+      RegionEntry->FileSize = 0;
+      close(FD);
+      RegionEntry->StillSerializing = false;
+      Entry->second->NamedJobRefCountMutex.unlock();
+      return;
+    }
+
+    RegionEntry->CurrentSerializedFD = FD;
+
+    // Walk the records until we run out of file. A truncated tail from a
+    // crashed writer just ends the walk early.
+    size_t Offset = sizeof(Header);
+    size_t NumRecords{};
+    while (Offset + sizeof(CodeObjectFileRecord) <= RegionEntry->FileSize) {
+      auto Record = reinterpret_cast<const CodeObjectFileRecord*>(&RegionEntry->CodeData[Offset]);
+      const size_t RecordEnd = Offset + sizeof(CodeObjectFileRecord) + Record->PayloadSize();
+      if (RecordEnd > RegionEntry->FileSize) {
+        break;
+      }
+      ++NumRecords;
+      Offset = RecordEnd;
+    }
+
+    RegionEntry->FileCodeSections.reserve(NumRecords);
+    RegionEntry->SectionLookupMap.reserve(NumRecords);
+
+    Offset = sizeof(Header);
+    for (size_t i = 0; i < NumRecords; ++i) {
+      auto Record = reinterpret_cast<const CodeObjectFileRecord*>(&RegionEntry->CodeData[Offset]);
+      const char *Payload = &RegionEntry->CodeData[Offset + sizeof(CodeObjectFileRecord)];
+
+      // Compressed records stay compressed in the mapping. The first JIT fetch
+      // of a section decompresses it, cold sections never pay for it at all.
+      const bool Compressed = Record->CompressedLength != 0;
+      auto &Section = RegionEntry->FileCodeSections.emplace_back(CodeObjectFileSection {
+        .Serialized = true,
+        .Invalid = false,
+        .Data = nullptr,
+        .HostCode = Compressed ? nullptr : Payload,
+        .HostCodeLength = Record->HostCodeLength,
+        .GuestCodeStart = RegionEntry->Base + Record->GuestStartOffset,
+        .GuestCodeLength = Record->GuestCodeLength,
+        .GuestCodeHash = Record->GuestCodeHash,
+        .NumRelocations = Record->NumRelocations,
+        .Relocations = Compressed ? nullptr : Payload + Record->HostCodeLength,
+        .CompressedData = Compressed ? Payload : nullptr,
+        .CompressedLength = Record->CompressedLength,
+      });
+
+      // Section addresses are relative to wherever the region is mapped this run
+      RegionEntry->SectionLookupMap.emplace(RegionEntry->Base + Record->GuestRIPOffset, &Section);
+
+      Offset += sizeof(CodeObjectFileRecord) + Record->PayloadSize();
+    }
+#endif
+
+    // Region is loaded, unblock JIT lookups
     Entry->second->NamedJobRefCountMutex.unlock();
   }
 
   void NamedRegionObjectHandler::RemoveNamedRegionObject(uintptr_t Base, uintptr_t Size, fextl::unique_ptr<CodeRegionEntry> Entry) {
-    // XXX: Remove named region objects
+#ifndef _WIN32
+    // File data was already unmapped when the entry was pulled from the map.
+    // Just close out the cache file FD.
+    if (Entry->CurrentSerializedFD != -1) {
+      close(Entry->CurrentSerializedFD);
+      Entry->CurrentSerializedFD = -1;
+    }
+#endif
 
-    // XXX: Until entry loading is complete just claim it is loaded
     Entry->NamedJobRefCountMutex.unlock();
   }
 
@@ -2,9 +2,25 @@
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
+#include <FEXCore/fextl/vector.h>
 #include <FEXCore/Utils/Threads.h>
 
+#ifndef _WIN32
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <xxhash.h>
+
+#ifdef OBJCACHE_HAS_ZSTD
+#include <zstd.h>
+#endif
+
 namespace {
   static void* ThreadHandler(void *Arg) {
     FEXCore::CodeSerialize::CodeObjectSerializeService *This = reinterpret_cast<FEXCore::CodeSerialize::CodeObjectSerializeService*>(Arg);
@@ -52,25 +68,416 @@ namespace FEXCore::CodeSerialize {
       // Don't do closure on canary
       return;
     }
-    // XXX: Do code region closure
+
+#ifndef _WIN32
+    // Close out the cache file for this region. Outstanding jobs hold the
+    // ObjectJobRefCountMutex, wait for them to drain first.
+    std::unique_lock lk {it->ObjectJobRefCountMutex};
+    if (it->CurrentSerializedFD != -1) {
+      if (it->NeedsFsync) {
+        // Data was flushed but the idle fsync pass hasn't run yet
+        fsync(it->CurrentSerializedFD);
+        it->NeedsFsync = false;
+      }
+      close(it->CurrentSerializedFD);
+      it->CurrentSerializedFD = -1;
+    }
+    it->StillSerializing = false;
+#endif
   }
 
   CodeObjectFileSection const *CodeObjectSerializeService::FetchCodeObjectFromCache(uint64_t GuestRIP) {
-    // XXX: Actually fetch code objects from cache
-    return nullptr;
+    std::shared_lock lk {EntryMapMutex};
+
+    // Find the region containing this RIP. The canary at ~0ULL guarantees
+    // upper_bound never returns begin() on a populated map.
+    auto it = AddressToEntryMap.upper_bound(GuestRIP);
+    if (it == AddressToEntryMap.begin()) {
+      return nullptr;
+    }
+    --it;
+
+    auto Entry = it->second.get();
+    if (GuestRIP < Entry->Base || GuestRIP >= (Entry->Base + Entry->Size)) {
+      return nullptr;
+    }
+
+    // Block until the named region has finished loading
+    std::shared_lock NamedLock {Entry->NamedJobRefCountMutex};
+
+    auto Section = Entry->SectionLookupMap.find(GuestRIP);
+    if (Section == Entry->SectionLookupMap.end()) {
+      return nullptr;
+    }
+
+    auto FileSection = Section->second;
+    if (FileSection->Invalid) {
+      return nullptr;
+    }
+
+    // Validate the guest code still matches what was serialized.
+    // Catches JIT'd or patched guest pages that build-id validation can't see.
+    if (XXH3_64bits(reinterpret_cast<const void*>(FileSection->GuestCodeStart), FileSection->GuestCodeLength) != FileSection->GuestCodeHash) {
+      FileSection->Invalid = true;
+
+      // The backing file now carries a dead record. Ask the worker thread to
+      // compact it away once it next goes idle.
+      ++Entry->InvalidatedSections;
+      MaintenanceRequested = true;
+      NotifyWork();
+      return nullptr;
+    }
+
+#ifdef OBJCACHE_HAS_ZSTD
+    if (FileSection->CompressedData) {
+      // First fetch of a compressed section, decompress it now. Sections the
+      // JIT never asks for stay compressed in the file mapping. The lock also
+      // publishes the decompressed payload to other fetching threads.
+      std::unique_lock DecompressGuard {Entry->DecompressLock};
+      if (!FileSection->HostCode) {
+        const size_t PayloadSize = FileSection->HostCodeLength +
+          FileSection->NumRelocations * sizeof(FEXCore::CPU::Relocation);
+        FileSection->DecompressedData.resize(PayloadSize);
+
+        const size_t Result = ZSTD_decompress(
+          FileSection->DecompressedData.data(), PayloadSize,
+          FileSection->CompressedData, FileSection->CompressedLength);
+        if (ZSTD_isError(Result) || Result != PayloadSize) {
+          // Corrupt record, treat it like a hash mismatch so compaction drops it
+          FileSection->DecompressedData.clear();
+          FileSection->Invalid = true;
+          ++Entry->InvalidatedSections;
+          MaintenanceRequested = true;
+          NotifyWork();
+          return nullptr;
+        }
+
+        // A set HostCode doubles as the already-decompressed flag
+        FileSection->HostCode = FileSection->DecompressedData.data();
+        FileSection->Relocations = FileSection->DecompressedData.data() + FileSection->HostCodeLength;
+      }
+    }
+#endif
+
+    return FileSection;
+  }
+
+  void CodeObjectSerializeService::SerializeCodeObject(CodeRegionEntry *Entry, AsyncJobHandler::SerializationJobData *Data) {
+#ifndef _WIN32
+    if (!Entry->StillSerializing || Entry->CurrentSerializedFD == -1) {
+      return;
+    }
+
+    if (Entry->SectionLookupMap.contains(Data->GuestRIP)) {
+      // Already serialized in a previous run, nothing to do
+      return;
+    }
+
+    CodeObjectFileRecord Record {
+      .GuestRIPOffset = Data->GuestRIP - Entry->Base,
+      .GuestStartOffset = Data->GuestCodeStart - Entry->Base,
+      .GuestCodeLength = Data->GuestCodeLength,
+      .GuestCodeHash = Data->GuestCodeHash,
+      .HostCodeLength = Data->HostCodeLength,
+      .NumRelocations = Data->Relocations.size(),
+    };
+
+    const size_t RelocationBytes = Data->Relocations.size() * sizeof(FEXCore::CPU::Relocation);
+
+#ifdef OBJCACHE_HAS_ZSTD
+    // Compress the payload. JIT'd code compresses well and the worker thread
+    // has the time. Records the compressor can't shrink get stored raw, which
+    // also covers blocks too small to be worth a round trip through zstd.
+    const size_t PayloadSize = Data->HostCodeLength + RelocationBytes;
+    fextl::vector<char> RawPayload;
+    RawPayload.reserve(PayloadSize);
+    RawPayload.insert(RawPayload.end(),
+      static_cast<const char*>(Data->HostCodeBegin),
+      static_cast<const char*>(Data->HostCodeBegin) + Data->HostCodeLength);
+    RawPayload.insert(RawPayload.end(),
+      reinterpret_cast<const char*>(Data->Relocations.data()),
+      reinterpret_cast<const char*>(Data->Relocations.data()) + RelocationBytes);
+
+    fextl::vector<char> CompressedPayload(ZSTD_compressBound(PayloadSize));
+    const size_t Result = ZSTD_compress(
+      CompressedPayload.data(), CompressedPayload.size(),
+      RawPayload.data(), PayloadSize,
+      ZSTD_CLEVEL_DEFAULT);
+    if (!ZSTD_isError(Result) && Result < PayloadSize) {
+      Record.CompressedLength = Result;
+    }
+#endif
+
+    // Serialize into the region's pending buffer. The actual file append is
+    // coalesced with the other jobs of this queue drain in FlushPendingWrites.
+    auto &Buffer = Entry->PendingWriteData;
+    auto Append = [&Buffer](const void *Ptr, size_t Size) {
+      const char *Bytes = static_cast<const char*>(Ptr);
+      Buffer.insert(Buffer.end(), Bytes, Bytes + Size);
+    };
+
+    Append(&Record, sizeof(Record));
+#ifdef OBJCACHE_HAS_ZSTD
+    if (Record.CompressedLength) {
+      Append(CompressedPayload.data(), Record.CompressedLength);
+    }
+    else
+#endif
+    {
+      Append(Data->HostCodeBegin, Data->HostCodeLength);
+      Append(Data->Relocations.data(), RelocationBytes);
+    }
+
+    if (Buffer.size() >= MaxPendingWriteBytes) {
+      // Don't let a large burst hold an unbounded buffer, flush early
+      FlushPendingWrites(Entry);
+    }
+#endif
+  }
+
+  void CodeObjectSerializeService::FlushPendingWrites(CodeRegionEntry *Entry) {
+#ifndef _WIN32
+    auto &Buffer = Entry->PendingWriteData;
+    if (Buffer.empty()) {
+      return;
+    }
+
+    if (!Entry->StillSerializing || Entry->CurrentSerializedFD == -1) {
+      Buffer.clear();
+      return;
+    }
+
+    const int FD = Entry->CurrentSerializedFD;
+
+    // Append under an OS file lock, the file is shared between processes.
+    // Other processes append as well, so seek to the current end under the lock.
+    flock(FD, LOCK_EX);
+    lseek(FD, 0, SEEK_END);
+    const bool Success = write(FD, Buffer.data(), Buffer.size()) == static_cast<ssize_t>(Buffer.size());
+    flock(FD, LOCK_UN);
+
+    if (Success) {
+      // fsync is batched on to the idle maintenance pass
+      Entry->NeedsFsync = true;
+    }
+    else {
+      // Partial write leaves a truncated tail which loaders skip, but don't
+      // keep appending to a file we can't write properly.
+      Entry->StillSerializing = false;
+    }
+
+    Buffer.clear();
+#endif
+  }
+
+  bool CodeObjectSerializeService::HandleSerializationJobs() {
+    // Pull the entire queue in one go so multiple jobs targeting the same
+    // region can coalesce their file writes.
+    fextl::queue<fextl::unique_ptr<AsyncJobHandler::SerializationJobData>> LocalQueue;
+    {
+      std::unique_lock lk {SerializationQueueMutex};
+      LocalQueue.swap(SerializationQueue);
+      SerializationQueueJobs.store(0);
+    }
+
+    if (LocalQueue.empty()) {
+      return false;
+    }
+
+    bool FlushedWrites = false;
+
+    {
+      // Holding the map lock shared for the whole drain keeps the touched
+      // entries alive until their buffers are flushed. Region removal pulls
+      // a unique lock and so waits for the flush.
+      std::shared_lock lk {EntryMapMutex};
+      fextl::vector<CodeRegionEntry*> TouchedEntries;
+
+      while (!LocalQueue.empty()) {
+        fextl::unique_ptr<AsyncJobHandler::SerializationJobData> Data = std::move(LocalQueue.front());
+        LocalQueue.pop();
+
+        // Find the region that contains this code object
+        auto it = AddressToEntryMap.upper_bound(Data->GuestRIP);
+        if (it != AddressToEntryMap.begin()) {
+          --it;
+          auto Entry = it->second.get();
+          if (Data->GuestRIP >= Entry->Base && Data->GuestRIP < (Entry->Base + Entry->Size)) {
+            // Wait for the region to finish loading, then hold its job ref count while serializing
+            std::shared_lock NamedLock {Entry->NamedJobRefCountMutex};
+            std::shared_lock JobLock {Entry->ObjectJobRefCountMutex};
+
+            if (Entry->PendingWriteData.empty()) {
+              TouchedEntries.push_back(Entry);
+            }
+            SerializeCodeObject(Entry, Data.get());
+          }
+        }
+
+        // Job complete, release the thread's ref count
+        Data->ThreadJobRefCount->unlock_shared();
+      }
+
+      // One locked append per region for this whole drain
+      for (auto Entry : TouchedEntries) {
+        FlushPendingWrites(Entry);
+        FlushedWrites |= Entry->NeedsFsync;
+      }
+    }
+
+    return FlushedWrites;
+  }
+
+  void CodeObjectSerializeService::CompactRegionFile(CodeRegionEntry *Entry) {
+#ifndef _WIN32
+    if (!Entry->StillSerializing || Entry->CurrentSerializedFD == -1) {
+      return;
+    }
+
+    const int FD = Entry->CurrentSerializedFD;
+
+    // Dropping records invalidates lookup map entries, block JIT fetches meanwhile
+    std::unique_lock NamedLock {Entry->NamedJobRefCountMutex};
+
+    flock(FD, LOCK_EX);
+
+    struct stat Stat{};
+    if (fstat(FD, &Stat) == -1 || Stat.st_size < static_cast<off_t>(sizeof(CodeObjectSerializationHeader))) {
+      flock(FD, LOCK_UN);
+      return;
+    }
+
+    // Read back the file rather than using the mapped copy, records appended
+    // since the region loaded only exist on disk.
+    fextl::vector<char> FileData(Stat.st_size);
+    if (pread(FD, FileData.data(), FileData.size(), 0) != static_cast<ssize_t>(FileData.size())) {
+      flock(FD, LOCK_UN);
+      return;
+    }
+
+    // Copy the header and every record the JIT hasn't invalidated
+    fextl::vector<char> Compacted;
+    Compacted.reserve(FileData.size());
+    Compacted.insert(Compacted.end(), FileData.begin(), FileData.begin() + sizeof(CodeObjectSerializationHeader));
+
+    size_t Offset = sizeof(CodeObjectSerializationHeader);
+    while (Offset + sizeof(CodeObjectFileRecord) <= FileData.size()) {
+      auto Record = reinterpret_cast<const CodeObjectFileRecord*>(&FileData[Offset]);
+      const size_t RecordEnd = Offset + sizeof(CodeObjectFileRecord) + Record->PayloadSize();
+      if (RecordEnd > FileData.size()) {
+        // Truncated tail from a crashed writer, compaction drops it
+        break;
+      }
+
+      auto Section = Entry->SectionLookupMap.find(Entry->Base + Record->GuestRIPOffset);
+      const bool Dropped = Section != Entry->SectionLookupMap.end() && Section->second->Invalid;
+      if (!Dropped) {
+        Compacted.insert(Compacted.end(), FileData.begin() + Offset, FileData.begin() + RecordEnd);
+      }
+
+      Offset = RecordEnd;
+    }
+
+    // Write the dense file next to the original and rename it into place. The
+    // old inode stays alive for this run's mapping and for other processes that
+    // still hold it open; their future appends are sacrificed to the rename.
+    const auto TempFilename = fextl::fmt::format("{}.compact.{}", Entry->ObjectEntrySourceFilename, getpid());
+    const int NewFD = open(TempFilename.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (NewFD == -1) {
+      flock(FD, LOCK_UN);
+      return;
+    }
+
+    const bool Success =
+      write(NewFD, Compacted.data(), Compacted.size()) == static_cast<ssize_t>(Compacted.size()) &&
+      fsync(NewFD) == 0 &&
+      rename(TempFilename.c_str(), Entry->ObjectEntrySourceFilename.c_str()) == 0;
+
+    flock(FD, LOCK_UN);
+
+    if (!Success) {
+      close(NewFD);
+      unlink(TempFilename.c_str());
+      return;
+    }
+
+    // Appends now go to the compacted file
+    close(FD);
+    Entry->CurrentSerializedFD = NewFD;
+    Entry->NeedsFsync = false;
+
+    // Drop the invalidated sections from the lookup map so fresh code at those
+    // addresses can be serialized again.
+    for (auto it = Entry->SectionLookupMap.begin(); it != Entry->SectionLookupMap.end();) {
+      if (it->second->Invalid) {
+        it = Entry->SectionLookupMap.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    Entry->InvalidatedSections.store(0);
+#endif
+  }
+
+  void CodeObjectSerializeService::IdleMaintenance() {
+#ifndef _WIN32
+    std::shared_lock lk {EntryMapMutex};
+
+    for (auto &it : AddressToEntryMap) {
+      auto Entry = it.second.get();
+      if (Entry->CurrentSerializedFD == -1) {
+        continue;
+      }
+
+      if (Entry->InvalidatedSections.load()) {
+        // Compaction fsyncs the rewritten file itself
+        CompactRegionFile(Entry);
+      }
+
+      if (Entry->NeedsFsync) {
+        fsync(Entry->CurrentSerializedFD);
+        Entry->NeedsFsync = false;
+      }
+    }
+#endif
   }
 
   void CodeObjectSerializeService::ExecutionThread() {
     // Set our thread name so we can see its relation
     FEXCore::Threads::SetThreadName("ObjectCodeSeri\0");
+
+    // Set once flushed writes owe an fsync, cleared by the idle maintenance pass
+    bool MaintenancePending = false;
+
     while (WorkerThreadShuttingDown.load() != true) {
-      // Wait for work
-      WorkAvailable.Wait();
+      bool Idled = false;
+      if (MaintenancePending || MaintenanceRequested.load()) {
+        // Maintenance is owed, wait with a deadline so it runs once the job
+        // queue has gone quiet instead of after every single write.
+        Idled = !WorkAvailable.WaitFor(IdleMaintenanceDeadline);
+      }
+      else {
+        // Wait for work
+        WorkAvailable.Wait();
+      }
 
       // Handle named region async jobs first. Highest priority
       NamedRegionHandler.HandleNamedRegionObjectJobs();
 
-      // XXX: Handle code serialization jobs second.
+      // Handle code serialization jobs second
+      if (HandleSerializationJobs()) {
+        MaintenancePending = true;
+      }
+
+      if (Idled) {
+        // Clear the request first so invalidations that race with the pass
+        // request another one.
+        MaintenanceRequested.store(false);
+        IdleMaintenance();
+        MaintenancePending = false;
+      }
     }
 
     // Do final code region closures on thread shutdown
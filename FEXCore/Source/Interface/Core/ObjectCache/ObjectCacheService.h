@@ -14,6 +14,8 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <chrono>
+#include <mutex>
 #include <shared_mutex>
 
 namespace FEXCore::CodeSerialize {
@@ -27,8 +29,46 @@ namespace FEXCore::CodeSerialize {
     bool Invalid;
     const CodeSerializationData *Data;
     const char *HostCode;
+    uint64_t HostCodeLength;
+    uint64_t GuestCodeStart;
+    uint64_t GuestCodeLength;
+    uint64_t GuestCodeHash;
     uint64_t NumRelocations;
     const char *Relocations;
+
+    // Compressed payload in the mapped file, null when the record is stored raw.
+    // HostCode and Relocations stay null until the first JIT fetch decompresses
+    // the record in to DecompressedData.
+    const char *CompressedData;
+    uint64_t CompressedLength;
+    fextl::vector<char> DecompressedData;
+  };
+
+  /**
+   * @brief On-disk record for one serialized code object
+   *
+   * Each record is followed directly by HostCodeLength bytes of host code and
+   * then NumRelocations Relocation unions. Records are appended under an OS
+   * file lock; a truncated tail from a crashed writer is skipped on load.
+   */
+  struct FEX_PACKED CodeObjectFileRecord {
+    // Guest RIP of the block, relative to the base the region was mapped at
+    uint64_t GuestRIPOffset{};
+    // Start of the decoded guest code range, relative to the region base
+    uint64_t GuestStartOffset{};
+    uint64_t GuestCodeLength{};
+    uint64_t GuestCodeHash{};
+    uint64_t HostCodeLength{};
+    uint64_t NumRelocations{};
+    // On-disk byte count of the zstd compressed payload, zero when the payload
+    // (host code plus relocations) is stored raw
+    uint64_t CompressedLength{};
+
+    // Bytes the payload occupies on disk after this record
+    uint64_t PayloadSize() const {
+      return CompressedLength ? CompressedLength :
+        HostCodeLength + NumRelocations * sizeof(FEXCore::CPU::Relocation);
+    }
   };
 
   /**
@@ -40,6 +80,9 @@ namespace FEXCore::CodeSerialize {
   struct CodeObjectSerializationHeader {
     // The configuration that this file has
     CodeObjectSerializationConfig Config;
+    // Hash of the ELF GNU build-id of the guest binary this cache belongs to
+    // Zero if the binary didn't carry a build-id, which disables serialization
+    uint64_t BuildIdHash{};
     // The original RIP that this object section was mapped at
     uint64_t OriginalBase{};
     // The original offset in to the file that this object section was loaded from
@@ -80,12 +123,33 @@ namespace FEXCore::CodeSerialize {
     // We should be resiliant to corruption but things happen
     bool StillSerializing {true};
 
+    // Hash of this region's ELF build-id, part of the cache file key
+    uint64_t BuildIdHash{};
+
     // Long lived FD for serialization if we have multiple jobs to serialize
     // Bursts of code entries are common and this reduces file lock overhead
     //
     // Especially useful over network mounts where file locks are very slow
     int CurrentSerializedFD {-1};
 
+    // Serialized records waiting to be appended to the cache file.
+    // Jobs from one queue drain coalesce in here so a burst of code entries
+    // becomes a single locked write. Only touched by the worker thread.
+    fextl::vector<char> PendingWriteData{};
+
+    // Set after the worker flushed data to the cache file, cleared once the
+    // idle maintenance pass has fsync'd it. Only touched by the worker thread.
+    bool NeedsFsync {false};
+
+    // Serializes first-fetch decompression of this region's sections.
+    // Only contended when two JIT threads hit the same cold section at once.
+    std::mutex DecompressLock{};
+
+    // Number of sections the JIT invalidated through hash mismatches.
+    // Written by JIT threads under a shared lock, tells the worker thread that
+    // the cache file carries dead entries worth compacting away.
+    std::atomic<uint64_t> InvalidatedSections{};
+
     /**
      * @name Objects required to sync objects between threads
      * @{ */
@@ -146,7 +210,7 @@ namespace FEXCore::CodeSerialize {
        */
       struct SerializationJobData {
         uint64_t GuestRIP;        ///< The RIP for the guest
-        // XXX: Support multiblock
+        uint64_t GuestCodeStart;  ///< Start of the decoded guest code range, can be below GuestRIP with multiblock
         uint64_t GuestCodeLength; ///< The Guest's code length
         uint64_t GuestCodeHash;   ///< Hash of the guest code
 
@@ -305,8 +369,8 @@ namespace FEXCore::CodeSerialize {
       }
 
     private:
-      // Code version. If the code emission changes then this needs to increment
-      constexpr static uint32_t CODE_VERSION = 0x0;
+      // Code version. If the code emission or file format changes then this needs to increment
+      constexpr static uint32_t CODE_VERSION = 0x1;
 
       // Default cookie header for the file header
       constexpr static uint64_t CODE_COOKIE = FEXCore::IR::COOKIE_VERSION("FEXC", CODE_VERSION);
@@ -433,6 +497,15 @@ namespace FEXCore::CodeSerialize {
       CodeSerializationMutex &GetEntryMapMutex() { return EntryMapMutex; }
       CodeSerializationMutex &GetUnrelocatedEntryMapMutex() { return EntryMapMutex; }
 
+      /**
+       * @brief Adds a code serialization job to the queue for the worker thread
+       */
+      void QueueSerializationJob(fextl::unique_ptr<AsyncJobHandler::SerializationJobData> Data) {
+        std::unique_lock lk {SerializationQueueMutex};
+        SerializationQueue.emplace(std::move(Data));
+        ++SerializationQueueJobs;
+      }
+
       CodeRegionMapType &GetEntryMap() { return AddressToEntryMap; }
       CodeRegionPtrMapType &GetUnrelocatedEntryMap() { return UnrelocatedAddressToEntryMap; }
 
@@ -444,6 +517,47 @@ namespace FEXCore::CodeSerialize {
     private:
       FEXCore::Context::ContextImpl *CTX;
 
+      /**
+       * @brief Drains the code serialization job queue, appending code objects to their region's cache file
+       *
+       * Writes for one region coalesce into a single locked append per drain.
+       *
+       * @return True if any data was flushed and an idle fsync pass is owed
+       */
+      bool HandleSerializationJobs();
+
+      // Serializes one code object into its region's pending write buffer. Runs on the worker thread.
+      void SerializeCodeObject(CodeRegionEntry *Entry, AsyncJobHandler::SerializationJobData *Data);
+
+      // Appends a region's pending write buffer to its cache file under the OS file lock.
+      void FlushPendingWrites(CodeRegionEntry *Entry);
+
+      /**
+       * @brief fsync batching and cache file compaction, runs once the job queue has idled past the deadline
+       *
+       * Dirty cache files get one fsync per idle period instead of one per write.
+       * Regions with sections the JIT has invalidated get their file compacted so
+       * long-lived caches stay dense and cheap to map on cold start.
+       */
+      void IdleMaintenance();
+
+      // Rewrites a region's cache file without the records the JIT invalidated.
+      void CompactRegionFile(CodeRegionEntry *Entry);
+
+      // Flush pending serialized data once the queue has idled for this long
+      constexpr static std::chrono::milliseconds IdleMaintenanceDeadline {100};
+
+      // Flush a region's pending write buffer early once it grows past this
+      constexpr static size_t MaxPendingWriteBytes = 1024 * 1024;
+
+      // Set by JIT threads when section invalidation leaves dead records in a cache file
+      std::atomic_bool MaintenanceRequested {false};
+
+      // Atomic counter for number of serialization jobs without needing the mutex to check
+      std::atomic<uint64_t> SerializationQueueJobs{};
+      std::mutex SerializationQueueMutex{};
+      fextl::queue<fextl::unique_ptr<AsyncJobHandler::SerializationJobData>> SerializationQueue{};
+
       Event WorkAvailable{};
       fextl::unique_ptr<FEXCore::Threads::Thread> WorkerThread;
       std::atomic_bool WorkerThreadShuttingDown {false};
@@ -135,6 +135,9 @@ void OpDispatchBuilder::SyscallOp(OpcodeArgs) {
     Arguments[6],
     DefaultSyscallFlags);
 
+  // arch_prctl and friends change the segment bases behind the IR's back.
+  InvalidateCachedSegmentBases();
+
   if (OSABI != FEXCore::HLE::SyscallOSABI::OS_HANGOVER &&
       (DefaultSyscallFlags & FEXCore::IR::SyscallFlags::NORETURNEDRESULT) != FEXCore::IR::SyscallFlags::NORETURNEDRESULT) {
     // Hangover doesn't want us returning a result here
@@ -182,7 +185,8 @@ void OpDispatchBuilder::ThunkOp(OpcodeArgs) {
   CalculateDeferredFlags();
 
   // Store the new RIP
-  _ExitFunction(NewRIP);
+  // Thunks return like a guest RET, consult the shadow return-address stack
+  _ExitFunction(NewRIP, true);
   BlockSetRIP = true;
 }
 
@@ -244,8 +248,33 @@ void OpDispatchBuilder::RETOp(OpcodeArgs) {
   StoreGPRRegister(X86State::REG_RSP, NewSP);
   CalculateDeferredFlags();
 
+  if (Multiblock && PredictedReturnTargets) {
+    // This RET belongs to an inlined leaf with a single known call site.
+    // Guard the popped RIP against the predicted return address so a matching
+    // return stays inside the region, anything else exits through the dispatcher
+    auto Predicted = PredictedReturnTargets->find(Op->PC);
+    if (Predicted != PredictedReturnTargets->end() && Predicted->second != 0) {
+      auto ReturnBlock = JumpTargets.find(Predicted->second);
+      if (ReturnBlock != JumpTargets.end()) {
+        auto ExpectedRIP = GetRelocatedPC(Op, Predicted->second - (Op->PC + Op->InstSize));
+        auto CondJump_ = CondJump(NewRIP, ExpectedRIP, InvalidNode, InvalidNode, {COND_EQ}, GPRSize);
+        SetTrueJumpTarget(CondJump_, ReturnBlock->second.BlockEntry);
+
+        auto MispredictBlock = CreateNewCodeBlockAtEnd();
+        SetFalseJumpTarget(CondJump_, MispredictBlock);
+        SetCurrentCodeBlock(MispredictBlock);
+        StartNewBlock();
+
+        _ExitFunction(NewRIP, true);
+        BlockSetRIP = true;
+        return;
+      }
+    }
+  }
+
   // Store the new RIP
-  _ExitFunction(NewRIP);
+  // Returns consult the shadow return-address stack pushed by CALL
+  _ExitFunction(NewRIP, true);
   BlockSetRIP = true;
 }
 
@@ -323,116 +352,6 @@ void OpDispatchBuilder::CallbackReturnOp(OpcodeArgs) {
   BlockSetRIP = true;
 }
 
-void OpDispatchBuilder::SecondaryALUOp(OpcodeArgs) {
-  FEXCore::IR::IROps IROp;
-#define OPD(group, prefix, Reg) (((group - FEXCore::X86Tables::TYPE_GROUP_1) << 6) | (prefix) << 3 | (Reg))
-  switch (Op->OP) {
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 0):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 0):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 0):
-    IROp = FEXCore::IR::IROps::OP_ADD;
-  break;
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 1):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 1):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 1):
-    IROp = FEXCore::IR::IROps::OP_OR;
-  break;
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 4):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 4):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 4):
-    IROp = FEXCore::IR::IROps::OP_AND;
-  break;
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 5):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 5):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 5):
-    IROp = FEXCore::IR::IROps::OP_SUB;
-  break;
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 6):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 6):
-  case OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 6):
-    IROp = FEXCore::IR::IROps::OP_XOR;
-  break;
-  default:
-    IROp = FEXCore::IR::IROps::OP_LAST;
-    LOGMAN_MSG_A_FMT("Unknown ALU Op: 0x{:x}", Op->OP);
-  break;
-  };
-#undef OPD
-  // Logical ops can tolerate garbage in the upper bits, so don't mask.
-  bool AllowUpperGarbage = IROp == FEXCore::IR::IROps::OP_AND ||
-                           IROp == FEXCore::IR::IROps::OP_XOR ||
-                           IROp == FEXCore::IR::IROps::OP_OR;
-
-  // X86 basic ALU ops just do the operation between the destination and a single source
-  uint8_t Size = GetDstSize(Op);
-  auto Src = LoadSource(GPRClass, Op, Op->Src[1], Op->Flags, {.AllowUpperGarbage = AllowUpperGarbage || Size >= 4});
-  OrderedNode *Result{};
-  OrderedNode *Dest{};
-
-  if (DestIsLockedMem(Op)) {
-    HandledLock = true;
-    auto DestMem = LoadSource(GPRClass, Op, Op->Dest, Op->Flags, {.LoadData = false});
-    DestMem = AppendSegmentOffset(DestMem, Op->Flags);
-    switch (IROp) {
-      case FEXCore::IR::IROps::OP_ADD: {
-        Dest = _AtomicFetchAdd(IR::SizeToOpSize(Size), Src, DestMem);
-        Result = _Add(IR::SizeToOpSize(std::max<uint8_t>(4u, std::max(GetOpSize(Dest), GetOpSize(Src)))), Dest, Src);
-        break;
-      }
-      case FEXCore::IR::IROps::OP_SUB: {
-        Dest = _AtomicFetchSub(IR::SizeToOpSize(Size), Src, DestMem);
-        Result = _Sub(IR::SizeToOpSize(std::max<uint8_t>(4u, std::max(GetOpSize(Dest), GetOpSize(Src)))), Dest, Src);
-        break;
-      }
-      case FEXCore::IR::IROps::OP_OR: {
-        Dest = _AtomicFetchOr(IR::SizeToOpSize(Size), Src, DestMem);
-        Result = _Or(IR::SizeToOpSize(std::max<uint8_t>(4u, std::max(GetOpSize(Dest), GetOpSize(Src)))), Dest, Src);
-        break;
-      }
-      case FEXCore::IR::IROps::OP_AND: {
-        Dest = _AtomicFetchAnd(IR::SizeToOpSize(Size), Src, DestMem);
-        Result = _And(IR::SizeToOpSize(std::max<uint8_t>(4u, std::max(GetOpSize(Dest), GetOpSize(Src)))), Dest, Src);
-        break;
-      }
-      case FEXCore::IR::IROps::OP_XOR: {
-        Dest = _AtomicFetchXor(IR::SizeToOpSize(Size), Src, DestMem);
-        Result = _Xor(IR::SizeToOpSize(std::max<uint8_t>(4u, std::max(GetOpSize(Dest), GetOpSize(Src)))), Dest, Src);
-        break;
-      }
-      default:
-        LOGMAN_MSG_A_FMT("Unknown Atomic IR Op: {}", ToUnderlying(IROp));
-        break;
-    }
-  }
-  else {
-    Dest = LoadSource(GPRClass, Op, Op->Dest, Op->Flags, {.AllowUpperGarbage = AllowUpperGarbage || Size >= 4});
-    DeriveOp(ALUOp, IROp, _Add(IR::SizeToOpSize(std::max<uint8_t>(4u, Size)), Dest, Src));
-
-    Result = ALUOp;
-
-    StoreResult(GPRClass, Op, Result, -1);
-  }
-
-  // Flags set
-  {
-    switch (IROp) {
-    case FEXCore::IR::IROps::OP_ADD:
-      GenerateFlags_ADD(Op, Result, Dest, Src);
-    break;
-    case FEXCore::IR::IROps::OP_SUB:
-      GenerateFlags_SUB(Op, Result, Dest, Src);
-    break;
-    case FEXCore::IR::IROps::OP_AND:
-    case FEXCore::IR::IROps::OP_XOR:
-    case FEXCore::IR::IROps::OP_OR: {
-      GenerateFlags_Logical(Op, Result, Dest, Src);
-    break;
-    }
-    default: break;
-    }
-  }
-}
-
 template<uint32_t SrcIndex>
 void OpDispatchBuilder::ADCOp(OpcodeArgs) {
   // Calculate flags early.
@@ -442,6 +361,16 @@ void OpDispatchBuilder::ADCOp(OpcodeArgs) {
   uint8_t Size = GetDstSize(Op);
   const auto OpSize = IR::SizeToOpSize(std::max<uint8_t>(4u, Size));
 
+  if (Size >= 4 && !DestIsLockedMem(Op)) {
+    // The deferred-flag calculation above left guest CF in the host carry, so
+    // the whole add consumes and produces host flags directly. Keeps adc
+    // chains in bignum code from round-tripping CF through a register.
+    OrderedNode *Before = LoadSource(GPRClass, Op, Op->Dest, Op->Flags);
+    OrderedNode *Result = CalculateADCWithNZCV(Size, Before, Src);
+    StoreResult(GPRClass, Op, Result, -1);
+    return;
+  }
+
   auto CF = GetRFLAG(FEXCore::X86State::RFLAG_CF_RAW_LOC);
   auto ALUOp = _Add(OpSize, Src, CF);
 
@@ -474,6 +403,15 @@ void OpDispatchBuilder::SBBOp(OpcodeArgs) {
   auto Size = GetDstSize(Op);
   const auto OpSize = IR::SizeToOpSize(std::max<uint8_t>(4u, Size));
 
+  if (SetFlags && Size >= 4 && !DestIsLockedMem(Op)) {
+    // Same host-flag-resident path as ADCOp, with the carry rectified to the
+    // arm64 borrow convention around the flag-setting subtract.
+    OrderedNode *Before = LoadSource(GPRClass, Op, Op->Dest, Op->Flags);
+    OrderedNode *Result = CalculateSBBWithNZCV(Size, Before, Src);
+    StoreResult(GPRClass, Op, Result, -1);
+    return;
+  }
+
   auto CF = GetRFLAG(FEXCore::X86State::RFLAG_CF_RAW_LOC);
   auto ALUOp = _Add(OpSize, Src, CF);
 
@@ -798,6 +736,20 @@ void OpDispatchBuilder::CALLOp(OpcodeArgs) {
 
   CalculateDeferredFlags();
   if (NextRIP != TargetRIP) {
+    if (Multiblock && InlinedCallSites && InlinedCallSites->contains(Op->PC)) {
+      // The frontend proved the callee is a leaf and pulled it in to this region.
+      // The return address push above stays architectural, control just stays
+      // in-region instead of bouncing through the dispatcher
+      auto TargetBlock = JumpTargets.find(TargetRIP);
+      if (TargetBlock != JumpTargets.end()) {
+        Jump(TargetBlock->second.BlockEntry);
+        return;
+      }
+    }
+
+    // Push the return address on to the shadow stack for the matching RET
+    _PushReturnPrediction(ConstantPC);
+
     // Store the RIP
     _ExitFunction(NewRIP); // If we get here then leave the function now
   }
@@ -826,6 +778,10 @@ void OpDispatchBuilder::CALLAbsoluteOp(OpcodeArgs) {
 
   // Store the RIP
   CalculateDeferredFlags();
+
+  // Push the return address on to the shadow stack for the matching RET
+  _PushReturnPrediction(ConstantPCReturn);
+
   _ExitFunction(JMPPCOffset); // If we get here then leave the function now
 }
 
@@ -3450,6 +3406,8 @@ void OpDispatchBuilder::WriteSegmentReg(OpcodeArgs) {
   else {
     _StoreContext(Size, GPRClass, Src, offsetof(FEXCore::Core::CPUState, gs_cached));
   }
+
+  InvalidateCachedSegmentBases();
 }
 
 void OpDispatchBuilder::EnterOp(OpcodeArgs) {
@@ -3550,7 +3508,12 @@ void OpDispatchBuilder::INCOp(OpcodeArgs) {
     StoreResult(GPRClass, Op, Result, -1);
   }
 
-  GenerateFlags_ADD(Op, Result, Dest, OneConst, false);
+  // INC only writes OF/SF/ZF/AF/PF; when those are all dead this also skips
+  // the forced materialization that preserving CF would otherwise require.
+  constexpr auto WrittenFlags = X86Tables::StatusFlags::ALL & ~X86Tables::StatusFlags::CF;
+  if ((Op->DeadStatusFlags & WrittenFlags) != WrittenFlags) {
+    GenerateFlags_ADD(Op, Result, Dest, OneConst, false);
+  }
 }
 
 void OpDispatchBuilder::DECOp(OpcodeArgs) {
@@ -3581,7 +3544,11 @@ void OpDispatchBuilder::DECOp(OpcodeArgs) {
     StoreResult(GPRClass, Op, Result, -1);
   }
 
-  GenerateFlags_SUB(Op, Result, Dest, OneConst, false);
+  // Same liveness shortcut as INCOp above, DEC leaves CF untouched too.
+  constexpr auto WrittenFlags = X86Tables::StatusFlags::ALL & ~X86Tables::StatusFlags::CF;
+  if ((Op->DeadStatusFlags & WrittenFlags) != WrittenFlags) {
+    GenerateFlags_SUB(Op, Result, Dest, OneConst, false);
+  }
 }
 
 void OpDispatchBuilder::STOSOp(OpcodeArgs) {
@@ -4433,7 +4400,7 @@ void OpDispatchBuilder::CMPXCHGPairOp(OpcodeArgs) {
   StartNewBlock();
 }
 
-void OpDispatchBuilder::CreateJumpBlocks(fextl::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *Blocks) {
+void OpDispatchBuilder::CreateJumpBlocks(FEXCore::Frontend::Decoder::DecodedBlockVector const *Blocks) {
   OrderedNode *PrevCodeBlock{};
   for (auto &Target : *Blocks) {
     auto CodeNode = CreateCodeNode();
@@ -4448,7 +4415,7 @@ void OpDispatchBuilder::CreateJumpBlocks(fextl::vector<FEXCore::Frontend::Decode
   }
 }
 
-void OpDispatchBuilder::BeginFunction(uint64_t RIP, fextl::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *Blocks, uint32_t NumInstructions) {
+void OpDispatchBuilder::BeginFunction(uint64_t RIP, FEXCore::Frontend::Decoder::DecodedBlockVector const *Blocks, uint32_t NumInstructions) {
   Entry = RIP;
   auto IRHeader = _IRHeader(InvalidNode, RIP, 0, NumInstructions);
   CreateJumpBlocks(Blocks);
@@ -4508,11 +4475,19 @@ OrderedNode *OpDispatchBuilder::GetSegment(uint32_t Flags, uint32_t DefaultPrefi
   const uint8_t GPRSize = CTX->GetGPRSize();
 
   if (CTX->Config.Is64BitMode) {
+    // TLS-heavy code hits the same base once per memory access; reuse the
+    // load for the rest of the block instead of emitting one per access.
     if (Flags & FEXCore::X86Tables::DecodeFlags::FLAG_FS_PREFIX) {
-      return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, fs_cached));
+      if (!CachedFSBase) {
+        CachedFSBase = _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, fs_cached));
+      }
+      return CachedFSBase;
     }
     else if (Flags & FEXCore::X86Tables::DecodeFlags::FLAG_GS_PREFIX) {
-      return _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, gs_cached));
+      if (!CachedGSBase) {
+        CachedGSBase = _LoadContext(GPRSize, GPRClass, offsetof(FEXCore::Core::CPUState, gs_cached));
+      }
+      return CachedGSBase;
     }
     // If there was any other segment in 64bit then it is ignored
   }
@@ -4675,6 +4650,54 @@ void OpDispatchBuilder::UpdatePrefixFromSegment(OrderedNode *Segment, uint32_t S
       break;
     default: break; // Do nothing
   }
+
+  InvalidateCachedSegmentBases();
+}
+
+void OpDispatchBuilder::InstrumentWatchpointCheck(X86Tables::DecodedOp const& Op, OrderedNode *Address, uint8_t AccessSize, bool IsStore) {
+  // Guards a guest memory access with the debugger's active watchpoints.
+  // Follows the INTO idiom of conditionally breaking out mid-instruction,
+  // reporting the hit like a hardware debug register would
+  const uint8_t GPRSize = CTX->GetGPRSize();
+
+  for (auto &Watchpoint : CTX->GuestWatchpoints) {
+    if (!Watchpoint.Enabled) {
+      continue;
+    }
+
+    if (!IsStore && Watchpoint.Type == FEXCore::Context::WatchpointType::WRITE) {
+      continue;
+    }
+
+    // The access [Address, Address + AccessSize) overlaps the watched range when
+    // Address - (WatchBegin - (AccessSize - 1)) < WatchSize + AccessSize - 1 unsigned
+    uint64_t WatchBegin = Watchpoint.Address - (AccessSize - 1);
+    if (GPRSize == 4) {
+      WatchBegin &= 0xFFFFFFFFU;
+    }
+
+    auto Distance = _Sub(IR::SizeToOpSize(GPRSize), Address, _Constant(GPRSize * 8, WatchBegin));
+    auto CondJump_ = CondJump(Distance, _Constant(GPRSize * 8, Watchpoint.Size + AccessSize - 1), InvalidNode, InvalidNode, {COND_ULT}, GPRSize);
+
+    auto HitBlock = CreateNewCodeBlockAfter(GetCurrentBlock());
+    SetTrueJumpTarget(CondJump_, HitBlock);
+    SetCurrentCodeBlock(HitBlock);
+    StartNewBlock();
+
+    auto NewRIP = GetRelocatedPC(Op, -Op->InstSize);
+    _StoreContext(GPRSize, GPRClass, NewRIP, offsetof(FEXCore::Core::CPUState, rip));
+    _Break(FEXCore::IR::BreakDefinition {
+      .ErrorRegister = 0,
+      .Signal = Core::FAULT_SIGTRAP,
+      .TrapNumber = X86State::X86_TRAPNO_DB,
+      .si_code = 4, // TRAP_HWBKPT
+    });
+
+    auto ContinueBlock = CreateNewCodeBlockAfter(HitBlock);
+    SetFalseJumpTarget(CondJump_, ContinueBlock);
+    SetCurrentCodeBlock(ContinueBlock);
+    StartNewBlock();
+  }
 }
 
 OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(RegisterClassType Class, X86Tables::DecodedOp const& Op, X86Tables::DecodedOperand const& Operand,
@@ -4732,7 +4755,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(RegisterClassType Class, X
     Src = LoadGPRRegister(Operand.Data.GPR.GPR, GPRSize);
 
     LoadableType = true;
-    if (Operand.Data.GPR.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::DEFAULT) {
+    if (AddressRegIsThreadPrivate(Operand.Data.GPR.GPR) && AccessType == MemoryAccessType::DEFAULT) {
       AccessType = MemoryAccessType::NONTSO;
     }
   }
@@ -4744,7 +4767,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(RegisterClassType Class, X
     Src = _Add(IR::SizeToOpSize(GPRSize), GPR, Constant);
 
     LoadableType = true;
-    if (Operand.Data.GPRIndirect.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::DEFAULT) {
+    if (AddressRegIsThreadPrivate(Operand.Data.GPRIndirect.GPR) && AccessType == MemoryAccessType::DEFAULT) {
       AccessType = MemoryAccessType::NONTSO;
     }
   }
@@ -4785,7 +4808,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(RegisterClassType Class, X
           auto Constant = _Constant(GPRSize * 8, Operand.Data.SIB.Scale);
           Tmp = _Mul(IR::SizeToOpSize(GPRSize), Tmp, Constant);
         }
-        if (Operand.Data.SIB.Index == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::DEFAULT) {
+        if (AddressRegIsThreadPrivate(Operand.Data.SIB.Index) && AccessType == MemoryAccessType::DEFAULT) {
           AccessType = MemoryAccessType::NONTSO;
         }
       }
@@ -4800,7 +4823,7 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(RegisterClassType Class, X
           Tmp = GPR;
         }
 
-        if (Operand.Data.SIB.Base == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::DEFAULT) {
+        if (AddressRegIsThreadPrivate(Operand.Data.SIB.Base) && AccessType == MemoryAccessType::DEFAULT) {
           AccessType = MemoryAccessType::NONTSO;
         }
       }
@@ -4840,6 +4863,10 @@ OrderedNode *OpDispatchBuilder::LoadSource_WithOpSize(RegisterClassType Class, X
   if ((LoadableType && LoadData) || ForceLoad) {
     Src = AppendSegmentOffset(Src, Flags);
 
+    if (CTX->ActiveGuestWatchpoints.load(std::memory_order_relaxed)) {
+      InstrumentWatchpointCheck(Op, Src, OpSize, false);
+    }
+
     if (AccessType == MemoryAccessType::NONTSO || AccessType == MemoryAccessType::STREAM) {
       Src = _LoadMem(Class, OpSize, Src, Align == -1 ? OpSize : Align);
     }
@@ -4990,7 +5017,7 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
     MemStoreDst = LoadGPRRegister(Operand.Data.GPR.GPR, GPRSize);
 
     MemStore = true;
-    if (Operand.Data.GPR.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::DEFAULT) {
+    if (AddressRegIsThreadPrivate(Operand.Data.GPR.GPR) && AccessType == MemoryAccessType::DEFAULT) {
       AccessType = MemoryAccessType::NONTSO;
     }
   }
@@ -5000,7 +5027,7 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
 
     MemStoreDst = _Add(IR::SizeToOpSize(GPRSize), GPR, Constant);
     MemStore = true;
-    if (Operand.Data.GPRIndirect.GPR == FEXCore::X86State::REG_RSP && AccessType == MemoryAccessType::DEFAULT) {
+    if (AddressRegIsThreadPrivate(Operand.Data.GPRIndirect.GPR) && AccessType == MemoryAccessType::DEFAULT) {
       AccessType = MemoryAccessType::NONTSO;
     }
   }
@@ -5030,6 +5057,9 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
           auto Constant = _Constant(GPRSize * 8, Operand.Data.SIB.Scale);
           Tmp = _Mul(IR::SizeToOpSize(GPRSize), Tmp, Constant);
         }
+        if (AddressRegIsThreadPrivate(Operand.Data.SIB.Index) && AccessType == MemoryAccessType::DEFAULT) {
+          AccessType = MemoryAccessType::NONTSO;
+        }
       }
 
       if (Operand.Data.SIB.Base != FEXCore::X86State::REG_INVALID) {
@@ -5041,6 +5071,10 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
         else {
           Tmp = GPR;
         }
+
+        if (AddressRegIsThreadPrivate(Operand.Data.SIB.Base) && AccessType == MemoryAccessType::DEFAULT) {
+          AccessType = MemoryAccessType::NONTSO;
+        }
       }
     }
 
@@ -5073,6 +5107,10 @@ void OpDispatchBuilder::StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Cl
   if (MemStore) {
     MemStoreDst = AppendSegmentOffset(MemStoreDst, Op->Flags);
 
+    if (CTX->ActiveGuestWatchpoints.load(std::memory_order_relaxed)) {
+      InstrumentWatchpointCheck(Op, MemStoreDst, OpSize, true);
+    }
+
     if (OpSize == 10) {
       // For X87 extended doubles, split before storing
       _StoreMem(FPRClass, 8, MemStoreDst, Src, Align);
@@ -5133,17 +5171,18 @@ void OpDispatchBuilder::MOVGPRNTOp(OpcodeArgs) {
   StoreResult(GPRClass, Op, Src, 1, MemoryAccessType::STREAM);
 }
 
-void OpDispatchBuilder::ALUOpImpl(OpcodeArgs, FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp) {
+template<FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp, uint32_t SrcIndex>
+void OpDispatchBuilder::ALUOpImpl(OpcodeArgs) {
   auto Size = GetDstSize(Op);
   const auto OpSize = Size == 8 ? OpSize::i64Bit : OpSize::i32Bit;
 
   // Logical ops can tolerate garbage in the upper bits, so don't mask.
-  bool AllowUpperGarbage = ALUIROp == FEXCore::IR::IROps::OP_AND ||
-                           ALUIROp == FEXCore::IR::IROps::OP_XOR ||
-                           ALUIROp == FEXCore::IR::IROps::OP_OR;
+  constexpr bool AllowUpperGarbage = ALUIROp == FEXCore::IR::IROps::OP_AND ||
+                                     ALUIROp == FEXCore::IR::IROps::OP_XOR ||
+                                     ALUIROp == FEXCore::IR::IROps::OP_OR;
 
   // X86 basic ALU ops just do the operation between the destination and a single source
-  OrderedNode *Src = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags,
+  OrderedNode *Src = LoadSource(GPRClass, Op, Op->Src[SrcIndex], Op->Flags,
                                 {.AllowUpperGarbage = AllowUpperGarbage || Size >= 4});
 
   OrderedNode *Result{};
@@ -5170,10 +5209,13 @@ void OpDispatchBuilder::ALUOpImpl(OpcodeArgs, FEXCore::IR::IROps ALUIROp, FEXCor
      * arm64, "mov x0, #0" is faster than "eor x0, x0, x0". Additionally this
      * lets more constant folding kick in for flags.
      */
-    if (ALUIROp == FEXCore::IR::IROps::OP_XOR &&
-        Op->Dest.IsGPR() && Op->Src[0].IsGPR() &&
-        Op->Dest.Data.GPR == Op->Src[0].Data.GPR) {
+    bool IsSelfZeroingXor = false;
+    if constexpr (ALUIROp == FEXCore::IR::IROps::OP_XOR) {
+      IsSelfZeroingXor = Op->Dest.IsGPR() && Op->Src[SrcIndex].IsGPR() &&
+                         Op->Dest.Data.GPR == Op->Src[SrcIndex].Data.GPR;
+    }
 
+    if (IsSelfZeroingXor) {
         Result = _Constant(0);
     } else {
         DeriveOp(ALUOp, ALUIROp, _Add(OpSize, Dest, Src));
@@ -5183,31 +5225,51 @@ void OpDispatchBuilder::ALUOpImpl(OpcodeArgs, FEXCore::IR::IROps ALUIROp, FEXCor
     StoreResult(GPRClass, Op, Result, -1);
   }
 
+  // The decoder proved every status flag is overwritten before any read, so
+  // there's nothing to generate. The deferred record from a prior op may still
+  // materialize into these dead slots later, which is harmless - the proven
+  // overwriter regenerates them all.
+  if ((Op->DeadStatusFlags & X86Tables::StatusFlags::ALL) == X86Tables::StatusFlags::ALL) {
+    return;
+  }
+
   // Flags set
-  {
-    switch (ALUIROp) {
-    case FEXCore::IR::IROps::OP_ADD:
-      GenerateFlags_ADD(Op, Result, Dest, Src);
-    break;
-    case FEXCore::IR::IROps::OP_SUB:
-      GenerateFlags_SUB(Op, Result, Dest, Src);
-    break;
-    case FEXCore::IR::IROps::OP_AND:
-    case FEXCore::IR::IROps::OP_XOR:
-    case FEXCore::IR::IROps::OP_OR: {
-      GenerateFlags_Logical(Op, Result, Dest, Src);
-    break;
-    }
-    default: break;
-    }
+  if constexpr (ALUIROp == FEXCore::IR::IROps::OP_ADD) {
+    GenerateFlags_ADD(Op, Result, Dest, Src);
+  }
+  else if constexpr (ALUIROp == FEXCore::IR::IROps::OP_SUB) {
+    GenerateFlags_SUB(Op, Result, Dest, Src);
+  }
+  else if constexpr (ALUIROp == FEXCore::IR::IROps::OP_AND ||
+                     ALUIROp == FEXCore::IR::IROps::OP_XOR ||
+                     ALUIROp == FEXCore::IR::IROps::OP_OR) {
+    GenerateFlags_Logical(Op, Result, Dest, Src);
   }
 }
 
 template<FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp>
 void OpDispatchBuilder::ALUOp(OpcodeArgs) {
-  ALUOpImpl(Op, ALUIROp, AtomicFetchOp);
+  ALUOpImpl<ALUIROp, AtomicFetchOp, 0>(Op);
 }
 
+template<FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp>
+void OpDispatchBuilder::SecondaryALUOp(OpcodeArgs) {
+  // Group 1 immediate forms share the ALU lowering, with the immediate in Src[1].
+  // The IR op is selected per table slot so no decoding of Op->OP is necessary here.
+  ALUOpImpl<ALUIROp, AtomicFetchOp, 1>(Op);
+}
+
+template
+void OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_ADD, FEXCore::IR::IROps::OP_ATOMICFETCHADD>(OpcodeArgs);
+template
+void OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_OR, FEXCore::IR::IROps::OP_ATOMICFETCHOR>(OpcodeArgs);
+template
+void OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_AND, FEXCore::IR::IROps::OP_ATOMICFETCHAND>(OpcodeArgs);
+template
+void OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_SUB, FEXCore::IR::IROps::OP_ATOMICFETCHSUB>(OpcodeArgs);
+template
+void OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_XOR, FEXCore::IR::IROps::OP_ATOMICFETCHXOR>(OpcodeArgs);
+
 void OpDispatchBuilder::INTOp(OpcodeArgs) {
   IR::BreakDefinition Reason;
   bool SetRIPToNext = false;
@@ -5816,6 +5878,8 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
     {OPD(2, 0b01, 0x0E), 1, &OpDispatchBuilder::VTESTPOp<4>},
     {OPD(2, 0b01, 0x0F), 1, &OpDispatchBuilder::VTESTPOp<8>},
 
+    {OPD(2, 0b01, 0x13), 1, &OpDispatchBuilder::VCVTPH2PSOp},
+
     {OPD(2, 0b01, 0x16), 1, &OpDispatchBuilder::VPERMDOp},
     {OPD(2, 0b01, 0x17), 1, &OpDispatchBuilder::PTestOp},
     {OPD(2, 0b01, 0x18), 1, &OpDispatchBuilder::VBROADCASTOp<4>},
@@ -5903,6 +5967,7 @@ void OpDispatchBuilder::InstallHostSpecificOpcodeHandlers() {
 
     {OPD(3, 0b01, 0x18), 1, &OpDispatchBuilder::VINSERTOp},
     {OPD(3, 0b01, 0x19), 1, &OpDispatchBuilder::VEXTRACT128Op},
+    {OPD(3, 0b01, 0x1D), 1, &OpDispatchBuilder::VCVTPS2PHOp},
     {OPD(3, 0b01, 0x20), 1, &OpDispatchBuilder::VPINSRBOp},
     {OPD(3, 0b01, 0x21), 1, &OpDispatchBuilder::VINSERTPSOp},
     {OPD(3, 0b01, 0x22), 1, &OpDispatchBuilder::VPINSRDQOp},
@@ -6241,31 +6306,31 @@ void InstallOpcodeHandlers(Context::OperatingMode Mode) {
 #define OPD(group, prefix, Reg) (((group - FEXCore::X86Tables::TYPE_GROUP_1) << 6) | (prefix) << 3 | (Reg))
   constexpr std::tuple<uint16_t, uint8_t, FEXCore::X86Tables::OpDispatchPtr> PrimaryGroupOpTable[] = {
     // GROUP 1
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 0), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 1), 1, &OpDispatchBuilder::SecondaryALUOp},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 0), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_ADD, FEXCore::IR::IROps::OP_ATOMICFETCHADD>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 1), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_OR, FEXCore::IR::IROps::OP_ATOMICFETCHOR>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 2), 1, &OpDispatchBuilder::ADCOp<1>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 3), 1, &OpDispatchBuilder::SBBOp<1, true>},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 4), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 5), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 6), 1, &OpDispatchBuilder::SecondaryALUOp},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 4), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_AND, FEXCore::IR::IROps::OP_ATOMICFETCHAND>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 5), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_SUB, FEXCore::IR::IROps::OP_ATOMICFETCHSUB>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 6), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_XOR, FEXCore::IR::IROps::OP_ATOMICFETCHXOR>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x80), 7), 1, &OpDispatchBuilder::CMPOp<1>}, // CMP
 
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 0), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 1), 1, &OpDispatchBuilder::SecondaryALUOp},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 0), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_ADD, FEXCore::IR::IROps::OP_ATOMICFETCHADD>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 1), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_OR, FEXCore::IR::IROps::OP_ATOMICFETCHOR>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 2), 1, &OpDispatchBuilder::ADCOp<1>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 3), 1, &OpDispatchBuilder::SBBOp<1, true>},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 4), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 5), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 6), 1, &OpDispatchBuilder::SecondaryALUOp},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 4), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_AND, FEXCore::IR::IROps::OP_ATOMICFETCHAND>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 5), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_SUB, FEXCore::IR::IROps::OP_ATOMICFETCHSUB>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 6), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_XOR, FEXCore::IR::IROps::OP_ATOMICFETCHXOR>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x81), 7), 1, &OpDispatchBuilder::CMPOp<1>},
 
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 0), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 1), 1, &OpDispatchBuilder::SecondaryALUOp},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 0), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_ADD, FEXCore::IR::IROps::OP_ATOMICFETCHADD>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 1), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_OR, FEXCore::IR::IROps::OP_ATOMICFETCHOR>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 2), 1, &OpDispatchBuilder::ADCOp<1>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 3), 1, &OpDispatchBuilder::SBBOp<1, true>},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 4), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 5), 1, &OpDispatchBuilder::SecondaryALUOp},
-    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 6), 1, &OpDispatchBuilder::SecondaryALUOp},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 4), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_AND, FEXCore::IR::IROps::OP_ATOMICFETCHAND>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 5), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_SUB, FEXCore::IR::IROps::OP_ATOMICFETCHSUB>},
+    {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 6), 1, &OpDispatchBuilder::SecondaryALUOp<FEXCore::IR::IROps::OP_XOR, FEXCore::IR::IROps::OP_ATOMICFETCHXOR>},
     {OPD(FEXCore::X86Tables::TYPE_GROUP_1, OpToIndex(0x83), 7), 1, &OpDispatchBuilder::CMPOp<1>},
 
     // GROUP 2
@@ -15,6 +15,7 @@
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/vector.h>
 
 #include <cstdint>
@@ -126,19 +127,45 @@ public:
     SetCurrentCodeBlock(it->second.BlockEntry);
   }
 
+  // Stores a pending x87 TOP update back to the context. Must happen before
+  // any point where TOP could be observed from guest state, mirroring the
+  // NZCV handling in CalculateDeferredFlags.
+  void FlushX87Top() {
+    if (X87TopDirty) {
+      _StoreContext(1, GPRClass, CachedX87Top, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+      X87TopDirty = false;
+    }
+  }
+
   void StartNewBlock() {
     // If we loaded flags but didn't change them, invalidate the cached copy and move on.
     // Changes get stored out by CalculateDeferredFlags.
     CachedNZCV = nullptr;
     PossiblySetNZCVBits = ~0U;
 
+    // Same for the cached TOP of the x87 stack. CalculateDeferredFlags stored
+    // any change before the branch here, flush is only a safety net.
+    FlushX87Top();
+    CachedX87Top = nullptr;
+
     // New block needs to reset segment telemetry.
     SegmentsNeedReadCheck = ~0U;
 
+    // Segment base loads from the previous block may not dominate this one.
+    InvalidateCachedSegmentBases();
+
     // Need to clear any named constants that were cached.
     ClearCachedNamedConstants();
   }
 
+  // Shadows the IREmitter method. Handlers that weave their own control flow
+  // switch blocks without passing through StartNewBlock, and a segment base
+  // cached on one path may not dominate the new block.
+  void SetCurrentCodeBlock(OrderedNode *Node) {
+    InvalidateCachedSegmentBases();
+    IREmitter::SetCurrentCodeBlock(Node);
+  }
+
   IRPair<IROp_Jump> Jump() {
     CalculateDeferredFlags();
     return _Jump();
@@ -246,7 +273,7 @@ public:
   void SetDumpIR(bool DumpIR) { ShouldDump = DumpIR; }
   bool ShouldDumpIR() const { return ShouldDump; }
 
-  void BeginFunction(uint64_t RIP, fextl::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *Blocks, uint32_t NumInstructions);
+  void BeginFunction(uint64_t RIP, FEXCore::Frontend::Decoder::DecodedBlockVector const *Blocks, uint32_t NumInstructions);
   void Finalize();
 
   // Dispatch builder functions
@@ -268,6 +295,7 @@ public:
   void RETOp(OpcodeArgs);
   void IRETOp(OpcodeArgs);
   void CallbackReturnOp(OpcodeArgs);
+  template<FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp>
   void SecondaryALUOp(OpcodeArgs);
   template<uint32_t SrcIndex>
   void ADCOp(OpcodeArgs);
@@ -514,6 +542,9 @@ public:
   template<size_t DstElementSize, size_t SrcElementSize>
   void AVXVector_CVT_Float_To_Float(OpcodeArgs);
 
+  void VCVTPH2PSOp(OpcodeArgs);
+  void VCVTPS2PHOp(OpcodeArgs);
+
   void InsertMMX_To_XMM_Vector_CVT_Int_To_Float(OpcodeArgs);
   template<size_t DstElementSize>
   void InsertCVTGPR_To_FPR(OpcodeArgs);
@@ -912,6 +943,10 @@ public:
   OrderedNode *GetPackedRFLAG(uint32_t FlagsMask = ~0U);
 
   void SetMultiblock(bool _Multiblock) { Multiblock = _Multiblock; }
+  void SetLeafCallInlineInfo(const fextl::set<uint64_t> *CallSites, const fextl::map<uint64_t, uint64_t> *ReturnTargets) {
+    InlinedCallSites = CallSites;
+    PredictedReturnTargets = ReturnTargets;
+  }
 
   static inline constexpr unsigned IndexNZCV(unsigned BitOffset) {
     switch (BitOffset) {
@@ -988,6 +1023,23 @@ private:
   bool NZCVDirty{};
   uint32_t PossiblySetNZCVBits{};
 
+  // Cached copy of the x87 TOP of stack, so runs of x87 ops pass TOP along as
+  // an SSA value instead of doing a context round-trip per instruction.
+  OrderedNode* CachedX87Top{};
+  bool X87TopDirty{};
+
+  // Cached 64-bit FS/GS segment bases, so runs of TLS accesses share one
+  // context load instead of paying one per access. The bases only change at
+  // segment writes and syscalls, which drop the cache; block boundaries drop
+  // it too since the load must dominate every reuse.
+  OrderedNode* CachedFSBase{};
+  OrderedNode* CachedGSBase{};
+
+  void InvalidateCachedSegmentBases() {
+    CachedFSBase = nullptr;
+    CachedGSBase = nullptr;
+  }
+
   fextl::map<uint64_t, JumpTargetInfo> JumpTargets;
   bool HandledLock{false};
   bool DecodeFailure{false};
@@ -995,7 +1047,8 @@ private:
   // Used during new op bringup
   bool ShouldDump{false};
 
-  void ALUOpImpl(OpcodeArgs, FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp);
+  template<FEXCore::IR::IROps ALUIROp, FEXCore::IR::IROps AtomicFetchOp, uint32_t SrcIndex>
+  void ALUOpImpl(OpcodeArgs);
 
   // Opcode helpers for generalizing behavior across VEX and non-VEX variants.
 
@@ -1214,6 +1267,8 @@ private:
 
   OrderedNode *GetRelocatedPC(FEXCore::X86Tables::DecodedOp const& Op, int64_t Offset = 0);
 
+  void InstrumentWatchpointCheck(X86Tables::DecodedOp const& Op, OrderedNode *Address, uint8_t AccessSize, bool IsStore);
+
   OrderedNode *LoadSource(RegisterClassType Class, X86Tables::DecodedOp const& Op, X86Tables::DecodedOperand const& Operand, uint32_t Flags, const LoadSourceOptions& Options = {});
   OrderedNode *LoadSource_WithOpSize(RegisterClassType Class, X86Tables::DecodedOp const& Op, X86Tables::DecodedOperand const& Operand, uint8_t OpSize, uint32_t Flags, const LoadSourceOptions& Options = {});
   void StoreResult_WithOpSize(FEXCore::IR::RegisterClassType Class, FEXCore::X86Tables::DecodedOp Op, FEXCore::X86Tables::DecodedOperand const& Operand, OrderedNode *const Src, uint8_t OpSize, int8_t Align, MemoryAccessType AccessType = MemoryAccessType::DEFAULT);
@@ -1718,6 +1773,12 @@ private:
   void CalculateOF(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, bool Sub);
   void CalculateFlags_ADC(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, OrderedNode *CF);
   void CalculateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, OrderedNode *CF);
+  // Combined result and eager flag calculation for adc/sbb, consuming and
+  // producing the carry in host NZCV so chained uses never materialize CF.
+  // Only valid for 32-bit and 64-bit operations with deferred flags already
+  // calculated; leaves the flag state fully up to date.
+  OrderedNode *CalculateADCWithNZCV(uint8_t SrcSize, OrderedNode *Src1, OrderedNode *Src2);
+  OrderedNode *CalculateSBBWithNZCV(uint8_t SrcSize, OrderedNode *Src1, OrderedNode *Src2);
   void CalculateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, bool UpdateCF = true);
   void CalculateFlags_ADD(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, bool UpdateCF = true);
   void CalculateFlags_MUL(uint8_t SrcSize, OrderedNode *Res, OrderedNode *High);
@@ -2139,6 +2200,17 @@ private:
   OrderedNode *GetX87FTW();
   void SetX87Top(OrderedNode *Value);
 
+  // Classifies an address register for region based TSO relaxation. Stack
+  // pointer relative accesses are always considered thread-private since no
+  // sane application publishes data below another thread's stack pointer.
+  // Frame pointer relative accesses get the same treatment when the
+  // FramePointerTSOEnabled tunable is disabled, which covers the other half of
+  // stack traffic in frame-pointer-enabled guest code.
+  bool AddressRegIsThreadPrivate(uint32_t GPR) const {
+    return GPR == FEXCore::X86State::REG_RSP ||
+           (GPR == FEXCore::X86State::REG_RBP && !CTX->Config.FramePointerTSOEnabled);
+  }
+
   bool DestIsLockedMem(FEXCore::X86Tables::DecodedOp Op) const {
     return DestIsMem(Op) && (Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_LOCK) != 0;
   }
@@ -2147,22 +2219,30 @@ private:
     return !Op->Dest.IsGPR();
   }
 
-  void CreateJumpBlocks(fextl::vector<FEXCore::Frontend::Decoder::DecodedBlocks> const *Blocks);
+  void CreateJumpBlocks(FEXCore::Frontend::Decoder::DecodedBlockVector const *Blocks);
   bool BlockSetRIP {false};
 
   bool Multiblock{};
+  // Populated by the frontend when leaf call inlining pulled callees in to the region
+  const fextl::set<uint64_t> *InlinedCallSites {};
+  const fextl::map<uint64_t, uint64_t> *PredictedReturnTargets {};
   uint64_t Entry;
 
+  // The TSO memory ops carry *proven* alignment so the backend can elide the
+  // alignment-fault backpatch pad. Decode-time Align claims describe the
+  // expected access, not a guarantee (the guest is free to misalign string
+  // ops and stack accesses), so they are deliberately not forwarded here.
+  // ConstProp raises the field when the address expression proves alignment.
   OrderedNode* _StoreMemAutoTSO(FEXCore::IR::RegisterClassType Class, uint8_t Size, OrderedNode *Addr, OrderedNode *Value, uint8_t Align = 1) {
     if (CTX->IsAtomicTSOEnabled())
-      return _StoreMemTSO(Class, Size, Value, Addr, Invalid(), Align, MEM_OFFSET_SXTX, 1);
+      return _StoreMemTSO(Class, Size, Value, Addr, Invalid(), 1, MEM_OFFSET_SXTX, 1);
     else
       return _StoreMem(Class, Size, Value, Addr, Invalid(), Align, MEM_OFFSET_SXTX, 1);
   }
 
   OrderedNode* _LoadMemAutoTSO(FEXCore::IR::RegisterClassType Class, uint8_t Size, OrderedNode *ssa0, uint8_t Align = 1) {
     if (CTX->IsAtomicTSOEnabled())
-      return _LoadMemTSO(Class, Size, ssa0, Invalid(), Align, MEM_OFFSET_SXTX, 1);
+      return _LoadMemTSO(Class, Size, ssa0, Invalid(), 1, MEM_OFFSET_SXTX, 1);
     else
       return _LoadMem(Class, Size, ssa0, Invalid(), Align, MEM_OFFSET_SXTX, 1);
   }
@@ -299,6 +299,10 @@ void OpDispatchBuilder::CalculateAF(OpSize OpSize, OrderedNode *Res, OrderedNode
 }
 
 void OpDispatchBuilder::CalculateDeferredFlags(uint32_t FlagsToCalculateMask) {
+  // The x87 TOP is cached the same way NZCV is, store out any pending update
+  // before anything can observe the context copy.
+  FlushX87Top();
+
   if (CurrentDeferredFlags.Type == FlagsGenerationType::TYPE_NONE) {
     // Nothing to do
     if (NZCVDirty && CachedNZCV)
@@ -559,6 +563,46 @@ void OpDispatchBuilder::CalculateFlags_SBB(uint8_t SrcSize, OrderedNode *Res, Or
   }
 }
 
+OrderedNode *OpDispatchBuilder::CalculateADCWithNZCV(uint8_t SrcSize, OrderedNode *Src1, OrderedNode *Src2) {
+  auto OpSize = SrcSize == 8 ? OpSize::i64Bit : OpSize::i32Bit;
+
+  // Carry-in is consumed straight from the NZCV carry, so sync any cached copy
+  // first, the same as CalculateFlags_ADC does before _AdcNZCV.
+  if (NZCVDirty && CachedNZCV)
+    _StoreNZCV(CachedNZCV);
+  CachedNZCV = nullptr;
+  NZCVDirty = false;
+
+  auto Res = _AdcWithFlags(OpSize, Src1, Src2);
+  PossiblySetNZCVBits = ~0;
+
+  CalculateAF(OpSize, Res, Src1, Src2);
+  CalculatePF(Res);
+  return Res;
+}
+
+OrderedNode *OpDispatchBuilder::CalculateSBBWithNZCV(uint8_t SrcSize, OrderedNode *Src1, OrderedNode *Src2) {
+  auto OpSize = SrcSize == 8 ? OpSize::i64Bit : OpSize::i32Bit;
+
+  // Rectify input carry
+  CarryInvert();
+
+  if (NZCVDirty && CachedNZCV)
+    _StoreNZCV(CachedNZCV);
+  CachedNZCV = nullptr;
+  NZCVDirty = false;
+
+  auto Res = _SbbWithFlags(OpSize, Src1, Src2);
+  PossiblySetNZCVBits = ~0;
+
+  // Rectify output carry
+  CarryInvert();
+
+  CalculateAF(OpSize, Res, Src1, Src2);
+  CalculatePF(Res);
+  return Res;
+}
+
 void OpDispatchBuilder::CalculateFlags_SUB(uint8_t SrcSize, OrderedNode *Res, OrderedNode *Src1, OrderedNode *Src2, bool UpdateCF) {
   auto OpSize = SrcSize == 8 ? OpSize::i64Bit : OpSize::i32Bit;
 
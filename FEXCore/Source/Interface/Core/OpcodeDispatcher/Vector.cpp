@@ -1104,7 +1104,7 @@ void OpDispatchBuilder::MOVMSKOpOne(OpcodeArgs) {
   const auto ExtractSize = Is256Bit ? 4 : 2;
 
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags);
-  OrderedNode *VMask = _VDupFromGPR(SrcSize, 8, _Constant(0x80'40'20'10'08'04'02'01ULL));
+  OrderedNode *VMask = LoadAndCacheNamedVectorConstant(SrcSize, FEXCore::IR::NamedVectorConstant::NAMED_VECTOR_MOVMSKB_MASK);
 
   auto VCMP = _VCMPLTZ(SrcSize, 1, Src);
   auto VAnd = _VAnd(SrcSize, 1, VCMP, VMask);
@@ -1437,43 +1437,68 @@ void OpDispatchBuilder::VPSHUFWOp(OpcodeArgs) {
 
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags);
 
+  if (!Is256Bit) {
+    // The SSE forms of these shuffles already select between native
+    // dup/zip sequences and a pooled TBL mask, so route the 128-bit VEX
+    // forms through the same selection instead of chaining element inserts.
+    constexpr auto IdentityCopy = 0b11'10'01'00;
+    const uint16_t Mask = Shuffle & 0xFF;
+    OrderedNode *Result{};
+
+    switch (Mask) {
+      case IdentityCopy: {
+        // Special case identity copy.
+        Result = Src;
+        break;
+      }
+      case 0b00'00'00'00:
+      case 0b01'01'01'01:
+      case 0b10'10'10'10:
+      case 0b11'11'11'11: {
+        if constexpr (ElementSize == 4) {
+          // Special case element duplicate and broadcast.
+          Result = _VDupElement(SrcSize, 4, Src, Mask & 0b11);
+          break;
+        }
+        [[fallthrough]];
+      }
+      default: {
+        const auto IndexedVectorConstant =
+          ElementSize == 4 ? FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_PSHUFD :
+          Low              ? FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_PSHUFLW :
+                             FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_PSHUFHW;
+        auto LookupIndexes = LoadAndCacheIndexedNamedVectorConstant(SrcSize, IndexedVectorConstant, Mask * 16);
+        Result = _VTBL1(SrcSize, Src, LookupIndexes);
+        break;
+      }
+    }
+
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   // Note/TODO: With better immediate facilities or vector loading in our IR
-  //            much of this can be reduced to setting up a table index register
-  //            and then using TBL
-  //
-  //            SVE has the INDEX instruction that works essentially like
-  //            std::iota (setting a range to an initial value and progressively
-  //            incrementing each successive element), so it's well suited for this.
-  //            It's just a matter of exposing these facilities in a way that works
-  //            well together.
-  //
-  //            Should be much nicer than doing repeated inserts in any case.
+  //            the 256-bit form below could also be reduced to setting up a
+  //            table index register and then using TBL, once the pooled masks
+  //            grow 256-bit variants.
 
   const size_t BaseElement = Low ? 0 : 4;
   OrderedNode *Result = Src;
-  if (Is256Bit) {
-    for (size_t i = 0; i < 4; i++) {
-      const auto Index = Shuffle & 0b11;
-      const auto UpperLaneOffset = Core::CPUState::XMM_SSE_REG_SIZE / ElementSize;
+  for (size_t i = 0; i < 4; i++) {
+    const auto Index = Shuffle & 0b11;
+    const auto UpperLaneOffset = Core::CPUState::XMM_SSE_REG_SIZE / ElementSize;
 
-      const auto LowDstIndex = BaseElement + i;
-      const auto LowSrcIndex = BaseElement + Index;
+    const auto LowDstIndex = BaseElement + i;
+    const auto LowSrcIndex = BaseElement + Index;
 
-      const auto HighDstIndex = BaseElement + UpperLaneOffset + i;
-      const auto HighSrcIndex = BaseElement + UpperLaneOffset + Index;
+    const auto HighDstIndex = BaseElement + UpperLaneOffset + i;
+    const auto HighSrcIndex = BaseElement + UpperLaneOffset + Index;
 
-      // Take care of both lanes per iteration
-      Result = _VInsElement(SrcSize, ElementSize, LowDstIndex, LowSrcIndex, Result, Src);
-      Result = _VInsElement(SrcSize, ElementSize, HighDstIndex, HighSrcIndex, Result, Src);
+    // Take care of both lanes per iteration
+    Result = _VInsElement(SrcSize, ElementSize, LowDstIndex, LowSrcIndex, Result, Src);
+    Result = _VInsElement(SrcSize, ElementSize, HighDstIndex, HighSrcIndex, Result, Src);
 
-      Shuffle >>= 2;
-    }
-  } else {
-    for (size_t i = 0; i < 4; i++) {
-      const auto Index = Shuffle & 0b11;
-      Result = _VInsElement(SrcSize, ElementSize, BaseElement + i, BaseElement + Index, Result, Src);
-      Shuffle >>= 2;
-    }
+    Shuffle >>= 2;
   }
 
   StoreResult(FPRClass, Op, Result, -1);
@@ -2747,6 +2772,59 @@ void OpDispatchBuilder::AVXVector_CVT_Float_To_Float<4, 8>(OpcodeArgs);
 template
 void OpDispatchBuilder::AVXVector_CVT_Float_To_Float<8, 4>(OpcodeArgs);
 
+void OpDispatchBuilder::VCVTPH2PSOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+  const auto Is128Bit = DstSize == Core::CPUState::XMM_SSE_REG_SIZE;
+
+  // Source is half the width of the destination floats.
+  // If loading from memory, only load the exact amount of halves needed.
+  const auto LoadSize = Op->Src[0].IsGPR() ? 16U : DstSize / 2;
+
+  OrderedNode *Src = LoadSource_WithOpSize(FPRClass, Op, Op->Src[0], LoadSize, Op->Flags);
+
+  // Half to single conversions are exact, so no rounding mode concerns here.
+  OrderedNode *Result = _Vector_FToF(DstSize, 4, Src, 2);
+
+  if (Is128Bit) {
+    Result = _VMov(16, Result);
+  }
+  StoreResult(FPRClass, Op, Result, -1);
+}
+
+void OpDispatchBuilder::VCVTPS2PHOp(OpcodeArgs) {
+  const auto SrcSize = GetSrcSize(Op);
+  const auto StoreSize = Op->Dest.IsGPR() ? 16U : SrcSize / 2;
+
+  OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags);
+
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Src1 needs to be literal here");
+  const uint64_t Imm8 = Op->Src[1].Data.Literal.Value;
+
+  // Bit 2 of the immediate selects MXCSR as the rounding control source,
+  // otherwise bits [1:0] hold a static mode in the MXCSR.RC encoding.
+  // The host conversion always rounds with the mode in FPCR, so briefly
+  // swap it for the static case.
+  const auto UseMXCSR = (Imm8 & 0b100) != 0;
+  OrderedNode *SavedMode{};
+  if (!UseMXCSR) {
+    SavedMode = _GetRoundingMode();
+    _SetRoundingMode(_Constant(Imm8 & 0b11));
+  }
+
+  OrderedNode *Result = _Vector_FToF(SrcSize, 2, Src, 4);
+
+  if (!UseMXCSR) {
+    _SetRoundingMode(SavedMode);
+  }
+
+  // We need to eliminate upper junk if we're storing into a register with
+  // a 256-bit source (VCVTPS2PH's destination for registers is an XMM).
+  if (Op->Dest.IsGPR() && SrcSize == Core::CPUState::XMM_AVX_REG_SIZE) {
+    Result = _VMov(16, Result);
+  }
+  StoreResult_WithOpSize(FPRClass, Op, Op->Dest, Result, StoreSize, -1);
+}
+
 void OpDispatchBuilder::MMX_To_XMM_Vector_CVT_Int_To_Float(OpcodeArgs) {
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags);
 
@@ -3142,23 +3220,24 @@ void OpDispatchBuilder::SaveX87State(OpcodeArgs, OrderedNode *MemBase) {
   // MXCSR_MASK: Mask for writes to the MXCSR register
   // If OSFXSR bit in CR4 is not set than FXSAVE /may/ not save the XMM registers
   // This is implementation dependent
-  for (uint32_t i = 0; i < Core::CPUState::NUM_MMS; ++i) {
-    OrderedNode *MMReg = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, mm[i]));
-    OrderedNode *MemLocation = _Add(OpSize, MemBase, _Constant(i * 16 + 32));
+  // The MM regions are adjacent 16-byte slots, so two registers go out per
+  // store-pair instead of one store each.
+  for (uint32_t i = 0; i < Core::CPUState::NUM_MMS; i += 2) {
+    OrderedNode *MMRegLow = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, mm[i]));
+    OrderedNode *MMRegHigh = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, mm[i + 1]));
 
-    _StoreMem(FPRClass, 16, MemLocation, MMReg, 16);
+    _StoreMemPair(FPRClass, 16, MMRegLow, MMRegHigh, MemBase, i * 16 + 32);
   }
 }
 
 void OpDispatchBuilder::SaveSSEState(OrderedNode *MemBase) {
-  const auto OpSize = IR::SizeToOpSize(CTX->GetGPRSize());
   const auto NumRegs = CTX->Config.Is64BitMode ? 16U : 8U;
 
-  for (uint32_t i = 0; i < NumRegs; ++i) {
-    OrderedNode *XMMReg = LoadXMMRegister(i);
-    OrderedNode *MemLocation = _Add(OpSize, MemBase, _Constant(i * 16 + 160));
+  for (uint32_t i = 0; i < NumRegs; i += 2) {
+    OrderedNode *XMMRegLow = LoadXMMRegister(i);
+    OrderedNode *XMMRegHigh = LoadXMMRegister(i + 1);
 
-    _StoreMem(FPRClass, 16, MemLocation, XMMReg, 16);
+    _StoreMemPair(FPRClass, 16, XMMRegLow, XMMRegHigh, MemBase, i * 16 + 160);
   }
 }
 
@@ -3175,14 +3254,13 @@ void OpDispatchBuilder::SaveMXCSRState(OrderedNode *MemBase) {
 }
 
 void OpDispatchBuilder::SaveAVXState(OrderedNode *MemBase) {
-  const auto OpSize = IR::SizeToOpSize(CTX->GetGPRSize());
   const auto NumRegs = CTX->Config.Is64BitMode ? 16U : 8U;
 
-  for (uint32_t i = 0; i < NumRegs; ++i) {
-    OrderedNode *Upper = _VDupElement(32, 16, LoadXMMRegister(i), 1);
-    OrderedNode *MemLocation = _Add(OpSize, MemBase, _Constant(i * 16 + 576));
+  for (uint32_t i = 0; i < NumRegs; i += 2) {
+    OrderedNode *UpperLow = _VDupElement(32, 16, LoadXMMRegister(i), 1);
+    OrderedNode *UpperHigh = _VDupElement(32, 16, LoadXMMRegister(i + 1), 1);
 
-    _StoreMem(FPRClass, 16, MemLocation, Upper, 16);
+    _StoreMemPair(FPRClass, 16, UpperLow, UpperHigh, MemBase, i * 16 + 576);
   }
 }
 
@@ -4616,13 +4694,13 @@ void OpDispatchBuilder::VTESTOpImpl(OpcodeArgs, size_t ElementSize) {
   InvalidateDeferredFlags();
 
   const auto SrcSize = GetSrcSize(Op);
-  const auto ElementSizeInBits = ElementSize * 8;
-  const auto MaskConstant = uint64_t{1} << (ElementSizeInBits - 1);
 
   OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Dest, Op->Flags);
   OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags);
 
-  OrderedNode *Mask = _VDupFromGPR(SrcSize, ElementSize, _Constant(MaskConstant));
+  OrderedNode *Mask = LoadAndCacheNamedVectorConstant(SrcSize,
+    ElementSize == 4 ? FEXCore::IR::NamedVectorConstant::NAMED_VECTOR_SIGN_MASK_PS
+                     : FEXCore::IR::NamedVectorConstant::NAMED_VECTOR_SIGN_MASK_PD);
 
   OrderedNode *AndTest = _VAnd(SrcSize, 1, Src2, Src1);
   OrderedNode *AndNotTest = _VBic(SrcSize, 1, Src2, Src1);
@@ -5226,11 +5304,11 @@ void OpDispatchBuilder::VPERMQOp(OpcodeArgs) {
     const auto Index = Selector & 0b11;
     Result = _VDupElement(DstSize, 8, Src, Index);
   } else {
-    Result = LoadAndCacheNamedVectorConstant(DstSize, FEXCore::IR::NamedVectorConstant::NAMED_VECTOR_ZERO);
-    for (size_t i = 0; i < DstSize / 8; i++) {
-      const auto SrcIndex = (Selector >> (i * 2)) & 0b11;
-      Result = _VInsElement(DstSize, 8, i, SrcIndex, Result, Src);
-    }
+    // Otherwise a single full-width table lookup can handle any selector,
+    // rather than inserting each element individually.
+    OrderedNode *LookupIndexes =
+      LoadAndCacheIndexedNamedVectorConstant(DstSize, FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_VPERMQ, Selector * 32);
+    Result = _VTBL1(DstSize, Src, LookupIndexes);
   }
   StoreResult(FPRClass, Op, Result, -1);
 }
@@ -5385,35 +5463,20 @@ void OpDispatchBuilder::VZEROOp(OpcodeArgs) {
 template <size_t ElementSize>
 void OpDispatchBuilder::VPERMILImmOp(OpcodeArgs) {
   const auto DstSize = GetDstSize(Op);
-  const auto Is256Bit = DstSize == Core::CPUState::XMM_AVX_REG_SIZE;
 
   LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Src1 needs to be literal here");
   const auto Selector = Op->Src[1].Data.Literal.Value & 0xFF;
 
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags);
-  OrderedNode *Result = LoadAndCacheNamedVectorConstant(DstSize, FEXCore::IR::NamedVectorConstant::NAMED_VECTOR_ZERO);
 
-  if constexpr (ElementSize == 8) {
-    Result = _VInsElement(DstSize, ElementSize, 0, Selector & 0b0001, Result, Src);
-    Result = _VInsElement(DstSize, ElementSize, 1, (Selector & 0b0010) >> 1, Result, Src);
+  // The in-lane permute can be done with a single table lookup. The LUT entries
+  // are laid out so the 128-bit form only reads the lower lane's indices.
+  constexpr auto IndexedConstant = ElementSize == 8 ?
+    FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_VPERMILPD :
+    FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_VPERMILPS;
 
-    if (Is256Bit) {
-      Result = _VInsElement(DstSize, ElementSize, 2, ((Selector & 0b0100) >> 2) + 2, Result, Src);
-      Result = _VInsElement(DstSize, ElementSize, 3, ((Selector & 0b1000) >> 3) + 2, Result, Src);
-    }
-  } else {
-    Result = _VInsElement(DstSize, ElementSize, 0, Selector & 0b00000011, Result, Src);
-    Result = _VInsElement(DstSize, ElementSize, 1, (Selector & 0b00001100) >> 2, Result, Src);
-    Result = _VInsElement(DstSize, ElementSize, 2, (Selector & 0b00110000) >> 4, Result, Src);
-    Result = _VInsElement(DstSize, ElementSize, 3, (Selector & 0b11000000) >> 6, Result, Src);
-
-    if (Is256Bit) {
-      Result = _VInsElement(DstSize, ElementSize, 4, (Selector & 0b00000011) + 4, Result, Src);
-      Result = _VInsElement(DstSize, ElementSize, 5, ((Selector & 0b00001100) >> 2) + 4, Result, Src);
-      Result = _VInsElement(DstSize, ElementSize, 6, ((Selector & 0b00110000) >> 4) + 4, Result, Src);
-      Result = _VInsElement(DstSize, ElementSize, 7, ((Selector & 0b11000000) >> 6) + 4, Result, Src);
-    }
-  }
+  OrderedNode *LookupIndexes = LoadAndCacheIndexedNamedVectorConstant(DstSize, IndexedConstant, Selector * 32);
+  OrderedNode *Result = _VTBL1(DstSize, Src, LookupIndexes);
 
   StoreResult(FPRClass, Op, Result, -1);
 }
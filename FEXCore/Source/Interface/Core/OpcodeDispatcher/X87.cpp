@@ -26,7 +26,10 @@ class OrderedNode;
 OrderedNode *OpDispatchBuilder::GetX87Top() {
   // Yes, we are storing 3 bits in a single flag register.
   // Deal with it
-  return _LoadContext(1, GPRClass, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+  if (!CachedX87Top) {
+    CachedX87Top = _LoadContext(1, GPRClass, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+  }
+  return CachedX87Top;
 }
 
 void OpDispatchBuilder::SetX87ValidTag(OrderedNode *Value, bool Valid) {
@@ -89,7 +92,10 @@ OrderedNode *OpDispatchBuilder::GetX87FTW() {
 }
 
 void OpDispatchBuilder::SetX87Top(OrderedNode *Value) {
-  _StoreContext(1, GPRClass, Value, offsetof(FEXCore::Core::CPUState, flags) + FEXCore::X86State::X87FLAG_TOP_LOC);
+  // Defer the context store. Back-to-back x87 ops rewrite TOP constantly and
+  // only the final value needs to reach the context, FlushX87Top handles that.
+  CachedX87Top = Value;
+  X87TopDirty = true;
 }
 
 OrderedNode *OpDispatchBuilder::ReconstructFSW() {
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: glue|pmu-tuning
+desc: Adjusts multiblock policy from host PMU feedback
+$end_info$
+*/
+#include "Interface/Core/PMUTuner.h"
+
+#include <FEXCore/Utils/LogManager.h>
+
+#include <algorithm>
+
+#ifndef _WIN32
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace FEXCore {
+
+struct PMUTuner::ThreadCounters {
+  int GroupFD{-1};
+  bool AttachAttempted{};
+  uint32_t PulseCount{};
+  uint64_t LastCycles{};
+  uint64_t LastBranchMisses{};
+  uint64_t LastITLBMisses{};
+
+  ~ThreadCounters() {
+#ifndef _WIN32
+    if (GroupFD != -1) {
+      // Closing the group leader tears down the whole group.
+      close(GroupFD);
+    }
+#endif
+  }
+};
+
+namespace {
+  // Sample every N compilations. Compilation activity is exactly when the
+  // policy decisions are being made, so that's when feedback matters.
+  constexpr uint32_t PULSE_WINDOW = 64;
+
+  // Don't act on a window below this many cycles, the rates would be noise.
+  constexpr uint64_t MIN_WINDOW_CYCLES = 50'000'000;
+
+  // Don't score a session below this many cycles. Scores steer the
+  // cross-session parameter store, a short run would let noise in.
+  constexpr uint64_t MIN_SESSION_CYCLES = 2'000'000'000;
+
+  // Miss rates are per thousand cycles, scaled by 1000 for integer math.
+  constexpr uint64_t ITLB_HIGH_WATER = 500;  // 0.5 iTLB misses / kcycle
+  constexpr uint64_t ITLB_LOW_WATER = 100;   // 0.1 iTLB misses / kcycle
+  constexpr uint64_t BRANCH_HIGH_WATER = 5'000; // 5 branch misses / kcycle
+
+#ifndef _WIN32
+  int OpenCounter(uint32_t Type, uint64_t EventConfig, int GroupFD) {
+    perf_event_attr Attr{};
+    Attr.size = sizeof(Attr);
+    Attr.type = Type;
+    Attr.config = EventConfig;
+    Attr.read_format = PERF_FORMAT_GROUP;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+
+    // pid 0, cpu -1: this thread, on whichever CPU it runs.
+    return ::syscall(SYS_perf_event_open, &Attr, 0, -1, GroupFD, PERF_FLAG_FD_CLOEXEC);
+  }
+#endif
+}
+
+PMUTuner::PMUTuner(int32_t InitialBudget)
+  : Budget {InitialBudget}
+  , MinBudget {std::max(500, InitialBudget / 8)}
+  , MaxBudget {InitialBudget * 8} {
+}
+
+void PMUTuner::Sample(ThreadCounters &Counters) {
+#ifndef _WIN32
+  if (!Counters.AttachAttempted) {
+    Counters.AttachAttempted = true;
+
+    const int Leader = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (Leader == -1) {
+      // perf_event_open rejected (seccomp, perf_event_paranoid). Run untuned.
+      return;
+    }
+
+    constexpr uint64_t ITLBReadMiss = PERF_COUNT_HW_CACHE_ITLB |
+                                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const int BranchMiss = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, Leader);
+    const int ITLBMiss = OpenCounter(PERF_TYPE_HW_CACHE, ITLBReadMiss, Leader);
+
+    if (BranchMiss == -1 || ITLBMiss == -1) {
+      // Partial groups would skew the controller, all or nothing.
+      if (BranchMiss != -1) close(BranchMiss);
+      if (ITLBMiss != -1) close(ITLBMiss);
+      close(Leader);
+      return;
+    }
+
+    // The siblings stay open through the group leader.
+    Counters.GroupFD = Leader;
+    return;
+  }
+
+  if (Counters.GroupFD == -1) {
+    return;
+  }
+
+  // PERF_FORMAT_GROUP layout: nr followed by one value per group member, in
+  // creation order: cycles, branch misses, iTLB misses.
+  struct {
+    uint64_t NR;
+    uint64_t Values[3];
+  } Data{};
+
+  if (read(Counters.GroupFD, &Data, sizeof(Data)) != sizeof(Data) || Data.NR != 3) {
+    return;
+  }
+
+  const uint64_t Cycles = Data.Values[0] - Counters.LastCycles;
+  const uint64_t BranchMisses = Data.Values[1] - Counters.LastBranchMisses;
+  const uint64_t ITLBMisses = Data.Values[2] - Counters.LastITLBMisses;
+  Counters.LastCycles = Data.Values[0];
+  Counters.LastBranchMisses = Data.Values[1];
+  Counters.LastITLBMisses = Data.Values[2];
+
+  // Every window counts toward the session score, including ones too small
+  // for the controller to act on.
+  SessionCycles.fetch_add(Cycles, std::memory_order_relaxed);
+  SessionBranchMisses.fetch_add(BranchMisses, std::memory_order_relaxed);
+  SessionITLBMisses.fetch_add(ITLBMisses, std::memory_order_relaxed);
+
+  if (Cycles < MIN_WINDOW_CYCLES) {
+    return;
+  }
+
+  // Misses per thousand cycles, scaled by 1000.
+  const uint64_t ITLBRate = ITLBMisses * 1'000'000 / Cycles;
+  const uint64_t BranchRate = BranchMisses * 1'000'000 / Cycles;
+
+  const int32_t Current = Budget.load(std::memory_order_relaxed);
+  int32_t Next = Current;
+
+  if (ITLBRate > ITLB_HIGH_WATER) {
+    // Code footprint outgrew the instruction TLB, narrow the traces.
+    Next = std::max(MinBudget, Current - Current / 4);
+  } else if (BranchRate > BRANCH_HIGH_WATER && ITLBRate < ITLB_LOW_WATER) {
+    // Branchy workload with headroom, widen the traces so more control flow
+    // stays inside one compilation unit.
+    Next = std::min(MaxBudget, Current + Current / 4);
+  }
+
+  if (Next != Current) {
+    Budget.store(Next, std::memory_order_relaxed);
+    if (Next < Current) {
+      // Existing code compiled at the old budget may now be oversized.
+      NarrowGen.fetch_add(1, std::memory_order_relaxed);
+    }
+    LogMan::Msg::DFmt("PMUTuner: trace budget {} -> {} (iTLB {}/Mcycle, branch-miss {}/Mcycle)",
+                      Current, Next, ITLBRate, BranchRate);
+  }
+#endif
+}
+
+int64_t PMUTuner::SessionScore() const {
+  const uint64_t Cycles = SessionCycles.load(std::memory_order_relaxed);
+  if (Cycles < MIN_SESSION_CYCLES) {
+    return -1;
+  }
+
+  const uint64_t BranchMisses = SessionBranchMisses.load(std::memory_order_relaxed);
+  const uint64_t ITLBMisses = SessionITLBMisses.load(std::memory_order_relaxed);
+  return static_cast<int64_t>((BranchMisses + ITLBMisses * 10) * 1'000'000 / Cycles);
+}
+
+void PMUTuner::Pulse() {
+  static thread_local ThreadCounters Counters{};
+
+  if (++Counters.PulseCount % PULSE_WINDOW != 0) {
+    return;
+  }
+
+  Sample(Counters);
+}
+
+}
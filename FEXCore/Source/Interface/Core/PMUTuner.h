@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace FEXCore {
+// Hardware-counter feedback for the multiblock policy.
+//
+// Each guest thread samples its own cycles, branch misses and iTLB misses
+// through perf_event_open. The controller watches the miss rates and adjusts
+// the total-instruction budget that bounds a multiblock trace:
+// - A high iTLB miss rate means the generated code footprint outgrew the
+//   host's instruction TLB reach, so traces are narrowed.
+// - A high branch miss rate with a healthy iTLB means the dispatcher round
+//   trips between small blocks dominate, so traces are widened.
+//
+// Counters attach lazily per thread on the first pulse and close when the
+// thread exits. If perf_event_open is unavailable (seccomp, paranoid level)
+// the tuner stays at its initial budget and costs one failed syscall.
+class PMUTuner final {
+public:
+  explicit PMUTuner(int32_t InitialBudget);
+
+  // Called from the block compile path. Cheap unless a sample window elapsed.
+  void Pulse();
+
+  // Current total-instruction budget for a multiblock trace.
+  int32_t TraceInstBudget() const {
+    return Budget.load(std::memory_order_relaxed);
+  }
+
+  // Bumped every time iTLB pressure narrows the budget. Threads compare this
+  // against their own mark to notice that already-compiled regions may now be
+  // oversized.
+  uint32_t NarrowGeneration() const {
+    return NarrowGen.load(std::memory_order_relaxed);
+  }
+
+  // Quality score for the whole session: misses per million cycles across
+  // every sampled thread window, iTLB misses weighted heavier since each one
+  // stalls the whole front end. Lower is better. Returns -1 until enough
+  // cycles accumulated for scores to be comparable across sessions.
+  int64_t SessionScore() const;
+
+private:
+  struct ThreadCounters;
+  void Sample(ThreadCounters &Counters);
+
+  std::atomic<int32_t> Budget;
+  std::atomic<uint32_t> NarrowGen{};
+  int32_t MinBudget;
+  int32_t MaxBudget;
+
+  // Whole-session totals, fed by Sample, read by SessionScore at exit.
+  std::atomic<uint64_t> SessionCycles{};
+  std::atomic<uint64_t> SessionBranchMisses{};
+  std::atomic<uint64_t> SessionITLBMisses{};
+};
+}
@@ -14,7 +14,7 @@ $end_info$
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
 
-std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> BaseOps = []() consteval {
+constinit std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> BaseOps = []() consteval {
   std::array<X86InstInfo, MAX_PRIMARY_TABLE_SIZE> Table{};
 
   constexpr U8U8InfoStruct BaseOpTable[] = {
@@ -273,8 +273,8 @@ auto BaseOpsLambda = []() consteval {
   return Table;
 };
 
-std::array<X86InstInfo, MAX_SECOND_TABLE_SIZE> SecondBaseOps = BaseOpsLambda();
-std::array<X86InstInfo, MAX_REP_MOD_TABLE_SIZE> RepModOps = []() consteval {
+constinit std::array<X86InstInfo, MAX_SECOND_TABLE_SIZE> SecondBaseOps = BaseOpsLambda();
+constinit std::array<X86InstInfo, MAX_REP_MOD_TABLE_SIZE> RepModOps = []() consteval {
   std::array<X86InstInfo, MAX_REP_MOD_TABLE_SIZE> Table{};
 
   constexpr U8U8InfoStruct RepModOpTable[] = {
@@ -362,7 +362,7 @@ std::array<X86InstInfo, MAX_REP_MOD_TABLE_SIZE> RepModOps = []() consteval {
   return Table;
 }();
 
-std::array<X86InstInfo, MAX_REPNE_MOD_TABLE_SIZE> RepNEModOps = []() consteval {
+constinit std::array<X86InstInfo, MAX_REPNE_MOD_TABLE_SIZE> RepNEModOps = []() consteval {
   std::array<X86InstInfo, MAX_REPNE_MOD_TABLE_SIZE> Table{};
 
   constexpr U8U8InfoStruct RepNEModOpTable[] = {
@@ -443,7 +443,7 @@ std::array<X86InstInfo, MAX_REPNE_MOD_TABLE_SIZE> RepNEModOps = []() consteval {
   return Table;
 }();
 
-std::array<X86InstInfo, MAX_OPSIZE_MOD_TABLE_SIZE> OpSizeModOps = []() consteval {
+constinit std::array<X86InstInfo, MAX_OPSIZE_MOD_TABLE_SIZE> OpSizeModOps = []() consteval {
   std::array<X86InstInfo, MAX_OPSIZE_MOD_TABLE_SIZE> Table{};
 
   constexpr U8U8InfoStruct OpSizeModOpTable[] = {
@@ -175,6 +175,17 @@ struct DecodedOperand {
   OpType Type;
 };
 
+// Compact x86 status flag masks for the decoder's liveness summaries.
+namespace StatusFlags {
+  constexpr uint8_t CF = 1U << 0;
+  constexpr uint8_t PF = 1U << 1;
+  constexpr uint8_t AF = 1U << 2;
+  constexpr uint8_t ZF = 1U << 3;
+  constexpr uint8_t SF = 1U << 4;
+  constexpr uint8_t OF = 1U << 5;
+  constexpr uint8_t ALL = CF | PF | AF | ZF | SF | OF;
+}
+
 struct DecodedInst {
   uint64_t PC;
 
@@ -191,6 +202,10 @@ struct DecodedInst {
   uint8_t SIB;
   uint8_t InstSize;
   uint8_t LastEscapePrefix;
+  // Status flags proven dead after this instruction by the decoder's backward
+  // block-local scan: a later instruction in the block overwrites them before
+  // anything can read them. Lowering may skip generating these entirely.
+  uint8_t DeadStatusFlags;
   bool DecodedModRM;
   bool DecodedSIB;
 };
@@ -491,8 +506,13 @@ extern std::array<X86InstInfo, MAX_VEX_TABLE_SIZE> VEXTableOps;
 extern std::array<X86InstInfo, MAX_VEX_GROUP_TABLE_SIZE> VEXTableGroupOps;
 
 // XOP
-extern std::array<X86InstInfo, MAX_XOP_TABLE_SIZE> XOPTableOps;
-extern std::array<X86InstInfo, MAX_XOP_GROUP_TABLE_SIZE> XOPTableGroupOps;
+// Fully decided at compile time: nothing mode-patches these or installs
+// dispatchers into them, so they live in read-only data shared across
+// processes. The remaining tables stay writable because InitializeInfoTables
+// patches them per operating mode and the dispatcher installs handler
+// pointers based on host features and configuration.
+extern const std::array<X86InstInfo, MAX_XOP_TABLE_SIZE> XOPTableOps;
+extern const std::array<X86InstInfo, MAX_XOP_GROUP_TABLE_SIZE> XOPTableGroupOps;
 
 // EVEX
 extern std::array<X86InstInfo, MAX_EVEX_TABLE_SIZE> EVEXTableOps;
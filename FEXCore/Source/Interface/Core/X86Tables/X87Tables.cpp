@@ -11,7 +11,7 @@ $end_info$
 
 namespace FEXCore::X86Tables {
 using namespace InstFlags;
-std::array<X86InstInfo, MAX_X87_TABLE_SIZE> X87Ops = []() consteval {
+constinit std::array<X86InstInfo, MAX_X87_TABLE_SIZE> X87Ops = []() consteval {
   std::array<X86InstInfo, MAX_X87_TABLE_SIZE> Table{};
 #define OPD(op, modrmop) (((op - 0xD8) << 8) | modrmop)
 #define OPDReg(op, reg) (((op - 0xD8) << 8) | (reg << 3))
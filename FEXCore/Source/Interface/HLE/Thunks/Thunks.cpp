@@ -17,6 +17,7 @@ $end_info$
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
 #include "Thunks.h"
 
 #include <cstdint>
@@ -26,6 +27,7 @@ $end_info$
 
 #include <Interface/Context/Context.h>
 #include "FEXCore/Core/X86Enums.h"
+#include <atomic>
 #include <malloc.h>
 #include <mutex>
 #include <memory>
@@ -162,8 +164,73 @@ namespace FEXCore {
         // Ideally we track when a library has been unloaded and remove it from this set before the memory backing goes away.
         fextl::set<fextl::string> Libs;
 
+        // Export tables of loaded libraries that haven't been merged into Thunks yet.
+        // Large libraries export thousands of symbols; binding them on the first
+        // lookup instead of at load time keeps that work off the startup path.
+        // The arrays are owned by the host library, which is never unloaded.
+        fextl::vector<std::pair<const ExportEntry*, size_t>> PendingExports;
+
         fextl::unordered_map<GuestcallInfo, HostToGuestTrampolinePtr*, GuestcallInfoHash> GuestcallToHostTrampoline;
 
+        // Lock-free translation cache in front of GuestcallToHostTrampoline.
+        // Callback-dense libraries re-register the same handful of guest
+        // pointers over and over; hitting here resolves them in a few loads
+        // without touching ThunksMutex. Two-way set-associative: a lookup
+        // probes the pair of slots its hash selects. Trampolines are never
+        // freed, so a stale entry can at worst miss, never dangle.
+        struct GuestcallCacheEntry {
+          std::atomic<uintptr_t> GuestTarget;
+          std::atomic<uintptr_t> GuestUnpacker;
+          std::atomic<HostToGuestTrampolinePtr*> Trampoline;
+        };
+        constexpr static size_t GUESTCALL_CACHE_SIZE = 1024; // Power of two, probed in pairs
+        GuestcallCacheEntry GuestcallCache[GUESTCALL_CACHE_SIZE]{};
+        std::atomic<uint32_t> GuestcallCacheVictim{};
+
+        static size_t GuestcallCacheSlot(const GuestcallInfo& GCI) {
+          // As with GuestcallInfoHash, the target address alone is unique enough.
+          return std::hash<uintptr_t>{}(GCI.GuestTarget) & (GUESTCALL_CACHE_SIZE - 2);
+        }
+
+        HostToGuestTrampolinePtr* LookupGuestcallCache(const GuestcallInfo& GCI) {
+          const size_t Slot = GuestcallCacheSlot(GCI);
+          for (size_t Way = 0; Way < 2; ++Way) {
+            auto& Entry = GuestcallCache[Slot + Way];
+            if (Entry.GuestTarget.load(std::memory_order_acquire) != GCI.GuestTarget) {
+              continue;
+            }
+            auto* Trampoline = Entry.Trampoline.load(std::memory_order_acquire);
+            const auto Unpacker = Entry.GuestUnpacker.load(std::memory_order_acquire);
+            // Re-check the tag so an interleaved eviction can't pair fields
+            // from two different entries. Writers clear the tag first and
+            // publish it last.
+            if (Entry.GuestTarget.load(std::memory_order_acquire) != GCI.GuestTarget ||
+                Unpacker != GCI.GuestUnpacker) {
+              continue;
+            }
+            return Trampoline;
+          }
+          return nullptr;
+        }
+
+        void InsertGuestcallCache(const GuestcallInfo& GCI, HostToGuestTrampolinePtr* Trampoline) {
+          const size_t Slot = GuestcallCacheSlot(GCI);
+          // Prefer an empty way, otherwise evict round-robin.
+          size_t Way = GuestcallCacheVictim.fetch_add(1, std::memory_order_relaxed) & 1;
+          for (size_t i = 0; i < 2; ++i) {
+            if (GuestcallCache[Slot + i].GuestTarget.load(std::memory_order_relaxed) == 0) {
+              Way = i;
+              break;
+            }
+          }
+
+          auto& Entry = GuestcallCache[Slot + Way];
+          Entry.GuestTarget.store(0, std::memory_order_release);
+          Entry.GuestUnpacker.store(GCI.GuestUnpacker, std::memory_order_relaxed);
+          Entry.Trampoline.store(Trampoline, std::memory_order_relaxed);
+          Entry.GuestTarget.store(GCI.GuestTarget, std::memory_order_release);
+        }
+
         uint8_t *HostTrampolineInstanceDataPtr;
         size_t HostTrampolineInstanceDataAvailable = 0;
 
@@ -343,17 +410,20 @@ namespace FEXCore {
 
             auto That = reinterpret_cast<ThunkHandler_impl*>(CTX->ThunkHandler.get());
 
+            size_t ExportCount = 0;
+            while (Exports[ExportCount].sha256) {
+                ExportCount++;
+            }
+
             {
                 std::lock_guard lk(That->ThunksMutex);
 
                 That->Libs.insert(fextl::string { Name });
 
-                int i;
-                for (i = 0; Exports[i].sha256; i++) {
-                    That->Thunks[*reinterpret_cast<IR::SHA256Sum*>(Exports[i].sha256)] = Exports[i].Fn;
-                }
+                // Don't bind the exports yet, the first LookupThunk does that.
+                That->PendingExports.emplace_back(Exports, ExportCount);
 
-                LogMan::Msg::DFmt("Loaded {} syms", i);
+                LogMan::Msg::DFmt("Loaded {} syms", ExportCount);
             }
         }
 
@@ -376,7 +446,36 @@ namespace FEXCore {
 
         ThunkedFunction* LookupThunk(const IR::SHA256Sum &sha256) override {
 
-            std::shared_lock lk(ThunksMutex);
+            {
+                std::shared_lock lk(ThunksMutex);
+
+                if (PendingExports.empty()) {
+                    auto it = Thunks.find(sha256);
+
+                    if (it != Thunks.end()) {
+                        return it->second;
+                    } else {
+                        return nullptr;
+                    }
+                }
+            }
+
+            // A library was loaded since the last lookup, bind its exports first
+            std::unique_lock lk(ThunksMutex);
+
+            size_t TotalExports = 0;
+            for (const auto& [Exports, Count] : PendingExports) {
+                TotalExports += Count;
+            }
+            // Reserve up front so the insert loop doesn't rehash repeatedly
+            Thunks.reserve(Thunks.size() + TotalExports);
+
+            for (const auto& [Exports, Count] : PendingExports) {
+                for (size_t i = 0; i < Count; i++) {
+                    Thunks[*reinterpret_cast<IR::SHA256Sum*>(Exports[i].sha256)] = Exports[i].Fn;
+                }
+            }
+            PendingExports.clear();
 
             auto it = Thunks.find(sha256);
 
@@ -434,12 +533,18 @@ namespace FEXCore {
 
       const GuestcallInfo gci = { GuestUnpacker, GuestTarget };
 
+      // Fast path for re-registration of a recently seen pointer, no lock taken
+      if (auto* Cached = ThunkHandler->LookupGuestcallCache(gci)) {
+        return Cached;
+      }
+
       // Try first with shared_lock
       {
         std::shared_lock lk(ThunkHandler->ThunksMutex);
 
         auto found = ThunkHandler->GuestcallToHostTrampoline.find(gci);
         if (found != ThunkHandler->GuestcallToHostTrampoline.end()) {
+          ThunkHandler->InsertGuestcallCache(gci, found->second);
           return found->second;
         }
       }
@@ -450,6 +555,7 @@ namespace FEXCore {
       {
         auto found = ThunkHandler->GuestcallToHostTrampoline.find(gci);
         if (found != ThunkHandler->GuestcallToHostTrampoline.end()) {
+          ThunkHandler->InsertGuestcallCache(gci, found->second);
           return found->second;
         }
       }
@@ -480,6 +586,7 @@ namespace FEXCore {
       };
 
       ThunkHandler->GuestcallToHostTrampoline[gci] = HostTrampoline;
+      ThunkHandler->InsertGuestcallCache(gci, HostTrampoline);
       return HostTrampoline;
     }
 
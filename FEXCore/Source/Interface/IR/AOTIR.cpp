@@ -7,15 +7,25 @@
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/Allocator.h>
 #include <FEXCore/HLE/SyscallHandler.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <Interface/Core/LookupCache.h>
 #include <Interface/GDBJIT/GDBJIT.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
 #include <mutex>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <unistd.h>
 #include <xxhash.h>
@@ -74,68 +84,110 @@ namespace FEXCore::IR {
     }
   }
 
-  static bool readAll(int fd, void *data, size_t size) {
-    int rv = read(fd, data, size);
-
-    if (rv != size)
-      return false;
-    else
-      return true;
-  }
+  // The capture stream appends entries in first-compile order, so the data
+  // section of a cache file is laid out by execution phase: boot entries
+  // first, later phases behind them. Play-time lookups therefore walk
+  // roughly forward through the file and the chunk holding the current
+  // phase's entries predicts the next one.
+  constexpr static uint64_t PREFETCH_CHUNK_SIZE = 2 * 1024 * 1024;
+  // How many chunks behind the cursor stay resident before being marked cold.
+  constexpr static uint64_t PREFETCH_COLD_DISTANCE = 2;
 
-  static bool LoadAOTIRCache(AOTIRCacheEntry *Entry, int streamfd) {
+  static void AdvancePhasePrefetch(AOTIRCacheEntry *Entry, const AOTIRInlineEntry *AOTEntry) {
 #ifndef _WIN32
-    uint64_t tag;
-
-    if (!readAll(streamfd, (char*)&tag, sizeof(tag)) || tag != FEXCore::IR::AOTIR_COOKIE)
-      return false;
-
-    fextl::string Module;
-    uint64_t ModSize;
-    uint64_t IndexSize;
-
-    lseek(streamfd, -sizeof(ModSize), SEEK_END);
-
-    if (!readAll(streamfd,  (char*)&ModSize, sizeof(ModSize)))
-      return false;
-
-    Module.resize(ModSize);
+    auto Base = reinterpret_cast<char*>(Entry->FilePtr);
+    const uint64_t DataOffset = reinterpret_cast<const char*>(AOTEntry) - Base;
+    const uint64_t Chunk = DataOffset / PREFETCH_CHUNK_SIZE;
+    const uint64_t Ahead = Chunk + 1;
+
+    // Benignly racy between compile threads; the worst case is a repeated or
+    // skipped advisory call.
+    if (Ahead <= Entry->PrefetchCursor) {
+      return;
+    }
+    Entry->PrefetchCursor = Ahead;
 
-    lseek(streamfd, -sizeof(ModSize) - ModSize, SEEK_END);
+    const uint64_t IndexOffset = reinterpret_cast<char*>(Entry->Array) - Base;
+    const uint64_t DataEnd = std::min<uint64_t>(IndexOffset, Entry->Size);
 
-    if (!readAll(streamfd,  (char*)&Module[0], Module.size()))
-      return false;
-
-    if (Entry->FileId != Module) {
-      return false;
+    // Pull the next phase's entries in before lookups start faulting through
+    // them one page at a time.
+    const uint64_t AheadStart = Ahead * PREFETCH_CHUNK_SIZE;
+    if (AheadStart < DataEnd) {
+      ::madvise(Base + AheadStart, std::min(PREFETCH_CHUNK_SIZE, DataEnd - AheadStart), MADV_WILLNEED);
     }
 
-    lseek(streamfd, -sizeof(ModSize) - ModSize - sizeof(IndexSize), SEEK_END);
-
-    if (!readAll(streamfd,  (char*)&IndexSize, sizeof(IndexSize)))
-      return false;
+#ifdef MADV_COLD
+    // Chunks this far behind the cursor belong to finished phases; make them
+    // the first thing reclaimed under memory pressure. The index tail is
+    // deliberately never marked, it is binary-searched on every lookup.
+    if (Chunk > PREFETCH_COLD_DISTANCE) {
+      const uint64_t ColdStart = (Chunk - PREFETCH_COLD_DISTANCE - 1) * PREFETCH_CHUNK_SIZE;
+      ::madvise(Base + ColdStart, std::min(PREFETCH_CHUNK_SIZE, DataEnd - ColdStart), MADV_COLD);
+    }
+#endif
+#endif
+  }
 
+  static bool LoadAOTIRCache(AOTIRCacheEntry *Entry, int streamfd) {
+#ifndef _WIN32
     struct stat fileinfo;
     if (fstat(streamfd, &fileinfo) < 0)
       return false;
-    size_t Size = (fileinfo.st_size + 4095) & ~4095;
 
-    size_t IndexOffset = fileinfo.st_size - IndexSize -sizeof(ModSize) - ModSize - sizeof(IndexSize);
+    const uint64_t FileSize = fileinfo.st_size;
+    if (FileSize < sizeof(AOTIRHeader))
+      return false;
+
+    size_t Size = (FileSize + 4095) & ~4095;
 
+    // Everything below is validated straight off the mapping, so loading a
+    // cache costs this single mmap and no reads or parsing.
     void *FilePtr = FEXCore::Allocator::mmap(nullptr, Size, PROT_READ, MAP_SHARED, streamfd, 0);
 
     if (FilePtr == MAP_FAILED) {
       return false;
     }
 
-    auto Array = (AOTIRInlineIndex *)((char*)FilePtr + IndexOffset);
+    // Bounds-check the section offsets before dereferencing them so a
+    // truncated or corrupt cache can't send us off the end of the mapping.
+    auto Header = (const AOTIRHeader *)FilePtr;
+    bool Valid = Header->Cookie == FEXCore::IR::AOTIR_COOKIE &&
+                 Header->IndexOffset >= sizeof(AOTIRHeader) &&
+                 Header->IndexOffset + sizeof(AOTIRInlineIndex) <= FileSize &&
+                 Header->ModuleIDOffset >= sizeof(AOTIRHeader) &&
+                 Header->ModuleIDSize <= FileSize &&
+                 Header->ModuleIDOffset <= FileSize - Header->ModuleIDSize;
+
+    if (Valid) {
+      Valid = Entry->FileId.size() == Header->ModuleIDSize &&
+              memcmp(Entry->FileId.c_str(), (const char*)FilePtr + Header->ModuleIDOffset, Header->ModuleIDSize) == 0;
+    }
+
+    auto Array = (AOTIRInlineIndex *)((char*)FilePtr + Header->IndexOffset);
+    if (Valid) {
+      // The index entry array must fit inside the file as well.
+      Valid = Header->IndexOffset + sizeof(AOTIRInlineIndex) + Array->Count * sizeof(AOTIRInlineIndexEntry) <= FileSize;
+    }
+
+    if (!Valid) {
+      FEXCore::Allocator::munmap(FilePtr, Size);
+      return false;
+    }
 
     LOGMAN_THROW_AA_FMT(Entry->Array == nullptr && Entry->FilePtr == nullptr, "Entry must not be initialized here");
     Entry->Array = Array;
     Entry->FilePtr = FilePtr;
     Entry->Size = Size;
 
-    LogMan::Msg::DFmt("AOTIR: Module {} has {} functions", Module, Array->Count);
+    // The index tail is searched on every lookup and the first data chunk
+    // holds the earliest-captured (boot phase) entries; pull both in up front
+    // instead of major-faulting through them one lookup at a time.
+    const uint64_t IndexPage = Header->IndexOffset & ~4095ULL;
+    ::madvise((char*)FilePtr + IndexPage, Size - IndexPage, MADV_WILLNEED);
+    ::madvise(FilePtr, std::min<uint64_t>(PREFETCH_CHUNK_SIZE, Size), MADV_WILLNEED);
+
+    LogMan::Msg::DFmt("AOTIR: Module {} has {} functions", Entry->FileId, Array->Count);
 
     return true;
 #else
@@ -162,8 +214,9 @@ namespace FEXCore::IR {
         stream->Write(&Zero, 1);
 
       // AOTIRInlineIndex
+      const size_t IndexOffset = stream->Offset();
       const auto FnCount = Entry.Index.size();
-      const size_t DataBase = -stream->Offset();
+      const size_t DataBase = -IndexOffset;
 
       stream->Write((const char*)&FnCount, sizeof(FnCount));
       stream->Write((const char*)&DataBase, sizeof(DataBase));
@@ -178,11 +231,19 @@ namespace FEXCore::IR {
         stream->Write((const char*)&DataOffset, sizeof(DataOffset));
       }
 
-      // End of file header
-      const auto IndexSize = FnCount * sizeof(FEXCore::IR::AOTIRInlineIndexEntry) + sizeof(DataBase) + sizeof(FnCount);
-      stream->Write((const char*)&IndexSize, sizeof(IndexSize));
+      // Module ID
+      const size_t ModuleIDOffset = stream->Offset();
       stream->Write(String.c_str(), ModSize);
-      stream->Write((const char*)&ModSize, sizeof(ModSize));
+
+      // Now that the section offsets are known, backpatch the header that was
+      // reserved at the start of the stream.
+      const AOTIRHeader Header {
+        .Cookie = FEXCore::IR::AOTIR_COOKIE,
+        .IndexOffset = IndexOffset,
+        .ModuleIDOffset = ModuleIDOffset,
+        .ModuleIDSize = ModSize,
+      };
+      stream->WriteAt(&Header, sizeof(Header), 0);
 
       // Close the stream
       stream->Close();
@@ -268,6 +329,8 @@ namespace FEXCore::IR {
           auto AOTEntry = Mod->Find(GuestRIP - AOTIRCacheEntry.VAFileStart);
 
           if (AOTEntry) {
+            AdvancePhasePrefetch(AOTIRCacheEntry.Entry, AOTEntry);
+
             // verify hash
             auto MappedStart = GuestRIP;
             auto hash = XXH3_64bits((void*)MappedStart, AOTEntry->GuestLength);
@@ -276,7 +339,8 @@ namespace FEXCore::IR {
               //LogMan::Msg::DFmt("using {} + {:x} -> {:x}\n", file->second.fileid, AOTEntry->first, GuestRIP);
 
               Result.RAData = AOTEntry->GetRAData()->CreateCopy();
-              Result.DebugData = new FEXCore::Core::DebugData();
+              Thread->ScratchDebugData.Reset();
+              Result.DebugData = &Thread->ScratchDebugData;
               Result.StartAddr = MappedStart;
               Result.Length = AOTEntry->GuestLength;
               Result.GeneratedIR = true;
@@ -345,8 +409,10 @@ namespace FEXCore::IR {
 
             if (!AotFile->Stream) {
               AotFile->Stream = AOTIRWriter(FileId);
-              uint64_t tag = FEXCore::IR::AOTIR_COOKIE;
-              AotFile->Stream->Write(&tag, sizeof(tag));
+              // Reserve the fixed-layout header. The section offsets get
+              // backpatched in FinalizeAOTIRCache once the index is written.
+              AOTIRHeader Header {.Cookie = FEXCore::IR::AOTIR_COOKIE};
+              AotFile->Stream->Write(&Header, sizeof(Header));
             }
             AotFile->AppendAOTIRCaptureCache(LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy);
             RADataCopyDeleter(RADataCopy);
@@ -363,8 +429,8 @@ namespace FEXCore::IR {
 
       // Insert to caches if we generated IR
       if (GeneratedIR) {
+        // DebugData is the thread's reused scratch, nothing to free.
         // If the IR doesn't need to be retained then we can just delete it now
-        delete DebugData;
         if (IRList->IsCopy()) delete IRList;
       }
     }
@@ -372,22 +438,141 @@ namespace FEXCore::IR {
     return false;
   }
 
+  // Content key for a guest binary: a hash of its GNU build-id note when it
+  // has one, otherwise a hash of the leading bytes plus the file size. Keying
+  // cache objects by content rather than path means two processes mapping the
+  // same library from different paths (or different mount namespaces) resolve
+  // to the same cache object, while a rebuilt library at an unchanged path
+  // gets a fresh one instead of silently reusing stale code.
+  template<typename EhdrType, typename PhdrType>
+  static bool HashELFBuildID(int FD, const uint8_t *Sample, size_t SampleSize, uint64_t *Key) {
+    if (SampleSize < sizeof(EhdrType)) {
+      return false;
+    }
+
+    EhdrType Ehdr;
+    memcpy(&Ehdr, Sample, sizeof(Ehdr));
+    if (Ehdr.e_phentsize != sizeof(PhdrType)) {
+      return false;
+    }
+
+    for (size_t i = 0; i < Ehdr.e_phnum; ++i) {
+      PhdrType Phdr;
+      const uint64_t PhdrOffset = Ehdr.e_phoff + i * sizeof(PhdrType);
+      if (PhdrOffset + sizeof(PhdrType) <= SampleSize) {
+        memcpy(&Phdr, Sample + PhdrOffset, sizeof(PhdrType));
+      }
+      else if (pread(FD, &Phdr, sizeof(PhdrType), PhdrOffset) != sizeof(PhdrType)) {
+        return false;
+      }
+
+      if (Phdr.p_type != PT_NOTE) {
+        continue;
+      }
+
+      // Note segments are tiny; cap the read so a malformed header can't make
+      // us pull in the world.
+      std::array<uint8_t, 4096> Notes;
+      const size_t NotesSize = std::min<uint64_t>(Phdr.p_filesz, Notes.size());
+      if (pread(FD, Notes.data(), NotesSize, Phdr.p_offset) != static_cast<ssize_t>(NotesSize)) {
+        continue;
+      }
+
+      // The note header layout is identical between ELF classes.
+      size_t Offset = 0;
+      while (Offset + sizeof(Elf64_Nhdr) <= NotesSize) {
+        Elf64_Nhdr Nhdr;
+        memcpy(&Nhdr, Notes.data() + Offset, sizeof(Nhdr));
+        const size_t NameOffset = Offset + sizeof(Nhdr);
+        const size_t DescOffset = NameOffset + FEXCore::AlignUp(Nhdr.n_namesz, 4);
+        if (DescOffset + Nhdr.n_descsz > NotesSize) {
+          break;
+        }
+
+        if (Nhdr.n_type == NT_GNU_BUILD_ID &&
+            Nhdr.n_namesz == 4 &&
+            memcmp(Notes.data() + NameOffset, "GNU", 4) == 0 &&
+            Nhdr.n_descsz != 0) {
+          *Key = XXH3_64bits(Notes.data() + DescOffset, Nhdr.n_descsz);
+          return true;
+        }
+
+        Offset = DescOffset + FEXCore::AlignUp(Nhdr.n_descsz, 4);
+      }
+    }
+
+    return false;
+  }
+
+  static uint64_t CalculateFileContentKey(const fextl::string &filename) {
+    int FD = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      // Can't read the file; fall back to the path so the entry still gets a
+      // stable (if unshared) identity.
+      return XXH3_64bits(filename.c_str(), filename.size());
+    }
+
+    // Enough for the headers of anything reasonable, and a decent content
+    // sample for files without a build-id.
+    fextl::vector<uint8_t> Sample(64 * 1024);
+    const ssize_t ReadSize = pread(FD, Sample.data(), Sample.size(), 0);
+    if (ReadSize <= 0) {
+      close(FD);
+      return XXH3_64bits(filename.c_str(), filename.size());
+    }
+
+    uint64_t Key{};
+    bool HasBuildID = false;
+    if (ReadSize >= EI_NIDENT && memcmp(Sample.data(), ELFMAG, SELFMAG) == 0) {
+      if (Sample[EI_CLASS] == ELFCLASS64) {
+        HasBuildID = HashELFBuildID<Elf64_Ehdr, Elf64_Phdr>(FD, Sample.data(), ReadSize, &Key);
+      }
+      else if (Sample[EI_CLASS] == ELFCLASS32) {
+        HasBuildID = HashELFBuildID<Elf32_Ehdr, Elf32_Phdr>(FD, Sample.data(), ReadSize, &Key);
+      }
+    }
+
+    if (!HasBuildID) {
+      struct stat Stat{};
+      fstat(FD, &Stat);
+      Key = XXH3_64bits_withSeed(Sample.data(), ReadSize, Stat.st_size);
+    }
+
+    close(FD);
+    return Key;
+  }
+
   AOTIRCacheEntry *AOTIRCaptureCache::LoadAOTIRCacheEntry(const fextl::string &filename) {
     fextl::string base_filename = FHU::Filesystem::GetFilename(filename);
 
     if (!base_filename.empty()) {
-      auto filename_hash = XXH3_64bits(filename.c_str(), filename.size());
+      auto content_key = CalculateFileContentKey(filename);
 
       auto fileid = fextl::fmt::format("{}-{}-{}{}{}",
         base_filename,
-        filename_hash,
+        content_key,
         (CTX->Config.SMCChecks == FEXCore::Config::CONFIG_SMC_FULL) ? 'S' : 's',
         CTX->Config.TSOEnabled ? 'T' : 't',
         CTX->Config.ABILocalFlags ? 'L' : 'l');
 
+      // The guest's unwinder libraries are cold until the first throw, then
+      // every frame of the unwind walks their loops through the dispatcher.
+      // Flag them so the tier selection gives them the optimized compile
+      // immediately rather than burning the first throw on baseline code.
+      bool HighPriority = base_filename.starts_with("libgcc_s.so") ||
+                          base_filename.starts_with("libunwind.so");
+
+      // Fleet-popular libraries get the same treatment: something every
+      // process on the box maps (glibc, libstdc++) isn't worth a baseline
+      // detour anywhere. Queried before taking the cache lock since the
+      // frontend may answer with a server round trip.
+      if (!HighPriority && LibraryPriorityQuery) {
+        HighPriority = LibraryPriorityQuery(base_filename) >= Context::LIBRARY_TIER_HOT;
+      }
+
       std::unique_lock lk(AOTIRCacheLock);
 
-      auto Inserted = AOTIRCache.insert({fileid, AOTIRCacheEntry { .FileId = fileid, .Filename = filename }});
+      auto Inserted = AOTIRCache.insert({fileid, AOTIRCacheEntry { .FileId = fileid, .Filename = filename, .HighPriorityRegion = HighPriority }});
       auto Entry = &(Inserted.first->second);
 
       LOGMAN_THROW_AA_FMT(Entry->Array == nullptr, "Duplicate LoadAOTIRCacheEntry");
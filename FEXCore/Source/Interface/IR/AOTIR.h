@@ -41,9 +41,20 @@ namespace FEXCore::IR {
 
     return Cookie;
   };
-  constexpr static uint32_t AOTIR_VERSION = 0x0000'00004;
+  constexpr static uint32_t AOTIR_VERSION = 0x0000'00005;
   constexpr static uint64_t AOTIR_COOKIE = COOKIE_VERSION("FEXI", AOTIR_VERSION);
 
+  // Fixed-layout header at offset zero of the cache file.  All sections are
+  // located through the offsets stored here, so a loader can validate and use
+  // the cache straight off a single mapping of the file without any reads.
+  // The offsets are backpatched on finalize since the stream is append-only.
+  struct AOTIRHeader {
+    uint64_t Cookie;
+    uint64_t IndexOffset;    ///< AOTIRInlineIndex, entries sorted by guest RIP
+    uint64_t ModuleIDOffset;
+    uint64_t ModuleIDSize;
+  };
+
   struct AOTIRInlineEntry {
     uint64_t GuestHash;
     uint64_t GuestLength;
@@ -80,10 +91,19 @@ namespace FEXCore::IR {
     AOTIRInlineIndex *Array;
     void *FilePtr;
     size_t Size;
+    // Highest data-section chunk the phase prefetcher has advised ahead of.
+    // Benignly racy between compile threads.
+    uint64_t PrefetchCursor;
     std::unique_ptr<FEXCore::HLE::SourcecodeMap> SourcecodeMap;
     fextl::string FileId;
     fextl::string Filename;
     bool ContainsCode;
+    // Set for libraries whose code is latency critical on first execution,
+    // currently the guest unwinders (libgcc_s, libunwind). Blocks in these
+    // regions skip the baseline tier so the first guest exception throw pays
+    // one optimized compile instead of a baseline compile plus a recompile,
+    // and so their code is object-cache serializable from the first touch.
+    bool HighPriorityRegion;
   };
 
   using AOTCacheType = fextl::unordered_map<fextl::string, FEXCore::IR::AOTIRCacheEntry>;
@@ -135,6 +155,10 @@ namespace FEXCore::IR {
         AOTIRRenamer = std::move(CacheRenamer);
       }
 
+      void SetLibraryPriorityQuery(Context::LibraryPriorityCBFn Query) {
+        LibraryPriorityQuery = std::move(Query);
+      }
+
     private:
       FEXCore::Context::ContextImpl *CTX;
 
@@ -149,6 +173,7 @@ namespace FEXCore::IR {
       Context::AOTIRLoaderCBFn AOTIRLoader;
       Context::AOTIRWriterCBFn AOTIRWriter;
       Context::AOTIRRenamerCBFn AOTIRRenamer;
+      Context::LibraryPriorityCBFn LibraryPriorityQuery;
       fextl::unordered_map<fextl::string, FEXCore::IR::AOTIRCaptureCacheEntry> AOTIRCaptureCacheMap;
   };
 }
@@ -227,6 +227,17 @@ friend class FEXCore::IR::PassManager;
   void SetPackedRFLAG(bool Lower8, OrderedNode *Src);
   OrderedNode *GetPackedRFLAG(bool Lower8);
 
+  // Loads a captured IR view into this emitter's backing storage. Only the raw
+  // data and list buffers are loaded, node bookkeeping (write cursor, block
+  // list) is not reconstructed, so the result is only usable through ViewIR()
+  // by read-only consumers like the validation passes.
+  void LoadFromView(IRListView const &View) {
+    LOGMAN_THROW_A_FMT(View.GetDataSize() <= DualListData.DataBackingSize(), "Trying to load IR data that is too large");
+    LOGMAN_THROW_A_FMT(View.GetListSize() <= DualListData.ListBackingSize(), "Trying to load IR data that is too large");
+    DualListData.CopyData(reinterpret_cast<const void*>(View.GetData()), View.GetDataSize(),
+                          reinterpret_cast<const void*>(View.GetListData()), View.GetListSize());
+  }
+
   void CopyData(IREmitter const &rhs) {
     LOGMAN_THROW_A_FMT(rhs.DualListData.DataBackingSize() <= DualListData.DataBackingSize(), "Trying to take ownership of data that is too large");
     LOGMAN_THROW_A_FMT(rhs.DualListData.ListBackingSize() <= DualListData.ListBackingSize(), "Trying to take ownership of data that is too large");
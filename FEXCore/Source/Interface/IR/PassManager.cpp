@@ -13,7 +13,9 @@ $end_info$
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/CompileTimeTelemetry.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/fmt.h>
 
 namespace FEXCore::IR {
 class IREmitter;
@@ -70,22 +72,40 @@ void PassManager::AddDefaultPasses(FEXCore::Context::ContextImpl *ctx, bool Inli
   FEX_CONFIG_OPT(DisablePasses, O0);
 
   if (!DisablePasses()) {
-    InsertPass(CreateContextLoadStoreElimination(ctx->HostFeatures.SupportsAVX));
+    // These are all skipped when compiling at the baseline tier.
+    InsertOptimizationPass(CreateContextLoadStoreElimination(ctx->HostFeatures.SupportsAVX), "RCLSE");
 
     if (Is64BitMode()) {
       // This needs to run after RCLSE
       // This only matters for 64-bit code since these instructions don't exist in 32-bit
-      InsertPass(CreateLongDivideEliminationPass());
+      InsertOptimizationPass(CreateLongDivideEliminationPass(), "LongDivideElimination");
     }
 
-    InsertPass(CreateDeadStoreElimination(ctx->HostFeatures.SupportsAVX));
-    InsertPass(CreatePassDeadCodeElimination());
-    InsertPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9));
+    InsertOptimizationPass(CreateDeadStoreElimination(ctx->HostFeatures.SupportsAVX), "DeadStoreElimination");
+    InsertOptimizationPass(CreatePassDeadCodeElimination(), "DeadCodeElimination");
+    InsertOptimizationPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9), "ConstProp");
 
-    ////// InsertPass(CreateDeadFlagCalculationEliminination());
+    // Cross-block flag liveness, after ConstProp so branches have settled
+    InsertOptimizationPass(CreateDeadFlagCalculationEliminination(), "DeadFlagCalculationElimination");
 
-    InsertPass(CreateInlineCallOptimization(&ctx->CPUID));
-    InsertPass(CreatePassDeadCodeElimination());
+    // After ConstProp so invariant address math has already been folded into
+    // its simplest form, before DCE2 so anything hoisting orphaned gets swept.
+    InsertOptimizationPass(CreateLoopInvariantCodeMotion(), "LICM");
+
+    InsertOptimizationPass(CreateInlineCallOptimization(&ctx->CPUID), "InlineCallOptimization");
+    InsertOptimizationPass(CreatePassDeadCodeElimination(), "DeadCodeElimination2");
+
+    // Declared idiom fusions from IR.json. After the elimination passes so
+    // dead flag calculations no longer sit between the pattern ops.
+    InsertOptimizationPass(CreateSuperOpFusion(), "SuperOpFusion");
+
+    // After ConstProp so store offsets have folded to constants, after the
+    // elimination passes so only stores that will really be emitted get paired.
+    InsertOptimizationPass(CreateStorePairing(), "StorePairing");
+
+    // Last so it schedules the final op set. The backend emits in IR order,
+    // making this the machine schedule.
+    InsertOptimizationPass(CreateCodeScheduling(), "CodeScheduling");
   }
 
   // If the IR is compacted post-RA then the node indexing gets messed up and the backend isn't able to find the register assigned to a node
@@ -105,12 +125,44 @@ void PassManager::InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAV
   InsertPass(IR::CreateRegisterAllocationPass(GetPass("Compaction"), OptimizeSRA, SupportsAVX), "RA");
 }
 
-bool PassManager::Run(IREmitter *IREmit) {
+void PassManager::RegisterPassTimers() {
+  // Timers are shared per name, so the two threads compiling the same pass
+  // list accumulate into the same process-wide totals. Passes without a name
+  // (the IRDumpers Finalize can splice in) get a positional one.
+  PassTimers.clear();
+  PassTimers.reserve(Passes.size());
+  for (size_t i = 0; i < Passes.size(); ++i) {
+    const auto &Name = Passes[i]->GetName();
+    PassTimers.emplace_back(&CompileTime::RegisterPassTimer(
+      Name.empty() ? fextl::fmt::format("Pass{}", i) : Name));
+  }
+}
+
+bool PassManager::Run(IREmitter *IREmit, bool SkipOptimizationPasses) {
   FEXCORE_PROFILE_SCOPED("PassManager::Run");
 
+  const bool TimePasses = CompileTimeTelemetry();
+  if (TimePasses && PassTimers.size() != Passes.size()) {
+    // The pass list is stable by the time anything compiles, Finalize ran at
+    // thread creation. Register lazily so the disabled path stays untouched.
+    RegisterPassTimers();
+  }
+
   bool Changed = false;
-  for (auto const &Pass : Passes) {
-    Changed |= Pass->Run(IREmit);
+  for (size_t i = 0; i < Passes.size(); ++i) {
+    auto const &Pass = Passes[i];
+    if (SkipOptimizationPasses && OptimizationPasses.contains(Pass.get())) {
+      continue;
+    }
+
+    if (TimePasses) {
+      const uint64_t Start = CompileTime::Now();
+      Changed |= Pass->Run(IREmit);
+      PassTimers[i]->Add(CompileTime::Now() - Start);
+    }
+    else {
+      Changed |= Pass->Run(IREmit);
+    }
   }
 
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
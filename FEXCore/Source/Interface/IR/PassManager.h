@@ -8,12 +8,15 @@ $end_info$
 #pragma once
 
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/CompileTimeTelemetry.h>
 #include <FEXCore/Utils/ThreadPoolAllocator.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/unordered_set.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 
@@ -29,6 +32,28 @@ namespace FEXCore::IR {
 class PassManager;
 class IREmitter;
 
+// Scratch containers owned by passes are cleared and reused across
+// compilations instead of being reallocated every Run (reset-not-free).
+// The decaying high-water mark guards against a single enormous multiblock
+// region permanently inflating capacity: once the retained storage exceeds
+// several times the recent peak usage, the container is dropped wholesale so
+// the next compilation reallocates at a reasonable size.
+template<typename T>
+void TrimScratchCapacity(T &Container, size_t &HighWaterMark) {
+  HighWaterMark = std::max(Container.size(), HighWaterMark - (HighWaterMark >> 6));
+
+  size_t Capacity{};
+  if constexpr (requires { Container.capacity(); }) {
+    Capacity = Container.capacity();
+  } else {
+    Capacity = Container.bucket_count();
+  }
+
+  if (Capacity > (HighWaterMark * 4 + 64)) {
+    Container = T{};
+  }
+}
+
 class Pass {
 public:
   virtual ~Pass() = default;
@@ -38,8 +63,18 @@ public:
     Manager = _Manager;
   }
 
+  void SetName(fextl::string _Name) {
+    Name = std::move(_Name);
+  }
+
+  const fextl::string &GetName() const {
+    return Name;
+  }
+
 protected:
   PassManager *Manager;
+  // Human readable name for compile-time accounting, empty if never set.
+  fextl::string Name;
 };
 
 class PassManager final {
@@ -52,13 +87,22 @@ public:
 
     if (!Name.empty()) {
       NameToPassMaping[Name] = PassPtr;
+      PassPtr->SetName(std::move(Name));
     }
     return PassPtr;
   }
 
+  // Same as InsertPass but marks the pass as an optional optimization.
+  // Optional passes get skipped when compiling at the baseline tier.
+  Pass* InsertOptimizationPass(fextl::unique_ptr<Pass> Pass, fextl::string Name = "") {
+    auto PassPtr = InsertPass(std::move(Pass), std::move(Name));
+    OptimizationPasses.insert(PassPtr);
+    return PassPtr;
+  }
+
   void InsertRegisterAllocationPass(bool OptimizeSRA, bool SupportsAVX);
 
-  bool Run(IREmitter *IREmit);
+  bool Run(IREmitter *IREmit, bool SkipOptimizationPasses = false);
 
   bool HasPass(fextl::string Name) const {
     return NameToPassMaping.contains(Name);
@@ -90,6 +134,11 @@ private:
   }
   PassArrayType Passes;
   fextl::unordered_map<fextl::string, Pass*> NameToPassMaping;
+  fextl::unordered_set<Pass*> OptimizationPasses;
+
+  // Parallel to Passes once compile-time accounting has kicked in.
+  fextl::vector<FEXCore::CompileTime::PassTimer*> PassTimers;
+  void RegisterPassTimers();
 
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
   fextl::vector<fextl::unique_ptr<Pass>> ValidationPasses;
@@ -105,6 +154,7 @@ private:
 
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   FEX_CONFIG_OPT(PassManagerDumpIR, PASSMANAGERDUMPIR);
+  FEX_CONFIG_OPT(CompileTimeTelemetry, COMPILETIMETELEMETRY);
 };
 }
 
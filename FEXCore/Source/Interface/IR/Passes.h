@@ -16,6 +16,7 @@ class Pass;
 class RegisterAllocationPass;
 class RegisterAllocationData;
 
+fextl::unique_ptr<FEXCore::IR::Pass> CreateCodeScheduling();
 fextl::unique_ptr<FEXCore::IR::Pass> CreateConstProp(bool InlineConstants, bool SupportsTSOImm9);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateContextLoadStoreElimination(bool SupportsAVX);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateInlineCallOptimization(const FEXCore::CPUIDEmu* CPUID);
@@ -27,6 +28,9 @@ fextl::unique_ptr<FEXCore::IR::RegisterAllocationPass> CreateRegisterAllocationP
                                                                                   bool OptimizeSRA,
                                                                                   bool SupportsAVX);
 fextl::unique_ptr<FEXCore::IR::Pass> CreateLongDivideEliminationPass();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateLoopInvariantCodeMotion();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateStorePairing();
+fextl::unique_ptr<FEXCore::IR::Pass> CreateSuperOpFusion();
 
 namespace Validation {
 fextl::unique_ptr<FEXCore::IR::Pass> CreateIRValidation();
@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: ir|opts
+desc: Latency-aware scheduling of block ops ahead of in-order emission
+$end_info$
+*/
+
+#include "Interface/IR/IREmitter.h"
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <memory>
+#include <utility>
+
+namespace FEXCore::IR {
+
+// The backend emits ops strictly in IR order, so block op order is the final
+// machine schedule. This pass list-schedules each block by approximate result
+// latency so long-latency producers (loads, divides) issue as early as their
+// dependencies allow, instead of back-to-back with their consumers the way
+// the dispatcher emitted them. Modest out-of-order windows on Neoverse-class
+// cores can't hide a load feeding its consumer two instructions later.
+class CodeScheduling final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  // How an op may move relative to others. SSA dependencies are always
+  // respected on top of this.
+  enum class SchedClass {
+    // No ordering constraints beyond SSA. Pure computation only.
+    Movable,
+    // Reads guest memory, ordered against State ops (stores may alias, and a
+    // faulting load must not drift across a guest instruction boundary or
+    // committed state).
+    MemRead,
+    // Reads the context/register file/flags, ordered against context writes.
+    CtxRead,
+    // Commits guest-visible state or marks a guest instruction boundary:
+    // memory stores, context/register/flag stores, GuestOpcode markers.
+    // Mutually ordered, and ordered against the reads that alias them.
+    State,
+    // Everything else with side effects, plus anything coupled to host NZCV
+    // (implicit clobbers and readers). Ordered against all non-Movable ops.
+    Barrier,
+  };
+
+  static SchedClass ClassifyOp(IROps Op) {
+    // Implicit NZCV clobbers must stay ordered against NZCV ops, which are
+    // all classified Barrier; the cheap answer is to pin the clobbers too.
+    if (ImplicitFlagClobber(Op)) {
+      return SchedClass::Barrier;
+    }
+
+    switch (Op) {
+      case OP_LOADMEM:
+      case OP_LOADMEMTSO:
+      case OP_VLOADVECTORELEMENT:
+        return SchedClass::MemRead;
+
+      case OP_LOADCONTEXT:
+      case OP_LOADCONTEXTINDEXED:
+      case OP_LOADREGISTER:
+      case OP_LOADFLAG:
+        return SchedClass::CtxRead;
+
+      case OP_STOREMEM:
+      case OP_STOREMEMTSO:
+      case OP_VSTOREVECTORELEMENT:
+      case OP_VSTOREVECTORMASKED:
+      case OP_STORECONTEXT:
+      case OP_STORECONTEXTINDEXED:
+      case OP_STOREREGISTER:
+      case OP_STOREFLAG:
+      case OP_GUESTOPCODE:
+        return SchedClass::State;
+
+      // Reads host NZCV, which Barrier-classified ops produce and clobber
+      case OP_LOADNZCV:
+        return SchedClass::Barrier;
+
+      default:
+        return HasSideEffects(Op) ? SchedClass::Barrier : SchedClass::Movable;
+    }
+  }
+
+  // Approximate result latencies on a Neoverse-class core. Only relative
+  // magnitudes matter; they decide which dependency chains start early.
+  static uint32_t OpLatency(IROps Op) {
+    switch (Op) {
+      case OP_LOADMEM:
+      case OP_LOADMEMTSO:
+      case OP_LOADCONTEXT:
+      case OP_LOADCONTEXTINDEXED:
+      case OP_LOADREGISTER:
+      case OP_LOADNAMEDVECTORCONSTANT:
+      case OP_LOADNAMEDVECTORINDEXEDCONSTANT:
+      case OP_VLOADVECTORELEMENT:
+      case OP_VLOADVECTORMASKED:
+        return 4; // L1 hit
+      case OP_MUL:
+      case OP_UMUL:
+      case OP_MULH:
+      case OP_UMULH:
+      case OP_UMULL:
+      case OP_VMUL:
+      case OP_VSMULL:
+      case OP_VUMULL:
+        return 3;
+      case OP_VFDIV:
+      case OP_VFSQRT:
+      case OP_VFRSQRT:
+        return 10;
+      case OP_DIV:
+      case OP_UDIV:
+      case OP_REM:
+      case OP_UREM:
+      case OP_LDIV:
+      case OP_LUDIV:
+      case OP_LREM:
+      case OP_LUREM:
+        return 12;
+      default:
+        return 1;
+    }
+  }
+
+  // Blocks past this size skip scheduling; the selection loop is quadratic
+  // and a block this large is already compile-time trouble elsewhere.
+  constexpr static size_t MaxRegionSize = 4096;
+
+  struct RegionOp {
+    OrderedNode *Node;
+    IROps Op;
+    SchedClass Class;
+    uint32_t Priority;
+    uint32_t InDegree;
+  };
+
+  // Scratch storage reset and reused across compilations
+  fextl::vector<RegionOp> Region{};
+  fextl::robin_map<uint32_t, uint32_t> DefIndex{};
+  fextl::vector<std::pair<uint32_t, uint32_t>> Edges{};
+  fextl::vector<uint32_t> SuccOffsets{};
+  fextl::vector<uint32_t> Succs{};
+  fextl::vector<uint32_t> Ready{};
+  fextl::vector<uint32_t> Schedule{};
+  fextl::vector<uint32_t> PendingMemReads{};
+  fextl::vector<uint32_t> PendingCtxReads{};
+  size_t RegionHighWater{};
+  size_t DefIndexHighWater{};
+  size_t EdgesHighWater{};
+
+  bool ScheduleBlock(IRListView &CurrentIR, OrderedNode *BlockNode, IROp_Header *BlockHeader);
+};
+
+bool CodeScheduling::ScheduleBlock(IRListView &CurrentIR, OrderedNode *BlockNode, IROp_Header *BlockHeader) {
+  const uintptr_t ListBegin = CurrentIR.GetListData();
+
+  auto BlockIROp = BlockHeader->CW<IROp_CodeBlock>();
+
+  // Collect the block's ops. The trailing terminator (and EndBlock when
+  // present) stays pinned in place and doubles as the relink anchor.
+  Region.clear();
+  DefIndex.clear();
+  for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+    Region.push_back(RegionOp {
+      .Node = CodeNode,
+      .Op = IROp->Op,
+      .Class = ClassifyOp(IROp->Op),
+      .Priority = OpLatency(IROp->Op),
+      .InDegree = 0,
+    });
+  }
+
+  if (Region.size() < 4 || Region.size() > MaxRegionSize) {
+    return false;
+  }
+
+  OrderedNode *Anchor = Region.back().Node;
+  Region.pop_back();
+  if (Region.back().Op == OP_ENDBLOCK) {
+    Anchor = Region.back().Node;
+    Region.pop_back();
+  }
+
+  const uint32_t NumOps = Region.size();
+  for (uint32_t i = 0; i < NumOps; ++i) {
+    DefIndex[CurrentIR.GetID(Region[i].Node).Value] = i;
+  }
+
+  // Build the dependency DAG. Edges always point from the earlier op to the
+  // later one, so indices are topologically ordered from the start.
+  Edges.clear();
+  PendingMemReads.clear();
+  PendingCtxReads.clear();
+
+  // BeginBlock anchors the block's entry point, everything stays behind it
+  const bool PinnedHead = Region[0].Op == OP_BEGINBLOCK;
+
+  uint32_t LastState = ~0U;
+  uint32_t LastCtxWrite = ~0U;
+  for (uint32_t i = 0; i < NumOps; ++i) {
+    auto &Op = Region[i];
+
+    if (PinnedHead && i != 0) {
+      Edges.emplace_back(0, i);
+    }
+
+    // SSA value dependencies on defs within this block
+    auto *IROp = Op.Node->Op(CurrentIR.GetData());
+    const uint8_t NumArgs = IR::GetArgs(Op.Op);
+    for (uint8_t Arg = 0; Arg < NumArgs; ++Arg) {
+      if (IROp->Args[Arg].IsInvalid()) {
+        continue;
+      }
+      auto Def = DefIndex.find(IROp->Args[Arg].ID().Value);
+      if (Def != DefIndex.end() && Def->second != i) {
+        Edges.emplace_back(Def->second, i);
+      }
+    }
+
+    // Ordering dependencies per class
+    switch (Op.Class) {
+      case SchedClass::Movable:
+        break;
+      case SchedClass::MemRead:
+        if (LastState != ~0U) {
+          Edges.emplace_back(LastState, i);
+        }
+        PendingMemReads.push_back(i);
+        break;
+      case SchedClass::CtxRead:
+        if (LastCtxWrite != ~0U) {
+          Edges.emplace_back(LastCtxWrite, i);
+        }
+        PendingCtxReads.push_back(i);
+        break;
+      case SchedClass::Barrier:
+        for (auto Read : PendingCtxReads) {
+          Edges.emplace_back(Read, i);
+        }
+        PendingCtxReads.clear();
+        LastCtxWrite = i;
+        [[fallthrough]];
+      case SchedClass::State:
+        if (LastState != ~0U) {
+          Edges.emplace_back(LastState, i);
+        }
+        for (auto Read : PendingMemReads) {
+          Edges.emplace_back(Read, i);
+        }
+        PendingMemReads.clear();
+        LastState = i;
+
+        // Context writes are State class; they additionally order against the
+        // context reads accumulated since the last context write.
+        if (Op.Class == SchedClass::State &&
+            (Op.Op == OP_STORECONTEXT || Op.Op == OP_STORECONTEXTINDEXED ||
+             Op.Op == OP_STOREREGISTER || Op.Op == OP_STOREFLAG)) {
+          for (auto Read : PendingCtxReads) {
+            Edges.emplace_back(Read, i);
+          }
+          PendingCtxReads.clear();
+          LastCtxWrite = i;
+        }
+        break;
+    }
+  }
+
+  // CSR adjacency plus indegrees
+  SuccOffsets.assign(NumOps + 1, 0);
+  for (auto &[From, To] : Edges) {
+    ++SuccOffsets[From + 1];
+    ++Region[To].InDegree;
+  }
+  for (uint32_t i = 0; i < NumOps; ++i) {
+    SuccOffsets[i + 1] += SuccOffsets[i];
+  }
+  Succs.resize(Edges.size());
+  {
+    fextl::vector<uint32_t> &Cursor = Ready; // reuse as scratch cursor
+    Cursor.assign(SuccOffsets.begin(), SuccOffsets.end() - 1);
+    for (auto &[From, To] : Edges) {
+      Succs[Cursor[From]++] = To;
+    }
+  }
+
+  // Priority is the latency-weighted critical path to the end of the block.
+  // Edges only point forward, so a reverse sweep sees successors first.
+  for (uint32_t i = NumOps; i-- != 0;) {
+    for (uint32_t s = SuccOffsets[i]; s != SuccOffsets[i + 1]; ++s) {
+      Region[i].Priority = std::max(Region[i].Priority, OpLatency(Region[i].Op) + Region[Succs[s]].Priority);
+    }
+  }
+
+  // Forward list scheduling: always issue the ready op with the longest
+  // remaining critical path, original order breaking ties so untouched code
+  // stays byte-identical.
+  Ready.clear();
+  Schedule.clear();
+  for (uint32_t i = 0; i < NumOps; ++i) {
+    if (Region[i].InDegree == 0) {
+      Ready.push_back(i);
+    }
+  }
+
+  while (!Ready.empty()) {
+    size_t Best = 0;
+    for (size_t r = 1; r < Ready.size(); ++r) {
+      const auto &Candidate = Region[Ready[r]];
+      const auto &Current = Region[Ready[Best]];
+      if (Candidate.Priority > Current.Priority ||
+          (Candidate.Priority == Current.Priority && Ready[r] < Ready[Best])) {
+        Best = r;
+      }
+    }
+
+    const uint32_t Picked = Ready[Best];
+    Ready[Best] = Ready.back();
+    Ready.pop_back();
+    Schedule.push_back(Picked);
+
+    for (uint32_t s = SuccOffsets[Picked]; s != SuccOffsets[Picked + 1]; ++s) {
+      if (--Region[Succs[s]].InDegree == 0) {
+        Ready.push_back(Succs[s]);
+      }
+    }
+  }
+
+  LOGMAN_THROW_AA_FMT(Schedule.size() == NumOps, "Scheduling dropped ops");
+
+  bool Changed = false;
+  for (uint32_t i = 0; i < NumOps; ++i) {
+    if (Schedule[i] != i) {
+      Changed = true;
+      break;
+    }
+  }
+
+  if (!Changed) {
+    return false;
+  }
+
+  // Relink the ops in schedule order just ahead of the pinned tail
+  for (uint32_t i = NumOps; i-- != 0;) {
+    OrderedNode *Node = Region[Schedule[i]].Node;
+    Node->Unlink(ListBegin);
+    Anchor = Anchor->prepend(ListBegin, Node);
+  }
+
+  BlockIROp->Begin = Region[Schedule[0]].Node->Wrapped(ListBegin);
+
+  return true;
+}
+
+bool CodeScheduling::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::CodeScheduling");
+
+  auto CurrentIR = IREmit->ViewIR();
+  bool Changed = false;
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    Changed |= ScheduleBlock(CurrentIR, BlockNode, BlockHeader);
+  }
+
+  TrimScratchCapacity(Region, RegionHighWater);
+  TrimScratchCapacity(DefIndex, DefIndexHighWater);
+  TrimScratchCapacity(Edges, EdgesHighWater);
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateCodeScheduling() {
+  return fextl::make_unique<CodeScheduling>();
+}
+
+}
@@ -20,10 +20,11 @@ $end_info$
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Profiler.h>
-#include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/small_flat_map.h>
 #include <FEXCore/fextl/unordered_map.h>
 
+#include <algorithm>
 #include <bit>
 #include <cstdint>
 #include <memory>
@@ -91,18 +92,25 @@ static bool IsTSOImm9(uint64_t imm) {
 }
 
 static std::tuple<MemOffsetType, uint8_t, OrderedNode*, OrderedNode*> MemExtendedAddressing(IREmitter *IREmit, uint8_t AccessSize,  IROp_Header* AddressHeader) {
-  auto Src0Header = IREmit->GetOpHeader(AddressHeader->Args[0]);
-  if (Src0Header->Size == 8) {
+  // The add is commutative and the guest address space identity-maps on to the
+  // host, so either operand can act as the base. Try the scaled/extended
+  // offset pattern on both sides before falling back to plain reg+reg.
+  for (size_t Side = 0; Side < 2; ++Side) {
+    auto Src0Header = IREmit->GetOpHeader(AddressHeader->Args[Side]);
+    auto Base = IREmit->UnwrapNode(AddressHeader->Args[Side ^ 1]);
+    if (Src0Header->Size != 8) {
+      continue;
+    }
     //Try to optimize: Base + MUL(Offset, Scale)
     if (Src0Header->Op == OP_MUL) {
       uint64_t Scale;
       if (IREmit->IsValueConstant(Src0Header->Args[1], &Scale)) {
         if (IsMemoryScale(Scale, AccessSize)) {
           // remove mul as it can be folded to the mem op
-          return { MEM_OFFSET_SXTX, (uint8_t)Scale, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
+          return { MEM_OFFSET_SXTX, (uint8_t)Scale, Base, IREmit->UnwrapNode(Src0Header->Args[0]) };
         } else if (Scale == 1) {
           // remove nop mul
-          return { MEM_OFFSET_SXTX, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
+          return { MEM_OFFSET_SXTX, 1, Base, IREmit->UnwrapNode(Src0Header->Args[0]) };
         }
       }
     }
@@ -113,10 +121,10 @@ static std::tuple<MemOffsetType, uint8_t, OrderedNode*, OrderedNode*> MemExtende
         uint64_t Scale = 1<<Constant2;
         if (IsMemoryScale(Scale, AccessSize)) {
           // remove shift as it can be folded to the mem op
-          return { MEM_OFFSET_SXTX, Scale, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
+          return { MEM_OFFSET_SXTX, Scale, Base, IREmit->UnwrapNode(Src0Header->Args[0]) };
         } else if (Scale == 1) {
           // remove nop shift
-          return { MEM_OFFSET_SXTX, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
+          return { MEM_OFFSET_SXTX, 1, Base, IREmit->UnwrapNode(Src0Header->Args[0]) };
         }
       }
     }
@@ -126,7 +134,7 @@ static std::tuple<MemOffsetType, uint8_t, OrderedNode*, OrderedNode*> MemExtende
       auto Bfe = Src0Header->C<IROp_Bfe>();
       if (Bfe->lsb == 0 && Bfe->Width == 32) {
         //todo: arm can also scale here
-        return { MEM_OFFSET_UXTW, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
+        return { MEM_OFFSET_UXTW, 1, Base, IREmit->UnwrapNode(Src0Header->Args[0]) };
       }
     }
     //Try to optimize: Base + (s32)Offset
@@ -134,7 +142,7 @@ static std::tuple<MemOffsetType, uint8_t, OrderedNode*, OrderedNode*> MemExtende
       auto Sbfe = Src0Header->C<IROp_Sbfe>();
       if (Sbfe->lsb == 0 && Sbfe->Width == 32) {
         //todo: arm can also scale here
-        return { MEM_OFFSET_SXTW, 1, IREmit->UnwrapNode(AddressHeader->Args[1]), IREmit->UnwrapNode(Src0Header->Args[0]) };
+        return { MEM_OFFSET_SXTW, 1, Base, IREmit->UnwrapNode(Src0Header->Args[0]) };
       }
     }
 #endif
@@ -171,6 +179,32 @@ static OrderedNodeWrapper RemoveUselessMasking(IREmitter *IREmit, OrderedNodeWra
 #endif
 }
 
+// Vector operand patterns constprop can reason about without materializing
+// element data: all bits clear and all bits set. Compiler-generated guest
+// code reaches these constantly through zeroing and masking idioms.
+enum class VectorConstant { None, Zero, AllOnes };
+
+static VectorConstant ClassifyVectorConstant(IREmitter *IREmit, OrderedNodeWrapper Arg) {
+  auto Header = IREmit->GetOpHeader(Arg);
+  if (Header->Op == OP_VECTORZERO) {
+    return VectorConstant::Zero;
+  }
+
+  if (Header->Op == OP_VECTORIMM) {
+    auto Op = Header->C<IR::IROp_VectorImm>();
+    if (Op->Immediate == 0) {
+      return VectorConstant::Zero;
+    }
+    // A byte splat of 0xFF is the only immediate pattern that sets every bit
+    // regardless of element size.
+    if (Header->ElementSize == 1 && Op->Immediate == 0xFF && Op->ShiftAmount == 0) {
+      return VectorConstant::AllOnes;
+    }
+  }
+
+  return VectorConstant::None;
+}
+
 static bool IsBfeAlreadyDone(IREmitter *IREmit, OrderedNodeWrapper src, uint64_t Width) {
   auto IROp = IREmit->GetOpHeader(src);
   if (IROp->Op == OP_BFE) {
@@ -205,8 +239,19 @@ private:
     OrderedNode *Node;
     IR::NodeID NodeID;
   };
-  fextl::unordered_map<uint64_t, ConstPoolData> ConstPool;
-  fextl::map<OrderedNode*, uint64_t> AddressgenConsts;
+  // Pools are tracked per block and inherited along single-predecessor edges.
+  // A block's sole predecessor dominates it, so values pooled there are safe
+  // to reuse; blocks with merging control flow start from an empty pool.
+  // The per-block pools are small and rebuilt for every block, so they use
+  // flat maps with inline storage; inheriting a predecessor's pool is then a
+  // contiguous copy rather than a node-by-node rebuild. The outer maps stay
+  // node based since references into them are held across pool inheritance.
+  fextl::unordered_map<IR::NodeID, fextl::small_flat_map<uint64_t, ConstPoolData, 16>> BlockConstPools;
+  fextl::unordered_map<IR::NodeID, fextl::small_flat_map<OrderedNode*, uint64_t, 8>> BlockAddressgenConsts;
+
+  // Maps a block to its sole predecessor, for blocks that have exactly one.
+  fextl::small_flat_map<IR::NodeID, IR::NodeID, 32> SinglePredecessor;
+  void CalculateSinglePredecessors(const IRListView& CurrentIR);
 
   // Pool inline constant generation. These are typically very small and pool efficiently.
   fextl::robin_map<uint64_t, OrderedNode*> InlineConstantGen;
@@ -219,6 +264,44 @@ private:
     return Result.first->second;
   }
   bool SupportsTSOImm9{};
+
+  // Lower bound on the alignment of an address expression, derived by walking
+  // its definition chain. Returns 1 when nothing can be proven, capped at 16.
+  // Used to record proven natural alignment on the TSO memory ops so the
+  // backend can drop their alignment-fault backpatch pads.
+  uint64_t KnownAlignment(IREmitter *IREmit, OrderedNodeWrapper Arg, uint32_t Depth) {
+    constexpr uint64_t MaxAlign = 16;
+    uint64_t Constant{};
+    if (IREmit->IsValueConstant(Arg, &Constant)) {
+      return Constant ? std::min(MaxAlign, uint64_t{1} << std::countr_zero(Constant)) : MaxAlign;
+    }
+
+    if (Depth >= 8) {
+      return 1;
+    }
+
+    auto Header = IREmit->GetOpHeader(Arg);
+    switch (Header->Op) {
+      case OP_ADD:
+      case OP_SUB:
+        return std::min(KnownAlignment(IREmit, Header->Args[0], Depth + 1),
+                        KnownAlignment(IREmit, Header->Args[1], Depth + 1));
+      case OP_AND:
+        // Low bits clear in either operand stay clear in the result. This
+        // catches explicit stack realignment in the guest.
+        return std::max(KnownAlignment(IREmit, Header->Args[0], Depth + 1),
+                        KnownAlignment(IREmit, Header->Args[1], Depth + 1));
+      case OP_LSHL:
+        if (IREmit->IsValueConstant(Header->Args[1], &Constant)) {
+          const uint64_t Shift = std::min(Constant, uint64_t{4});
+          return std::min(MaxAlign, KnownAlignment(IREmit, Header->Args[0], Depth + 1) << Shift);
+        }
+        return 1;
+      default:
+        return 1;
+    }
+  }
+
   // This is a heuristic to limit constant pool live ranges to reduce RA interference pressure.
   // If the range is unbounded then RA interference pressure seems to increase to the point
   // that long blocks of constant usage can slow to a crawl.
@@ -226,11 +309,51 @@ private:
   constexpr static uint32_t CONSTANT_POOL_RANGE_LIMIT = 200;
 };
 
+void ConstProp::CalculateSinglePredecessors(const IRListView& CurrentIR) {
+  // An invalid NodeID marks blocks with merging control flow.
+  auto AddEdge = [this](IR::NodeID From, IR::NodeID To) {
+    auto Inserted = SinglePredecessor.try_emplace(To, From);
+    if (!Inserted.second) {
+      Inserted.first->second = IR::NodeID{};
+    }
+  };
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    const auto BlockID = CurrentIR.GetID(BlockNode);
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (IROp->Op == OP_CONDJUMP) {
+        auto Op = IROp->C<IR::IROp_CondJump>();
+        AddEdge(BlockID, Op->TrueBlock.ID());
+        AddEdge(BlockID, Op->FalseBlock.ID());
+      }
+      else if (IROp->Op == OP_JUMP) {
+        AddEdge(BlockID, IROp->Args[0].ID());
+      }
+    }
+  }
+}
+
 bool ConstProp::HandleConstantPools(IREmitter *IREmit, const IRListView& CurrentIR) {
   bool Changed = false;
 
-  // constants are pooled per block
+  // Constants are pooled along single-predecessor chains. Segment bases,
+  // stack-frame constants and GOT addresses regenerated in every block of a
+  // region collapse to the dominating definition this way.
   for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    const auto BlockID = CurrentIR.GetID(BlockNode);
+    auto &ConstPool = BlockConstPools.try_emplace(BlockID).first->second;
+
+    auto Pred = SinglePredecessor.find(BlockID);
+    if (Pred != SinglePredecessor.end() && Pred->second.IsValid()) {
+      // Only inherit from predecessors already visited in layout order; a
+      // back edge means the predecessor doesn't dominate this block.
+      auto PredPool = BlockConstPools.find(Pred->second);
+      if (PredPool != BlockConstPools.end()) {
+        ConstPool = PredPool->second;
+      }
+    }
+
     for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
       if (IROp->Op == OP_CONSTANT) {
         auto Op = IROp->C<IR::IROp_Constant>();
@@ -259,8 +382,8 @@ bool ConstProp::HandleConstantPools(IREmitter *IREmit, const IRListView& Current
         }
       }
     }
-    ConstPool.clear();
   }
+  BlockConstPools.clear();
 
   return Changed;
 }
@@ -269,6 +392,19 @@ bool ConstProp::HandleConstantPools(IREmitter *IREmit, const IRListView& Current
 // If imms are close by, use address gen to generate the values instead of using a new imm
 void ConstProp::LoadMemStoreMemImmediatePooling(IREmitter *IREmit, const IRListView& CurrentIR) {
   for (auto [BlockNode, BlockIROp] : CurrentIR.GetBlocks()) {
+    const auto BlockID = CurrentIR.GetID(BlockNode);
+    auto &AddressgenConsts = BlockAddressgenConsts.try_emplace(BlockID).first->second;
+
+    // Inherit address bases from a dominating single predecessor, same as the
+    // constant pools above.
+    auto Pred = SinglePredecessor.find(BlockID);
+    if (Pred != SinglePredecessor.end() && Pred->second.IsValid()) {
+      auto PredConsts = BlockAddressgenConsts.find(Pred->second);
+      if (PredConsts != BlockAddressgenConsts.end()) {
+        AddressgenConsts = PredConsts->second;
+      }
+    }
+
     for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
       if (IROp->Op == OP_LOADMEM || IROp->Op == OP_STOREMEM) {
         size_t AddrIndex = 0;
@@ -300,8 +436,8 @@ void ConstProp::LoadMemStoreMemImmediatePooling(IREmitter *IREmit, const IRListV
       }
       IREmit->SetWriteCursor(CodeNode);
     }
-    AddressgenConsts.clear();
   }
+  BlockAddressgenConsts.clear();
 }
 
 bool ConstProp::ZextAndMaskingElimination(IREmitter *IREmit, const IRListView& CurrentIR,
@@ -487,6 +623,15 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
       auto Op = IROp->CW<IR::IROp_LoadMemTSO>();
       auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
 
+      // Atomic acquire forms alignment-fault on unaligned addresses. Record
+      // proven natural alignment so the backend can skip the backpatch pad
+      // for accesses that can't fault.
+      if (Op->Class == FEXCore::IR::GPRClass && Op->Align < IROp->Size && Op->Offset.IsInvalid() &&
+          KnownAlignment(IREmit, Op->Addr, 0) >= IROp->Size) {
+        Op->Align = IROp->Size;
+        Changed = true;
+      }
+
       if (Op->Class == FEXCore::IR::FPRClass && AddressHeader->Op == OP_ADD && AddressHeader->Size == 8) {
         // TODO: LRCPC3 supports a vector unscaled offset like LRCPC2.
         // Support once hardware is available to use this.
@@ -506,6 +651,13 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
       auto Op = IROp->CW<IR::IROp_StoreMemTSO>();
       auto AddressHeader = IREmit->GetOpHeader(Op->Addr);
 
+      // Same as the load case, proven alignment elides the backpatch pad.
+      if (Op->Class == FEXCore::IR::GPRClass && Op->Align < IROp->Size && Op->Offset.IsInvalid() &&
+          KnownAlignment(IREmit, Op->Addr, 0) >= IROp->Size) {
+        Op->Align = IROp->Size;
+        Changed = true;
+      }
+
       if (Op->Class == FEXCore::IR::FPRClass && AddressHeader->Op == OP_ADD && AddressHeader->Size == 8) {
         // TODO: LRCPC3 supports a vector unscaled offset like LRCPC2.
         // Support once hardware is available to use this.
@@ -901,25 +1053,227 @@ bool ConstProp::ConstantPropagation(IREmitter *IREmit, const IRListView& Current
       }
       break;
     }
+    case OP_PDEP:
+    case OP_PEXT: {
+      // Guests overwhelmingly use these with a constant mask describing a
+      // bitfield. With a contiguous mask the whole operation strength-reduces
+      // to a bitfield extract/insert, dodging the backend's bit-by-bit loop.
+      auto Op = IROp->C<IR::IROp_PDep>();
+      const bool IsPDep = IROp->Op == OP_PDEP;
+      uint64_t Input{};
+      uint64_t Mask{};
+
+      if (!IREmit->IsValueConstant(Op->Mask, &Mask)) {
+        break;
+      }
+      Mask &= getMask(IROp);
+
+      if (IREmit->IsValueConstant(Op->Input, &Input)) {
+        uint64_t NewConstant{};
+        for (uint64_t Bit = 1, Select = Mask; Select != 0; Select &= Select - 1, Bit <<= 1) {
+          const uint64_t MaskBit = Select & -Select;
+          if (Input & (IsPDep ? Bit : MaskBit)) {
+            NewConstant |= IsPDep ? MaskBit : Bit;
+          }
+        }
+        IREmit->ReplaceWithConstant(CodeNode, NewConstant);
+        Changed = true;
+        break;
+      }
+
+      if (Mask == 0) {
+        IREmit->ReplaceWithConstant(CodeNode, 0);
+        Changed = true;
+        break;
+      }
+
+      const uint64_t Lsb = std::countr_zero(Mask);
+      const uint64_t Width = std::popcount(Mask);
+      const bool Contiguous = ((Mask >> Lsb) & ((Mask >> Lsb) + 1)) == 0;
+      if (!Contiguous || Width == IROp->Size * 8) {
+        break;
+      }
+
+      IREmit->SetWriteCursor(CodeNode);
+      if (IsPDep) {
+        // PDEP with a contiguous mask deposits the low Width bits at Lsb.
+        auto Field = IREmit->_Bfe(IR::SizeToOpSize(IROp->Size), Width, 0, CurrentIR.GetNode(Op->Input));
+        IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_Lshl(IR::SizeToOpSize(IROp->Size), Field, IREmit->_Constant(Lsb)));
+      } else {
+        // PEXT with a contiguous mask is exactly a bitfield extract.
+        IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_Bfe(IR::SizeToOpSize(IROp->Size), Width, Lsb, CurrentIR.GetNode(Op->Input)));
+      }
+      Changed = true;
+      break;
+    }
     case OP_SELECT: {
       auto Op = IROp->C<IR::IROp_Select>();
       uint64_t Constant1{};
       uint64_t Constant2{};
 
       if (IREmit->IsValueConstant(Op->Header.Args[0], &Constant1) &&
-          IREmit->IsValueConstant(Op->Header.Args[1], &Constant2) &&
-          Op->Cond == COND_EQ) {
+          IREmit->IsValueConstant(Op->Header.Args[1], &Constant2)) {
 
         Constant1 &= getMask(Op);
         Constant2 &= getMask(Op);
 
-        bool is_true = Constant1 == Constant2;
+        bool is_true{};
+        switch (Op->Cond) {
+          case COND_EQ:  is_true = Constant1 == Constant2; break;
+          case COND_NEQ: is_true = Constant1 != Constant2; break;
+          case COND_UGE: is_true = Constant1 >= Constant2; break;
+          case COND_ULT: is_true = Constant1 <  Constant2; break;
+          case COND_UGT: is_true = Constant1 >  Constant2; break;
+          case COND_ULE: is_true = Constant1 <= Constant2; break;
+          // Signed and float conditions left to the backend.
+          default: return Changed;
+        }
 
         IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(Op->Header.Args[is_true ? 2 : 3]));
         Changed = true;
       }
       break;
     }
+    // Vector identity and zero idioms. Forwarding an operand is only safe
+    // when its register size matches this op's - a narrower source can carry
+    // garbage in the bits this op would have zeroed (see the OP_VMOV note in
+    // ZextAndMaskingElimination).
+    case OP_VXOR: {
+      if (IROp->Args[0].ID() == IROp->Args[1].ID()) {
+        // Standard vector zeroing idiom, pxor xmm0, xmm0.
+        IREmit->SetWriteCursor(CodeNode);
+        IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_VectorZero(IROp->Size));
+        Changed = true;
+        break;
+      }
+
+      for (unsigned i = 0; i < 2; ++i) {
+        if (ClassifyVectorConstant(IREmit, IROp->Args[i]) != VectorConstant::Zero) {
+          continue;
+        }
+
+        if (IREmit->GetOpHeader(IROp->Args[i ^ 1])->Size != IROp->Size) {
+          break;
+        }
+
+        IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[i ^ 1]));
+        Changed = true;
+        break;
+      }
+      break;
+    }
+    case OP_VOR: {
+      if (IROp->Args[0].ID() == IROp->Args[1].ID()) {
+        if (IREmit->GetOpHeader(IROp->Args[0])->Size == IROp->Size) {
+          IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[0]));
+          Changed = true;
+        }
+        break;
+      }
+
+      for (unsigned i = 0; i < 2; ++i) {
+        const auto Kind = ClassifyVectorConstant(IREmit, IROp->Args[i]);
+        if (Kind == VectorConstant::Zero) {
+          if (IREmit->GetOpHeader(IROp->Args[i ^ 1])->Size != IROp->Size) {
+            break;
+          }
+
+          IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[i ^ 1]));
+          Changed = true;
+          break;
+        } else if (Kind == VectorConstant::AllOnes) {
+          IREmit->SetWriteCursor(CodeNode);
+          IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_VectorImm(IROp->Size, 1, 0xFF));
+          Changed = true;
+          break;
+        }
+      }
+      break;
+    }
+    case OP_VAND: {
+      if (IROp->Args[0].ID() == IROp->Args[1].ID()) {
+        if (IREmit->GetOpHeader(IROp->Args[0])->Size == IROp->Size) {
+          IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[0]));
+          Changed = true;
+        }
+        break;
+      }
+
+      for (unsigned i = 0; i < 2; ++i) {
+        const auto Kind = ClassifyVectorConstant(IREmit, IROp->Args[i]);
+        if (Kind == VectorConstant::Zero) {
+          IREmit->SetWriteCursor(CodeNode);
+          IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_VectorZero(IROp->Size));
+          Changed = true;
+          break;
+        } else if (Kind == VectorConstant::AllOnes) {
+          // AND with all-ones is the identity, common from constant masks.
+          if (IREmit->GetOpHeader(IROp->Args[i ^ 1])->Size != IROp->Size) {
+            break;
+          }
+
+          IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[i ^ 1]));
+          Changed = true;
+          break;
+        }
+      }
+      break;
+    }
+    case OP_VBIC: {
+      // Dest = Args[0] & ~Args[1]
+      const auto Kind0 = ClassifyVectorConstant(IREmit, IROp->Args[0]);
+      const auto Kind1 = ClassifyVectorConstant(IREmit, IROp->Args[1]);
+
+      if (IROp->Args[0].ID() == IROp->Args[1].ID() ||
+          Kind0 == VectorConstant::Zero ||
+          Kind1 == VectorConstant::AllOnes) {
+        IREmit->SetWriteCursor(CodeNode);
+        IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_VectorZero(IROp->Size));
+        Changed = true;
+      } else if (Kind1 == VectorConstant::Zero &&
+                 IREmit->GetOpHeader(IROp->Args[0])->Size == IROp->Size) {
+        IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[0]));
+        Changed = true;
+      }
+      break;
+    }
+    case OP_VADD: {
+      for (unsigned i = 0; i < 2; ++i) {
+        if (ClassifyVectorConstant(IREmit, IROp->Args[i]) != VectorConstant::Zero) {
+          continue;
+        }
+
+        if (IREmit->GetOpHeader(IROp->Args[i ^ 1])->Size != IROp->Size) {
+          break;
+        }
+
+        IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[i ^ 1]));
+        Changed = true;
+        break;
+      }
+      break;
+    }
+    case OP_VSUB: {
+      if (ClassifyVectorConstant(IREmit, IROp->Args[1]) == VectorConstant::Zero &&
+          IREmit->GetOpHeader(IROp->Args[0])->Size == IROp->Size) {
+        IREmit->ReplaceAllUsesWith(CodeNode, CurrentIR.GetNode(IROp->Args[0]));
+        Changed = true;
+      }
+      break;
+    }
+    case OP_VNOT: {
+      const auto Kind = ClassifyVectorConstant(IREmit, IROp->Args[0]);
+      if (Kind == VectorConstant::Zero) {
+        IREmit->SetWriteCursor(CodeNode);
+        IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_VectorImm(IROp->Size, 1, 0xFF));
+        Changed = true;
+      } else if (Kind == VectorConstant::AllOnes) {
+        IREmit->SetWriteCursor(CodeNode);
+        IREmit->ReplaceAllUsesWith(CodeNode, IREmit->_VectorZero(IROp->Size));
+        Changed = true;
+      }
+      break;
+    }
     default:
       break;
     }
@@ -1093,9 +1447,47 @@ bool ConstProp::ConstantInlining(IREmitter *IREmit, const IRListView& CurrentIR)
       }
       case OP_CONDJUMP:
       {
-        auto Op = IROp->C<IR::IROp_CondJump>();
+        auto Op = IROp->CW<IR::IROp_CondJump>();
 
         uint64_t Constant2{};
+        if (!Op->FromNZCV &&
+            (Op->Cond.Val == COND_EQ || Op->Cond.Val == COND_NEQ) &&
+            IREmit->IsValueConstant(Op->Header.Args[1], &Constant2) &&
+            Constant2 == 0) {
+          // Zero compares against a single-bit value can branch on the bit
+          // directly with tbz/tbnz, skipping the masking op entirely.
+          auto Cmp1 = IREmit->GetOpHeader(Op->Header.Args[0]);
+
+          uint64_t BitMask{};
+          if (Cmp1->Op == OP_AND &&
+              IREmit->IsValueConstant(Cmp1->Args[1], &BitMask) &&
+              std::popcount(BitMask) == 1 &&
+              BitMask < (1ULL << (Cmp1->Size * 8))) {
+            // (x & (1 << b)) == 0 only tests bit b of x
+            IREmit->SetWriteCursor(CurrentIR.GetNode(Op->Header.Args[1]));
+            IREmit->ReplaceNodeArgument(CodeNode, 0, CurrentIR.GetNode(Cmp1->Args[0]));
+            IREmit->ReplaceNodeArgument(CodeNode, 1, CreateInlineConstant(IREmit, BitMask));
+            Op->CompareSize = Cmp1->Size;
+
+            Changed = true;
+            break;
+          }
+
+          if (Cmp1->Op == OP_BFE) {
+            auto Bfe = Cmp1->C<IR::IROp_Bfe>();
+            if (Bfe->Width == 1) {
+              // A single-bit extract against zero is also just a bit test
+              IREmit->SetWriteCursor(CurrentIR.GetNode(Op->Header.Args[1]));
+              IREmit->ReplaceNodeArgument(CodeNode, 0, CurrentIR.GetNode(Bfe->Src));
+              IREmit->ReplaceNodeArgument(CodeNode, 1, CreateInlineConstant(IREmit, 1ULL << Bfe->lsb));
+              Op->CompareSize = 8;
+
+              Changed = true;
+              break;
+            }
+          }
+        }
+
         if (IREmit->IsValueConstant(Op->Header.Args[1], &Constant2)) {
           if (IsImmAddSub(Constant2)) {
             IREmit->SetWriteCursor(CurrentIR.GetNode(Op->Header.Args[1]));
@@ -1262,12 +1654,16 @@ bool ConstProp::Run(IREmitter *IREmit) {
   auto CurrentIR = IREmit->ViewIR();
   auto OriginalWriteCursor = IREmit->GetWriteCursor();
 
+  CalculateSinglePredecessors(CurrentIR);
+
   if (HandleConstantPools(IREmit, CurrentIR)) {
     Changed = true;
   }
 
   LoadMemStoreMemImmediatePooling(IREmit, CurrentIR);
 
+  SinglePredecessor.clear();
+
   for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
     if (ZextAndMaskingElimination(IREmit, CurrentIR, CodeNode, IROp)) {
       Changed = true;
@@ -24,6 +24,30 @@ namespace FEXCore::IR {
 
 constexpr int PropagationRounds = 5;
 
+struct FlagInfo {
+  uint64_t reads { 0 };
+  uint64_t writes { 0 };
+  uint64_t kill { 0 };
+};
+
+struct GPRInfo {
+  uint32_t reads { 0 };
+  uint32_t writes { 0 };
+  uint32_t kill { 0 };
+};
+
+struct FPRInfo {
+  uint64_t reads { 0 };
+  uint64_t writes { 0 };
+  uint64_t kill { 0 };
+};
+
+struct Info {
+  FlagInfo flag;
+  GPRInfo gpr;
+  FPRInfo fpr;
+};
+
 class DeadStoreElimination final : public FEXCore::IR::Pass {
 public:
   explicit DeadStoreElimination(bool SupportsAVX_) : SupportsAVX{SupportsAVX_} {}
@@ -33,6 +57,11 @@ public:
 private:
   bool SupportsAVX;
 
+  // Per-block read/write/kill classification, reset and reused across
+  // compilations to avoid churning the allocator on every Run
+  fextl::unordered_map<OrderedNode*, Info> InfoMap;
+  size_t InfoMapHighWater {};
+
   bool IsFPR(uint32_t Offset) const {
     const auto [begin, end] = [this]() -> std::pair<ptrdiff_t, ptrdiff_t> {
       if (SupportsAVX) {
@@ -91,19 +120,6 @@ private:
   }
 };
 
-struct FlagInfo {
-  uint64_t reads { 0 };
-  uint64_t writes { 0 };
-  uint64_t kill { 0 };
-};
-
-
-struct GPRInfo {
-  uint32_t reads { 0 };
-  uint32_t writes { 0 };
-  uint32_t kill { 0 };
-};
-
 bool IsFullGPR(uint32_t Offset, uint8_t Size) {
   if (Size != 8)
     return false;
@@ -132,18 +148,6 @@ uint32_t GPRBit(uint32_t Offset) {
   return  1 << ((Offset - 8)/8);
 }
 
-struct FPRInfo {
-  uint64_t reads { 0 };
-  uint64_t writes { 0 };
-  uint64_t kill { 0 };
-};
-
-struct Info {
-  FlagInfo flag;
-  GPRInfo gpr;
-  FPRInfo fpr;
-};
-
 /**
  * @brief This is a temporary pass to detect simple multiblock dead flag/gpr/fpr stores
  *
@@ -158,7 +162,7 @@ struct Info {
 bool DeadStoreElimination::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::DSE");
 
-  fextl::unordered_map<OrderedNode*, Info> InfoMap;
+  InfoMap.clear();
 
   bool Changed = false;
   auto CurrentIR = IREmit->ViewIR();
@@ -358,6 +362,8 @@ bool DeadStoreElimination::Run(IREmitter *IREmit) {
     }
   }
 
+  TrimScratchCapacity(InfoMap, InfoMapHighWater);
+
   return Changed;
 }
 
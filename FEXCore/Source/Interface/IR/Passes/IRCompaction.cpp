@@ -45,7 +45,15 @@ private:
     OrderedNode *NewNode;
   };
 
+  // Arguments that referenced nodes not yet copied when their op was visited
+  struct DeferredArgFixup {
+    IROp_Header *LocalOp;
+    uint32_t OldArg;
+    uint8_t Arg;
+  };
+
   fextl::vector<CodeBlockData> GeneratedCodeBlocks{};
+  fextl::vector<DeferredArgFixup> DeferredFixups{};
 };
 
 IRCompaction::IRCompaction(FEXCore::Utils::IntrusivePooledAllocator &Allocator)
@@ -64,11 +72,12 @@ bool IRCompaction::Run(IREmitter *IREmit) {
   if (OldToNewRemap.size() < NodeCount) {
     OldToNewRemap.resize(std::max(OldToNewRemap.size() * 2U, AlignUp(NodeCount, AlignSize)));
   }
-  #ifndef NDEBUG
-    memset(&OldToNewRemap.at(0), 0xFF, NodeCount * sizeof(RemapNode));
-  #endif
+  // The 0xFF fill is load-bearing, unmapped entries mark forward references
+  // during the copy pass below
+  memset(&OldToNewRemap.at(0), 0xFF, NodeCount * sizeof(RemapNode));
 
   GeneratedCodeBlocks.clear();
+  DeferredFixups.clear();
 
   // Reset our local working list
   LocalBuilder.ResetWorkingList();
@@ -145,6 +154,25 @@ bool IRCompaction::Run(IREmitter *IREmit) {
         // Need to be able to remap branch targets any other bits
         OldToNewRemap[CodeID.Value].NodeID = LocalIR.GetID(LocalPair.Node);
 
+        // Remap arguments in the same walk while the op is still hot in cache.
+        // SSA defs dominate their uses and the code blocks are pre-created, so
+        // arguments nearly always map to already-copied nodes. The rare forward
+        // reference gets patched once everything is copied.
+        // This doesn't use IR::GetRAArgs(Op) because we need to remap all SSA nodes
+        // Including ones that we don't RA
+        const uint8_t NumArgs = IR::GetArgs(LocalPair.first->Op);
+        for (uint8_t Arg = 0; Arg < NumArgs; ++Arg) {
+          const auto OldArg = LocalPair.first->Args[Arg].ID();
+          const auto NewArg = OldToNewRemap[OldArg.Value].NodeID;
+
+          if (NewArg.Value == UINT32_MAX) {
+            DeferredFixups.emplace_back(DeferredArgFixup{LocalPair.first, OldArg.Value, Arg});
+            continue;
+          }
+
+          LocalPair.first->Args[Arg].NodeOffset = NewArg.Value * sizeof(OrderedNode);
+        }
+
         if (i == 0) {
           FirstNode.OldNode = CodeNode;
           FirstNode.NewNode = LocalPair.Node;
@@ -166,31 +194,16 @@ bool IRCompaction::Run(IREmitter *IREmit) {
   }
 
   {
-    // Fixup the arguments of all the IROps
-    for (auto &Block : GeneratedCodeBlocks) {
-#if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
-      auto BlockIROp = LocalIR.GetOp<FEXCore::IR::IROp_CodeBlock>(Block.NewNode);
-      LOGMAN_THROW_AA_FMT(BlockIROp->Header.Op == OP_CODEBLOCK, "IR type failed to be a code block");
-#endif
-
-      for (auto [LocalNode, LocalIROp] : LocalIR.GetCode(Block.NewNode)) {
-
-        // Now that we have the op copied over, we need to modify SSA values to point to the new correct locations
-        // This doesn't use IR::GetRAArgs(Op) because we need to remap all SSA nodes
-        // Including ones that we don't RA
-        const uint8_t NumArgs = IR::GetArgs(LocalIROp->Op);
-        for (uint8_t i = 0; i < NumArgs; ++i) {
-          const auto OldArg = LocalIROp->Args[i].ID();
-          const auto NewArg = OldToNewRemap[OldArg.Value].NodeID;
+    // Patch the forward references the copy pass couldn't resolve yet
+    for (auto &Fixup : DeferredFixups) {
+      const auto NewArg = OldToNewRemap[Fixup.OldArg].NodeID;
 
-          #ifndef NDEBUG
-            LOGMAN_THROW_A_FMT(NewArg.Value != UINT32_MAX,
-                               "Tried remapping unfound node %{}", OldArg);
-          #endif
+      #ifndef NDEBUG
+        LOGMAN_THROW_A_FMT(NewArg.Value != UINT32_MAX,
+                           "Tried remapping unfound node %{}", Fixup.OldArg);
+      #endif
 
-          LocalIROp->Args[i].NodeOffset = NewArg.Value * sizeof(OrderedNode);
-        }
-      }
+      Fixup.LocalOp->Args[Fixup.Arg].NodeOffset = NewArg.Value * sizeof(OrderedNode);
     }
   }
 
@@ -17,6 +17,7 @@ $end_info$
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/sstream.h>
 #include <FEXCore/fextl/vector.h>
 
@@ -255,6 +256,11 @@ bool IRValidation::Run(IREmitter *IREmit) {
     FEXCore::IR::Dump(&Out, &CurrentIR, RAData);
 
     if (HadError) {
+      // Counted so shadow validation failures survive in release builds, where
+      // the assert below compiles out.
+      FEXCORE_TELEMETRY_STATIC_INIT(ValidationError, TYPE_IR_VALIDATION_ERROR);
+      FEXCORE_TELEMETRY_INC(ValidationError);
+
       Out << "Errors:" << std::endl << Errors.str() << std::endl;
     }
 
@@ -33,6 +33,7 @@ bool InlineCallOptimization::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::SyscallOpt");
 
   bool Changed = false;
+  bool InlinedConstantResult = false;
   auto CurrentIR = IREmit->ViewIR();
 
   for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
@@ -106,6 +107,7 @@ bool InlineCallOptimization::Run(IREmitter *IREmit) {
             // Replace all CPUID uses with this inline one
             IREmit->ReplaceAllUsesWith(CodeNode, ElementPair);
             Changed = true;
+            InlinedConstantResult = true;
           }
         }
       }
@@ -123,9 +125,42 @@ bool InlineCallOptimization::Run(IREmitter *IREmit) {
         // Replace all xgetbv uses with this inline one
         IREmit->ReplaceAllUsesWith(CodeNode, ElementPair);
         Changed = true;
+        InlinedConstantResult = true;
       }
     }
   }
+
+  if (InlinedConstantResult) {
+    // The inlined results feed the ExtractElementPair and Bfe chains that the
+    // dispatcher emitted to split the pair back into GPRs. ConstProp already
+    // ran by this point, so fold those here as well to leave plain immediate
+    // loads of the precomputed results behind. DCE cleans up the dead pair.
+    for (auto [CodeNode, IROp] : CurrentIR.GetAllCode()) {
+      if (IROp->Op == FEXCore::IR::OP_EXTRACTELEMENTPAIR) {
+        auto Op = IROp->C<IR::IROp_ExtractElementPair>();
+        auto Pair = IREmit->GetOpHeader(Op->Pair);
+
+        uint64_t Constant{};
+        if (Pair->Op == FEXCore::IR::OP_CREATEELEMENTPAIR &&
+            IREmit->IsValueConstant(Pair->Args[Op->Element], &Constant)) {
+          if (IROp->Size < 8) {
+            Constant &= (1ULL << (IROp->Size * 8)) - 1;
+          }
+          IREmit->ReplaceWithConstant(CodeNode, Constant);
+        }
+      }
+      else if (IROp->Op == FEXCore::IR::OP_BFE) {
+        auto Op = IROp->C<IR::IROp_Bfe>();
+
+        uint64_t Constant{};
+        if (IROp->Size <= 8 && IREmit->IsValueConstant(Op->Src, &Constant)) {
+          const uint64_t SourceMask = Op->Width == 64 ? ~0ULL : ((1ULL << Op->Width) - 1);
+          IREmit->ReplaceWithConstant(CodeNode, (Constant >> Op->lsb) & SourceMask);
+        }
+      }
+    }
+  }
+
   return Changed;
 }
 
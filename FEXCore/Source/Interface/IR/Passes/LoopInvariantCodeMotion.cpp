@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: ir|opts
+desc: Hoists invariant computation out of multiblock loops
+$end_info$
+*/
+
+#include "Interface/IR/IREmitter.h"
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstdint>
+
+namespace FEXCore::IR {
+
+// Loop-following multiblock formation keeps whole guest loops inside one IR
+// region, but every per-iteration address computation and segment-base load
+// the dispatcher emitted still sits in the loop body. This pass finds the
+// natural loops in the block list and moves invariant ops into the loop's
+// preheader so they execute once instead of once per iteration.
+//
+// A loop here is a contiguous run of blocks [Header..Latch] in emission order
+// whose only entry from outside is a branch to Header from a single block,
+// with the back edge jumping from inside the range to Header. That is exactly
+// the shape the frontend's loop following produces; anything more irregular is
+// left alone.
+class LoopInvariantCodeMotion final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  struct BlockInfo {
+    OrderedNode *Node;
+    IROp_Header *Header;
+    OrderedNode *Terminator;
+    uint32_t Succs[2];
+    uint32_t NumSuccs;
+  };
+
+  // Hoisting extends live ranges across the whole loop body, so cap how much
+  // pressure a single loop may add. Invariant chains past this stay put.
+  constexpr static size_t MaxHoistsPerLoop = 32;
+
+  fextl::vector<BlockInfo> Blocks{};
+  fextl::robin_map<uint32_t, uint32_t> BlockIndex{};
+  fextl::set<uint32_t> LoopDefs{};
+  fextl::vector<OrderedNode *> Hoisted{};
+
+  bool HoistLoop(IRListView &CurrentIR, uint32_t HeaderIdx, uint32_t LatchIdx, uint32_t Preheader);
+};
+
+// Pure ops that are profitable to move. Constants are free to rematerialize
+// and the inline forms must stay next to their user, so they never move.
+static bool IsHoistableOp(IROps Op) {
+  switch (Op) {
+    case OP_CONSTANT:
+    case OP_INLINECONSTANT:
+    case OP_ENTRYPOINTOFFSET:
+    case OP_INLINEENTRYPOINTOFFSET:
+    // Reads the host flags that surrounding ops produce and clobber.
+    case OP_LOADNZCV:
+      return false;
+    default:
+      // Ops that implicitly clobber host NZCV can't cross ops that read it,
+      // which a cross-block move can't reason about.
+      return !HasSideEffects(Op) && !ImplicitFlagClobber(Op);
+  }
+}
+
+// Side-effect ops that provably never write the guest context. Any other
+// side effect in the loop (syscalls, thunks, indexed context stores) makes
+// every LoadContext in it variant.
+static bool CannotWriteContext(IROps Op) {
+  switch (Op) {
+    case OP_STOREMEM:
+    case OP_STOREMEMTSO:
+    case OP_STOREMEMPAIR:
+    case OP_VSTOREVECTORELEMENT:
+    case OP_VSTOREVECTORMASKED:
+    case OP_STORECONTEXT:  // Known offset, checked per candidate
+    case OP_STOREREGISTER: // Known offset, checked per candidate
+    case OP_STOREFLAG:     // Writes the flags area only
+    case OP_GUESTOPCODE:
+    case OP_BEGINBLOCK:
+    case OP_ENDBLOCK:
+    case OP_JUMP:
+    case OP_CONDJUMP:
+    case OP_INVALIDATEFLAGS:
+    case OP_CACHELINECLEAR:
+    case OP_CACHELINEZERO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool LoopInvariantCodeMotion::HoistLoop(IRListView &CurrentIR, uint32_t HeaderIdx, uint32_t LatchIdx, uint32_t Preheader) {
+  const uintptr_t ListBegin = CurrentIR.GetListData();
+
+  // Every value defined inside the loop, so invariance is one set lookup.
+  LoopDefs.clear();
+  bool UnknownContextWrite = false;
+  bool StoresFlags = false;
+  for (uint32_t b = HeaderIdx; b <= LatchIdx; ++b) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Blocks[b].Node)) {
+      LoopDefs.insert(CurrentIR.GetID(CodeNode).Value);
+      if (HasSideEffects(IROp->Op) && !CannotWriteContext(IROp->Op)) {
+        UnknownContextWrite = true;
+      }
+      StoresFlags |= IROp->Op == OP_STOREFLAG;
+    }
+  }
+
+  const auto ContextIsClobbered = [&](uint32_t Offset, uint32_t Size) {
+    if (UnknownContextWrite) {
+      return true;
+    }
+    if (StoresFlags &&
+        Offset < offsetof(FEXCore::Core::CPUState, flags) + sizeof(FEXCore::Core::CPUState::flags) &&
+        Offset + Size > offsetof(FEXCore::Core::CPUState, flags)) {
+      return true;
+    }
+    for (uint32_t b = HeaderIdx; b <= LatchIdx; ++b) {
+      for (auto [CodeNode, IROp] : CurrentIR.GetCode(Blocks[b].Node)) {
+        uint32_t StoreOffset{};
+        uint32_t StoreSize{};
+        if (IROp->Op == OP_STORECONTEXT) {
+          auto Op = IROp->C<IROp_StoreContext>();
+          StoreOffset = Op->Offset;
+          StoreSize = IROp->Size;
+        }
+        else if (IROp->Op == OP_STOREREGISTER) {
+          auto Op = IROp->C<IROp_StoreRegister>();
+          StoreOffset = Op->Offset;
+          StoreSize = IROp->Size;
+        }
+        else {
+          continue;
+        }
+        if (StoreOffset < Offset + Size && StoreOffset + StoreSize > Offset) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  // Walk the loop in order collecting invariant ops. Defs precede uses in
+  // emission order, so ops feeding off an earlier hoist are caught in the
+  // same sweep.
+  Hoisted.clear();
+  for (uint32_t b = HeaderIdx; b <= LatchIdx && Hoisted.size() < MaxHoistsPerLoop; ++b) {
+    auto BlockIROp = Blocks[b].Header->CW<IROp_CodeBlock>();
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Blocks[b].Node)) {
+      if (Hoisted.size() >= MaxHoistsPerLoop) {
+        break;
+      }
+
+      const bool IsContextLoad = IROp->Op == OP_LOADCONTEXT;
+      if (!IsHoistableOp(IROp->Op) && !IsContextLoad) {
+        continue;
+      }
+      // Never disturb the block's entry link.
+      if (CodeNode->Wrapped(ListBegin) == BlockIROp->Begin) {
+        continue;
+      }
+
+      bool Invariant = true;
+      const uint8_t NumArgs = IR::GetArgs(IROp->Op);
+      for (uint8_t Arg = 0; Arg < NumArgs; ++Arg) {
+        if (IROp->Args[Arg].IsInvalid()) {
+          continue;
+        }
+        if (LoopDefs.contains(IROp->Args[Arg].ID().Value)) {
+          Invariant = false;
+          break;
+        }
+      }
+      if (!Invariant) {
+        continue;
+      }
+
+      if (IsContextLoad) {
+        // Segment bases and similar slow-context state: only invariant when
+        // nothing in the loop can write those bytes back.
+        auto Op = IROp->C<IROp_LoadContext>();
+        if (ContextIsClobbered(Op->Offset, IROp->Size)) {
+          continue;
+        }
+      }
+
+      LoopDefs.erase(CurrentIR.GetID(CodeNode).Value);
+      Hoisted.push_back(CodeNode);
+    }
+  }
+
+  if (Hoisted.empty()) {
+    return false;
+  }
+
+  // Relink ahead of the preheader's terminator, preserving definition order.
+  // The preheader dominates the header, so every loop use stays dominated.
+  OrderedNode *Anchor = Blocks[Preheader].Terminator;
+  for (size_t i = Hoisted.size(); i-- != 0;) {
+    OrderedNode *Node = Hoisted[i];
+    Node->Unlink(ListBegin);
+    Anchor = Anchor->prepend(ListBegin, Node);
+  }
+
+  return true;
+}
+
+bool LoopInvariantCodeMotion::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::LICM");
+
+  auto CurrentIR = IREmit->ViewIR();
+
+  // Index the blocks in emission order and record their successors.
+  Blocks.clear();
+  BlockIndex.clear();
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    BlockIndex[CurrentIR.GetID(BlockNode).Value] = Blocks.size();
+    Blocks.push_back(BlockInfo {
+      .Node = BlockNode,
+      .Header = BlockHeader,
+      .Terminator = nullptr,
+      .Succs = {},
+      .NumSuccs = 0,
+    });
+  }
+
+  if (Blocks.size() < 2) {
+    return false;
+  }
+
+  for (auto &Block : Blocks) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block.Node)) {
+      if (IROp->Op == OP_JUMP) {
+        Block.Terminator = CodeNode;
+        auto Op = IROp->C<IROp_Jump>();
+        Block.Succs[Block.NumSuccs++] = BlockIndex[Op->TargetBlock.ID().Value];
+      }
+      else if (IROp->Op == OP_CONDJUMP) {
+        Block.Terminator = CodeNode;
+        auto Op = IROp->C<IROp_CondJump>();
+        Block.Succs[Block.NumSuccs++] = BlockIndex[Op->TrueBlock.ID().Value];
+        Block.Succs[Block.NumSuccs++] = BlockIndex[Op->FalseBlock.ID().Value];
+      }
+      else if (HasSideEffects(IROp->Op) && IROp->Op != OP_ENDBLOCK) {
+        // Exits and breaks terminate without successors; remember the last
+        // side-effect op as the terminator anchor regardless.
+        Block.Terminator = CodeNode;
+      }
+    }
+  }
+
+  // Widest back edge per header, so a loop with multiple latches (guest
+  // continue statements) is treated as one region.
+  bool Changed = false;
+  for (uint32_t Header = 0; Header < Blocks.size(); ++Header) {
+    uint32_t Latch = ~0U;
+    for (uint32_t b = Header; b < Blocks.size(); ++b) {
+      for (uint32_t s = 0; s < Blocks[b].NumSuccs; ++s) {
+        if (Blocks[b].Succs[s] == Header) {
+          Latch = b;
+        }
+      }
+    }
+    if (Latch == ~0U || Header == 0) {
+      // No back edge, or the header is the region entry: execution enters the
+      // entry block without passing any preheader, so nothing dominates it.
+      continue;
+    }
+
+    // Single-entry check: no block outside [Header..Latch] may branch into
+    // the range except to the header, and exactly one block may target the
+    // header from outside.
+    uint32_t Preheader = ~0U;
+    bool Irregular = false;
+    for (uint32_t b = 0; b < Blocks.size() && !Irregular; ++b) {
+      if (b >= Header && b <= Latch) {
+        continue;
+      }
+      for (uint32_t s = 0; s < Blocks[b].NumSuccs; ++s) {
+        const uint32_t Succ = Blocks[b].Succs[s];
+        if (Succ == Header) {
+          if (Preheader != ~0U && Preheader != b) {
+            Irregular = true;
+            break;
+          }
+          Preheader = b;
+        }
+        else if (Succ > Header && Succ <= Latch) {
+          Irregular = true;
+          break;
+        }
+      }
+    }
+
+    if (Irregular || Preheader == ~0U || Blocks[Preheader].Terminator == nullptr) {
+      continue;
+    }
+
+    Changed |= HoistLoop(CurrentIR, Header, Latch, Preheader);
+  }
+
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateLoopInvariantCodeMotion() {
+  return fextl::make_unique<LoopInvariantCodeMotion>();
+}
+
+}
@@ -10,6 +10,7 @@
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/fextl/deque.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/sstream.h>
@@ -457,6 +458,11 @@ bool RAValidation::Run(IREmitter *IREmit) {
   }
 
   if (HadError) {
+    // Counted so shadow validation failures survive in release builds, where
+    // the assert below compiles out.
+    FEXCORE_TELEMETRY_STATIC_INIT(ValidationError, TYPE_RA_VALIDATION_ERROR);
+    FEXCORE_TELEMETRY_INC(ValidationError);
+
     fextl::stringstream IrDump;
     FEXCore::IR::Dump(&IrDump, &CurrentIR, RAData);
 
@@ -2,19 +2,21 @@
 /*
 $info$
 tags: ir|opts
-desc: This is not used right now, possibly broken
+desc: Cross-block elimination of dead flag calculations
 $end_info$
 */
 
 #include "Interface/IR/IREmitter.h"
 
+#include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/IR/IR.h>
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/fextl/unordered_map.h>
+#include <FEXCore/fextl/vector.h>
 
 #include "Interface/IR/PassManager.h"
 
-#include <array>
 #include <memory>
 
 namespace FEXCore::IR {
@@ -22,51 +24,217 @@ namespace FEXCore::IR {
 class DeadFlagCalculationEliminination final : public FEXCore::IR::Pass {
 public:
   bool Run(IREmitter *IREmit) override;
+
+private:
+  // One bit per x86 flag location (including the x87 block), plus the NZCV
+  // register tracked as a single unit since consumers read it as a whole.
+  constexpr static uint64_t FLAG_NZCV = 1ULL << 63;
+  constexpr static uint64_t FLAGS_ALL = ~0ULL;
+
+  struct FlagEffects {
+    uint64_t Reads;
+    uint64_t Writes;
+
+    // Set when the op's only observable effect is the flag write, making it
+    // removable once the written flags are provably dead.
+    bool RemovableWhenDead;
+  };
+
+  static FlagEffects ClassifyOp(const IROp_Header *IROp);
+
+  struct BlockData {
+    OrderedNode *BlockNode;
+    fextl::vector<uint32_t> Successors;
+
+    // Flags read before being written within the block
+    uint64_t Reads;
+    // Flags written within the block
+    uint64_t Writes;
+
+    uint64_t LiveIn;
+    uint64_t LiveOut;
+  };
+
+  // Scratch storage reset and reused across compilations. Blocks is recycled
+  // element-wise so the per-block successor vectors keep their capacity too.
+  fextl::vector<BlockData> Blocks{};
+  fextl::vector<OrderedNode *> BlockCode{};
+  fextl::unordered_map<IR::NodeID, uint32_t> BlockIndexes{};
+  size_t BlocksHighWater{};
+  size_t BlockCodeHighWater{};
+  size_t BlockIndexesHighWater{};
 };
 
+DeadFlagCalculationEliminination::FlagEffects DeadFlagCalculationEliminination::ClassifyOp(const IROp_Header *IROp) {
+  switch (IROp->Op) {
+    case OP_STOREFLAG:
+      return {0, 1ULL << IROp->C<IROp_StoreFlag>()->Flag, true};
+    case OP_LOADFLAG:
+      return {1ULL << IROp->C<IROp_LoadFlag>()->Flag, 0, false};
+
+    // Full NZCV definitions
+    case OP_STORENZCV:
+    case OP_ADDNZCV:
+    case OP_SUBNZCV:
+    case OP_TESTNZ:
+      return {0, FLAG_NZCV, true};
+
+    // Ops that both observe and update NZCV, either with a carry-in, a
+    // condition, or by preserving part of the register
+    case OP_ADCNZCV:
+    case OP_SBBNZCV:
+    case OP_CONDADDNZCV:
+    case OP_CARRYINVERT:
+    case OP_RMIFNZCV:
+    case OP_AXFLAG:
+      return {FLAG_NZCV, FLAG_NZCV, true};
+
+    // Also produce a result, so they stay even when the flag write is dead
+    case OP_ADCWITHFLAGS:
+    case OP_SBBWITHFLAGS:
+      return {FLAG_NZCV, FLAG_NZCV, false};
+
+    case OP_LOADNZCV:
+    case OP_NZCVSELECT:
+      return {FLAG_NZCV, 0, false};
+
+    case OP_CONDJUMP:
+      if (IROp->C<IROp_CondJump>()->FromNZCV) {
+        return {FLAG_NZCV, 0, false};
+      }
+      return {0, 0, false};
+
+    // Anything that can hand control to code that observes the guest context
+    // must see architecturally correct flags
+    case OP_SYSCALL:
+    case OP_INLINESYSCALL:
+    case OP_THUNK:
+    case OP_BREAK:
+      return {FLAGS_ALL, 0, false};
+
+    default:
+      return {0, 0, false};
+  }
+}
+
 /**
- * @brief (UNSAFE) This pass removes flag calculations that will otherwise be unused INSIDE of that block
+ * @brief Removes flag calculations that provably can't be observed
  *
- * Compilers don't really do any form of cross-block flag allocation like they do RA with GPRs.
- * This ends up with them recalculating flags across blocks regardless of if it is actually possible to reuse the flags.
- * This is an additional burden in x86 that most instructions change flags when called, so it is easier to recalculate anyway.
+ * Compilers don't do any form of cross-block flag allocation like they do RA with GPRs,
+ * so guest code recalculates flags constantly and nearly all of those calculations die
+ * before anything consumes them. Within a block the dispatcher's deferred flag handling
+ * already avoids most of the cost, but every block boundary forces a materialization.
  *
- * This is unsafe since handwritten code can easily break this assumption.
- * This may be more interesting with full function level recompilation since flags definitely won't be used across function boundaries.
+ * This pass runs a backwards liveness analysis over the flag locations across the whole
+ * multiblock region. A flag write whose value is overwritten on every successor path
+ * before being read is deleted. Region exits are treated as reading every flag, so
+ * anything that can leave the region (or trap into a signal handler via Break/Syscall)
+ * still observes architecturally correct flags.
  *
+ * Like the dispatcher's deferred flag handling, this assumes an asynchronous signal
+ * cannot observe flag state between two guest instructions inside the region.
  */
 bool DeadFlagCalculationEliminination::Run(IREmitter *IREmit) {
   FEXCORE_PROFILE_SCOPED("PassManager::DFE");
 
-  std::array<OrderedNode*, 32> LastValidFlagStores{};
-
   bool Changed = false;
   auto CurrentIR = IREmit->ViewIR();
 
+  BlockIndexes.clear();
+
+  // Gather the blocks, their flag effects, and the CFG edges
+  size_t NumBlocks {};
   for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
-    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
-      if (IROp->Op == OP_STOREFLAG) {
-        auto Op = IROp->CW<IR::IROp_StoreFlag>();
-        // Set this node as the last one valid for this flag
-        LastValidFlagStores[Op->Flag] = CodeNode;
+    BlockIndexes.try_emplace(CurrentIR.GetID(BlockNode), NumBlocks);
+    if (NumBlocks == Blocks.size()) {
+      Blocks.emplace_back();
+    }
+
+    auto &Block = Blocks[NumBlocks++];
+    Block.BlockNode = BlockNode;
+    Block.Successors.clear();
+    Block.Reads = 0;
+    Block.Writes = 0;
+    Block.LiveIn = 0;
+    Block.LiveOut = 0;
+  }
+
+  if (Blocks.size() > NumBlocks) {
+    Blocks.resize(NumBlocks);
+  }
+
+  for (auto &Block : Blocks) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block.BlockNode)) {
+      const auto Effects = ClassifyOp(IROp);
+
+      // Only reads of flags this block hasn't defined yet propagate upwards
+      Block.Reads |= Effects.Reads & ~Block.Writes;
+      Block.Writes |= Effects.Writes;
+
+      if (IROp->Op == OP_CONDJUMP) {
+        auto Op = IROp->C<IROp_CondJump>();
+        Block.Successors.emplace_back(BlockIndexes.at(Op->TrueBlock.ID()));
+        Block.Successors.emplace_back(BlockIndexes.at(Op->FalseBlock.ID()));
       }
-      else if (IROp->Op == OP_LOADFLAG) {
-        auto Op = IROp->CW<IR::IROp_LoadFlag>();
-        LastValidFlagStores[Op->Flag] = nullptr;
+      else if (IROp->Op == OP_JUMP) {
+        Block.Successors.emplace_back(BlockIndexes.at(IROp->Args[0].ID()));
       }
     }
+  }
 
-    // If any flags are stored but not loaded by the end of the block, then erase them
-    for (auto &Flag : LastValidFlagStores) {
-      if (Flag != nullptr) {
-        IREmit->Remove(Flag);
-        Changed = true;
+  // Backwards dataflow to a fixed point. Blocks are emitted in roughly guest
+  // order so the reverse walk converges quickly.
+  bool LivenessChanged = true;
+  while (LivenessChanged) {
+    LivenessChanged = false;
+
+    for (auto it = Blocks.rbegin(); it != Blocks.rend(); ++it) {
+      auto &Block = *it;
+
+      // Leaving the region means every flag is observable
+      uint64_t LiveOut = Block.Successors.empty() ? FLAGS_ALL : 0;
+      for (auto Successor : Block.Successors) {
+        LiveOut |= Blocks[Successor].LiveIn;
+      }
+
+      const uint64_t LiveIn = Block.Reads | (LiveOut & ~Block.Writes);
+
+      if (LiveOut != Block.LiveOut || LiveIn != Block.LiveIn) {
+        Block.LiveOut = LiveOut;
+        Block.LiveIn = LiveIn;
+        LivenessChanged = true;
       }
     }
+  }
+
+  // Walk each block backwards, deleting flag writes that are dead at their
+  // program point
+  for (auto &Block : Blocks) {
+    BlockCode.clear();
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block.BlockNode)) {
+      BlockCode.emplace_back(CodeNode);
+    }
+
+    uint64_t Live = Block.LiveOut;
+    for (auto it = BlockCode.rbegin(); it != BlockCode.rend(); ++it) {
+      auto CodeNode = *it;
+      auto IROp = CurrentIR.GetOp<IROp_Header>(CodeNode);
+      const auto Effects = ClassifyOp(IROp);
 
-    LastValidFlagStores.fill(nullptr);
+      if (Effects.RemovableWhenDead && (Live & Effects.Writes) == 0) {
+        IREmit->Remove(CodeNode);
+        Changed = true;
+        continue;
+      }
+
+      Live = (Live & ~Effects.Writes) | Effects.Reads;
+    }
   }
 
+  TrimScratchCapacity(Blocks, BlocksHighWater);
+  TrimScratchCapacity(BlockCode, BlockCodeHighWater);
+  TrimScratchCapacity(BlockIndexes, BlockIndexesHighWater);
+
   return Changed;
 }
 
@@ -20,6 +20,7 @@ $end_info$
 #include <FEXCore/Utils/Profiler.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/set.h>
+#include <FEXCore/fextl/small_flat_map.h>
 #include <FEXCore/fextl/unordered_map.h>
 #include <FEXCore/fextl/unordered_set.h>
 #include <FEXCore/fextl/vector.h>
@@ -98,8 +99,10 @@ namespace {
     fextl::vector<RegisterNode> Nodes{};
     uint32_t NodeCount{};
     fextl::vector<SpillStackUnit> SpillStack;
+    // BlockPredecessors must stay node based: RecursiveLiveRangeExpansion
+    // holds references to its elements across operator[] inserts into it.
     fextl::unordered_map<IR::NodeID, fextl::unordered_set<IR::NodeID>> BlockPredecessors;
-    fextl::unordered_map<IR::NodeID, fextl::unordered_set<IR::NodeID>> VisitedNodePredecessors;
+    fextl::small_flat_map<IR::NodeID, fextl::unordered_set<IR::NodeID>, 32> VisitedNodePredecessors;
   };
 
   void ResetRegisterGraph(RegisterGraph *Graph, uint64_t NodeCount);
@@ -1159,8 +1162,7 @@ namespace {
         // If the node's live range intersects the interference node
         // but the interference node only overlaps the end of our live range
         // then spilling the register will lower register pressure if there is
-        // not a use of the interference register at the same node as the other node's
-        // last use
+        // not a use of the interference register inside of our live range
         // | Our Node             |        Interference |
         // | ========================================== |
         // | 0 - Assign           |                     |
@@ -1170,17 +1172,20 @@ namespace {
         // | 4                    |            (No Use) |
         // | 5                    |            Last Use |
         // | Range - (1, 3]       |              (2, 5] |
-
-        // XXX: This route has a bug in it so it is purposely disabled for now
-        if (false && !Found &&
+        if (!Found &&
             CurrentLocation <= InterferenceLiveRange->Begin &&
             OpLiveRange->End <= InterferenceLiveRange->End) {
-          auto FirstUseLocation = FindFirstUse(IREmit, InterferenceOrderedNode, NodeOpEndIter, NodeOpEndIter);
+          // The interference is assigned inside our live range so it occupies a register
+          // from there until past our last use. Spilling it only lowers pressure if it
+          // has no use before our live range ends, otherwise the fill lands back inside
+          // our live range and we just churn spill/fill pairs.
+          auto FirstUseLocation = FindFirstUse(IREmit, InterferenceOrderedNode, NodeOpBeginIter, NodeOpEndIter);
 
           if (FirstUseLocation == IR::NodeIterator::Invalid()) {
-            // This means that the assignment of our the interference register doesn't overlap
-            // with the final usage of our register, we can spill it and reduce usage
-            const auto InterferenceNodeNextUse = FindFirstUse(IREmit, InterferenceOrderedNode, NodeOpBeginIter, InterferenceNodeOpEndIter);
+            // No use inside our live range, spilling at the definition and filling past
+            // our last use frees the register for the rest of our range
+            const auto InterferenceNodeNextUse = FindFirstUse(IREmit, InterferenceOrderedNode, NodeOpEndIter, InterferenceNodeOpEndIter);
+            LOGMAN_THROW_A_FMT(InterferenceNodeNextUse != IR::NodeIterator::Invalid(), "Couldn't find next usage of op");
             const auto NextUseDistance = InterferenceNodeNextUse.ID().Value - CurrentLocation.Value;
             if (NextUseDistance >= InterferenceFarthestNextUse) {
               Found = true;
@@ -1336,19 +1341,25 @@ namespace {
           // This is the op that we need to dump
           auto [InterferenceOrderedNode, InterferenceIROp] = IR.at(*InterferenceNode)();
 
-
-          // This will find the last use of this definition
-          // Walks from CodeBegin -> BlockBegin to find the last Use
-          // Which this is walking backwards to find the first use
-          auto LastUseIterator = FindLastUseBefore(IREmit, InterferenceOrderedNode, NodeIterator::Invalid(), IR.at(CodeNode));
-          if (LastUseIterator != AllNodesIterator::Invalid()) {
-            auto [LastUseNode, LastUseIROp] = LastUseIterator();
-
-            // Set the write cursor to point of last usage
-            IREmit->SetWriteCursor(LastUseNode);
-          } else {
-            // There is no last use -- use the definition as last use
+          if (LiveRanges[InterferenceNode->Value].Begin > Node) {
+            // The interference is defined after the op that failed allocation, so
+            // there are no uses to walk backwards through. Spill straight after the
+            // definition
             IREmit->SetWriteCursor(InterferenceOrderedNode);
+          } else {
+            // This will find the last use of this definition
+            // Walks from CodeBegin -> BlockBegin to find the last Use
+            // Which this is walking backwards to find the first use
+            auto LastUseIterator = FindLastUseBefore(IREmit, InterferenceOrderedNode, NodeIterator::Invalid(), IR.at(CodeNode));
+            if (LastUseIterator != AllNodesIterator::Invalid()) {
+              auto [LastUseNode, LastUseIROp] = LastUseIterator();
+
+              // Set the write cursor to point of last usage
+              IREmit->SetWriteCursor(LastUseNode);
+            } else {
+              // There is no last use -- use the definition as last use
+              IREmit->SetWriteCursor(InterferenceOrderedNode);
+            }
           }
 
           // Actually spill the node now
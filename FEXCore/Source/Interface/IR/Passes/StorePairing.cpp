@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: ir|opts
+desc: Merges provably adjacent plain stores into store-pair ops
+$end_info$
+*/
+
+#include "Interface/IR/IREmitter.h"
+#include "Interface/IR/PassManager.h"
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+
+#include <cstdint>
+
+namespace FEXCore::IR {
+
+// Guest code is dense with back-to-back same-size stores through one base
+// register - stack spills, struct copies, the context save sequences RCLSE
+// leaves behind. The backend emits each one individually, so pairs that a
+// native compiler would have turned into a single stp cost two stores here.
+//
+// This pass walks each block looking for two plain StoreMem ops with the same
+// base address node, the same class and size, and constant offsets exactly one
+// element apart, with nothing side-effecting between them. Such a pair merges
+// into one StoreMemPair at the later store's position, which the backend
+// lowers to a single stp.
+//
+// TSO stores are never touched: their release ordering has no paired
+// equivalent, so merging them would weaken the memory model.
+class StorePairing final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  // Extracts a store's constant offset. Returns false when the offset is a
+  // runtime value or the addressing mode isn't a plain base + byte offset.
+  bool GetConstantOffset(IREmitter *IREmit, const IROp_StoreMem *Op, int64_t *Offset);
+};
+
+bool StorePairing::GetConstantOffset(IREmitter *IREmit, const IROp_StoreMem *Op, int64_t *Offset) {
+  if (Op->OffsetType != MEM_OFFSET_SXTX || Op->OffsetScale != 1) {
+    return false;
+  }
+
+  if (Op->Offset.IsInvalid()) {
+    *Offset = 0;
+    return true;
+  }
+
+  const auto *OffsetHeader = IREmit->GetOpHeader(Op->Offset);
+  if (OffsetHeader->Op == OP_CONSTANT) {
+    *Offset = static_cast<int64_t>(OffsetHeader->C<IROp_Constant>()->Constant);
+    return true;
+  }
+  if (OffsetHeader->Op == OP_INLINECONSTANT) {
+    *Offset = static_cast<int64_t>(OffsetHeader->C<IROp_InlineConstant>()->Constant);
+    return true;
+  }
+
+  return false;
+}
+
+bool StorePairing::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::StorePairing");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+  auto OriginalWriteCursor = IREmit->GetWriteCursor();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    // Previous unpaired store still eligible for merging.
+    OrderedNode *PrevNode{};
+    IROp_StoreMem *PrevOp{};
+    int64_t PrevOffset{};
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (IROp->Op != OP_STOREMEM) {
+        // Pure ops can sit between the two stores, anything with side effects
+        // (loads included - they might alias) resets the window.
+        if (HasSideEffects(IROp->Op)) {
+          PrevNode = nullptr;
+        }
+        continue;
+      }
+
+      auto Op = IROp->CW<IROp_StoreMem>();
+      const auto Size = IROp->Size;
+
+      int64_t Offset{};
+      const bool SupportedSize = Op->Class == GPRClass ? (Size == 4 || Size == 8)
+                                                       : (Size == 4 || Size == 8 || Size == 16);
+      if (!SupportedSize || !GetConstantOffset(IREmit, Op, &Offset)) {
+        PrevNode = nullptr;
+        continue;
+      }
+
+      if (PrevNode &&
+          PrevOp->Addr == Op->Addr &&
+          PrevOp->Class == Op->Class &&
+          PrevOp->Header.Size == Size &&
+          (Offset - PrevOffset == Size || PrevOffset - Offset == Size)) {
+        const bool PrevIsLower = PrevOffset < Offset;
+        const int64_t BaseOffset = PrevIsLower ? PrevOffset : Offset;
+
+        // stp takes a signed 7-bit element-scaled immediate.
+        if ((BaseOffset % Size) == 0 &&
+            (BaseOffset / Size) >= -64 && (BaseOffset / Size) <= 63) {
+          auto Lower = CurrentIR.GetNode(PrevIsLower ? PrevOp->Value : Op->Value);
+          auto Upper = CurrentIR.GetNode(PrevIsLower ? Op->Value : PrevOp->Value);
+
+          // Both values dominate the later store, so the pair lands there.
+          IREmit->SetWriteCursor(CodeNode);
+          IREmit->_StoreMemPair(Op->Class, Size, Lower, Upper, CurrentIR.GetNode(Op->Addr), BaseOffset);
+
+          IREmit->Remove(PrevNode);
+          IREmit->Remove(CodeNode);
+
+          PrevNode = nullptr;
+          Changed = true;
+          continue;
+        }
+      }
+
+      PrevNode = CodeNode;
+      PrevOp = Op;
+      PrevOffset = Offset;
+    }
+  }
+
+  IREmit->SetWriteCursor(OriginalWriteCursor);
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateStorePairing() {
+  return fextl::make_unique<StorePairing>();
+}
+
+} // namespace FEXCore::IR
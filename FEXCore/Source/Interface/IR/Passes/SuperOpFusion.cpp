@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: ir|opts
+desc: Replaces declared guest idiom sequences with their fused superops
+$end_info$
+*/
+
+#include "Interface/IR/IREmitter.h"
+#include "Interface/IR/PassManager.h"
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Profiler.h>
+
+namespace FEXCore::IR {
+
+#define IROP_SUPEROP_HELPERS
+#include <FEXCore/IR/IRDefines.inc>
+
+// Superops are declared in IR.json next to the op sequence they replace, and
+// the generator emits a matcher and a fuser per declaration. This pass only
+// supplies the walk: every op in every block is offered as the start of every
+// declared pattern, and a hit swaps the matched sequence for its fused op.
+//
+// Patterns are tried in declaration order and matched greedily, the first hit
+// at a position wins.
+class SuperOpFusion final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+};
+
+bool SuperOpFusion::Run(IREmitter *IREmit) {
+  FEXCORE_PROFILE_SCOPED("PassManager::SuperOpFusion");
+
+  bool Changed = false;
+  auto CurrentIR = IREmit->ViewIR();
+  auto OriginalWriteCursor = IREmit->GetWriteCursor();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    auto BlockIROp = BlockHeader->CW<IROp_CodeBlock>();
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+#define TRY_FUSE(Name) \
+      { \
+        SuperOpMatch_##Name Match; \
+        if (MatchSuperOp_##Name(CurrentIR, CurrentIR.at(CodeNode), CurrentIR.at(BlockIROp->Last), Match)) { \
+          FuseSuperOp_##Name(IREmit, CurrentIR, Match); \
+          Changed = true; \
+          continue; \
+        } \
+      }
+
+      FOREACH_SUPEROP(TRY_FUSE)
+#undef TRY_FUSE
+    }
+  }
+
+  IREmit->SetWriteCursor(OriginalWriteCursor);
+  return Changed;
+}
+
+fextl::unique_ptr<FEXCore::IR::Pass> CreateSuperOpFusion() {
+  return fextl::make_unique<SuperOpFusion>();
+}
+
+}
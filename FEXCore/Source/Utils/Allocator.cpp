@@ -13,8 +13,12 @@
 #include <cstdio>
 #include <fcntl.h>
 #ifndef _WIN32
+#include <linux/mempolicy.h>
+#include <malloc.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <sys/user.h>
+#include <unistd.h>
 #endif
 
 #ifdef ENABLE_JEMALLOC
@@ -121,6 +125,20 @@ namespace FEXCore::Allocator {
     }
   }
 
+  void TrimHeap() {
+#ifdef ENABLE_JEMALLOC
+    // Forces a purge pass over every arena rather than waiting for the
+    // background decay to hand dirty pages back.
+#define MALLCTL_STR(x) #x
+#define MALLCTL_XSTR(x) MALLCTL_STR(x)
+    je_mallctl("arena." MALLCTL_XSTR(MALLCTL_ARENAS_ALL) ".purge", nullptr, nullptr, nullptr, 0);
+#undef MALLCTL_XSTR
+#undef MALLCTL_STR
+#else
+    ::malloc_trim(0);
+#endif
+  }
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
   void SetupHooks() {
@@ -192,6 +210,26 @@ namespace FEXCore::Allocator {
     FEX_UNREACHABLE;
   }
 
+  void BindToLocalNode(void *Ptr, size_t Size) {
+    unsigned CPU{};
+    unsigned Node{};
+    if (::syscall(SYS_getcpu, &CPU, &Node, nullptr) != 0) {
+      return;
+    }
+
+    // Fixed-width mask. Systems with more nodes than this keep the default policy.
+    unsigned long NodeMask[2]{};
+    if (Node >= sizeof(NodeMask[0]) * 8) {
+      return;
+    }
+    NodeMask[0] = 1UL << Node;
+
+    // maxnode is one past the highest representable node so the kernel never reads past the first element.
+    // mbind only steers pages that haven't been faulted in yet; failure just keeps the default
+    // first-touch policy, so it's safe to ignore. Can't use glibc's wrapper since libnuma isn't a dependency.
+    ::syscall(SYS_mbind, Ptr, Size, MPOL_BIND, NodeMask, sizeof(NodeMask[0]) * 8 + 1, 0);
+  }
+
   #define STEAL_LOG(...) // fprintf(stderr, __VA_ARGS__)
 
   fextl::vector<MemoryRegion> StealMemoryRegion(uintptr_t Begin, uintptr_t End) {
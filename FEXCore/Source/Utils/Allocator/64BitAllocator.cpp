@@ -70,6 +70,9 @@ namespace Alloc::OSAllocator {
       // Lower bound is the starting of the range just past the lower 32bits
       constexpr static uintptr_t LOWER_BOUND = 0x1'0000'0000ULL;
 
+      // Transparent huge page size used for large allocation placement
+      constexpr static uint64_t HUGE_PAGE_SIZE = 2ULL * 1024 * 1024;
+
       uintptr_t UPPER_BOUND_PAGE = UPPER_BOUND / FHU::FEX_PAGE_SIZE;
       constexpr static uintptr_t LOWER_BOUND_PAGE = LOWER_BOUND / FHU::FEX_PAGE_SIZE;
 
@@ -281,9 +284,16 @@ void *OSAllocator_64Bit::Mmap(void *addr, size_t length, int prot, int flags, in
     LiveRegion = FindLiveRegionForAddress(Addr, AddrEnd);
   }
 
+  // Place large floating anonymous mappings on huge page boundaries so the
+  // kernel's THP machinery can back them with large pages from the first touch.
+  // Big-heap guests otherwise pay well above native dTLB miss rates
+  const bool WantsHugePages = !Fixed && Addr == 0 &&
+    (flags & MAP_ANONYMOUS) && fd == -1 &&
+    length >= HUGE_PAGE_SIZE;
+
   again:
 
-  auto CheckIfRangeFits = [&AllocatedOffset](LiveVMARegion *Region, uint64_t length, int prot, int flags, int fd, off_t offset, uint64_t StartingPosition = 0) -> std::pair<LiveVMARegion*, void*> {
+  auto CheckIfRangeFits = [&AllocatedOffset, WantsHugePages](LiveVMARegion *Region, uint64_t length, int prot, int flags, int fd, off_t offset, uint64_t StartingPosition = 0) -> std::pair<LiveVMARegion*, void*> {
     uint64_t AllocatedPage{~0ULL};
     uint64_t NumberOfPages = length >> FHU::FEX_PAGE_SHIFT;
 
@@ -294,8 +304,20 @@ void *OSAllocator_64Bit::Mmap(void *addr, size_t length, int prot, int flags, in
         : Region->LastPageAllocation;
       size_t RegionNumberOfPages = Region->SlabInfo->RegionSize >> FHU::FEX_PAGE_SHIFT;
 
+      if (WantsHugePages && !StartingPosition) {
+        // Scan with worst-case alignment padding, then take the first huge page
+        // boundary inside the found run. Only the pages actually mapped get
+        // marked used, so the alignment slack stays free for later allocations.
+        // On failure fall through to the normal unaligned placement
+        constexpr uint64_t HugePagePages = HUGE_PAGE_SIZE >> FHU::FEX_PAGE_SHIFT;
+        auto SearchResult = Region->UsedPages.ForwardScanForRange<true>(LastAllocation, NumberOfPages + HugePagePages - 1, RegionNumberOfPages);
+        if (SearchResult.FoundElement != ~0ULL) {
+          const uint64_t FoundAddr = Region->SlabInfo->Base + SearchResult.FoundElement * FHU::FEX_PAGE_SIZE;
+          AllocatedPage = SearchResult.FoundElement + ((FEXCore::AlignUp(FoundAddr, HUGE_PAGE_SIZE) - FoundAddr) >> FHU::FEX_PAGE_SHIFT);
+        }
+      }
 
-      if (Region->HadMunmap) {
+      if (AllocatedPage == ~0ULL && Region->HadMunmap) {
         // Backward scan
         // We need to do a backward scan first to fill any holes
         // Otherwise we will very quickly run out of VMA regions (65k maximum)
@@ -329,6 +351,11 @@ void *OSAllocator_64Bit::Mmap(void *addr, size_t length, int prot, int flags, in
         if (MMapResult == MAP_FAILED) {
           return std::make_pair(Region, reinterpret_cast<void*>(-errno));
         }
+
+        if (WantsHugePages) {
+          // Any huge-page-aligned subrange can now be collapsed by khugepaged
+          ::madvise(MMapResult, length, MADV_HUGEPAGE);
+        }
         return std::make_pair(Region, MMapResult);
       }
     }
@@ -490,7 +517,11 @@ int OSAllocator_64Bit::Munmap(void *addr, size_t length) {
         // This woul be a bug in the frontend application
         // So be careful with mlock/munlock
         ::madvise(addr, length, MADV_DONTNEED);
-        ::mmap(addr, length, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        // Punch the hole with the exact flags the original reservation used.
+        // Matching vm_flags lets the kernel merge the hole with the surrounding
+        // reservation and with neighbouring holes instead of fragmenting the
+        // host VMA space, which slows every mmap-family syscall down
+        ::mmap(addr, length, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
       }
 
       (*it)->FreeSpace += FreedPages * 4096;
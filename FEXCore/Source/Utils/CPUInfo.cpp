@@ -1,14 +1,20 @@
 // SPDX-License-Identifier: MIT
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/fextl/string.h>
 #include <FEXHeaderUtils/Filesystem.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #ifdef _WIN32
 #include <thread>
 #else
 #include <linux/limits.h>
+#include <sched.h>
 #endif
 
 namespace FEXCore::CPUInfo {
@@ -27,6 +33,85 @@ namespace FEXCore::CPUInfo {
 
     return CPUs;
   }
+
+  // Reads a small integer-prefixed sysfs file. Returns false when the file
+  // doesn't exist or doesn't start with a number.
+  static bool ReadSysfsValue(const fextl::string &Path, uint64_t *Value) {
+    std::array<char, 32> Data{};
+    // Fixed size read since sysfs files report a full page as their size.
+    if (FEXCore::FileLoading::LoadFileToBuffer(Path, Data) <= 0) {
+      return false;
+    }
+
+    char *End{};
+    const uint64_t Result = std::strtoull(Data.data(), &End, 10);
+    if (End == Data.data()) {
+      return false;
+    }
+
+    *Value = Result;
+    return true;
+  }
+
+  bool CalculateAuxiliaryCPUSet(cpu_set_t *Set) {
+    const uint32_t CPUs = std::min(CalculateNumberOfCPUs(), static_cast<uint32_t>(CPU_SETSIZE));
+    CPU_ZERO(Set);
+
+    // Heterogeneous topology first: the kernel scales cpu_capacity so the
+    // fastest core type reads 1024 and slower types read less. Every CPU
+    // below the maximum capacity is an efficiency core we can hand to
+    // auxiliary threads.
+    uint64_t MaxCapacity = 0;
+    bool HaveCapacity = true;
+    for (uint32_t i = 0; i < CPUs; ++i) {
+      uint64_t Capacity{};
+      if (!ReadSysfsValue(fextl::fmt::format("/sys/devices/system/cpu/cpu{}/cpu_capacity", i), &Capacity)) {
+        HaveCapacity = false;
+        break;
+      }
+      MaxCapacity = std::max(MaxCapacity, Capacity);
+    }
+
+    if (HaveCapacity) {
+      bool Any = false;
+      for (uint32_t i = 0; i < CPUs; ++i) {
+        uint64_t Capacity{};
+        if (ReadSysfsValue(fextl::fmt::format("/sys/devices/system/cpu/cpu{}/cpu_capacity", i), &Capacity) &&
+            Capacity < MaxCapacity) {
+          CPU_SET(i, Set);
+          Any = true;
+        }
+      }
+
+      if (Any) {
+        return true;
+      }
+    }
+
+    // Homogeneous cores. On SMT systems take the secondary sibling of each
+    // physical core: a CPU whose thread_siblings_list doesn't lead with its
+    // own number shares a core with the CPU that does.
+    bool Any = false;
+    for (uint32_t i = 0; i < CPUs; ++i) {
+      uint64_t FirstSibling{};
+      if (ReadSysfsValue(fextl::fmt::format("/sys/devices/system/cpu/cpu{}/topology/thread_siblings_list", i), &FirstSibling) &&
+          FirstSibling != i) {
+        CPU_SET(i, Set);
+        Any = true;
+      }
+    }
+
+    return Any;
+  }
+
+  bool PinThisThreadToAuxiliaryCPUs() {
+    cpu_set_t Set;
+    if (!CalculateAuxiliaryCPUSet(&Set)) {
+      return false;
+    }
+
+    return sched_setaffinity(0, sizeof(Set), &Set) == 0;
+  }
 #else
   uint32_t CalculateNumberOfCPUs() {
     // May not return correct number of cores if some are parked.
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: MIT
+#include <FEXCore/Utils/CompileTimeTelemetry.h>
+#include <FEXCore/fextl/deque.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+namespace FEXCore::CompileTime {
+  namespace {
+    std::mutex TimerLock{};
+    // Deque so handed-out references survive later registrations.
+    fextl::deque<PassTimer> Timers{};
+
+    // The N slowest-compiling blocks seen so far by guest RIP. New entries
+    // replace the current fastest once the table is full.
+    struct SlowBlock {
+      uint64_t GuestRIP;
+      uint64_t Nanoseconds;
+    };
+
+    constexpr size_t NUM_SLOW_BLOCKS = 16;
+    std::mutex SlowBlockLock{};
+    std::array<SlowBlock, NUM_SLOW_BLOCKS> SlowBlocks{};
+    size_t NumSlowBlocks{};
+    // Admission threshold mirrored outside the lock so the common case of an
+    // unremarkable block compile doesn't take it.
+    std::atomic<uint64_t> SlowBlockFloor{};
+  }
+
+  PassTimer &RegisterPassTimer(std::string_view Name) {
+    std::unique_lock lk {TimerLock};
+    for (auto &Timer : Timers) {
+      if (Timer.Name == Name) {
+        return Timer;
+      }
+    }
+
+    auto &Timer = Timers.emplace_back();
+    Timer.Name = Name;
+    return Timer;
+  }
+
+  void RecordBlockCompile(uint64_t GuestRIP, uint64_t Nanoseconds) {
+    if (Nanoseconds <= SlowBlockFloor.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    std::unique_lock lk {SlowBlockLock};
+
+    // A block that gets recompiled (SMC, tier promotion) keeps one entry.
+    for (size_t i = 0; i < NumSlowBlocks; ++i) {
+      if (SlowBlocks[i].GuestRIP == GuestRIP) {
+        SlowBlocks[i].Nanoseconds = std::max(SlowBlocks[i].Nanoseconds, Nanoseconds);
+        return;
+      }
+    }
+
+    if (NumSlowBlocks < NUM_SLOW_BLOCKS) {
+      SlowBlocks[NumSlowBlocks++] = { GuestRIP, Nanoseconds };
+    }
+    else {
+      auto Fastest = std::min_element(SlowBlocks.begin(), SlowBlocks.end(),
+        [](const SlowBlock &a, const SlowBlock &b) { return a.Nanoseconds < b.Nanoseconds; });
+      if (Fastest->Nanoseconds >= Nanoseconds) {
+        return;
+      }
+      *Fastest = { GuestRIP, Nanoseconds };
+    }
+
+    if (NumSlowBlocks == NUM_SLOW_BLOCKS) {
+      auto Fastest = std::min_element(SlowBlocks.begin(), SlowBlocks.end(),
+        [](const SlowBlock &a, const SlowBlock &b) { return a.Nanoseconds < b.Nanoseconds; });
+      SlowBlockFloor.store(Fastest->Nanoseconds, std::memory_order_relaxed);
+    }
+  }
+
+  fextl::string Dump() {
+    fextl::string Result{};
+
+    {
+      std::unique_lock lk {TimerLock};
+      if (!Timers.empty()) {
+        // Sort a snapshot by total time so the expensive passes lead.
+        fextl::vector<std::pair<fextl::string, std::pair<uint64_t, uint64_t>>> Sorted{};
+        for (auto &Timer : Timers) {
+          Sorted.emplace_back(Timer.Name, std::make_pair(
+            Timer.Nanoseconds.load(std::memory_order_relaxed),
+            Timer.Invocations.load(std::memory_order_relaxed)));
+        }
+        std::sort(Sorted.begin(), Sorted.end(),
+          [](const auto &a, const auto &b) { return a.second.first > b.second.first; });
+
+        Result += "Compile time per pass:\n";
+        for (auto &[Name, Data] : Sorted) {
+          auto [Nanoseconds, Invocations] = Data;
+          if (!Invocations) {
+            continue;
+          }
+          Result += fextl::fmt::format("  {}: {:.3f}ms over {} runs ({}ns avg)\n",
+            Name, Nanoseconds / 1'000'000.0, Invocations, Nanoseconds / Invocations);
+        }
+      }
+    }
+
+    {
+      std::unique_lock lk {SlowBlockLock};
+      if (NumSlowBlocks) {
+        auto Sorted = SlowBlocks;
+        std::sort(Sorted.begin(), Sorted.begin() + NumSlowBlocks,
+          [](const SlowBlock &a, const SlowBlock &b) { return a.Nanoseconds > b.Nanoseconds; });
+
+        Result += "Slowest block compiles:\n";
+        for (size_t i = 0; i < NumSlowBlocks; ++i) {
+          Result += fextl::fmt::format("  RIP 0x{:x}: {:.3f}ms\n",
+            Sorted[i].GuestRIP, Sorted[i].Nanoseconds / 1'000'000.0);
+        }
+      }
+    }
+
+    return Result;
+  }
+}
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+#include <FEXCore/Utils/Statistics.h>
+
+#include <algorithm>
+#include <array>
+
+namespace FEXCore::Statistics {
+  static std::array<Stat, StatType::STAT_LAST> Stats = {{ }};
+
+  Stat &GetStat(StatType Type) {
+    return Stats.at(Type);
+  }
+
+  void SnapshotStats(uint64_t *Values, size_t Count) {
+    Count = std::min(Count, Stats.size());
+    for (size_t i = 0; i < Count; ++i) {
+      Values[i] = *Stats[i];
+    }
+  }
+}
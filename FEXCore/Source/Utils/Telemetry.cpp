@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: MIT
 #include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Utils/CompileTimeTelemetry.h>
 #include <FEXCore/Utils/File.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Telemetry.h>
@@ -7,10 +9,14 @@
 #include <FEXCore/fextl/string.h>
 #include <FEXHeaderUtils/Filesystem.h>
 
+#include <algorithm>
 #include <array>
 #include <stddef.h>
 #include <string_view>
 #include <system_error>
+#include <utility>
+
+#include <FEXCore/fextl/vector.h>
 
 namespace FEXCore::Telemetry {
 #ifndef FEX_DISABLE_TELEMETRY
@@ -33,6 +39,66 @@ namespace FEXCore::Telemetry {
     "Uses 32-bit Segment SS",
     "Uses 32-bit Segment CS",
     "Uses 32-bit Segment DS",
+    "Shadow validated blocks",
+    "IR validation errors",
+    "RA validation errors",
+  };
+
+  // Execution counts for the softfloat/vector fallback handlers, bumped
+  // inline by the JIT at every lowered fallback call site. In enum order of
+  // Core::FallbackHandlerIndex, like TelemetryNames above.
+  static std::array<uint64_t, Core::FallbackHandlerIndex::OPINDEX_MAX> FallbackCensus = {{ }};
+  const std::array<std::string_view, Core::FallbackHandlerIndex::OPINDEX_MAX> FallbackCensusNames {
+    "F80CVTTO_4",
+    "F80CVTTO_8",
+    "F80CVT_4",
+    "F80CVT_8",
+    "F80CVTINT_2",
+    "F80CVTINT_4",
+    "F80CVTINT_8",
+    "F80CVTINT_TRUNC2",
+    "F80CVTINT_TRUNC4",
+    "F80CVTINT_TRUNC8",
+    "F80CMP_0",
+    "F80CMP_1",
+    "F80CMP_2",
+    "F80CMP_3",
+    "F80CMP_4",
+    "F80CMP_5",
+    "F80CMP_6",
+    "F80CMP_7",
+    "F80CVTTOINT_2",
+    "F80CVTTOINT_4",
+    "F80ROUND",
+    "F80F2XM1",
+    "F80TAN",
+    "F80SQRT",
+    "F80SIN",
+    "F80COS",
+    "F80XTRACT_EXP",
+    "F80XTRACT_SIG",
+    "F80BCDSTORE",
+    "F80BCDLOAD",
+    "F80ADD",
+    "F80SUB",
+    "F80MUL",
+    "F80DIV",
+    "F80FYL2X",
+    "F80ATAN",
+    "F80FPREM1",
+    "F80FPREM",
+    "F80SCALE",
+    "F64SIN",
+    "F64COS",
+    "F64TAN",
+    "F64ATAN",
+    "F64F2XM1",
+    "F64FYL2X",
+    "F64FPREM",
+    "F64FPREM1",
+    "F64SCALE",
+    "VPCMPESTRX",
+    "VPCMPISTRX",
   };
 
   static bool Enabled {true};
@@ -78,6 +144,32 @@ namespace FEXCore::Telemetry {
         auto &Data = TelemetryValues.at(i);
         fextl::fmt::print(File, "{}: {}\n", Name, *Data);
       }
+
+      // Ranked census of the fallback handlers that actually ran, hottest
+      // first, so the most profitable missing native lowering leads the list.
+      fextl::vector<std::pair<uint64_t, size_t>> Census{};
+      for (size_t i = 0; i < FallbackCensus.size(); ++i) {
+        if (FallbackCensus[i]) {
+          Census.emplace_back(FallbackCensus[i], i);
+        }
+      }
+
+      if (!Census.empty()) {
+        std::sort(Census.begin(), Census.end(),
+          [](const auto &a, const auto &b) { return a.first > b.first; });
+
+        fextl::fmt::print(File, "Fallback census (executions per fallback handler):\n");
+        for (auto &[Count, Index] : Census) {
+          fextl::fmt::print(File, "  {}: {}\n", FallbackCensusNames.at(Index), Count);
+        }
+      }
+
+      // Compile-time accounting rides along when it was enabled.
+      auto CompileTimes = FEXCore::CompileTime::Dump();
+      if (!CompileTimes.empty()) {
+        fextl::fmt::print(File, "{}", CompileTimes);
+      }
+
       File.Flush();
     }
   }
@@ -85,5 +177,9 @@ namespace FEXCore::Telemetry {
   Value &GetTelemetryValue(TelemetryType Type) {
     return TelemetryValues.at(Type);
   }
+
+  uint64_t *GetFallbackCensusCounters() {
+    return Enabled ? FallbackCensus.data() : nullptr;
+  }
 #endif
 }
@@ -213,6 +213,12 @@ namespace Type {
       OptionMap.erase(Option);
     }
 
+    // Drops everything this layer loaded. Required ahead of a re-Load since
+    // Set appends to the option's value list rather than replacing it.
+    void Clear() {
+      OptionMap.clear();
+    }
+
     LayerType GetLayerType() const { return Type; }
     const LayerOptions &GetOptionMap() const { return OptionMap; }
 
@@ -226,6 +232,7 @@ namespace Type {
 
   FEX_DEFAULT_VISIBILITY void Load();
   FEX_DEFAULT_VISIBILITY void ReloadMetaLayer();
+  FEX_DEFAULT_VISIBILITY void ReloadFileLayers();
   FEX_DEFAULT_VISIBILITY fextl::string FindContainer();
   FEX_DEFAULT_VISIBILITY fextl::string FindContainerPrefix();
 
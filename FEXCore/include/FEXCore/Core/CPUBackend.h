@@ -173,8 +173,26 @@ namespace CPU {
      */
     virtual void ClearRelocations() {}
 
+    /**
+     * @brief Publishes any code whose instruction-cache maintenance the backend batched up
+     *
+     * Backends may defer the per-block cache maintenance and cover a run of
+     * contiguously emitted blocks with one ranged operation. Nothing compiled
+     * since the previous flush may be executed, or made visible to another
+     * thread, before calling this.
+     */
+    virtual void FlushCodePublishWindow() {}
+
     bool IsAddressInCodeBuffer(uintptr_t Address) const;
 
+    /**
+     * @brief Binds all code buffers to the NUMA node of the calling thread.
+     *
+     * Must be called from the execution thread itself, once it is running on
+     * the CPU it will execute from.
+     */
+    void BindCodeBuffersToLocalNode();
+
   protected:
     // Max spill slot size in bytes. We need at most 32 bytes
     // to be able to handle a 256-bit vector store to a slot.
@@ -185,6 +203,20 @@ namespace CPU {
     size_t InitialCodeSize, MaxCodeSize;
     [[nodiscard]] CodeBuffer *GetEmptyCodeBuffer();
 
+    /**
+     * @brief Switches to a fresh code buffer while keeping the filled ones resident.
+     *
+     * Blocks in the old buffers stay valid and reachable, so unlike a full cache
+     * clear this doesn't cause a recompile storm. The old buffers are reclaimed
+     * on the next full clear.
+     *
+     * @param MinimumSize - The new buffer must have at least this much space
+     *
+     * @return The new buffer, or nullptr if the configured max code size is
+     * exhausted and the caller needs to do a full clear instead.
+     */
+    [[nodiscard]] CodeBuffer *TryExpandCodeBuffer(size_t MinimumSize);
+
     // This is the current code buffer that we are tracking
     CodeBuffer *CurrentCodeBuffer{};
 
@@ -58,6 +58,11 @@ namespace FEXCore::Context {
     MODE_64BIT,
   };
 
+  enum class WatchpointType {
+    WRITE,      ///< Hit on guest stores only
+    READWRITE,  ///< Hit on guest loads and stores
+  };
+
   struct CustomIRResult {
     void *Creator;
     void *Data;
@@ -78,6 +83,8 @@ namespace FEXCore::Context {
     public:
       virtual ~AOTIRWriter() = default;
       virtual void Write(const void* Data, size_t Size) = 0;
+      ///< Overwrites previously written data without moving the append cursor.
+      virtual void WriteAt(const void* Data, size_t Size, size_t Offset) = 0;
       virtual size_t Offset() = 0;
       virtual void Close() = 0;
   };
@@ -104,6 +111,16 @@ namespace FEXCore::Context {
   using AOTIRRenamerCBFn = std::function<void(const fextl::string&)>;
   using AOTIRWriterCBFn = std::function<fextl::unique_ptr<AOTIRWriter>(const fextl::string&)>;
 
+  // Popularity tiers for named guest libraries, rising with fleet-wide usage.
+  // Tiers at or above HOT pin the library's code at full optimization from
+  // first touch and make it eligible for shared-cache serialization.
+  constexpr uint32_t LIBRARY_TIER_DEFAULT = 0;
+  constexpr uint32_t LIBRARY_TIER_POPULAR = 1;
+  constexpr uint32_t LIBRARY_TIER_HOT = 2;
+  // Maps a library's base filename to its popularity tier. The frontend backs
+  // this with whatever fleet aggregation it has available.
+  using LibraryPriorityCBFn = std::function<uint32_t(const fextl::string&)>;
+
   class Context {
     public:
       virtual ~Context() = default;
@@ -149,6 +166,15 @@ namespace FEXCore::Context {
       FEX_DEFAULT_VISIBILITY virtual void CompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP) = 0;
       FEX_DEFAULT_VISIBILITY virtual void CompileRIPCount(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, uint64_t MaxInst) = 0;
 
+      /**
+       * @brief Asks the background compiler to translate a guest RIP before execution reaches it.
+       *
+       * Best-effort and asynchronous. Lets the frontend pre-translate entry points it knows will
+       * run soon, such as freshly registered signal handlers. A no-op when no background compile
+       * consumer is active.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void PretranslateRIP(uint64_t GuestRIP) = 0;
+
       /**
        * @brief Allows the frontend to pass in a custom CPUBackend creation factory
        *
@@ -172,6 +198,17 @@ namespace FEXCore::Context {
       ///< State reconstruction helpers
       ///< Reconstructs the guest RIP from the passed in thread context and related Host PC.
       FEX_DEFAULT_VISIBILITY virtual uint64_t RestoreRIPFromHostPC(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) = 0;
+
+      /**
+       * @brief Records that an unaligned atomic inside JIT code faulted and was backpatched.
+       *
+       * Blocks that keep faulting get invalidated and recompiled with the barrier-based
+       * TSO lowering up front, stopping the SIGBUS-per-instruction backpatch cycle.
+       *
+       * @param Thread The thread that took the fault
+       * @param HostPC The host PC of the faulting instruction
+       */
+      FEX_DEFAULT_VISIBILITY virtual void RecordTSOFaultBackpatch(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) = 0;
       /**
        * @brief Reconstructs a compacted EFLAGS from FEX's internal EFLAG representation.
        *
@@ -222,15 +259,49 @@ namespace FEXCore::Context {
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRLoader(AOTIRLoaderCBFn CacheReader) = 0;
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRWriter(AOTIRWriterCBFn CacheWriter) = 0;
       FEX_DEFAULT_VISIBILITY virtual void SetAOTIRRenamer(AOTIRRenamerCBFn CacheRenamer) = 0;
+      FEX_DEFAULT_VISIBILITY virtual void SetLibraryPriorityQuery(LibraryPriorityCBFn Query) = 0;
 
       FEX_DEFAULT_VISIBILITY virtual void FinalizeAOTIRCache() = 0;
       FEX_DEFAULT_VISIBILITY virtual void WriteFilesWithCode(AOTIRCodeFileWriterFn Writer) = 0;
 
+      /**
+       * @brief Multiblock trace budget as adjusted by the PMU tuner.
+       *
+       * @return The learned budget, or 0 when PMU tuning is inactive.
+       */
+      FEX_DEFAULT_VISIBILITY virtual int32_t GetTunedTraceBudget() const = 0;
+
+      /**
+       * @brief PMU-derived quality score for this session's codegen parameters.
+       *
+       * Misses per million cycles, lower is better. Returns -1 when PMU
+       * tuning is inactive or the session was too short to score.
+       */
+      FEX_DEFAULT_VISIBILITY virtual int64_t GetTunerSessionScore() const = 0;
+
       FEX_DEFAULT_VISIBILITY virtual void ClearCodeCache(FEXCore::Core::InternalThreadState *Thread) = 0;
       FEX_DEFAULT_VISIBILITY virtual void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) = 0;
       FEX_DEFAULT_VISIBILITY virtual void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length, CodeRangeInvalidationFn callback) = 0;
       FEX_DEFAULT_VISIBILITY virtual void MarkMemoryShared(FEXCore::Core::InternalThreadState *Thread) = 0;
 
+      /**
+       * @brief Installs a guest data watchpoint.
+       *
+       * Blocks compiled while a watchpoint is active get inline address checks on their
+       * guest memory accesses, raising SIGTRAP on a hit. The caller must pause threads
+       * and invalidate translated code around changes so running code picks them up.
+       *
+       * @return false when all watchpoint slots are in use
+       */
+      FEX_DEFAULT_VISIBILITY virtual bool SetGuestWatchpoint(uint64_t Address, uint64_t Size, WatchpointType Type) = 0;
+
+      /**
+       * @brief Removes a guest data watchpoint previously installed with SetGuestWatchpoint.
+       *
+       * @return false when no matching watchpoint exists
+       */
+      FEX_DEFAULT_VISIBILITY virtual bool ClearGuestWatchpoint(uint64_t Address, uint64_t Size) = 0;
+
       FEX_DEFAULT_VISIBILITY virtual void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, fextl::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress) = 0;
 
       /**
@@ -259,6 +330,14 @@ namespace FEXCore::Context {
        */
       FEX_DEFAULT_VISIBILITY virtual void EnableExitOnHLT() = 0;
 
+      /**
+       * @brief Re-reads the tunables that are safe to change on a running context.
+       *
+       * Only affects configuration consumed per-compile (multiblock tunables, telemetry).
+       * Call after the config layers have been reloaded from disk.
+       */
+      FEX_DEFAULT_VISIBILITY virtual void ReloadLiveTunables() = 0;
+
     private:
   };
 
@@ -99,11 +99,13 @@ namespace FEXCore::Core {
     uint32_t es_cached{}, cs_cached{}, ss_cached{}, ds_cached{};
     uint64_t gs_cached{};
     uint64_t fs_cached{};
-    uint64_t InlineJITBlockHeader{};
-    XMMRegs xmm{};
+    // Hot scalar state lives ahead of the 512-byte xmm array so that rip,
+    // gregs, segments and flags all pack into the first four cache lines.
     uint8_t flags[48]{};
     uint64_t pf_raw{};
     uint64_t af_raw{};
+    uint64_t InlineJITBlockHeader{};
+    XMMRegs xmm{};
     uint64_t mm[8][2]{};
 
     // 32bit x86 state
@@ -237,12 +239,20 @@ namespace FEXCore::Core {
       uint64_t SyscallHandlerObj{};
       uint64_t SyscallHandlerFunc{};
       uint64_t ExitFunctionLink{};
+      uint64_t IndirectBranchPredictorLink{};
 
       uint64_t FallbackHandlerPointers[FallbackHandlerIndex::OPINDEX_MAX];
+      // Base of the process-wide fallback census counters, one slot per
+      // FallbackHandlerIndex. Null when telemetry is disabled.
+      uint64_t FallbackCensusCounters;
       uint64_t NamedVectorConstantPointers[FEXCore::IR::NamedVectorConstant::NAMED_VECTOR_CONST_POOL_MAX];
       uint64_t IndexedNamedVectorConstantPointers[FEXCore::IR::IndexNamedVectorConstant::INDEXED_NAMED_VECTOR_MAX];
       uint64_t TelemetryValueAddresses[FEXCore::Telemetry::TYPE_LAST];
 
+      // Address of the STAT_STREX_FAILURES counter, bumped by the retry path
+      // of the LL/SC atomic fallback loops on hosts without LSE.
+      uint64_t StatStrexFailureCounter{};
+
       // Thread Specific
       /**
        * @name Dispatcher pointers
@@ -250,6 +260,7 @@ namespace FEXCore::Core {
       uint64_t DispatcherLoopTop{};
       uint64_t DispatcherLoopTopFillSRA{};
       uint64_t ExitFunctionLinker{};
+      uint64_t IndirectBranchPredictorLinker{};
       uint64_t ThreadStopHandlerSpillSRA{};
       uint64_t ThreadPauseHandlerSpillSRA{};
       uint64_t UnimplementedInstructionHandler{};
@@ -259,6 +270,9 @@ namespace FEXCore::Core {
       uint64_t SignalReturnHandler{};
       uint64_t SignalReturnHandlerRT{};
       uint64_t L1Pointer{};
+      // Index mask matching the current L1 table size. Loaded by the
+      // dispatcher on every lookup since the table can grow at runtime.
+      uint64_t L1EntriesMask{};
       uint64_t L2Pointer{};
       /**  @} */
 
@@ -314,6 +328,59 @@ namespace FEXCore::Core {
 
     uint32_t SignalHandlerRefCounter{};
 
+    // Number of guest PAUSE instructions this thread has executed, maintained
+    // by the JIT's Yield lowering. The low bits decide when a spinning thread
+    // escalates from a yield hint to a WFE, so over-subscribed guest spin
+    // loops stop burning whole host cores. Never reset, wrapping is fine.
+    uint32_t PauseSpinCount{};
+
+    /**
+     * @brief Host `rseq` area for kernel-maintained current-CPU tracking
+     *
+     * Registered once per thread when execution starts; the guest-facing rseq
+     * syscall is rejected so the host slot is free for our use. While
+     * registered the kernel keeps CPUId current across migrations, letting the
+     * ProcessorID lowering service rdtscp's TSC_AUX read with two loads
+     * instead of a getcpu syscall. CPUId stays negative when registration
+     * fails (old kernel, or libc already owns the slot) and the lowering falls
+     * back to the syscall path.
+     */
+    struct alignas(32) HostRSeqArea {
+      uint32_t CPUIdStart{};
+      // Current CPU while registered, otherwise RSEQ_CPU_ID_UNINITIALIZED (-1)
+      uint32_t CPUId{~0U};
+      uint64_t RSeqCS{};
+      uint32_t Flags{};
+    };
+    HostRSeqArea RSeq;
+
+    // NUMA node for the `(node << 12) | cpu` format getcpu reports. Seeded at
+    // rseq registration and refreshed whenever the syscall fallback runs; a
+    // stale value after a cross-node migration only misreports the node bits.
+    uint32_t RSeqNodeId{};
+
+    /**
+     * @brief Flight recorder ring of recently executed block entries
+     *
+     * With FlightRecorderSampleInterval set, every Nth block entry the JIT
+     * appends the block's guest RIP and the raw cycle counter here. The ring
+     * only ever holds the most recent samples; consumers diff neighbouring
+     * cycle values to see where the time went. Written by JIT code on this
+     * thread only. Readers (crash dump streaming, the on-demand dump) may
+     * observe an entry mid-write - this is forensics data, not transactional.
+     */
+    struct FlightRecorderEntry {
+      uint64_t GuestRIP;
+      uint64_t Cycles;
+    };
+    constexpr static uint32_t FLIGHT_RECORDER_ENTRIES = 2048; // Must be a power of two
+    constexpr static uint32_t FLIGHT_RECORDER_MASK = FLIGHT_RECORDER_ENTRIES - 1;
+    // Null while the recorder is disabled. Points at the thread's backing storage.
+    FlightRecorderEntry* FlightRecorderRing{};
+    uint32_t FlightRecorderIndex{};
+    // Counts down once per block entry, a sample is taken when it reaches zero.
+    uint32_t FlightRecorderCountdown{};
+
     struct alignas(8) SynchronousFaultDataStruct {
       bool FaultToTopAndGeneratedException{};
       uint8_t Signal;
@@ -325,9 +392,26 @@ namespace FEXCore::Core {
 
     InternalThreadState* Thread;
 
+    /**
+     * @brief Shadow return-address stack for guest CALL/RET prediction
+     *
+     * CALL pushes the guest return RIP along with its host block if one is
+     * already compiled, RET pops and branches directly on a match.
+     * Ring semantics, over and underflow only ever cost a misprediction.
+     */
+    struct ReturnPredictionEntry {
+      uint64_t GuestRIP;
+      uint64_t HostCode;
+    };
+    constexpr static uint64_t RETURN_PREDICTION_STACK_ENTRIES = 16;
+    constexpr static uint64_t RETURN_PREDICTION_STACK_MASK = RETURN_PREDICTION_STACK_ENTRIES - 1;
+    uint64_t ReturnPredictionIndex{};
+    ReturnPredictionEntry ReturnPredictionStack[RETURN_PREDICTION_STACK_ENTRIES]{};
+
     // Pointers that the JIT needs to load to remove relocations
     JITPointers Pointers;
   };
+  static_assert(sizeof(CpuStateFrame::HostRSeqArea) == 32, "Kernel requires a 32-byte rseq area");
   static_assert(offsetof(CpuStateFrame, State) == 0, "CPUState must be first member in CpuStateFrame");
   static_assert(offsetof(CpuStateFrame, State.rip) == 0, "rip must be zero offset in CpuStateFrame");
   static_assert(offsetof(CpuStateFrame, Pointers) % 8 == 0, "JITPointers need to be aligned to 8 bytes");
@@ -27,6 +27,8 @@ class HostFeatures final {
     bool SupportsAVX{};
     bool SupportsAVX2{};
     bool SupportsSVE{};
+    bool SupportsSVE2{};
+    bool SupportsSVEBitPerm{};
     bool SupportsSHA{};
     bool SupportsBMI1{};
     bool SupportsBMI2{};
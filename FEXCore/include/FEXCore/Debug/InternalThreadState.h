@@ -11,9 +11,11 @@
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/robin_map.h>
+#include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/vector.h>
 #include <FEXHeaderUtils/TypeDefines.h>
 
+#include <array>
 #include <chrono>
 #include <shared_mutex>
 #include <type_traits>
@@ -54,13 +56,23 @@ namespace FEXCore::Core {
   /**
    * @brief Contains debug data for a block of code for later debugger analysis
    *
-   * Needs to remain around for as long as the code could be executed at least
+   * Lives in the compiling thread as reused scratch; only valid for the
+   * duration of one block compile
    */
   struct DebugData : public FEXCore::Allocator::FEXAllocOperators {
-    uint64_t HostCodeSize; ///< The size of the code generated in the host JIT
+    uint64_t HostCodeSize{}; ///< The size of the code generated in the host JIT
     fextl::vector<DebugDataSubblock> Subblocks;
     fextl::vector<DebugDataGuestOpcode> GuestOpcodes;
-    fextl::vector<FEXCore::CPU::Relocation> *Relocations;
+    fextl::vector<FEXCore::CPU::Relocation> *Relocations{};
+
+    // Clears the contents for the next block. The vectors keep their capacity,
+    // which is the point of reusing this across compiles.
+    void Reset() {
+      HostCodeSize = 0;
+      Subblocks.clear();
+      GuestOpcodes.clear();
+      Relocations = nullptr;
+    }
   };
 
   struct LocalIREntry {
@@ -68,7 +80,6 @@ namespace FEXCore::Core {
     uint64_t Length;
     fextl::unique_ptr<FEXCore::IR::IRListView, FEXCore::IR::IRListViewDeleter> IR;
     FEXCore::IR::RegisterAllocationData::UniquePtr RAData;
-    fextl::unique_ptr<FEXCore::Core::DebugData> DebugData;
   };
 
   // Buffered JIT symbol tracking.
@@ -117,6 +128,38 @@ namespace FEXCore::Core {
 
     fextl::robin_map<uint64_t, LocalIREntry> DebugStore;
 
+    // Per-block compile metadata, handed out by CompileCode instead of a fresh
+    // heap allocation for every block. Reset at the start of each compile and
+    // only valid until that compile finishes.
+    FEXCore::Core::DebugData ScratchDebugData;
+
+    // Tracks how many times a block has been compiled at the baseline tier.
+    // Only used when TieredCompilation is enabled.
+    fextl::robin_map<uint64_t, uint32_t> BaselineCompileCount;
+
+    // Multiblock regions this thread compiled that consumed a meaningful
+    // slice of the trace budget, as {entry RIP, guest instruction count}.
+    // When PMU feedback narrows the budget below a region's size it gets
+    // dropped and recompiles split. Only populated when PMU tuning is enabled.
+    fextl::vector<std::pair<uint64_t, uint64_t>> OversizedRegions;
+
+    // Tuner narrowing generation this thread last reconciled against.
+    uint32_t ReconciledNarrowGeneration {};
+
+    // Statically known branch targets collected by the frontend while decoding.
+    // Drained into the context's speculative compile queue after each compile.
+    // Only populated when SpeculativeCompilation is enabled.
+    fextl::set<uint64_t> SpeculativeBranchTargets;
+
+    // Set for compile-only background threads. These always compile at the full
+    // tier since their output is only reachable through the shared code cache.
+    bool IsBackgroundCompileThread {false};
+
+    // Set for guest threads flagged latency critical. These only ever take the
+    // bounded baseline-tier compile on their own time; promotion to the
+    // optimized tier is deferred to the background compile thread.
+    bool LatencyCriticalCompile {false};
+
     fextl::unique_ptr<FEXCore::Frontend::Decoder> FrontendDecoder;
     fextl::unique_ptr<FEXCore::IR::PassManager> PassManager;
     FEXCore::HLE::ThreadManagement ThreadManager;
@@ -135,10 +178,30 @@ namespace FEXCore::Core {
       int Signal;
     };
 
+    // Backing storage for CurrentFrame->FlightRecorderRing. Sized once at
+    // thread creation when the flight recorder is enabled, otherwise empty.
+    fextl::vector<FEXCore::Core::CpuStateFrame::FlightRecorderEntry> FlightRecorderStorage;
+
     // Queue of thread local signal frames that have been deferred.
     // Async signals aren't guaranteed to be delivered in any particular order, but FEX treats them as FILO.
     fextl::vector<DeferredSignalState> DeferredSignalFrames;
 
+    // Memoized RIP reconstruction results for repeated fault sites.
+    // Managed runtimes that rely on hardware null checks and stack probes
+    // fault at the same handful of host instructions over and over. The
+    // block's RIP entries are delta encoded, so reconstruction walks them
+    // linearly from the block entry - decoding each fault site once and
+    // memoizing here keeps the signal hot path at a fixed cost.
+    // Only touched from this thread (including its signal handler) and
+    // cleared whenever the thread's code buffer is reset, since a reset
+    // reuses host addresses for unrelated guest code.
+    struct FaultSiteEntry {
+      uint64_t HostPC;
+      uint64_t GuestRIP;
+    };
+    constexpr static size_t FaultSiteCacheSize = 32; // Direct mapped, must be a power of two
+    std::array<FaultSiteEntry, FaultSiteCacheSize> FaultSiteCache{};
+
     // BaseFrameState should always be at the end, directly before the interrupt fault page
     alignas(16) FEXCore::Core::CpuStateFrame BaseFrameState{};
 
@@ -533,6 +533,12 @@ enum NamedVectorConstant : uint8_t {
   NAMED_VECTOR_BLENDPS_1011B,
   NAMED_VECTOR_BLENDPS_1101B,
   NAMED_VECTOR_BLENDPS_1110B,
+  NAMED_VECTOR_MOVMSKB_MASK,
+  NAMED_VECTOR_MOVMSKB_MASK_UPPER,
+  NAMED_VECTOR_SIGN_MASK_PS,
+  NAMED_VECTOR_SIGN_MASK_PS_UPPER,
+  NAMED_VECTOR_SIGN_MASK_PD,
+  NAMED_VECTOR_SIGN_MASK_PD_UPPER,
   NAMED_VECTOR_CONST_POOL_MAX,
   // Beginning of named constants that don't have a constant pool backing.
   NAMED_VECTOR_ZERO = NAMED_VECTOR_CONST_POOL_MAX,
@@ -550,6 +556,9 @@ enum IndexNamedVectorConstant : uint8_t {
   INDEXED_NAMED_VECTOR_DPPS_MASK,
   INDEXED_NAMED_VECTOR_DPPD_MASK,
   INDEXED_NAMED_VECTOR_PBLENDW,
+  INDEXED_NAMED_VECTOR_VPERMQ,
+  INDEXED_NAMED_VECTOR_VPERMILPS,
+  INDEXED_NAMED_VECTOR_VPERMILPD,
   INDEXED_NAMED_VECTOR_MAX,
 };
 
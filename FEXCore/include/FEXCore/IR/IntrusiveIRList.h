@@ -70,6 +70,13 @@ class DualIntrusiveAllocator {
       memcpy(reinterpret_cast<void*>(List), reinterpret_cast<void*>(rhs.List), ListCurrentOffset);
     }
 
+    void CopyData(const void *DataPtr, size_t Size_Data, const void *ListPtr, size_t Size_List) {
+      DataCurrentOffset = Size_Data;
+      ListCurrentOffset = Size_List;
+      memcpy(reinterpret_cast<void*>(Data), DataPtr, Size_Data);
+      memcpy(reinterpret_cast<void*>(List), ListPtr, Size_List);
+    }
+
   protected:
     DualIntrusiveAllocator(size_t Size)
       : MemorySize {Size} {
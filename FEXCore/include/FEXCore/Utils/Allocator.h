@@ -14,6 +14,12 @@ namespace FEXCore::Allocator {
 
   FEX_DEFAULT_VISIBILITY size_t DetermineVASize();
 
+  // Binds a memory region's pages to the NUMA node the calling thread is
+  // currently running on. Pages that have already been faulted in stay where
+  // they are; only future faults are affected. No-op on kernels without NUMA
+  // support or with more nodes than the fixed-width mask covers.
+  FEX_DEFAULT_VISIBILITY void BindToLocalNode(void *Ptr, size_t Size);
+
 #ifdef GLIBC_ALLOCATOR_FAULT
   // Glibc hooks should only fault once we are in main.
   // Required since glibc allocator hooking will catch things before FEX has control.
@@ -60,6 +66,11 @@ namespace FEXCore::Allocator {
   };
 #endif
 
+  // Hands the allocator's dirty pages back to the kernel. jemalloc purges all
+  // arenas, the glibc fallback trims the main arena. Best effort, safe to call
+  // from any thread.
+  FEX_DEFAULT_VISIBILITY void TrimHeap();
+
   // Disable allocations through glibc's sbrk allocation method.
   // Returns a pointer at the end of the sbrk region.
   FEX_DEFAULT_VISIBILITY void *DisableSBRKAllocations();
@@ -4,6 +4,10 @@
 
 #include <cstdint>
 
+#ifndef _WIN32
+#include <sched.h>
+#endif
+
 namespace FEXCore::CPUInfo {
   /**
    * @brief Calculate the number of CPUs in the system regardless of affinity mask.
@@ -11,4 +15,24 @@ namespace FEXCore::CPUInfo {
    * @return The number of CPUs in the system.
    */
   FEX_DEFAULT_VISIBILITY uint32_t CalculateNumberOfCPUs();
+
+#ifndef _WIN32
+  /**
+   * @brief Calculate the set of CPUs that emulator auxiliary threads should prefer.
+   *
+   * Picks the efficiency cores on heterogeneous systems (lowest sysfs
+   * cpu_capacity), falling back to one SMT sibling per physical core on SMT
+   * systems, leaving the remaining cores for guest threads.
+   *
+   * @return false when the topology is flat and no placement restriction is useful.
+   */
+  FEX_DEFAULT_VISIBILITY bool CalculateAuxiliaryCPUSet(cpu_set_t *Set);
+
+  /**
+   * @brief Pin the calling thread to the auxiliary CPU set.
+   *
+   * @return false when the topology is flat or the affinity couldn't be applied.
+   */
+  FEX_DEFAULT_VISIBILITY bool PinThisThreadToAuxiliaryCPUs();
+#endif
 }
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/Utils/CompilerDefs.h>
+#include <FEXCore/fextl/string.h>
+
+#include <atomic>
+#include <stdint.h>
+#include <string_view>
+#include <time.h>
+
+namespace FEXCore::CompileTime {
+  // Per-pass compile time accounting, enabled with the CompileTimeTelemetry
+  // config option.
+  //
+  // Timers are process wide; every thread's PassManager registers against the
+  // same timer for a given pass name so the totals cover the whole process.
+  // The aggregate is appended to the Telemetry dump at shutdown and can be
+  // fetched live through the GdbServer `monitor compiletime` command.
+  struct PassTimer final {
+    fextl::string Name;
+    std::atomic<uint64_t> Nanoseconds{};
+    std::atomic<uint64_t> Invocations{};
+
+    void Add(uint64_t Duration) {
+      Nanoseconds.fetch_add(Duration, std::memory_order_relaxed);
+      Invocations.fetch_add(1, std::memory_order_relaxed);
+    }
+  };
+
+  static inline uint64_t Now() {
+    // Same clock as the profiler; a VDSO clock_gettime is noise next to an
+    // optimization pass run.
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+  }
+
+  // Returns the process-wide timer for this pass name, creating it on first
+  // use. The reference stays valid for the lifetime of the process.
+  FEX_DEFAULT_VISIBILITY PassTimer &RegisterPassTimer(std::string_view Name);
+
+  // Feeds a finished block compile in to the slowest-block tracking.
+  FEX_DEFAULT_VISIBILITY void RecordBlockCompile(uint64_t GuestRIP, uint64_t Nanoseconds);
+
+  // Renders the pass totals and the slowest blocks as text. Empty when nothing
+  // was recorded.
+  FEX_DEFAULT_VISIBILITY fextl::string Dump();
+}
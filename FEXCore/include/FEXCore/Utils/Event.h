@@ -42,6 +42,12 @@ public:
     }
   }
 
+  // Drops a pending signal without waking anything. Only safe when no
+  // thread can be waiting, e.g. when recycling the owning object.
+  void Reset() {
+    FlagObject.TestAndClear();
+  }
+
   void Wait() {
     // Have we signaled before we started waiting?
     if (FlagObject.TestAndClear())
@@ -71,6 +71,12 @@ namespace FEXCore {
         DoNotify(INT_MAX);
       }
 
+      // Drops a pending signal without waking anything. Only safe when no
+      // thread can be waiting, e.g. when recycling the owning object.
+      void Reset() {
+        Mutex.store(UNSIGNALED);
+      }
+
     private:
       std::atomic<uint32_t> Mutex{};
       constexpr static uint32_t SIGNALED = 1;
@@ -136,6 +142,12 @@ namespace FEXCore {
         DoNotify(true);
       }
 
+      // Drops a pending signal without waking anything. Only safe when no
+      // thread can be waiting, e.g. when recycling the owning object.
+      void Reset() {
+        Mutex.store(UNSIGNALED);
+      }
+
     private:
       std::atomic<uint32_t> Mutex{};
       constexpr static uint32_t SIGNALED = 1;
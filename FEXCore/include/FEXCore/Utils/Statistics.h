@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/Utils/CompilerDefs.h>
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace FEXCore::Statistics {
+  // Runtime event counters for live instrumentation.
+  //
+  // Unlike Telemetry these aren't usage reports written once at exit; they are
+  // monotonic counters cheap enough to bump from already-heavyweight paths and
+  // meant to be sampled while the process runs. The enum order is the wire
+  // order of the FEXServer stats protocol, so entries may only be appended.
+  enum StatType : uint32_t {
+    STAT_BLOCKS_COMPILED,
+    STAT_CODE_CACHE_HITS,
+    STAT_SMC_INVALIDATIONS,
+    STAT_SIGBUS_BACKPATCHES,
+    STAT_THUNK_CROSSINGS,
+    STAT_SYSCALLS,
+    // LookupCache tiers. L1 hits resolve inline in the JIT and can't be
+    // counted, so the lookup counters start at the L2 tier.
+    STAT_LOOKUP_L2_HITS,
+    STAT_LOOKUP_L3_HITS,
+    STAT_LOOKUP_MISSES,
+    STAT_LOOKUP_L1_REHASHES,
+    // Failed store-exclusives in the JIT's LL/SC atomic fallback loops.
+    // Only moves on hosts without LSE; a climbing rate means guest atomics
+    // are contended enough that their retry paths are being exercised.
+    STAT_STREX_FAILURES,
+    STAT_LAST,
+  };
+
+  // Cacheline sized so counters bumped from different threads don't false
+  // share with their neighbours.
+  class alignas(64) Stat final {
+    public:
+      uint64_t operator*() const { return Data.load(std::memory_order_relaxed); }
+      void operator++(int) { Data.fetch_add(1, std::memory_order_relaxed); }
+
+      std::atomic<uint64_t> *GetAddr() { return &Data; }
+
+    private:
+      std::atomic<uint64_t> Data{};
+  };
+
+  FEX_DEFAULT_VISIBILITY Stat &GetStat(StatType Type);
+
+  // Copies a relaxed snapshot of the first Count counters in enum order.
+  FEX_DEFAULT_VISIBILITY void SnapshotStats(uint64_t *Values, size_t Count);
+
+// Statistics object declaration, mirroring the Telemetry macros.
+// The static version hides the lookup behind an initialization guard; don't
+// use it from signal handlers, call GetStat directly there instead.
+#define FEXCORE_STATS_STATIC_INIT(Name, Type) static FEXCore::Statistics::Stat &Name = FEXCore::Statistics::GetStat(FEXCore::Statistics::Type)
+#define FEXCORE_STATS_INC(Name) Name++
+}
@@ -30,6 +30,10 @@ namespace FEXCore::Telemetry {
     TYPE_USES_32BIT_SEGMENT_SS,
     TYPE_USES_32BIT_SEGMENT_CS,
     TYPE_USES_32BIT_SEGMENT_DS,
+    // Shadow validation results: sampled out-of-line revalidation of production compilations.
+    TYPE_SHADOW_VALIDATED_BLOCKS,
+    TYPE_IR_VALIDATION_ERROR,
+    TYPE_RA_VALIDATION_ERROR,
     TYPE_LAST,
   };
 
@@ -54,6 +58,12 @@ namespace FEXCore::Telemetry {
 
   FEX_DEFAULT_VISIBILITY Value &GetTelemetryValue(TelemetryType Type);
 
+  // Process-wide execution counters for the Interpreter/Fallbacks handlers,
+  // one slot per Core::FallbackHandlerIndex. The JIT bumps these inline from
+  // lowered fallback call sites and the ranked census is appended to the
+  // telemetry dump at shutdown. Null when telemetry is disabled.
+  FEX_DEFAULT_VISIBILITY uint64_t *GetFallbackCensusCounters();
+
   FEX_DEFAULT_VISIBILITY void Initialize();
   FEX_DEFAULT_VISIBILITY void Shutdown(fextl::string const &ApplicationName);
 
@@ -75,6 +85,7 @@ namespace FEXCore::Telemetry {
 #else
   static inline void Initialize() {}
   static inline void Shutdown(fextl::string const &ApplicationName) {}
+  static inline uint64_t *GetFallbackCensusCounters() { return nullptr; }
 
 #define FEXCORE_TELEMETRY_STATIC_INIT(Name, Type)
 #define FEXCORE_TELEMETRY_INIT(Name, Type)
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <FEXCore/fextl/memory_resource.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace fextl {
+  namespace detail {
+    // Separate base so the arena is fully constructed before the vector that
+    // allocates out of it, and destructed after it.
+    template<class T, size_t N>
+    struct inline_vector_storage {
+      alignas(T) std::byte Buffer[sizeof(T) * N];
+      std::pmr::monotonic_buffer_resource Arena;
+      inline_vector_storage()
+        : Arena {Buffer, sizeof(Buffer), fextl::pmr::get_default_resource()} {}
+    };
+  }
+
+  /**
+   * @brief A vector with inline storage for N elements.
+   *
+   * The first N elements live inside the object itself, so containers that
+   * stay small never touch the allocator. Growth past N spills to the FEX
+   * allocator through the arena's upstream.
+   *
+   * The arena is monotonic: memory is only reclaimed when the vector is
+   * destroyed, not on clear() or shrink. This is intended for members that
+   * are cleared and refilled each use, where capacity stabilizes quickly -
+   * not for containers with unbounded or highly variable peaks.
+   *
+   * Not movable. A moved-to vector would keep pointing into the source's
+   * inline buffer.
+   */
+  template<class T, size_t N>
+  class inline_vector : private detail::inline_vector_storage<T, N>, public std::pmr::vector<T> {
+    using Base = std::pmr::vector<T>;
+  public:
+    inline_vector() : Base {&this->Arena} {
+      Base::reserve(N);
+    }
+    inline_vector(const inline_vector &other) : inline_vector {} {
+      Base::assign(other.begin(), other.end());
+    }
+    inline_vector &operator=(const inline_vector &other) {
+      Base::assign(other.begin(), other.end());
+      return *this;
+    }
+    inline_vector(inline_vector &&) = delete;
+    inline_vector &operator=(inline_vector &&) = delete;
+  };
+}
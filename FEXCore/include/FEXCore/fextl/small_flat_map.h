@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <FEXCore/fextl/inline_vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+namespace fextl {
+  /**
+   * @brief A map over a sorted vector with inline storage for N entries.
+   *
+   * Lookups are a binary search over contiguous pairs, insertion shifts the
+   * tail. For the small, short-lived maps the IR passes keep per block this
+   * beats a node or hash map on both allocation count and cache behaviour.
+   *
+   * Inherits inline_vector's lifetime caveats: memory is only reclaimed on
+   * destruction and the map is copyable but not movable. References into the
+   * map are invalidated by insertion, like any vector.
+   */
+  template<class Key, class T, size_t N, class Compare = std::less<Key>>
+  class small_flat_map {
+  public:
+    using value_type = std::pair<Key, T>;
+    using storage_type = fextl::inline_vector<value_type, N>;
+    using iterator = typename storage_type::iterator;
+    using const_iterator = typename storage_type::const_iterator;
+
+    iterator begin() { return Data.begin(); }
+    iterator end() { return Data.end(); }
+    const_iterator begin() const { return Data.begin(); }
+    const_iterator end() const { return Data.end(); }
+
+    size_t size() const { return Data.size(); }
+    bool empty() const { return Data.empty(); }
+    void clear() { Data.clear(); }
+
+    iterator find(const Key &K) {
+      auto It = lower_bound(K);
+      if (It != Data.end() && !Compare{}(K, It->first)) {
+        return It;
+      }
+      return Data.end();
+    }
+    const_iterator find(const Key &K) const {
+      auto It = const_cast<small_flat_map*>(this)->lower_bound(K);
+      if (It != Data.end() && !Compare{}(K, It->first)) {
+        return It;
+      }
+      return Data.end();
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const Key &K, Args&&... args) {
+      auto It = lower_bound(K);
+      if (It != Data.end() && !Compare{}(K, It->first)) {
+        return {It, false};
+      }
+      return {Data.emplace(It, std::piecewise_construct,
+                           std::forward_as_tuple(K),
+                           std::forward_as_tuple(std::forward<Args>(args)...)), true};
+    }
+
+    T &operator[](const Key &K) {
+      return try_emplace(K).first->second;
+    }
+
+  private:
+    iterator lower_bound(const Key &K) {
+      return std::lower_bound(Data.begin(), Data.end(), K,
+        [](const value_type &V, const Key &K) { return Compare{}(V.first, K); });
+    }
+
+    storage_type Data;
+  };
+}
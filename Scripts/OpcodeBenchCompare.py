@@ -0,0 +1,50 @@
+#!/usr/bin/python3
+# Merges the two OpcodeBench result files - one from the x86-64 build run
+# under FEX, one from the native AArch64 build - into a per-opcode slowdown
+# matrix. Ratios above 1.0 mean the emitted code is slower than the native
+# equivalent sequence.
+#
+# Usage:
+#   OpcodeBenchCompare.py <fex_results.json> <native_results.json> [<matrix.json>]
+#
+# Prints a sorted table to stdout and optionally writes the matrix as JSON.
+
+import json
+import sys
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(f"Usage: {sys.argv[0]} <fex_results.json> <native_results.json> [<matrix.json>]")
+
+    with open(sys.argv[1], "r") as File:
+        FEXResults = json.load(File)
+    with open(sys.argv[2], "r") as File:
+        NativeResults = json.load(File)
+
+    Matrix = {}
+    for Name, FEX in sorted(FEXResults.items()):
+        Native = NativeResults.get(Name)
+        if Native is None:
+            print(f"warning: {Name} missing from native results, skipped", file=sys.stderr)
+            continue
+        Matrix[Name] = {
+            "fex": FEX,
+            "native": Native,
+            "latency_slowdown": FEX["latency"] / Native["latency"] if Native["latency"] else 0.0,
+            "throughput_slowdown": FEX["throughput"] / Native["throughput"] if Native["throughput"] else 0.0,
+        }
+
+    print(f"{'Opcode':<10} {'Lat ns':>8} {'Native':>8} {'Ratio':>7}   {'Tp ns':>8} {'Native':>8} {'Ratio':>7}")
+    for Name, Row in sorted(Matrix.items(), key=lambda kv: -kv[1]["latency_slowdown"]):
+        print(f"{Name:<10} {Row['fex']['latency']:>8.3f} {Row['native']['latency']:>8.3f} "
+              f"{Row['latency_slowdown']:>7.2f}   {Row['fex']['throughput']:>8.3f} "
+              f"{Row['native']['throughput']:>8.3f} {Row['throughput_slowdown']:>7.2f}")
+
+    if len(sys.argv) > 3:
+        with open(sys.argv[3], "w") as File:
+            json.dump(Matrix, File, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,234 @@
+#!/usr/bin/python3
+# Generates a per-opcode latency/throughput microbenchmark from the X86Tables
+# instruction definitions.
+#
+# The emitted C++ source carries both an x86-64 and an AArch64 body for every
+# benchmarked opcode, selected by the compiler's target architecture. Building
+# it once with the x86-64 guest toolchain (run under FEX) and once natively
+# gives two JSON result files that Scripts/OpcodeBenchCompare.py merges into a
+# per-opcode slowdown matrix.
+#
+# Usage:
+#   OpcodeBenchGenerator.py <output.cpp> <table.cpp> [<table.cpp>...]
+#
+# Only opcodes that are both present as TYPE_INST entries in the parsed tables
+# and covered by the template table below are emitted; the rest are counted so
+# coverage gaps stay visible in the generator output.
+
+import re
+import sys
+
+# Benchmark templates per opcode name as spelled in X86Tables.
+#
+# Each template gives one instruction instance per architecture with {d} and
+# {s} register placeholders. The generator unrolls them two ways:
+#  - latency:    every copy uses the same register as source and destination,
+#                forming a serial dependency chain.
+#  - throughput: copies rotate over four independent destination registers.
+#
+# Opcodes with fixed register operands or untypical shapes provide explicit
+# "x86_raw"/"a64_raw" bodies instead, used for both measurements.
+X86_REGS = ["rax", "rcx", "rdx", "rsi"]
+A64_REGS = ["x0", "x1", "x2", "x3"]
+
+TEMPLATES = {
+    # Basic ALU
+    "ADD":    {"x86": "add %%{s}, %%{d}",        "a64": "add {d}, {d}, {s}"},
+    "SUB":    {"x86": "sub %%{s}, %%{d}",        "a64": "sub {d}, {d}, {s}"},
+    "ADC":    {"x86": "adc %%{s}, %%{d}",        "a64": "adcs {d}, {d}, {s}"},
+    "SBB":    {"x86": "sbb %%{s}, %%{d}",        "a64": "sbcs {d}, {d}, {s}"},
+    "AND":    {"x86": "and %%{s}, %%{d}",        "a64": "and {d}, {d}, {s}"},
+    "OR":     {"x86": "or %%{s}, %%{d}",         "a64": "orr {d}, {d}, {s}"},
+    "XOR":    {"x86": "xor %%{s}, %%{d}",        "a64": "eor {d}, {d}, {s}"},
+    "CMP":    {"x86": "cmp %%{s}, %%{d}",        "a64": "cmp {d}, {s}"},
+    "TEST":   {"x86": "test %%{s}, %%{d}",       "a64": "tst {d}, {s}"},
+    "NEG":    {"x86": "neg %%{d}",               "a64": "neg {d}, {d}"},
+    "NOT":    {"x86": "not %%{d}",               "a64": "mvn {d}, {d}"},
+    "INC":    {"x86": "inc %%{d}",               "a64": "add {d}, {d}, #1"},
+    "DEC":    {"x86": "dec %%{d}",               "a64": "sub {d}, {d}, #1"},
+    "LEA":    {"x86": "lea 8(%%{d},%%{s},4), %%{d}", "a64": "add {d}, {d}, {s}, lsl #2"},
+    "MOV":    {"x86": "mov %%{s}, %%{d}",        "a64": "mov {d}, {s}"},
+    "XCHG":   {"x86": "xchg %%{s}, %%{d}",       "a64": "eor {d}, {d}, {s}\neor {s}, {d}, {s}\neor {d}, {d}, {s}"},
+    "MOVZX":  {"x86": "movzbq %%al, %%{d}",      "a64": "uxtb {d}, {d}"},
+    "MOVSX":  {"x86": "movsbq %%al, %%{d}",      "a64": "sxtb {d}, {d}"},
+    "BSWAP":  {"x86": "bswap %%{d}",             "a64": "rev {d}, {d}"},
+
+    # Shifts and rotates (constant amount, the common lowered shape)
+    "SHL":    {"x86": "shl $3, %%{d}",           "a64": "lsl {d}, {d}, #3"},
+    "SHR":    {"x86": "shr $3, %%{d}",           "a64": "lsr {d}, {d}, #3"},
+    "SAR":    {"x86": "sar $3, %%{d}",           "a64": "asr {d}, {d}, #3"},
+    "ROL":    {"x86": "rol $3, %%{d}",           "a64": "ror {d}, {d}, #61"},
+    "ROR":    {"x86": "ror $3, %%{d}",           "a64": "ror {d}, {d}, #3"},
+
+    # Bit manipulation
+    "BSF":    {"x86": "bsf %%{d}, %%{d}",        "a64": "rbit {d}, {d}\nclz {d}, {d}"},
+    "BSR":    {"x86": "bsr %%{d}, %%{d}",        "a64": "clz {d}, {d}"},
+    "BT":     {"x86": "bt %%{s}, %%{d}",         "a64": "lsr {d}, {d}, {s}"},
+    "POPCNT": {"x86": "popcnt %%{d}, %%{d}",     "a64": "fmov d0, {d}\ncnt v0.8b, v0.8b\naddv b0, v0.8b\nfmov {d}, d0"},
+    "LZCNT":  {"x86": "lzcnt %%{d}, %%{d}",      "a64": "clz {d}, {d}"},
+    "TZCNT":  {"x86": "tzcnt %%{d}, %%{d}",      "a64": "rbit {d}, {d}\nclz {d}, {d}"},
+
+    # Conditional moves
+    "CMOVZ":  {"x86": "cmovz %%{s}, %%{d}",      "a64": "csel {d}, {s}, {d}, eq"},
+    "CMOVNZ": {"x86": "cmovnz %%{s}, %%{d}",     "a64": "csel {d}, {s}, {d}, ne"},
+    "CMOVC":  {"x86": "cmovc %%{s}, %%{d}",      "a64": "csel {d}, {s}, {d}, cs"},
+    "CMOVS":  {"x86": "cmovs %%{s}, %%{d}",      "a64": "csel {d}, {s}, {d}, mi"},
+
+    # Fixed-register shapes: raw bodies used for both latency and throughput.
+    "IMUL": {
+        "x86_raw": "imul %%rcx, %%rax",
+        "a64_raw": "mul x0, x0, x1",
+    },
+    "MUL": {
+        "x86_raw": "mul %%rcx",  # RDX:RAX = RAX * RCX
+        "a64_raw": "umulh x2, x0, x1\nmul x0, x0, x1",
+    },
+    "DIV": {
+        "x86_raw": "xor %%edx, %%edx\ndiv %%rcx",
+        "a64_raw": "udiv x0, x0, x1",
+    },
+    "IDIV": {
+        "x86_raw": "cqo\nidiv %%rcx",
+        "a64_raw": "sdiv x0, x0, x1",
+    },
+    "CMPXCHG": {
+        "x86_raw": "cmpxchg %%rcx, (%%rdi)",
+        "a64_raw": "ldaxr x2, [x4]\ncmp x2, x0\nb.ne 1f\nstlxr w3, x1, [x4]\n1:",
+    },
+    "XADD": {
+        "x86_raw": "lock xadd %%rax, (%%rdi)",
+        "a64_raw": "ldaddal x0, x0, [x4]",
+    },
+}
+
+# How many copies of the instruction body are placed in the loop. Amortizes
+# the loop branch so timing reflects the instruction under test.
+UNROLL = 32
+# Loop iterations per measurement; total instances = ITERATIONS * UNROLL.
+ITERATIONS = 1000000
+
+
+def ParseTables(Paths):
+    """Returns the set of TYPE_INST opcode names found in the table sources."""
+    Names = set()
+    Pattern = re.compile(r'X86InstInfo\{"([^"]+)",\s*TYPE_INST')
+    for Path in Paths:
+        with open(Path, "r") as File:
+            Names.update(Pattern.findall(File.read()))
+    return Names
+
+
+# Register initialization prepended to every measured block. Keeps divide
+# operands sane (nonzero divisor) and makes runs reproducible. Four setup
+# instructions against UNROLL copies of the body is measurement noise.
+INIT = {
+    "x86": ["mov $0x4567, %%rax", "mov $0x89, %%rcx", "mov $0x2b, %%rdx", "mov $0x11, %%rsi"],
+    "a64": ["mov x0, #0x4567", "mov x1, #0x89", "mov x2, #0x2b", "mov x3, #0x11"],
+}
+
+
+def ExpandBody(Template, Arch, Latency):
+    Raw = Template.get(f"{Arch}_raw")
+    if Raw is not None:
+        Lines = [Raw] * UNROLL
+    else:
+        Inst = Template[Arch]
+        Regs = X86_REGS if Arch == "x86" else A64_REGS
+        Lines = []
+        for i in range(UNROLL):
+            # Latency chains everything through one register, throughput
+            # rotates over independent ones.
+            Dest = Regs[0] if Latency else Regs[i % len(Regs)]
+            Src = Regs[1] if Latency and len(Regs) > 1 else Regs[(i + 1) % len(Regs)]
+            if Dest == Src:
+                Src = Regs[(i + 2) % len(Regs)]
+            Lines.append(Inst.format(d=Dest, s=Src))
+    Lines = INIT[Arch] + Lines
+    Asm = "\n".join(f'    "{Line} \\n"' for Body in Lines for Line in Body.split("\n"))
+    return Asm
+
+
+def EmitBench(Out, Name, Template):
+    Symbol = re.sub(r"[^A-Za-z0-9]", "_", Name)
+    for Latency in (True, False):
+        Kind = "Lat" if Latency else "Tp"
+        Out.append(f"static void Bench_{Kind}_{Symbol}() {{")
+        Out.append(f"  for (uint64_t i = 0; i < {ITERATIONS}; ++i) {{")
+        Out.append("#if defined(__x86_64__)")
+        Out.append("    asm volatile(")
+        Out.append(ExpandBody(Template, "x86", Latency))
+        Out.append('    : : "D"(MemScratch) : "rax", "rcx", "rdx", "rsi", "cc", "memory");')
+        Out.append("#elif defined(__aarch64__)")
+        Out.append('    register uint64_t *Scratch asm("x4") = MemScratch;')
+        Out.append("    asm volatile(")
+        Out.append(ExpandBody(Template, "a64", Latency))
+        Out.append('    : : "r"(Scratch) : "x0", "x1", "x2", "x3", "v0", "cc", "memory");')
+        Out.append("#else")
+        Out.append("#error Unsupported benchmark architecture")
+        Out.append("#endif")
+        Out.append("  }")
+        Out.append("}")
+        Out.append("")
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(f"usage: {sys.argv[0]} <output.cpp> <table.cpp> [<table.cpp>...]")
+
+    OutputPath = sys.argv[1]
+    TableNames = ParseTables(sys.argv[2:])
+
+    Benchmarked = sorted(Name for Name in TableNames if Name in TEMPLATES)
+    Skipped = len(TableNames) - len(Benchmarked)
+
+    Out = []
+    Out.append("// SPDX-License-Identifier: MIT")
+    Out.append("// Generated by Scripts/OpcodeBenchGenerator.py - do not edit.")
+    Out.append(f"// {len(Benchmarked)} opcodes benchmarked, {Skipped} table entries without a template.")
+    Out.append("#include <chrono>")
+    Out.append("#include <cstdint>")
+    Out.append("#include <cstdio>")
+    Out.append("")
+    Out.append("// Scratch word for the memory-operand benchmarks.")
+    Out.append("// x86 bodies address it through rdi, AArch64 bodies through x4.")
+    Out.append("static uint64_t MemScratch[8];")
+    Out.append("")
+
+    for Name in Benchmarked:
+        EmitBench(Out, Name, TEMPLATES[Name])
+
+    Out.append("static double TimeNSPerInst(void (*Fn)()) {")
+    Out.append("  Fn(); // Warm the code cache, FEX compiles on first execution")
+    Out.append("  const auto Begin = std::chrono::steady_clock::now();")
+    Out.append("  Fn();")
+    Out.append("  const auto End = std::chrono::steady_clock::now();")
+    Out.append("  const double NS = std::chrono::duration_cast<std::chrono::nanoseconds>(End - Begin).count();")
+    Out.append(f"  return NS / (double({ITERATIONS}) * {UNROLL});")
+    Out.append("}")
+    Out.append("")
+    Out.append("int main(int argc, char **argv) {")
+    Out.append('  FILE *Output = argc > 1 ? fopen(argv[1], "w") : stdout;')
+    Out.append("  if (!Output) { return 1; }")
+    Out.append('  asm volatile("" : : "r"(MemScratch) : "memory");')
+    Out.append('  fprintf(Output, "{\\n");')
+    Separator = ""
+    for Name in Benchmarked:
+        Symbol = re.sub(r"[^A-Za-z0-9]", "_", Name)
+        if Separator:
+            Out.append(f'  fprintf(Output, ",\\n");')
+        Out.append(f'  fprintf(Output, "  \\"{Name}\\": {{\\"latency\\": %.3f, \\"throughput\\": %.3f}}",')
+        Out.append(f"          TimeNSPerInst(Bench_Lat_{Symbol}), TimeNSPerInst(Bench_Tp_{Symbol}));")
+        Separator = ","
+    Out.append('  fprintf(Output, "\\n}\\n");')
+    Out.append("  if (Output != stdout) { fclose(Output); }")
+    Out.append("  return 0;")
+    Out.append("}")
+
+    with open(OutputPath, "w") as File:
+        File.write("\n".join(Out) + "\n")
+
+    print(f"OpcodeBench: generated {len(Benchmarked)} opcode benchmarks, {Skipped} table entries uncovered")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstdint>
+
+namespace FEX::CrashDump {
+// Binary crash record format.
+//
+// When an emulated process dies on an unhandled fatal signal, the frontend
+// captures the guest view of the crash and streams it through an FD handed
+// out by FEXServer, landing in the server's `<DataDir>/crashes/` directory.
+// Field triage then has the guest register state, a guest backtrace and the
+// telemetry counters without needing to reproduce the crash locally.
+//
+// File layout, all fields little-endian:
+//   Header
+//   uint64_t GuestFrames[Header.NumGuestFrames]     - guest return addresses
+//   uint64_t HostFrames[Header.NumHostFrames]       - host return addresses
+//   uint64_t Telemetry[Header.NumTelemetryValues]   - FEXCore::Telemetry enum order
+//   { uint64_t GuestRIP; uint64_t Cycles; } FlightRecorder[Header.NumFlightRecorderEntries]
+//     - the crashed thread's flight recorder ring, oldest sample first.
+//       Cycles is the raw host cycle counter; diff neighbours for deltas.
+
+///< "FEXC"
+constexpr uint32_t COOKIE = 0x43584546;
+constexpr uint32_t VERSION = 0x0000'0002;
+
+// Frame pointer walks through crashed state can't be trusted very far.
+constexpr uint32_t MAX_BACKTRACE_DEPTH = 32;
+
+struct Header {
+  uint32_t Cookie;
+  uint32_t Version;
+  int32_t PID;
+  int32_t TID;
+  int32_t Signal;
+  int32_t SignalCode;
+  uint64_t FaultAddress;
+  ///< CLOCK_REALTIME nanoseconds at capture time.
+  uint64_t Timestamp;
+  ///< Reconstructed from the faulting host PC through the JIT's RIP mapping.
+  uint64_t GuestRIP;
+  ///< Guest general purpose registers in FEXCore::X86State::REG_* order.
+  uint64_t GuestGPRs[16];
+  uint32_t NumGuestFrames;
+  uint32_t NumHostFrames;
+  uint32_t NumTelemetryValues;
+  uint32_t NumFlightRecorderEntries;
+};
+
+static_assert(sizeof(Header) == 192, "Crash dump header changed size, bump VERSION");
+}
@@ -25,6 +25,62 @@
 #include <thread>
 
 namespace FEXServerClient {
+  static int RecvFDResultPacket(int ServerSocket) {
+    // Wait for success response with SCM_RIGHTS
+
+    FEXServerResultPacket Res{};
+    struct iovec iov {
+      .iov_base = &Res,
+      .iov_len = sizeof(Res),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    // Setup the ancillary buffer. This is where we will be getting pipe FDs
+    // We only need 4 bytes for the FD
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
+    union AncillaryBuffer {
+      struct cmsghdr Header;
+      uint8_t Buffer[CMSG_SIZE];
+    };
+    AncillaryBuffer AncBuf{};
+
+    // Now link to our ancilllary buffer
+    msg.msg_control = AncBuf.Buffer;
+    msg.msg_controllen = CMSG_SIZE;
+
+    ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
+    if (DataResult > 0) {
+      // Now that we have the data, we can extract the FD from the ancillary buffer
+      struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+
+      // Do some error checking
+      if (cmsg == nullptr ||
+          cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
+          cmsg->cmsg_level != SOL_SOCKET ||
+          cmsg->cmsg_type != SCM_RIGHTS) {
+        // Couldn't get a socket
+      }
+      else {
+        // Check for Success.
+        // If type error was returned then the FEXServer doesn't have a log to pipe in to
+        if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
+          // Now that we know the cmsg is sane, read the FD
+          int NewFD{};
+          memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
+          return NewFD;
+        }
+      }
+    }
+
+    return -1;
+  }
+
   int RequestPIDFDPacket(int ServerSocket, PacketType Type) {
     FEXServerRequestPacket Req {
       .Header {
@@ -34,57 +90,7 @@ namespace FEXServerClient {
 
     int Result = write(ServerSocket, &Req, sizeof(Req.BasicRequest));
     if (Result != -1) {
-      // Wait for success response with SCM_RIGHTS
-
-      FEXServerResultPacket Res{};
-      struct iovec iov {
-        .iov_base = &Res,
-        .iov_len = sizeof(Res),
-      };
-
-      struct msghdr msg {
-        .msg_name = nullptr,
-        .msg_namelen = 0,
-        .msg_iov = &iov,
-        .msg_iovlen = 1,
-      };
-
-      // Setup the ancillary buffer. This is where we will be getting pipe FDs
-      // We only need 4 bytes for the FD
-      constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int));
-      union AncillaryBuffer {
-        struct cmsghdr Header;
-        uint8_t Buffer[CMSG_SIZE];
-      };
-      AncillaryBuffer AncBuf{};
-
-      // Now link to our ancilllary buffer
-      msg.msg_control = AncBuf.Buffer;
-      msg.msg_controllen = CMSG_SIZE;
-
-      ssize_t DataResult = recvmsg(ServerSocket, &msg, 0);
-      if (DataResult > 0) {
-        // Now that we have the data, we can extract the FD from the ancillary buffer
-        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
-
-        // Do some error checking
-        if (cmsg == nullptr ||
-            cmsg->cmsg_len != CMSG_LEN(sizeof(int)) ||
-            cmsg->cmsg_level != SOL_SOCKET ||
-            cmsg->cmsg_type != SCM_RIGHTS) {
-          // Couldn't get a socket
-        }
-        else {
-          // Check for Success.
-          // If type error was returned then the FEXServer doesn't have a log to pipe in to
-          if (Res.Header.Type == PacketType::TYPE_SUCCESS) {
-            // Now that we know the cmsg is sane, read the FD
-            int NewFD{};
-            memcpy(&NewFD, CMSG_DATA(cmsg), sizeof(NewFD));
-            return NewFD;
-          }
-        }
-      }
+      return RecvFDResultPacket(ServerSocket);
     }
 
     return -1;
@@ -152,6 +158,16 @@ namespace FEXServerClient {
     return ServerSocketPath;
   }
 
+  fextl::string GetServerStatsSocketName() {
+    // Lives next to the request socket so one FEXServer instance owns both.
+    return GetServerSocketName() + ".Stats";
+  }
+
+  fextl::string GetServerProfileStreamSocketName() {
+    // Lives next to the request socket so one FEXServer instance owns both.
+    return GetServerSocketName() + ".Profile";
+  }
+
   int GetServerFD() {
     return ServerFD;
   }
@@ -340,6 +356,315 @@ namespace FEXServerClient {
     return RequestPIDFDPacket(ServerSocket, PacketType::TYPE_GET_PID_FD);
   }
 
+  int RequestAOTIRCacheFD(int ServerSocket, const fextl::string &FileID) {
+    FEXServerRequestPacket Req {
+      .AOTIRCacheFD {
+        .Header {
+          .Type = PacketType::TYPE_GET_AOTIRCACHE_FD,
+        },
+        // Include final null character.
+        .Length = FileID.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.AOTIRCacheFD),
+      },
+      {
+        .iov_base = const_cast<char*>(FileID.data()),
+        .iov_len = FileID.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 3);
+    if (Result != -1) {
+      return RecvFDResultPacket(ServerSocket);
+    }
+
+    return -1;
+  }
+
+  int RequestAOTIRCacheWriteFD(int ServerSocket, const fextl::string &FileID) {
+    FEXServerRequestPacket Req {
+      .AOTIRCacheFD {
+        .Header {
+          .Type = PacketType::TYPE_GET_AOTIRCACHE_WRITE_FD,
+        },
+        // Include final null character.
+        .Length = FileID.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.AOTIRCacheFD),
+      },
+      {
+        .iov_base = const_cast<char*>(FileID.data()),
+        .iov_len = FileID.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 3);
+    if (Result != -1) {
+      return RecvFDResultPacket(ServerSocket);
+    }
+
+    return -1;
+  }
+
+  uint32_t RequestLibraryPriority(int ServerSocket, const fextl::string &BaseFilename) {
+    FEXServerRequestPacket Req {
+      .LibraryPriority {
+        .Header {
+          .Type = PacketType::TYPE_GET_LIBRARY_PRIORITY,
+        },
+        // Include final null character.
+        .Length = BaseFilename.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.LibraryPriority),
+      },
+      {
+        .iov_base = const_cast<char*>(BaseFilename.data()),
+        .iov_len = BaseFilename.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 3);
+    if (Result != -1) {
+      FEXServerResultPacket Res{};
+      ssize_t DataResult = recv(ServerSocket, &Res, sizeof(Res), 0);
+      if (DataResult >= static_cast<ssize_t>(sizeof(Res.LibraryTier)) &&
+          Res.Header.Type == PacketType::TYPE_SUCCESS) {
+        return Res.LibraryTier.Tier;
+      }
+    }
+
+    return 0;
+  }
+
+  bool RequestAOTIRCacheCommit(int ServerSocket, const fextl::string &FileID) {
+    FEXServerRequestPacket Req {
+      .AOTIRCacheFD {
+        .Header {
+          .Type = PacketType::TYPE_AOTIRCACHE_COMMIT,
+        },
+        // Include final null character.
+        .Length = FileID.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.AOTIRCacheFD),
+      },
+      {
+        .iov_base = const_cast<char*>(FileID.data()),
+        .iov_len = FileID.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 3);
+    if (Result != -1) {
+      FEXServerResultPacket Res{};
+      ssize_t DataResult = recv(ServerSocket, &Res, sizeof(Res), 0);
+      if (DataResult >= static_cast<ssize_t>(sizeof(Res.Header))) {
+        return Res.Header.Type == PacketType::TYPE_SUCCESS;
+      }
+    }
+
+    return false;
+  }
+
+  int RequestCrashDumpFD(int ServerSocket, const fextl::string &AppName) {
+    FEXServerRequestPacket Req {
+      .CrashDumpFD {
+        .Header {
+          .Type = PacketType::TYPE_GET_CRASHDUMP_FD,
+        },
+        // Include final null character.
+        .Length = AppName.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.CrashDumpFD),
+      },
+      {
+        .iov_base = const_cast<char*>(AppName.data()),
+        .iov_len = AppName.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 3);
+    if (Result != -1) {
+      return RecvFDResultPacket(ServerSocket);
+    }
+
+    return -1;
+  }
+
+  int RequestFlightRecordFD(int ServerSocket, const fextl::string &AppName) {
+    FEXServerRequestPacket Req {
+      .FlightRecordFD {
+        .Header {
+          .Type = PacketType::TYPE_GET_FLIGHTRECORD_FD,
+        },
+        // Include final null character.
+        .Length = AppName.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.FlightRecordFD),
+      },
+      {
+        .iov_base = const_cast<char*>(AppName.data()),
+        .iov_len = AppName.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    ssize_t Result = writev(ServerSocket, iov, 3);
+    if (Result != -1) {
+      return RecvFDResultPacket(ServerSocket);
+    }
+
+    return -1;
+  }
+
+  void SendCompileSubmit(int ServerSocket, const fextl::string &Path) {
+    FEXServerRequestPacket Req {
+      .CompileSubmit {
+        .Header {
+          .Type = PacketType::TYPE_COMPILE_SUBMIT,
+        },
+        // Include final null character.
+        .Length = Path.size() + 1,
+      },
+    };
+
+    char Null{};
+
+    iovec iov[3] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.CompileSubmit),
+      },
+      {
+        .iov_base = const_cast<char*>(Path.data()),
+        .iov_len = Path.size(),
+      },
+      {
+        .iov_base = &Null,
+        .iov_len = 1,
+      },
+    };
+
+    // Fire and forget, the server doesn't respond to submissions.
+    writev(ServerSocket, iov, 3);
+  }
+
+  void SendStatsUpdate(int ServerSocket, const uint64_t *Stats, uint32_t NumStats) {
+    FEXServerRequestPacket Req {
+      .StatsUpdate {
+        .Header {
+          .Type = PacketType::TYPE_STATS_UPDATE,
+        },
+        .PID = ::getpid(),
+        .NumStats = NumStats,
+      },
+    };
+
+    iovec iov[2] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.StatsUpdate),
+      },
+      {
+        .iov_base = const_cast<uint64_t*>(Stats),
+        .iov_len = NumStats * sizeof(uint64_t),
+      },
+    };
+
+    // Fire and forget, the server doesn't respond to stats pushes.
+    writev(ServerSocket, iov, 2);
+  }
+
+  void SendProfileUpdate(int ServerSocket, const ProfileSampleEntry *Entries, uint32_t NumEntries) {
+    FEXServerRequestPacket Req {
+      .ProfileUpdate {
+        .Header {
+          .Type = PacketType::TYPE_PROFILE_UPDATE,
+        },
+        .PID = ::getpid(),
+        .NumEntries = NumEntries,
+      },
+    };
+
+    iovec iov[2] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req.ProfileUpdate),
+      },
+      {
+        .iov_base = const_cast<ProfileSampleEntry*>(Entries),
+        .iov_len = NumEntries * sizeof(ProfileSampleEntry),
+      },
+    };
+
+    // Fire and forget, same as the stats pushes.
+    writev(ServerSocket, iov, 2);
+  }
+
   /**  @} */
 
   /**
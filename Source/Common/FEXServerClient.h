@@ -12,12 +12,74 @@ namespace FEXServerClient {
     TYPE_GET_LOG_FD,
     TYPE_GET_ROOTFS_PATH,
     TYPE_GET_PID_FD,
+    TYPE_GET_AOTIRCACHE_FD,
+    TYPE_GET_AOTIRCACHE_WRITE_FD,
+    TYPE_AOTIRCACHE_COMMIT,
+    TYPE_GET_CRASHDUMP_FD,
+    TYPE_GET_FLIGHTRECORD_FD,
+    TYPE_GET_LIBRARY_PRIORITY,
+
+    // Request only, no result
+    TYPE_STATS_UPDATE,
+    TYPE_PROFILE_UPDATE,
+    TYPE_COMPILE_SUBMIT,
 
     // Result only
     TYPE_SUCCESS,
     TYPE_ERROR,
   };
 
+  // One aggregated sample location from a process's flat profile.
+  // Location carries a pre-symbolized guest `module+0xoffset` string so the
+  // server doesn't need access to the client's address space or binaries.
+  struct ProfileSampleEntry {
+    uint64_t Count;
+    char Location[56];
+  };
+
+  // Binary always-on profiling stream served by FEXServer. Distinct from both
+  // the text metrics scrape socket and GdbServer's per-process text protocol;
+  // built for continuous fleet monitoring where those are too heavy.
+  //
+  // A subscriber connects to the stream socket, writes one SubscribeRequest
+  // and then only reads: the server pushes length-prefixed frames at the
+  // requested cadence until either side hangs up. Frame payloads are the
+  // server's aggregation records verbatim - counters in FEXCore::Statistics
+  // enum order and ProfileSampleEntry records - so neither side pays a
+  // formatting or parsing cost.
+  namespace ProfileStream {
+    constexpr uint32_t COOKIE = 0x53505846; // 'FXPS'
+    constexpr uint32_t VERSION = 1;
+
+    struct SubscribeRequest {
+      uint32_t Cookie;
+      uint32_t Version;
+      // The server pushes at most one frame per interval. Zero selects the
+      // server's default cadence.
+      uint32_t IntervalMS;
+    };
+
+    // Every frame starts with this header. FrameSize includes the header, so
+    // a reader can consume frames from the stream without knowing the layout
+    // of the process records inside.
+    struct FrameHeader {
+      uint32_t FrameSize;
+      uint32_t NumProcesses;
+      // CLOCK_MONOTONIC at serialization time, for rate computation.
+      uint64_t TimestampNS;
+    };
+
+    // Repeated NumProcesses times after the frame header: this, then NumStats
+    // uint64_t counters in FEXCore::Statistics enum order, then NumSamples
+    // ProfileSampleEntry records.
+    struct ProcessHeader {
+      int32_t PID;
+      uint32_t NumStats;
+      uint32_t NumSamples;
+      uint32_t Reserved;
+    };
+  }
+
   union FEXServerRequestPacket {
     struct Header {
       PacketType Type;
@@ -26,6 +88,54 @@ namespace FEXServerClient {
     struct {
       struct Header Header;
     } BasicRequest;
+
+    struct {
+      struct Header Header;
+      size_t Length;
+      char FileID[0];
+    } AOTIRCacheFD;
+
+    struct {
+      struct Header Header;
+      int32_t PID;
+      // Number of counters following the header, in FEXCore::Statistics enum
+      // order. Sent explicitly so a server can consume pushes from processes
+      // built with fewer or more counters than itself.
+      uint32_t NumStats;
+      uint64_t Stats[0];
+    } StatsUpdate;
+
+    struct {
+      struct Header Header;
+      size_t Length;
+      char AppName[0];
+    } CrashDumpFD;
+
+    struct {
+      struct Header Header;
+      size_t Length;
+      char AppName[0];
+    } FlightRecordFD;
+
+    struct {
+      struct Header Header;
+      int32_t PID;
+      // Number of sample entries following the header, hottest first.
+      uint32_t NumEntries;
+      ProfileSampleEntry Entries[0];
+    } ProfileUpdate;
+
+    struct {
+      struct Header Header;
+      size_t Length;
+      char Path[0];
+    } CompileSubmit;
+
+    struct {
+      struct Header Header;
+      size_t Length;
+      char Name[0];
+    } LibraryPriority;
   };
 
   union FEXServerResultPacket {
@@ -43,6 +153,11 @@ namespace FEXServerClient {
       size_t Length;
       char Mount[0];
     } MountPath;
+
+    struct {
+      struct Header Header;
+      uint32_t Tier;
+    } LibraryTier;
   };
 
   constexpr size_t MAXIMUM_REQUEST_PACKET_SIZE = sizeof(FEXServerRequestPacket);
@@ -53,6 +168,8 @@ namespace FEXServerClient {
   fextl::string GetTempFolder();
   fextl::string GetServerMountFolder();
   fextl::string GetServerSocketName();
+  fextl::string GetServerStatsSocketName();
+  fextl::string GetServerProfileStreamSocketName();
   int GetServerFD();
 
   bool SetupClient(char *InterpreterPath);
@@ -105,6 +222,108 @@ namespace FEXServerClient {
    */
   int RequestPIDFD(int ServerSocket);
 
+  /**
+   * @brief Request a FEXServer to hand out an FD to a shared AOTIR cache file
+   *
+   * Every emulated process on the box gets an FD of the same inode, so mapping
+   * it shares a single page cache copy between them even when the process's
+   * filesystem view doesn't include the data directory
+   *
+   * @param ServerSocket - Socket to the server
+   * @param FileID - AOTIR file id of the cache to open
+   *
+   * @return FD of the cache file, or -1 if the server doesn't have it
+   */
+  int RequestAOTIRCacheFD(int ServerSocket, const fextl::string &FileID);
+
+  /**
+   * @brief Request an FD to stream a freshly captured AOTIR cache in to
+   *
+   * The server creates a temporary file in its own data directory, so the
+   * capture lands in the shared cache rather than a per-process (or
+   * per-container) directory. Commit with RequestAOTIRCacheCommit once the
+   * stream is complete.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param FileID - AOTIR file id of the cache being written
+   *
+   * @return FD to write the cache to, or -1 on failure
+   */
+  int RequestAOTIRCacheWriteFD(int ServerSocket, const fextl::string &FileID);
+
+  /**
+   * @brief Ask the server to publish a cache previously streamed through
+   * RequestAOTIRCacheWriteFD
+   *
+   * The server atomically renames the temporary file in to place, after which
+   * RequestAOTIRCacheFD hands the object out to every process on the box.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param FileID - AOTIR file id of the cache to publish
+   *
+   * @return True if the server published the cache
+   */
+  bool RequestAOTIRCacheCommit(int ServerSocket, const fextl::string &FileID);
+
+  /**
+   * @brief Request an FD to stream a crash dump record in to
+   *
+   * The server creates the file in its own data directory, so the record
+   * lands somewhere a triage tool can find it even when the crashing
+   * process's filesystem view doesn't include the data directory.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param AppName - Application name used in the dump's filename
+   *
+   * @return FD to write the crash record to, or -1 on failure
+   */
+  int RequestCrashDumpFD(int ServerSocket, const fextl::string &AppName);
+  int RequestFlightRecordFD(int ServerSocket, const fextl::string &AppName);
+
+  /**
+   * @brief Push a snapshot of this process's runtime statistics to FEXServer
+   *
+   * Fire and forget; the server aggregates the latest snapshot per process and
+   * serves the fleet view on its stats socket in Prometheus text format.
+   *
+   * @param ServerSocket - Socket to the server. Use a dedicated connection,
+   * pushes interleaved with request/result traffic would corrupt both.
+   * @param Stats - Counter values in FEXCore::Statistics enum order
+   * @param NumStats - Number of counters
+   */
+  void SendStatsUpdate(int ServerSocket, const uint64_t *Stats, uint32_t NumStats);
+  void SendProfileUpdate(int ServerSocket, const ProfileSampleEntry *Entries, uint32_t NumEntries);
+
+  /**
+   * @brief Submit a guest binary for ahead-of-time compilation by the server
+   *
+   * Fire and forget. A server running with compile workers fans submissions
+   * out to a pool of low-priority FEXInterpreter processes in AOTIRGENERATE
+   * mode, so idle cores compile code the submitting process hasn't reached
+   * yet. Results land in the shared AOTIR cache and are picked up through
+   * RequestAOTIRCacheFD on the next run.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param Path - Absolute path of the binary to compile
+   */
+  void SendCompileSubmit(int ServerSocket, const fextl::string &Path);
+
+  /**
+   * @brief Record a named-region sighting and fetch the library's popularity tier
+   *
+   * The server counts sightings of each library base filename across every
+   * emulated process on the box and buckets them in to tiers, persisted across
+   * server restarts. Asking for the tier is also what records the sighting, so
+   * callers query exactly once per region load. The tier values match
+   * FEXCore::Context::LIBRARY_TIER_*.
+   *
+   * @param ServerSocket - Socket to the server
+   * @param BaseFilename - Base filename of the library
+   *
+   * @return The library's popularity tier, default tier on any failure
+   */
+  uint32_t RequestLibraryPriority(int ServerSocket, const fextl::string &BaseFilename);
+
   /**  @} */
 
   /**
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstdint>
+
+namespace FEX::FlightRecord {
+// Binary flight record format.
+//
+// Written on demand while the emulated process keeps running: touching
+// `<DataDir>/flightrecord.trigger` makes every FEX process with the flight
+// recorder enabled stream its per-thread rings of recently executed blocks
+// through an FD handed out by FEXServer, landing in the server's
+// `<DataDir>/flightrecords/` directory. Answers what a process was executing
+// around a performance anomaly without a reproducer or a debugger attach.
+//
+// File layout, all fields little-endian:
+//   Header
+//   uint64_t Telemetry[Header.NumTelemetryValues]  - FEXCore::Telemetry enum order
+//   Header.NumThreads x {
+//     ThreadHeader
+//     { uint64_t GuestRIP; uint64_t Cycles; } Entries[ThreadHeader.NumEntries]
+//       - oldest sample first. Cycles is the raw host cycle counter, diff
+//         neighbours and divide by the header frequency for wall time.
+//   }
+
+///< "FEXF"
+constexpr uint32_t COOKIE = 0x46584546;
+constexpr uint32_t VERSION = 0x0000'0001;
+
+struct Header {
+  uint32_t Cookie;
+  uint32_t Version;
+  int32_t PID;
+  uint32_t NumThreads;
+  ///< CLOCK_REALTIME nanoseconds at capture time.
+  uint64_t Timestamp;
+  ///< Host cycle counter frequency in Hz. Zero when unknown.
+  uint64_t CycleCounterFrequency;
+  uint32_t NumTelemetryValues;
+  uint32_t Reserved;
+};
+
+static_assert(sizeof(Header) == 40, "Flight record header changed size, bump VERSION");
+
+struct ThreadHeader {
+  int32_t TID;
+  uint32_t NumEntries;
+};
+}
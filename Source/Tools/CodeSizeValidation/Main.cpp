@@ -199,6 +199,69 @@ namespace CodeSize {
     SetupInfoDisabled = false;
   }
 
+  // Codegen-quality metrics derived from a block's disassembly. Instruction
+  // counts catch size regressions; the cycle estimate and spill traffic catch
+  // regressions that keep the count flat but trade cheap instructions for
+  // expensive ones or add register pressure.
+  struct CodegenMetrics {
+    uint64_t HostInstructions{};
+    uint64_t EstimatedCycles{};
+    uint64_t SpillStores{};
+    uint64_t FillLoads{};
+  };
+
+  // Coarse static cost weights. Not a pipeline model; the only requirement is
+  // that the total moves in the same direction as real cost so a diff between
+  // two commits is meaningful.
+  static uint64_t EstimateInstructionCost(std::string_view Line) {
+    const auto Mnemonic = Line.substr(0, Line.find(' '));
+
+    if (Mnemonic.starts_with("udiv") || Mnemonic.starts_with("sdiv") ||
+        Mnemonic.starts_with("fdiv") || Mnemonic.starts_with("fsqrt")) {
+      return 12;
+    }
+    if (Mnemonic.starts_with("dmb") || Mnemonic.starts_with("dsb") ||
+        Mnemonic.starts_with("isb")) {
+      return 10;
+    }
+    if (Mnemonic.starts_with("mul") || Mnemonic.starts_with("madd") ||
+        Mnemonic.starts_with("msub") || Mnemonic.starts_with("smull") ||
+        Mnemonic.starts_with("umull") || Mnemonic.starts_with("fmul") ||
+        Mnemonic.starts_with("fmadd")) {
+      return 3;
+    }
+    if (Mnemonic.starts_with("ld")) {
+      return 3;
+    }
+    if (Mnemonic.starts_with("blr") || Mnemonic.starts_with("st")) {
+      return 2;
+    }
+    return 1;
+  }
+
+  static CodegenMetrics CalculateMetrics(CodeSizeValidation::InstructionData const *Data) {
+    CodegenMetrics Metrics {
+      .HostInstructions = Data->first.HostCodeInstructions,
+    };
+
+    for (const auto &Line : Data->second) {
+      Metrics.EstimatedCycles += EstimateInstructionCost(Line);
+
+      // Spill slots live on the host stack, so sp-relative memory traffic in
+      // a block body is register spill and fill plus ABI-call save/restore;
+      // either way it is pressure the allocator failed to hide.
+      const bool SPRelative = Line.find("[sp") != Line.npos;
+      if (SPRelative && Line.starts_with("st")) {
+        ++Metrics.SpillStores;
+      }
+      else if (SPRelative && Line.starts_with("ld")) {
+        ++Metrics.FillLoads;
+      }
+    }
+
+    return Metrics;
+  }
+
   static CodeSizeValidation Validation{};
 }
 
@@ -248,7 +311,7 @@ static TestHeader const *TestHeaderData{};
 static TestInfo const *TestsStart{};
 static fextl::vector<std::pair<std::string_view, std::string_view>> EnvironmentVariables{};
 
-static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, const char *UpdatedInstructionCountsPath) {
+static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, const char *UpdatedInstructionCountsPath, const char *CodegenReportPath) {
   LogMan::Msg::IFmt("Compiling code");
 
   // Tell FEXCore to compile all the instructions upfront.
@@ -275,22 +338,26 @@ static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::Inte
 
     LogMan::Msg::IFmt("Testing instruction '{}': {} host instructions", CurrentTest->TestInst, INSTStats->first.HostCodeInstructions);
 
-    // Show the code if the count of instructions changed to something we didn't expect.
-    bool ShouldShowCode =
-      INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount;
-
-    if (ShouldShowCode) {
-      for (auto Line : INSTStats->second) {
-        LogMan::Msg::EFmt("\t{}", Line);
+    // Corpus entries packed from captured hot blocks carry a negative expected
+    // count: they only feed the codegen report and never gate on an exact match.
+    if (CurrentTest->ExpectedInstructionCount >= 0) {
+      // Show the code if the count of instructions changed to something we didn't expect.
+      bool ShouldShowCode =
+        INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount;
+
+      if (ShouldShowCode) {
+        for (auto Line : INSTStats->second) {
+          LogMan::Msg::EFmt("\t{}", Line);
+        }
       }
-    }
 
-    if (INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount) {
-      LogMan::Msg::EFmt("Fail: '{}': {} host instructions", CurrentTest->TestInst, INSTStats->first.HostCodeInstructions);
-      LogMan::Msg::EFmt("Fail: Test took {} instructions but we expected {} instructions!", INSTStats->first.HostCodeInstructions, CurrentTest->ExpectedInstructionCount);
+      if (INSTStats->first.HostCodeInstructions != CurrentTest->ExpectedInstructionCount) {
+        LogMan::Msg::EFmt("Fail: '{}': {} host instructions", CurrentTest->TestInst, INSTStats->first.HostCodeInstructions);
+        LogMan::Msg::EFmt("Fail: Test took {} instructions but we expected {} instructions!", INSTStats->first.HostCodeInstructions, CurrentTest->ExpectedInstructionCount);
 
-      // Fail the test if the instruction count has changed at all.
-      TestsPassed = false;
+        // Fail the test if the instruction count has changed at all.
+        TestsPassed = false;
+      }
     }
 
     // Go to the next test.
@@ -342,6 +409,55 @@ static bool TestInstructions(FEXCore::Context::Context *CTX, FEXCore::Core::Inte
 
     FD.Write("}\n", 2);
   }
+
+  if (CodegenReportPath) {
+    // Tab separated and in test order, so two reports from different commits
+    // diff line-for-line and a regression names the exact block.
+    unlink(CodegenReportPath);
+
+    FEXCore::File::File FD(CodegenReportPath, FEXCore::File::FileModes::WRITE | FEXCore::File::FileModes::CREATE | FEXCore::File::FileModes::TRUNCATE);
+
+    if (!FD.IsValid()) {
+      LogMan::Msg::EFmt("Couldn't open {} for the codegen report", CodegenReportPath);
+      return TestsPassed;
+    }
+
+    FD.Write(fextl::fmt::format("# block\tguest_insts\thost_insts\test_cycles\tspill_stores\tfill_loads\n"));
+
+    CodeSize::CodegenMetrics Totals{};
+    uint64_t TotalGuestInstructions{};
+
+    CurrentTest = TestsStart;
+    for (size_t i = 0; i < TestHeaderData->NumTests; ++i) {
+      uint64_t CodeRIP = (uint64_t)CurrentTest->Code;
+      auto INSTStats = CodeSize::Validation.GetDataForRIP(CodeRIP);
+      const auto Metrics = CodeSize::CalculateMetrics(INSTStats);
+
+      FD.Write(fextl::fmt::format("{}\t{}\t{}\t{}\t{}\t{}\n",
+        CurrentTest->TestInst,
+        INSTStats->first.GuestCodeInstructions,
+        Metrics.HostInstructions,
+        Metrics.EstimatedCycles,
+        Metrics.SpillStores,
+        Metrics.FillLoads));
+
+      TotalGuestInstructions += INSTStats->first.GuestCodeInstructions;
+      Totals.HostInstructions += Metrics.HostInstructions;
+      Totals.EstimatedCycles += Metrics.EstimatedCycles;
+      Totals.SpillStores += Metrics.SpillStores;
+      Totals.FillLoads += Metrics.FillLoads;
+
+      // Go to the next test.
+      CurrentTest = reinterpret_cast<TestInfo const*>(&CurrentTest->Code[CurrentTest->CodeSize]);
+    }
+
+    FD.Write(fextl::fmt::format("TOTAL\t{}\t{}\t{}\t{}\t{}\n",
+      TotalGuestInstructions,
+      Totals.HostInstructions,
+      Totals.EstimatedCycles,
+      Totals.SpillStores,
+      Totals.FillLoads));
+  }
   return TestsPassed;
 }
 
@@ -428,7 +544,7 @@ int main(int argc, char **argv, char **const envp) {
   FEXCore::Config::Load();
 
   if (argc < 2) {
-    LogMan::Msg::EFmt("Usage: {} <Test binary> [Changed instruction count.json]", argv[0]);
+    LogMan::Msg::EFmt("Usage: {} <Test binary> [Changed instruction count.json] [Codegen report.tsv]", argv[0]);
     return 1;
   }
 
@@ -567,7 +683,7 @@ int main(int argc, char **argv, char **const envp) {
   CodeSize::Validation.CalculateBaseStats(CTX.get(), ParentThread);
 
   // Test all the instructions.
-  auto Result = TestInstructions(CTX.get(), ParentThread, argc >= 2 ? argv[2] : nullptr) ? 0 : 1;
+  auto Result = TestInstructions(CTX.get(), ParentThread, argc >= 3 ? argv[2] : nullptr, argc >= 4 ? argv[3] : nullptr) ? 0 : 1;
   CTX->DestroyThread(ParentThread);
   return Result;
 }
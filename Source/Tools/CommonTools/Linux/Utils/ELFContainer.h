@@ -57,10 +57,13 @@ public:
   struct BRKInfo {
     uint64_t Base;
     uint64_t Size;
+    // Total reserved arena the brk can grow into. Matches Size when no
+    // growth room past the initial window was reserved.
+    uint64_t MaxSize;
   };
 
   BRKInfo GetBRKInfo() const {
-    return {BRKBase, BRKSize};
+    return {BRKBase, BRKSize, BRKSize};
   }
 
   // Data, Physical, Size
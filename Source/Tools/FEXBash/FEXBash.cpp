@@ -106,6 +106,19 @@ int main(int argc, char **argv, char **const envp) {
     PS1 += &PS1Env[strlen("PS1=")];
   }
   Envp.emplace_back(PS1.c_str());
+
+  // Warm session mode: the interactive bash process itself stays warm across
+  // commands since it is one long-lived emulated process, but every command
+  // it spawns is a fresh process that would otherwise redo its translation
+  // work. Turning on the AOT IR cache for the whole session makes that work
+  // stick: the first `ls` pays for the translation, later ones load it back
+  // through FEXServer's cache FDs.
+  FEX_CONFIG_OPT(WarmShellSession, WARMSHELLSESSION);
+  if (WarmShellSession()) {
+    Envp.emplace_back("FEX_AOTIRCAPTURE=1");
+    Envp.emplace_back("FEX_AOTIRLOAD=1");
+  }
+
   Envp.emplace_back(nullptr);
 
   return execve(Argv[0], const_cast<char *const*>(&Argv.at(0)), const_cast<char *const*>(&Envp[0]));
@@ -5,12 +5,15 @@
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Utils/CPUInfo.h>
 #include <FEXCore/Utils/LogManager.h>
-#include <FEXCore/fextl/queue.h>
+#include <FEXCore/fextl/deque.h>
+#include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/set.h>
 #include <FEXCore/fextl/vector.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <atomic>
 #include <cstddef>
+#include <mutex>
 #include <sys/resource.h>
 #include <sys/sysinfo.h>
 #include <thread>
@@ -83,25 +86,45 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
   fextl::set<uint64_t> Compiled;
   std::atomic<int> counter = 0;
 
-  fextl::queue<uint64_t> BranchTargets;
+  // Per-worker deques with stealing. Workers push and pop discovered branches
+  // on their own queue and only touch another worker's queue when theirs runs
+  // dry, so the queue locks stay uncontended on wide machines.
+  struct WorkerQueue {
+    std::mutex Mutex;
+    fextl::deque<uint64_t> Targets;
+  };
 
-  // Setup BranchTargets, Compiled sets from InitiaBranchTargets
+  const int NumWorkers = FEXCore::CPUInfo::CalculateNumberOfCPUs();
 
+  fextl::vector<fextl::unique_ptr<WorkerQueue>> WorkerQueues;
+  for (int i = 0; i < NumWorkers; i++) {
+    WorkerQueues.emplace_back(fextl::make_unique<WorkerQueue>());
+  }
+
+  // Partition the discovered entry points across the workers
   Compiled.insert(InitialBranchTargets.begin(), InitialBranchTargets.end());
-  for (auto BranchTarget: InitialBranchTargets) {
-    BranchTargets.push(BranchTarget);
+  {
+    int Worker = 0;
+    for (auto BranchTarget: InitialBranchTargets) {
+      WorkerQueues[Worker]->Targets.push_back(BranchTarget);
+      Worker = (Worker + 1) % NumWorkers;
+    }
   }
 
-  InitialBranchTargets.clear();
+  // Outstanding entry points across all queues, the pool is done when this
+  // hits zero. Workers only decrement after re-queueing discovered branches
+  // so it can't reach zero while work is still being generated.
+  std::atomic<uint64_t> WorkRemaining = InitialBranchTargets.size();
 
+  InitialBranchTargets.clear();
 
-  std::mutex QueueMutex;
+  std::mutex CompiledMutex;
   fextl::vector<std::thread> ThreadPool;
 
   // This code is tricky to refactor so it doesn't allocate memory through glibc.
   FEXCore::Allocator::YesIKnowImNotSupposedToUseTheGlibcAllocator glibc;
-  for (int i = 0; i < FEXCore::CPUInfo::CalculateNumberOfCPUs(); i++) {
-    std::thread thd([&BranchTargets, CTX, &counter, &Compiled, &Section, &QueueMutex, SectionMaxAddress]() {
+  for (int i = 0; i < NumWorkers; i++) {
+    std::thread thd([&WorkerQueues, NumWorkers, i, CTX, &counter, &Compiled, &Section, &CompiledMutex, &WorkRemaining, SectionMaxAddress]() {
       // Set the priority of the thread so it doesn't overwhelm the system when running in the background
       setpriority(PRIO_PROCESS, FHU::Syscalls::gettid(), 19);
 
@@ -110,19 +133,44 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
       fextl::set<uint64_t> ExternalBranchesLocal;
       CTX->ConfigureAOTGen(Thread, &ExternalBranchesLocal, SectionMaxAddress);
 
+      auto &OwnQueue = *WorkerQueues[i];
+
       for (;;) {
         uint64_t BranchTarget;
+        bool HasWork = false;
+
+        // Pop from our own queue first
+        {
+          std::lock_guard lk {OwnQueue.Mutex};
+          if (!OwnQueue.Targets.empty()) {
+            BranchTarget = OwnQueue.Targets.back();
+            OwnQueue.Targets.pop_back();
+            HasWork = true;
+          }
+        }
 
-        // Get a entrypoint to process from the queue
-        QueueMutex.lock();
-        if (BranchTargets.empty()) {
-          QueueMutex.unlock();
-          break; // no entrypoint to process - exit
+        // Own queue dry, steal from the front of a victim's queue
+        if (!HasWork) {
+          for (int j = 1; j < NumWorkers && !HasWork; j++) {
+            auto &Victim = *WorkerQueues[(i + j) % NumWorkers];
+            std::lock_guard lk {Victim.Mutex};
+            if (!Victim.Targets.empty()) {
+              BranchTarget = Victim.Targets.front();
+              Victim.Targets.pop_front();
+              HasWork = true;
+            }
+          }
         }
 
-        BranchTarget = BranchTargets.front();
-        BranchTargets.pop();
-        QueueMutex.unlock();
+        if (!HasWork) {
+          if (WorkRemaining.load() == 0) {
+            break; // no entrypoint to process anywhere - exit
+          }
+
+          // Another worker is still compiling and may discover more branches
+          std::this_thread::yield();
+          continue;
+        }
 
         // Compile entrypoint
         counter++;
@@ -130,19 +178,27 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader::LoadedSection
 
         // Are there more branches?
         if (ExternalBranchesLocal.size() > 0) {
-          // Add them to the "to process" list
-          QueueMutex.lock();
-          for(auto Destination: ExternalBranchesLocal) {
+          // Add them to our own queue
+          uint64_t Added = 0;
+          {
+            std::lock_guard lk {CompiledMutex};
+            for (auto Destination: ExternalBranchesLocal) {
               if (! (Destination >= Section.Base && Destination <= (Section.Base + Section.Size)) )
                 continue;
               if (Compiled.contains(Destination))
                 continue;
               Compiled.insert(Destination);
-            BranchTargets.push(Destination);
+
+              std::lock_guard qlk {OwnQueue.Mutex};
+              OwnQueue.Targets.push_back(Destination);
+              ++Added;
+            }
           }
-          QueueMutex.unlock();
+          WorkRemaining += Added;
           ExternalBranchesLocal.clear();
         }
+
+        --WorkRemaining;
       }
 
       // All entryproints processed, cleanup this thread
@@ -16,6 +16,7 @@
 #include <cassert>
 #include <cstring>
 #include <random>
+#include <thread>
 
 #include <FEXCore/Core/CodeLoader.h>
 #include <FEXCore/Core/CoreState.h>
@@ -110,6 +111,48 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
     return rv;
   }
 
+  // Warms the page cache for the file ranges backing an ELF's PT_LOAD
+  // segments from a background thread. The segment mappings themselves are
+  // already demand-paged, but on a compressed RootFS every major fault pays
+  // squashfs decompression latency one page at a time. For huge guest
+  // binaries prefetching in the background overlaps that cost with the rest
+  // of process startup instead of serializing it behind guest execution.
+  // Purely advisory - the kernel is free to drop the pages under pressure.
+  static void StartSegmentReadahead(const ELFParser& Elf) {
+    struct FileRange {
+      off_t Offset;
+      size_t Size;
+    };
+    fextl::vector<FileRange> Ranges;
+    for (const auto &Header : Elf.phdrs) {
+      if (Header.p_type != PT_LOAD || Header.p_filesz == 0)
+        continue;
+
+      Ranges.push_back({
+        static_cast<off_t>(PAGE_START(Header.p_offset)),
+        static_cast<size_t>(PAGE_ALIGN(Header.p_filesz + PAGE_OFFSET(Header.p_offset))),
+      });
+    }
+
+    if (Ranges.empty()) {
+      return;
+    }
+
+    // The parser's FD can be closed before the thread gets around to running,
+    // so give the thread its own reference.
+    int FD = ::dup(Elf.fd);
+    if (FD == -1) {
+      return;
+    }
+
+    std::thread([FD, Ranges = std::move(Ranges)]() {
+      for (const auto &Range : Ranges) {
+        ::readahead(FD, Range.Offset, Range.Size);
+      }
+      ::close(FD);
+    }).detach();
+  }
+
   std::optional<uintptr_t> LoadElfFile(ELFParser& Elf, uintptr_t *BrkBase, FEX::HLE::SyscallHandler *const Handler, uint64_t LoadHint = 0) {
 
     uintptr_t LoadBase = 0;
@@ -120,7 +163,7 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
 
     if (Elf.ehdr.e_type == ET_DYN) {
       // needs base address
-      auto TotalSize = CalculateTotalElfSize(Elf.phdrs) + (BrkBase ? BRK_SIZE : 0);
+      auto TotalSize = CalculateTotalElfSize(Elf.phdrs) + (BrkBase ? BrkArenaSize() : 0);
       LoadBase = (uintptr_t)Handler->GuestMmap(nullptr, reinterpret_cast<void*>(LoadHint), TotalSize, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
       if ((void*)LoadBase == MAP_FAILED) {
         return {};
@@ -128,7 +171,7 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
 
       //fprintf(stderr, "elf %d: %lx-%lx\n", Elf.fd, LoadBase, LoadBase + TotalSize);
       if (BrkBase) {
-        *BrkBase = LoadBase + (TotalSize - BRK_SIZE);
+        *BrkBase = LoadBase + (TotalSize - BrkArenaSize());
       }
     }
 
@@ -174,6 +217,8 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
       }
     }
 
+    StartSegmentReadahead(Elf);
+
     return LoadBase;
   }
 
@@ -540,7 +585,18 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
 
     // XXX Randomise brk?
 
-    BrkStart = (uint64_t)Handler->GuestMmap(nullptr, (void*)BrkBase, BRK_SIZE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0);
+    // Reserve the whole growth arena up front with no access permissions, then
+    // commit the initial window over its front. brk growth is then a protection
+    // flip inside one mapping instead of a fresh mmap with its own VMA and SMC
+    // registration per increment.
+    uint64_t BrkArena = (uint64_t)Handler->GuestMmap(nullptr, (void*)BrkBase, BrkArenaSize(), PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE | MAP_FIXED, -1, 0);
+
+    if ((void*)BrkArena == MAP_FAILED) {
+      LogMan::Msg::EFmt("Failed to reserve BRK arena @ {:x}, {}\n", BrkBase, errno);
+      return false;
+    }
+
+    BrkStart = (uint64_t)Handler->GuestMmap(nullptr, (void*)BrkArena, BRK_SIZE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0);
 
     if ((void*)BrkStart == MAP_FAILED) {
       LogMan::Msg::EFmt("Failed to allocate BRK @ {:x}, {}\n", BrkBase, errno);
@@ -823,8 +879,12 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
     return MainElf.type == ::ELFLoader::ELFContainer::TYPE_X86_64;
   }
 
+  uint64_t BrkArenaSize() const {
+    return Is64BitMode() ? BRK_ARENA_SIZE_64 : BRK_ARENA_SIZE_32;
+  }
+
   ::ELFLoader::ELFContainer::BRKInfo GetBRKInfo() {
-    return ::ELFLoader::ELFContainer::BRKInfo { BrkStart, BRK_SIZE };
+    return ::ELFLoader::ELFContainer::BRKInfo { BrkStart, BRK_SIZE, BrkArenaSize() };
   }
 
   bool ELFWasLoaded() {
@@ -901,6 +961,10 @@ class ELFCodeLoader final : public FEXCore::CodeLoader {
   }
 
   constexpr static uint64_t BRK_SIZE = 8 * 1024 * 1024;
+  // Reserved-but-uncommitted room the brk can grow into without new mappings.
+  // Kept modest on 32-bit where address space is the scarce resource.
+  constexpr static uint64_t BRK_ARENA_SIZE_64 = 512 * 1024 * 1024;
+  constexpr static uint64_t BRK_ARENA_SIZE_32 = 64 * 1024 * 1024;
   constexpr static uint64_t STACK_SIZE = 8 * 1024 * 1024;
   constexpr static uint64_t FULL_STACK_SIZE = 128 * 1024 * 1024;
   constexpr static uint64_t STACK_HINT_32 = 0xFFFFE000 - FULL_STACK_SIZE;
@@ -9,8 +9,12 @@ $end_info$
 #include "AOT/AOTGenerator.h"
 #include "Common/ArgumentLoader.h"
 #include "Common/FEXServerClient.h"
+#include "Common/FlightRecord.h"
 #include "Common/Config.h"
 #include "ELFCodeLoader.h"
+#include "ForkServer.h"
+#include "SampleProfiler.h"
+#include "StartupTimeline.h"
 #include "VDSO_Emulation.h"
 #include "LinuxSyscalls/GdbServer.h"
 #include "LinuxSyscalls/LinuxAllocator.h"
@@ -25,11 +29,13 @@ $end_info$
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/CPUInfo.h>
 #include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Telemetry.h>
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/Utils/Profiler.h>
+#include <FEXCore/Utils/Statistics.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/sstream.h>
@@ -39,16 +45,19 @@ $end_info$
 
 #include <atomic>
 #include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <elf.h>
 #include <fcntl.h>
 #include <mutex>
 #include <queue>
 #include <set>
 #include <sys/auxv.h>
+#include <sys/inotify.h>
 #include <sys/prctl.h>
 #include <sys/resource.h>
 #include <sys/select.h>
@@ -107,6 +116,10 @@ namespace AOTIR {
         FD = open(Path.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, USER_PERMS);
       }
 
+      // Takes ownership of an already opened FD, e.g. one handed out by the
+      // FEXServer for its shared cache store.
+      explicit AOTIRWriterFD(int FD) : FD {FD} {}
+
       operator bool() const {
         return FD != -1;
       }
@@ -115,6 +128,10 @@ namespace AOTIR {
         write(FD, Data, Size);
       }
 
+      void WriteAt(const void* Data, size_t Size, size_t Offset) override {
+        pwrite(FD, Data, Size, Offset);
+      }
+
       size_t Offset() override {
         return lseek(FD, 0, SEEK_CUR);
       }
@@ -250,9 +267,223 @@ namespace FEX::TSO {
   }
 }
 
+namespace FEX::ConfigWatch {
+  // Watches the config files with inotify and re-applies the live-safe
+  // tunables when one of them changes. Everything else keeps the value it
+  // resolved at startup.
+  void Start(FEXCore::Context::Context *CTX, fextl::string ProgramName) {
+    std::thread([CTX, ProgramName = std::move(ProgramName)]() {
+      int FD = inotify_init1(IN_CLOEXEC);
+      if (FD == -1) {
+        return;
+      }
+
+      const fextl::vector<fextl::string> ConfigFiles = {
+        FEXCore::Config::GetConfigFileLocation(true),
+        FEXCore::Config::GetConfigFileLocation(false),
+        FEXCore::Config::GetApplicationConfig(ProgramName, true),
+        FEXCore::Config::GetApplicationConfig(ProgramName, false),
+      };
+
+      struct WatchedFile {
+        int WD;
+        fextl::string Filename;
+      };
+      fextl::vector<WatchedFile> Watches;
+      for (const auto &File : ConfigFiles) {
+        if (File.empty()) {
+          continue;
+        }
+
+        // Watch the directory rather than the file. Config editors replace
+        // the file atomically, which would orphan a watch on the file itself.
+        const auto Dir = FHU::Filesystem::ParentPath(File);
+        const int WD = inotify_add_watch(FD, Dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (WD != -1) {
+          Watches.emplace_back(WatchedFile { WD, FHU::Filesystem::GetFilename(File) });
+        }
+      }
+
+      if (Watches.empty()) {
+        close(FD);
+        return;
+      }
+
+      alignas(struct inotify_event) char Buffer[4096];
+      while (true) {
+        const ssize_t Size = read(FD, Buffer, sizeof(Buffer));
+        if (Size <= 0) {
+          break;
+        }
+
+        bool ConfigChanged = false;
+        for (ssize_t Offset = 0; Offset < Size;) {
+          auto *Event = reinterpret_cast<struct inotify_event *>(&Buffer[Offset]);
+          if (Event->len != 0) {
+            for (const auto &Watch : Watches) {
+              if (Watch.WD == Event->wd && Watch.Filename == Event->name) {
+                ConfigChanged = true;
+                break;
+              }
+            }
+          }
+          Offset += sizeof(struct inotify_event) + Event->len;
+        }
+
+        if (ConfigChanged) {
+          FEXCore::Config::ReloadFileLayers();
+          CTX->ReloadLiveTunables();
+        }
+      }
+
+      close(FD);
+    }).detach();
+  }
+}
+
+namespace FEX::FlightRecordWatch {
+  static uint64_t CycleCounterFrequency() {
+#ifdef _M_ARM_64
+    uint64_t Result{};
+    __asm("mrs %[Res], CNTFRQ_EL0"
+        : [Res] "=r" (Result));
+    return Result;
+#else
+    return 0;
+#endif
+  }
+
+  // Streams the flight recorder rings of every guest thread plus a telemetry
+  // snapshot through an FD handed out by FEXServer. The thread list is only
+  // stable while the world is paused, so the caller pauses around this.
+  static void Dump(FEX::HLE::SyscallHandler *Handler, int ServerSocket, const fextl::string &AppName) {
+    const int FD = FEXServerClient::RequestFlightRecordFD(ServerSocket, AppName);
+    if (FD == -1) {
+      return;
+    }
+
+    struct timespec Time{};
+    clock_gettime(CLOCK_REALTIME, &Time);
+
+    FEX::FlightRecord::Header Header {
+      .Cookie = FEX::FlightRecord::COOKIE,
+      .Version = FEX::FlightRecord::VERSION,
+      .PID = ::getpid(),
+      .Timestamp = Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec,
+      .CycleCounterFrequency = CycleCounterFrequency(),
+    };
+
+    auto Threads = Handler->TM.GetThreads();
+    for (auto &Thread : *Threads) {
+      if (Thread->CurrentFrame->FlightRecorderRing) {
+        ++Header.NumThreads;
+      }
+    }
+
+#ifndef FEX_DISABLE_TELEMETRY
+    uint64_t TelemetryValues[FEXCore::Telemetry::TYPE_LAST];
+    for (size_t i = 0; i < FEXCore::Telemetry::TYPE_LAST; ++i) {
+      TelemetryValues[i] = *FEXCore::Telemetry::GetTelemetryValue(static_cast<FEXCore::Telemetry::TelemetryType>(i));
+    }
+    Header.NumTelemetryValues = FEXCore::Telemetry::TYPE_LAST;
+#endif
+
+    write(FD, &Header, sizeof(Header));
+#ifndef FEX_DISABLE_TELEMETRY
+    write(FD, TelemetryValues, Header.NumTelemetryValues * sizeof(uint64_t));
+#endif
+
+    fextl::vector<FEXCore::Core::CpuStateFrame::FlightRecorderEntry> Entries;
+    Entries.reserve(FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_ENTRIES);
+    for (auto &Thread : *Threads) {
+      const auto Frame = Thread->CurrentFrame;
+      if (!Frame->FlightRecorderRing) {
+        continue;
+      }
+
+      // Rotate the ring out oldest-first. Unwritten slots hold a zero RIP.
+      Entries.clear();
+      const uint32_t Index = Frame->FlightRecorderIndex;
+      for (uint32_t i = 0; i < FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_ENTRIES; ++i) {
+        const auto &Entry = Frame->FlightRecorderRing[(Index + i) & FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_MASK];
+        if (Entry.GuestRIP != 0) {
+          Entries.emplace_back(Entry);
+        }
+      }
+
+      FEX::FlightRecord::ThreadHeader ThreadHeader {
+        .TID = static_cast<int32_t>(Thread->ThreadManager.GetTID()),
+        .NumEntries = static_cast<uint32_t>(Entries.size()),
+      };
+      write(FD, &ThreadHeader, sizeof(ThreadHeader));
+      write(FD, Entries.data(), Entries.size() * sizeof(Entries[0]));
+    }
+
+    close(FD);
+  }
+
+  // Watches `<DataDir>/flightrecord.trigger` with inotify, touching the file
+  // dumps a flight record of every running FEX process that has the recorder
+  // enabled. Mirrors the config hot reload watcher.
+  void Start(FEX::HLE::SyscallHandler *Handler, fextl::string AppName) {
+    std::thread([Handler, AppName = std::move(AppName)]() {
+      int FD = inotify_init1(IN_CLOEXEC);
+      if (FD == -1) {
+        return;
+      }
+
+      const auto TriggerName = "flightrecord.trigger";
+      const int WD = inotify_add_watch(FD, FEXCore::Config::GetDataDirectory().c_str(),
+                                       IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB);
+      if (WD == -1) {
+        close(FD);
+        return;
+      }
+
+      // Dumps go over their own server connection, the shared server FD
+      // carries request/result pairs from other threads.
+      int ServerSocket = -1;
+
+      alignas(struct inotify_event) char Buffer[4096];
+      while (true) {
+        const ssize_t Size = read(FD, Buffer, sizeof(Buffer));
+        if (Size <= 0) {
+          break;
+        }
+
+        bool Triggered = false;
+        for (ssize_t Offset = 0; Offset < Size;) {
+          auto *Event = reinterpret_cast<struct inotify_event *>(&Buffer[Offset]);
+          if (Event->len != 0 && strcmp(Event->name, TriggerName) == 0) {
+            Triggered = true;
+          }
+          Offset += sizeof(struct inotify_event) + Event->len;
+        }
+
+        if (Triggered) {
+          if (ServerSocket == -1) {
+            ServerSocket = FEXServerClient::ConnectToServer(FEXServerClient::ConnectionOption::NoPrintConnectionError);
+          }
+          if (ServerSocket != -1) {
+            // Pause the guest threads for the capture. The thread list and the
+            // rings are only stable while nothing executes, and an operator
+            // poking the trigger has already accepted a hiccup.
+            Handler->TM.Pause();
+            Dump(Handler, ServerSocket, AppName);
+            Handler->TM.Run();
+          }
+        }
+      }
+
+      close(FD);
+    }).detach();
+  }
+}
+
 int main(int argc, char **argv, char **const envp) {
   auto SBRKPointer = FEXCore::Allocator::DisableSBRKAllocations();
   FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
+  FEX::StartupTimeline::Begin("config-load");
   const bool IsInterpreter = RanAsInterpreter(argv[0]);
 
   ExecutedWithFD = getauxval(AT_EXECFD) != 0;
@@ -269,14 +500,26 @@ int main(int argc, char **argv, char **const envp) {
     ExecutedWithFD,
     FEXFDView);
 
-  if (Program.ProgramPath.empty() && !FEXFD) {
-    // Early exit if we weren't passed an argument
+  FEX_CONFIG_OPT(ForkServerSocket, FORKSERVERSOCKET);
+
+  if (Program.ProgramPath.empty() && !FEXFD && ForkServerSocket().empty()) {
+    // Early exit if we weren't passed an argument and we aren't a resident fork server
     return 0;
   }
 
   auto Args = FEX::ArgLoader::Get();
   auto ParsedArgs = FEX::ArgLoader::GetParsedArgs();
 
+  if (!ForkServerSocket().empty() && !Program.ProgramPath.empty() && !FEXFD) {
+    // Try to relay the launch through a resident fork server, skipping all of
+    // the startup initialization below. Falls through to a regular launch when
+    // no server is listening.
+    int Status = FEX::ForkServer::LaunchThroughServer(ForkServerSocket(), Args);
+    if (Status != -1) {
+      return Status;
+    }
+  }
+
   // Reload the meta layer
   FEXCore::Config::ReloadMetaLayer();
   FEXCore::Config::Set(FEXCore::Config::CONFIG_IS_INTERPRETER, IsInterpreter ? "1" : "0");
@@ -297,15 +540,20 @@ int main(int argc, char **argv, char **const envp) {
   }
 
   // Ensure FEXServer is setup before config options try to pull CONFIG_ROOTFS
+  // This span covers spawning or finding the server and waiting for it to be
+  // ready, which includes its squashfs rootfs mount on first launch.
+  FEX::StartupTimeline::Begin("fexserver-negotiation");
   if (!FEXServerClient::SetupClient(argv[0])) {
     LogMan::Msg::EFmt("FEXServerClient: Failure to setup client");
     return -1;
   }
+  FEX::StartupTimeline::Begin("program-setup");
 
   FEX_CONFIG_OPT(SilentLog, SILENTLOG);
   FEX_CONFIG_OPT(AOTIRCapture, AOTIRCAPTURE);
   FEX_CONFIG_OPT(AOTIRGenerate, AOTIRGENERATE);
   FEX_CONFIG_OPT(AOTIRLoad, AOTIRLOAD);
+  FEX_CONFIG_OPT(PMUTuning, PMUTUNING);
   FEX_CONFIG_OPT(OutputLog, OUTPUTLOG);
   FEX_CONFIG_OPT(LDPath, ROOTFS);
   FEX_CONFIG_OPT(Environment, ENV);
@@ -349,6 +597,34 @@ int main(int argc, char **argv, char **const envp) {
   FEXCore::Profiler::Init();
   FEXCore::Telemetry::Initialize();
 
+  if (!ForkServerSocket().empty() && Program.ProgramPath.empty() && !FEXFD) {
+    // Resident fork server. The config load, FEXServer negotiation and logging
+    // setup above are inherited by every forked child, each launch only pays
+    // for the program-specific work below. Must run before any threads are
+    // spawned since only the serving thread survives a fork.
+    auto Launch = FEX::ForkServer::Serve(ForkServerSocket());
+    if (!Launch) {
+      // Server shut down
+      return 0;
+    }
+
+    // We are a forked child. Adopt the requested program and continue the
+    // regular startup path below.
+    Program.ProgramPath = Launch->Args[0];
+    Program.ProgramName = FHU::Filesystem::GetFilename(Program.ProgramPath);
+    Args = std::move(Launch->Args);
+    ParsedArgs = Args;
+
+    // Each child needs a private FEXServer connection, sharing the parent's
+    // socket between concurrent children would interleave their request
+    // streams.
+    close(FEXServerClient::GetServerFD());
+    if (!FEXServerClient::SetupClient(argv[0])) {
+      LogMan::Msg::EFmt("FEXServerClient: Failure to setup client");
+      return -1;
+    }
+  }
+
   RootFSRedirect(&Program.ProgramPath, LDPath());
   InterpreterHandler(&Program.ProgramPath, LDPath(), &Args);
 
@@ -372,6 +648,7 @@ int main(int argc, char **argv, char **const envp) {
     putenv(HostEnv.data());
   }
 
+  FEX::StartupTimeline::Begin("elf-load");
   ELFCodeLoader Loader{Program.ProgramPath, FEXFDView, LDPath(), Args, ParsedArgs, envp, &Environment};
 
   if (!Loader.ELFWasLoaded()) {
@@ -389,6 +666,8 @@ int main(int argc, char **argv, char **const envp) {
     return -ENOEXEC;
   }
 
+  FEX::StartupTimeline::Begin("core-setup");
+
   if (ExecutedWithFD) {
     // Don't need to canonicalize Program.ProgramPath, Config loader will have resolved this already.
     FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_APP_FILENAME, Program.ProgramPath);
@@ -440,6 +719,85 @@ int main(int argc, char **argv, char **const envp) {
   // System allocator is now system allocator or FEX
   FEXCore::Context::InitializeStaticTables(Loader.Is64BitMode() ? FEXCore::Context::MODE_64BIT : FEXCore::Context::MODE_32BIT);
 
+  // Best-known per-program codegen parameters, learned across sessions and
+  // persisted alongside the AOTIR cache. Most sessions run the incumbent
+  // configuration; occasionally one parameter is trialled, and the trial is
+  // only adopted at exit if the PMU session score improved on the incumbent.
+  struct {
+    int32_t Budget {};       // Trace budget the PMU controller settled on
+    int32_t LoopRange {-1};  // Multiblock backward-branch range, -1 unset
+    int32_t InlineLeaf {-1}; // InlineLeafCalls as 0/1, -1 unset
+    int64_t Score {-1};      // Session score of the incumbent, lower is better
+    // Values this session is trialling, -1 when not trialling
+    int32_t TrialLoopRange {-1};
+    int32_t TrialInlineLeaf {-1};
+  } Tune;
+
+  if (PMUTuning()) {
+    // Seed this run from the parameters the store settled on for this program.
+    const auto TuneFilepath = fextl::fmt::format("{}/aotir/{}.tune", FEXCore::Config::GetDataDirectory(), Program.ProgramName);
+    fextl::string TuneData;
+    if (FEXCore::FileLoading::LoadFile(TuneData, TuneFilepath)) {
+      if (TuneData.find('=') == fextl::string::npos) {
+        // Files from before the parameter store hold a bare budget number.
+        Tune.Budget = std::strtol(TuneData.c_str(), nullptr, 10);
+      } else {
+        // One key=value per line.
+        size_t Begin = 0;
+        while (Begin < TuneData.size()) {
+          size_t End = TuneData.find('\n', Begin);
+          if (End == fextl::string::npos) {
+            End = TuneData.size();
+          }
+          const std::string_view Line {TuneData.c_str() + Begin, End - Begin};
+          const auto Split = Line.find('=');
+          if (Split != Line.npos) {
+            const auto Key = Line.substr(0, Split);
+            const int64_t Value = std::strtoll(Line.data() + Split + 1, nullptr, 10);
+            if (Key == "budget") {
+              Tune.Budget = Value;
+            } else if (Key == "looprange") {
+              Tune.LoopRange = Value;
+            } else if (Key == "inlineleaf") {
+              Tune.InlineLeaf = Value;
+            } else if (Key == "score") {
+              Tune.Score = Value;
+            }
+          }
+          Begin = End + 1;
+        }
+      }
+    }
+
+    if (Tune.Budget > 0) {
+      FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_MULTIBLOCKTRACEINST, fextl::fmt::format("{}", Tune.Budget));
+    }
+
+    // Trial one parameter change with a 1-in-4 chance, greedy otherwise. The
+    // budget is excluded: it has its own live controller inside FEXCore.
+    FEX_CONFIG_OPT(MultiblockLoopRange, MULTIBLOCKLOOPRANGE);
+    FEX_CONFIG_OPT(InlineLeafCalls, INLINELEAFCALLS);
+    const int32_t BaseLoopRange = Tune.LoopRange != -1 ? Tune.LoopRange : MultiblockLoopRange();
+    const int32_t BaseInlineLeaf = Tune.InlineLeaf != -1 ? Tune.InlineLeaf : (InlineLeafCalls() ? 1 : 0);
+    const uint32_t Roll = static_cast<uint32_t>(::getpid()) ^ static_cast<uint32_t>(::time(nullptr));
+    if ((Roll & 3) == 0) {
+      switch ((Roll >> 2) % 3) {
+      case 0: Tune.TrialLoopRange = BaseLoopRange ? BaseLoopRange * 2 : 1024; break;
+      case 1: Tune.TrialLoopRange = BaseLoopRange / 2; break;
+      case 2: Tune.TrialInlineLeaf = BaseInlineLeaf ? 0 : 1; break;
+      }
+    }
+
+    const int32_t RunLoopRange = Tune.TrialLoopRange != -1 ? Tune.TrialLoopRange : Tune.LoopRange;
+    if (RunLoopRange != -1) {
+      FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_MULTIBLOCKLOOPRANGE, fextl::fmt::format("{}", RunLoopRange));
+    }
+    const int32_t RunInlineLeaf = Tune.TrialInlineLeaf != -1 ? Tune.TrialInlineLeaf : Tune.InlineLeaf;
+    if (RunInlineLeaf != -1) {
+      FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_INLINELEAFCALLS, fextl::fmt::format("{}", RunInlineLeaf));
+    }
+  }
+
   auto CTX = FEXCore::Context::Context::CreateNewContext();
 
   // Setup TSO hardware emulation immediately after initializing the context.
@@ -450,6 +808,7 @@ int main(int argc, char **argv, char **const envp) {
   auto SyscallHandler = Loader.Is64BitMode() ? FEX::HLE::x64::CreateHandler(CTX.get(), SignalDelegation.get())
                                              : FEX::HLE::x32::CreateHandler(CTX.get(), SignalDelegation.get(), std::move(Allocator));
 
+  FEX::StartupTimeline::Begin("program-map");
   {
     // Load VDSO in to memory prior to mapping our ELFs.
     void* VDSOBase = FEX::VDSO::LoadVDSOThunks(Loader.Is64BitMode(), SyscallHandler.get());
@@ -467,7 +826,7 @@ int main(int argc, char **argv, char **const envp) {
 
   auto BRKInfo = Loader.GetBRKInfo();
 
-  SyscallHandler->DefaultProgramBreak(BRKInfo.Base, BRKInfo.Size);
+  SyscallHandler->DefaultProgramBreak(BRKInfo.Base, BRKInfo.Size, BRKInfo.MaxSize);
 
   CTX->SetSignalDelegator(SignalDelegation.get());
   CTX->SetSyscallHandler(SyscallHandler.get());
@@ -478,6 +837,7 @@ int main(int argc, char **argv, char **const envp) {
     DebugServer = fextl::make_unique<FEX::GdbServer>(CTX.get(), SignalDelegation.get(), SyscallHandler.get());
   }
 
+  FEX::StartupTimeline::Begin("core-init");
   if (!CTX->InitCore()) {
     return 1;
   }
@@ -500,17 +860,49 @@ int main(int argc, char **argv, char **const envp) {
     });
   }
 
+  CTX->SetLibraryPriorityQuery([](const fextl::string &BaseFilename) -> uint32_t {
+    // The FEXServer counts named-region sightings from every emulated process
+    // on the box; the query doubles as this process's sighting report.
+    // Fleet-hot libraries skip the baseline compile tier from first touch.
+    if (FEXServerClient::GetServerFD() == -1) {
+      return FEXCore::Context::LIBRARY_TIER_DEFAULT;
+    }
+    return FEXServerClient::RequestLibraryPriority(FEXServerClient::GetServerFD(), BaseFilename);
+  });
+
   const bool AOTEnabled = AOTIRLoad() || AOTIRCapture() || AOTIRGenerate();
   if (AOTEnabled) {
     LogMan::Msg::IFmt("Warning: AOTIR is experimental, and might lead to crashes. "
                       "Capture doesn't work with programs that fork.");
 
     CTX->SetAOTIRLoader([](const fextl::string &fileid) -> int {
+      // Ask the FEXServer for the cache first. Every emulated process then maps
+      // the same inode, sharing one page cache copy of the compiled code, and
+      // it works even when this process's filesystem view doesn't include the
+      // data directory.
+      if (FEXServerClient::GetServerFD() != -1) {
+        int FD = FEXServerClient::RequestAOTIRCacheFD(FEXServerClient::GetServerFD(), fileid);
+        if (FD != -1) {
+          return FD;
+        }
+      }
+
       const auto filepath = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), fileid);
       return open(filepath.c_str(), O_RDONLY);
     });
 
     CTX->SetAOTIRWriter([](const fextl::string& fileid) -> fextl::unique_ptr<AOTIR::AOTIRWriterFD> {
+      // Stream captures through the FEXServer when it is around so they land
+      // in the host-level shared store instead of a per-process (or
+      // per-container) directory. The renamer below commits them.
+      if (FEXServerClient::GetServerFD() != -1) {
+        int FD = FEXServerClient::RequestAOTIRCacheWriteFD(FEXServerClient::GetServerFD(), fileid);
+        if (FD != -1) {
+          LogMan::Msg::IFmt("AOTIR: Storing {} via FEXServer", fileid);
+          return fextl::make_unique<AOTIR::AOTIRWriterFD>(FD);
+        }
+      }
+
       const auto filepath = fextl::fmt::format("{}/aotir/{}.aotir.tmp", FEXCore::Config::GetDataDirectory(), fileid);
       auto AOTWrite = fextl::make_unique<AOTIR::AOTIRWriterFD>(filepath);
       if (*AOTWrite) {
@@ -521,7 +913,22 @@ int main(int argc, char **argv, char **const envp) {
       return AOTWrite;
     });
 
+    if (AOTIRLoad() && !AOTIRGenerate() && !Program.ProgramPath.empty() &&
+        FEXServerClient::GetServerFD() != -1) {
+      // Hand the binary to the server's compile workers. Idle cores populate
+      // the shared cache in the background while this run executes whatever
+      // already exists; the next launch picks up the rest.
+      FEXServerClient::SendCompileSubmit(FEXServerClient::GetServerFD(), Program.ProgramPath);
+    }
+
     CTX->SetAOTIRRenamer([](const fextl::string& fileid) -> void {
+      // A capture streamed through the server gets committed there too; the
+      // server renames its temporary in to place atomically.
+      if (FEXServerClient::GetServerFD() != -1 &&
+          FEXServerClient::RequestAOTIRCacheCommit(FEXServerClient::GetServerFD(), fileid)) {
+        return;
+      }
+
       const auto TmpFilepath = fextl::fmt::format("{}/aotir/{}.aotir.tmp", FEXCore::Config::GetDataDirectory(), fileid);
       const auto NewFilepath = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), fileid);
 
@@ -532,6 +939,55 @@ int main(int argc, char **argv, char **const envp) {
     });
   }
 
+  FEX_CONFIG_OPT(AuxiliaryThreadAffinity, AUXILIARYTHREADAFFINITY);
+
+  FEX_CONFIG_OPT(StatsPushInterval, STATSPUSHINTERVAL);
+  if (StatsPushInterval() > 0) {
+    // Pushes go over their own server connection. The shared server FD carries
+    // request/result pairs and interleaving pushes would corrupt both streams.
+    std::thread([Interval = StatsPushInterval(), PinAux = AuxiliaryThreadAffinity()]() {
+      if (PinAux) {
+        FEXCore::CPUInfo::PinThisThreadToAuxiliaryCPUs();
+      }
+      int StatsSocket = FEXServerClient::ConnectToServer(FEXServerClient::ConnectionOption::NoPrintConnectionError);
+      if (StatsSocket == -1) {
+        return;
+      }
+
+      uint64_t Values[FEXCore::Statistics::STAT_LAST];
+      while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(Interval));
+        FEXCore::Statistics::SnapshotStats(Values, FEXCore::Statistics::STAT_LAST);
+        FEXServerClient::SendStatsUpdate(StatsSocket, Values, FEXCore::Statistics::STAT_LAST);
+      }
+    }).detach();
+  }
+
+  FEX_CONFIG_OPT(ProfileInterval, PROFILEINTERVAL);
+  if (ProfileInterval() > 0) {
+    FEX::SampleProfiler::Start(CTX.get(), SignalDelegation.get(), ProfileInterval());
+  }
+
+  FEX_CONFIG_OPT(FlightRecorderSampleInterval, FLIGHTRECORDERSAMPLEINTERVAL);
+  if (FlightRecorderSampleInterval() > 0) {
+    FEX::FlightRecordWatch::Start(SyscallHandler.get(), Program.ProgramName);
+  }
+
+  FEX_CONFIG_OPT(ConfigHotReload, CONFIGHOTRELOAD);
+  if (ConfigHotReload()) {
+    FEX::ConfigWatch::Start(CTX.get(), Program.ProgramName);
+  }
+
+  // Close out the startup timeline and write it before handing control to the
+  // guest. The first CompileBlock happens inside RunUntilExit, so guest-start
+  // marks the closest loader-visible point to the first guest instruction.
+  FEX::StartupTimeline::End();
+  FEX::StartupTimeline::Mark("guest-start");
+  FEX_CONFIG_OPT(StartupTraceFile, STARTUPTRACEFILE);
+  if (!StartupTraceFile().empty()) {
+    FEX::StartupTimeline::Write(StartupTraceFile());
+  }
+
   if (AOTIRGenerate()) {
     for(auto &Section: Loader.Sections) {
       FEX::AOT::AOTGenSection(CTX.get(), Section);
@@ -558,6 +1014,53 @@ int main(int argc, char **argv, char **const envp) {
     }
   }
 
+  if (PMUTuning()) {
+    // Reconcile this session into the parameter store, then persist it so the
+    // next launch starts from the best-known configuration.
+    const int32_t TunedBudget = CTX->GetTunedTraceBudget();
+    const int64_t Score = CTX->GetTunerSessionScore();
+
+    const bool Trialled = Tune.TrialLoopRange != -1 || Tune.TrialInlineLeaf != -1;
+    if (Score != -1) {
+      if (!Trialled || Tune.Score == -1 || Score < Tune.Score) {
+        // Adopt the trial when it beat the incumbent (or there was nothing to
+        // beat). When the incumbent itself ran, refresh its score so stale
+        // luck can't block future trials. A losing trial changes nothing.
+        if (Tune.TrialLoopRange != -1) {
+          Tune.LoopRange = Tune.TrialLoopRange;
+        }
+        if (Tune.TrialInlineLeaf != -1) {
+          Tune.InlineLeaf = Tune.TrialInlineLeaf;
+        }
+        Tune.Score = Score;
+      }
+    }
+
+    if (TunedBudget > 0) {
+      Tune.Budget = TunedBudget;
+    }
+
+    if (Tune.Budget > 0 &&
+        FHU::Filesystem::CreateDirectories(fextl::fmt::format("{}/aotir", FEXCore::Config::GetDataDirectory()))) {
+      const auto TuneFilepath = fextl::fmt::format("{}/aotir/{}.tune", FEXCore::Config::GetDataDirectory(), Program.ProgramName);
+      fextl::string Data = fextl::fmt::format("budget={}\n", Tune.Budget);
+      if (Tune.LoopRange != -1) {
+        Data += fextl::fmt::format("looprange={}\n", Tune.LoopRange);
+      }
+      if (Tune.InlineLeaf != -1) {
+        Data += fextl::fmt::format("inlineleaf={}\n", Tune.InlineLeaf);
+      }
+      if (Tune.Score != -1) {
+        Data += fextl::fmt::format("score={}\n", Tune.Score);
+      }
+      int fd = open(TuneFilepath.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+      if (fd != -1) {
+        write(fd, Data.c_str(), Data.size());
+        close(fd);
+      }
+    }
+  }
+
   auto ProgramStatus = ParentThread->StatusCode;
 
   CTX->DestroyThread(ParentThread);
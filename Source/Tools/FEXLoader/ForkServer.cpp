@@ -0,0 +1,605 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: Bin|FEXLoader
+desc: Resident fork server that hands out pre-initialized FEXLoader children
+$end_info$
+*/
+
+#include "ForkServer.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <cstring>
+#include <linux/limits.h>
+#include <optional>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <FEXHeaderUtils/Syscalls.h>
+
+namespace FEX::ForkServer {
+  // Cap on the trailing string blob of a launch request. Covers a PATH_MAX cwd
+  // plus any realistic argv while keeping a malformed length field from
+  // driving a huge allocation.
+  constexpr size_t MAX_STRINGS_LENGTH = 1024 * 1024;
+
+  static int ConnectToForkServer(const fextl::string &SocketName) {
+    int SocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (SocketFD == -1) {
+      LogMan::Msg::EFmt("Couldn't open AF_UNIX socket {} {}", errno, strerror(errno));
+      return -1;
+    }
+
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    size_t SizeOfSocketString = std::min(SocketName.size() + 1, sizeof(addr.sun_path) - 1);
+    addr.sun_path[0] = 0; // Abstract AF_UNIX sockets start with \0
+    strncpy(addr.sun_path + 1, SocketName.data(), SizeOfSocketString);
+    // Include final null character.
+    size_t SizeOfAddr = sizeof(addr.sun_family) + SizeOfSocketString;
+
+    if (connect(SocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr) == -1) {
+      // No server listening is the expected fallback path, stay quiet about it
+      close(SocketFD);
+      return -1;
+    }
+
+    return SocketFD;
+  }
+
+  static int CreateListenSocket(const fextl::string &SocketName) {
+    int SocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (SocketFD == -1) {
+      LogMan::Msg::EFmt("Couldn't create AF_UNIX socket: {} {}", errno, strerror(errno));
+      return -1;
+    }
+
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    size_t SizeOfSocketString = std::min(SocketName.size() + 1, sizeof(addr.sun_path) - 1);
+    addr.sun_path[0] = 0; // Abstract AF_UNIX sockets start with \0
+    strncpy(addr.sun_path + 1, SocketName.data(), SizeOfSocketString);
+    // Include final null character.
+    size_t SizeOfAddr = sizeof(addr.sun_family) + SizeOfSocketString;
+
+    int Result = bind(SocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr);
+    if (Result == -1) {
+      LogMan::Msg::EFmt("Couldn't bind AF_UNIX socket '{}': {} {}", SocketName, errno, strerror(errno));
+      close(SocketFD);
+      return -1;
+    }
+
+    listen(SocketFD, 16);
+    return SocketFD;
+  }
+
+  static bool RecvExact(int Socket, void *Data, size_t Size) {
+    size_t CurrentRead{};
+    while (CurrentRead < Size) {
+      ssize_t Result = recv(Socket, reinterpret_cast<char*>(Data) + CurrentRead, Size - CurrentRead, 0);
+      if (Result <= 0) {
+        return false;
+      }
+      CurrentRead += Result;
+    }
+    return true;
+  }
+
+  static void SendResultPacket(int Socket, const ForkServerResultPacket &Res) {
+    struct iovec iov {
+      .iov_base = const_cast<ForkServerResultPacket*>(&Res),
+      .iov_len = sizeof(Res),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    sendmsg(Socket, &msg, 0);
+  }
+
+  int LaunchThroughServer(const fextl::string &SocketName, const fextl::vector<fextl::string> &Args) {
+    if (Args.empty()) {
+      return -1;
+    }
+
+    int ServerSocket = ConnectToForkServer(SocketName);
+    if (ServerSocket == -1) {
+      return -1;
+    }
+
+    char CwdBuffer[PATH_MAX];
+    const char *Cwd = getcwd(CwdBuffer, sizeof(CwdBuffer));
+
+    fextl::string Strings = Cwd ? Cwd : "/";
+    Strings += '\0';
+    for (const auto &Arg : Args) {
+      Strings += Arg;
+      Strings += '\0';
+    }
+
+    ForkServerRequestPacket Req {
+      .Launch {
+        .Header {
+          .Type = PacketType::TYPE_LAUNCH,
+        },
+        .NumArgs = static_cast<uint32_t>(Args.size()),
+        .StringsLength = Strings.size(),
+      },
+    };
+
+    iovec iov[2] {
+      {
+        .iov_base = &Req,
+        .iov_len = sizeof(Req),
+      },
+      {
+        .iov_base = Strings.data(),
+        .iov_len = Strings.size(),
+      },
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = iov,
+      .msg_iovlen = 2,
+    };
+
+    // Hand the server our stdio so the forked child talks to our terminal and
+    // pipes directly instead of relaying through this process.
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int) * 3);
+    union AncillaryBuffer {
+      struct cmsghdr Header;
+      uint8_t Buffer[CMSG_SIZE];
+    };
+    AncillaryBuffer AncBuf{};
+
+    msg.msg_control = AncBuf.Buffer;
+    msg.msg_controllen = CMSG_SIZE;
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * 3);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+
+    const int StdioFDs[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    memcpy(CMSG_DATA(cmsg), StdioFDs, sizeof(StdioFDs));
+
+    if (sendmsg(ServerSocket, &msg, 0) == -1) {
+      close(ServerSocket);
+      return -1;
+    }
+
+    ForkServerResultPacket Res{};
+    if (!RecvExact(ServerSocket, &Res, sizeof(Res)) ||
+        Res.Header.Type != PacketType::TYPE_PID) {
+      // The server turned the request down before forking anything, launching
+      // the program ourselves is still safe.
+      close(ServerSocket);
+      return -1;
+    }
+
+    const int32_t ChildPID = Res.PID.PID;
+
+    // The child is running from here on. Errors must not fall back to a local
+    // launch any more, that would run the program twice.
+    if (!RecvExact(ServerSocket, &Res, sizeof(Res)) ||
+        Res.Header.Type != PacketType::TYPE_EXIT) {
+      LogMan::Msg::EFmt("ForkServer: Lost connection while waiting for child {} to exit", ChildPID);
+      close(ServerSocket);
+      return 255;
+    }
+
+    close(ServerSocket);
+
+    if (WIFEXITED(Res.Exit.Status)) {
+      return WEXITSTATUS(Res.Exit.Status);
+    }
+    else if (WIFSIGNALED(Res.Exit.Status)) {
+      // Match the shell convention for children that died to a signal
+      return 128 + WTERMSIG(Res.Exit.Status);
+    }
+
+    return 255;
+  }
+
+  namespace {
+    // A forked child the server is still waiting on
+    struct PendingChild {
+      pid_t PID;
+      int PidFD;
+      // Connection that requested the launch, -1 once the client hung up
+      int ClientFD;
+    };
+
+    // Result of servicing one message on a client connection
+    struct RequestResult {
+      bool CloseConnection{};
+      bool Shutdown{};
+      // Set in the forked child, the caller unwinds back to the startup path
+      std::optional<LaunchRequest> Launch{};
+      // Set in the parent when a child was forked and needs reaping
+      std::optional<PendingChild> Child{};
+    };
+  }
+
+  static RequestResult HandleSocketData(int Socket, int ListenSocket, const fextl::vector<int> &ClientFDs,
+                                        const fextl::vector<PendingChild> &Children) {
+    RequestResult Result{};
+
+    fextl::vector<char> Data(4096);
+
+    struct iovec iov {
+      .iov_base = Data.data(),
+      .iov_len = Data.size(),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    // Launch requests carry the client's three stdio FDs
+    constexpr size_t CMSG_SIZE = CMSG_SPACE(sizeof(int) * 3);
+    union AncillaryBuffer {
+      struct cmsghdr Header;
+      uint8_t Buffer[CMSG_SIZE];
+    };
+    AncillaryBuffer AncBuf{};
+
+    msg.msg_control = AncBuf.Buffer;
+    msg.msg_controllen = CMSG_SIZE;
+
+    ssize_t Read = recvmsg(Socket, &msg, 0);
+    if (Read <= 0) {
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    int StdioFDs[3] = {-1, -1, -1};
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != nullptr &&
+        cmsg->cmsg_len == CMSG_LEN(sizeof(int) * 3) &&
+        cmsg->cmsg_level == SOL_SOCKET &&
+        cmsg->cmsg_type == SCM_RIGHTS) {
+      memcpy(StdioFDs, CMSG_DATA(cmsg), sizeof(StdioFDs));
+    }
+
+    auto CloseStdioFDs = [&StdioFDs]() {
+      for (int FD : StdioFDs) {
+        if (FD != -1) {
+          close(FD);
+        }
+      }
+    };
+
+    auto *Req = reinterpret_cast<ForkServerRequestPacket*>(Data.data());
+    if (Read < sizeof(Req->Header)) {
+      CloseStdioFDs();
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    if (Req->Header.Type == PacketType::TYPE_SHUTDOWN) {
+      CloseStdioFDs();
+      Result.Shutdown = true;
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    if (Req->Header.Type != PacketType::TYPE_LAUNCH ||
+        Read < sizeof(Req->Launch)) {
+      CloseStdioFDs();
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    const uint32_t NumArgs = Req->Launch.NumArgs;
+    const size_t StringsLength = Req->Launch.StringsLength;
+    const size_t TotalLength = sizeof(ForkServerRequestPacket) + StringsLength;
+
+    if (NumArgs == 0 ||
+        StringsLength > MAX_STRINGS_LENGTH ||
+        StdioFDs[0] == -1 || StdioFDs[1] == -1 || StdioFDs[2] == -1) {
+      LogMan::Msg::EFmt("ForkServer: Malformed launch request");
+      CloseStdioFDs();
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    // Pull in the rest of the string blob if the first read was short
+    if (static_cast<size_t>(Read) < TotalLength) {
+      Data.resize(TotalLength);
+      Req = reinterpret_cast<ForkServerRequestPacket*>(Data.data());
+      if (!RecvExact(Socket, Data.data() + Read, TotalLength - Read)) {
+        CloseStdioFDs();
+        Result.CloseConnection = true;
+        return Result;
+      }
+    }
+
+    // Walk the null terminated strings: cwd first, then the argv
+    const char *Cursor = Data.data() + sizeof(ForkServerRequestPacket);
+    const char *End = Cursor + StringsLength;
+
+    auto NextString = [&Cursor, End]() -> std::optional<fextl::string> {
+      const char *Terminator = static_cast<const char*>(memchr(Cursor, 0, End - Cursor));
+      if (Terminator == nullptr) {
+        return std::nullopt;
+      }
+      fextl::string String{Cursor, Terminator};
+      Cursor = Terminator + 1;
+      return String;
+    };
+
+    LaunchRequest Launch{};
+    auto Cwd = NextString();
+    if (!Cwd) {
+      LogMan::Msg::EFmt("ForkServer: Malformed launch request");
+      CloseStdioFDs();
+      Result.CloseConnection = true;
+      return Result;
+    }
+    Launch.Cwd = std::move(*Cwd);
+
+    for (uint32_t i = 0; i < NumArgs; ++i) {
+      auto Arg = NextString();
+      if (!Arg) {
+        LogMan::Msg::EFmt("ForkServer: Malformed launch request");
+        CloseStdioFDs();
+        Result.CloseConnection = true;
+        return Result;
+      }
+      Launch.Args.push_back(std::move(*Arg));
+    }
+
+    pid_t PID = fork();
+    if (PID == 0) {
+      // Forked child. Sever every tie to the server before continuing, the
+      // only descriptors this process keeps are the client's stdio.
+      close(ListenSocket);
+      close(Socket);
+      for (int FD : ClientFDs) {
+        if (FD != Socket) {
+          close(FD);
+        }
+      }
+      for (const auto &Child : Children) {
+        close(Child.PidFD);
+        if (Child.ClientFD != -1) {
+          close(Child.ClientFD);
+        }
+      }
+
+      // Adopt the client's stdio and working directory
+      for (int i = 0; i < 3; ++i) {
+        if (StdioFDs[i] != i) {
+          dup2(StdioFDs[i], i);
+          close(StdioFDs[i]);
+        }
+      }
+
+      if (chdir(Launch.Cwd.c_str()) == -1) {
+        LogMan::Msg::EFmt("ForkServer: Couldn't change to '{}': {} {}", Launch.Cwd, errno, strerror(errno));
+      }
+
+      Result.Launch = std::move(Launch);
+      return Result;
+    }
+
+    // Parent. The child owns the client's stdio now.
+    CloseStdioFDs();
+
+    if (PID == -1) {
+      LogMan::Msg::EFmt("ForkServer: fork failed: {} {}", errno, strerror(errno));
+      SendResultPacket(Socket, ForkServerResultPacket {
+        .Header {
+          .Type = PacketType::TYPE_ERROR,
+        },
+      });
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    SendResultPacket(Socket, ForkServerResultPacket {
+      .PID {
+        .Header {
+          .Type = PacketType::TYPE_PID,
+        },
+        .PID = PID,
+      },
+    });
+
+    int PidFD = FHU::Syscalls::pidfd_open(PID, 0);
+    if (PidFD == -1) {
+      // pidfd_open needs a 5.3+ kernel. Reap synchronously as a fallback,
+      // serializing launches rather than leaking the child.
+      int Status{};
+      waitpid(PID, &Status, 0);
+      SendResultPacket(Socket, ForkServerResultPacket {
+        .Exit {
+          .Header {
+            .Type = PacketType::TYPE_EXIT,
+          },
+          .Status = Status,
+        },
+      });
+      Result.CloseConnection = true;
+      return Result;
+    }
+
+    Result.Child = PendingChild {
+      .PID = PID,
+      .PidFD = PidFD,
+      .ClientFD = Socket,
+    };
+    return Result;
+  }
+
+  std::optional<LaunchRequest> Serve(const fextl::string &SocketName) {
+    int ListenSocket = CreateListenSocket(SocketName);
+    if (ListenSocket == -1) {
+      return std::nullopt;
+    }
+
+    // Connections that haven't requested a launch yet
+    fextl::vector<int> ClientFDs{};
+    // Forked children still running
+    fextl::vector<PendingChild> Children{};
+    bool ShouldShutdown{};
+
+    // The poll set is rebuilt every iteration. Launches mutate several lists
+    // at once and the set stays small, so rebuilding is simpler than editing
+    // it in place.
+    while (!ShouldShutdown || !Children.empty()) {
+      std::vector<struct pollfd> PollFDs{};
+      if (!ShouldShutdown) {
+        PollFDs.emplace_back(pollfd {
+          .fd = ListenSocket,
+          .events = POLLIN,
+          .revents = 0,
+        });
+      }
+      for (int FD : ClientFDs) {
+        PollFDs.emplace_back(pollfd {
+          .fd = FD,
+          .events = POLLIN | POLLPRI | POLLRDHUP,
+          .revents = 0,
+        });
+      }
+      for (const auto &Child : Children) {
+        PollFDs.emplace_back(pollfd {
+          .fd = Child.PidFD,
+          .events = POLLIN,
+          .revents = 0,
+        });
+        if (Child.ClientFD != -1) {
+          // Only watch for the client dropping, exit results are pushed when
+          // the pidfd fires
+          PollFDs.emplace_back(pollfd {
+            .fd = Child.ClientFD,
+            .events = POLLRDHUP,
+            .revents = 0,
+          });
+        }
+      }
+
+      int Result = ppoll(&PollFDs.at(0), PollFDs.size(), nullptr, nullptr);
+      if (Result <= 0) {
+        continue;
+      }
+
+      for (auto &Event : PollFDs) {
+        if (Event.revents == 0) {
+          continue;
+        }
+
+        if (Event.fd == ListenSocket) {
+          if (Event.revents & POLLIN) {
+            struct sockaddr_storage Addr{};
+            socklen_t AddrSize{};
+            int NewFD = accept(ListenSocket, reinterpret_cast<struct sockaddr*>(&Addr), &AddrSize);
+            if (NewFD != -1) {
+              ClientFDs.push_back(NewFD);
+            }
+          }
+          else if (Event.revents & (POLLHUP | POLLERR | POLLNVAL)) {
+            // Listen socket died, drain the children and leave
+            ShouldShutdown = true;
+          }
+          continue;
+        }
+
+        // A child exiting?
+        auto ChildIt = std::find_if(Children.begin(), Children.end(), [&Event](const PendingChild &Child) {
+          return Child.PidFD == Event.fd;
+        });
+        if (ChildIt != Children.end()) {
+          int Status{};
+          waitpid(ChildIt->PID, &Status, 0);
+          close(ChildIt->PidFD);
+          if (ChildIt->ClientFD != -1) {
+            SendResultPacket(ChildIt->ClientFD, ForkServerResultPacket {
+              .Exit {
+                .Header {
+                  .Type = PacketType::TYPE_EXIT,
+                },
+                .Status = Status,
+              },
+            });
+            close(ChildIt->ClientFD);
+          }
+          Children.erase(ChildIt);
+          continue;
+        }
+
+        // A waiting client dropping while its child still runs?
+        ChildIt = std::find_if(Children.begin(), Children.end(), [&Event](const PendingChild &Child) {
+          return Child.ClientFD == Event.fd;
+        });
+        if (ChildIt != Children.end()) {
+          if (Event.revents & (POLLHUP | POLLERR | POLLNVAL | POLLRDHUP)) {
+            // Nobody is listening for the result any more. Pass the hangup on
+            // to the child and keep waiting on the pidfd to reap it.
+            kill(ChildIt->PID, SIGHUP);
+            close(ChildIt->ClientFD);
+            ChildIt->ClientFD = -1;
+          }
+          continue;
+        }
+
+        // A connection without a child yet
+        auto ClientIt = std::find(ClientFDs.begin(), ClientFDs.end(), Event.fd);
+        if (ClientIt == ClientFDs.end()) {
+          continue;
+        }
+
+        bool Erase{};
+        if (Event.revents & POLLIN) {
+          auto Request = HandleSocketData(Event.fd, ListenSocket, ClientFDs, Children);
+          if (Request.Launch) {
+            // We are the forked child, unwind back to the startup path
+            return std::move(Request.Launch);
+          }
+          if (Request.Child) {
+            // The connection now belongs to the child's bookkeeping
+            Children.push_back(*Request.Child);
+            ClientFDs.erase(ClientIt);
+            continue;
+          }
+          ShouldShutdown |= Request.Shutdown;
+          Erase = Request.CloseConnection;
+        }
+
+        if (!Erase &&
+            (Event.revents & (POLLHUP | POLLERR | POLLNVAL | POLLRDHUP))) {
+          Erase = true;
+        }
+
+        if (Erase) {
+          close(Event.fd);
+          ClientFDs.erase(ClientIt);
+        }
+      }
+    }
+
+    close(ListenSocket);
+    return std::nullopt;
+  }
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <optional>
+
+namespace FEX::ForkServer {
+  enum class PacketType : uint32_t {
+    // Request, carries the guest argv plus the client's stdio FDs
+    TYPE_LAUNCH,
+
+    // Request only, no result
+    TYPE_SHUTDOWN,
+
+    // Results
+    TYPE_PID,
+    TYPE_EXIT,
+    TYPE_ERROR,
+  };
+
+  union ForkServerRequestPacket {
+    struct Header {
+      PacketType Type;
+    } Header;
+
+    struct {
+      struct Header Header;
+      uint32_t NumArgs;
+      // Length of the null terminated working directory followed by NumArgs
+      // null terminated argument strings trailing the packet
+      size_t StringsLength;
+      char Strings[0];
+    } Launch;
+  };
+
+  union ForkServerResultPacket {
+    struct Header {
+      PacketType Type;
+    } Header;
+
+    struct {
+      struct Header Header;
+      int32_t PID;
+    } PID;
+
+    struct {
+      struct Header Header;
+      // Raw wait status of the child as returned by waitpid
+      int32_t Status;
+    } Exit;
+  };
+
+  struct LaunchRequest {
+    fextl::string Cwd;
+    fextl::vector<fextl::string> Args;
+  };
+
+  /**
+   * @brief Relay a program launch through a resident fork server
+   *
+   * Hands the server our working directory, guest argv and stdio FDs, then
+   * blocks until the forked child exits.
+   *
+   * @param SocketName - Abstract socket name the server is listening on
+   * @param Args - Guest argv, Args[0] being the program to launch
+   *
+   * @return The child's translated exit status, or -1 when no server is
+   * listening and the caller should launch the program itself
+   */
+  int LaunchThroughServer(const fextl::string &SocketName, const fextl::vector<fextl::string> &Args);
+
+  /**
+   * @brief Serve launch requests as a resident fork server
+   *
+   * Listens on the abstract socket and forks one child per launch request.
+   * Must be called before any threads are spawned, the children only
+   * inherit the calling thread.
+   *
+   * In the parent this only returns once the server is shutting down. In each
+   * forked child it returns the launch request after adopting the client's
+   * working directory and stdio, so the caller can continue the regular
+   * startup path with the requested program.
+   *
+   * @param SocketName - Abstract socket name to listen on
+   *
+   * @return The launch request in a forked child, nullopt in the parent
+   */
+  std::optional<LaunchRequest> Serve(const fextl::string &SocketName);
+}
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: Bin|FEXLoader
+desc: SIGPROF flat profiler pushing symbolized guest hotspots to FEXServer
+$end_info$
+*/
+
+#include "SampleProfiler.h"
+#include "Common/FEXServerClient.h"
+#include "LinuxSyscalls/SignalDelegator.h"
+#include "ArchHelpers/MContext.h"
+
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <signal.h>
+#include <sys/time.h>
+#include <thread>
+
+namespace FEX::SampleProfiler {
+  namespace {
+    // Open-addressed table of guest RIP hit counters. Fixed size and built
+    // from atomics so the SIGPROF handler can bump counts from any thread
+    // without taking locks or allocating.
+    constexpr size_t TABLE_SIZE = 4096;
+    constexpr size_t MAX_PROBES = 16;
+
+    struct SampleSlot {
+      std::atomic<uint64_t> RIP;
+      std::atomic<uint64_t> Count;
+    };
+    std::array<SampleSlot, TABLE_SIZE> SampleTable{};
+
+    // Hottest locations pushed per round. Keeps the packet small and bounds
+    // the label cardinality on the server's metrics endpoint.
+    constexpr size_t PUSH_TOP_N = 32;
+
+    void RecordSample(uint64_t RIP) {
+      size_t Bucket = (RIP * 0x9E37'79B9'7F4A'7C15ULL) >> 52;
+      for (size_t Probe = 0; Probe < MAX_PROBES; ++Probe) {
+        auto &Slot = SampleTable[(Bucket + Probe) % TABLE_SIZE];
+        uint64_t Expected = Slot.RIP.load(std::memory_order_relaxed);
+        if (Expected == 0) {
+          // Claim the empty slot, losing the race just means another thread
+          // claimed it for some RIP first.
+          Slot.RIP.compare_exchange_strong(Expected, RIP, std::memory_order_relaxed);
+        }
+        if (Expected == 0 || Expected == RIP) {
+          if (Slot.RIP.load(std::memory_order_relaxed) == RIP) {
+            Slot.Count.fetch_add(1, std::memory_order_relaxed);
+            return;
+          }
+        }
+      }
+      // Probed a full neighbourhood, drop the sample. A flat profile only
+      // cares about the hot locations and those claimed slots early.
+    }
+
+    struct MapEntry {
+      uint64_t Begin;
+      uint64_t End;
+      uint64_t FileOffset;
+      fextl::string Name;
+    };
+
+    // Snapshot the file-backed mappings of our own address space. Guest
+    // addresses are host addresses under FEX, so a guest RIP resolves against
+    // the guest binaries the loader and guest mmaped in to this process.
+    fextl::vector<MapEntry> LoadMemoryMap() {
+      fextl::vector<MapEntry> Entries{};
+
+      fextl::string MapsFile;
+      if (!FEXCore::FileLoading::LoadFile(MapsFile, "/proc/self/maps")) {
+        return Entries;
+      }
+
+      size_t LineBegin = 0;
+      while (LineBegin < MapsFile.size()) {
+        size_t LineEnd = MapsFile.find('\n', LineBegin);
+        if (LineEnd == fextl::string::npos) {
+          LineEnd = MapsFile.size();
+        }
+
+        uint64_t Begin{}, End{}, FileOffset{};
+        char Perms[5]{};
+        int PathOffset{};
+        if (sscanf(MapsFile.c_str() + LineBegin, "%lx-%lx %4s %lx %*s %*s %n",
+                   &Begin, &End, Perms, &FileOffset, &PathOffset) == 4 &&
+            Perms[2] == 'x' && PathOffset != 0) {
+          size_t PathBegin = LineBegin + PathOffset;
+          if (PathBegin < LineEnd && MapsFile[PathBegin] != '[') {
+            // Strip to the basename, full rootfs paths don't fit the location
+            // strings and the module name plus offset is enough for addr2line.
+            fextl::string Path = MapsFile.substr(PathBegin, LineEnd - PathBegin);
+            size_t Slash = Path.rfind('/');
+            Entries.emplace_back(MapEntry {
+              .Begin = Begin,
+              .End = End,
+              .FileOffset = FileOffset,
+              .Name = Slash == fextl::string::npos ? Path : Path.substr(Slash + 1),
+            });
+          }
+        }
+
+        LineBegin = LineEnd + 1;
+      }
+
+      return Entries;
+    }
+
+    void Symbolize(const fextl::vector<MapEntry> &Map, uint64_t RIP, char (&Location)[56]) {
+      for (auto &Entry : Map) {
+        if (RIP >= Entry.Begin && RIP < Entry.End) {
+          const auto Symbolized = fextl::fmt::format("{}+0x{:x}", Entry.Name, RIP - Entry.Begin + Entry.FileOffset);
+          strncpy(Location, Symbolized.c_str(), sizeof(Location) - 1);
+          Location[sizeof(Location) - 1] = '\0';
+          return;
+        }
+      }
+
+      // JIT-generated or since-unmapped guest code, keep the raw address.
+      snprintf(Location, sizeof(Location), "anon+0x%lx", RIP);
+    }
+
+    void PushLoop() {
+      int ProfileSocket = FEXServerClient::ConnectToServer(FEXServerClient::ConnectionOption::NoPrintConnectionError);
+      if (ProfileSocket == -1) {
+        return;
+      }
+
+      while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(5));
+
+        // Snapshot the live counters. Counts are cumulative, matching the
+        // counter semantics of the server's metrics endpoint.
+        fextl::vector<std::pair<uint64_t, uint64_t>> Samples{};
+        for (auto &Slot : SampleTable) {
+          const uint64_t RIP = Slot.RIP.load(std::memory_order_relaxed);
+          const uint64_t Count = Slot.Count.load(std::memory_order_relaxed);
+          if (RIP != 0 && Count != 0) {
+            Samples.emplace_back(Count, RIP);
+          }
+        }
+
+        if (Samples.empty()) {
+          continue;
+        }
+
+        const size_t NumEntries = std::min(Samples.size(), PUSH_TOP_N);
+        std::partial_sort(Samples.begin(), Samples.begin() + NumEntries, Samples.end(),
+                          std::greater<>{});
+
+        const auto Map = LoadMemoryMap();
+        fextl::vector<FEXServerClient::ProfileSampleEntry> Entries(NumEntries);
+        for (size_t i = 0; i < NumEntries; ++i) {
+          Entries[i].Count = Samples[i].first;
+          Symbolize(Map, Samples[i].second, Entries[i].Location);
+        }
+
+        FEXServerClient::SendProfileUpdate(ProfileSocket, Entries.data(), NumEntries);
+      }
+    }
+  }
+
+  void Start(FEXCore::Context::Context *CTX, FEX::HLE::SignalDelegator *SignalDelegation, int32_t IntervalMS) {
+    SignalDelegation->RegisterHostSignalHandler(SIGPROF, [CTX](FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) -> bool {
+      if (Thread) {
+        // Inside a JIT block this walks the block's RIP reconstruction
+        // entries, everywhere else it falls back to the thread's stored RIP.
+        // Either way it is signal safe.
+        RecordSample(CTX->RestoreRIPFromHostPC(Thread, ArchHelpers::Context::GetPc(ucontext)));
+      }
+      return true;
+    }, true);
+
+    std::thread(PushLoop).detach();
+
+    // CPU-time timer so idle guests don't accumulate samples in whatever
+    // thread happens to receive the signal.
+    const struct timeval Period {
+      .tv_sec = IntervalMS / 1000,
+      .tv_usec = static_cast<suseconds_t>((IntervalMS % 1000) * 1000),
+    };
+    struct itimerval Timer {
+      .it_interval = Period,
+      .it_value = Period,
+    };
+    setitimer(ITIMER_PROF, &Timer, nullptr);
+  }
+}
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstdint>
+
+namespace FEXCore::Context {
+  class Context;
+}
+
+namespace FEX::HLE {
+  class SignalDelegator;
+}
+
+namespace FEX::SampleProfiler {
+  /**
+   * @brief Start sampling the guest RIP on a SIGPROF CPU-time timer
+   *
+   * Samples aggregate in to a lock-free flat profile and a background thread
+   * periodically pushes the hottest locations to FEXServer, symbolized as
+   * guest module+offset, where they are served alongside the runtime
+   * statistics.
+   *
+   * Claims ITIMER_PROF for the whole process, so this conflicts with guest
+   * applications that profile themselves through the same timer.
+   *
+   * @param CTX - Context to reconstruct guest RIPs against
+   * @param SignalDelegation - Delegator to register the SIGPROF handler with
+   * @param IntervalMS - Sampling period in milliseconds of consumed CPU time
+   */
+  void Start(FEXCore::Context::Context *CTX, FEX::HLE::SignalDelegator *SignalDelegation, int32_t IntervalMS);
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: MIT
+#include "StartupTimeline.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace FEX::StartupTimeline {
+namespace {
+  struct Event {
+    // Phase names are string literals from the call sites, never owned
+    const char *Name;
+    uint64_t BeginNS;
+    // Equal to BeginNS for instantaneous events
+    uint64_t EndNS;
+  };
+
+  // Static storage: the first phase begins before the allocator hooks are
+  // configured, recording must not allocate.
+  constexpr size_t MAX_EVENTS = 32;
+  Event Events[MAX_EVENTS];
+  size_t NumEvents{};
+  Event *OpenEvent{};
+
+  uint64_t Now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000ULL + ts.tv_nsec;
+  }
+}
+
+void Begin(const char *Name) {
+  const uint64_t Time = Now();
+  if (OpenEvent) {
+    OpenEvent->EndNS = Time;
+    OpenEvent = nullptr;
+  }
+
+  if (NumEvents == MAX_EVENTS) {
+    return;
+  }
+
+  Events[NumEvents] = { Name, Time, Time };
+  OpenEvent = &Events[NumEvents];
+  ++NumEvents;
+}
+
+void End() {
+  if (OpenEvent) {
+    OpenEvent->EndNS = Now();
+    OpenEvent = nullptr;
+  }
+}
+
+void Mark(const char *Name) {
+  if (NumEvents == MAX_EVENTS) {
+    return;
+  }
+
+  const uint64_t Time = Now();
+  Events[NumEvents] = { Name, Time, Time };
+  ++NumEvents;
+}
+
+void Write(const fextl::string &Path) {
+  End();
+
+  // Chrome trace-event JSON. Timestamps are absolute CLOCK_MONOTONIC
+  // microseconds so traces from multiple processes of one launch line up.
+  fextl::string Json = "{\"traceEvents\":[";
+  const uint32_t PID = ::getpid();
+  for (size_t i = 0; i < NumEvents; ++i) {
+    const auto &Event = Events[i];
+    if (i != 0) {
+      Json += ",";
+    }
+
+    if (Event.EndNS == Event.BeginNS) {
+      Json += fextl::fmt::format(
+        "{{\"name\":\"{}\",\"ph\":\"i\",\"s\":\"p\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}}",
+        Event.Name, Event.BeginNS / 1000.0, PID, PID);
+    }
+    else {
+      Json += fextl::fmt::format(
+        "{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{}}}",
+        Event.Name, Event.BeginNS / 1000.0, (Event.EndNS - Event.BeginNS) / 1000.0, PID, PID);
+    }
+  }
+  Json += "]}\n";
+
+  const int FD = ::open(Path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (FD == -1) {
+    LogMan::Msg::EFmt("Couldn't write startup timeline to '{}'", Path);
+    return;
+  }
+
+  const bool Success = ::write(FD, Json.c_str(), Json.size()) == static_cast<ssize_t>(Json.size());
+  ::close(FD);
+
+  if (Success) {
+    LogMan::Msg::IFmt("Startup timeline written to '{}'", Path);
+  }
+}
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: Bin|FEXLoader
+desc: Records FEXLoader's startup phases for startup-time regression chasing
+$end_info$
+*/
+#pragma once
+
+#include <FEXCore/fextl/string.h>
+
+namespace FEX::StartupTimeline {
+  // Begins a named startup phase, ending the currently open phase first.
+  // Phases are recorded unconditionally: recording is two clock reads in to
+  // static storage, the cost only exists when a trace file is requested.
+  void Begin(const char *Name);
+
+  // Ends the currently open phase without starting a new one.
+  void End();
+
+  // Records an instantaneous event.
+  void Mark(const char *Name);
+
+  // Writes everything recorded so far as Chrome trace-event JSON.
+  // Loadable directly in chrome://tracing or Perfetto.
+  void Write(const fextl::string &Path);
+}
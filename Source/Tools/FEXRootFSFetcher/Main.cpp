@@ -14,10 +14,13 @@
 #include <unistd.h>
 #include <optional>
 #include <sstream>
+#include <algorithm>
+#include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/syscall.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#include <xxhash.h>
 
 #include <tiny-json.h>
 
@@ -636,6 +639,349 @@ namespace WebFileFetcher {
   }
 }
 
+namespace DeltaFetcher {
+  // Chunk manifest published next to an image as `<image URL>.chunks`.
+  // Lists the image size, the chunk granularity and one XXH3 hash per chunk,
+  // letting a client with an older image only fetch the chunks that changed.
+  // Hosting the manifest is optional, clients fall back to a full download.
+  //
+  // {
+  //   "v1": {
+  //     "Size": "<total image bytes, decimal>",
+  //     "ChunkSize": "<chunk bytes, decimal>",
+  //     "Chunks": [ "<xxh3 hex>", ... ]
+  //   }
+  // }
+  struct ChunkManifest {
+    uint64_t Size;
+    uint64_t ChunkSize;
+    std::vector<uint64_t> Chunks;
+  };
+
+  // How many ranged curl processes are kept in flight at once.
+  constexpr static size_t MAX_PARALLEL_FETCHES = 4;
+
+  // Sanity bounds on the manifest's chunk granularity.
+  constexpr static uint64_t MIN_CHUNK_SIZE = 64 * 1024;
+  constexpr static uint64_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+
+  std::optional<ChunkManifest> FetchManifest(const fextl::string &URL) {
+    std::string Data = WebFileFetcher::DownloadToString(std::string(URL) + ".chunks");
+    if (Data.empty()) {
+      return std::nullopt;
+    }
+
+    WebFileFetcher::JsonAllocator Pool {
+      .PoolObject = {
+        .init = WebFileFetcher::PoolInit,
+        .alloc = WebFileFetcher::PoolAlloc,
+      },
+    };
+
+    json_t const *json = json_createWithPool(&Data.at(0), &Pool.PoolObject);
+    if (!json) {
+      return std::nullopt;
+    }
+
+    json_t const *Root = json_getProperty(json, "v1");
+    if (!Root) {
+      return std::nullopt;
+    }
+
+    ChunkManifest Manifest{};
+    for (json_t const* DataItem = json_getChild(Root);
+      DataItem != nullptr;
+      DataItem = json_getSibling(DataItem)) {
+      auto DataName = std::string_view {json_getName(DataItem)};
+
+      if (DataName == "Size") {
+        Manifest.Size = std::stoull(json_getValue(DataItem));
+      }
+      else if (DataName == "ChunkSize") {
+        Manifest.ChunkSize = std::stoull(json_getValue(DataItem));
+      }
+      else if (DataName == "Chunks") {
+        for (json_t const* Chunk = json_getChild(DataItem);
+          Chunk != nullptr;
+          Chunk = json_getSibling(Chunk)) {
+          Manifest.Chunks.emplace_back(std::stoull(json_getValue(Chunk), nullptr, 16));
+        }
+      }
+    }
+
+    // Reject nonsense manifests rather than reconstructing garbage.
+    if (Manifest.Size == 0 ||
+        Manifest.ChunkSize < MIN_CHUNK_SIZE ||
+        Manifest.ChunkSize > MAX_CHUNK_SIZE ||
+        Manifest.Chunks.size() != (Manifest.Size + Manifest.ChunkSize - 1) / Manifest.ChunkSize) {
+      return std::nullopt;
+    }
+
+    return Manifest;
+  }
+
+  // Picks the image to reuse chunks from. Prefers the download destination
+  // itself, otherwise the largest image of the same type in the RootFS folder,
+  // which shares most blocks with any other version of the same distro.
+  fextl::string FindSeedImage(const fextl::string &PathName) {
+    std::error_code ec;
+    if (std::filesystem::exists(PathName, ec)) {
+      return PathName;
+    }
+
+    const auto Extension = std::filesystem::path(PathName.c_str()).extension();
+    const auto Folder = std::filesystem::path(PathName.c_str()).parent_path();
+
+    fextl::string Seed{};
+    uintmax_t SeedSize{};
+    for (const auto &Entry : std::filesystem::directory_iterator(Folder, ec)) {
+      if (!Entry.is_regular_file(ec) || Entry.path().extension() != Extension) {
+        continue;
+      }
+      const auto Size = Entry.file_size(ec);
+      if (Size > SeedSize) {
+        SeedSize = Size;
+        Seed = Entry.path().string().c_str();
+      }
+    }
+    return Seed;
+  }
+
+  struct ChunkFetch {
+    pid_t PID;
+    uint64_t Index;
+    fextl::string Path;
+  };
+
+  pid_t SpawnRangedFetch(const fextl::string &URL, const fextl::string &ChunkPath, uint64_t Begin, uint64_t End) {
+    // curl's range header is inclusive on both ends.
+    fextl::string Range = fextl::fmt::format("{}-{}", Begin, End - 1);
+    std::vector<const char*> ExecveArgs = {
+      "curl",
+      "-fs",
+      "-r",
+      Range.c_str(),
+      URL.c_str(),
+      "-o",
+      ChunkPath.c_str(),
+      nullptr,
+    };
+
+    pid_t pid = fork();
+    if (pid == 0) {
+      execvp(ExecveArgs[0], const_cast<char* const*>(ExecveArgs.data()));
+      _exit(-1);
+    }
+    return pid;
+  }
+
+  // Fetches the listed chunks through a pool of ranged curl downloads and
+  // writes each verified chunk in to the image at DestFD.
+  bool FetchChunks(const WebFileFetcher::FileTargets &Target, const ChunkManifest &Manifest,
+                   const std::vector<uint64_t> &Needed, const fextl::string &PathName, int DestFD) {
+    std::vector<ChunkFetch> InFlight;
+    std::vector<char> Data(Manifest.ChunkSize);
+    size_t NextChunk{};
+    size_t Completed{};
+    bool Failed{};
+
+    auto ChunkBounds = [&Manifest](uint64_t Index) -> std::pair<uint64_t, uint64_t> {
+      const uint64_t Begin = Index * Manifest.ChunkSize;
+      return {Begin, std::min(Begin + Manifest.ChunkSize, Manifest.Size)};
+    };
+
+    auto CleanupInFlight = [&InFlight]() {
+      for (auto &Fetch : InFlight) {
+        int32_t Status{};
+        while (waitpid(Fetch.PID, &Status, 0) == -1 && errno == EINTR);
+        unlink(Fetch.Path.c_str());
+      }
+      InFlight.clear();
+    };
+
+    while ((NextChunk < Needed.size() || !InFlight.empty()) && !Failed) {
+      // Keep the pool saturated.
+      while (NextChunk < Needed.size() && InFlight.size() < MAX_PARALLEL_FETCHES) {
+        const uint64_t Index = Needed[NextChunk++];
+        const auto [Begin, End] = ChunkBounds(Index);
+        fextl::string ChunkPath = fextl::fmt::format("{}.chunk.{}", PathName, Index);
+        const pid_t PID = SpawnRangedFetch(Target.URL, ChunkPath, Begin, End);
+        if (PID == -1) {
+          Failed = true;
+          break;
+        }
+        InFlight.emplace_back(ChunkFetch { .PID = PID, .Index = Index, .Path = std::move(ChunkPath) });
+      }
+
+      if (InFlight.empty()) {
+        break;
+      }
+
+      // Reap any finished fetch, verify its data and splice it in place.
+      int32_t Status{};
+      pid_t PID{};
+      while ((PID = waitpid(-1, &Status, 0)) == -1 && errno == EINTR);
+
+      auto Fetch = std::find_if(InFlight.begin(), InFlight.end(), [PID](const auto &Entry) { return Entry.PID == PID; });
+      if (Fetch == InFlight.end()) {
+        continue;
+      }
+
+      const auto [Begin, End] = ChunkBounds(Fetch->Index);
+      const uint64_t ChunkLength = End - Begin;
+
+      bool ChunkGood = WIFEXITED(Status) && WEXITSTATUS(Status) == 0;
+      if (ChunkGood) {
+        int ChunkFD = open(Fetch->Path.c_str(), O_RDONLY);
+        ChunkGood = ChunkFD != -1;
+        if (ChunkGood) {
+          uint64_t Read{};
+          while (Read < ChunkLength) {
+            ssize_t Result = pread(ChunkFD, Data.data() + Read, ChunkLength - Read, Read);
+            if (Result <= 0) {
+              break;
+            }
+            Read += Result;
+          }
+          close(ChunkFD);
+
+          ChunkGood = Read == ChunkLength &&
+                      XXH3_64bits(Data.data(), ChunkLength) == Manifest.Chunks[Fetch->Index] &&
+                      pwrite(DestFD, Data.data(), ChunkLength, Begin) == static_cast<ssize_t>(ChunkLength);
+        }
+      }
+
+      unlink(Fetch->Path.c_str());
+      InFlight.erase(Fetch);
+
+      if (!ChunkGood) {
+        Failed = true;
+        break;
+      }
+
+      ++Completed;
+      fmt::print("\r{}/{} changed chunks fetched", Completed, Needed.size());
+      fflush(stdout);
+    }
+    fmt::print("\n");
+
+    CleanupInFlight();
+    return !Failed && Completed == Needed.size();
+  }
+
+  // Attempts a delta update against an existing local image.
+  // Returns true when the destination now matches the published hash. Any
+  // failure leaves the destination untouched so the caller can fall back to a
+  // full download.
+  bool TryDeltaUpdate(const WebFileFetcher::FileTargets &Target, const fextl::string &RootFS) {
+    auto filename = Target.URL.substr(Target.URL.find_last_of('/') + 1);
+    auto PathName = RootFS + filename;
+
+    const fextl::string Seed = FindSeedImage(PathName);
+    if (Seed.empty()) {
+      return false;
+    }
+
+    auto Manifest = FetchManifest(Target.URL);
+    if (!Manifest) {
+      return false;
+    }
+
+    fmt::print("Hashing {} for delta update\n", Seed);
+    auto SeedHashes = XXFileHash::HashFileChunks(Seed, Manifest->ChunkSize);
+    if (!SeedHashes.first) {
+      return false;
+    }
+
+    std::vector<uint64_t> Needed;
+    for (uint64_t i = 0; i < Manifest->Chunks.size(); ++i) {
+      if (i >= SeedHashes.second.size() ||
+          SeedHashes.second[i] != Manifest->Chunks[i]) {
+        Needed.emplace_back(i);
+      }
+    }
+
+    // A mostly changed image downloads faster as one ranged-less transfer with
+    // the regular progress UI than as thousands of ranged requests.
+    if (Needed.size() * 2 > Manifest->Chunks.size()) {
+      fmt::print("{} of {} chunks changed, falling back to full download\n", Needed.size(), Manifest->Chunks.size());
+      return false;
+    }
+
+    fextl::string TmpPath = PathName + ".delta";
+    int DestFD = open(TmpPath.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (DestFD == -1) {
+      return false;
+    }
+
+    auto HadError = [&DestFD, &TmpPath]() -> bool {
+      if (DestFD != -1) {
+        close(DestFD);
+      }
+      unlink(TmpPath.c_str());
+      return false;
+    };
+
+    if (ftruncate(DestFD, Manifest->Size) == -1) {
+      return HadError();
+    }
+
+    // Splice the chunks the seed already has.
+    {
+      int SeedFD = open(Seed.c_str(), O_RDONLY);
+      if (SeedFD == -1) {
+        return HadError();
+      }
+
+      std::vector<char> Data(Manifest->ChunkSize);
+      bool CopyGood = true;
+      for (uint64_t i = 0; i < Manifest->Chunks.size() && CopyGood; ++i) {
+        if (i < SeedHashes.second.size() && SeedHashes.second[i] == Manifest->Chunks[i]) {
+          const uint64_t Begin = i * Manifest->ChunkSize;
+          const uint64_t Length = std::min(Manifest->ChunkSize, Manifest->Size - Begin);
+          uint64_t Done{};
+          while (Done < Length) {
+            ssize_t Result = pread(SeedFD, Data.data(), Length - Done, Begin + Done);
+            CopyGood = Result > 0 && pwrite(DestFD, Data.data(), Result, Begin + Done) == Result;
+            if (!CopyGood) {
+              break;
+            }
+            Done += Result;
+          }
+        }
+      }
+      close(SeedFD);
+      if (!CopyGood) {
+        return HadError();
+      }
+    }
+
+    fmt::print("Reusing {} of {} chunks from {}\n", Manifest->Chunks.size() - Needed.size(), Manifest->Chunks.size(), Seed);
+    if (!FetchChunks(Target, *Manifest, Needed, PathName, DestFD)) {
+      return HadError();
+    }
+
+    close(DestFD);
+    DestFD = -1;
+
+    // The reconstructed image must match the published image hash exactly,
+    // same as a fully downloaded one would.
+    const uint64_t ExpectedHash = std::stoul(Target.Hash, nullptr, 16);
+    auto Res = XXFileHash::HashFile(TmpPath);
+    if (!Res.first || Res.second != ExpectedHash) {
+      fmt::print("Reconstructed image doesn't match expected hash, falling back to full download\n");
+      return HadError();
+    }
+
+    if (rename(TmpPath.c_str(), PathName.c_str()) == -1) {
+      return HadError();
+    }
+
+    fmt::print("Delta update complete\n");
+    return true;
+  }
+}
+
 namespace Zenity {
   bool ExecWithQuestion(const fextl::string &Question) {
     fextl::string TextArg = "--text=" + Question;
@@ -824,6 +1170,12 @@ namespace Zenity {
         }
       }
 
+      // Reconstruct from an existing local image first when the server hosts a
+      // chunk manifest, only the changed blocks transfer.
+      if (DeltaFetcher::TryDeltaUpdate(Target, RootFS)) {
+        return true;
+      }
+
       if (!WebFileFetcher::DownloadToPathWithZenityProgress(Target.URL, RootFS)) {
         return false;
       }
@@ -993,6 +1345,12 @@ namespace TTY {
           return false;
         }
       }
+      // Reconstruct from an existing local image first when the server hosts a
+      // chunk manifest, only the changed blocks transfer.
+      if (DeltaFetcher::TryDeltaUpdate(Target, RootFS)) {
+        return true;
+      }
+
       auto DoDownload = [&Target, &RootFS]() -> bool {
         if (!WebFileFetcher::DownloadToPath(Target.URL, RootFS)) {
           fmt::print("Couldn't download RootFS\n");
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
 #include "XXFileHash.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fcntl.h>
 #include <fmt/format.h>
@@ -71,4 +72,39 @@ namespace XXFileHash {
     close(fd);
     return {true, Hash};
   }
+
+  std::pair<bool, std::vector<uint64_t>> HashFileChunks(const fextl::string &Filepath, uint64_t ChunkSize) {
+    int fd = open(Filepath.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return {false, {}};
+    }
+
+    const off_t Size = lseek(fd, 0, SEEK_END);
+    lseek(fd, 0, SEEK_SET);
+
+    std::vector<uint64_t> Hashes;
+    std::vector<char> Data(ChunkSize);
+    off_t CurrentOffset = 0;
+
+    // Let the kernel know that we will be reading linearly
+    posix_fadvise(fd, 0, Size, POSIX_FADV_SEQUENTIAL);
+    while (CurrentOffset < Size) {
+      const uint64_t Remaining = std::min<uint64_t>(ChunkSize, Size - CurrentOffset);
+      uint64_t Read{};
+      while (Read < Remaining) {
+        ssize_t Result = pread(fd, Data.data() + Read, Remaining - Read, CurrentOffset + Read);
+        if (Result <= 0) {
+          close(fd);
+          return {false, {}};
+        }
+        Read += Result;
+      }
+
+      Hashes.emplace_back(XXH3_64bits(Data.data(), Remaining));
+      CurrentOffset += Remaining;
+    }
+
+    close(fd);
+    return {true, std::move(Hashes)};
+  }
 }
@@ -2,7 +2,12 @@
 #pragma once
 #include <FEXCore/fextl/string.h>
 
+#include <vector>
+
 namespace XXFileHash {
   std::pair<bool, uint64_t> HashFile(const fextl::string &Filepath);
+  // Hashes each ChunkSize sized piece of the file independently.
+  // The final chunk hashes whatever partial data remains.
+  std::pair<bool, std::vector<uint64_t>> HashFileChunks(const fextl::string &Filepath, uint64_t ChunkSize);
 }
 
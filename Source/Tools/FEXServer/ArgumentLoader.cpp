@@ -37,6 +37,13 @@ namespace FEXServer::Config {
       .set_default(false)
       .help("Wait for the FEXServer to shutdown");
 
+    Parser.add_option("-c", "--compile-workers")
+      .action("store")
+      .type("int")
+      .set_default(0)
+      .metavar("n")
+      .help("Run an AOT compile service with n worker processes");
+
     Parser.add_option("-v")
       .action("version")
       .help("Version string");
@@ -50,6 +57,7 @@ namespace FEXServer::Config {
       FEXOptions.Foreground = true;
     }
     FEXOptions.PersistentTimeout = Options.get("persistent");
+    FEXOptions.CompileWorkers = Options.get("compile_workers");
 
     return FEXOptions;
   }
@@ -8,6 +8,7 @@ namespace FEXServer::Config {
     bool Foreground;
     bool Wait;
     uint32_t PersistentTimeout;
+    uint32_t CompileWorkers;
   };
 
   FEXServerOptions Load(int argc, char **argv);
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+#include "CompileService.h"
+
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/deque.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/unordered_set.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <condition_variable>
+#include <limits.h>
+#include <mutex>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace CompileService {
+  // Emulated processes submit the binaries they are running and the server
+  // fans them out to a pool of worker processes. Each worker is a regular
+  // FEXInterpreter invocation in AOTIRGENERATE mode, which walks the binary's
+  // executable sections and stores the compiled result in the shared AOTIR
+  // cache directory. Submitting processes pick the objects up through the
+  // existing AOTIR cache FD request on their next run.
+  uint32_t MaxWorkers{};
+  uint32_t ActiveWorkers{};
+  bool ShuttingDown{};
+
+  std::mutex QueueMutex;
+  std::condition_variable QueueCV;
+  fextl::deque<fextl::string> Queue;
+
+  // Paths queued at any point in this server's lifetime. Every emulated
+  // process submits its own binary on startup, so the common case is a
+  // duplicate of something already compiled or in flight.
+  fextl::unordered_set<fextl::string> SubmittedPaths;
+
+  fextl::string InterpreterPath;
+
+  static fextl::string FindInterpreterPath() {
+    // FEXInterpreter lives next to the FEXServer binary
+    char SelfPath[PATH_MAX];
+    auto Size = readlink("/proc/self/exe", SelfPath, sizeof(SelfPath) - 1);
+    if (Size <= 0) {
+      return {};
+    }
+    SelfPath[Size] = 0;
+
+    fextl::string Path {SelfPath};
+    auto Separator = Path.rfind('/');
+    if (Separator == fextl::string::npos) {
+      return {};
+    }
+    Path.erase(Separator + 1);
+    Path += "FEXInterpreter";
+
+    if (access(Path.c_str(), X_OK) != 0) {
+      return {};
+    }
+    return Path;
+  }
+
+  static void WorkerLoop() {
+    while (true) {
+      fextl::string Path;
+      {
+        std::unique_lock lk {QueueMutex};
+        QueueCV.wait(lk, []() { return ShuttingDown || !Queue.empty(); });
+        if (ShuttingDown) {
+          return;
+        }
+        Path = std::move(Queue.front());
+        Queue.pop_front();
+      }
+
+      pid_t PID = fork();
+      if (PID == 0) {
+        // The workers exist to soak idle cores, never to compete with the
+        // running guest. Drop to the lowest scheduling priority.
+        setpriority(PRIO_PROCESS, 0, 19);
+
+        setenv("FEX_AOTIRGENERATE", "1", 1);
+        setenv("FEX_AOTIRCAPTURE", "0", 1);
+        setenv("FEX_AOTIRLOAD", "0", 1);
+
+        execl(InterpreterPath.c_str(), InterpreterPath.c_str(), Path.c_str(), nullptr);
+        _exit(1);
+      }
+
+      if (PID > 0) {
+        int Status {};
+        waitpid(PID, &Status, 0);
+        if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0) {
+          LogMan::Msg::EFmt("[FEXServer] AOT compile worker failed for '{}'", Path);
+        }
+      }
+    }
+  }
+
+  void SetConfiguration(uint32_t Workers) {
+    MaxWorkers = Workers;
+    if (MaxWorkers) {
+      InterpreterPath = FindInterpreterPath();
+      if (InterpreterPath.empty()) {
+        LogMan::Msg::EFmt("[FEXServer] Couldn't find FEXInterpreter for the compile service");
+        MaxWorkers = 0;
+      }
+    }
+  }
+
+  void Submit(std::string_view Path) {
+    if (!MaxWorkers ||
+        Path.empty() ||
+        Path[0] != '/') {
+      return;
+    }
+
+    std::unique_lock lk {QueueMutex};
+    if (ShuttingDown ||
+        !SubmittedPaths.emplace(Path).second) {
+      return;
+    }
+    Queue.emplace_back(Path);
+
+    // Workers spin up lazily so an idle server doesn't carry a thread pool
+    if (ActiveWorkers < MaxWorkers && ActiveWorkers < Queue.size()) {
+      ++ActiveWorkers;
+      std::thread(WorkerLoop).detach();
+    }
+    lk.unlock();
+    QueueCV.notify_one();
+  }
+
+  void Shutdown() {
+    {
+      std::unique_lock lk {QueueMutex};
+      ShuttingDown = true;
+      Queue.clear();
+    }
+    // Workers are detached and exit on the flag. In-flight compile children
+    // are left to finish, their results still land in the shared cache.
+    QueueCV.notify_all();
+  }
+}
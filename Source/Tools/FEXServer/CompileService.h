@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace CompileService {
+  // Enables the compile service with a pool of up to MaxWorkers worker
+  // processes. Zero keeps the service disabled.
+  void SetConfiguration(uint32_t MaxWorkers);
+
+  // Queues a guest binary for ahead-of-time compilation in to the shared
+  // AOTIR cache. Thread-safe; duplicate submissions of the same path are
+  // dropped.
+  void Submit(std::string_view Path);
+
+  void Shutdown();
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: MIT
+#include "LibraryIndex.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
+#include <charconv>
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+#include <unistd.h>
+
+namespace LibraryIndex {
+  namespace {
+    std::mutex IndexLock{};
+    bool Loaded{};
+    // Sighting counts per library base filename, fleet-wide. Every emulated
+    // process reports each named region once per run, so the count is a
+    // process-runs-times-usage popularity proxy.
+    fextl::map<fextl::string, uint64_t> Sightings{};
+    uint64_t UpdatesSinceSave{};
+
+    // Tier thresholds. A library has to show up across a handful of process
+    // launches before it earns the hot tier; a binary run once never does.
+    constexpr uint64_t POPULAR_THRESHOLD = 4;
+    constexpr uint64_t HOT_THRESHOLD = 16;
+
+    // Bound the write rate; a lost tail of sightings only delays tier
+    // promotion by a few process launches.
+    constexpr uint64_t SAVE_INTERVAL = 64;
+
+    uint32_t TierForCount(uint64_t Count) {
+      if (Count >= HOT_THRESHOLD) {
+        return 2;
+      }
+      if (Count >= POPULAR_THRESHOLD) {
+        return 1;
+      }
+      return 0;
+    }
+
+    fextl::string GetIndexPath() {
+      return fextl::fmt::format("{}/objcache/LibraryPopularity", FEXCore::Config::GetDataDirectory());
+    }
+
+    void LoadIndex() {
+      // One "<count> <name>" entry per line.
+      fextl::vector<char> Data{};
+      if (!FEXCore::FileLoading::LoadFile(Data, GetIndexPath())) {
+        return;
+      }
+
+      std::string_view Remaining { Data.data(), Data.size() };
+      while (!Remaining.empty()) {
+        const auto LineEnd = Remaining.find('\n');
+        std::string_view Line = Remaining.substr(0, LineEnd);
+        Remaining = LineEnd == Remaining.npos ? std::string_view{} : Remaining.substr(LineEnd + 1);
+
+        const auto Split = Line.find(' ');
+        if (Split == Line.npos) {
+          continue;
+        }
+
+        uint64_t Count{};
+        auto Conv = std::from_chars(Line.data(), Line.data() + Split, Count);
+        if (Conv.ec != std::errc{} || Count == 0 || Split + 1 >= Line.size()) {
+          continue;
+        }
+
+        Sightings[fextl::string(Line.substr(Split + 1))] = Count;
+      }
+    }
+
+    void SaveIndex() {
+      const auto Path = GetIndexPath();
+      FHU::Filesystem::CreateDirectory(fextl::fmt::format("{}/objcache", FEXCore::Config::GetDataDirectory()));
+
+      // Write through a temporary and rename so a concurrent reader or a
+      // crashed server never sees a half-written index.
+      fextl::string Data{};
+      for (auto &[Name, Count] : Sightings) {
+        Data += fextl::fmt::format("{} {}\n", Count, Name);
+      }
+
+      const auto TmpPath = Path + ".tmp";
+      FILE *File = fopen(TmpPath.c_str(), "wb");
+      if (!File) {
+        return;
+      }
+
+      const bool Written = fwrite(Data.data(), 1, Data.size(), File) == Data.size();
+      fclose(File);
+
+      if (Written) {
+        ::rename(TmpPath.c_str(), Path.c_str());
+      } else {
+        ::unlink(TmpPath.c_str());
+      }
+    }
+  }
+
+  uint32_t RecordSighting(const fextl::string &BaseFilename) {
+    std::unique_lock lk {IndexLock};
+
+    if (!Loaded) {
+      LoadIndex();
+      Loaded = true;
+    }
+
+    const uint64_t Count = ++Sightings[BaseFilename];
+    const uint32_t Tier = TierForCount(Count);
+
+    // Persist immediately on a tier promotion so it takes effect fleet-wide
+    // right away, otherwise on the throttled interval.
+    if (++UpdatesSinceSave >= SAVE_INTERVAL || Tier != TierForCount(Count - 1)) {
+      SaveIndex();
+      UpdatesSinceSave = 0;
+    }
+
+    return Tier;
+  }
+}
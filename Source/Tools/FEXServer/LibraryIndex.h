@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/fextl/string.h>
+
+#include <cstdint>
+
+namespace LibraryIndex {
+  // Records one sighting of a guest library and returns its popularity tier.
+  // Tier values match FEXCore::Context::LIBRARY_TIER_*. The index persists in
+  // the server's data directory so popularity survives server restarts.
+  uint32_t RecordSighting(const fextl::string &BaseFilename);
+}
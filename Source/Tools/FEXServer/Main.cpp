@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: MIT
 #include "ArgumentLoader.h"
+#include "CompileService.h"
 #include "Logger.h"
 #include "PipeScanner.h"
 #include "ProcessPipe.h"
@@ -171,6 +172,16 @@ int main(int argc, char **argv, char **const envp) {
     return -1;
   }
 
+  if (!ProcessPipe::InitializeStatsSocket()) {
+    // Stats are diagnostics only, keep serving without them.
+    LogMan::Msg::EFmt("[FEXServer] Couldn't create stats socket");
+  }
+
+  if (!ProcessPipe::InitializeProfileStreamSocket()) {
+    // Same deal as stats, profiling is diagnostics only.
+    LogMan::Msg::EFmt("[FEXServer] Couldn't create profile stream socket");
+  }
+
   // Switch this process over to a new session id
   // Probably not required but allows this to become the process group leader of its session
   ::setsid();
@@ -194,11 +205,14 @@ int main(int argc, char **argv, char **const envp) {
   PipeScanner::ClosePipes();
 
   ProcessPipe::SetConfiguration(Options.Foreground, Options.PersistentTimeout ?: 10);
+  CompileService::SetConfiguration(Options.CompileWorkers);
 
   // Actually spin up the request thread.
   // Any applications that were waiting for the socket to accept will then go through here.
   ProcessPipe::WaitForRequests();
 
+  CompileService::Shutdown();
+
   SquashFS::UnmountRootFS();
 
   Logger::Shutdown();
@@ -1,15 +1,25 @@
 // SPDX-License-Identifier: MIT
 #include "FEXHeaderUtils/Syscalls.h"
+#include "CompileService.h"
+#include "LibraryIndex.h"
 #include "Logger.h"
 #include "SquashFS.h"
+#include "Stats.h"
 
 #include "Common/FEXServerClient.h"
 
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXHeaderUtils/Filesystem.h>
+
 #include <atomic>
+#include <chrono>
 #include <fcntl.h>
 #include <filesystem>
 #include <poll.h>
 #include <string>
+#include <string_view>
 #include <sys/resource.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -19,6 +29,8 @@ namespace ProcessPipe {
   constexpr int USER_PERMS = S_IRWXU | S_IRWXG | S_IRWXO;
   int ServerLockFD {-1};
   int ServerSocketFD{-1};
+  int StatsSocketFD{-1};
+  int ProfileStreamSocketFD{-1};
   std::atomic<bool> ShouldShutdown {false};
   time_t RequestTimeout {10};
   bool Foreground {false};
@@ -179,41 +191,253 @@ namespace ProcessPipe {
     return true;
   }
 
-  bool InitializeServerSocket() {
-    auto ServerSocketName = FEXServerClient::GetServerSocketName();
-
+  int CreateListenSocket(const fextl::string &SocketName) {
     // Create the initial unix socket
-    ServerSocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
-    if (ServerSocketFD == -1) {
+    int SocketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (SocketFD == -1) {
       LogMan::Msg::EFmt("Couldn't create AF_UNIX socket: {} {}\n", errno, strerror(errno));
-      return false;
+      return -1;
     }
 
     struct sockaddr_un addr{};
     addr.sun_family = AF_UNIX;
-    size_t SizeOfSocketString = std::min(ServerSocketName.size() + 1, sizeof(addr.sun_path) - 1);
+    size_t SizeOfSocketString = std::min(SocketName.size() + 1, sizeof(addr.sun_path) - 1);
     addr.sun_path[0] = 0; // Abstract AF_UNIX sockets start with \0
-    strncpy(addr.sun_path + 1, ServerSocketName.data(), SizeOfSocketString);
+    strncpy(addr.sun_path + 1, SocketName.data(), SizeOfSocketString);
     // Include final null character.
     size_t SizeOfAddr = sizeof(addr.sun_family) + SizeOfSocketString;
 
     // Bind the socket to the path
-    int Result = bind(ServerSocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr);
+    int Result = bind(SocketFD, reinterpret_cast<struct sockaddr*>(&addr), SizeOfAddr);
     if (Result == -1) {
       LogMan::Msg::EFmt("Couldn't bind AF_UNIX socket '{}': {} {}\n", addr.sun_path, errno, strerror(errno));
-      close(ServerSocketFD);
-      ServerSocketFD = -1;
-      return false;
+      close(SocketFD);
+      return -1;
     }
 
-    listen(ServerSocketFD, 16);
+    listen(SocketFD, 16);
     PollFDs.emplace_back(pollfd {
-      .fd = ServerSocketFD,
+      .fd = SocketFD,
       .events = POLLIN,
       .revents = 0,
     });
 
-    return true;
+    return SocketFD;
+  }
+
+  bool InitializeServerSocket() {
+    ServerSocketFD = CreateListenSocket(FEXServerClient::GetServerSocketName());
+    return ServerSocketFD != -1;
+  }
+
+  bool InitializeStatsSocket() {
+    StatsSocketFD = CreateListenSocket(FEXServerClient::GetServerStatsSocketName());
+    return StatsSocketFD != -1;
+  }
+
+  bool InitializeProfileStreamSocket() {
+    ProfileStreamSocketFD = CreateListenSocket(FEXServerClient::GetServerProfileStreamSocketName());
+    return ProfileStreamSocketFD != -1;
+  }
+
+  // Binary profile stream subscribers. Deliberately not in PollFDs: the
+  // server only ever writes to them, so hangups surface as send errors at
+  // push time rather than needing poll events.
+  constexpr uint32_t DEFAULT_STREAM_INTERVAL_MS = 1000;
+  struct ProfileSubscriber {
+    int FD;
+    std::chrono::milliseconds Interval;
+    std::chrono::steady_clock::time_point NextPush;
+  };
+  std::vector<ProfileSubscriber> ProfileSubscribers{};
+
+  void AcceptProfileSubscriber() {
+    struct sockaddr_storage Addr{};
+    socklen_t AddrSize{};
+    const int StreamFD = accept(ProfileStreamSocketFD, reinterpret_cast<struct sockaddr*>(&Addr), &AddrSize);
+    if (StreamFD == -1) {
+      return;
+    }
+
+    // The subscribe request arrives together with the connection. Bound the
+    // wait so a connect-and-stall client can't wedge the event loop.
+    struct timeval Timeout {
+      .tv_sec = 1,
+    };
+    setsockopt(StreamFD, SOL_SOCKET, SO_RCVTIMEO, &Timeout, sizeof(Timeout));
+
+    FEXServerClient::ProfileStream::SubscribeRequest Request{};
+    if (recv(StreamFD, &Request, sizeof(Request), MSG_WAITALL) != sizeof(Request) ||
+        Request.Cookie != FEXServerClient::ProfileStream::COOKIE ||
+        Request.Version != FEXServerClient::ProfileStream::VERSION) {
+      close(StreamFD);
+      return;
+    }
+
+    // Slow consumers get dropped at push time instead of ever blocking the
+    // server on a full socket buffer.
+    fcntl(StreamFD, F_SETFL, fcntl(StreamFD, F_GETFL) | O_NONBLOCK);
+
+    const auto Interval = std::chrono::milliseconds(Request.IntervalMS != 0 ? Request.IntervalMS : DEFAULT_STREAM_INTERVAL_MS);
+    ProfileSubscribers.emplace_back(ProfileSubscriber {
+      .FD = StreamFD,
+      .Interval = Interval,
+      .NextPush = std::chrono::steady_clock::now() + Interval,
+    });
+  }
+
+  void PushProfileFrames() {
+    if (ProfileSubscribers.empty()) {
+      return;
+    }
+
+    const auto Now = std::chrono::steady_clock::now();
+
+    // One serialization serves every due subscriber this round.
+    fextl::vector<char> Frame{};
+    bool Serialized{};
+
+    for (auto it = ProfileSubscribers.begin(); it != ProfileSubscribers.end(); ) {
+      if (Now < it->NextPush) {
+        ++it;
+        continue;
+      }
+
+      if (!Serialized) {
+        Stats::SerializeProfileFrame(Frame);
+        Serialized = true;
+      }
+
+      // Frames are small enough to fit a socket buffer, so a short write means
+      // the subscriber stopped reading long ago. Drop it, a partial frame
+      // would desynchronize the stream anyway.
+      const ssize_t Sent = send(it->FD, Frame.data(), Frame.size(), MSG_NOSIGNAL);
+      if (Sent != static_cast<ssize_t>(Frame.size())) {
+        close(it->FD);
+        it = ProfileSubscribers.erase(it);
+        continue;
+      }
+
+      it->NextPush = Now + it->Interval;
+      ++it;
+    }
+  }
+
+  // Opens an AOTIR cache file from the server's data directory for a client.
+  // Every client gets an FD of the same inode, so the kernel's page cache holds
+  // a single copy of the compiled code no matter how many emulated processes
+  // map it, even when the clients can't see the data directory themselves.
+  // Each request gets its own open file description since clients seek the FD.
+  int OpenAOTIRCacheFD(std::string_view FileID) {
+    // The file id comes from another process. Refuse anything that could walk
+    // out of the aotir directory.
+    if (FileID.empty() ||
+        FileID.find('/') != std::string_view::npos ||
+        FileID == "." ||
+        FileID == "..") {
+      return -1;
+    }
+
+    auto Path = fextl::fmt::format("{}/aotir/{}.aotir", FEXCore::Config::GetDataDirectory(), FileID);
+    return open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+  }
+
+  // Creates a temporary file in the server's aotir directory for a client to
+  // stream a freshly captured cache in to. The name is suffixed with the
+  // client's socket FD so concurrent captures of the same file id from
+  // different processes can't clobber each other mid-stream; CommitAOTIRCache
+  // publishes the finished file under its final name. A client that dies
+  // mid-stream leaks its temporary, matching what the local .tmp convention
+  // already tolerated.
+  int OpenAOTIRCacheWriteFD(std::string_view FileID, int Socket) {
+    // The file id comes from another process. Refuse anything that could walk
+    // out of the aotir directory.
+    if (FileID.empty() ||
+        FileID.find('/') != std::string_view::npos ||
+        FileID == "." ||
+        FileID == "..") {
+      return -1;
+    }
+
+    const auto CacheFolder = fextl::fmt::format("{}/aotir", FEXCore::Config::GetDataDirectory());
+    if (!FHU::Filesystem::CreateDirectories(CacheFolder)) {
+      return -1;
+    }
+
+    auto Path = fextl::fmt::format("{}/{}.aotir.{}.tmp", CacheFolder, FileID, Socket);
+    return open(Path.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0644);
+  }
+
+  // Atomically renames a client's streamed temporary cache in to place. Last
+  // committer of a file id wins, which is fine - every committer generated the
+  // object from the same guest code under the same config.
+  bool CommitAOTIRCache(std::string_view FileID, int Socket) {
+    // The file id comes from another process. Refuse anything that could walk
+    // out of the aotir directory.
+    if (FileID.empty() ||
+        FileID.find('/') != std::string_view::npos ||
+        FileID == "." ||
+        FileID == "..") {
+      return false;
+    }
+
+    const auto CacheFolder = fextl::fmt::format("{}/aotir", FEXCore::Config::GetDataDirectory());
+    const auto TmpPath = fextl::fmt::format("{}/{}.aotir.{}.tmp", CacheFolder, FileID, Socket);
+    const auto Path = fextl::fmt::format("{}/{}.aotir", CacheFolder, FileID);
+    return !FHU::Filesystem::RenameFile(TmpPath, Path);
+  }
+
+  // Creates a crash dump file in the server's data directory for a client.
+  // The crashing process streams its binary crash record through the FD, so
+  // dumps from every emulated process on the box collect in one place even
+  // when the crashing process can't see the data directory itself.
+  int OpenCrashDumpFD(std::string_view AppName) {
+    // The application name comes from another process. Refuse anything that
+    // could walk out of the crashes directory.
+    if (AppName.empty() ||
+        AppName.find('/') != std::string_view::npos ||
+        AppName == "." ||
+        AppName == "..") {
+      return -1;
+    }
+
+    const auto CrashFolder = fextl::fmt::format("{}/crashes", FEXCore::Config::GetDataDirectory());
+    if (!FHU::Filesystem::CreateDirectories(CrashFolder)) {
+      return -1;
+    }
+
+    struct timespec Time{};
+    clock_gettime(CLOCK_REALTIME, &Time);
+    const uint64_t Timestamp = Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+
+    auto Path = fextl::fmt::format("{}/{}-{}.fexcrash", CrashFolder, AppName, Timestamp);
+    return open(Path.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0644);
+  }
+
+  // Creates a flight record file in the server's data directory for a client.
+  // Same collection model as the crash dumps, but written on demand while the
+  // process keeps running rather than on a fatal signal.
+  int OpenFlightRecordFD(std::string_view AppName) {
+    // The application name comes from another process. Refuse anything that
+    // could walk out of the flightrecords directory.
+    if (AppName.empty() ||
+        AppName.find('/') != std::string_view::npos ||
+        AppName == "." ||
+        AppName == "..") {
+      return -1;
+    }
+
+    const auto RecordFolder = fextl::fmt::format("{}/flightrecords", FEXCore::Config::GetDataDirectory());
+    if (!FHU::Filesystem::CreateDirectories(RecordFolder)) {
+      return -1;
+    }
+
+    struct timespec Time{};
+    clock_gettime(CLOCK_REALTIME, &Time);
+    const uint64_t Timestamp = Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec;
+
+    auto Path = fextl::fmt::format("{}/{}-{}.fexfr", RecordFolder, AppName, Timestamp);
+    return open(Path.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0644);
   }
 
   void SendEmptyErrorPacket(int Socket) {
@@ -238,6 +462,28 @@ namespace ProcessPipe {
     sendmsg(Socket, &msg, 0);
   }
 
+  void SendEmptySuccessPacket(int Socket) {
+    FEXServerClient::FEXServerResultPacket Res {
+      .Header {
+        .Type = FEXServerClient::PacketType::TYPE_SUCCESS,
+      },
+    };
+
+    struct iovec iov {
+      .iov_base = &Res,
+      .iov_len = sizeof(Res),
+    };
+
+    struct msghdr msg {
+      .msg_name = nullptr,
+      .msg_namelen = 0,
+      .msg_iov = &iov,
+      .msg_iovlen = 1,
+    };
+
+    sendmsg(Socket, &msg, 0);
+  }
+
   void SendFDSuccessPacket(int Socket, int FD) {
     FEXServerClient::FEXServerResultPacket Res {
       .Header {
@@ -427,6 +673,242 @@ namespace ProcessPipe {
 
           CurrentOffset += sizeof(FEXServerClient::FEXServerRequestPacket::Header);
           break;
+        }
+        case FEXServerClient::PacketType::TYPE_STATS_UPDATE: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->StatsUpdate);
+
+          if (Remaining < PacketSize ||
+              Req->StatsUpdate.NumStats == 0 ||
+              Req->StatsUpdate.NumStats > (Remaining - PacketSize) / sizeof(uint64_t)) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed stats update");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          Stats::Update(Socket, Req->StatsUpdate.PID, Req->StatsUpdate.Stats, Req->StatsUpdate.NumStats);
+
+          // Fire and forget from the client, no response.
+          CurrentOffset += PacketSize + Req->StatsUpdate.NumStats * sizeof(uint64_t);
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_PROFILE_UPDATE: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->ProfileUpdate);
+
+          if (Remaining < PacketSize ||
+              Req->ProfileUpdate.NumEntries == 0 ||
+              Req->ProfileUpdate.NumEntries > (Remaining - PacketSize) / sizeof(FEXServerClient::ProfileSampleEntry)) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed profile update");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          Stats::UpdateProfile(Socket, Req->ProfileUpdate.PID, Req->ProfileUpdate.Entries, Req->ProfileUpdate.NumEntries);
+
+          // Fire and forget from the client, no response.
+          CurrentOffset += PacketSize + Req->ProfileUpdate.NumEntries * sizeof(FEXServerClient::ProfileSampleEntry);
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_COMPILE_SUBMIT: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->CompileSubmit);
+
+          if (Remaining < PacketSize ||
+              Req->CompileSubmit.Length == 0 ||
+              Req->CompileSubmit.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed compile submission");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          std::string_view Path { Req->CompileSubmit.Path, Req->CompileSubmit.Length - 1 };
+
+          CompileService::Submit(Path);
+
+          // Fire and forget from the client, no response.
+          CurrentOffset += PacketSize + Req->CompileSubmit.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_LIBRARY_PRIORITY: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->LibraryPriority);
+
+          if (Remaining < PacketSize ||
+              Req->LibraryPriority.Length == 0 ||
+              Req->LibraryPriority.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed library priority request");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          fextl::string Name { Req->LibraryPriority.Name, Req->LibraryPriority.Length - 1 };
+
+          FEXServerClient::FEXServerResultPacket Res {
+            .LibraryTier {
+              .Header {
+                .Type = FEXServerClient::PacketType::TYPE_SUCCESS,
+              },
+              .Tier = LibraryIndex::RecordSighting(Name),
+            },
+          };
+
+          write(Socket, &Res, sizeof(Res));
+
+          CurrentOffset += PacketSize + Req->LibraryPriority.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_AOTIRCACHE_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->AOTIRCacheFD);
+
+          if (Remaining < PacketSize ||
+              Req->AOTIRCacheFD.Length == 0 ||
+              Req->AOTIRCacheFD.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed AOTIR cache request");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          std::string_view FileID { Req->AOTIRCacheFD.FileID, Req->AOTIRCacheFD.Length - 1 };
+
+          int FD = OpenAOTIRCacheFD(FileID);
+          if (FD != -1) {
+            SendFDSuccessPacket(Socket, FD);
+
+            // Close the FD now since we've sent it
+            close(FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += PacketSize + Req->AOTIRCacheFD.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_AOTIRCACHE_WRITE_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->AOTIRCacheFD);
+
+          if (Remaining < PacketSize ||
+              Req->AOTIRCacheFD.Length == 0 ||
+              Req->AOTIRCacheFD.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed AOTIR cache write request");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          std::string_view FileID { Req->AOTIRCacheFD.FileID, Req->AOTIRCacheFD.Length - 1 };
+
+          int FD = OpenAOTIRCacheWriteFD(FileID, Socket);
+          if (FD != -1) {
+            SendFDSuccessPacket(Socket, FD);
+
+            // Close the FD now since we've sent it
+            close(FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += PacketSize + Req->AOTIRCacheFD.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_AOTIRCACHE_COMMIT: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->AOTIRCacheFD);
+
+          if (Remaining < PacketSize ||
+              Req->AOTIRCacheFD.Length == 0 ||
+              Req->AOTIRCacheFD.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed AOTIR cache commit");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          std::string_view FileID { Req->AOTIRCacheFD.FileID, Req->AOTIRCacheFD.Length - 1 };
+
+          if (CommitAOTIRCache(FileID, Socket)) {
+            SendEmptySuccessPacket(Socket);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += PacketSize + Req->AOTIRCacheFD.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_CRASHDUMP_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->CrashDumpFD);
+
+          if (Remaining < PacketSize ||
+              Req->CrashDumpFD.Length == 0 ||
+              Req->CrashDumpFD.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed crash dump request");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          std::string_view AppName { Req->CrashDumpFD.AppName, Req->CrashDumpFD.Length - 1 };
+
+          int FD = OpenCrashDumpFD(AppName);
+          if (FD != -1) {
+            SendFDSuccessPacket(Socket, FD);
+
+            // Close the FD now since we've sent it
+            close(FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += PacketSize + Req->CrashDumpFD.Length;
+          break;
+        }
+        case FEXServerClient::PacketType::TYPE_GET_FLIGHTRECORD_FD: {
+          const size_t Remaining = CurrentRead - CurrentOffset;
+          const size_t PacketSize = sizeof(Req->FlightRecordFD);
+
+          if (Remaining < PacketSize ||
+              Req->FlightRecordFD.Length == 0 ||
+              Req->FlightRecordFD.Length > Remaining - PacketSize) {
+            // Malformed packet. Consume all the data so we don't spin.
+            LogMan::Msg::EFmt("[FEXServer] Malformed flight record request");
+            CurrentOffset = CurrentRead;
+            break;
+          }
+
+          // Length includes the null terminator.
+          std::string_view AppName { Req->FlightRecordFD.AppName, Req->FlightRecordFD.Length - 1 };
+
+          int FD = OpenFlightRecordFD(AppName);
+          if (FD != -1) {
+            SendFDSuccessPacket(Socket, FD);
+
+            // Close the FD now since we've sent it
+            close(FD);
+          }
+          else {
+            SendEmptyErrorPacket(Socket);
+          }
+
+          CurrentOffset += PacketSize + Req->FlightRecordFD.Length;
+          break;
         }
           // Invalid
         case FEXServerClient::PacketType::TYPE_ERROR:
@@ -446,6 +928,19 @@ namespace ProcessPipe {
 
     // Close the server socket so no more connections can be started
     close(ServerSocketFD);
+
+    if (StatsSocketFD != -1) {
+      close(StatsSocketFD);
+    }
+
+    if (ProfileStreamSocketFD != -1) {
+      close(ProfileStreamSocketFD);
+    }
+
+    for (auto &Subscriber : ProfileSubscribers) {
+      close(Subscriber.FD);
+    }
+    ProfileSubscribers.clear();
   }
 
   void WaitForRequests() {
@@ -455,7 +950,24 @@ namespace ProcessPipe {
       struct timespec ts{};
       ts.tv_sec = RequestTimeout;
 
+      if (!ProfileSubscribers.empty()) {
+        // Wake up in time for the earliest due frame push.
+        auto NextDue = ProfileSubscribers.front().NextPush;
+        for (auto &Subscriber : ProfileSubscribers) {
+          NextDue = std::min(NextDue, Subscriber.NextPush);
+        }
+        const auto Now = std::chrono::steady_clock::now();
+        const auto Wait = NextDue > Now ? std::chrono::duration_cast<std::chrono::nanoseconds>(NextDue - Now)
+                                        : std::chrono::nanoseconds::zero();
+        if (Wait < std::chrono::seconds(RequestTimeout)) {
+          ts.tv_sec = Wait.count() / 1'000'000'000;
+          ts.tv_nsec = Wait.count() % 1'000'000'000;
+        }
+      }
+
       int Result = ppoll(&PollFDs.at(0), PollFDs.size(), &ts, nullptr);
+
+      PushProfileFrames();
       std::vector<struct pollfd> NewPollFDs{};
 
       if (Result > 0) {
@@ -484,6 +996,25 @@ namespace ProcessPipe {
                 break;
               }
             }
+            else if (Event.fd == StatsSocketFD) {
+              if (Event.revents & POLLIN) {
+                // Scrape connection. Dump the current metrics and hang up,
+                // one response per connection like a plaintext exporter.
+                struct sockaddr_storage Addr{};
+                socklen_t AddrSize{};
+                int ScrapeFD = accept(StatsSocketFD, reinterpret_cast<struct sockaddr*>(&Addr), &AddrSize);
+                if (ScrapeFD != -1) {
+                  fextl::string Metrics = Stats::GenerateMetrics();
+                  write(ScrapeFD, Metrics.data(), Metrics.size());
+                  close(ScrapeFD);
+                }
+              }
+            }
+            else if (Event.fd == ProfileStreamSocketFD) {
+              if (Event.revents & POLLIN) {
+                AcceptProfileSubscriber();
+              }
+            }
             else {
               if (Event.revents & POLLIN) {
                 // Data from the socket
@@ -493,6 +1024,7 @@ namespace ProcessPipe {
               if (Event.revents & (POLLHUP | POLLERR | POLLNVAL | POLLRDHUP)) {
                 // Error or hangup, close the socket and erase it from our list
                 Erase = true;
+                Stats::ClientDisconnected(Event.fd);
                 close(Event.fd);
               }
             }
@@ -522,9 +1054,13 @@ namespace ProcessPipe {
       else {
         auto Now = std::chrono::system_clock::now();
         auto Diff = Now - LastDataTime;
+        // The listen sockets always sit in the poll list, only client
+        // connections count towards keeping the server alive.
+        const size_t NumListenSockets = 1 + (StatsSocketFD != -1 ? 1 : 0) + (ProfileStreamSocketFD != -1 ? 1 : 0);
         if (Diff >= std::chrono::seconds(RequestTimeout) &&
             !Foreground &&
-            PollFDs.size() == 1) {
+            PollFDs.size() == NumListenSockets &&
+            ProfileSubscribers.empty()) {
           // If we aren't running in the foreground and we have no connections after a timeout
           // Then we can just go ahead and leave
           ShouldShutdown = true;
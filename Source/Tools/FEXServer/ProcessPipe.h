@@ -5,6 +5,8 @@
 namespace ProcessPipe {
   bool InitializeServerPipe();
   bool InitializeServerSocket();
+  bool InitializeStatsSocket();
+  bool InitializeProfileStreamSocket();
   void WaitForRequests();
   void SetConfiguration(bool Foreground, uint32_t PersistentTimeout);
   void Shutdown();
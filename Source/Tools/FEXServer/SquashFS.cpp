@@ -261,6 +261,15 @@ namespace SquashFS {
       return false;
     }
 
+    // Hint the kernel to start paging the image in. Guests begin probing the
+    // rootfs as soon as the mount is up, and readahead turns the fuse
+    // process's small random image reads into sequential ones done early.
+    int ImageFD = open(LDPath().c_str(), O_RDONLY | O_CLOEXEC);
+    if (ImageFD != -1) {
+      posix_fadvise(ImageFD, 0, 0, POSIX_FADV_WILLNEED);
+      close(ImageFD);
+    }
+
     if (!DowngradeRootFSPipeToReadLock()) {
       LogMan::Msg::EFmt("[FEXServer] Couldn't downgrade read lock");
       return false;
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MIT
+#include "Stats.h"
+
+#include <FEXCore/Utils/Statistics.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/map.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <time.h>
+
+namespace Stats {
+  namespace {
+    struct ClientStats {
+      int32_t PID;
+      fextl::vector<uint64_t> Values;
+      fextl::vector<FEXServerClient::ProfileSampleEntry> Profile;
+    };
+
+    std::mutex StatsLock{};
+    // Keyed by client socket FD so a client that reconnects or dies cleanly
+    // replaces its old snapshot rather than leaving a stale process behind.
+    fextl::map<int, ClientStats> Clients{};
+
+    // Metric names in FEXCore::Statistics enum order. Pushes carry their
+    // counter count explicitly, so a shorter snapshot from an older client
+    // just publishes fewer metrics.
+    constexpr std::array<const char*, FEXCore::Statistics::STAT_LAST> METRIC_NAMES {
+      "fex_blocks_compiled_total",
+      "fex_code_cache_hits_total",
+      "fex_smc_invalidations_total",
+      "fex_sigbus_backpatches_total",
+      "fex_thunk_crossings_total",
+      "fex_syscalls_total",
+      "fex_lookup_l2_hits_total",
+      "fex_lookup_l3_hits_total",
+      "fex_lookup_misses_total",
+      "fex_lookup_l1_rehashes_total",
+      "fex_strex_failures_total",
+    };
+  }
+
+  void Update(int FD, int32_t PID, const uint64_t *Values, uint32_t NumStats) {
+    std::unique_lock lk {StatsLock};
+    auto &Client = Clients[FD];
+    Client.PID = PID;
+    Client.Values.assign(Values, Values + NumStats);
+  }
+
+  void UpdateProfile(int FD, int32_t PID, const FEXServerClient::ProfileSampleEntry *Entries, uint32_t NumEntries) {
+    std::unique_lock lk {StatsLock};
+    auto &Client = Clients[FD];
+    Client.PID = PID;
+    Client.Profile.assign(Entries, Entries + NumEntries);
+
+    // The client can't be trusted to null-terminate its location strings.
+    for (auto &Entry : Client.Profile) {
+      Entry.Location[sizeof(Entry.Location) - 1] = '\0';
+    }
+  }
+
+  void ClientDisconnected(int FD) {
+    std::unique_lock lk {StatsLock};
+    Clients.erase(FD);
+  }
+
+  fextl::string GenerateMetrics() {
+    std::unique_lock lk {StatsLock};
+
+    fextl::string Metrics{};
+    for (size_t Stat = 0; Stat < METRIC_NAMES.size(); ++Stat) {
+      bool EmittedHeader{};
+      for (auto &[FD, Client] : Clients) {
+        if (Stat >= Client.Values.size()) {
+          continue;
+        }
+
+        if (!EmittedHeader) {
+          Metrics += fextl::fmt::format("# TYPE {} counter\n", METRIC_NAMES[Stat]);
+          EmittedHeader = true;
+        }
+
+        Metrics += fextl::fmt::format("{}{{pid=\"{}\"}} {}\n", METRIC_NAMES[Stat], Client.PID, Client.Values[Stat]);
+      }
+    }
+
+    // Flat profile samples. Bounded cardinality: clients only push their
+    // hottest locations.
+    bool EmittedProfileHeader{};
+    for (auto &[FD, Client] : Clients) {
+      for (auto &Entry : Client.Profile) {
+        if (!EmittedProfileHeader) {
+          Metrics += "# TYPE fex_profile_samples_total counter\n";
+          EmittedProfileHeader = true;
+        }
+
+        Metrics += fextl::fmt::format("fex_profile_samples_total{{pid=\"{}\",location=\"{}\"}} {}\n", Client.PID, Entry.Location, Entry.Count);
+      }
+    }
+
+    return Metrics;
+  }
+
+  void SerializeProfileFrame(fextl::vector<char> &Frame) {
+    std::unique_lock lk {StatsLock};
+
+    Frame.clear();
+    Frame.resize(sizeof(FEXServerClient::ProfileStream::FrameHeader));
+
+    auto Append = [&Frame](const void *Data, size_t Size) {
+      const auto Offset = Frame.size();
+      Frame.resize(Offset + Size);
+      memcpy(Frame.data() + Offset, Data, Size);
+    };
+
+    // The per-client records are already stored in wire format, so each one
+    // appends wholesale without any per-field handling.
+    for (auto &[FD, Client] : Clients) {
+      const FEXServerClient::ProfileStream::ProcessHeader Process {
+        .PID = Client.PID,
+        .NumStats = static_cast<uint32_t>(Client.Values.size()),
+        .NumSamples = static_cast<uint32_t>(Client.Profile.size()),
+      };
+      Append(&Process, sizeof(Process));
+      Append(Client.Values.data(), Client.Values.size() * sizeof(uint64_t));
+      Append(Client.Profile.data(), Client.Profile.size() * sizeof(FEXServerClient::ProfileSampleEntry));
+    }
+
+    struct timespec Time{};
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+    const FEXServerClient::ProfileStream::FrameHeader Header {
+      .FrameSize = static_cast<uint32_t>(Frame.size()),
+      .NumProcesses = static_cast<uint32_t>(Clients.size()),
+      .TimestampNS = static_cast<uint64_t>(Time.tv_sec) * 1'000'000'000ULL + Time.tv_nsec,
+    };
+    memcpy(Frame.data(), &Header, sizeof(Header));
+  }
+}
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "Common/FEXServerClient.h"
+
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstdint>
+
+namespace Stats {
+  void Update(int FD, int32_t PID, const uint64_t *Values, uint32_t NumStats);
+  void UpdateProfile(int FD, int32_t PID, const FEXServerClient::ProfileSampleEntry *Entries, uint32_t NumEntries);
+  void ClientDisconnected(int FD);
+  fextl::string GenerateMetrics();
+  // Serializes one binary profile stream frame from the current aggregation
+  // state. The buffer is reused by the caller across pushes.
+  void SerializeProfileFrame(fextl::vector<char> &Frame);
+}
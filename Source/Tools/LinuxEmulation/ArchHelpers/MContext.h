@@ -45,6 +45,10 @@ struct X86ContextBackup {
   // Guest state
   int Signal;
   uint32_t Flags;
+  // EFLAGS value materialized in to the guest context at delivery. Compared
+  // against the context coming back from the handler so sigreturn only pays
+  // the compacted-flag decode when the handler actually changed FLAGS.
+  uint32_t DeliveredEFLAGS;
   uint64_t OriginalRIP;
   uint64_t FPStateLocation;
   uint64_t UContextLocation;
@@ -72,6 +76,9 @@ struct ArmContextBackup {
   // Guest state
   int Signal;
   uint32_t Flags;
+  // Same role as in X86ContextBackup: lets sigreturn skip the flag decode
+  // when the handler left FLAGS untouched.
+  uint32_t DeliveredEFLAGS;
   uint64_t OriginalRIP;
   uint64_t FPStateLocation;
   uint64_t UContextLocation;
@@ -15,6 +15,7 @@ $end_info$
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Core/CPUID.h>
 #include <FEXCore/Utils/CPUInfo.h>
+#include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/string.h>
@@ -65,6 +66,33 @@ namespace FEX::EmulatedFile {
       F_SEAL_FUTURE_WRITE);
   }
 
+  int32_t EmulatedFDManager::OpenCachedFD(const char *pathname, int32_t flags, const std::function<fextl::string()> &GenerateContent) {
+    int32_t MasterFD{};
+    {
+      std::lock_guard lk(CachedFDMutex);
+      auto it = CachedFDs.find(pathname);
+      if (it == CachedFDs.end()) {
+        const fextl::string Contents = GenerateContent();
+        int32_t FD = GenTmpFD(pathname, O_CLOEXEC);
+        if (FD == -1) {
+          return -1;
+        }
+        write(FD, Contents.data(), Contents.size());
+        lseek(FD, 0, SEEK_SET);
+        SealTmpFD(FD);
+        it = CachedFDs.emplace(pathname, FD).first;
+      }
+      MasterFD = it->second;
+    }
+
+    // Reopen the sealed memfd through procfs. The guest gets a fresh file
+    // description with its own offset while sharing the generated content,
+    // so every open after the first skips regeneration entirely.
+    char ProcFDPath[32];
+    snprintf(ProcFDPath, sizeof(ProcFDPath), "/proc/self/fd/%d", MasterFD);
+    return open(ProcFDPath, O_RDONLY | (flags & O_CLOEXEC));
+  }
+
   fextl::string GenerateCPUInfo(FEXCore::Context::Context *ctx, uint32_t CPUCores) {
     fextl::ostringstream cpu_stream{};
     auto res_0  = ctx->RunCPUIDFunction(0, 0);
@@ -634,88 +662,170 @@ namespace FEX::EmulatedFile {
     return cpu_stream.str();
   }
 
+  // Guest-visible CPU count. Virtualized when VirtualCPUCount is set so the
+  // emulated procfs/sysfs surface matches what CPUID advertises, host count
+  // otherwise.
+  static uint32_t GuestCPUCount() {
+    FEX_CONFIG_OPT(VirtualCPUCount, VIRTUALCPUCOUNT);
+    return VirtualCPUCount() ? VirtualCPUCount() : FEXCore::CPUInfo::CalculateNumberOfCPUs();
+  }
+
   EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context *ctx)
     : CTX {ctx}
-    , ThreadsConfig { FEXCore::CPUInfo::CalculateNumberOfCPUs() } {
+    , ThreadsConfig { GuestCPUCount() } {
     FDReadCreators["/proc/cpuinfo"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      // Only allow a single thread to initialize the cpu_info.
-      // Jit in-case multiple threads try to initialize at once.
-      // Check if deferred cpuinfo initialization has occured.
-      std::call_once(cpu_info_initialized, [&]() { cpu_info = GenerateCPUInfo(ctx, ThreadsConfig); });
-
-      int FD = GenTmpFD(pathname, flags);
-      write(FD, (void*)&cpu_info.at(0), cpu_info.size());
-      lseek(FD, 0, SEEK_SET);
-      SealTmpFD(FD);
-      return FD;
+      // Generation only happens on the first open, the cache lock serializes racing threads.
+      return OpenCachedFD(pathname, flags, [&]() -> fextl::string {
+        return GenerateCPUInfo(ctx, ThreadsConfig);
+      });
     };
 
     FDReadCreators["/proc/sys/kernel/osrelease"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD(pathname, flags);
-      uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      char Tmp[64]{};
-      snprintf(Tmp, sizeof(Tmp), "%d.%d.%d\n",
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-      // + 1 to ensure null at the end
-      write(FD, Tmp, strlen(Tmp) + 1);
-      lseek(FD, 0, SEEK_SET);
-      SealTmpFD(FD);
-      return FD;
+      return OpenCachedFD(pathname, flags, []() -> fextl::string {
+        uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
+        char Tmp[64]{};
+        snprintf(Tmp, sizeof(Tmp), "%d.%d.%d\n",
+          FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
+        // + 1 to ensure null at the end
+        return fextl::string(Tmp, strlen(Tmp) + 1);
+      });
     };
 
     FDReadCreators["/proc/version"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD(pathname, flags);
-      // UTS version NEEDS to be in a format that can pass to `date -d`
-      // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
-      const char kernel_version[] = "Linux version %d.%d.%d (FEX@FEX) (clang) #" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__ "\n";
-      uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      char Tmp[sizeof(kernel_version) + 64]{};
-      snprintf(Tmp, sizeof(Tmp), kernel_version,
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-      // + 1 to ensure null at the end
-      write(FD, Tmp, strlen(Tmp) + 1);
-      lseek(FD, 0, SEEK_SET);
-      SealTmpFD(FD);
-      return FD;
+      return OpenCachedFD(pathname, flags, []() -> fextl::string {
+        // UTS version NEEDS to be in a format that can pass to `date -d`
+        // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
+        const char kernel_version[] = "Linux version %d.%d.%d (FEX@FEX) (clang) #" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__ "\n";
+        uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
+        char Tmp[sizeof(kernel_version) + 64]{};
+        snprintf(Tmp, sizeof(Tmp), kernel_version,
+          FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
+        // + 1 to ensure null at the end
+        return fextl::string(Tmp, strlen(Tmp) + 1);
+      });
     };
 
     auto NumCPUCores = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD(pathname, flags);
-      write(FD, (void*)&cpus_online.at(0), cpus_online.size());
-      lseek(FD, 0, SEEK_SET);
-      SealTmpFD(FD);
-      return FD;
+      return OpenCachedFD(pathname, flags, [&]() -> fextl::string {
+        return cpus_online;
+      });
     };
 
     FDReadCreators["/sys/devices/system/cpu/online"] = NumCPUCores;
     FDReadCreators["/sys/devices/system/cpu/present"] = NumCPUCores;
 
+    // Formats a cpumask the way the kernel's bitmap printer does.
+    // Comma separated 32-bit groups, most significant group first, only the
+    // leading group loses its zero padding.
+    // A negative OnlyCPU selects every core.
+    auto GenerateCPUMask = [](uint32_t NumCPUs, int64_t OnlyCPU) -> fextl::string {
+      fextl::string Mask{};
+      for (uint32_t Group = (NumCPUs + 31) / 32; Group-- > 0;) {
+        uint32_t Bits{};
+        for (uint32_t Bit = 0; Bit < 32; ++Bit) {
+          const uint32_t CPU = Group * 32 + Bit;
+          if (CPU >= NumCPUs) {
+            break;
+          }
+          if (OnlyCPU < 0 || static_cast<uint32_t>(OnlyCPU) == CPU) {
+            Bits |= 1U << Bit;
+          }
+        }
+        if (Mask.empty()) {
+          Mask = fextl::fmt::format("{:x}", Bits);
+        }
+        else {
+          Mask += fextl::fmt::format(",{:08x}", Bits);
+        }
+      }
+      return Mask;
+    };
+
+    auto StringFile = [&](fextl::string Contents) -> FDReadStringFunc {
+      return [this, Contents = std::move(Contents)](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
+        return OpenCachedFD(pathname, flags, [&]() -> fextl::string {
+          return Contents;
+        });
+      };
+    };
+
+    // Topology information for guest schedulers and thread pools.
+    // Matches the flat view that CPUID leaf 0xB and /proc/cpuinfo present:
+    // one socket, one NUMA node, one thread per core. Without these nodes
+    // topology-aware runtimes silently fall back to worst-case assumptions.
+    const fextl::string AllCPUsList = ThreadsConfig > 1 ? fextl::fmt::format("0-{}", ThreadsConfig - 1) : fextl::string("0");
+    const fextl::string AllCPUsMask = GenerateCPUMask(ThreadsConfig, -1);
+
+    for (uint32_t i = 0; i < ThreadsConfig; ++i) {
+      const auto Topology = fextl::fmt::format("/sys/devices/system/cpu/cpu{}/topology/", i);
+      const auto ThisCPUList = fextl::fmt::format("{}", i);
+      const auto ThisCPUMask = GenerateCPUMask(ThreadsConfig, i);
+
+      FDReadCreators[Topology + "physical_package_id"] = StringFile("0");
+      FDReadCreators[Topology + "core_id"] = StringFile(ThisCPUList);
+
+      // Thread level, each core is its own singleton sibling set.
+      FDReadCreators[Topology + "thread_siblings"] = StringFile(ThisCPUMask);
+      FDReadCreators[Topology + "thread_siblings_list"] = StringFile(ThisCPUList);
+      FDReadCreators[Topology + "core_cpus"] = StringFile(ThisCPUMask);
+      FDReadCreators[Topology + "core_cpus_list"] = StringFile(ThisCPUList);
+
+      // Package level, every core shares the single socket.
+      FDReadCreators[Topology + "core_siblings"] = StringFile(AllCPUsMask);
+      FDReadCreators[Topology + "core_siblings_list"] = StringFile(AllCPUsList);
+      FDReadCreators[Topology + "package_cpus"] = StringFile(AllCPUsMask);
+      FDReadCreators[Topology + "package_cpus_list"] = StringFile(AllCPUsList);
+    }
+
+    // Transparent hugepage controls. Guest databases and runtimes probe these
+    // before enabling their hugepage paths, so mirror the host's state - that
+    // is what the host kernel will actually honor for the guest's mappings.
+    // Hosts without the sysfs nodes get sane defaults so the probe still
+    // succeeds instead of silently disabling the guest's hugepage support.
+    auto HostSysFileOr = [](const char *Path, const char *Default) -> fextl::string {
+      fextl::string Data{};
+      if (FEXCore::FileLoading::LoadFile(Data, Path) && !Data.empty()) {
+        return Data;
+      }
+      return Default;
+    };
+
+    const char THPBase[] = "/sys/kernel/mm/transparent_hugepage/";
+    FDReadCreators[fextl::string(THPBase) + "enabled"] =
+      StringFile(HostSysFileOr("/sys/kernel/mm/transparent_hugepage/enabled", "always [madvise] never\n"));
+    FDReadCreators[fextl::string(THPBase) + "shmem_enabled"] =
+      StringFile(HostSysFileOr("/sys/kernel/mm/transparent_hugepage/shmem_enabled", "always within_size [advise] never deny force\n"));
+    FDReadCreators[fextl::string(THPBase) + "hpage_pmd_size"] =
+      StringFile(HostSysFileOr("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "2097152\n"));
+
+    // Single NUMA node covering every core, for libnuma and friends.
+    FDReadCreators["/sys/devices/system/node/online"] = StringFile("0");
+    FDReadCreators["/sys/devices/system/node/possible"] = StringFile("0");
+    FDReadCreators["/sys/devices/system/node/node0/cpulist"] = StringFile(AllCPUsList);
+    FDReadCreators["/sys/devices/system/node/node0/cpumap"] = StringFile(AllCPUsMask);
+
     fextl::string procAuxv = fextl::fmt::format("/proc/{}/auxv", getpid());
 
     FDReadCreators[procAuxv] = &EmulatedFDManager::ProcAuxv;
     FDReadCreators["/proc/self/auxv"] = &EmulatedFDManager::ProcAuxv;
 
     auto cmdline_handler = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD(pathname, flags);
-      auto CodeLoader = FEX::HLE::_SyscallHandler->GetCodeLoader();
-      auto Args = CodeLoader->GetApplicationArguments();
-      char NullChar{};
-      // cmdline is an array of null terminated arguments
-      for (size_t i = 0; i < Args->size(); ++i) {
-        auto &Arg = Args->at(i);
-        write(FD, Arg.c_str(), Arg.size());
-        // Finish off with a null terminator
-        write(FD, &NullChar, sizeof(uint8_t));
-      }
-
-      // One additional null terminator to finish the list
-      lseek(FD, 0, SEEK_SET);
-      SealTmpFD(FD);
-      return FD;
+      return OpenCachedFD(pathname, flags, []() -> fextl::string {
+        auto CodeLoader = FEX::HLE::_SyscallHandler->GetCodeLoader();
+        auto Args = CodeLoader->GetApplicationArguments();
+        fextl::string CmdLine{};
+        // cmdline is an array of null terminated arguments
+        for (size_t i = 0; i < Args->size(); ++i) {
+          CmdLine.append(Args->at(i));
+          // Finish off with a null terminator
+          CmdLine.push_back('\0');
+        }
+        return CmdLine;
+      });
     };
 
     FDReadCreators["/proc/self/cmdline"] = cmdline_handler;
@@ -731,6 +841,9 @@ namespace FEX::EmulatedFile {
   }
 
   EmulatedFDManager::~EmulatedFDManager() {
+    for (auto &it : CachedFDs) {
+      close(it.second);
+    }
   }
 
   int32_t EmulatedFDManager::OpenAt(int dirfs, const char *pathname, int flags, uint32_t mode) {
@@ -12,6 +12,7 @@ $end_info$
 
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <sys/types.h>
 
 namespace FEXCore::Context {
@@ -28,11 +29,17 @@ namespace FEX::EmulatedFile {
     private:
       FEXCore::Context::Context *CTX;
       fextl::string cpus_online{};
-      std::once_flag cpu_info_initialized{};
-      fextl::string cpu_info{};
       using FDReadStringFunc = std::function<int32_t(FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode)>;
       fextl::unordered_map<fextl::string, FDReadStringFunc> FDReadCreators;
 
+      // Master sealed memfds for emulated files whose content is fixed for the
+      // lifetime of the process. Content is generated once on the first open,
+      // later opens reopen the sealed memfd through procfs so each guest FD
+      // gets an independent offset without regenerating anything.
+      std::mutex CachedFDMutex{};
+      fextl::unordered_map<fextl::string, int32_t> CachedFDs;
+      int32_t OpenCachedFD(const char *pathname, int32_t flags, const std::function<fextl::string()> &GenerateContent);
+
       static int32_t ProcAuxv(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode);
       const uint32_t ThreadsConfig;
   };
@@ -31,7 +31,9 @@ $end_info$
 #include <fcntl.h>
 #include <filesystem>
 #include <optional>
+#include <shared_mutex>
 #include <stdio.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/xattr.h>
@@ -250,6 +252,16 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
     if (RootFSFD == -1) {
       RootFSFD = AT_FDCWD;
     }
+    else {
+      // Watch the overlay folder so cached negative lookups get dropped when
+      // something changes it behind our back. Only the top level folder is
+      // watched; squashfs and erofs images are immutable so deeper changes can
+      // only happen on the uncommon writable rootfs setups.
+      RootFSInotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (RootFSInotifyFD != -1) {
+        inotify_add_watch(RootFSInotifyFD, LDPath().c_str(), IN_CREATE | IN_DELETE | IN_MOVE);
+      }
+    }
   }
 
   fextl::unordered_map<fextl::string, ThunkDBObject> ThunkDB;
@@ -377,6 +389,46 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
 
 FileManager::~FileManager() {
   close(RootFSFD);
+  if (RootFSInotifyFD != -1) {
+    close(RootFSInotifyFD);
+  }
+}
+
+bool FileManager::IsRootFSLookupCachedMissing(const char *Filepath) {
+  {
+    std::shared_lock lk{RootFSLookupCacheMutex};
+    if (RootFSLookupMissingCache.find(Filepath) == RootFSLookupMissingCache.end()) {
+      return false;
+    }
+  }
+
+  // About to skip the rootfs lookup entirely. Drain the overlay watch first so
+  // a file that appeared since the miss was cached gets picked up again.
+  if (RootFSInotifyFD != -1) {
+    char Buffer[4096];
+    if (read(RootFSInotifyFD, Buffer, sizeof(Buffer)) > 0) {
+      // Something changed in the overlay folder, toss the whole cache.
+      while (read(RootFSInotifyFD, Buffer, sizeof(Buffer)) > 0);
+      InvalidateRootFSLookupCache();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void FileManager::CacheRootFSLookupMissing(const char *Filepath) {
+  std::unique_lock lk{RootFSLookupCacheMutex};
+  // Bound the cache so an application probing unique paths forever can't grow
+  // it without limit.
+  if (RootFSLookupMissingCache.size() < 16384) {
+    RootFSLookupMissingCache.emplace(Filepath);
+  }
+}
+
+void FileManager::InvalidateRootFSLookupCache() {
+  std::unique_lock lk{RootFSLookupCacheMutex};
+  RootFSLookupMissingCache.clear();
 }
 
 fextl::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlink) {
@@ -455,6 +507,12 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
   };
 
   if (FollowSymlink) {
+    // If we already know the file doesn't exist in the rootfs then skip the
+    // stat and symlink walk entirely.
+    if (IsRootFSLookupCachedMissing(pathname)) {
+      return NoEntry;
+    }
+
     // Check if the combination of RootFS FD and subpath with the front '/' stripped off is a symlink.
     bool HadAtLeastOne{};
     struct stat Buffer{};
@@ -465,6 +523,7 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
       int Result = fstatat(RootFSFD, &SubPath[1], &Buffer, AT_SYMLINK_NOFOLLOW);
       if (Result != 0 && errno == ENOENT && !HadAtLeastOne) {
         // Initial file didn't exist at all
+        CacheRootFSLookupMissing(pathname);
         return NoEntry;
       }
 
@@ -506,6 +565,11 @@ std::pair<int, const char*> FileManager::GetEmulatedFDPath(int dirfd, const char
   return std::make_pair(RootFSFD, &SubPath[1]);
 }
 
+void FileManager::UpdatePID(uint32_t PID) {
+  CurrentPID = PID;
+  snprintf(PidSelfPath, sizeof(PidSelfPath), "/proc/%i/exe", PID);
+}
+
 std::optional<std::string_view> FileManager::GetSelf(const char *Pathname) {
   if (SupportsProcFSInterpreter) {
     // FEX doesn't need to track procfs/exe if this is supported.
@@ -516,8 +580,11 @@ std::optional<std::string_view> FileManager::GetSelf(const char *Pathname) {
     return std::nullopt;
   }
 
-  char PidSelfPath[50];
-  snprintf(PidSelfPath, 50, "/proc/%i/exe", CurrentPID);
+  // Only procfs paths can refer to the emulated executable. This runs on
+  // every path syscall, so reject everything else on the prefix alone.
+  if (strncmp(Pathname, "/proc/", 6) != 0) {
+    return Pathname;
+  }
 
   if (strcmp(Pathname, "/proc/self/exe") == 0 ||
       strcmp(Pathname, "/proc/thread-self/exe") == 0 ||
@@ -547,38 +614,132 @@ static bool ShouldSkipOpenInEmu(int flags) {
   return false;
 }
 
+std::optional<FileManager::FDAttributes> FileManager::LookupFDAttributes(int fd) {
+  std::shared_lock lk{FDAttributesMutex};
+  if (fd < 0 || static_cast<size_t>(fd) >= FDAttributesCache.size() ||
+      !FDAttributesCache[fd].Tracked) {
+    return std::nullopt;
+  }
+  return FDAttributesCache[fd];
+}
+
+void FileManager::TrackFDAttributes(int fd, bool IsEmulated, bool IsRootFS, bool CloseOnExec, fextl::string HostPath) {
+  if (fd < 0) {
+    return;
+  }
+  std::unique_lock lk{FDAttributesMutex};
+  if (static_cast<size_t>(fd) >= FDAttributesCache.size()) {
+    FDAttributesCache.resize(fd + 1);
+  }
+  FDAttributesCache[fd] = FDAttributes {
+    .Tracked = true,
+    .IsEmulated = IsEmulated,
+    .IsRootFS = IsRootFS,
+    .CloseOnExec = CloseOnExec,
+    .HostPath = std::move(HostPath),
+  };
+}
+
+void FileManager::DupFDAttributes(int oldfd, int newfd, bool CloseOnExec) {
+  if (oldfd < 0 || newfd < 0) {
+    return;
+  }
+  std::unique_lock lk{FDAttributesMutex};
+  if (static_cast<size_t>(newfd) >= FDAttributesCache.size()) {
+    FDAttributesCache.resize(newfd + 1);
+  }
+  if (static_cast<size_t>(oldfd) < FDAttributesCache.size() &&
+      FDAttributesCache[oldfd].Tracked) {
+    FDAttributesCache[newfd] = FDAttributesCache[oldfd];
+    FDAttributesCache[newfd].CloseOnExec = CloseOnExec;
+  } else {
+    // dup on to an fd that was tracked replaces it, even if the source is
+    // unknown to us.
+    FDAttributesCache[newfd] = {};
+  }
+}
+
+void FileManager::UntrackFDAttributes(int fd) {
+  std::unique_lock lk{FDAttributesMutex};
+  if (fd >= 0 && static_cast<size_t>(fd) < FDAttributesCache.size()) {
+    FDAttributesCache[fd] = {};
+  }
+}
+
+void FileManager::UntrackFDAttributesRange(unsigned int first, unsigned int last) {
+  std::unique_lock lk{FDAttributesMutex};
+  const auto End = std::min<size_t>(FDAttributesCache.size(), static_cast<size_t>(last) + 1);
+  for (size_t fd = first; fd < End; ++fd) {
+    FDAttributesCache[fd] = {};
+  }
+}
+
 uint64_t FileManager::Open(const char *pathname, int flags, uint32_t mode) {
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->data() : nullptr;
   int fd = -1;
+  bool IsEmulated = false;
+  bool IsRootFS = false;
+  fextl::string HostPath{};
 
   if (!ShouldSkipOpenInEmu(flags)) {
     fd = EmuFD.OpenAt(AT_FDCWD, SelfPath, flags, mode);
-    if (fd == -1) {
+    if (fd != -1) {
+      IsEmulated = true;
+      if (SelfPath) {
+        HostPath = SelfPath;
+      }
+    } else {
       FDPathTmpData TmpFilename;
       auto Path = GetEmulatedFDPath(AT_FDCWD, SelfPath, true, TmpFilename);
       if (Path.first != -1) {
         fd = ::openat(Path.first, Path.second, flags, mode);
+        if (fd != -1) {
+          if (Path.first == AT_FDCWD) {
+            HostPath = Path.second;
+          } else {
+            IsRootFS = true;
+            HostPath = LDPath();
+            HostPath += '/';
+            HostPath += Path.second;
+          }
+        }
       }
     }
   }
 
   if (fd == -1) {
     fd = ::open(SelfPath, flags, mode);
+    if (fd != -1 && SelfPath && SelfPath[0] == '/') {
+      HostPath = SelfPath;
+    }
+  }
+
+  if (fd != -1) {
+    TrackFDAttributes(fd, IsEmulated, IsRootFS, (flags & O_CLOEXEC) != 0, std::move(HostPath));
   }
 
   return fd;
 }
 
 uint64_t FileManager::Close(int fd) {
-  return ::close(fd);
+  uint64_t Result = ::close(fd);
+  if (Result != uint64_t(-1)) {
+    UntrackFDAttributes(fd);
+  }
+  return Result;
 }
 
 uint64_t FileManager::CloseRange(unsigned int first, unsigned int last, unsigned int flags) {
 #ifndef CLOSE_RANGE_CLOEXEC
 #define CLOSE_RANGE_CLOEXEC (1U << 2)
 #endif
-  return ::syscall(SYSCALL_DEF(close_range), first, last, flags);
+  uint64_t Result = ::syscall(SYSCALL_DEF(close_range), first, last, flags);
+  if (Result != uint64_t(-1) && !(flags & CLOSE_RANGE_CLOEXEC)) {
+    // CLOSE_RANGE_CLOEXEC only marks the fds, anything else closed them.
+    UntrackFDAttributesRange(first, last);
+  }
+  return Result;
 }
 
 uint64_t FileManager::Stat(const char *pathname, void *buf) {
@@ -658,12 +819,9 @@ uint64_t FileManager::FAccessat2(int dirfd, const char *pathname, int mode, int
 }
 
 uint64_t FileManager::Readlink(const char *pathname, char *buf, size_t bufsiz) {
-  if (!SupportsProcFSInterpreter) {
-    // calculate the non-self link to exe
+  if (!SupportsProcFSInterpreter && strncmp(pathname, "/proc/", 6) == 0) {
+    // Match the non-self link to exe as well.
     // Some executables do getpid, stat("/proc/$pid/exe")
-    char PidSelfPath[50];
-    snprintf(PidSelfPath, 50, "/proc/%i/exe", CurrentPID);
-
     if (strcmp(pathname, "/proc/self/exe") == 0 ||
         strcmp(pathname, "/proc/thread-self/exe") == 0 ||
         strcmp(pathname, PidSelfPath) == 0) {
@@ -740,10 +898,7 @@ uint64_t FileManager::Readlinkat(int dirfd, const char *pathname, char *buf, siz
     }
   }
 
-  if (!SupportsProcFSInterpreter) {
-    char PidSelfPath[50];
-    snprintf(PidSelfPath, 50, "/proc/%i/exe", CurrentPID);
-
+  if (!SupportsProcFSInterpreter && Path.starts_with("/proc/")) {
     if (Path == "/proc/self/exe" ||
         Path == "/proc/thread-self/exe" ||
         Path == PidSelfPath) {
@@ -776,20 +931,45 @@ uint64_t FileManager::Openat([[maybe_unused]] int dirfs, const char *pathname, i
   const char *SelfPath = NewPath ? NewPath->data() : nullptr;
 
   int32_t fd = -1;
+  bool IsEmulated = false;
+  bool IsRootFS = false;
+  fextl::string HostPath{};
 
   if (!ShouldSkipOpenInEmu(flags)) {
     fd = EmuFD.OpenAt(dirfs, SelfPath, flags, mode);
-    if (fd == -1) {
+    if (fd != -1) {
+      IsEmulated = true;
+      if (SelfPath) {
+        HostPath = SelfPath;
+      }
+    } else {
       FDPathTmpData TmpFilename;
       auto Path = GetEmulatedFDPath(dirfs, SelfPath, true, TmpFilename);
       if (Path.first != -1) {
         fd = ::syscall(SYSCALL_DEF(openat), Path.first, Path.second, flags, mode);
+        if (fd != -1) {
+          if (Path.first == AT_FDCWD) {
+            HostPath = Path.second;
+          } else {
+            IsRootFS = true;
+            HostPath = LDPath();
+            HostPath += '/';
+            HostPath += Path.second;
+          }
+        }
       }
     }
   }
 
   if (fd == -1) {
     fd = ::syscall(SYSCALL_DEF(openat), dirfs, SelfPath, flags, mode);
+    if (fd != -1 && SelfPath && SelfPath[0] == '/') {
+      HostPath = SelfPath;
+    }
+  }
+
+  if (fd != -1) {
+    TrackFDAttributes(fd, IsEmulated, IsRootFS, (flags & O_CLOEXEC) != 0, std::move(HostPath));
   }
 
   return fd;
@@ -801,23 +981,48 @@ uint64_t FileManager::Openat2(int dirfs, const char *pathname, FEX::HLE::open_ho
 
   int32_t fd = -1;
 
+  bool IsEmulated = false;
+  bool IsRootFS = false;
+  fextl::string HostPath{};
+
   if (!ShouldSkipOpenInEmu(how->flags)) {
     fd = EmuFD.OpenAt(dirfs, SelfPath, how->flags, how->mode);
-    if (fd == -1) {
+    if (fd != -1) {
+      IsEmulated = true;
+      if (SelfPath) {
+        HostPath = SelfPath;
+      }
+    } else {
       FDPathTmpData TmpFilename;
       auto Path = GetEmulatedFDPath(dirfs, SelfPath, true, TmpFilename);
       if (Path.first != -1) {
         fd = ::syscall(SYSCALL_DEF(openat2), Path.first, Path.second, how, usize);
+        if (fd != -1) {
+          if (Path.first == AT_FDCWD) {
+            HostPath = Path.second;
+          } else {
+            IsRootFS = true;
+            HostPath = LDPath();
+            HostPath += '/';
+            HostPath += Path.second;
+          }
+        }
       }
     }
   }
 
   if (fd == -1) {
     fd = ::syscall(SYSCALL_DEF(openat2), dirfs, SelfPath, how, usize);
+    if (fd != -1 && SelfPath && SelfPath[0] == '/') {
+      HostPath = SelfPath;
+    }
   }
 
-  return fd;
+  if (fd != -1) {
+    TrackFDAttributes(fd, IsEmulated, IsRootFS, (how->flags & O_CLOEXEC) != 0, std::move(HostPath));
+  }
 
+  return fd;
 }
 
 uint64_t FileManager::Statx(int dirfd, const char *pathname, int flags, uint32_t mask, struct statx *statxbuf) {
@@ -842,8 +1047,11 @@ uint64_t FileManager::Mknod(const char *pathname, mode_t mode, dev_t dev) {
   auto Path = GetEmulatedFDPath(AT_FDCWD, SelfPath, false, TmpFilename);
   if (Path.first != -1) {
     uint64_t Result = ::mknodat(Path.first, Path.second, mode, dev);
-    if (Result != -1)
+    if (Result != -1) {
+      // We created a file in the rootfs, cached negative lookups are stale now.
+      InvalidateRootFSLookupCache();
       return Result;
+    }
   }
   return ::mknod(SelfPath, mode, dev);
 }
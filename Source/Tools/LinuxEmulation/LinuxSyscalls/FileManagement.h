@@ -10,6 +10,7 @@ $end_info$
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/unordered_set.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <cstdint>
 #include <fcntl.h>
@@ -17,6 +18,7 @@ $end_info$
 #include <mutex>
 #include <linux/limits.h>
 #include <optional>
+#include <shared_mutex>
 #include <stddef.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -80,7 +82,7 @@ public:
 
   std::optional<std::string_view> GetSelf(const char *Pathname);
 
-  void UpdatePID(uint32_t PID) { CurrentPID = PID; }
+  void UpdatePID(uint32_t PID);
 
   fextl::string GetEmulatedPath(const char *pathname, bool FollowSymlink = false);
   using FDPathTmpData = std::array<char[PATH_MAX], 2>;
@@ -88,9 +90,28 @@ public:
 
   bool SupportsProcFSInterpreterPath() const { return SupportsProcFSInterpreter; }
 
+  // Per-fd attribute cache.
+  // An fd's classification (emulated file, rootfs ownership, resolved host
+  // path, close-on-exec) is recorded once when the descriptor is created, so
+  // later fd-based queries are an indexed load instead of a /proc/self/fd
+  // readlink or fcntl round-trip. Maintained at open/close/dup time.
+  struct FDAttributes {
+    bool Tracked{};
+    bool IsEmulated{};
+    bool IsRootFS{};
+    bool CloseOnExec{};
+    fextl::string HostPath{};
+  };
+  std::optional<FDAttributes> LookupFDAttributes(int fd);
+  void DupFDAttributes(int oldfd, int newfd, bool CloseOnExec);
+
 private:
   bool RootFSPathExists(const char* Filepath);
 
+  bool IsRootFSLookupCachedMissing(const char *Filepath);
+  void CacheRootFSLookupMissing(const char *Filepath);
+  void InvalidateRootFSLookupCache();
+
   struct ThunkDBObject {
     fextl::string LibraryName;
     fextl::unordered_set<fextl::string> Depends;
@@ -110,7 +131,27 @@ private:
   FEX_CONFIG_OPT(AppConfigName, APP_CONFIG_NAME);
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   uint32_t CurrentPID{};
+  // "/proc/<pid>/exe", formatted once per PID change. Every path syscall
+  // funnels through GetSelf, so this must not be rebuilt per call.
+  char PidSelfPath[50]{};
   int RootFSFD{AT_FDCWD};
   bool SupportsProcFSInterpreter{};
+
+  void TrackFDAttributes(int fd, bool IsEmulated, bool IsRootFS, bool CloseOnExec, fextl::string HostPath);
+  void UntrackFDAttributes(int fd);
+  void UntrackFDAttributesRange(unsigned int first, unsigned int last);
+
+  // Flat fd-indexed attribute array, grown on demand. fds are process global
+  // so concurrent syscall threads share this under the lock.
+  std::shared_mutex FDAttributesMutex;
+  fextl::vector<FDAttributes> FDAttributesCache;
+
+  // Negative dentry cache for rootfs lookups.
+  // Guest application startup probes thousands of paths that don't exist in
+  // the rootfs; remembering the misses lets repeat probes skip the stat and
+  // symlink walk entirely.
+  std::shared_mutex RootFSLookupCacheMutex;
+  fextl::unordered_set<fextl::string> RootFSLookupMissingCache;
+  int RootFSInotifyFD{-1};
 };
 }
@@ -22,6 +22,7 @@ $end_info$
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/HLE/Linux/ThreadManagement.h>
 #include <FEXCore/HLE/SyscallHandler.h>
+#include <FEXCore/Utils/CompileTimeTelemetry.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/FileLoading.h>
 #include <FEXCore/Utils/NetStream.h>
@@ -197,12 +198,18 @@ static fextl::string hexstring(fextl::istringstream &ss, int delm) {
 }
 
 static fextl::string encodeHex(const unsigned char *data, size_t length) {
-  fextl::ostringstream ss;
+  constexpr char Nibbles[] = "0123456789abcdef";
+  fextl::string ret;
+  ret.resize(length * 2);
 
-  for (size_t i=0; i < length; i++) {
-    ss << std::setfill('0') << std::setw(2) << std::hex << int(data[i]);
+  // GDB reads memory in PacketSize chunks, so this encodes up to 32KB per
+  // packet. Formatting through an ostringstream per byte dominates large
+  // transfers; index a nibble table instead.
+  for (size_t i = 0; i < length; i++) {
+    ret[i * 2 + 0] = Nibbles[data[i] >> 4];
+    ret[i * 2 + 1] = Nibbles[data[i] & 0xF];
   }
-  return ss.str();
+  return ret;
 }
 
 static fextl::string encodeHex(std::string_view str) {
@@ -272,7 +279,8 @@ fextl::string GdbServer::ReadPacket(std::iostream &stream) {
 }
 
 static fextl::string escapePacket(const fextl::string& packet) {
-  fextl::ostringstream ss;
+  fextl::string ret;
+  ret.reserve(packet.size());
 
   for(const auto &c : packet) {
     switch (c) {
@@ -281,16 +289,17 @@ static fextl::string escapePacket(const fextl::string& packet) {
       case '*':
       case '}': {
         char escaped = c ^ 0x20;
-        ss << '}' << (escaped);
+        ret.push_back('}');
+        ret.push_back(escaped);
         break;
       }
       default:
-        ss << c;
+        ret.push_back(c);
         break;
     }
   }
 
-  return ss.str();
+  return ret;
 }
 
 void GdbServer::SendPacket(std::ostream &stream, const fextl::string& packet) {
@@ -605,9 +614,18 @@ fextl::string buildOSData() {
   return xml.str();
 }
 
+bool GdbServer::LibrariesChanged() const {
+  // Library load/unload is always an mmap/munmap of a file, so any load since
+  // the list was built has moved the VMA generation stamp. Mutations that
+  // aren't library changes also move it and only cost a rebuild.
+  return SyscallHandler->VMAGeneration() != LibraryMapGeneration;
+}
+
 void GdbServer::buildLibraryMap() {
-  if (!LibraryMapChanged) {
-    // No need to update
+  const uint64_t Generation = SyscallHandler->VMAGeneration();
+  if (Generation == LibraryMapGeneration) {
+    // No mapping has changed since the cached list was built. IDE debuggers
+    // poll this endpoint continuously, so this is the common path.
     return;
   }
 
@@ -679,7 +697,7 @@ void GdbServer::buildLibraryMap() {
   xml << "</library-list>\n";
 
   LibraryMapString = xml.str();
-  LibraryMapChanged = false;
+  LibraryMapGeneration = Generation;
 }
 
 GdbServer::HandledPacketType GdbServer::handleXfer(const fextl::string &packet) {
@@ -810,8 +828,12 @@ GdbServer::HandledPacketType GdbServer::handleXfer(const fextl::string &packet)
   return {"", HandledPacketType::TYPE_UNKNOWN};
 }
 
-static size_t CheckMemMapping(uint64_t Address, size_t Size) {
-  uint64_t AddressEnd = Address + Size;
+void GdbServer::RefreshMemMapCache() {
+  // Stamp before parsing: a mutation racing the parse leaves the stamp stale
+  // and the next check refreshes again, rather than trusting a torn snapshot.
+  MemMapCacheGeneration = SyscallHandler->VMAGeneration();
+  MemMapCache.clear();
+
   fextl::string MapsFile;
   FEXCore::FileLoading::LoadFile(MapsFile, "/proc/self/maps");
   fextl::istringstream MapsStream(MapsFile);
@@ -823,18 +845,50 @@ static size_t CheckMemMapping(uint64_t Address, size_t Size) {
     uint64_t Begin, End;
     char r,w,x,p;
     if (sscanf(Line.c_str(), "%lx-%lx %c%c%c%c", &Begin, &End, &r, &w, &x, &p) == 6) {
-      if (Begin <= Address &&
-          End > Address) {
-        ssize_t Overrun{};
-        if (AddressEnd > End) {
-          Overrun = AddressEnd - End;
-        }
-        return Size - Overrun;
+      MemMapCache.emplace_back(MemMapping { Begin, End });
+    }
+  }
+}
+
+size_t GdbServer::CheckMemMapping(uint64_t Address, size_t Size) {
+  const uint64_t AddressEnd = Address + Size;
+
+  const auto FindMapping = [this](uint64_t Address) -> const MemMapping* {
+    for (const auto &Mapping : MemMapCache) {
+      if (Mapping.Begin <= Address && Mapping.End > Address) {
+        return &Mapping;
       }
     }
+    return nullptr;
+  };
+
+  // GDB walks large transfers as a run of chunked reads, which all land in the
+  // same snapshot of the maps. Re-read and re-parse the maps file only when
+  // the VMA generation stamp shows the guest has changed its mappings - which
+  // also catches unmapped ranges the old snapshot would still claim - or when
+  // an address misses the snapshot, which covers host-side mappings the
+  // tracking never sees.
+  bool Refreshed = false;
+  if (SyscallHandler->VMAGeneration() != MemMapCacheGeneration) {
+    RefreshMemMapCache();
+    Refreshed = true;
+  }
+
+  auto Mapping = FindMapping(Address);
+  if (!Mapping && !Refreshed) {
+    RefreshMemMapCache();
+    Mapping = FindMapping(Address);
+  }
+
+  if (!Mapping) {
+    return 0;
   }
 
-  return 0;
+  ssize_t Overrun{};
+  if (AddressEnd > Mapping->End) {
+    Overrun = AddressEnd - Mapping->End;
+  }
+  return Size - Overrun;
 }
 
 GdbServer::HandledPacketType GdbServer::handleProgramOffsets() {
@@ -1034,6 +1088,22 @@ GdbServer::HandledPacketType GdbServer::handleQuery(const fextl::string &packet)
     }
   }
 
+  if (match("qRcmd,")) {
+    // gdb `monitor` commands arrive hex encoded after the comma.
+    auto ss = fextl::istringstream(packet.substr(strlen("qRcmd,")));
+    const auto Command = hexstring(ss, -1);
+
+    if (Command == "compiletime") {
+      auto Dump = FEXCore::CompileTime::Dump();
+      if (Dump.empty()) {
+        Dump = "No compile time data recorded. Enable the CompileTimeTelemetry config option.\n";
+      }
+      return {encodeHex(Dump), HandledPacketType::TYPE_ACK};
+    }
+
+    return {"", HandledPacketType::TYPE_UNKNOWN};
+  }
+
   if (match("QPassSignals")) {
     // First set all signals as unpassed
     std::fill(PassSignals.begin(), PassSignals.end(), false);
@@ -1124,7 +1194,7 @@ GdbServer::HandledPacketType GdbServer::ThreadAction(char action, uint32_t tid)
       SyscallHandler->TM.Step();
       SendPacketPair({"OK", HandledPacketType::TYPE_ACK});
       fextl::string str = fextl::fmt::format("T05thread:{:02x};", getpid());
-      if (LibraryMapChanged) {
+      if (LibrariesChanged()) {
         // If libraries have changed then let gdb know
         str += "library:1;";
       }
@@ -1263,18 +1333,48 @@ GdbServer::HandledPacketType GdbServer::handleThreadOp(const fextl::string &pack
 GdbServer::HandledPacketType GdbServer::handleBreakpoint(const fextl::string &packet) {
   auto ss = fextl::istringstream(packet);
 
-  // Don't do anything with set breakpoints yet
-  [[maybe_unused]] bool Set{};
+  // Packet format: Z<Type>,<Addr>,<Kind>
+  bool Set{};
   uint64_t Addr;
   uint64_t Type;
+  uint64_t Kind;
   Set = ss.get() == 'Z';
 
+  ss >> std::hex >> Type;
+  ss.get(); // discard comma
   ss >> std::hex >> Addr;
   ss.get(); // discard comma
-  ss >> std::hex >> Type;
+  ss >> std::hex >> Kind;
 
   SyscallHandler->TM.Pause();
-  return {"OK", HandledPacketType::TYPE_ACK};
+
+  switch (Type) {
+    case 2:   // Write watchpoint
+    case 3:   // Read watchpoint
+    case 4: { // Access watchpoint
+      // Kind carries the watched byte length for watchpoints
+      const auto WatchType = Type == 2 ? FEXCore::Context::WatchpointType::WRITE :
+                                         FEXCore::Context::WatchpointType::READWRITE;
+
+      const bool Changed = Set ? CTX->SetGuestWatchpoint(Addr, Kind, WatchType) :
+                                 CTX->ClearGuestWatchpoint(Addr, Kind);
+      if (!Changed) {
+        return {"E00", HandledPacketType::TYPE_ACK};
+      }
+
+      // Throw away every translation so blocks recompile with the watchpoint
+      // checks folded in, or without them once the last watchpoint is gone.
+      // Blocks compiled while no watchpoints are active carry zero overhead,
+      // so detaching returns the guest to full speed.
+      SyscallHandler->TM.InvalidateGuestCodeRange(nullptr, 0, ~0ULL);
+      return {"OK", HandledPacketType::TYPE_ACK};
+    }
+    default:
+      // Breakpoints are unsupported here. An empty reply makes gdb plant int3
+      // through memory writes instead, which SMC tracking picks up like any
+      // other code modification
+      return {"", HandledPacketType::TYPE_UNKNOWN};
+  }
 }
 
 GdbServer::HandledPacketType GdbServer::ProcessPacket(const fextl::string &packet) {
@@ -1419,7 +1519,7 @@ void GdbServer::GdbServerLoop() {
         case '\x03': { // ASCII EOT
             SyscallHandler->TM.Pause();
             fextl::string str = fextl::fmt::format("T02thread:{:02x};", getpid());
-            if (LibraryMapChanged) {
+            if (LibrariesChanged()) {
               // If libraries have changed then let gdb know
               str += "library:1;";
             }
@@ -12,6 +12,7 @@ $end_info$
 #include <FEXCore/Utils/Threads.h>
 #include <FEXCore/fextl/memory.h>
 #include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <atomic>
 #include <istream>
@@ -31,10 +32,6 @@ public:
     // Public for threading
     void GdbServerLoop();
 
-    void AlertLibrariesChanged() {
-      LibraryMapChanged = true;
-    }
-
 private:
     void Break(int signal);
 
@@ -80,6 +77,25 @@ private:
 
     HandledPacketType ThreadAction(char action, uint32_t tid);
 
+    // Cached snapshot of /proc/self/maps so chunked memory transfers don't
+    // re-parse the file per packet. Refreshed when the VMA generation stamp
+    // moves or a lookup misses.
+    struct MemMapping {
+      uint64_t Begin;
+      uint64_t End;
+    };
+    void RefreshMemMapCache();
+    size_t CheckMemMapping(uint64_t Address, size_t Size);
+    fextl::vector<MemMapping> MemMapCache{};
+
+    // The VMAGeneration() stamps the cache above and the library list were
+    // built at. NEVER_BUILT never compares equal to a live stamp, forcing the
+    // first build.
+    constexpr static uint64_t NEVER_BUILT = ~0ULL;
+    uint64_t MemMapCacheGeneration = NEVER_BUILT;
+    uint64_t LibraryMapGeneration = NEVER_BUILT;
+    bool LibrariesChanged() const;
+
     fextl::string readRegs();
     HandledPacketType readReg(const fextl::string& packet);
 
@@ -94,7 +110,6 @@ private:
     fextl::string ThreadString{};
     fextl::string OSDataString{};
     void buildLibraryMap();
-    std::atomic<bool> LibraryMapChanged = true;
     std::atomic<bool> CoreShuttingDown{};
     fextl::string LibraryMapString{};
 
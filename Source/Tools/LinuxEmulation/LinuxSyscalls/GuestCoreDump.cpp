@@ -0,0 +1,440 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+category: LinuxSyscalls ~ Linux syscall emulation, marshaling and passthrough
+tags: LinuxSyscalls|common
+desc: Guest-scoped sparse ELF core dump writer
+$end_info$
+*/
+
+#include "LinuxSyscalls/Syscalls.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/Utils/Threads.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/vector.h>
+#include <FEXHeaderUtils/Filesystem.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace FEX::HLE {
+namespace {
+  constexpr uint64_t DUMP_PAGE_SIZE = 4096;
+
+  // Segment payloads are read and written in chunks of this size per worker.
+  constexpr size_t WRITER_CHUNK_SIZE = 1024 * 1024;
+
+  // Reading guest memory is cheap next to the disk writes, more workers than
+  // this just fight over the same device queue.
+  constexpr uint32_t MAX_DUMP_WRITERS = 4;
+
+  // e_phnum is 16 bits; a guest with more mappings than this gets a truncated
+  // dump rather than the PN_XNUM extension dance.
+  constexpr size_t MAX_DUMP_SEGMENTS = 65534;
+
+  struct DumpSegment {
+    uint64_t Base;
+    uint64_t Length;
+    uint64_t FileOffset;
+    uint32_t PFlags;
+    bool Dump; ///< false emits the Phdr with p_filesz = 0, contents recoverable from the backing file
+  };
+
+  // elf_prstatus layouts, defined locally since the host libc only provides
+  // its native one and the 32-bit guest needs the i386 shape.
+  struct GuestSigInfo {
+    int32_t Signo;
+    int32_t Code;
+    int32_t Errno;
+  };
+
+  struct PrTimeval64 {
+    int64_t Sec;
+    int64_t USec;
+  };
+
+  struct PrStatus64 {
+    GuestSigInfo Info;
+    int16_t CurSig;
+    uint64_t SigPend;
+    uint64_t SigHold;
+    int32_t Pid;
+    int32_t PPid;
+    int32_t PGrp;
+    int32_t Sid;
+    PrTimeval64 UTime;
+    PrTimeval64 STime;
+    PrTimeval64 CUTime;
+    PrTimeval64 CSTime;
+    uint64_t Regs[27]; ///< x86-64 user_regs_struct order
+    int32_t FPValid;
+  };
+  static_assert(sizeof(PrStatus64) == 336, "Must match the kernel's x86-64 elf_prstatus");
+
+  struct PrTimeval32 {
+    int32_t Sec;
+    int32_t USec;
+  };
+
+  struct PrStatus32 {
+    GuestSigInfo Info;
+    int16_t CurSig;
+    uint32_t SigPend;
+    uint32_t SigHold;
+    int32_t Pid;
+    int32_t PPid;
+    int32_t PGrp;
+    int32_t Sid;
+    PrTimeval32 UTime;
+    PrTimeval32 STime;
+    PrTimeval32 CUTime;
+    PrTimeval32 CSTime;
+    uint32_t Regs[17]; ///< i386 user_regs_struct order
+    int32_t FPValid;
+  };
+  static_assert(sizeof(PrStatus32) == 144, "Must match the kernel's i386 elf_prstatus");
+
+  void FillRegs64(uint64_t (&Regs)[27], const FEXCore::Core::CPUState &State, uint32_t EFlags) {
+    namespace X86 = FEXCore::X86State;
+    const auto &G = State.gregs;
+    Regs[0] = G[X86::REG_R15];
+    Regs[1] = G[X86::REG_R14];
+    Regs[2] = G[X86::REG_R13];
+    Regs[3] = G[X86::REG_R12];
+    Regs[4] = G[X86::REG_RBP];
+    Regs[5] = G[X86::REG_RBX];
+    Regs[6] = G[X86::REG_R11];
+    Regs[7] = G[X86::REG_R10];
+    Regs[8] = G[X86::REG_R9];
+    Regs[9] = G[X86::REG_R8];
+    Regs[10] = G[X86::REG_RAX];
+    Regs[11] = G[X86::REG_RCX];
+    Regs[12] = G[X86::REG_RDX];
+    Regs[13] = G[X86::REG_RSI];
+    Regs[14] = G[X86::REG_RDI];
+    Regs[15] = ~0ULL; // orig_rax: no syscall in flight on a crash
+    Regs[16] = State.rip;
+    Regs[17] = State.cs_cached;
+    Regs[18] = EFlags;
+    Regs[19] = G[X86::REG_RSP];
+    Regs[20] = State.ss_cached;
+    Regs[21] = State.fs_cached;
+    Regs[22] = State.gs_cached;
+    Regs[23] = State.ds_cached;
+    Regs[24] = State.es_cached;
+    // fs/gs selectors aren't tracked, the bases above carry the information
+    Regs[25] = 0;
+    Regs[26] = 0;
+  }
+
+  void FillRegs32(uint32_t (&Regs)[17], const FEXCore::Core::CPUState &State, uint32_t EFlags) {
+    namespace X86 = FEXCore::X86State;
+    const auto &G = State.gregs;
+    Regs[0] = G[X86::REG_RBX];
+    Regs[1] = G[X86::REG_RCX];
+    Regs[2] = G[X86::REG_RDX];
+    Regs[3] = G[X86::REG_RSI];
+    Regs[4] = G[X86::REG_RDI];
+    Regs[5] = G[X86::REG_RBP];
+    Regs[6] = G[X86::REG_RAX];
+    Regs[7] = State.ds_cached;
+    Regs[8] = State.es_cached;
+    Regs[9] = 0;  // xfs
+    Regs[10] = 0; // xgs
+    Regs[11] = ~0U; // orig_eax
+    Regs[12] = State.rip;
+    Regs[13] = State.cs_cached;
+    Regs[14] = EFlags;
+    Regs[15] = G[X86::REG_RSP];
+    Regs[16] = State.ss_cached;
+  }
+
+  struct ElfTraits64 {
+    using Ehdr = Elf64_Ehdr;
+    using Phdr = Elf64_Phdr;
+    using Nhdr = Elf64_Nhdr;
+    using PrStatus = PrStatus64;
+    constexpr static uint8_t Class = ELFCLASS64;
+    constexpr static uint16_t Machine = EM_X86_64;
+  };
+
+  struct ElfTraits32 {
+    using Ehdr = Elf32_Ehdr;
+    using Phdr = Elf32_Phdr;
+    using Nhdr = Elf32_Nhdr;
+    using PrStatus = PrStatus32;
+    constexpr static uint8_t Class = ELFCLASS32;
+    constexpr static uint16_t Machine = EM_386;
+  };
+
+  void Append(fextl::vector<uint8_t> &Out, const void *Data, size_t Size) {
+    const auto *Bytes = static_cast<const uint8_t*>(Data);
+    Out.insert(Out.end(), Bytes, Bytes + Size);
+  }
+
+  // Serializes the Ehdr, Phdr table and NT_PRSTATUS note, assigning each
+  // dumped segment its page-aligned file offset along the way. Returns the
+  // total file size for the ftruncate that materializes the holes.
+  template<typename Traits>
+  uint64_t EmitHeaders(fextl::vector<uint8_t> &Out, fextl::vector<DumpSegment> &Segments, const typename Traits::PrStatus &Status) {
+    const uint64_t PhdrCount = Segments.size() + 1; // + PT_NOTE
+    const uint64_t NoteNameSize = 8;                // "CORE" NUL-padded to 4-byte alignment
+    const uint64_t NoteSize = sizeof(typename Traits::Nhdr) + NoteNameSize + sizeof(Status);
+    const uint64_t NoteOffset = sizeof(typename Traits::Ehdr) + PhdrCount * sizeof(typename Traits::Phdr);
+
+    uint64_t DataOffset = FEXCore::AlignUp(NoteOffset + NoteSize, DUMP_PAGE_SIZE);
+    for (auto &Segment : Segments) {
+      Segment.FileOffset = DataOffset;
+      if (Segment.Dump) {
+        DataOffset += Segment.Length;
+      }
+    }
+
+    typename Traits::Ehdr Ehdr{};
+    memcpy(Ehdr.e_ident, ELFMAG, SELFMAG);
+    Ehdr.e_ident[EI_CLASS] = Traits::Class;
+    Ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+    Ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    Ehdr.e_type = ET_CORE;
+    Ehdr.e_machine = Traits::Machine;
+    Ehdr.e_version = EV_CURRENT;
+    Ehdr.e_phoff = sizeof(Ehdr);
+    Ehdr.e_ehsize = sizeof(Ehdr);
+    Ehdr.e_phentsize = sizeof(typename Traits::Phdr);
+    Ehdr.e_phnum = PhdrCount;
+    Append(Out, &Ehdr, sizeof(Ehdr));
+
+    typename Traits::Phdr Note{};
+    Note.p_type = PT_NOTE;
+    Note.p_offset = NoteOffset;
+    Note.p_filesz = NoteSize;
+    Append(Out, &Note, sizeof(Note));
+
+    for (const auto &Segment : Segments) {
+      typename Traits::Phdr Phdr{};
+      Phdr.p_type = PT_LOAD;
+      Phdr.p_offset = Segment.FileOffset;
+      Phdr.p_vaddr = Segment.Base;
+      Phdr.p_filesz = Segment.Dump ? Segment.Length : 0;
+      Phdr.p_memsz = Segment.Length;
+      Phdr.p_flags = Segment.PFlags;
+      Phdr.p_align = DUMP_PAGE_SIZE;
+      Append(Out, &Phdr, sizeof(Phdr));
+    }
+
+    typename Traits::Nhdr Nhdr{};
+    Nhdr.n_namesz = 5;
+    Nhdr.n_descsz = sizeof(Status);
+    Nhdr.n_type = NT_PRSTATUS;
+    Append(Out, &Nhdr, sizeof(Nhdr));
+    Append(Out, "CORE\0\0\0", NoteNameSize);
+    Append(Out, &Status, sizeof(Status));
+
+    return DataOffset;
+  }
+
+  // Reads through process_vm_readv on ourselves. The kernel validates the
+  // range instead of the worker faulting on it, so a mapping torn down since
+  // the VMA snapshot degrades to a hole rather than a nested crash.
+  size_t SafeReadGuestMemory(uint64_t Address, void *Dest, size_t Size) {
+    iovec Local {
+      .iov_base = Dest,
+      .iov_len = Size,
+    };
+    iovec Remote {
+      .iov_base = reinterpret_cast<void*>(Address),
+      .iov_len = Size,
+    };
+
+    const ssize_t Result = process_vm_readv(::getpid(), &Local, 1, &Remote, 1, 0);
+    return Result < 0 ? 0 : Result;
+  }
+
+  bool IsZeroPage(const uint8_t *Page) {
+    uint64_t Accum{};
+    for (size_t i = 0; i < DUMP_PAGE_SIZE; i += sizeof(uint64_t)) {
+      uint64_t Word;
+      memcpy(&Word, Page + i, sizeof(Word));
+      Accum |= Word;
+    }
+    return Accum == 0;
+  }
+
+  struct WriterContext {
+    const DumpSegment *Segments;
+    size_t SegmentCount;
+    std::atomic<uint32_t> NextSegment{};
+    int FD;
+  };
+
+  void *CoreDumpWriterEntry(void *Arg) {
+    auto *Context = static_cast<WriterContext*>(Arg);
+    fextl::vector<uint8_t> Buffer(WRITER_CHUNK_SIZE);
+
+    for (;;) {
+      const uint32_t Index = Context->NextSegment.fetch_add(1, std::memory_order_relaxed);
+      if (Index >= Context->SegmentCount) {
+        break;
+      }
+
+      const auto &Segment = Context->Segments[Index];
+      if (!Segment.Dump) {
+        continue;
+      }
+
+      for (uint64_t Done = 0; Done < Segment.Length; Done += WRITER_CHUNK_SIZE) {
+        const size_t Chunk = std::min<uint64_t>(WRITER_CHUNK_SIZE, Segment.Length - Done);
+        const size_t Read = SafeReadGuestMemory(Segment.Base + Done, Buffer.data(), Chunk);
+
+        // Coalesce runs of nonzero pages into single pwrites. Zero pages and
+        // anything past a short read stay holes in the file.
+        size_t RunStart{};
+        bool InRun{};
+        for (size_t Offset = 0; Offset < Read; Offset += DUMP_PAGE_SIZE) {
+          const bool Zero = (Read - Offset) >= DUMP_PAGE_SIZE && IsZeroPage(&Buffer[Offset]);
+          if (!Zero && !InRun) {
+            RunStart = Offset;
+            InRun = true;
+          } else if (Zero && InRun) {
+            pwrite(Context->FD, &Buffer[RunStart], Offset - RunStart, Segment.FileOffset + Done + RunStart);
+            InRun = false;
+          }
+        }
+        if (InRun) {
+          pwrite(Context->FD, &Buffer[RunStart], Read - RunStart, Segment.FileOffset + Done + RunStart);
+        }
+      }
+    }
+
+    return nullptr;
+  }
+}
+
+bool SyscallHandler::WriteGuestCoreDump(FEXCore::Core::InternalThreadState *Thread, int Signal, const siginfo_t *Info, const fextl::string &ApplicationName) {
+  FEX_CONFIG_OPT(GuestCoreDump, GUESTCOREDUMP);
+  FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
+  if (!GuestCoreDump() || ApplicationName.empty()) {
+    return false;
+  }
+
+  // The crashing thread can fault while holding the VMA lock (SMC handling,
+  // mid-mmap tracking). Blocking here would turn the crash into a hang, so
+  // bail and let the plain termination path run.
+  if (!VMATracking.Mutex.try_lock_shared()) {
+    return false;
+  }
+
+  // Snapshot the guest mappings so the lock drops before any disk IO.
+  // VMATracking only holds guest mappings, which scopes the dump to the guest
+  // address space for free - JIT buffers and emulator heap never appear here.
+  fextl::vector<DumpSegment> Segments;
+  Segments.reserve(std::min(VMATracking.VMAs.size(), MAX_DUMP_SEGMENTS));
+  for (const auto &[Base, VMA] : VMATracking.VMAs) {
+    if (!VMA.Prot.Readable || Segments.size() == MAX_DUMP_SEGMENTS) {
+      continue;
+    }
+
+    // Match the kernel's default coredump_filter: anonymous memory (private,
+    // shared and sys-v shm) carries guest state and is dumped. File-backed
+    // mappings only hold unique state when privately written; everything else
+    // is recoverable from the file and emitted headers-only.
+    bool Dump = true;
+    if (VMA.Resource) {
+      const uint64_t Dev = VMA.Resource->Iterator->first.dev;
+      if (Dev != SpecialDev::Anon && Dev != SpecialDev::SHM) {
+        Dump = !VMA.Flags.Shared && VMA.Prot.Writable;
+      }
+    }
+
+    Segments.emplace_back(DumpSegment {
+      .Base = VMA.Base,
+      .Length = VMA.Length,
+      .FileOffset = 0,
+      .PFlags = static_cast<uint32_t>((VMA.Prot.Readable ? PF_R : 0) |
+                                      (VMA.Prot.Writable ? PF_W : 0) |
+                                      (VMA.Prot.Executable ? PF_X : 0)),
+      .Dump = Dump,
+    });
+  }
+  VMATracking.Mutex.unlock_shared();
+
+  if (Segments.empty()) {
+    return false;
+  }
+
+  const int32_t PID = ::getpid();
+
+  auto FillStatus = [&](auto &Status, auto &FillRegs) {
+    Status.Info.Signo = Signal;
+    Status.Info.Code = Info->si_code;
+    Status.Info.Errno = Info->si_errno;
+    Status.CurSig = Signal;
+    Status.Pid = FHU::Syscalls::gettid();
+    Status.PPid = PID;
+    FillRegs(Status.Regs, Thread->CurrentFrame->State, CTX->ReconstructCompactedEFLAGS(Thread, false, nullptr, 0));
+  };
+
+  fextl::vector<uint8_t> Headers;
+  fextl::vector<DumpSegment> &Layout = Segments;
+  uint64_t FileSize{};
+  if (Is64BitMode()) {
+    PrStatus64 Status{};
+    FillStatus(Status, FillRegs64);
+    FileSize = EmitHeaders<ElfTraits64>(Headers, Layout, Status);
+  } else {
+    PrStatus32 Status{};
+    FillStatus(Status, FillRegs32);
+    FileSize = EmitHeaders<ElfTraits32>(Headers, Layout, Status);
+  }
+
+  const auto DumpDirectory = fextl::fmt::format("{}CoreDumps", FEXCore::Config::GetDataDirectory());
+  if (!FHU::Filesystem::CreateDirectories(DumpDirectory)) {
+    return false;
+  }
+
+  const auto Filename = fextl::fmt::format("{}/{}.{}.core", DumpDirectory, FHU::Filesystem::GetFilename(ApplicationName), PID);
+  const int FD = ::open(Filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  if (FD == -1) {
+    return false;
+  }
+
+  // Size the file up front so skipped pages materialize as holes, then the
+  // workers only ever write nonzero data.
+  if (ftruncate(FD, FileSize) == -1) {
+    ::close(FD);
+    return false;
+  }
+  pwrite(FD, Headers.data(), Headers.size(), 0);
+
+  WriterContext Context {
+    .Segments = Segments.data(),
+    .SegmentCount = Segments.size(),
+    .FD = FD,
+  };
+
+  // Work-stealing over the segment list: big heaps decompose into many VMAs
+  // so the split stays balanced without carving up individual segments.
+  fextl::vector<fextl::unique_ptr<FEXCore::Threads::Thread>> Writers;
+  for (uint32_t i = 1; i < MAX_DUMP_WRITERS && i < Segments.size(); ++i) {
+    Writers.emplace_back(FEXCore::Threads::Thread::Create(CoreDumpWriterEntry, &Context));
+  }
+  CoreDumpWriterEntry(&Context);
+  for (auto &Writer : Writers) {
+    Writer->join(nullptr);
+  }
+
+  ::close(FD);
+  return true;
+}
+}
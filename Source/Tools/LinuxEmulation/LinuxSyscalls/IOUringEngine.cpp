@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: io_uring servicing of guest read/write syscalls
+$end_info$
+*/
+
+#include "LinuxSyscalls/IOUringEngine.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Utils/AllocatorHooks.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace FEX::HLE::IOUringEngine {
+namespace {
+  // Only one request is ever in flight per ring, the queues just need to be
+  // deep enough that the poller never sees a full SQ.
+  constexpr uint32_t RING_ENTRIES = 8;
+
+  // How long the kernel poller stays awake after the last submission before
+  // it needs an explicit wakeup again, in milliseconds. Bursty servers keep
+  // it resident; an idle thread stops burning its core.
+  constexpr uint32_t SQ_THREAD_IDLE_MS = 20;
+
+  // Spins on the CQ tail before giving up and sleeping in io_uring_enter.
+  // NOWAIT requests complete inline in the poller so this is normally enough.
+  constexpr uint32_t CQ_SPIN_BUDGET = 4096;
+
+  struct ThreadRing {
+    int RingFD {-1};
+    bool SetupFailed {};
+
+    uint32_t *SQTail;
+    uint32_t *SQMask;
+    uint32_t *SQFlags;
+    uint32_t *SQIndices;
+    struct io_uring_sqe *SQEs;
+
+    uint32_t *CQHead;
+    uint32_t *CQTail;
+    uint32_t *CQMask;
+    struct io_uring_cqe *CQEs;
+  };
+
+  thread_local ThreadRing Ring;
+
+  // First ring created in the process, later threads attach to its poller so
+  // there is a single kernel submission thread per process rather than one
+  // per guest thread.
+  std::atomic<int> SharedPollerFD {-1};
+
+  bool EngineEnabled() {
+    // Queried on every hooked syscall, cache the config lookup.
+    static const bool Enabled = [] {
+      FEX_CONFIG_OPT(IOUringEngine, IOURINGENGINE);
+      return IOUringEngine();
+    }();
+    return Enabled;
+  }
+
+  bool SetupRing() {
+    struct io_uring_params Params {};
+    Params.flags = IORING_SETUP_SQPOLL;
+    Params.sq_thread_idle = SQ_THREAD_IDLE_MS;
+
+    int PollerFD = SharedPollerFD.load(std::memory_order_acquire);
+    if (PollerFD != -1) {
+      Params.flags |= IORING_SETUP_ATTACH_WQ;
+      Params.wq_fd = PollerFD;
+    }
+
+    int FD = ::syscall(SYS_io_uring_setup, RING_ENTRIES, &Params);
+    if (FD == -1 && PollerFD != -1) {
+      // The shared poller might be gone (owning thread exited). Retry with a
+      // fresh one.
+      Params.flags &= ~IORING_SETUP_ATTACH_WQ;
+      Params.wq_fd = 0;
+      FD = ::syscall(SYS_io_uring_setup, RING_ENTRIES, &Params);
+    }
+
+    if (FD == -1 ||
+        !(Params.features & IORING_FEAT_SINGLE_MMAP)) {
+      // Kernel too old or SQPOLL not permitted here. Stay on the plain
+      // syscall path for the rest of this thread's life.
+      if (FD != -1) {
+        ::close(FD);
+      }
+      Ring.SetupFailed = true;
+      return false;
+    }
+
+    const size_t SQSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+    const size_t CQSize = Params.cq_off.cqes + Params.cq_entries * sizeof(struct io_uring_cqe);
+    const size_t RingSize = std::max(SQSize, CQSize);
+
+    void *RingPtr = FEXCore::Allocator::mmap(nullptr, RingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQ_RING);
+    void *SQEPtr = FEXCore::Allocator::mmap(nullptr, Params.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, FD, IORING_OFF_SQES);
+    if (RingPtr == MAP_FAILED || SQEPtr == MAP_FAILED) {
+      if (RingPtr != MAP_FAILED) {
+        FEXCore::Allocator::munmap(RingPtr, RingSize);
+      }
+      if (SQEPtr != MAP_FAILED) {
+        FEXCore::Allocator::munmap(SQEPtr, Params.sq_entries * sizeof(struct io_uring_sqe));
+      }
+      ::close(FD);
+      Ring.SetupFailed = true;
+      return false;
+    }
+
+    auto RingBase = reinterpret_cast<uint8_t*>(RingPtr);
+    Ring.SQTail = reinterpret_cast<uint32_t*>(RingBase + Params.sq_off.tail);
+    Ring.SQMask = reinterpret_cast<uint32_t*>(RingBase + Params.sq_off.ring_mask);
+    Ring.SQFlags = reinterpret_cast<uint32_t*>(RingBase + Params.sq_off.flags);
+    Ring.SQIndices = reinterpret_cast<uint32_t*>(RingBase + Params.sq_off.array);
+    Ring.SQEs = reinterpret_cast<struct io_uring_sqe*>(SQEPtr);
+
+    Ring.CQHead = reinterpret_cast<uint32_t*>(RingBase + Params.cq_off.head);
+    Ring.CQTail = reinterpret_cast<uint32_t*>(RingBase + Params.cq_off.tail);
+    Ring.CQMask = reinterpret_cast<uint32_t*>(RingBase + Params.cq_off.ring_mask);
+    Ring.CQEs = reinterpret_cast<struct io_uring_cqe*>(RingBase + Params.cq_off.cqes);
+
+    Ring.RingFD = FD;
+
+    int Expected = -1;
+    SharedPollerFD.compare_exchange_strong(Expected, FD, std::memory_order_acq_rel);
+    return true;
+  }
+
+  /**
+   * @brief Submits one NOWAIT request and reaps its completion.
+   *
+   * Returns true with *Result holding the byte count on success. Any failed
+   * completion returns false so the caller re-issues through the regular
+   * host syscall, keeping blocking and error semantics identical to the
+   * non-uring path.
+   */
+  bool SubmitAndWait(uint8_t OpCode, int FD, const void *Buf, size_t Count, uint64_t Offset, uint64_t *Result) {
+    auto &R = Ring;
+
+    const uint32_t Tail = *R.SQTail;
+    const uint32_t Index = Tail & *R.SQMask;
+    auto *SQE = &R.SQEs[Index];
+    memset(SQE, 0, sizeof(*SQE));
+    SQE->opcode = OpCode;
+    SQE->fd = FD;
+    SQE->addr = reinterpret_cast<uint64_t>(Buf);
+    SQE->len = Count;
+    SQE->off = Offset;
+    SQE->rw_flags = RWF_NOWAIT;
+
+    R.SQIndices[Index] = Index;
+    __atomic_store_n(R.SQTail, Tail + 1, __ATOMIC_RELEASE);
+
+    // The poller clearing NEED_WAKEUP must be ordered against our tail store,
+    // otherwise both sides can miss each other and the request stalls.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (__atomic_load_n(R.SQFlags, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP) {
+      ::syscall(SYS_io_uring_enter, R.RingFD, 0, 0, IORING_ENTER_SQ_WAKEUP, nullptr, 0);
+    }
+
+    // NOWAIT requests can't park on readiness, so the completion shows up as
+    // soon as the poller picks the SQE up.
+    const uint32_t Head = *R.CQHead;
+    uint32_t SpinBudget = CQ_SPIN_BUDGET;
+    while (__atomic_load_n(R.CQTail, __ATOMIC_ACQUIRE) == Head) {
+      if (--SpinBudget == 0) {
+        // Overloaded poller, sleep until the completion arrives. EINTR just
+        // means a signal was serviced while the request is still bounded.
+        ::syscall(SYS_io_uring_enter, R.RingFD, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        SpinBudget = CQ_SPIN_BUDGET;
+      }
+    }
+
+    const int32_t Res = R.CQEs[Head & *R.CQMask].res;
+    __atomic_store_n(R.CQHead, Head + 1, __ATOMIC_RELEASE);
+
+    if (Res < 0) {
+      // EAGAIN means the request needs to block, anything else gets
+      // rediagnosed by the real syscall. Either way the fallback is
+      // authoritative and no data was consumed.
+      return false;
+    }
+
+    *Result = Res;
+    return true;
+  }
+
+  bool TryOp(uint8_t OpCode, int FD, const void *Buf, size_t Count, uint64_t Offset, uint64_t *Result) {
+    if (!EngineEnabled()) {
+      return false;
+    }
+
+    if (Ring.RingFD == -1 &&
+        (Ring.SetupFailed || !SetupRing())) {
+      return false;
+    }
+
+    return SubmitAndWait(OpCode, FD, Buf, Count, Offset, Result);
+  }
+}
+
+bool TryRead(int fd, void *buf, size_t count, uint64_t *Result) {
+  // off = -1 reads at and updates the file position, matching read(2).
+  return TryOp(IORING_OP_READ, fd, buf, count, ~0ULL, Result);
+}
+
+bool TryWrite(int fd, const void *buf, size_t count, uint64_t *Result) {
+  return TryOp(IORING_OP_WRITE, fd, buf, count, ~0ULL, Result);
+}
+
+bool TryPRead(int fd, void *buf, size_t count, uint64_t offset, uint64_t *Result) {
+  return TryOp(IORING_OP_READ, fd, buf, count, offset, Result);
+}
+
+bool TryPWrite(int fd, const void *buf, size_t count, uint64_t offset, uint64_t *Result) {
+  return TryOp(IORING_OP_WRITE, fd, buf, count, offset, Result);
+}
+}
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: io_uring servicing of guest read/write syscalls
+$end_info$
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace FEX::HLE::IOUringEngine {
+  /**
+   * @brief Opt-in io_uring fast path for guest read/write syscalls.
+   *
+   * Each guest thread that reaches a hooked syscall lazily creates a small
+   * SQPOLL ring, attaching to the first thread's poller so the process only
+   * pays for one kernel-side submission thread. While the poller is awake the
+   * common case costs no host syscall at all: the SQE is written to shared
+   * memory, the poller executes it, and the completion is reaped from the CQ
+   * ring.
+   *
+   * Requests are submitted with RWF_NOWAIT so a request can never park on fd
+   * readiness inside the ring - it either completes immediately (page cache
+   * hit, socket with data pending) or fails with EAGAIN. Anything that does
+   * not complete successfully falls back to the regular host syscall, which
+   * preserves blocking behaviour, signal interruption, and error semantics
+   * unchanged.
+   *
+   * Enabled with the IOUringEngine config option. Threads where ring setup
+   * fails (kernel too old, SQPOLL not permitted, fd limits) permanently fall
+   * back to the plain syscall path.
+   */
+
+  /**
+   * @brief Attempts to service a read through the ring.
+   *
+   * Returns true with *Result holding the byte count when serviced. Returns
+   * false when the engine is disabled, unavailable, or the request needs the
+   * blocking host syscall path; the caller then issues the syscall as usual.
+   */
+  bool TryRead(int fd, void *buf, size_t count, uint64_t *Result);
+  bool TryWrite(int fd, const void *buf, size_t count, uint64_t *Result);
+
+  ///< pread64/pwrite64 variants with an explicit file offset.
+  bool TryPRead(int fd, void *buf, size_t count, uint64_t offset, uint64_t *Result);
+  bool TryPWrite(int fd, const void *buf, size_t count, uint64_t offset, uint64_t *Result);
+}
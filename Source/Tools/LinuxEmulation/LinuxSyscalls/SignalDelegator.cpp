@@ -9,6 +9,9 @@ $end_info$
 #include "LinuxSyscalls/SignalDelegator.h"
 #include "LinuxSyscalls/Syscalls.h"
 
+#include <Common/CrashDump.h>
+#include <Common/FEXServerClient.h>
+
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Core/SignalDelegator.h>
@@ -19,6 +22,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/FPState.h>
+#include <FEXCore/Utils/Statistics.h>
 #include <FEXCore/Utils/ArchHelpers/Arm64.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
@@ -33,6 +37,7 @@ $end_info$
 #include <syscall.h>
 #include <sys/mman.h>
 #include <sys/signalfd.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <utility>
 
@@ -296,6 +301,7 @@ namespace FEX::HLE {
     Context->UContextLocation = 0;
     Context->SigInfoLocation = 0;
     Context->InSyscallInfo = 0;
+    Context->DeliveredEFLAGS = 0;
 
     // Store fault to top status and then reset it
     Context->FaultToTopAndGeneratedException = Thread->CurrentFrame->SynchronousFaultData.FaultToTopAndGeneratedException;
@@ -434,7 +440,15 @@ namespace FEX::HLE {
 
       Frame->State.rip = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_RIP];
       // XXX: Full context setting
-      CTX->SetFlagsFromCompactedEFLAGS(Thread, guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_EFL]);
+      // The GuestState memcpy above already put back the exact raw deferred
+      // flag operands from before delivery. Only decode the compacted EFLAGS
+      // when the handler actually changed the value it was given; preemption
+      // signals (Go's runtime fires these constantly) redirect RIP but never
+      // touch FLAGS.
+      const uint32_t ReturnedEFLAGS = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_EFL];
+      if (ReturnedEFLAGS != Context->DeliveredEFLAGS) {
+        CTX->SetFlagsFromCompactedEFLAGS(Thread, ReturnedEFLAGS);
+      }
 
 #define COPY_REG(x) \
           Frame->State.gregs[FEXCore::X86State::REG_##x] = guest_uctx->uc_mcontext.gregs[FEXCore::x86_64::FEX_REG_##x];
@@ -502,7 +516,11 @@ namespace FEX::HLE {
       ArchHelpers::Context::SetState(ucontext, reinterpret_cast<uint64_t>(Frame));
 
       // XXX: Full context setting
-      CTX->SetFlagsFromCompactedEFLAGS(Thread, guest_uctx->sc.flags);
+      // Same as the x64 frame: the raw flag state was already restored from
+      // the backup, decoding is only needed if the handler changed FLAGS.
+      if (static_cast<uint32_t>(guest_uctx->sc.flags) != Context->DeliveredEFLAGS) {
+        CTX->SetFlagsFromCompactedEFLAGS(Thread, guest_uctx->sc.flags);
+      }
 
       Frame->State.rip = guest_uctx->sc.ip;
       Frame->State.cs_idx = guest_uctx->sc.cs;
@@ -582,7 +600,12 @@ namespace FEX::HLE {
       ArchHelpers::Context::SetState(ucontext, reinterpret_cast<uint64_t>(Frame));
 
       // XXX: Full context setting
-      CTX->SetFlagsFromCompactedEFLAGS(Thread, guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EFL]);
+      // Same as the x64 frame: the raw flag state was already restored from
+      // the backup, decoding is only needed if the handler changed FLAGS.
+      const uint32_t ReturnedEFLAGS = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EFL];
+      if (ReturnedEFLAGS != Context->DeliveredEFLAGS) {
+        CTX->SetFlagsFromCompactedEFLAGS(Thread, ReturnedEFLAGS);
+      }
 
       Frame->State.rip = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_EIP];
       Frame->State.cs_idx = guest_uctx->uc.uc_mcontext.gregs[FEXCore::x86::FEX_REG_CS];
@@ -1242,6 +1265,9 @@ namespace FEX::HLE {
     ContextBackup->OriginalRIP = CTX->RestoreRIPFromHostPC(Thread, ArchHelpers::Context::GetPc(ucontext));
     // Calculate eflags upfront.
     uint32_t eflags = CTX->ReconstructCompactedEFLAGS(Thread, WasInJIT, ArchHelpers::Context::GetArmGPRs(ucontext), ArchHelpers::Context::GetArmPState(ucontext));
+    // Remember what we handed out so sigreturn can tell whether the handler
+    // touched FLAGS at all.
+    ContextBackup->DeliveredEFLAGS = eflags;
 
     if (Is64BitMode) {
       NewGuestSP = SetupFrame_x64(Thread, ContextBackup, Frame, Signal, HostSigInfo, ucontext, GuestAction, GuestStack, NewGuestSP, eflags);
@@ -1427,6 +1453,20 @@ namespace FEX::HLE {
     ucontext_t* _context = (ucontext_t*)UContext;
     auto SigInfo = *static_cast<siginfo_t*>(Info);
 
+    if (Signal == SIGSEGV &&
+        SigInfo.si_code == SEGV_ACCERR &&
+        SigInfo.si_addr == static_cast<void*>(Thread->InterruptFaultPage)) {
+      // A coordinator armed this thread's interrupt fault page to request a
+      // pause without a signal; the JIT polls the page with a store at every
+      // block entry. Disarm it and service the pending event exactly as the
+      // directed pause signal would. If no event is pending this is the
+      // benign race of the page staying armed after the event was consumed
+      // through the signal fallback - just resume at the faulting store.
+      mprotect(Thread->InterruptFaultPage, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE);
+      HandleSignalPause(Thread, Signal, Info, UContext);
+      return;
+    }
+
     constexpr bool SupportDeferredSignals = true;
     if (SupportDeferredSignals) {
       auto MustDeferSignal = (Thread->CurrentFrame->State.DeferredSignalRefCount.Load() != 0);
@@ -1521,13 +1561,8 @@ namespace FEX::HLE {
           NewMask |= (1ULL << (Signal - 1));
         }
 
-        // Walk our required signals and stop masking them if requested
-        for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-          if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-            // Never mask our required signals
-            NewMask &= ~(1ULL << i);
-          }
-        }
+        // Never mask our required signals
+        NewMask &= ~RequiredSignalsMask.load(std::memory_order_relaxed);
 
         // Update our host signal mask so we don't hit race conditions with signals
         // This allows us to maintain the expected signal mask through the guest signal handling and then all the way back again
@@ -1561,6 +1596,26 @@ namespace FEX::HLE {
       SaveTelemetry();
 #endif
 
+      // Stream a crash record with the guest view of the crash through
+      // FEXServer so field dumps carry guest context for triage.
+      StreamCrashDump(Thread, Signal, &SigInfo, UContext);
+
+      // DEFAULT_COREDUMP aliases DEFAULT_TERM, so gate the guest core writer
+      // on the signals the kernel itself would dump for.
+      constexpr uint64_t CoreSignalMask =
+        (1ULL << SIGQUIT) | (1ULL << SIGILL) | (1ULL << SIGTRAP) | (1ULL << SIGABRT) | (1ULL << SIGBUS) |
+        (1ULL << SIGFPE) | (1ULL << SIGSEGV) | (1ULL << SIGXCPU) | (1ULL << SIGXFSZ) | (1ULL << SIGSYS);
+      if (CoreSignalMask & (1ULL << Signal)) {
+        const uint64_t HostPC = ArchHelpers::Context::GetPc(UContext);
+        if (Thread->CPUBackend->IsAddressInCodeBuffer(HostPC)) {
+          // Spill the statically allocated registers and recover the precise
+          // guest RIP so the prstatus note reflects the real guest state.
+          SpillSRA(Thread, UContext, 0);
+          Thread->CurrentFrame->State.rip = CTX->RestoreRIPFromHostPC(Thread, HostPC);
+        }
+        FEX::HLE::_SyscallHandler->WriteGuestCoreDump(Thread, Signal, &SigInfo, ApplicationName);
+      }
+
       // Reassign back to DFL and crash
       signal(Signal, SIG_DFL);
       if (SigInfo.si_code != SI_KERNEL) {
@@ -1575,6 +1630,157 @@ namespace FEX::HLE {
     }
   }
 
+  namespace {
+    // Reads through process_vm_readv on ourselves. The kernel validates the
+    // address range instead of this thread faulting on it, which matters when
+    // chasing untrusted frame pointers from inside a crash handler.
+    size_t SafeReadMemory(uint64_t Address, void *Dest, size_t Size) {
+      iovec Local {
+        .iov_base = Dest,
+        .iov_len = Size,
+      };
+      iovec Remote {
+        .iov_base = reinterpret_cast<void*>(Address),
+        .iov_len = Size,
+      };
+
+      const ssize_t Result = process_vm_readv(::getpid(), &Local, 1, &Remote, 1, 0);
+      return Result < 0 ? 0 : Result;
+    }
+
+    // Both x86-64 guest frames and AArch64 host frames lay out a frame record
+    // as [FP] = previous FP, [FP + 8] = return address. Compilers can omit
+    // frame pointers so the walk is best effort, requiring the chain to grow
+    // strictly upward bounds it on corrupt stacks.
+    uint32_t WalkFramePointers(uint64_t FramePointer, uint64_t *Frames, uint32_t MaxFrames) {
+      uint32_t Count{};
+      while (Count < MaxFrames) {
+        uint64_t Record[2];
+        if (SafeReadMemory(FramePointer, Record, sizeof(Record)) != sizeof(Record) ||
+            Record[1] == 0) {
+          break;
+        }
+
+        Frames[Count++] = Record[1];
+
+        if (Record[0] <= FramePointer) {
+          break;
+        }
+        FramePointer = Record[0];
+      }
+
+      return Count;
+    }
+  }
+
+  void SignalDelegator::StreamCrashDump(FEXCore::Core::InternalThreadState *Thread, int Signal, siginfo_t *HostSigInfo, void *UContext) {
+    if (ApplicationName.empty()) {
+      return;
+    }
+
+    const int ServerFD = FEXServerClient::GetServerFD();
+    if (ServerFD == -1) {
+      return;
+    }
+
+    const int FD = FEXServerClient::RequestCrashDumpFD(ServerFD, ApplicationName);
+    if (FD == -1) {
+      return;
+    }
+
+    const uint64_t HostPC = ArchHelpers::Context::GetPc(UContext);
+
+    // If the crash came from inside JIT code then the statically allocated
+    // registers live in host registers, not in CPUState. Spill them so the
+    // record carries the real guest state.
+    if (Thread->CPUBackend->IsAddressInCodeBuffer(HostPC)) {
+      SpillSRA(Thread, UContext, 0);
+    }
+
+    struct timespec Time{};
+    clock_gettime(CLOCK_REALTIME, &Time);
+
+    auto Frame = Thread->CurrentFrame;
+
+    FEX::CrashDump::Header Header {
+      .Cookie = FEX::CrashDump::COOKIE,
+      .Version = FEX::CrashDump::VERSION,
+      .PID = ::getpid(),
+      .TID = FHU::Syscalls::gettid(),
+      .Signal = Signal,
+      .SignalCode = HostSigInfo->si_code,
+      .FaultAddress = reinterpret_cast<uint64_t>(HostSigInfo->si_addr),
+      .Timestamp = Time.tv_sec * 1'000'000'000ULL + Time.tv_nsec,
+      .GuestRIP = CTX->RestoreRIPFromHostPC(Thread, HostPC),
+    };
+    static_assert(sizeof(Header.GuestGPRs) == sizeof(Frame->State.gregs), "Crash dump GPR area needs to match CPUState");
+    memcpy(Header.GuestGPRs, Frame->State.gregs, sizeof(Header.GuestGPRs));
+
+    uint64_t GuestFrames[FEX::CrashDump::MAX_BACKTRACE_DEPTH];
+    uint64_t HostFrames[FEX::CrashDump::MAX_BACKTRACE_DEPTH];
+
+    Header.NumGuestFrames = WalkFramePointers(Frame->State.gregs[FEXCore::X86State::REG_RBP], GuestFrames, FEX::CrashDump::MAX_BACKTRACE_DEPTH);
+
+    // The faulting host PC leads the host backtrace, the frame walk provides
+    // the callers behind it.
+    HostFrames[0] = HostPC;
+#ifdef _M_ARM_64
+    const uint64_t HostFP = ArchHelpers::Context::GetArmReg(UContext, 29);
+#else
+    const uint64_t HostFP = ArchHelpers::Context::GetMContext(UContext)->gregs[REG_RBP];
+#endif
+    Header.NumHostFrames = 1 + WalkFramePointers(HostFP, &HostFrames[1], FEX::CrashDump::MAX_BACKTRACE_DEPTH - 1);
+
+#ifndef FEX_DISABLE_TELEMETRY
+    uint64_t TelemetryValues[FEXCore::Telemetry::TYPE_LAST];
+    for (size_t i = 0; i < FEXCore::Telemetry::TYPE_LAST; ++i) {
+      TelemetryValues[i] = *FEXCore::Telemetry::GetTelemetryValue(static_cast<FEXCore::Telemetry::TelemetryType>(i));
+    }
+    Header.NumTelemetryValues = FEXCore::Telemetry::TYPE_LAST;
+#endif
+
+    // Count the valid flight recorder samples up front, the header needs the
+    // total before the entries stream out. Unwritten slots hold a zero RIP.
+    if (Frame->FlightRecorderRing) {
+      for (uint32_t i = 0; i < FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_ENTRIES; ++i) {
+        if (Frame->FlightRecorderRing[i].GuestRIP != 0) {
+          ++Header.NumFlightRecorderEntries;
+        }
+      }
+    }
+
+    write(FD, &Header, sizeof(Header));
+    write(FD, GuestFrames, Header.NumGuestFrames * sizeof(uint64_t));
+    write(FD, HostFrames, Header.NumHostFrames * sizeof(uint64_t));
+#ifndef FEX_DISABLE_TELEMETRY
+    write(FD, TelemetryValues, Header.NumTelemetryValues * sizeof(uint64_t));
+#endif
+
+    if (Header.NumFlightRecorderEntries != 0) {
+      // Rotate the ring out oldest-first in bounded chunks. This runs on the
+      // signal stack, so no ring-sized staging buffer.
+      constexpr uint32_t ChunkEntries = 64;
+      FEXCore::Core::CpuStateFrame::FlightRecorderEntry Chunk[ChunkEntries];
+      uint32_t Filled = 0;
+      const uint32_t Index = Frame->FlightRecorderIndex;
+      for (uint32_t i = 0; i < FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_ENTRIES; ++i) {
+        const auto &Entry = Frame->FlightRecorderRing[(Index + i) & FEXCore::Core::CpuStateFrame::FLIGHT_RECORDER_MASK];
+        if (Entry.GuestRIP == 0) {
+          continue;
+        }
+        Chunk[Filled++] = Entry;
+        if (Filled == ChunkEntries) {
+          write(FD, Chunk, Filled * sizeof(Chunk[0]));
+          Filled = 0;
+        }
+      }
+      if (Filled != 0) {
+        write(FD, Chunk, Filled * sizeof(Chunk[0]));
+      }
+    }
+    close(FD);
+  }
+
   void SignalDelegator::SaveTelemetry() {
 #ifndef FEX_DISABLE_TELEMETRY
     if (!ApplicationName.empty()) {
@@ -1765,6 +1971,15 @@ namespace FEX::HLE {
       }
 
       const auto Result = FEXCore::ArchHelpers::Arm64::HandleUnalignedAccess(GlobalDelegator->ParanoidTSO(), PC, ArchHelpers::Context::GetArmGPRs(ucontext));
+      if (Result.first) {
+        // Direct GetStat call: the static-init macro hides a guard variable
+        // that isn't safe from a signal handler.
+        FEXCore::Statistics::GetStat(FEXCore::Statistics::STAT_SIGBUS_BACKPATCHES)++;
+      }
+      if (Result.first && !GlobalDelegator->ParanoidTSO()) {
+        // Each backpatch costs a SIGBUS round-trip; let the core recompile chronic offenders.
+        Thread->CTX->RecordTSOFaultBackpatch(Thread, PC);
+      }
       ArchHelpers::Context::SetPc(ucontext, PC + Result.second);
       return Result.first;
     };
@@ -1849,6 +2064,9 @@ namespace FEX::HLE {
     // Multiple threads could be calling in to this
     std::lock_guard lk(HostDelegatorMutex);
     HostHandlers[Signal].Required = Required;
+    if (Required) {
+      RequiredSignalsMask.fetch_or(1ULL << (Signal - 1), std::memory_order_relaxed);
+    }
     InstallHostThunk(Signal);
   }
 
@@ -1857,6 +2075,9 @@ namespace FEX::HLE {
     // Multiple threads could be calling in to this
     std::lock_guard lk(HostDelegatorMutex);
     HostHandlers[Signal].Required = Required;
+    if (Required) {
+      RequiredSignalsMask.fetch_or(1ULL << (Signal - 1), std::memory_order_relaxed);
+    }
     InstallHostThunk(Signal);
   }
 
@@ -1895,6 +2116,14 @@ namespace FEX::HLE {
       if (!InstallHostThunk(Signal)) {
         UpdateHostThunk(Signal);
       }
+
+      // Hand the handler's entry point to the background compiler now instead
+      // of compiling it at first delivery, which is the worst possible time
+      // for guests using signals for IO notification.
+      if (Action->sigaction_handler.handler != SIG_DFL &&
+          Action->sigaction_handler.handler != SIG_IGN) {
+        CTX->PretranslateRIP(reinterpret_cast<uint64_t>(Action->sigaction_handler.sigaction));
+      }
     }
 
     return 0;
@@ -2025,12 +2254,8 @@ namespace FEX::HLE {
       uint64_t HostMask = ThreadData.CurrentSignalMask.Val;
       // Now actually set the host mask
       // This will hide from the guest that we are not actually setting all of the masks it wants
-      for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-        if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-          // If it is a required host signal then we can't mask it
-          HostMask &= ~(1ULL << i);
-        }
-      }
+      // Required host signals can never be masked
+      HostMask &= ~RequiredSignalsMask.load(std::memory_order_relaxed);
 
       ::syscall(SYS_rt_sigprocmask, SIG_SETMASK, &HostMask, nullptr, 8);
     }
@@ -2126,13 +2351,10 @@ namespace FEX::HLE {
     sigset_t HostSet{};
     sigemptyset(&HostSet);
 
+    // For now skip our internal signals
+    const uint64_t GuestVisibleSignals = *set & ~RequiredSignalsMask.load(std::memory_order_relaxed);
     for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-      if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-        // For now skip our internal signals
-        continue;
-      }
-
-      if (*set & (1ULL << i)) {
+      if (GuestVisibleSignals & (1ULL << i)) {
         sigaddset(&HostSet, i + 1);
       }
     }
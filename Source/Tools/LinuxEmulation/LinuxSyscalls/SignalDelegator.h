@@ -129,6 +129,16 @@ namespace FEX::HLE {
     FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
 
     void SaveTelemetry();
+
+    /**
+     * @brief Streams a binary crash record through FEXServer.
+     *
+     * Captures guest register state, a guest backtrace reconstructed through
+     * the JIT's RIP mapping, a host backtrace and the telemetry counters.
+     * Called from the fatal signal path right before FEX crashes out, so it
+     * must not allocate or take locks.
+     */
+    void StreamCrashDump(FEXCore::Core::InternalThreadState *Thread, int Signal, siginfo_t *HostSigInfo, void *UContext);
   private:
     FEXCore::Core::InternalThreadState *GetTLSThread();
 
@@ -190,6 +200,13 @@ namespace FEX::HLE {
     };
 
     std::array<SignalHandler, MAX_SIGNALS + 1> HostHandlers{};
+
+    // Aggregate bitmask of the Required flags above, kept in sync at handler
+    // registration. Signal delivery and guest sigprocmask recalculate masks on
+    // every call, a single cached mask keeps them from walking all 64 handlers
+    // each time.
+    std::atomic<uint64_t> RequiredSignalsMask{};
+
     bool InstallHostThunk(int Signal);
     bool UpdateHostThunk(int Signal);
 
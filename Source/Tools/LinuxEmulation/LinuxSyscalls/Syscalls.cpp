@@ -32,6 +32,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/FileLoading.h>
+#include <FEXCore/Utils/Statistics.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXCore/fextl/sstream.h>
 #include <FEXCore/fextl/string.h>
@@ -55,6 +56,7 @@ $end_info$
 #include <system_error>
 #include <syscall.h>
 #include <sys/mman.h>
+#include <sys/prctl.h>
 #include <sys/utsname.h>
 #include <unistd.h>
 
@@ -680,14 +682,28 @@ uint64_t SyscallHandler::HandleBRK(FEXCore::Core::CpuStateFrame *Frame, void *Ad
       uint64_t NewSizeAligned = FEXCore::AlignUp(NewSize, 4096);
 
       if (NewSizeAligned < DataSpaceMaxSize) {
-        // If we are shrinking the brk then munmap the ranges
-        // That way we gain the memory back and also give the application zero pages if it allocates again
+        // Shrinking the brk. Give the memory back and make sure the application
+        // gets zero pages if it allocates again, but keep the loader's arena
+        // reservation so the next growth is a protection flip instead of a
+        // fresh mapping. Only pages past the arena get unmapped for real.
         // DataspaceMaxSize is always page aligned
 
-        uint64_t RemainingSize = DataSpaceMaxSize - NewSizeAligned;
-        // We have pages we can unmap
-        [[maybe_unused]] auto ok = GuestMunmap(Frame->Thread, reinterpret_cast<void*>(DataSpace + NewSizeAligned), RemainingSize);
-        LOGMAN_THROW_A_FMT(ok != -1, "Munmap failed");
+        if (DataSpaceMaxSize > DataSpaceArenaSize) {
+          uint64_t UnmapBegin = std::max(NewSizeAligned, DataSpaceArenaSize);
+          [[maybe_unused]] auto ok = GuestMunmap(Frame->Thread, reinterpret_cast<void*>(DataSpace + UnmapBegin), DataSpaceMaxSize - UnmapBegin);
+          LOGMAN_THROW_A_FMT(ok != -1, "Munmap failed");
+        }
+
+        if (NewSizeAligned < DataSpaceArenaSize) {
+          uint64_t InArenaSize = std::min(DataSpaceMaxSize, DataSpaceArenaSize) - NewSizeAligned;
+          void *InArenaBegin = reinterpret_cast<void*>(DataSpace + NewSizeAligned);
+          // DONTNEED on private anonymous memory guarantees zero pages on the
+          // next touch, same as a munmap and re-mmap would.
+          ::madvise(InArenaBegin, InArenaSize, MADV_DONTNEED);
+          [[maybe_unused]] auto ok = ::mprotect(InArenaBegin, InArenaSize, PROT_NONE);
+          LOGMAN_THROW_A_FMT(ok != -1, "Mprotect failed");
+          TrackMprotect(Frame->Thread, DataSpace + NewSizeAligned, InArenaSize, PROT_NONE);
+        }
 
         DataSpaceMaxSize = NewSizeAligned;
       }
@@ -700,25 +716,45 @@ uint64_t SyscallHandler::HandleBRK(FEXCore::Core::CpuStateFrame *Frame, void *Ad
           return DataSpace + DataSpaceSize;
         }
 
-        uint64_t NewBRK{};
-        NewBRK = (uint64_t)GuestMmap(Frame->Thread, (void*)(DataSpace + DataSpaceMaxSize), AllocateNewSize, PROT_READ | PROT_WRITE, MAP_FIXED_NOREPLACE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-
+        // Satisfy as much of the growth as possible from the reserved arena.
+        // That path is a protection flip on an existing mapping.
+        if (DataSpaceMaxSize < DataSpaceArenaSize) {
+          uint64_t FromArena = std::min(AllocateNewSize, DataSpaceArenaSize - DataSpaceMaxSize);
+          if (::mprotect(reinterpret_cast<void*>(DataSpace + DataSpaceMaxSize), FromArena, PROT_READ | PROT_WRITE) == -1) {
+            // Commit failed, likely memory pressure. Out of memory.
+            return DataSpace + DataSpaceSize;
+          }
+          TrackMprotect(Frame->Thread, DataSpace + DataSpaceMaxSize, FromArena, PROT_READ | PROT_WRITE);
 
-        if (NewBRK != ~0ULL && NewBRK != (DataSpace + DataSpaceMaxSize)) {
-          // Couldn't allocate that the region we wanted
-          // Can happen if MAP_FIXED_NOREPLACE isn't understood by the kernel
-          [[maybe_unused]] int ok = GuestMunmap(Frame->Thread, reinterpret_cast<void*>(NewBRK), AllocateNewSize);
-          LOGMAN_THROW_A_FMT(ok != -1, "Munmap failed");
-          NewBRK = ~0ULL;
+          DataSpaceMaxSize += FromArena;
+          AllocateNewSize -= FromArena;
         }
 
-        if (NewBRK == ~0ULL) {
-          // If we couldn't allocate a new region then out of memory
-          return DataSpace + DataSpaceSize;
-        }
-        else {
-          // Increase our BRK size
-          DataSpaceMaxSize += AllocateNewSize;
+        if (AllocateNewSize) {
+          // Ran past the arena, fall back to growing with new mappings.
+          uint64_t NewBRK{};
+          NewBRK = (uint64_t)GuestMmap(Frame->Thread, (void*)(DataSpace + DataSpaceMaxSize), AllocateNewSize, PROT_READ | PROT_WRITE, MAP_FIXED_NOREPLACE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+          if (NewBRK != ~0ULL && NewBRK != (DataSpace + DataSpaceMaxSize)) {
+            // Couldn't allocate that the region we wanted
+            // Can happen if MAP_FIXED_NOREPLACE isn't understood by the kernel
+            [[maybe_unused]] int ok = GuestMunmap(Frame->Thread, reinterpret_cast<void*>(NewBRK), AllocateNewSize);
+            LOGMAN_THROW_A_FMT(ok != -1, "Munmap failed");
+            NewBRK = ~0ULL;
+          }
+
+          if (NewBRK == ~0ULL) {
+            // Couldn't allocate a new region. If the arena commit above already
+            // covered the requested size then the break can still move, only
+            // the prefetched padding is lost.
+            if (NewSizeAligned > DataSpaceMaxSize) {
+              return DataSpace + DataSpaceSize;
+            }
+          }
+          else {
+            // Increase our BRK size
+            DataSpaceMaxSize += AllocateNewSize;
+          }
         }
       }
 
@@ -729,10 +765,11 @@ uint64_t SyscallHandler::HandleBRK(FEXCore::Core::CpuStateFrame *Frame, void *Ad
   return Result;
 }
 
-void SyscallHandler::DefaultProgramBreak(uint64_t Base, uint64_t Size) {
+void SyscallHandler::DefaultProgramBreak(uint64_t Base, uint64_t Size, uint64_t ArenaSize) {
   DataSpace = Base;
   DataSpaceMaxSize = Size;
   DataSpaceStartingSize = Size;
+  DataSpaceArenaSize = ArenaSize;
 }
 
 SyscallHandler::SyscallHandler(FEXCore::Context::Context *_CTX, FEX::HLE::SignalDelegator *_SignalDelegation)
@@ -745,6 +782,14 @@ SyscallHandler::SyscallHandler(FEXCore::Context::Context *_CTX, FEX::HLE::Signal
   GuestKernelVersion = CalculateGuestKernelVersion();
   Alloc32Handler = FEX::HLE::Create32BitAllocator();
 
+  // Timer slack is per-thread and inherited on clone, so setting it here
+  // covers every guest thread. Widening it lets the kernel batch expirations
+  // of threads sleeping on close deadlines into a single wakeup.
+  FEX_CONFIG_OPT(TimerSlack, TIMERSLACK);
+  if (TimerSlack()) {
+    prctl(PR_SET_TIMERSLACK, TimerSlack());
+  }
+
   SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleSegfault, true);
 }
 
@@ -777,6 +822,9 @@ uint32_t SyscallHandler::CalculateGuestKernelVersion() {
 }
 
 uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args) {
+  FEXCORE_STATS_STATIC_INIT(StatSyscalls, STAT_SYSCALLS);
+  FEXCORE_STATS_INC(StatSyscalls);
+
   if (Args->Argument[0] >= Definitions.size()) {
     return -ENOSYS;
   }
@@ -829,6 +877,41 @@ uint64_t UnimplementedSyscallSafe(FEXCore::Core::CpuStateFrame *Frame, uint64_t
   return -ENOSYS;
 }
 
+void *HugePageGuestMmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
+  // First shot passes the request straight through. Correct whenever the host
+  // supports the guest's hugepage size and the admin reserved pages for it.
+  void *Result = ::mmap(addr, length, prot, flags, fd, offset);
+  if (Result != MAP_FAILED) {
+    return Result;
+  }
+
+  if (fd != -1) {
+    // A hugetlbfs-backed file mapping can't be downgraded, the file offset
+    // semantics are tied to the hugepage size. Keep the host's answer.
+    return MAP_FAILED;
+  }
+
+  // x86 guests encode their page size expectation in the flags, typically
+  // MAP_HUGE_2MB. A host running 16K or 64K granules backs different sizes,
+  // so retry at the host's default hugepage size.
+  const int SizeEncoding = flags & (0x3F << MAP_HUGE_SHIFT);
+  if (SizeEncoding) {
+    Result = ::mmap(addr, length, prot, flags & ~SizeEncoding, fd, offset);
+    if (Result != MAP_FAILED) {
+      return Result;
+    }
+  }
+
+  // No explicit hugepages to be had. Downgrade to regular pages with the
+  // transparent hint, the same fallback the JIT code buffers use, so
+  // khugepaged can still collapse the range into large TLB entries.
+  Result = ::mmap(addr, length, prot, flags & ~(MAP_HUGETLB | SizeEncoding), fd, offset);
+  if (Result != MAP_FAILED) {
+    ::madvise(Result, length, MADV_HUGEPAGE);
+  }
+  return Result;
+}
+
 void SyscallHandler::LockBeforeFork() {
   VMATracking.Mutex.lock();
 }
@@ -23,12 +23,15 @@ $end_info$
 #include <FEXCore/fextl/string.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 
 #include <errno.h>
 #include <fcntl.h>
+#include <signal.h>
 #include <stdint.h>
+#include <time.h>
 #include <type_traits>
 #include <list>
 #ifdef _M_X86_64
@@ -96,6 +99,28 @@ struct ExecveAtArgs {
 
 uint64_t ExecveHandler(const char *pathname, char* const* argv, char* const* envp, ExecveAtArgs Args);
 
+/**
+ * @brief Userspace fast path for private FUTEX_WAIT without a timeout
+ *
+ * Validates the futex word and briefly spins on it before the caller falls
+ * back to the real syscall. Gated behind the FutexSpinWait config option.
+ *
+ * @return true if the wait was satisfied without a syscall, with the guest
+ * syscall result placed in Result
+ */
+bool TryFutexWaitFastPath(int *uaddr, int futex_op, int val, const void *timeout, uint64_t *Result);
+
+/**
+ * @brief Userspace fast path for short relative nanosleeps
+ *
+ * Burns sub-threshold sleep requests on the clock_gettime vDSO instead of a
+ * host syscall round trip. Gated behind the SleepSpinThreshold config option.
+ *
+ * @return true if the sleep completed without a syscall, with the guest
+ * syscall result placed in Result
+ */
+bool TryNanosleepFastPath(clockid_t clockid, int flags, const struct timespec *req, uint64_t *Result);
+
 class ThreadManager final {
   public:
     ThreadManager(FEXCore::Context::Context *CTX, FEX::HLE::SignalDelegator *SignalDelegation)
@@ -127,20 +152,16 @@ class ThreadManager final {
       ++IdleWaitRefCount;
     }
 
+    // One journal append covers every thread: the core scrubs the calling
+    // thread eagerly and the rest replay the entry from the invalidation
+    // journal at their next dispatcher entry, instead of this walking each
+    // thread's lookup cache under ThreadCreationMutex.
     void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *CallingThread, uint64_t Start, uint64_t Length) {
-      std::lock_guard lk(ThreadCreationMutex);
-
-      for (auto &Thread : Threads) {
-        CTX->InvalidateGuestCodeRange(Thread, Start, Length);
-      }
+      CTX->InvalidateGuestCodeRange(CallingThread, Start, Length);
     }
 
     void InvalidateGuestCodeRange(FEXCore::Core::InternalThreadState *CallingThread, uint64_t Start, uint64_t Length, FEXCore::Context::CodeRangeInvalidationFn callback) {
-      std::lock_guard lk(ThreadCreationMutex);
-
-      for (auto &Thread : Threads) {
-        CTX->InvalidateGuestCodeRange(Thread, Start, Length, callback);
-      }
+      CTX->InvalidateGuestCodeRange(CallingThread, Start, Length, callback);
     }
 
     fextl::vector<FEXCore::Core::InternalThreadState *> const *GetThreads() const {
@@ -154,12 +175,19 @@ class ThreadManager final {
     std::mutex ThreadCreationMutex;
     fextl::vector<FEXCore::Core::InternalThreadState *> Threads;
 
+    // Dead thread state inherited over a fork, torn down lazily so a child
+    // heading straight for exec never faults in COW copies of it.
+    fextl::vector<FEXCore::Core::InternalThreadState *> DeadThreadsAfterFork;
+    void ReapDeadThreads();
+
     // Thread idling support.
     bool Running{};
     std::mutex IdleWaitMutex;
     std::condition_variable IdleWaitCV;
     std::atomic<uint32_t> IdleWaitRefCount{};
 
+    FEX_CONFIG_OPT(CoopPreempt, COOPPREEMPT);
+
     void HandleThreadDeletion(FEXCore::Core::InternalThreadState *Thread);
     void NotifyPause();
 };
@@ -172,7 +200,12 @@ public:
   // In the case that the syscall doesn't hit the optimized path then we still need to go here
   uint64_t HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args) final override;
 
-  void DefaultProgramBreak(uint64_t Base, uint64_t Size);
+  void DefaultProgramBreak(uint64_t Base, uint64_t Size, uint64_t ArenaSize);
+
+  // Writes a guest-scoped sparse ELF core for a crashing thread, enumerating
+  // the guest mappings from VMATracking. Gated on the GuestCoreDump config
+  // option. Implemented in GuestCoreDump.cpp.
+  bool WriteGuestCoreDump(FEXCore::Core::InternalThreadState *Thread, int Signal, const siginfo_t *Info, const fextl::string &ApplicationName);
 
   using SyscallPtrArg0 = uint64_t(*)(FEXCore::Core::CpuStateFrame *Frame);
   using SyscallPtrArg1 = uint64_t(*)(FEXCore::Core::CpuStateFrame *Frame, uint64_t);
@@ -207,7 +240,13 @@ public:
 
   FEXCore::HLE::SyscallABI GetSyscallABI(uint64_t Syscall) override {
     auto &Def = Definitions.at(Syscall);
+#ifdef DEBUG_STRACE
+    // Inline passthrough would skip the Strace call in HandleSyscall.
+    // Report nothing as inlineable so tracing sees every syscall.
+    return {Def.NumArgs, true, -1};
+#else
     return {Def.NumArgs, true, Def.HostSyscallNumber};
+#endif
   }
 
   FEXCore::IR::SyscallFlags  GetSyscallFlags(uint64_t Syscall) const override {
@@ -288,6 +327,11 @@ public:
   // AOTIRCacheEntryLookupResult also includes a shared lock guard, so the pointed AOTIRCacheEntry return can be safely used
   FEXCore::HLE::AOTIRCacheEntryLookupResult LookupAOTIRCacheEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestAddr) final override;
 
+  // Generation stamp of the tracked guest VMA set, bumped by every tracking
+  // mutation. The gdbserver keys its memory-map and library-list caches off
+  // this so debugger polling stays O(changes) rather than O(mappings).
+  uint64_t VMAGeneration() const { return VMATracking.Generation(); }
+
   ///// FORK tracking /////
   void LockBeforeFork();
   void UnlockAfterFork(FEXCore::Core::InternalThreadState *LiveThread, bool Child);
@@ -312,6 +356,9 @@ protected:
   uint64_t DataSpaceSize {};
   uint64_t DataSpaceMaxSize {};
   uint64_t DataSpaceStartingSize{};
+  // Size of the PROT_NONE reservation the loader placed behind the brk base.
+  // Adjustments inside it are protection flips, never map/unmap churn.
+  uint64_t DataSpaceArenaSize {};
 
   // (Major << 24) | (Minor << 16) | Patch
   uint32_t HostKernelVersion{};
@@ -429,13 +476,107 @@ private:
     // Mutex must be unique_locked before calling
     // Returns the Size fo the Shm or 0 if not found
     uintptr_t ClearShmUnsafe(FEXCore::Context::Context *Ctx, uintptr_t Base);
+
+    // Wait-free read snapshot of the VMA set.
+    //
+    // Writers rebuild a flat, Base-sorted copy of the VMAs while the snapshot
+    // epoch is odd and bump it even again once consistent. Readers sample the
+    // epoch, binary search, copy the match out and resample - an interleaved
+    // writer sends them down the locked path instead of looping, so readers
+    // never wait. With thousands of guest mappings the shared lock on the hot
+    // lookup path otherwise serializes against every mmap/mprotect.
+    struct SnapshotEntry {
+      uint64_t Base;
+      uint64_t Top;
+      uint64_t Offset;
+      FEXCore::IR::AOTIRCacheEntry *AOTIRCacheEntry;
+      VMAFlags Flags;
+      VMAProt Prot;
+    };
+
+    enum class SnapshotResult {
+      Hit,   // Entry filled from a consistent snapshot
+      Miss,  // Address wasn't mapped in a consistent snapshot
+      Retry, // A writer interfered, take the locked path
+    };
+
+    // Mutex must be unique_locked before calling; call after any mutation
+    void PublishSnapshot();
+
+    // Lock-free, never blocks on Mutex
+    SnapshotResult LookupVMASnapshot(uint64_t GuestAddr, SnapshotEntry *Entry) const;
+
+    // Monotonic stamp that advances with every published mutation. Consumers
+    // caching views derived from the VMA set compare stamps to detect changes
+    // without re-walking anything. Odd only while a writer is mid-publish,
+    // which at worst costs such a consumer one redundant rebuild.
+    uint64_t Generation() const { return SnapshotEpoch.load(std::memory_order_acquire); }
   private:
+    std::atomic<uint64_t> SnapshotEpoch{};
+    std::atomic<const SnapshotEntry *> SnapshotData{};
+    std::atomic<size_t> SnapshotSize{};
+    fextl::vector<SnapshotEntry> SnapshotStorage;
+
+    // Old snapshot allocations are retired here instead of freed, so a reader
+    // still walking one dereferences stale data that the epoch recheck will
+    // reject, never freed memory. Growth doubles, keeping the retired total
+    // within a couple of snapshot sizes.
+    fextl::vector<fextl::vector<SnapshotEntry>> RetiredSnapshots;
+
     bool ListRemove(VMAEntry *Mapping);
     void ListReplace(VMAEntry *Mapping, VMAEntry *NewMapping);
     void ListInsertAfter(VMAEntry *Mapping, VMAEntry *NewMapping);
     void ListPrepend(MappedResource *Resource, VMAEntry *NewVMA);
     static void ListCheckVMALinks(VMAEntry *VMA);
   } VMATracking;
+
+  // Address-range sharded epoch counters with small per-shard caches of
+  // private writable VMAs, so the hot SMC write-fault path can resolve the
+  // common case without touching VMATracking.Mutex at all. VMA mutations from
+  // one thread would otherwise stall every other thread faulting on unrelated
+  // code pages.
+  //
+  // Writers (holding VMATracking.Mutex uniquely) bump the epoch of every shard
+  // their range covers to an odd value, drop the shard's cached entries,
+  // mutate the VMA map, then bump the epoch back to even. Readers load the
+  // epoch, match a cached entry, and re-check the epoch - any interleaved
+  // writer forces them down the locked slow path. Entries are only published
+  // while VMATracking.Mutex is held shared, so a published entry is always
+  // consistent with the map as of the shard's current epoch.
+  struct VMAShardedEpochs {
+    // Granules wrap around the shard array, so a JIT's code heap and an
+    // unrelated mapping usually land in different shards.
+    constexpr static size_t SHARD_COUNT = 64;
+    constexpr static uint64_t SHARD_GRANULE_SHIFT = 21; // 2MB granules
+    constexpr static size_t ENTRIES_PER_SHARD = 4;
+
+    // Entries pack a page range in to one atomic so they can't tear:
+    // (Base >> 12) in the low 36 bits, length in pages in the upper 28 bits.
+    constexpr static uint64_t ENTRY_PAGE_BITS = 36;
+    constexpr static uint64_t ENTRY_MAX_PAGES = 1ULL << (64 - ENTRY_PAGE_BITS);
+
+    struct alignas(64) Shard {
+      std::atomic<uint64_t> Epoch{};
+      std::atomic<uint64_t> Entries[ENTRIES_PER_SHARD]{};
+      std::atomic<uint32_t> NextEntry{};
+    };
+
+    Shard Shards[SHARD_COUNT];
+
+    Shard &ShardFor(uint64_t Addr) {
+      return Shards[(Addr >> SHARD_GRANULE_SHIFT) % SHARD_COUNT];
+    }
+
+    // VMATracking.Mutex must be unique_locked around these
+    void BeginWrite(uint64_t Base, uint64_t Top);
+    void EndWrite(uint64_t Base, uint64_t Top);
+
+    // VMATracking.Mutex must be at least shared_locked before calling
+    void PublishPrivateWritable(uint64_t FaultBase, uint64_t Base, uint64_t Length);
+
+    // Lock-free, safe to call from the SIGSEGV handler
+    bool LookupPrivateWritable(uint64_t FaultBase);
+  } SMCSharding;
 };
 
 uint64_t HandleSyscall(SyscallHandler *Handler, FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args);
@@ -602,6 +743,17 @@ static bool HasSyscallError(const void* Result) {
   return HasSyscallError(reinterpret_cast<uintptr_t>(Result));
 }
 
+/**
+ * @brief Services a guest mmap carrying MAP_HUGETLB.
+ *
+ * Tries the host as-is first, then without the guest's explicit x86 hugepage
+ * size encoding, and finally downgrades to a regular mapping with a
+ * transparent hugepage hint. Guests treat explicit hugepages as an
+ * optimization; the downgrade keeps them running with khugepaged still able
+ * to deliver the large TLB entries.
+ */
+void *HugePageGuestMmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+
 template<bool IncrementOffset, typename T>
 uint64_t GetDentsEmulation(int fd, T *dirp, uint32_t count);
 }
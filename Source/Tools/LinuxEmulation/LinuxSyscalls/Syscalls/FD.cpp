@@ -5,6 +5,7 @@ tags: LinuxSyscalls|syscalls-shared
 $end_info$
 */
 
+#include "LinuxSyscalls/IOUringEngine.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
@@ -34,13 +35,21 @@ namespace FEX::HLE {
 
     REGISTER_SYSCALL_IMPL_PASS_FLAGS(read, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, int fd, void *buf, size_t count) -> uint64_t {
-      uint64_t Result = ::read(fd, buf, count);
+      uint64_t Result{};
+      if (IOUringEngine::TryRead(fd, buf, count, &Result)) {
+        return Result;
+      }
+      Result = ::read(fd, buf, count);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_PASS_FLAGS(write, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, int fd, void *buf, size_t count) -> uint64_t {
-      uint64_t Result = ::write(fd, buf, count);
+      uint64_t Result{};
+      if (IOUringEngine::TryWrite(fd, buf, count, &Result)) {
+        return Result;
+      }
+      Result = ::write(fd, buf, count);
       SYSCALL_ERRNO();
     });
 
@@ -97,6 +106,9 @@ namespace FEX::HLE {
       [](FEXCore::Core::CpuStateFrame* Frame, int oldfd, int newfd, int flags) -> uint64_t {
       flags = FEX::HLE::RemapFromX86Flags(flags);
       uint64_t Result = ::dup3(oldfd, newfd, flags);
+      if (Result != -1) {
+        FEX::HLE::_SyscallHandler->FM.DupFDAttributes(oldfd, Result, (flags & O_CLOEXEC) != 0);
+      }
       SYSCALL_ERRNO();
     });
 
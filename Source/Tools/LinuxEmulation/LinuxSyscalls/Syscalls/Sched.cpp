@@ -9,10 +9,13 @@ $end_info$
 #include "LinuxSyscalls/x64/Syscalls.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 
+#include <FEXCore/Config/Config.h>
 #include <FEXCore/Utils/MathUtils.h>
 
 #include <FEXCore/IR/IR.h>
 
+#include <algorithm>
+#include <cstring>
 #include <stdint.h>
 #include <sched.h>
 #include <sys/time.h>
@@ -21,6 +24,16 @@ $end_info$
 #include <unistd.h>
 
 namespace FEX::HLE {
+  // Guest-visible CPU count when the topology is virtualized, 0 for 1:1
+  // passthrough. Matches what CPUID and the emulated procfs surface report.
+  static uint32_t GuestVirtualCPUCount() {
+    static const uint32_t Count = []() {
+      FEX_CONFIG_OPT(VirtualCPUCount, VIRTUALCPUCOUNT);
+      return VirtualCPUCount();
+    }();
+    return Count;
+  }
+
   void RegisterSched(FEX::HLE::SyscallHandler *Handler) {
     using namespace FEXCore::IR;
 
@@ -80,6 +93,26 @@ namespace FEX::HLE {
 
     REGISTER_SYSCALL_IMPL_FLAGS(sched_setaffinity, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY | SyscallFlags::NOSIDEEFFECTS,
       [](FEXCore::Core::CpuStateFrame *Frame, pid_t pid, size_t cpusetsize, const unsigned long *mask) -> uint64_t {
+      const uint32_t VirtualCPUs = GuestVirtualCPUCount();
+      if (VirtualCPUs) {
+        // Virtualized topology: guest CPU indices don't correspond to host
+        // CPUs, so pinning requests must not constrain host scheduling.
+        // Validate against the advertised CPUs and accept, matching what the
+        // kernel does for a mask that only names offline CPUs otherwise.
+        if (!mask || !cpusetsize) {
+          return -EFAULT;
+        }
+        const size_t Bits = std::min<size_t>(cpusetsize * 8, VirtualCPUs);
+        bool AnyVisible = false;
+        for (size_t i = 0; i < Bits; ++i) {
+          if (mask[i / (sizeof(unsigned long) * 8)] & (1UL << (i % (sizeof(unsigned long) * 8)))) {
+            AnyVisible = true;
+            break;
+          }
+        }
+        return AnyVisible ? 0 : -EINVAL;
+      }
+
       uint64_t Result = ::syscall(SYSCALL_DEF(sched_setaffinity), pid, cpusetsize, mask);
       SYSCALL_ERRNO();
     });
@@ -87,6 +120,19 @@ namespace FEX::HLE {
     REGISTER_SYSCALL_IMPL_FLAGS(sched_getaffinity, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, pid_t pid, size_t cpusetsize, unsigned char *mask) -> uint64_t {
       uint64_t Result = ::syscall(SYSCALL_DEF(sched_getaffinity), pid, cpusetsize, mask);
+
+      const uint32_t VirtualCPUs = GuestVirtualCPUCount();
+      if (VirtualCPUs && Result != uint64_t(-1)) {
+        // Rewrite the kernel's answer to the advertised topology: all virtual
+        // CPUs runnable, nothing above them. Thread pools sized from this
+        // then agree with CPUID and /proc/cpuinfo.
+        const size_t Bytes = Result;
+        memset(mask, 0, Bytes);
+        const size_t Bits = std::min<size_t>(Bytes * 8, VirtualCPUs);
+        for (size_t i = 0; i < Bits; ++i) {
+          mask[i / 8] |= 1U << (i % 8);
+        }
+      }
       SYSCALL_ERRNO();
     });
 
@@ -14,13 +14,17 @@ $end_info$
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Thread.h"
 
+#include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Core/X86Enums.h>
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/IR/IR.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
 
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <fnmatch.h>
 #include <grp.h>
 #include <limits.h>
 #include <linux/futex.h>
@@ -41,6 +45,96 @@ ARG_TO_STR(idtype_t, "%u")
 
 namespace FEX::HLE {
 
+  // Flags the calling guest thread for bounded-latency compiles when its
+  // freshly set name matches one of the configured patterns. Guest audio and
+  // input threads identify themselves through pthread_setname_np, which lands
+  // here as prctl PR_SET_NAME.
+  static void CheckLatencyCriticalThreadName(FEXCore::Core::InternalThreadState *Thread) {
+    static const fextl::vector<fextl::string> Patterns = []() {
+      FEX_CONFIG_OPT(LatencyCriticalThreads, LATENCYCRITICALTHREADS);
+      const fextl::string List = LatencyCriticalThreads();
+
+      fextl::vector<fextl::string> Result{};
+      size_t Begin = 0;
+      while (Begin <= List.size()) {
+        size_t End = List.find(',', Begin);
+        if (End == fextl::string::npos) {
+          End = List.size();
+        }
+        if (End != Begin) {
+          Result.push_back(List.substr(Begin, End - Begin));
+        }
+        Begin = End + 1;
+      }
+      return Result;
+    }();
+
+    if (Patterns.empty()) {
+      return;
+    }
+
+    // The name was just applied to the calling thread, so read it back
+    // truncated and null terminated instead of trusting the guest pointer.
+    char Comm[17] {};
+    if (::prctl(PR_GET_NAME, Comm) != 0) {
+      return;
+    }
+
+    // Renames both set and clear the flag so it always reflects the current name.
+    Thread->LatencyCriticalCompile = std::any_of(Patterns.begin(), Patterns.end(), [&Comm](const auto &Pattern) {
+      return fnmatch(Pattern.c_str(), Comm, 0) == 0;
+    });
+  }
+
+  bool TryFutexWaitFastPath(int *uaddr, int futex_op, int val, const void *timeout, uint64_t *Result) {
+    static const bool SpinEnabled = []() {
+      FEX_CONFIG_OPT(FutexSpinWait, FUTEXSPINWAIT);
+      return FutexSpinWait();
+    }();
+
+    if (!SpinEnabled) {
+      return false;
+    }
+
+    const int cmd = futex_op & FUTEX_CMD_MASK;
+    if (cmd != FUTEX_WAIT || !(futex_op & FUTEX_PRIVATE_FLAG) || timeout) {
+      return false;
+    }
+
+    // Same check the kernel does before sleeping. Under contention the owner
+    // frequently releases the lock between the guest's userspace check and the
+    // syscall, so this resolves a good chunk of waits without entering the
+    // kernel at all.
+    if (__atomic_load_n(uaddr, __ATOMIC_ACQUIRE) != val) {
+      *Result = -EAGAIN;
+      return true;
+    }
+
+#ifdef _M_ARM_64
+    // Briefly spin on the futex word before sleeping in the kernel. The
+    // waker's store to the word clears the exclusive monitor and drops us out
+    // of WFE, so a quickly arriving wakeup is noticed without either side
+    // paying for a kernel round trip. The architectural event stream bounds
+    // each WFE, so an absent wakeup falls through to the real syscall shortly.
+    // An early drop-out amounts to a spurious wakeup, which FUTEX_WAIT is
+    // documented to allow.
+    for (size_t i = 0; i < 32; ++i) {
+      int Current{};
+      __asm volatile("ldaxr %w[Res], [%[Addr]];"
+        : [Res] "=r" (Current)
+        : [Addr] "r" (uaddr)
+        : "memory");
+      if (Current != val) {
+        *Result = 0;
+        return true;
+      }
+      __asm volatile("wfe;" ::: "memory");
+    }
+#endif
+
+    return false;
+  }
+
   struct ExecutionThreadHandler {
     FEXCore::Context::Context *CTX;
     FEXCore::Core::InternalThreadState *Thread;
@@ -527,6 +621,12 @@ namespace FEX::HLE {
         // FEX doesn't support seccomp
         return -EINVAL;
         break;
+      case PR_SET_NAME:
+        Result = ::prctl(option, arg2, arg3, arg4, arg5);
+        if (Result == 0) {
+          CheckLatencyCriticalThreadName(Frame->Thread);
+        }
+        break;
       default:
         Result = ::prctl(option, arg2, arg3, arg4, arg5);
       break;
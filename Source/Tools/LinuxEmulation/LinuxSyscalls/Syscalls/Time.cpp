@@ -9,11 +9,65 @@ $end_info$
 #include "LinuxSyscalls/x64/Syscalls.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 
+#include <FEXCore/Config/Config.h>
 #include <FEXCore/IR/IR.h>
 
+#include <stdint.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace FEX::HLE {
+  bool TryNanosleepFastPath(clockid_t clockid, int flags, const struct timespec *req, uint64_t *Result) {
+    static const uint64_t SpinThreshold = []() -> uint64_t {
+      FEX_CONFIG_OPT(SleepSpinThreshold, SLEEPSPINTHRESHOLD);
+      return SleepSpinThreshold();
+    }();
+
+    if (!SpinThreshold || !req) {
+      return false;
+    }
+
+    // Only relative sleeps measure a duration, and only the common clocks
+    // match what the spin measures. Absolute deadlines and the exotic clocks
+    // keep their host semantics.
+    if ((flags & TIMER_ABSTIME) ||
+        (clockid != CLOCK_MONOTONIC && clockid != CLOCK_REALTIME)) {
+      return false;
+    }
+
+    // Malformed requests fall through so the host syscall produces EINVAL.
+    if (req->tv_sec != 0 || req->tv_nsec < 0 || req->tv_nsec >= 1'000'000'000 ||
+        static_cast<uint64_t>(req->tv_nsec) > SpinThreshold) {
+      return false;
+    }
+
+    // Frame-pacing loops sleep for tens of microseconds thousands of times a
+    // second, and at that grain the exit/entry cost of the host syscall is a
+    // large fraction of the requested time. Burn the interval on the
+    // clock_gettime vDSO instead. Signal delivery is deferred by at most the
+    // threshold, the same order as the kernel's own timer slack. A completed
+    // sleep leaves rem untouched, matching the kernel on success.
+    struct timespec Start{};
+    ::clock_gettime(CLOCK_MONOTONIC, &Start);
+
+    const int64_t WaitNS = req->tv_nsec;
+    for (;;) {
+      struct timespec Now{};
+      ::clock_gettime(CLOCK_MONOTONIC, &Now);
+      const int64_t ElapsedNS = (Now.tv_sec - Start.tv_sec) * 1'000'000'000LL +
+                                (Now.tv_nsec - Start.tv_nsec);
+      if (ElapsedNS >= WaitNS) {
+        break;
+      }
+#ifdef _M_ARM_64
+      __asm volatile("yield;" ::: "memory");
+#endif
+    }
+
+    *Result = 0;
+    return true;
+  }
+
   void RegisterTime(FEX::HLE::SyscallHandler *Handler) {
     using namespace FEXCore::IR;
 
@@ -46,9 +46,107 @@ auto SyscallHandler::VMAFlags::fromFlags(int Flags) -> VMAFlags {
   };
 }
 
+/// Sharded epoch tracking ///
+void SyscallHandler::VMAShardedEpochs::BeginWrite(uint64_t Base, uint64_t Top) {
+  if (Top <= Base) {
+    return;
+  }
+
+  const uint64_t FirstGranule = Base >> SHARD_GRANULE_SHIFT;
+  const uint64_t LastGranule = (Top - 1) >> SHARD_GRANULE_SHIFT;
+  const uint64_t Count = std::min<uint64_t>(LastGranule - FirstGranule + 1, SHARD_COUNT);
+
+  for (uint64_t i = 0; i < Count; ++i) {
+    auto &Shard = Shards[(FirstGranule + i) % SHARD_COUNT];
+
+    // Odd epoch - write in progress, readers take the locked slow path
+    Shard.Epoch.fetch_add(1, std::memory_order_acq_rel);
+
+    // The cached entries may describe VMAs this write is about to change
+    for (auto &Entry : Shard.Entries) {
+      Entry.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void SyscallHandler::VMAShardedEpochs::EndWrite(uint64_t Base, uint64_t Top) {
+  if (Top <= Base) {
+    return;
+  }
+
+  const uint64_t FirstGranule = Base >> SHARD_GRANULE_SHIFT;
+  const uint64_t LastGranule = (Top - 1) >> SHARD_GRANULE_SHIFT;
+  const uint64_t Count = std::min<uint64_t>(LastGranule - FirstGranule + 1, SHARD_COUNT);
+
+  for (uint64_t i = 0; i < Count; ++i) {
+    Shards[(FirstGranule + i) % SHARD_COUNT].Epoch.fetch_add(1, std::memory_order_release);
+  }
+}
+
+void SyscallHandler::VMAShardedEpochs::PublishPrivateWritable(uint64_t FaultBase, uint64_t Base, uint64_t Length) {
+  const uint64_t Pages = Length / FHU::FEX_PAGE_SIZE;
+  const uint64_t BasePage = Base / FHU::FEX_PAGE_SIZE;
+
+  // Too large to pack, not worth caching
+  if (Pages == 0 || Pages >= ENTRY_MAX_PAGES || BasePage >= (1ULL << ENTRY_PAGE_BITS)) {
+    return;
+  }
+
+  // Publish in to the faulting address's shard, repeated faults in the same
+  // region will probe the same shard. A mutation of any page looked up through
+  // this shard bumps this shard's epoch, so the entry can safely describe a
+  // VMA that spans other shards.
+  auto &Shard = ShardFor(FaultBase);
+  const auto Slot = Shard.NextEntry.fetch_add(1, std::memory_order_relaxed) % ENTRIES_PER_SHARD;
+  Shard.Entries[Slot].store(BasePage | (Pages << ENTRY_PAGE_BITS), std::memory_order_release);
+}
+
+bool SyscallHandler::VMAShardedEpochs::LookupPrivateWritable(uint64_t FaultBase) {
+  auto &Shard = ShardFor(FaultBase);
+
+  const auto Epoch = Shard.Epoch.load(std::memory_order_acquire);
+  if (Epoch & 1) {
+    // Write in progress
+    return false;
+  }
+
+  for (auto &EntrySlot : Shard.Entries) {
+    const auto Packed = EntrySlot.load(std::memory_order_acquire);
+    if (!Packed) {
+      continue;
+    }
+
+    const uint64_t Base = (Packed & ((1ULL << ENTRY_PAGE_BITS) - 1)) * FHU::FEX_PAGE_SIZE;
+    const uint64_t Top = Base + (Packed >> ENTRY_PAGE_BITS) * FHU::FEX_PAGE_SIZE;
+
+    if (FaultBase < Base || FaultBase >= Top) {
+      continue;
+    }
+
+    // The match only counts if no writer touched this shard since the epoch
+    // was sampled
+    return Shard.Epoch.load(std::memory_order_acquire) == Epoch;
+  }
+
+  return false;
+}
+
 // SMC interactions
 bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) {
   const auto FaultAddress = (uintptr_t)((siginfo_t *)info)->si_addr;
+  const auto FaultBase = FEXCore::AlignDown(FaultAddress, FHU::FEX_PAGE_SIZE);
+
+  // Fast path - a known private writable mapping can be flushed without ever
+  // touching the VMA mutex, so mmap/mprotect traffic on other threads doesn't
+  // stall this fault
+  if (_SyscallHandler->SMCSharding.LookupPrivateWritable(FaultBase)) {
+    _SyscallHandler->TM.InvalidateGuestCodeRange(Thread, FaultBase, FHU::FEX_PAGE_SIZE, [](uintptr_t Start, uintptr_t Length) {
+      auto rv = mprotect((void *)Start, Length, PROT_READ | PROT_WRITE);
+      LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", Start, Length);
+    });
+
+    return true;
+  }
 
   {
     // Can't use the deferred signal lock in the SIGSEGV handler.
@@ -64,8 +162,6 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
       return false;
     }
 
-    auto FaultBase = FEXCore::AlignDown(FaultAddress, FHU::FEX_PAGE_SIZE);
-
     if (Entry->second.Flags.Shared) {
       LOGMAN_THROW_A_FMT(Entry->second.Resource, "VMA tracking error");
 
@@ -90,6 +186,9 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
         }
       } while ((VMA = VMA->ResourceNextVMA));
     } else {
+      // Let future faults in this mapping take the lock-free fast path
+      _SyscallHandler->SMCSharding.PublishPrivateWritable(FaultBase, Entry->first, Entry->second.Length);
+
       _SyscallHandler->TM.InvalidateGuestCodeRange(Thread, FaultBase, FHU::FEX_PAGE_SIZE, [](uintptr_t Start, uintptr_t Length) {
         auto rv = mprotect((void *)Start, Length, PROT_READ | PROT_WRITE);
         LogMan::Throw::AAFmt(rv == 0, "mprotect({}, {}) failed", Start, Length);
@@ -164,6 +263,19 @@ void SyscallHandler::MarkGuestExecutableRange(FEXCore::Core::InternalThreadState
 
 // Used for AOT
 FEXCore::HLE::AOTIRCacheEntryLookupResult SyscallHandler::LookupAOTIRCacheEntry(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestAddr) {
+  // This runs for every block compile; resolve against the wait-free snapshot
+  // so concurrent mmap/mprotect traffic from other threads can't stall it.
+  // Only a lookup that raced a writer has to fall through to the lock.
+  VMATracking::SnapshotEntry Snapshot;
+  switch (VMATracking.LookupVMASnapshot(GuestAddr, &Snapshot)) {
+  case VMATracking::SnapshotResult::Hit:
+    return {Snapshot.AOTIRCacheEntry, Snapshot.Base - Snapshot.Offset};
+  case VMATracking::SnapshotResult::Miss:
+    return {nullptr, 0};
+  case VMATracking::SnapshotResult::Retry:
+    break;
+  }
+
   auto lk = FEXCore::GuardSignalDeferringSection<std::shared_lock>(VMATracking.Mutex, Thread);
 
   // Get the first mapping after GuestAddr, or end
@@ -203,16 +315,25 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
       fstat64(fd, &buf);
       MRID mrid {buf.st_dev, buf.st_ino};
 
-      char Tmp[PATH_MAX];
-      auto PathLength = FEX::get_fdpath(fd, Tmp);
+      // fds opened through the FileManager carry their resolved host path in
+      // the per-fd attribute cache, skipping the /proc/self/fd readlink.
+      fextl::string Filename{};
+      if (auto Attributes = FM.LookupFDAttributes(fd); Attributes && !Attributes->HostPath.empty()) {
+        Filename = std::move(Attributes->HostPath);
+      } else {
+        char Tmp[PATH_MAX];
+        auto PathLength = FEX::get_fdpath(fd, Tmp);
+        if (PathLength != -1) {
+          Filename = fextl::string(Tmp, PathLength);
+        }
+      }
 
-      if (PathLength != -1) {
-        Tmp[PathLength] = '\0';
+      if (!Filename.empty()) {
         auto [Iter, Inserted] = VMATracking.MappedResources.emplace(mrid, MappedResource {nullptr, nullptr, 0});
         Resource = &Iter->second;
 
         if (Inserted) {
-          Resource->AOTIRCacheEntry = CTX->LoadAOTIRCacheEntry(fextl::string(Tmp, PathLength));
+          Resource->AOTIRCacheEntry = CTX->LoadAOTIRCacheEntry(Filename);
           Resource->Iterator = Iter;
         }
       }
@@ -227,7 +348,10 @@ void SyscallHandler::TrackMmap(FEXCore::Core::InternalThreadState *Thread, uintp
       Resource = nullptr;
     }
 
+    SMCSharding.BeginWrite(Base, Base + Size);
     VMATracking.SetUnsafe(CTX, Resource, Base, Offset, Size, VMAFlags::fromFlags(Flags), VMAProt::fromProt(Prot));
+    SMCSharding.EndWrite(Base, Base + Size);
+    VMATracking.PublishSnapshot();
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
@@ -245,7 +369,10 @@ void SyscallHandler::TrackMunmap(FEXCore::Core::InternalThreadState *Thread, uin
     // To be more optimal the frontend should provide this code with a valid Thread object earlier.
     auto lk = FEXCore::GuardSignalDeferringSectionWithFallback(VMATracking.Mutex, Thread);
 
+    SMCSharding.BeginWrite(Base, Base + Size);
     VMATracking.ClearUnsafe(CTX, Base, Size);
+    SMCSharding.EndWrite(Base, Base + Size);
+    VMATracking.PublishSnapshot();
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
@@ -259,7 +386,10 @@ void SyscallHandler::TrackMprotect(FEXCore::Core::InternalThreadState *Thread, u
   {
     auto lk = FEXCore::GuardSignalDeferringSection(VMATracking.Mutex, Thread);
 
+    SMCSharding.BeginWrite(Base, Base + Size);
     VMATracking.ChangeUnsafe(Base, Size, VMAProt::fromProt(Prot));
+    SMCSharding.EndWrite(Base, Base + Size);
+    VMATracking.PublishSnapshot();
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
@@ -283,6 +413,9 @@ void SyscallHandler::TrackMremap(FEXCore::Core::InternalThreadState *Thread, uin
 
     LOGMAN_THROW_A_FMT(OldVMA != VMATracking.VMAs.end(), "VMA Tracking corruption");
 
+    SMCSharding.BeginWrite(OldAddress, OldAddress + OldSize);
+    SMCSharding.BeginWrite(NewAddress, NewAddress + NewSize);
+
     if (OldSize == 0) {
       // Mirror existing mapping
       // must be a shared mapping
@@ -302,6 +435,10 @@ void SyscallHandler::TrackMremap(FEXCore::Core::InternalThreadState *Thread, uin
       // Make anonymous mapping
       VMATracking.SetUnsafe(CTX, OldResource, NewAddress, OldOffset, NewSize, OldFlags, OldProt);
     }
+
+    SMCSharding.EndWrite(OldAddress, OldAddress + OldSize);
+    SMCSharding.EndWrite(NewAddress, NewAddress + NewSize);
+    VMATracking.PublishSnapshot();
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
@@ -340,9 +477,12 @@ void SyscallHandler::TrackShmat(FEXCore::Core::InternalThreadState *Thread, int
     if (ResourceInserted.second) {
       Resource->Iterator = ResourceInserted.first;
     }
+    SMCSharding.BeginWrite(Base, Base + Length);
     VMATracking.SetUnsafe(CTX, Resource, Base, 0, Length, VMAFlags::fromFlags(MAP_SHARED),
       VMAProt::fromProt((shmflg & SHM_RDONLY) ? PROT_READ : (PROT_READ | PROT_WRITE))
     );
+    SMCSharding.EndWrite(Base, Base + Length);
+    VMATracking.PublishSnapshot();
   }
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     _SyscallHandler->TM.InvalidateGuestCodeRange(Thread, Base, Length);
@@ -354,7 +494,11 @@ void SyscallHandler::TrackShmdt(FEXCore::Core::InternalThreadState *Thread, uint
   {
     auto lk = FEXCore::GuardSignalDeferringSection(VMATracking.Mutex, Thread);
 
+    // The length isn't known until the shm is cleared, bump every shard
+    SMCSharding.BeginWrite(0, UINT64_MAX);
     Length = VMATracking.ClearShmUnsafe(CTX, Base);
+    SMCSharding.EndWrite(0, UINT64_MAX);
+    VMATracking.PublishSnapshot();
   }
 
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
@@ -365,9 +509,41 @@ void SyscallHandler::TrackShmdt(FEXCore::Core::InternalThreadState *Thread, uint
 
 void SyscallHandler::TrackMadvise(FEXCore::Core::InternalThreadState *Thread, uintptr_t Base, uintptr_t Size, int advice) {
   Size = FEXCore::AlignUp(Size, FHU::FEX_PAGE_SIZE);
+
+  // Only advice that destroys or replaces page contents can stale compiled
+  // code. Everything else is an access-pattern hint and changes nothing.
+  // Guest JITs lean on MADV_DONTNEED to reset code arenas instead of
+  // mprotect+write cycles, so this is also the cheap range-invalidation
+  // idiom aware guests get told about through the FEX hypervisor CPUID leaf.
+  if (advice != MADV_DONTNEED && advice != MADV_REMOVE && advice != MADV_FREE) {
+    return;
+  }
+
+  bool ContainsExecutable = false;
   {
     auto lk = FEXCore::GuardSignalDeferringSection(VMATracking.Mutex, Thread);
-    // TODO
+
+    // Scope the invalidation to ranges that can actually hold code, so the
+    // overwhelmingly common data-heap madvise never touches the invalidation
+    // machinery.
+    auto It = VMATracking.VMAs.upper_bound(Base);
+    if (It != VMATracking.VMAs.begin()) {
+      --It;
+      if (It->first + It->second.Length <= Base) {
+        ++It;
+      }
+    }
+    for (; It != VMATracking.VMAs.end() && It->first < Base + Size; ++It) {
+      if (It->second.Prot.Executable) {
+        ContainsExecutable = true;
+        break;
+      }
+    }
+  }
+
+  if (ContainsExecutable && SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
+    // VMATracking.Mutex can't be held here, same as the other Track paths.
+    _SyscallHandler->TM.InvalidateGuestCodeRange(Thread, Base, Size);
   }
 }
 
@@ -9,6 +9,8 @@ $end_info$
 
 #include "LinuxSyscalls/Syscalls.h"
 
+#include <algorithm>
+
 namespace FEX::HLE {
 /// List Operations ///
 
@@ -323,6 +325,91 @@ void SyscallHandler::VMATracking::ChangeUnsafe(uintptr_t Base, uintptr_t Length,
   }
 }
 
+/// Read snapshots ///
+
+// Rebuilds the wait-free lookup snapshot from the VMA map.
+// Mutex must be unique_locked, call once per tracking operation after all
+// mutations are done.
+void SyscallHandler::VMATracking::PublishSnapshot() {
+  // Odd epoch - publish in progress, readers take the locked path
+  SnapshotEpoch.fetch_add(1, std::memory_order_acq_rel);
+
+  if (SnapshotStorage.capacity() < VMAs.size()) {
+    // A stale reader may still be walking the old allocation, retire it
+    // instead of letting the vector free it underneath them.
+    RetiredSnapshots.emplace_back(std::move(SnapshotStorage));
+    SnapshotStorage = {};
+    SnapshotStorage.reserve(std::max<size_t>(VMAs.size() * 2, 64));
+  }
+
+  SnapshotStorage.clear();
+  for (const auto &[Base, VMA] : VMAs) {
+    SnapshotStorage.push_back(SnapshotEntry{
+        .Base = VMA.Base,
+        .Top = VMA.Base + VMA.Length,
+        .Offset = VMA.Offset,
+        .AOTIRCacheEntry = VMA.Resource ? VMA.Resource->AOTIRCacheEntry : nullptr,
+        .Flags = VMA.Flags,
+        .Prot = VMA.Prot,
+    });
+  }
+
+  SnapshotData.store(SnapshotStorage.data(), std::memory_order_relaxed);
+  SnapshotSize.store(SnapshotStorage.size(), std::memory_order_relaxed);
+
+  SnapshotEpoch.fetch_add(1, std::memory_order_release);
+}
+
+// Wait-free point lookup against the last published snapshot.
+// Mirrors LookupVMAUnsafe but copies the entry out by value, interleaved
+// writers are detected through the epoch and reported as Retry.
+SyscallHandler::VMATracking::SnapshotResult
+SyscallHandler::VMATracking::LookupVMASnapshot(uint64_t GuestAddr, SnapshotEntry *Entry) const {
+  const auto Epoch = SnapshotEpoch.load(std::memory_order_acquire);
+  const auto *Data = SnapshotData.load(std::memory_order_acquire);
+  const auto Size = SnapshotSize.load(std::memory_order_acquire);
+
+  // Odd means mid-publish; a changed epoch means Data and Size might be from
+  // different publishes.
+  if ((Epoch & 1) || SnapshotEpoch.load(std::memory_order_acquire) != Epoch) {
+    return SnapshotResult::Retry;
+  }
+
+  // upper_bound on Base, then check the entry before it, as LookupVMAUnsafe
+  // does. Index arithmetic stays within [0, Size) even if a writer scribbles
+  // over the array mid-search; the recheck below rejects whatever was read.
+  size_t Low = 0;
+  size_t Count = Size;
+  while (Count) {
+    const auto Step = Count / 2;
+    if (Data[Low + Step].Base <= GuestAddr) {
+      Low += Step + 1;
+      Count -= Step + 1;
+    } else {
+      Count = Step;
+    }
+  }
+
+  SnapshotEntry Found{};
+  bool Matched = false;
+  if (Low != 0) {
+    Found = Data[Low - 1];
+    Matched = Found.Base <= GuestAddr && Found.Top > GuestAddr;
+  }
+
+  // Only trust the result if no writer interleaved with the search
+  if (SnapshotEpoch.load(std::memory_order_acquire) != Epoch) {
+    return SnapshotResult::Retry;
+  }
+
+  if (!Matched) {
+    return SnapshotResult::Miss;
+  }
+
+  *Entry = Found;
+  return SnapshotResult::Hit;
+}
+
 // This matches the peculiarities algorithm used in linux ksys_shmdt (linux kernel 5.16, ipc/shm.c)
 uintptr_t SyscallHandler::VMATracking::ClearShmUnsafe(FEXCore::Context::Context *CTX, uintptr_t Base) {
 
@@ -4,9 +4,27 @@
 #include "LinuxSyscalls/SignalDelegator.h"
 
 #include <FEXHeaderUtils/Syscalls.h>
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <chrono>
+#include <sys/mman.h>
+#include <thread>
 
 namespace FEX::HLE {
+  void ThreadManager::ReapDeadThreads() {
+    // Deconstructing the internal thread state should clean up most of the state.
+    // But if anything on the now deleted stack is holding a refrence to the heap, it will be leaked
+    for (auto &DeadThread : DeadThreadsAfterFork) {
+      CTX->DestroyThread(DeadThread);
+    }
+    DeadThreadsAfterFork.clear();
+  }
+
   FEXCore::Core::InternalThreadState *ThreadManager::CreateThread(uint64_t InitialRIP, uint64_t StackPointer, FEXCore::Core::CPUState *NewThreadState, uint64_t ParentTID) {
+    // A forked child that creates a thread is going to keep running; now is
+    // the time to pay for the parent's dead thread state it inherited.
+    ReapDeadThreads();
+
     auto Thread = CTX->CreateThread(InitialRIP, StackPointer, NewThreadState, ParentTID);
 
     std::lock_guard lk(ThreadCreationMutex);
@@ -57,6 +75,36 @@ namespace FEX::HLE {
   void ThreadManager::NotifyPause() {
     // Tell all the threads that they should pause
     std::lock_guard lk(ThreadCreationMutex);
+
+    if (CoopPreempt()) {
+      // Arm each running thread's interrupt fault page instead of signalling
+      // it. The JIT polls the page with a store at every block entry, so a
+      // thread executing guest code parks itself on its next block; one
+      // mprotect here replaces a signal delivery plus handler entry per
+      // thread, which is what makes pausing scale past ~100 guest threads.
+      for (auto &Thread : Threads) {
+        if (!Thread->RunningEvents.Running.load()) {
+          continue;
+        }
+        Thread->SignalReason.store(FEXCore::Core::SignalEvent::Pause);
+        mprotect(Thread->InterruptFaultPage, FHU::FEX_PAGE_SIZE, PROT_READ);
+      }
+
+      // Threads blocked in a syscall never reach a block entry, so give
+      // everyone a short window to park and fall back to the pause signal
+      // for whoever is still going.
+      for (size_t i = 0; i < 20 && IdleWaitRefCount.load() != 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+
+      for (auto &Thread : Threads) {
+        if (!Thread->RunningEvents.ThreadSleeping) {
+          SignalDelegation->SignalThread(Thread, FEXCore::Core::SignalEvent::Pause);
+        }
+      }
+      return;
+    }
+
     for (auto &Thread : Threads) {
       SignalDelegation->SignalThread(Thread, FEXCore::Core::SignalEvent::Pause);
     }
@@ -209,9 +257,12 @@ namespace FEX::HLE {
 
       // FIXME: TLS is probally still alive. Investigate
 
-      // Deconstructing the Interneal thread state should clean up most of the state.
-      // But if anything on the now deleted stack is holding a refrence to the heap, it will be leaked
-      CTX->DestroyThread(DeadThread);
+      // Destroying the thread here would free its lookup cache, code buffers
+      // and heap state - faulting in private copies of COW pages on the fork
+      // critical path for metadata a child that is about to exec never
+      // touches. Defer the teardown until the child demonstrably keeps
+      // running; exec discards the whole list for free.
+      DeadThreadsAfterFork.push_back(DeadThread);
 
       // FIXME: Make sure sure nothing gets leaked via the heap. Ideas:
       //         * Make sure nothing is allocated on the heap without ref in InternalThreadState
@@ -242,6 +293,8 @@ namespace FEX::HLE {
   ThreadManager::~ThreadManager() {
     std::lock_guard lk(ThreadCreationMutex);
 
+    ReapDeadThreads();
+
     for (auto &Thread : Threads) {
       HandleThreadDeletion(Thread);
     }
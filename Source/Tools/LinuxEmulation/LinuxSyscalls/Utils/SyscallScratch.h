@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <FEXCore/Utils/MathUtils.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace FEX::HLE {
+  /**
+   * @brief Per-thread bump arena for temporary host copies of guest struct arrays.
+   *
+   * The hot compat syscalls (readv/writev family, sendmsg/recvmsg, epoll waits)
+   * used to construct a fextl::vector per call, which costs a heap round-trip on
+   * every syscall. Allocations from this arena come out of a reusable per-thread
+   * buffer instead. A handler opens a Scope at its top; every allocation made
+   * while the Scope is live stays valid until it unwinds, including across later
+   * allocations.
+   */
+  class SyscallScratchArena final {
+  public:
+    class Scope final {
+    public:
+      explicit Scope(SyscallScratchArena &Arena)
+        : Arena {Arena}
+        , SavedOffset {Arena.Offset}
+        , SavedOverflowCount {Arena.Overflow.size()} {}
+
+      ~Scope() {
+        Arena.Offset = SavedOffset;
+        Arena.Overflow.resize(SavedOverflowCount);
+      }
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+    private:
+      SyscallScratchArena &Arena;
+      size_t SavedOffset;
+      size_t SavedOverflowCount;
+    };
+
+    /**
+     * @brief Bump allocates an uninitialized array of Count T.
+     *
+     * The fixed buffer covers any reasonable request. Oversized requests fall
+     * back to a heap block that lives until the covering Scope unwinds, so
+     * callers never need to handle the overflow case themselves.
+     */
+    template<typename T>
+    T *Allocate(size_t Count) {
+      const size_t Bytes = FEXCore::AlignUp(Count * sizeof(T), alignof(std::max_align_t));
+      if ((FIXED_SIZE - Offset) < Bytes) {
+        auto &Block = Overflow.emplace_back();
+        Block.resize(Bytes);
+        return reinterpret_cast<T*>(Block.data());
+      }
+
+      T *Result = reinterpret_cast<T*>(&Fixed[Offset]);
+      Offset += Bytes;
+      return Result;
+    }
+
+    /**
+     * @brief Copies Count guest entries in to a host representation array.
+     *
+     * Relies on the guest type's conversion operator, just like the vector
+     * range construction the handlers previously used. Accepts raw pointers
+     * and compat_ptr alike, anything indexable works.
+     */
+    template<typename THost, typename TGuestPtr>
+    THost *AllocateConverted(TGuestPtr Guest, size_t Count) {
+      THost *Result = Allocate<THost>(Count);
+      for (size_t i = 0; i < Count; ++i) {
+        Result[i] = Guest[i];
+      }
+      return Result;
+    }
+
+  private:
+    constexpr static size_t FIXED_SIZE = 16 * 1024;
+
+    alignas(alignof(std::max_align_t)) uint8_t Fixed[FIXED_SIZE];
+    size_t Offset{};
+    fextl::vector<fextl::vector<uint8_t>> Overflow{};
+  };
+
+  inline SyscallScratchArena &GetSyscallScratchArena() {
+    static thread_local SyscallScratchArena Arena{};
+    return Arena;
+  }
+}
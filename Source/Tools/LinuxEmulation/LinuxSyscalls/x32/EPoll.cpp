@@ -8,12 +8,11 @@ $end_info$
 
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/Types.h"
+#include "LinuxSyscalls/Utils/SyscallScratch.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 
-#include <FEXCore/fextl/vector.h>
-
 #include <algorithm>
 #include <cstdint>
 #include <sys/epoll.h>
@@ -31,8 +30,10 @@ namespace FEXCore::Core {
 namespace FEX::HLE::x32 {
   void RegisterEpoll(FEX::HLE::SyscallHandler *Handler) {
     REGISTER_SYSCALL_IMPL_X32(epoll_wait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevents, int timeout) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevents));
-      uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events.data(), maxevents, timeout, nullptr, 8);
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Events = Scratch.Allocate<struct epoll_event>(std::max(0, maxevents));
+      uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait), epfd, Events, maxevents, timeout, nullptr, 8);
 
       if (Result != -1) {
         for (size_t i = 0; i < Result; ++i) {
@@ -49,11 +50,13 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(epoll_pwait, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, int timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-      fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Events = Scratch.Allocate<struct epoll_event>(std::max(0, maxevent));
 
       uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait),
         epfd,
-        Events.data(),
+        Events,
         maxevent,
         timeout,
         sigmask,
@@ -70,7 +73,9 @@ namespace FEX::HLE::x32 {
 
     if (Handler->IsHostKernelVersionAtLeast(5, 11, 0)) {
       REGISTER_SYSCALL_IMPL_X32(epoll_pwait2, [](FEXCore::Core::CpuStateFrame *Frame, int epfd, compat_ptr<FEX::HLE::x32::epoll_event32> events, int maxevent, compat_ptr<timespec32> timeout, const uint64_t* sigmask, size_t sigsetsize) -> uint64_t {
-        fextl::vector<struct epoll_event> Events(std::max(0, maxevent));
+        auto &Scratch = GetSyscallScratchArena();
+        SyscallScratchArena::Scope ScratchScope {Scratch};
+        auto *Events = Scratch.Allocate<struct epoll_event>(std::max(0, maxevent));
 
         struct timespec tp64{};
         struct timespec *timed_ptr{};
@@ -81,7 +86,7 @@ namespace FEX::HLE::x32 {
 
         uint64_t Result = ::syscall(SYSCALL_DEF(epoll_pwait2),
           epfd,
-          Events.data(),
+          Events,
           maxevent,
           timed_ptr,
           sigmask,
@@ -6,6 +6,7 @@ $end_info$
 */
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/Utils/SyscallScratch.h"
 #include "LinuxSyscalls/x32/IoctlEmulation.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/SyscallsEnum.h"
@@ -16,7 +17,6 @@ $end_info$
 #include <FEXCore/Debug/InternalThreadState.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/MathUtils.h>
-#include <FEXCore/fextl/vector.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -148,6 +148,7 @@ namespace FEX::HLE::x32 {
         case F_DUPFD:
         case F_DUPFD_CLOEXEC:
           FEX::HLE::x32::CheckAndAddFDDuplication(fd, Result);
+          FEX::HLE::_SyscallHandler->FM.DupFDAttributes(fd, Result, old_cmd == F_DUPFD_CLOEXEC);
           break;
         case F_GETFL: {
           Result = FEX::HLE::RemapToX86Flags(Result);
@@ -304,14 +305,18 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(readv, [](FEXCore::Core::CpuStateFrame *Frame, int fd, const struct iovec32 *iov, int iovcnt) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
-      uint64_t Result = ::readv(fd, Host_iovec.data(), iovcnt);
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, SanitizeIOCount(iovcnt));
+      uint64_t Result = ::readv(fd, Host_iovec, iovcnt);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X32(writev, [](FEXCore::Core::CpuStateFrame *Frame, int fd, const struct iovec32 *iov, int iovcnt) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
-      uint64_t Result = ::writev(fd, Host_iovec.data(), iovcnt);
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, SanitizeIOCount(iovcnt));
+      uint64_t Result = ::writev(fd, Host_iovec, iovcnt);
       SYSCALL_ERRNO();
     });
 
@@ -494,6 +499,7 @@ namespace FEX::HLE::x32 {
       uint64_t Result = ::dup(oldfd);
       if (Result != -1) {
         CheckAndAddFDDuplication(oldfd, Result);
+        FEX::HLE::_SyscallHandler->FM.DupFDAttributes(oldfd, Result, false);
       }
       SYSCALL_ERRNO();
     });
@@ -502,6 +508,7 @@ namespace FEX::HLE::x32 {
       uint64_t Result = ::dup2(oldfd, newfd);
       if (Result != -1) {
         CheckAndAddFDDuplication(oldfd, newfd);
+        FEX::HLE::_SyscallHandler->FM.DupFDAttributes(oldfd, newfd, false);
       }
       SYSCALL_ERRNO();
     });
@@ -512,9 +519,11 @@ namespace FEX::HLE::x32 {
       uint32_t iovcnt,
       uint32_t pos_low,
       uint32_t pos_high) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, SanitizeIOCount(iovcnt));
 
-      uint64_t Result = ::syscall(SYSCALL_DEF(preadv), fd, Host_iovec.data(), iovcnt, pos_low, pos_high);
+      uint64_t Result = ::syscall(SYSCALL_DEF(preadv), fd, Host_iovec, iovcnt, pos_low, pos_high);
       SYSCALL_ERRNO();
     });
 
@@ -524,25 +533,31 @@ namespace FEX::HLE::x32 {
       uint32_t iovcnt,
       uint32_t pos_low,
       uint32_t pos_high) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, SanitizeIOCount(iovcnt));
 
-      uint64_t Result = ::syscall(SYSCALL_DEF(pwritev), fd, Host_iovec.data(), iovcnt, pos_low, pos_high);
+      uint64_t Result = ::syscall(SYSCALL_DEF(pwritev), fd, Host_iovec, iovcnt, pos_low, pos_high);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X32(process_vm_readv, [](FEXCore::Core::CpuStateFrame *Frame, pid_t pid, const struct iovec32 *local_iov, unsigned long liovcnt, const struct iovec32 *remote_iov, unsigned long riovcnt, unsigned long flags) -> uint64_t {
-      fextl::vector<iovec> Host_local_iovec(local_iov, local_iov + SanitizeIOCount(liovcnt));
-      fextl::vector<iovec> Host_remote_iovec(remote_iov, remote_iov + SanitizeIOCount(riovcnt));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_local_iovec = Scratch.AllocateConverted<iovec>(local_iov, SanitizeIOCount(liovcnt));
+      auto *Host_remote_iovec = Scratch.AllocateConverted<iovec>(remote_iov, SanitizeIOCount(riovcnt));
 
-      uint64_t Result = ::process_vm_readv(pid, Host_local_iovec.data(), liovcnt, Host_remote_iovec.data(), riovcnt, flags);
+      uint64_t Result = ::process_vm_readv(pid, Host_local_iovec, liovcnt, Host_remote_iovec, riovcnt, flags);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X32(process_vm_writev, [](FEXCore::Core::CpuStateFrame *Frame, pid_t pid, const struct iovec32 *local_iov, unsigned long liovcnt, const struct iovec32 *remote_iov, unsigned long riovcnt, unsigned long flags) -> uint64_t {
-      fextl::vector<iovec> Host_local_iovec(local_iov, local_iov + SanitizeIOCount(liovcnt));
-      fextl::vector<iovec> Host_remote_iovec(remote_iov, remote_iov + SanitizeIOCount(riovcnt));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_local_iovec = Scratch.AllocateConverted<iovec>(local_iov, SanitizeIOCount(liovcnt));
+      auto *Host_remote_iovec = Scratch.AllocateConverted<iovec>(remote_iov, SanitizeIOCount(riovcnt));
 
-      uint64_t Result = ::process_vm_writev(pid, Host_local_iovec.data(), liovcnt, Host_remote_iovec.data(), riovcnt, flags);
+      uint64_t Result = ::process_vm_writev(pid, Host_local_iovec, liovcnt, Host_remote_iovec, riovcnt, flags);
       SYSCALL_ERRNO();
     });
 
@@ -553,9 +568,11 @@ namespace FEX::HLE::x32 {
       uint32_t pos_low,
       uint32_t pos_high,
       int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, SanitizeIOCount(iovcnt));
 
-      uint64_t Result = ::syscall(SYSCALL_DEF(preadv2), fd, Host_iovec.data(), iovcnt, pos_low, pos_high, flags);
+      uint64_t Result = ::syscall(SYSCALL_DEF(preadv2), fd, Host_iovec, iovcnt, pos_low, pos_high, flags);
       SYSCALL_ERRNO();
     });
 
@@ -566,9 +583,11 @@ namespace FEX::HLE::x32 {
       uint32_t pos_low,
       uint32_t pos_high,
       int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + SanitizeIOCount(iovcnt));
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, SanitizeIOCount(iovcnt));
 
-      uint64_t Result = ::syscall(SYSCALL_DEF(pwritev2), fd, Host_iovec.data(),iovcnt, pos_low, pos_high, flags);
+      uint64_t Result = ::syscall(SYSCALL_DEF(pwritev2), fd, Host_iovec,iovcnt, pos_low, pos_high, flags);
       SYSCALL_ERRNO();
     });
 
@@ -960,8 +979,10 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(vmsplice, [](FEXCore::Core::CpuStateFrame *Frame, int fd, const struct iovec32 *iov, unsigned long nr_segs, unsigned int flags) -> uint64_t {
-      fextl::vector<iovec> Host_iovec(iov, iov + nr_segs);
-      uint64_t Result = ::vmsplice(fd, Host_iovec.data(), nr_segs, flags);
+      auto &Scratch = GetSyscallScratchArena();
+      SyscallScratchArena::Scope ScratchScope {Scratch};
+      auto *Host_iovec = Scratch.AllocateConverted<iovec>(iov, nr_segs);
+      uint64_t Result = ::vmsplice(fd, Host_iovec, nr_segs, flags);
       SYSCALL_ERRNO();
     });
   }
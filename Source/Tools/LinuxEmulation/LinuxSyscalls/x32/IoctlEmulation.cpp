@@ -19,8 +19,9 @@
 #include <FEXCore/fextl/map.h>
 #include <FEXCore/fextl/vector.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <functional>
 #include <sys/ioctl.h>
 #include <sys/syscall.h>
 #include <unistd.h>
@@ -43,6 +44,76 @@ namespace FEX::HLE::x32 {
     }
   }
 
+  using IoctlHandlerFn = uint32_t (*)(int fd, uint32_t cmd, uint32_t args);
+
+  // Inline cache of fully resolved handlers keyed by (fd, request).
+  //
+  // Graphics guests issue thousands of identical DRM ioctls per frame; once
+  // the device handler behind an fd is known, a repeat request jumps straight
+  // to it instead of redoing the type dispatch, the NR switch and the per-fd
+  // device lookup.
+  //
+  // Slots are seqlocked so a torn update can never pair a key with another
+  // entry's handler. Publishing is best effort - losing a race just means the
+  // next call resolves through the full path again.
+  namespace InlineCache {
+    struct Slot {
+      std::atomic<uint32_t> Version{};
+      std::atomic<uint64_t> Key{};
+      std::atomic<IoctlHandlerFn> Handler{};
+    };
+
+    // Direct mapped
+    constexpr static size_t CACHE_SIZE = 512;
+    static Slot Cache[CACHE_SIZE];
+
+    static uint64_t MakeKey(int fd, uint32_t request) {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(fd)) << 32) | request;
+    }
+
+    static Slot &SlotFor(uint64_t Key) {
+      return Cache[(Key ^ (Key >> 32)) % CACHE_SIZE];
+    }
+
+    // Returns the cached handler for this (fd, request) or nullptr
+    static IoctlHandlerFn Find(int fd, uint32_t request) {
+      const auto Key = MakeKey(fd, request);
+      auto &Slot = SlotFor(Key);
+
+      const auto Version = Slot.Version.load(std::memory_order_acquire);
+      if (Version & 1) {
+        // Publish in progress
+        return nullptr;
+      }
+
+      const auto CachedKey = Slot.Key.load(std::memory_order_relaxed);
+      const auto Handler = Slot.Handler.load(std::memory_order_relaxed);
+
+      // The reads above only pair up if no publish interleaved
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (Slot.Version.load(std::memory_order_relaxed) != Version || CachedKey != Key) {
+        return nullptr;
+      }
+
+      return Handler;
+    }
+
+    static void Publish(int fd, uint32_t request, IoctlHandlerFn Handler) {
+      auto &Slot = SlotFor(MakeKey(fd, request));
+
+      auto Version = Slot.Version.load(std::memory_order_relaxed);
+      if ((Version & 1) ||
+          !Slot.Version.compare_exchange_strong(Version, Version + 1, std::memory_order_acquire)) {
+        // Another thread is mid-publish on this slot, let it win
+        return;
+      }
+
+      Slot.Key.store(MakeKey(fd, request), std::memory_order_relaxed);
+      Slot.Handler.store(Handler, std::memory_order_relaxed);
+      Slot.Version.store(Version + 2, std::memory_order_release);
+    }
+  }
+
   namespace DRM {
     uint32_t AddAndRunHandler(int fd, uint32_t cmd, uint32_t args);
     void AssignDeviceTypeToFD(int fd, drm_version const &Version);
@@ -691,6 +762,10 @@ namespace FEX::HLE::x32 {
         case DRM_COMMAND_BASE ... (DRM_COMMAND_END - 1): {
           // This is the space of the DRM device commands
           auto it = FDToHandler.FindHandler(fd);
+          if (it != AddAndRunHandler) {
+            // Known device, repeats of this ioctl can go straight to it
+            InlineCache::Publish(fd, cmd, it);
+          }
           return it(fd, cmd, args);
         break;
         }
@@ -711,10 +786,13 @@ namespace FEX::HLE::x32 {
 
   struct IoctlHandler {
     uint32_t Command;
-    std::function<uint32_t(int fd, uint32_t cmd, uint32_t args)> Handler;
+    IoctlHandlerFn Handler;
   };
 
-  static fextl::vector<std::function<uint32_t(int fd, uint32_t cmd, uint32_t args)>> Handlers;
+  // Flat table indexed by _IOC_TYPE. Every entry is a raw function pointer to
+  // a compile-time specialized translator, so per-call dispatch is one load
+  // and a direct call with no type-erasure thunk in between.
+  static IoctlHandlerFn Handlers[1U << _IOC_TYPEBITS];
 
   void InitializeStaticIoctlHandlers() {
     using namespace DRM;
@@ -770,7 +848,7 @@ namespace FEX::HLE::x32 {
 #undef _CUSTOM_META_OFFSET
     }};
 
-    Handlers.assign(1U << _IOC_TYPEBITS, FEX::HLE::x32::BasicHandler::BasicHandler);
+    std::fill(std::begin(Handlers), std::end(Handlers), FEX::HLE::x32::BasicHandler::BasicHandler);
 
     for (auto &Arg : LocalHandlers) {
       Handlers[Arg.Command] = Arg.Handler;
@@ -778,6 +856,10 @@ namespace FEX::HLE::x32 {
   }
 
   uint32_t ioctl32(FEXCore::Core::CpuStateFrame *Frame, int fd, uint32_t request, uint32_t args) {
+    if (const auto Cached = InlineCache::Find(fd, request)) {
+      return Cached(fd, request, args);
+    }
+
     return Handlers[_IOC_TYPE(request)](fd, request, args);
   }
 
@@ -24,11 +24,22 @@ namespace FEX::HLE::x32 {
   void *x32SyscallHandler::GuestMmap(FEXCore::Core::InternalThreadState *Thread, void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
     LOGMAN_THROW_AA_FMT((length >> 32) == 0, "values must fit to 32 bits");
 
+    // The 32-bit allocator places mappings at 4K-aligned hint addresses, which
+    // explicit hugepages reject. Strip the request down to the transparent
+    // hint; the address space is too cramped for hugetlb reservations anyway.
+    const bool WantsHugePages = (flags & MAP_HUGETLB) && fd == -1;
+    if (WantsHugePages) {
+      flags &= ~(MAP_HUGETLB | (0x3F << MAP_HUGE_SHIFT));
+    }
+
     auto Result = (uint64_t)GetAllocator()->Mmap((void*)addr, length, prot, flags, fd, offset);
 
     LOGMAN_THROW_AA_FMT((Result >> 32) == 0|| (Result >> 32) == 0xFFFFFFFF, "values must fit to 32 bits");
 
     if (!FEX::HLE::HasSyscallError(Result)) {
+      if (WantsHugePages) {
+        ::madvise(reinterpret_cast<void*>(Result), length, MADV_HUGEPAGE);
+      }
       FEX::HLE::_SyscallHandler->TrackMmap(Thread, Result, length, prot, flags, fd, offset);
       return (void *)Result;
     } else {
@@ -6,6 +6,7 @@ $end_info$
 */
 
 #include "LinuxSyscalls/Syscalls.h"
+#include "LinuxSyscalls/Utils/SyscallScratch.h"
 #include "LinuxSyscalls/x32/Syscalls.h"
 #include "LinuxSyscalls/x32/Types.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
@@ -124,15 +125,14 @@ namespace FEX::HLE::x32 {
 
   static uint64_t SendMsg(int sockfd, const struct msghdr32 *msg, int flags) {
     struct msghdr HostHeader{};
-    fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-    for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-      Host_iovec[i] = msg->msg_iov[i];
-    }
+    auto &Scratch = GetSyscallScratchArena();
+    SyscallScratchArena::Scope ScratchScope {Scratch};
+    auto *Host_iovec = Scratch.AllocateConverted<iovec>(msg->msg_iov, msg->msg_iovlen);
 
     HostHeader.msg_name = msg->msg_name;
     HostHeader.msg_namelen = msg->msg_namelen;
 
-    HostHeader.msg_iov = Host_iovec.data();
+    HostHeader.msg_iov = Host_iovec;
     HostHeader.msg_iovlen = msg->msg_iovlen;
 
     HostHeader.msg_control = alloca(msg->msg_controllen * 2);
@@ -180,15 +180,14 @@ namespace FEX::HLE::x32 {
 
   static uint64_t RecvMsg(int sockfd, struct msghdr32 *msg, int flags) {
     struct msghdr HostHeader{};
-    fextl::vector<iovec> Host_iovec(msg->msg_iovlen);
-    for (size_t i = 0; i < msg->msg_iovlen; ++i) {
-      Host_iovec[i] = msg->msg_iov[i];
-    }
+    auto &Scratch = GetSyscallScratchArena();
+    SyscallScratchArena::Scope ScratchScope {Scratch};
+    auto *Host_iovec = Scratch.AllocateConverted<iovec>(msg->msg_iov, msg->msg_iovlen);
 
     HostHeader.msg_name = msg->msg_name;
     HostHeader.msg_namelen = msg->msg_namelen;
 
-    HostHeader.msg_iov = Host_iovec.data();
+    HostHeader.msg_iov = Host_iovec;
     HostHeader.msg_iovlen = msg->msg_iovlen;
 
     HostHeader.msg_control = alloca(msg->msg_controllen*2);
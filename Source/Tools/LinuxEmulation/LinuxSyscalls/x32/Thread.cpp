@@ -190,6 +190,11 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(futex, [](FEXCore::Core::CpuStateFrame *Frame, int *uaddr, int futex_op, int val, const timespec32 *timeout, int *uaddr2, uint32_t val3) -> uint64_t {
+      uint64_t FastResult{};
+      if (FEX::HLE::TryFutexWaitFastPath(uaddr, futex_op, val, timeout, &FastResult)) {
+        return FastResult;
+      }
+
       void* timeout_ptr = (void*)timeout;
       struct timespec tp64{};
       int cmd = futex_op & FUTEX_CMD_MASK;
@@ -423,7 +428,12 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32_PASS_MANUAL(futex_time64, futex, [](FEXCore::Core::CpuStateFrame *Frame, int *uaddr, int futex_op, int val, const struct timespec *timeout, int *uaddr2, uint32_t val3) -> uint64_t {
-      uint64_t Result = syscall(SYSCALL_DEF(futex),
+      uint64_t Result{};
+      if (FEX::HLE::TryFutexWaitFastPath(uaddr, futex_op, val, timeout, &Result)) {
+        return Result;
+      }
+
+      Result = syscall(SYSCALL_DEF(futex),
         uaddr,
         futex_op,
         val,
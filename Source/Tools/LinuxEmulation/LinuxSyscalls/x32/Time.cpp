@@ -102,6 +102,10 @@ namespace FEX::HLE::x32 {
       uint64_t Result = 0;
       if (req) {
         const struct timespec req64 = *req;
+        if (FEX::HLE::TryNanosleepFastPath(CLOCK_MONOTONIC, 0, &req64, &Result)) {
+          // A completed sleep doesn't touch rem.
+          return Result;
+        }
         Result = ::nanosleep(&req64, rem64_ptr);
       } else {
         Result = ::nanosleep(nullptr, rem64_ptr);
@@ -148,8 +152,14 @@ namespace FEX::HLE::x32 {
         rem64_ptr = &rem64;
       }
 
+      uint64_t Result{};
+      if (FEX::HLE::TryNanosleepFastPath(clockid, flags, req64_ptr, &Result)) {
+        // A completed sleep doesn't touch remain.
+        return Result;
+      }
+
       // Can't use glibc helper here since it does additional validation and data munging that breaks games.
-      uint64_t Result = ::syscall(SYSCALL_DEF(clock_nanosleep), clockid, flags, req64_ptr, rem64_ptr);
+      Result = ::syscall(SYSCALL_DEF(clock_nanosleep), clockid, flags, req64_ptr, rem64_ptr);
 
       if (remain &&
           (flags & TIMER_ABSTIME) == 0) {
@@ -218,7 +228,12 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32_PASS_MANUAL(clock_nanosleep_time64, clock_nanosleep, [](FEXCore::Core::CpuStateFrame *Frame, clockid_t clockid, int flags, const struct timespec *request, struct timespec *remain) -> uint64_t {
-      uint64_t Result = ::clock_nanosleep(clockid, flags, request, remain);
+      uint64_t Result{};
+      if (FEX::HLE::TryNanosleepFastPath(clockid, flags, request, &Result)) {
+        return Result;
+      }
+
+      Result = ::clock_nanosleep(clockid, flags, request, remain);
       SYSCALL_ERRNO();
     });
 
@@ -6,6 +6,7 @@ $end_info$
 */
 
 #include "LinuxSyscalls/FileManagement.h"
+#include "LinuxSyscalls/IOUringEngine.h"
 #include "LinuxSyscalls/Syscalls.h"
 #include "LinuxSyscalls/x64/Syscalls.h"
 #include "LinuxSyscalls/x64/Types.h"
@@ -51,6 +52,13 @@ namespace FEX::HLE::x64 {
       case F_SETFL:
         Result = ::fcntl(fd, cmd, FEX::HLE::RemapFromX86Flags(arg));
         break;
+      case F_DUPFD:
+      case F_DUPFD_CLOEXEC:
+        Result = ::fcntl(fd, cmd, arg);
+        if (Result != -1) {
+          FEX::HLE::_SyscallHandler->FM.DupFDAttributes(fd, Result, cmd == F_DUPFD_CLOEXEC);
+        }
+        break;
       default:
         Result = ::fcntl(fd, cmd, arg);
         break;
@@ -172,12 +180,20 @@ namespace FEX::HLE::x64 {
     });
 
     REGISTER_SYSCALL_IMPL_X64_PASS(pread_64, [](FEXCore::Core::CpuStateFrame *Frame, int fd, void *buf, size_t count, off_t offset) -> uint64_t {
-      uint64_t Result = ::pread64(fd, buf, count, offset);
+      uint64_t Result{};
+      if (IOUringEngine::TryPRead(fd, buf, count, offset, &Result)) {
+        return Result;
+      }
+      Result = ::pread64(fd, buf, count, offset);
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X64_PASS(pwrite_64, [](FEXCore::Core::CpuStateFrame *Frame, int fd, void *buf, size_t count, off_t offset) -> uint64_t {
-      uint64_t Result = ::pwrite64(fd, buf, count, offset);
+      uint64_t Result{};
+      if (IOUringEngine::TryPWrite(fd, buf, count, offset, &Result)) {
+        return Result;
+      }
+      Result = ::pwrite64(fd, buf, count, offset);
       SYSCALL_ERRNO();
     });
 
@@ -216,11 +232,17 @@ namespace FEX::HLE::x64 {
 
     REGISTER_SYSCALL_IMPL_X64_PASS(dup, [](FEXCore::Core::CpuStateFrame *Frame, int oldfd) -> uint64_t {
       uint64_t Result = ::dup(oldfd);
+      if (Result != -1) {
+        FEX::HLE::_SyscallHandler->FM.DupFDAttributes(oldfd, Result, false);
+      }
       SYSCALL_ERRNO();
     });
 
     REGISTER_SYSCALL_IMPL_X64_PASS(dup2, [](FEXCore::Core::CpuStateFrame *Frame, int oldfd, int newfd) -> uint64_t {
       uint64_t Result = ::dup2(oldfd, newfd);
+      if (Result != -1) {
+        FEX::HLE::_SyscallHandler->FM.DupFDAttributes(oldfd, newfd, false);
+      }
       SYSCALL_ERRNO();
     });
 
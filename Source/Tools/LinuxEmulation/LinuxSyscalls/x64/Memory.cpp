@@ -33,6 +33,10 @@ namespace FEX::HLE::x64 {
         errno = -Result;
         Result = -1;
       }
+    } else if (flags & MAP_HUGETLB) {
+      // Guest hugepage requests go through the translating helper so a host
+      // with a different hugepage configuration still satisfies them.
+      Result = reinterpret_cast<uint64_t>(FEX::HLE::HugePageGuestMmap(addr, length, prot, flags, fd, offset));
     } else {
       Result = reinterpret_cast<uint64_t>(::mmap(reinterpret_cast<void*>(addr), length, prot, flags, fd, offset));
     }
@@ -59,7 +59,12 @@ namespace FEX::HLE::x64 {
 
     REGISTER_SYSCALL_IMPL_X64_PASS_FLAGS(futex, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, int *uaddr, int futex_op, int val, const struct timespec *timeout, int *uaddr2, uint32_t val3) -> uint64_t {
-      uint64_t Result = syscall(SYSCALL_DEF(futex),
+      uint64_t Result{};
+      if (FEX::HLE::TryFutexWaitFastPath(uaddr, futex_op, val, timeout, &Result)) {
+        return Result;
+      }
+
+      Result = syscall(SYSCALL_DEF(futex),
         uaddr,
         futex_op,
         val,
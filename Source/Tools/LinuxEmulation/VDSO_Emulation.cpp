@@ -5,16 +5,22 @@
 
 #include <FEXCore/Config/Config.h>
 #include <FEXCore/Core/Context.h>
+#include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/MathUtils.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/fextl/fmt.h>
 #include <FEXHeaderUtils/Syscalls.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
+#include <cstddef>
+#include <cstring>
 #include <dlfcn.h>
 #include <elf.h>
 #include <fcntl.h>
 #include <filesystem>
 #include <sys/mman.h>
+#include <sys/random.h>
+#include <sys/syscall.h>
 #include <sys/time.h>
 #include <unistd.h>
 
@@ -34,6 +40,82 @@ namespace FEX::VDSO {
     GetCPUType GetCPUPtr;
   }
 
+  namespace EntropyPool {
+    // Guest getrandom accelerator. Serves small reads from a per-thread pool
+    // of host entropy so TLS-heavy guests don't pay the syscall emulation trap
+    // for every session key. One host getrandom per page of served bytes.
+    //
+    // The pool page is wiped on fork (fill level included) so parent and child
+    // can never hand out the same bytes, and consumed bytes are zeroed as they
+    // are copied out so a later disclosure of the pool can't recover keys the
+    // guest already owns.
+    constexpr static size_t POOL_BYTES = FHU::FEX_PAGE_SIZE - sizeof(uint64_t);
+    struct PoolPage {
+      uint64_t Remaining;
+      uint8_t Bytes[POOL_BYTES];
+    };
+    static_assert(sizeof(PoolPage) == FHU::FEX_PAGE_SIZE, "Pool must cover exactly the wiped page");
+
+    // Serve reads past this size with a direct host syscall, they amortize it
+    constexpr static size_t MAX_POOLED_READ = 256;
+
+    // Matches the kernel's struct vgetrandom_opaque_params from the vDSO
+    // getrandom ABI. glibc probes with opaque_len == ~0 to learn how to
+    // allocate its per-thread states.
+    struct OpaqueParams {
+      uint32_t SizeOfOpaqueState;
+      uint32_t MmapProt;
+      uint32_t MmapFlags;
+      uint32_t Reserved[13];
+    };
+
+    struct ThreadPool {
+      PoolPage *Page{};
+      ~ThreadPool() {
+        if (Page) {
+          ::munmap(Page, FHU::FEX_PAGE_SIZE);
+        }
+      }
+    };
+
+    // Returns like the raw syscall, -1 with errno set on failure
+    static ssize_t Read(void *Buffer, size_t Length, uint32_t Flags) {
+      if ((Flags & GRND_RANDOM) || Length > MAX_POOLED_READ) {
+        // GRND_RANDOM requests a different entropy source, let the host sort it out
+        return ::syscall(SYS_getrandom, Buffer, Length, Flags);
+      }
+
+      thread_local ThreadPool Pool{};
+      if (!Pool.Page) {
+        void *Page = ::mmap(nullptr, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (Page == MAP_FAILED ||
+            ::madvise(Page, FHU::FEX_PAGE_SIZE, MADV_WIPEONFORK) == -1) {
+          // Without the wipe a forked child would replay the parent's pool,
+          // never buffer in that case.
+          if (Page != MAP_FAILED) {
+            ::munmap(Page, FHU::FEX_PAGE_SIZE);
+          }
+          return ::syscall(SYS_getrandom, Buffer, Length, Flags);
+        }
+        Pool.Page = static_cast<PoolPage*>(Page);
+      }
+
+      if (Pool.Page->Remaining < Length) {
+        const ssize_t Result = ::syscall(SYS_getrandom, Pool.Page->Bytes, POOL_BYTES, 0);
+        if (Result != static_cast<ssize_t>(POOL_BYTES)) {
+          // Failed or partial refill, don't try to track half a pool
+          return ::syscall(SYS_getrandom, Buffer, Length, Flags);
+        }
+        Pool.Page->Remaining = POOL_BYTES;
+      }
+
+      Pool.Page->Remaining -= Length;
+      memcpy(Buffer, &Pool.Page->Bytes[Pool.Page->Remaining], Length);
+      memset(&Pool.Page->Bytes[Pool.Page->Remaining], 0, Length);
+      return Length;
+    }
+  }
+
   using HandlerPtr = void(*)(void*);
   namespace x64 {
     static uint64_t SyscallRet(int Result) {
@@ -97,6 +179,34 @@ namespace FEX::VDSO {
         int Result = FHU::Syscalls::getcpu(args->cpu, args->node);
         args->rv = SyscallRet(Result);
       }
+
+      static void getrandom(void* ArgsRV) {
+        struct ArgsRV_t {
+          void *buffer;
+          size_t length;
+          uint32_t flags;
+          void *opaque_state;
+          size_t opaque_len;
+          uint64_t rv;
+        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+        if (args->opaque_len == ~0ULL) {
+          // State allocation probe from the vDSO getrandom ABI. Hand glibc a
+          // dummy state description, the entropy pool is thread local on the
+          // host side and doesn't use the guest allocated states.
+          auto Params = reinterpret_cast<EntropyPool::OpaqueParams*>(args->opaque_state);
+          *Params = {
+            .SizeOfOpaqueState = sizeof(EntropyPool::OpaqueParams),
+            .MmapProt = PROT_READ | PROT_WRITE,
+            .MmapFlags = MAP_PRIVATE | MAP_ANONYMOUS,
+          };
+          args->rv = 0;
+          return;
+        }
+
+        const ssize_t Result = EntropyPool::Read(args->buffer, args->length, args->flags);
+        args->rv = Result == -1 ? -errno : Result;
+      }
     }
 
     namespace VDSO {
@@ -156,6 +266,8 @@ namespace FEX::VDSO {
     HandlerPtr Handler_clock_gettime = FEX::VDSO::x64::glibc::clock_gettime;
     HandlerPtr Handler_clock_getres = FEX::VDSO::x64::glibc::clock_getres;
     HandlerPtr Handler_getcpu = FEX::VDSO::x64::glibc::getcpu;
+    // The entropy pool is the fast path, there is no host VDSO variant
+    HandlerPtr Handler_getrandom = FEX::VDSO::x64::glibc::getrandom;
   }
   namespace x32 {
     namespace glibc {
@@ -256,6 +368,33 @@ namespace FEX::VDSO {
         int Result = ::getcpu(args->cpu, args->node);
         args->rv = SyscallRet(Result);
       }
+
+      static void getrandom(void* ArgsRV) {
+        struct ArgsRV_t {
+          HLE::x32::compat_ptr<void> buffer;
+          uint32_t length;
+          uint32_t flags;
+          HLE::x32::compat_ptr<void> opaque_state;
+          uint32_t opaque_len;
+          int rv;
+        } *args = reinterpret_cast<ArgsRV_t*>(ArgsRV);
+
+        if (args->opaque_len == ~0U) {
+          // State allocation probe from the vDSO getrandom ABI, see the
+          // 64-bit handler.
+          auto Params = reinterpret_cast<EntropyPool::OpaqueParams*>(static_cast<void*>(args->opaque_state));
+          *Params = {
+            .SizeOfOpaqueState = sizeof(EntropyPool::OpaqueParams),
+            .MmapProt = PROT_READ | PROT_WRITE,
+            .MmapFlags = MAP_PRIVATE | MAP_ANONYMOUS,
+          };
+          args->rv = 0;
+          return;
+        }
+
+        const ssize_t Result = EntropyPool::Read(args->buffer, args->length, args->flags);
+        args->rv = Result == -1 ? -errno : Result;
+      }
     }
 
     namespace VDSO {
@@ -359,6 +498,7 @@ namespace FEX::VDSO {
     HandlerPtr Handler_clock_gettime64 = FEX::VDSO::x32::glibc::clock_gettime64;
     HandlerPtr Handler_clock_getres = FEX::VDSO::x32::glibc::clock_getres;
     HandlerPtr Handler_getcpu = FEX::VDSO::x32::glibc::getcpu;
+    HandlerPtr Handler_getrandom = FEX::VDSO::x32::glibc::getrandom;
   }
 
   void LoadHostVDSO() {
@@ -464,8 +604,236 @@ namespace FEX::VDSO {
         { 0x39, 0x83, 0x39, 0x36, 0x0f, 0x68, 0xd6, 0xfc, 0xc2, 0x3a, 0x97, 0x11, 0x85, 0x09, 0xc7, 0x25, 0xbb, 0x50, 0x49, 0x55, 0x6b, 0x0c, 0x9f, 0x50, 0x37, 0xf5, 0x9d, 0xb0, 0x38, 0x58, 0x57, 0x12 },
         nullptr,
     },
+    {
+        // sha256(libVDSO:getrandom)
+        { 0xf8, 0x03, 0xe2, 0x70, 0xe3, 0xf1, 0xbb, 0xc1, 0x7d, 0xa7, 0x8b, 0xb3, 0x1f, 0x3e, 0xbd, 0xc6, 0x8a, 0x50, 0xd3, 0x4a, 0x1f, 0xb3, 0x4b, 0x7e, 0x32, 0xcb, 0x1e, 0x18, 0x3b, 0x7c, 0xeb, 0x4b },
+        nullptr,
+    },
   };
 
+  namespace SynthesizedVDSO {
+    // When the VDSO thunk guest library isn't installed, 32-bit guests get no VDSO at all and
+    // glibc falls back to int 0x80 for every time call, walking the full syscall emulation path.
+    // The host-side thunk handlers above are registered with the core regardless of whether the
+    // guest library exists, so all that is missing is guest-visible code that invokes them.
+    //
+    // Synthesize that code: a one page ELF image exporting the usual __vdso symbols, each one a
+    // small hand-assembled stub that packs its arguments and executes the thunk instruction with
+    // the matching libVDSO hash. The JIT dispatches thunks directly to the host handlers, so
+    // guest time calls skip the syscall frontend entirely.
+    constexpr static uint32_t NumSymbols = 9;
+
+    // Stub for cdecl `int func(arg)` entry points:
+    //   sub esp, 8         ; ArgsRV_t {arg, rv}
+    //   mov eax, [esp+12]
+    //   mov [esp], eax
+    //   mov ecx, esp       ; 32-bit thunks take the argument pointer in ecx
+    //   call 1f
+    //   mov eax, [esp+4]   ; ArgsRV_t::rv
+    //   add esp, 8
+    //   ret
+    // 1: .byte 0x0f, 0x3f  ; Thunk instruction, returns like a guest ret
+    //    .byte <sha256>
+    constexpr static uint8_t OneArgStub[59] = {
+      0x83, 0xEC, 0x08,
+      0x8B, 0x44, 0x24, 0x0C,
+      0x89, 0x04, 0x24,
+      0x89, 0xE1,
+      0xE8, 0x08, 0x00, 0x00, 0x00,
+      0x8B, 0x44, 0x24, 0x04,
+      0x83, 0xC4, 0x08,
+      0xC3,
+      0x0F, 0x3F,
+      // The thunk's sha256 is copied in here.
+    };
+    constexpr static size_t OneArgStubHashOffset = 27;
+
+    // Same shape for cdecl `int func(arg, arg)` entry points with a 12-byte ArgsRV_t.
+    constexpr static uint8_t TwoArgStub[67] = {
+      0x83, 0xEC, 0x0C,
+      0x8B, 0x44, 0x24, 0x10,
+      0x89, 0x04, 0x24,
+      0x8B, 0x44, 0x24, 0x14,
+      0x89, 0x44, 0x24, 0x04,
+      0x89, 0xE1,
+      0xE8, 0x08, 0x00, 0x00, 0x00,
+      0x8B, 0x44, 0x24, 0x08,
+      0x83, 0xC4, 0x0C,
+      0xC3,
+      0x0F, 0x3F,
+    };
+    constexpr static size_t TwoArgStubHashOffset = 35;
+
+    // Same shape again for the five argument vDSO getrandom entry point with a
+    // 24-byte ArgsRV_t.
+    constexpr static uint8_t FiveArgStub[91] = {
+      0x83, 0xEC, 0x18,
+      0x8B, 0x44, 0x24, 0x1C,
+      0x89, 0x04, 0x24,
+      0x8B, 0x44, 0x24, 0x20,
+      0x89, 0x44, 0x24, 0x04,
+      0x8B, 0x44, 0x24, 0x24,
+      0x89, 0x44, 0x24, 0x08,
+      0x8B, 0x44, 0x24, 0x28,
+      0x89, 0x44, 0x24, 0x0C,
+      0x8B, 0x44, 0x24, 0x2C,
+      0x89, 0x44, 0x24, 0x10,
+      0x89, 0xE1,
+      0xE8, 0x08, 0x00, 0x00, 0x00,
+      0x8B, 0x44, 0x24, 0x14,
+      0x83, 0xC4, 0x18,
+      0xC3,
+      0x0F, 0x3F,
+    };
+    constexpr static size_t FiveArgStubHashOffset = 59;
+
+    // int 0x80; ret - matching the vsyscall fallback page the ELF loader generates.
+    constexpr static uint8_t VSyscallStub[3] = {
+      0xCD, 0x80,
+      0xC3,
+    };
+
+    // Offsets into this table are referenced by the symbol table and DT_SONAME below.
+    constexpr static char DynStrTab[] =
+      "\0"
+      "linux-gate.so.1\0"        // 1
+      "__kernel_vsyscall\0"      // 17
+      "__vdso_time\0"            // 35
+      "__vdso_gettimeofday\0"    // 47
+      "__vdso_clock_gettime\0"   // 67
+      "__vdso_clock_gettime64\0" // 88
+      "__vdso_clock_getres\0"    // 111
+      "__vdso_getcpu\0"          // 131
+      "__vdso_getrandom";        // 145
+
+    // The image is position independent with all vaddrs relative to the mapping base, just like
+    // the kernel's VDSO. No section headers are emitted; the dynamic linker only needs the
+    // program headers, DT_HASH and the dynamic symbol table. LoadGuestVDSOSymbols only walks
+    // section headers, so it leaves this image alone and the generated sigreturn helpers stay in
+    // use.
+    struct FEX_PACKED ImageLayout {
+      Elf32_Ehdr Ehdr;
+      Elf32_Phdr Phdrs[2];
+      uint32_t Hash[3 + NumSymbols];
+      Elf32_Sym DynSym[NumSymbols];
+      char DynStr[sizeof(DynStrTab)];
+      uint8_t Pad[4 - sizeof(DynStrTab) % 4];
+      Elf32_Dyn Dynamic[7];
+      uint8_t VSyscallCode[sizeof(VSyscallStub)];
+      uint8_t TimeCode[sizeof(OneArgStub)];
+      uint8_t GetTimeOfDayCode[sizeof(TwoArgStub)];
+      uint8_t ClockGetTimeCode[sizeof(TwoArgStub)];
+      uint8_t ClockGetTime64Code[sizeof(TwoArgStub)];
+      uint8_t ClockGetResCode[sizeof(TwoArgStub)];
+      uint8_t GetCPUCode[sizeof(TwoArgStub)];
+      uint8_t GetRandomCode[sizeof(FiveArgStub)];
+    };
+    static_assert(sizeof(ImageLayout) <= FHU::FEX_PAGE_SIZE, "Synthesized VDSO must fit in one page");
+    static_assert(offsetof(ImageLayout, Dynamic) % 4 == 0, "Dynamic section must stay aligned");
+  }
+
+  static void* SynthesizeGuestVDSO(FEX::HLE::SyscallHandler *const Handler) {
+    using namespace SynthesizedVDSO;
+
+    ImageLayout Image{};
+
+    memcpy(Image.Ehdr.e_ident, ELFMAG, SELFMAG);
+    Image.Ehdr.e_ident[EI_CLASS] = ELFCLASS32;
+    Image.Ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+    Image.Ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    Image.Ehdr.e_type = ET_DYN;
+    Image.Ehdr.e_machine = EM_386;
+    Image.Ehdr.e_version = EV_CURRENT;
+    // e_entry feeds AT_SYSINFO through GetVSyscallEntry.
+    Image.Ehdr.e_entry = offsetof(ImageLayout, VSyscallCode);
+    Image.Ehdr.e_phoff = offsetof(ImageLayout, Phdrs);
+    Image.Ehdr.e_ehsize = sizeof(Elf32_Ehdr);
+    Image.Ehdr.e_phentsize = sizeof(Elf32_Phdr);
+    Image.Ehdr.e_phnum = 2;
+    Image.Ehdr.e_shentsize = sizeof(Elf32_Shdr);
+
+    Image.Phdrs[0] = {
+      .p_type = PT_LOAD,
+      .p_offset = 0,
+      .p_vaddr = 0,
+      .p_paddr = 0,
+      .p_filesz = sizeof(ImageLayout),
+      .p_memsz = sizeof(ImageLayout),
+      .p_flags = PF_R | PF_X,
+      .p_align = FHU::FEX_PAGE_SIZE,
+    };
+    Image.Phdrs[1] = {
+      .p_type = PT_DYNAMIC,
+      .p_offset = offsetof(ImageLayout, Dynamic),
+      .p_vaddr = offsetof(ImageLayout, Dynamic),
+      .p_paddr = offsetof(ImageLayout, Dynamic),
+      .p_filesz = sizeof(Image.Dynamic),
+      .p_memsz = sizeof(Image.Dynamic),
+      .p_flags = PF_R,
+      .p_align = 4,
+    };
+
+    // Single bucket SysV hash table, lookups walk the full chain. With eight exported symbols
+    // that's cheaper than getting the bucket distribution right and only runs at symbol bind.
+    Image.Hash[0] = 1;          // nbucket
+    Image.Hash[1] = NumSymbols; // nchain
+    Image.Hash[2] = 1;          // bucket 0 -> first real symbol
+    for (uint32_t i = 1; i < NumSymbols - 1; ++i) {
+      // chain[0] and chain[NumSymbols - 1] terminate with STN_UNDEF from zero-init.
+      Image.Hash[3 + i] = i + 1;
+    }
+
+    auto Symbol = [&Image](uint32_t Index, uint32_t NameOffset, uint32_t Value, uint32_t Size) {
+      Image.DynSym[Index] = {
+        .st_name = NameOffset,
+        .st_value = Value,
+        .st_size = Size,
+        .st_info = ELF32_ST_INFO(STB_GLOBAL, STT_FUNC),
+        .st_other = STV_DEFAULT,
+        // There are no section headers to cross-reference, any defined index works.
+        .st_shndx = 1,
+      };
+    };
+    Symbol(1, 17, offsetof(ImageLayout, VSyscallCode), sizeof(Image.VSyscallCode));
+    Symbol(2, 35, offsetof(ImageLayout, TimeCode), sizeof(Image.TimeCode));
+    Symbol(3, 47, offsetof(ImageLayout, GetTimeOfDayCode), sizeof(Image.GetTimeOfDayCode));
+    Symbol(4, 67, offsetof(ImageLayout, ClockGetTimeCode), sizeof(Image.ClockGetTimeCode));
+    Symbol(5, 88, offsetof(ImageLayout, ClockGetTime64Code), sizeof(Image.ClockGetTime64Code));
+    Symbol(6, 111, offsetof(ImageLayout, ClockGetResCode), sizeof(Image.ClockGetResCode));
+    Symbol(7, 131, offsetof(ImageLayout, GetCPUCode), sizeof(Image.GetCPUCode));
+    Symbol(8, 145, offsetof(ImageLayout, GetRandomCode), sizeof(Image.GetRandomCode));
+
+    memcpy(Image.DynStr, DynStrTab, sizeof(DynStrTab));
+
+    Image.Dynamic[0] = { .d_tag = DT_SONAME, .d_un = { .d_val = 1 } };
+    Image.Dynamic[1] = { .d_tag = DT_HASH, .d_un = { .d_ptr = offsetof(ImageLayout, Hash) } };
+    Image.Dynamic[2] = { .d_tag = DT_STRTAB, .d_un = { .d_ptr = offsetof(ImageLayout, DynStr) } };
+    Image.Dynamic[3] = { .d_tag = DT_SYMTAB, .d_un = { .d_ptr = offsetof(ImageLayout, DynSym) } };
+    Image.Dynamic[4] = { .d_tag = DT_STRSZ, .d_un = { .d_val = sizeof(Image.DynStr) } };
+    Image.Dynamic[5] = { .d_tag = DT_SYMENT, .d_un = { .d_val = sizeof(Elf32_Sym) } };
+    // Dynamic[6] is the DT_NULL terminator from zero-init.
+
+    memcpy(Image.VSyscallCode, VSyscallStub, sizeof(VSyscallStub));
+
+    auto Stub = [](uint8_t *Dest, const uint8_t *Template, size_t TemplateSize, size_t HashOffset, const FEXCore::IR::ThunkDefinition &Definition) {
+      memcpy(Dest, Template, TemplateSize);
+      memcpy(Dest + HashOffset, Definition.Sum.data, sizeof(Definition.Sum.data));
+    };
+    Stub(Image.TimeCode, OneArgStub, sizeof(OneArgStub), OneArgStubHashOffset, VDSODefinitions[0]);
+    Stub(Image.GetTimeOfDayCode, TwoArgStub, sizeof(TwoArgStub), TwoArgStubHashOffset, VDSODefinitions[1]);
+    Stub(Image.ClockGetTimeCode, TwoArgStub, sizeof(TwoArgStub), TwoArgStubHashOffset, VDSODefinitions[2]);
+    Stub(Image.ClockGetTime64Code, TwoArgStub, sizeof(TwoArgStub), TwoArgStubHashOffset, VDSODefinitions[3]);
+    Stub(Image.ClockGetResCode, TwoArgStub, sizeof(TwoArgStub), TwoArgStubHashOffset, VDSODefinitions[4]);
+    Stub(Image.GetCPUCode, TwoArgStub, sizeof(TwoArgStub), TwoArgStubHashOffset, VDSODefinitions[5]);
+    Stub(Image.GetRandomCode, FiveArgStub, sizeof(FiveArgStub), FiveArgStubHashOffset, VDSODefinitions[6]);
+
+    void* GuestVDSO = Handler->GuestMmap(nullptr, nullptr, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    memcpy(GuestVDSO, &Image, sizeof(Image));
+    mprotect(GuestVDSO, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_EXEC);
+
+    return GuestVDSO;
+  }
+
   void LoadGuestVDSOSymbols(bool Is64Bit, char *VDSOBase) {
     // We need to load symbols we care about.
     if (Is64Bit) {
@@ -538,6 +906,7 @@ namespace FEX::VDSO {
       VDSODefinitions[3].ThunkFunction = FEX::VDSO::x64::Handler_clock_gettime;
       VDSODefinitions[4].ThunkFunction = FEX::VDSO::x64::Handler_clock_getres;
       VDSODefinitions[5].ThunkFunction = FEX::VDSO::x64::Handler_getcpu;
+      VDSODefinitions[6].ThunkFunction = FEX::VDSO::x64::Handler_getrandom;
     }
     else {
       ThunkGuestPath = fextl::fmt::format("{}/libVDSO-guest.so", ThunkGuestLibs32());
@@ -549,6 +918,7 @@ namespace FEX::VDSO {
       VDSODefinitions[3].ThunkFunction = FEX::VDSO::x32::Handler_clock_gettime64;
       VDSODefinitions[4].ThunkFunction = FEX::VDSO::x32::Handler_clock_getres;
       VDSODefinitions[5].ThunkFunction = FEX::VDSO::x32::Handler_getcpu;
+      VDSODefinitions[6].ThunkFunction = FEX::VDSO::x32::Handler_getrandom;
     }
 
     // Load VDSO if we can
@@ -574,6 +944,14 @@ namespace FEX::VDSO {
       LoadGuestVDSOSymbols(Is64Bit, reinterpret_cast<char*>(VDSOBase));
     }
 
+    if (!VDSOBase && !Is64Bit) {
+      // No VDSO thunk library is installed. Without a VDSO, 32-bit guests fall back to int 0x80
+      // for every time call, so synthesize a minimal one from the thunk handlers set up above.
+      // 64-bit guests lose less here since their libc falls back to the plain syscall instruction.
+      LoadHostVDSO();
+      VDSOBase = SynthesizeGuestVDSO(Handler);
+    }
+
     return VDSOBase;
   }
 
@@ -30,6 +30,7 @@ $end_info$
 #include "BTInterface.h"
 #include "IntervalList.h"
 
+#include <array>
 #include <cstdint>
 #include <type_traits>
 #include <atomic>
@@ -118,6 +119,48 @@ namespace {
   }
 }
 
+namespace ExceptionDispatchCache {
+  // Recoverable guest exceptions (guard-page touches, .NET-style probes)
+  // re-fault at a handful of host instructions, and mapping each host PC back
+  // to its guest RIP walks the faulting block's RIP reconstruction entries
+  // every time. Keep a small per-thread direct-mapped cache of that mapping;
+  // code buffers are per-thread so entries can never alias across threads.
+  // Guest code invalidation bumps the global generation, which drops every
+  // thread's cache on its next lookup since the invalidated host code range
+  // may be reused for different guest code.
+  struct Entry {
+    uint64_t HostPC;
+    uint64_t GuestRIP;
+  };
+
+  static constexpr size_t CACHE_ENTRIES = 64; // Must be a power of two
+  static std::atomic<uint64_t> Generation{1};
+
+  static thread_local std::array<Entry, CACHE_ENTRIES> Cache{};
+  static thread_local uint64_t CacheGeneration{};
+
+  void Invalidate() {
+    Generation.fetch_add(1, std::memory_order::release);
+  }
+
+  uint64_t LookupGuestRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t HostPC) {
+    const uint64_t CurrentGeneration = Generation.load(std::memory_order::acquire);
+    if (CacheGeneration != CurrentGeneration) {
+      Cache.fill({});
+      CacheGeneration = CurrentGeneration;
+    }
+
+    auto &Slot = Cache[(HostPC >> 2) & (CACHE_ENTRIES - 1)];
+    if (Slot.HostPC == HostPC) {
+      return Slot.GuestRIP;
+    }
+
+    const uint64_t GuestRIP = CTX->RestoreRIPFromHostPC(Thread, HostPC);
+    Slot = {HostPC, GuestRIP};
+    return GuestRIP;
+  }
+}
+
 namespace Context {
   void LoadStateFromWowContext(FEXCore::Core::InternalThreadState *Thread, uint64_t WowTEB, WOW64_CONTEXT *Context) {
     auto &State = Thread->CurrentFrame->State;
@@ -235,7 +278,7 @@ namespace Context {
     auto *Thread = GetTLS().ThreadState();
     auto &State = Thread->CurrentFrame->State;
 
-    State.rip = CTX->RestoreRIPFromHostPC(Thread, Context->Pc);
+    State.rip = ExceptionDispatchCache::LookupGuestRIP(Thread, Context->Pc);
 
     // Spill all SRA GPRs
     for (size_t i = 0; i < Config.SRAGPRCount; i++) {
@@ -335,6 +378,7 @@ namespace Invalidation {
 
     if (Prot & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE)) {
       CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), AlignedBase, AlignedSize);
+      ExceptionDispatchCache::Invalidate();
     }
 
     if (Prot & PAGE_EXECUTE_READWRITE) {
@@ -356,6 +400,7 @@ namespace Invalidation {
     const auto SectionSize = reinterpret_cast<uint64_t>(Info.BaseAddress) + Info.RegionSize
                              - reinterpret_cast<uint64_t>(Info.AllocationBase);
     CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), SectionBase, SectionSize);
+    ExceptionDispatchCache::Invalidate();
 
     if (Free) {
       std::scoped_lock Lock(RWXIntervalsLock);
@@ -367,6 +412,7 @@ namespace Invalidation {
     const auto AlignedBase = Address & FHU::FEX_PAGE_MASK;
     const auto AlignedSize = (Address - AlignedBase + Size + FHU::FEX_PAGE_SIZE - 1) & FHU::FEX_PAGE_MASK;
     CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), AlignedBase, AlignedSize);
+    ExceptionDispatchCache::Invalidate();
 
     if (Free) {
       std::scoped_lock Lock(RWXIntervalsLock);
@@ -412,6 +458,7 @@ namespace Invalidation {
     if (NeedsInvalidate) {
       // RWXIntervalsLock cannot be held during invalidation
       CTX->InvalidateGuestCodeRange(GetTLS().ThreadState(), FaultAddress & FHU::FEX_PAGE_MASK, FHU::FEX_PAGE_SIZE);
+      ExceptionDispatchCache::Invalidate();
       return true;
     }
     return false;
@@ -762,7 +809,14 @@ NTSTATUS BTCpuResetToConsistentState(EXCEPTION_POINTERS *Ptrs) {
   WOW64_CONTEXT WowContext = Context::ReconstructWowContext(Context);
   LogMan::Msg::DFmt("pc: {:X} eip: {:X}", Context->Pc, WowContext.Eip);
 
-  BTCpuSetContext(GetCurrentThread(), GetCurrentProcess(), nullptr, &WowContext);
+  // The WOW context was just built from the JIT state, so the two already
+  // agree; publish it straight to the CPU area rather than going through
+  // BTCpuSetContext, whose flush/merge/reload round trip costs three extra
+  // context copies on every dispatched guest exception.
+  if (RtlWow64SetThreadContext(GetCurrentThread(), &WowContext)) {
+    // Fall back to the full merge path
+    BTCpuSetContext(GetCurrentThread(), GetCurrentProcess(), nullptr, &WowContext);
+  }
   Context::UnlockJITContext();
 
   // Replace the host context with one captured before JIT entry so host code can unwind
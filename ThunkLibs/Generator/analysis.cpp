@@ -68,6 +68,8 @@ struct Annotations {
     bool custom_host_impl = false;
     bool custom_guest_entrypoint = false;
 
+    bool batchable = false;
+
     bool returns_guest_pointer = false;
 
     std::optional<clang::QualType> uniform_va_type;
@@ -89,6 +91,8 @@ static Annotations GetAnnotations(clang::ASTContext& context, clang::CXXRecordDe
             ret.callback_strategy = CallbackStrategy::Stub;
         } else if (annotation == "fexgen::custom_guest_entrypoint") {
             ret.custom_guest_entrypoint = true;
+        } else if (annotation == "fexgen::batchable") {
+            ret.batchable = true;
         } else {
             throw report_error(base.getSourceRange().getBegin(), "Unknown annotation");
         }
@@ -335,6 +339,37 @@ void AnalysisAction::ParseInterface(clang::ASTContext& context) {
 
                     data.custom_host_impl = annotations.custom_host_impl;
 
+                    data.batchable = annotations.batchable;
+                    if (data.batchable) {
+                        // Deferred replay can't produce return values, and
+                        // pointer arguments could be invalidated before the
+                        // log is drained.
+                        if (!return_type->isVoidType()) {
+                            throw report_error(template_arg_loc, "batchable functions must return void");
+                        }
+                        if (emitted_function->isVariadic()) {
+                            throw report_error(template_arg_loc, "batchable functions may not be variadic");
+                        }
+                        for (std::size_t param_idx = 0; param_idx < emitted_function->param_size(); ++param_idx) {
+                            auto param_type = emitted_function->getParamDecl(param_idx)->getType();
+                            if (param_type->isBuiltinType() || param_type->isEnumeralType()) {
+                                continue;
+                            }
+                            // Pointers to opaque handles are logged by value like
+                            // scalars. Any call that could free or reuse the handle
+                            // is itself a thunk transition that drains the log
+                            // first, so the handle stays valid until replay.
+                            if (param_type->isPointerType()) {
+                                auto pointee_type = param_type->getPointeeType();
+                                if (types.contains(context.getCanonicalType(pointee_type.getTypePtr())) &&
+                                    LookupType(context, pointee_type.getTypePtr()).pointers_only) {
+                                    continue;
+                                }
+                            }
+                            throw report_error(emitted_function->getParamDecl(param_idx)->getBeginLoc(), "batchable functions may only take scalar or opaque-handle parameters");
+                        }
+                    }
+
                     data.param_annotations = param_annotations[emitted_function];
 
                     const int retval_index = -1;
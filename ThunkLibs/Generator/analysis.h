@@ -49,6 +49,13 @@ struct ThunkedFunction : FunctionParams {
     // This is implied e.g. for thunks generated for variadic functions
     bool custom_host_impl = false;
 
+    // If true, guest-side calls are appended to a thread-local log and
+    // replayed host-side in order on the next regular thunk transition
+    // instead of transitioning immediately.
+    // Only valid for void-returning functions whose parameters are scalars
+    // or pointers to opaque handle types.
+    bool batchable = false;
+
     std::string GetOriginalFunctionName() const {
         const std::string suffix = "_internal";
         assert(function_name.length() > suffix.size());
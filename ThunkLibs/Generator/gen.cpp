@@ -4,6 +4,7 @@
 #include "interface.h"
 #include <clang/Frontend/CompilerInstance.h>
 
+#include <algorithm>
 #include <fstream>
 #include <numeric>
 #include <iostream>
@@ -197,6 +198,27 @@ void GenerateThunkLibsAction::EmitLayoutWrappers(
         fmt::print(file, "  guest_layout& operator=(const guest_layout<{}>& other) {{ memcpy(this, &other, sizeof(other)); return *this; }}\n", struct_name);
         fmt::print(file, "}};\n");
 
+        // Fully compatible types are passed through without repacking, so the
+        // compatibility verdict reached at generation time must still hold
+        // when the host library is compiled. Pin down size and member offsets
+        // so that any drift in the host headers fails loudly instead of
+        // corrupting data silently.
+        if (auto guest_info_it = guest_abi.find(struct_name);
+            type_compat.at(type) == TypeCompatibility::Full && guest_info_it != guest_abi.end()) {
+            if (auto* guest_struct = guest_info_it->second.get_if_struct()) {
+                fmt::print(file, "static_assert(sizeof({}) == {}, \"Host struct size differs from the guest layout this thunk was generated against\");\n",
+                           struct_name, guest_struct->size_bits / 8);
+                for (auto& member : guest_struct->members) {
+                    // Bitfields and anonymous members can't be checked via offsetof
+                    if (member.member_name.empty() || member.offset_bits % 8) {
+                        continue;
+                    }
+                    fmt::print(file, "static_assert(__builtin_offsetof({}, {}) == {}, \"Host member offset differs from the guest layout this thunk was generated against\");\n",
+                               struct_name, member.member_name, member.offset_bits / 8);
+                }
+            }
+        }
+
         // Host layout definition
         fmt::print(file, "template<>\n");
         fmt::print(file, "struct host_layout<{}> {{\n", struct_name);
@@ -359,6 +381,12 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
         return fmt::format("{}CBFN{}", function_name, param_index);
     };
 
+    // Batchable calls are logged guest-side and replayed host-side through an
+    // internal fex_flush_batch thunk, which only needs to exist if any
+    // function in this library is annotated as batchable
+    const bool has_batchable = std::any_of(thunks.begin(), thunks.end(),
+                                           [](const ThunkedFunction& thunk) { return thunk.batchable; });
+
     // Files used guest-side
     if (!output_filenames.guest.empty()) {
         std::ofstream file(output_filenames.guest);
@@ -371,8 +399,33 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
             fmt::print( file, "MAKE_THUNK({}, {}, \"{:#02x}\")\n",
                         libname, function_name, fmt::join(sha256, ", "));
         }
+        if (has_batchable) {
+            auto sha256 = get_sha256("fex_flush_batch", true);
+            fmt::print( file, "MAKE_THUNK({}, fex_flush_batch, \"{:#02x}\")\n",
+                        libname, fmt::join(sha256, ", "));
+        }
         file << "}\n";
 
+        // Call log for batchable functions. The host replays pending entries
+        // in submission order before servicing any regular thunk, so a
+        // thread-local buffer is all that's needed to keep per-thread call
+        // order (and hence API error observation) unchanged.
+        if (has_batchable) {
+            file << "static thread_local struct {\n";
+            file << "  uint32_t offset;\n";
+            file << "  alignas(8) unsigned char data[16384];\n";
+            file << "} fex_batch;\n";
+            fmt::print(file, "static void fex_flush_batch() {{\n");
+            file << "  if (fex_batch.offset == 0) {\n";
+            file << "    return;\n";
+            file << "  }\n";
+            file << "  struct { uint64_t addr; uint64_t size; } args = { (uintptr_t)fex_batch.data, fex_batch.offset };\n";
+            fmt::print(file, "  fexthunks_{}_fex_flush_batch(&args);\n", libname);
+            file << "  fex_batch.offset = 0;\n";
+            file << "}\n";
+            file << "[[maybe_unused]] static bool fex_batch_flush_hook_registered = (fex_batch_flush_hook = fex_flush_batch, true);\n";
+        }
+
         // Guest->Host transition points for invoking runtime host-function pointers based on their signature
         std::vector<std::vector<unsigned char>> sha256s;
         for (auto type_it = thunked_funcptrs.begin(); type_it != thunked_funcptrs.end(); ++type_it) {
@@ -396,6 +449,7 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
         }
 
         // Thunks-internal packing functions
+        std::size_t batch_index = 0;
         file << "extern \"C\" {\n";
         for (auto& data : thunks) {
             const auto& function_name = data.function_name;
@@ -431,7 +485,26 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
                     fmt::print(file, "AllocateHostTrampolineForGuestFunction(a_{});\n", idx);
                 }
             }
-            file << "  fexthunks_" << libname << "_" << function_name << "(&args);\n";
+            if (data.batchable) {
+                // Append to the call log instead of transitioning. Entries are
+                // {function index, payload size, packed args}, 8-byte aligned so
+                // the host can replay them with the regular unpacking functions.
+                file << "  constexpr uint32_t entry_size = (sizeof(args) + 7) & ~7u;\n";
+                file << "  if (fex_batch.offset + 8 + entry_size > sizeof(fex_batch.data)) {\n";
+                file << "    fex_flush_batch();\n";
+                file << "  }\n";
+                fmt::print(file, "  const uint32_t batch_fn = {};\n", batch_index++);
+                file << "  __builtin_memcpy(fex_batch.data + fex_batch.offset, &batch_fn, 4);\n";
+                file << "  __builtin_memcpy(fex_batch.data + fex_batch.offset + 4, &entry_size, 4);\n";
+                file << "  __builtin_memcpy(fex_batch.data + fex_batch.offset + 8, &args, sizeof(args));\n";
+                file << "  fex_batch.offset += 8 + entry_size;\n";
+            } else {
+                if (has_batchable) {
+                    // Drain pending batched calls first to preserve call order
+                    file << "  fex_flush_batch();\n";
+                }
+                file << "  fexthunks_" << libname << "_" << function_name << "(&args);\n";
+            }
             if (!is_void) {
                 file << "  return args.rv;\n";
             }
@@ -638,6 +711,32 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
 
             file << "}\n";
         }
+
+        // Replay entry point for the guest-side call log of batchable
+        // functions. Entries reuse the regular unpacking functions, indexed by
+        // their position among batchable thunks (mirrored guest-side).
+        if (has_batchable) {
+            fmt::print(file, "static void (*const fexfn_batch_targets_{}[])(void*) = {{\n", libname);
+            for (auto& thunk : thunks) {
+                if (thunk.batchable) {
+                    fmt::print(file, "  (void(*)(void*))&fexfn_unpack_{}_{},\n", libname, thunk.function_name);
+                }
+            }
+            file << "};\n";
+
+            fmt::print(file, "static void fexfn_unpack_{}_fex_flush_batch(void* argsv) {{\n", libname);
+            file << "  struct args_t { uint64_t addr; uint64_t size; };\n";
+            file << "  auto args = reinterpret_cast<args_t*>(argsv);\n";
+            file << "  auto data = reinterpret_cast<unsigned char*>(args->addr);\n";
+            file << "  for (uint64_t offset = 0; offset < args->size;) {\n";
+            file << "    uint32_t batch_fn, entry_size;\n";
+            file << "    memcpy(&batch_fn, data + offset, 4);\n";
+            file << "    memcpy(&entry_size, data + offset + 4, 4);\n";
+            fmt::print(file, "    fexfn_batch_targets_{}[batch_fn](data + offset + 8);\n", libname);
+            file << "    offset += 8 + entry_size;\n";
+            file << "  }\n";
+            file << "}\n";
+        }
         file << "}\n";
 
         // Endpoints for Guest->Host invocation of API functions
@@ -648,6 +747,11 @@ void GenerateThunkLibsAction::OnAnalysisComplete(clang::ASTContext& context) {
             fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_{}}}, // {}:{}\n",
                         fmt::join(sha256, "\\x"), libname, function_name, libname, function_name);
         }
+        if (has_batchable) {
+            auto sha256 = get_sha256("fex_flush_batch", true);
+            fmt::print( file, "  {{(uint8_t*)\"\\x{:02x}\", (void(*)(void *))&fexfn_unpack_{}_fex_flush_batch}}, // {}:fex_flush_batch\n",
+                        fmt::join(sha256, "\\x"), libname, libname, libname);
+        }
 
         // Endpoints for Guest->Host invocation of runtime host-function pointers
         for (auto& host_funcptr_entry : thunked_funcptrs) {
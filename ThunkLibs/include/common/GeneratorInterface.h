@@ -6,6 +6,15 @@ struct custom_guest_entrypoint {};
 struct generate_guest_symtable {};
 struct indirect_guest_calls {};
 
+// Function annotation for void-returning functions taking only scalar or
+// opaque-handle arguments. Instead of transitioning to the host immediately, calls are
+// logged to a thread-local buffer and replayed host-side in order when the
+// next regular thunk transition happens (or when the buffer fills up).
+// Since every other thunked call drains the log first, per-thread call order
+// (including error observation through e.g. glGetError) is unchanged; only
+// the number of guest<->host transitions shrinks.
+struct batchable {};
+
 struct callback_annotation_base {
     // Prevent annotating multiple callback strategies
     bool prevent_multiple;
@@ -93,6 +93,11 @@ inline bool IsLibLoaded(const char *libname) {
   return argsrv.rv;
 }
 
+// Set by generated library code when any function of the library is annotated
+// as batchable. Drains the thread-local call log so that transitions which
+// bypass the generated packing functions still observe batched calls in order.
+inline void (*fex_batch_flush_hook)() = nullptr;
+
 // Helper template that packs the given arguments and invokes a thunk at the
 // address stored in the `r11` guest register. The signature of the thunk must
 // be specified at compile-time via the Thunk template parameter.
@@ -139,6 +144,12 @@ inline Result CallHostFunction(Args... args) {
     // Return value not explicitly initialized since an initializer would fail to compile for the void case
   };
 
+  // This path bypasses the generated packing functions, so batched calls must
+  // be drained here to keep their order relative to this call
+  if (fex_batch_flush_hook) {
+    fex_batch_flush_hook();
+  }
+
   Thunk(reinterpret_cast<void*>(&packed_args));
 
   if constexpr (!std::is_void_v<Result>) {
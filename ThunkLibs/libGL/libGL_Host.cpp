@@ -28,4 +28,164 @@ void* symbolFromGlXGetProcAddr(void*, const char* name) {
     return (void*)glXGetProcAddress((const GLubyte*)name);
 }
 
+namespace {
+
+// Client-memory texture uploads stall in the driver: glTexImage2D has to copy
+// the pixels synchronously before returning since the caller may reuse the
+// memory immediately. Staging large uploads through a pixel-unpack buffer
+// instead hands the data to driver-owned (typically DMA-able) storage in one
+// copy and lets the actual texture transfer run asynchronously; deleting the
+// buffer right away just defers its destruction until the transfer completes,
+// so no explicit fencing is needed.
+
+// Below this, the upload finishes faster than the staging round trip costs.
+constexpr GLsizeiptr MIN_STAGED_UPLOAD_SIZE = 64 * 1024;
+
+// Bytes per pixel for the client formats games stream with, or -1 for
+// anything exotic enough that the direct path should handle it.
+GLsizeiptr PixelSizeBytes(GLenum format, GLenum type) {
+    // Packed types encode the whole pixel regardless of component count.
+    switch (type) {
+    case GL_UNSIGNED_BYTE_3_3_2:
+    case GL_UNSIGNED_BYTE_2_3_3_REV:
+        return 1;
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_5_6_5_REV:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+    case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+        return 2;
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_10_10_10_2:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+        return 4;
+    default:
+        break;
+    }
+
+    GLsizeiptr Components{};
+    switch (format) {
+    case GL_RED:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:
+        Components = 1;
+        break;
+    case GL_RG:
+    case GL_LUMINANCE_ALPHA:
+        Components = 2;
+        break;
+    case GL_RGB:
+    case GL_BGR:
+        Components = 3;
+        break;
+    case GL_RGBA:
+    case GL_BGRA:
+        Components = 4;
+        break;
+    default:
+        return -1;
+    }
+
+    switch (type) {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+        return Components;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+        return Components * 2;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+        return Components * 4;
+    default:
+        return -1;
+    }
+}
+
+// Binds a freshly filled pixel-unpack buffer and returns its name, or 0 when
+// the upload should take the direct path. The caller issues the texture call
+// with a null offset and hands the name to FinishStagedUpload.
+GLuint StageUpload(GLsizei Width, GLsizei Height, GLenum Format, GLenum Type, const void *Pixels) {
+    if (!Pixels || Width <= 0 || Height <= 0) {
+        return 0;
+    }
+
+    if (!fexldr_ptr_libGL_glGetIntegerv || !fexldr_ptr_libGL_glGenBuffers ||
+        !fexldr_ptr_libGL_glBindBuffer || !fexldr_ptr_libGL_glBufferData ||
+        !fexldr_ptr_libGL_glDeleteBuffers) {
+        return 0;
+    }
+
+    const GLsizeiptr PixelSize = PixelSizeBytes(Format, Type);
+    if (PixelSize <= 0) {
+        return 0;
+    }
+
+    // A bound unpack buffer means the application manages its own staging and
+    // Pixels is an offset, not a pointer. Non-default unpack row state would
+    // need replicating in the staging copy; punt those to the direct path.
+    GLint UnpackBuffer{}, RowLength{}, SkipRows{}, SkipPixels{}, Alignment{1};
+    fexldr_ptr_libGL_glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &UnpackBuffer);
+    fexldr_ptr_libGL_glGetIntegerv(GL_UNPACK_ROW_LENGTH, &RowLength);
+    fexldr_ptr_libGL_glGetIntegerv(GL_UNPACK_SKIP_ROWS, &SkipRows);
+    fexldr_ptr_libGL_glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &SkipPixels);
+    fexldr_ptr_libGL_glGetIntegerv(GL_UNPACK_ALIGNMENT, &Alignment);
+    if (UnpackBuffer != 0 || RowLength != 0 || SkipRows != 0 || SkipPixels != 0 || Alignment <= 0) {
+        return 0;
+    }
+
+    // Interior rows are padded to the unpack alignment; the final row is not,
+    // and must not be - the client array may end exactly at its last byte.
+    const GLsizeiptr RowBytes = PixelSize * Width;
+    const GLsizeiptr AlignedRowBytes = (RowBytes + Alignment - 1) & -GLsizeiptr{Alignment};
+    const GLsizeiptr Size = AlignedRowBytes * (Height - 1) + RowBytes;
+    if (Size < MIN_STAGED_UPLOAD_SIZE) {
+        return 0;
+    }
+
+    // A fresh buffer per upload sidesteps buffer-name lifetime questions
+    // across context switches; GL_STREAM_DRAW storage is where drivers place
+    // their transfer staging anyway.
+    GLuint PBO{};
+    fexldr_ptr_libGL_glGenBuffers(1, &PBO);
+    if (PBO == 0) {
+        return 0;
+    }
+    fexldr_ptr_libGL_glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PBO);
+    fexldr_ptr_libGL_glBufferData(GL_PIXEL_UNPACK_BUFFER, Size, Pixels, GL_STREAM_DRAW);
+    return PBO;
+}
+
+void FinishStagedUpload(GLuint PBO) {
+    fexldr_ptr_libGL_glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    // The driver keeps the storage alive until the queued transfer consumed it.
+    fexldr_ptr_libGL_glDeleteBuffers(1, &PBO);
+}
+
+} // anonymous namespace
+
+static void fexfn_impl_libGL_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                          GLint border, GLenum format, GLenum type, const void *pixels) {
+    if (GLuint PBO = StageUpload(width, height, format, type, pixels)) {
+        fexldr_ptr_libGL_glTexImage2D(target, level, internalformat, width, height, border, format, type, nullptr);
+        FinishStagedUpload(PBO);
+        return;
+    }
+    fexldr_ptr_libGL_glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+static void fexfn_impl_libGL_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                                             GLsizei height, GLenum format, GLenum type, const void *pixels) {
+    if (GLuint PBO = StageUpload(width, height, format, type, pixels)) {
+        fexldr_ptr_libGL_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, nullptr);
+        FinishStagedUpload(PBO);
+        return;
+    }
+    fexldr_ptr_libGL_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
 EXPORTS(libGL)
@@ -361,7 +361,7 @@ template<> struct fex_gen_config<glActiveProgramEXT> {};
 template<> struct fex_gen_config<glActiveShaderProgram> {};
 template<> struct fex_gen_config<glActiveStencilFaceEXT> {};
 template<> struct fex_gen_config<glActiveTextureARB> {};
-template<> struct fex_gen_config<glActiveTexture> {};
+template<> struct fex_gen_config<glActiveTexture> : fexgen::batchable {};
 template<> struct fex_gen_config<glActiveVaryingNV> {};
 template<> struct fex_gen_config<glAlphaFragmentOp1ATI> {};
 template<> struct fex_gen_config<glAlphaFragmentOp2ATI> {};
@@ -399,7 +399,7 @@ template<> struct fex_gen_config<glBindBufferARB> {};
 template<> struct fex_gen_config<glBindBufferBaseEXT> {};
 template<> struct fex_gen_config<glBindBufferBase> {};
 template<> struct fex_gen_config<glBindBufferBaseNV> {};
-template<> struct fex_gen_config<glBindBuffer> {};
+template<> struct fex_gen_config<glBindBuffer> : fexgen::batchable {};
 template<> struct fex_gen_config<glBindBufferOffsetEXT> {};
 template<> struct fex_gen_config<glBindBufferOffsetNV> {};
 template<> struct fex_gen_config<glBindBufferRangeEXT> {};
@@ -426,13 +426,13 @@ template<> struct fex_gen_config<glBindSampler> {};
 template<> struct fex_gen_config<glBindSamplers> {};
 template<> struct fex_gen_config<glBindShadingRateImageNV> {};
 template<> struct fex_gen_config<glBindTextureEXT> {};
-template<> struct fex_gen_config<glBindTexture> {};
+template<> struct fex_gen_config<glBindTexture> : fexgen::batchable {};
 template<> struct fex_gen_config<glBindTextures> {};
 template<> struct fex_gen_config<glBindTextureUnit> {};
 template<> struct fex_gen_config<glBindTransformFeedback> {};
 template<> struct fex_gen_config<glBindTransformFeedbackNV> {};
 template<> struct fex_gen_config<glBindVertexArrayAPPLE> {};
-template<> struct fex_gen_config<glBindVertexArray> {};
+template<> struct fex_gen_config<glBindVertexArray> : fexgen::batchable {};
 template<> struct fex_gen_config<glBindVertexBuffer> {};
 template<> struct fex_gen_config<glBindVertexBuffers> {};
 template<> struct fex_gen_config<glBindVertexShaderEXT> {};
@@ -466,7 +466,7 @@ template<> struct fex_gen_config<glBlendEquationSeparate> {};
 template<> struct fex_gen_config<glBlendEquationSeparateiARB> {};
 template<> struct fex_gen_config<glBlendEquationSeparatei> {};
 template<> struct fex_gen_config<glBlendEquationSeparateIndexedAMD> {};
-template<> struct fex_gen_config<glBlendFunc> {};
+template<> struct fex_gen_config<glBlendFunc> : fexgen::batchable {};
 template<> struct fex_gen_config<glBlendFunciARB> {};
 template<> struct fex_gen_config<glBlendFunci> {};
 template<> struct fex_gen_config<glBlendFuncIndexedAMD> {};
@@ -715,7 +715,7 @@ template<> struct fex_gen_config<glCreateStatesNV> {};
 template<> struct fex_gen_config<glCreateTextures> {};
 template<> struct fex_gen_config<glCreateTransformFeedbacks> {};
 template<> struct fex_gen_config<glCreateVertexArrays> {};
-template<> struct fex_gen_config<glCullFace> {};
+template<> struct fex_gen_config<glCullFace> : fexgen::batchable {};
 template<> struct fex_gen_config<glCullParameterdvEXT> {};
 template<> struct fex_gen_config<glCullParameterfvEXT> {};
 template<> struct fex_gen_config<glCurrentPaletteMatrixARB> {};
@@ -772,8 +772,8 @@ template<> struct fex_gen_config<glDeleteVertexArrays> {};
 template<> struct fex_gen_config<glDeleteVertexShaderEXT> {};
 template<> struct fex_gen_config<glDepthBoundsdNV> {};
 template<> struct fex_gen_config<glDepthBoundsEXT> {};
-template<> struct fex_gen_config<glDepthFunc> {};
-template<> struct fex_gen_config<glDepthMask> {};
+template<> struct fex_gen_config<glDepthFunc> : fexgen::batchable {};
+template<> struct fex_gen_config<glDepthMask> : fexgen::batchable {};
 template<> struct fex_gen_config<glDepthRangeArraydvNV> {};
 template<> struct fex_gen_config<glDepthRangeArrayv> {};
 template<> struct fex_gen_config<glDepthRangedNV> {};
@@ -789,7 +789,7 @@ template<> struct fex_gen_config<glDetailTexFuncSGIS> {};
 template<> struct fex_gen_config<glDisableClientState> {};
 template<> struct fex_gen_config<glDisableClientStateiEXT> {};
 template<> struct fex_gen_config<glDisableClientStateIndexedEXT> {};
-template<> struct fex_gen_config<glDisable> {};
+template<> struct fex_gen_config<glDisable> : fexgen::batchable {};
 template<> struct fex_gen_config<glDisablei> {};
 template<> struct fex_gen_config<glDisableIndexedEXT> {};
 template<> struct fex_gen_config<glDisableVariantClientStateEXT> {};
@@ -798,7 +798,7 @@ template<> struct fex_gen_config<glDisableVertexArrayAttrib> {};
 template<> struct fex_gen_config<glDisableVertexArrayEXT> {};
 template<> struct fex_gen_config<glDisableVertexAttribAPPLE> {};
 template<> struct fex_gen_config<glDisableVertexAttribArrayARB> {};
-template<> struct fex_gen_config<glDisableVertexAttribArray> {};
+template<> struct fex_gen_config<glDisableVertexAttribArray> : fexgen::batchable {};
 template<> struct fex_gen_config<glDispatchCompute> {};
 template<> struct fex_gen_config<glDispatchComputeGroupSizeARB> {};
 template<> struct fex_gen_config<glDispatchComputeIndirect> {};
@@ -859,7 +859,7 @@ template<> struct fex_gen_config<glElementPointerATI> {};
 template<> struct fex_gen_config<glEnableClientState> {};
 template<> struct fex_gen_config<glEnableClientStateiEXT> {};
 template<> struct fex_gen_config<glEnableClientStateIndexedEXT> {};
-template<> struct fex_gen_config<glEnable> {};
+template<> struct fex_gen_config<glEnable> : fexgen::batchable {};
 template<> struct fex_gen_config<glEnablei> {};
 template<> struct fex_gen_config<glEnableIndexedEXT> {};
 template<> struct fex_gen_config<glEnableVariantClientStateEXT> {};
@@ -868,7 +868,7 @@ template<> struct fex_gen_config<glEnableVertexArrayAttrib> {};
 template<> struct fex_gen_config<glEnableVertexArrayEXT> {};
 template<> struct fex_gen_config<glEnableVertexAttribAPPLE> {};
 template<> struct fex_gen_config<glEnableVertexAttribArrayARB> {};
-template<> struct fex_gen_config<glEnableVertexAttribArray> {};
+template<> struct fex_gen_config<glEnableVertexAttribArray> : fexgen::batchable {};
 template<> struct fex_gen_config<glEnd> {};
 template<> struct fex_gen_config<glEndConditionalRender> {};
 template<> struct fex_gen_config<glEndConditionalRenderNV> {};
@@ -983,7 +983,7 @@ template<> struct fex_gen_config<glFramebufferTextureMultiviewOVR> {};
 template<> struct fex_gen_config<glFrameTerminatorGREMEDY> {};
 template<> struct fex_gen_config<glFrameZoomSGIX> {};
 template<> struct fex_gen_config<glFreeObjectBufferATI> {};
-template<> struct fex_gen_config<glFrontFace> {};
+template<> struct fex_gen_config<glFrontFace> : fexgen::batchable {};
 template<> struct fex_gen_config<glFrustumfOES> {};
 template<> struct fex_gen_config<glFrustum> {};
 template<> struct fex_gen_config<glFrustumxOES> {};
@@ -1482,7 +1482,7 @@ template<> struct fex_gen_config<glLightModelxvOES> {};
 template<> struct fex_gen_config<glLightxOES> {};
 template<> struct fex_gen_config<glLightxvOES> {};
 template<> struct fex_gen_config<glLineStipple> {};
-template<> struct fex_gen_config<glLineWidth> {};
+template<> struct fex_gen_config<glLineWidth> : fexgen::batchable {};
 template<> struct fex_gen_config<glLineWidthxOES> {};
 template<> struct fex_gen_config<glLinkProgramARB> {};
 template<> struct fex_gen_config<glLinkProgram> {};
@@ -2224,7 +2224,7 @@ template<> struct fex_gen_config<glScalexOES> {};
 template<> struct fex_gen_config<glScissorArrayv> {};
 template<> struct fex_gen_config<glScissorExclusiveArrayvNV> {};
 template<> struct fex_gen_config<glScissorExclusiveNV> {};
-template<> struct fex_gen_config<glScissor> {};
+template<> struct fex_gen_config<glScissor> : fexgen::batchable {};
 template<> struct fex_gen_config<glScissorIndexed> {};
 template<> struct fex_gen_config<glScissorIndexedv> {};
 template<> struct fex_gen_config<glSecondaryColor3bEXT> {};
@@ -2287,12 +2287,12 @@ template<> struct fex_gen_config<glStateCaptureNV> {};
 template<> struct fex_gen_config<glStencilClearTagEXT> {};
 template<> struct fex_gen_config<glStencilFillPathInstancedNV> {};
 template<> struct fex_gen_config<glStencilFillPathNV> {};
-template<> struct fex_gen_config<glStencilFunc> {};
+template<> struct fex_gen_config<glStencilFunc> : fexgen::batchable {};
 template<> struct fex_gen_config<glStencilFuncSeparateATI> {};
 template<> struct fex_gen_config<glStencilFuncSeparate> {};
-template<> struct fex_gen_config<glStencilMask> {};
+template<> struct fex_gen_config<glStencilMask> : fexgen::batchable {};
 template<> struct fex_gen_config<glStencilMaskSeparate> {};
-template<> struct fex_gen_config<glStencilOp> {};
+template<> struct fex_gen_config<glStencilOp> : fexgen::batchable {};
 template<> struct fex_gen_config<glStencilOpSeparateATI> {};
 template<> struct fex_gen_config<glStencilOpSeparate> {};
 template<> struct fex_gen_config<glStencilOpValueAMD> {};
@@ -2420,7 +2420,7 @@ template<> struct fex_gen_config<glTexGeniv> {};
 template<> struct fex_gen_config<glTexGenxOES> {};
 template<> struct fex_gen_config<glTexGenxvOES> {};
 template<> struct fex_gen_config<glTexImage1D> {};
-template<> struct fex_gen_config<glTexImage2D> {};
+template<> struct fex_gen_config<glTexImage2D> : fexgen::custom_host_impl {};
 template<> struct fex_gen_config<glTexImage2DMultisampleCoverageNV> {};
 template<> struct fex_gen_config<glTexImage2DMultisample> {};
 template<> struct fex_gen_config<glTexImage3DEXT> {};
@@ -2454,7 +2454,7 @@ template<> struct fex_gen_config<glTexStorageSparseAMD> {};
 template<> struct fex_gen_config<glTexSubImage1DEXT> {};
 template<> struct fex_gen_config<glTexSubImage1D> {};
 template<> struct fex_gen_config<glTexSubImage2DEXT> {};
-template<> struct fex_gen_config<glTexSubImage2D> {};
+template<> struct fex_gen_config<glTexSubImage2D> : fexgen::custom_host_impl {};
 template<> struct fex_gen_config<glTexSubImage3DEXT> {};
 template<> struct fex_gen_config<glTexSubImage3D> {};
 template<> struct fex_gen_config<glTexSubImage4DSGIS> {};
@@ -2529,7 +2529,7 @@ template<> struct fex_gen_config<glTranslatexOES> {};
 template<> struct fex_gen_config<glUniform1d> {};
 template<> struct fex_gen_config<glUniform1dv> {};
 template<> struct fex_gen_config<glUniform1fARB> {};
-template<> struct fex_gen_config<glUniform1f> {};
+template<> struct fex_gen_config<glUniform1f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform1fvARB> {};
 template<> struct fex_gen_config<glUniform1fv> {};
 template<> struct fex_gen_config<glUniform1i64ARB> {};
@@ -2537,7 +2537,7 @@ template<> struct fex_gen_config<glUniform1i64NV> {};
 template<> struct fex_gen_config<glUniform1i64vARB> {};
 template<> struct fex_gen_config<glUniform1i64vNV> {};
 template<> struct fex_gen_config<glUniform1iARB> {};
-template<> struct fex_gen_config<glUniform1i> {};
+template<> struct fex_gen_config<glUniform1i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform1ivARB> {};
 template<> struct fex_gen_config<glUniform1iv> {};
 template<> struct fex_gen_config<glUniform1ui64ARB> {};
@@ -2545,13 +2545,13 @@ template<> struct fex_gen_config<glUniform1ui64NV> {};
 template<> struct fex_gen_config<glUniform1ui64vARB> {};
 template<> struct fex_gen_config<glUniform1ui64vNV> {};
 template<> struct fex_gen_config<glUniform1uiEXT> {};
-template<> struct fex_gen_config<glUniform1ui> {};
+template<> struct fex_gen_config<glUniform1ui> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform1uivEXT> {};
 template<> struct fex_gen_config<glUniform1uiv> {};
 template<> struct fex_gen_config<glUniform2d> {};
 template<> struct fex_gen_config<glUniform2dv> {};
 template<> struct fex_gen_config<glUniform2fARB> {};
-template<> struct fex_gen_config<glUniform2f> {};
+template<> struct fex_gen_config<glUniform2f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform2fvARB> {};
 template<> struct fex_gen_config<glUniform2fv> {};
 template<> struct fex_gen_config<glUniform2i64ARB> {};
@@ -2559,7 +2559,7 @@ template<> struct fex_gen_config<glUniform2i64NV> {};
 template<> struct fex_gen_config<glUniform2i64vARB> {};
 template<> struct fex_gen_config<glUniform2i64vNV> {};
 template<> struct fex_gen_config<glUniform2iARB> {};
-template<> struct fex_gen_config<glUniform2i> {};
+template<> struct fex_gen_config<glUniform2i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform2ivARB> {};
 template<> struct fex_gen_config<glUniform2iv> {};
 template<> struct fex_gen_config<glUniform2ui64ARB> {};
@@ -2567,13 +2567,13 @@ template<> struct fex_gen_config<glUniform2ui64NV> {};
 template<> struct fex_gen_config<glUniform2ui64vARB> {};
 template<> struct fex_gen_config<glUniform2ui64vNV> {};
 template<> struct fex_gen_config<glUniform2uiEXT> {};
-template<> struct fex_gen_config<glUniform2ui> {};
+template<> struct fex_gen_config<glUniform2ui> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform2uivEXT> {};
 template<> struct fex_gen_config<glUniform2uiv> {};
 template<> struct fex_gen_config<glUniform3d> {};
 template<> struct fex_gen_config<glUniform3dv> {};
 template<> struct fex_gen_config<glUniform3fARB> {};
-template<> struct fex_gen_config<glUniform3f> {};
+template<> struct fex_gen_config<glUniform3f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform3fvARB> {};
 template<> struct fex_gen_config<glUniform3fv> {};
 template<> struct fex_gen_config<glUniform3i64ARB> {};
@@ -2581,7 +2581,7 @@ template<> struct fex_gen_config<glUniform3i64NV> {};
 template<> struct fex_gen_config<glUniform3i64vARB> {};
 template<> struct fex_gen_config<glUniform3i64vNV> {};
 template<> struct fex_gen_config<glUniform3iARB> {};
-template<> struct fex_gen_config<glUniform3i> {};
+template<> struct fex_gen_config<glUniform3i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform3ivARB> {};
 template<> struct fex_gen_config<glUniform3iv> {};
 template<> struct fex_gen_config<glUniform3ui64ARB> {};
@@ -2589,13 +2589,13 @@ template<> struct fex_gen_config<glUniform3ui64NV> {};
 template<> struct fex_gen_config<glUniform3ui64vARB> {};
 template<> struct fex_gen_config<glUniform3ui64vNV> {};
 template<> struct fex_gen_config<glUniform3uiEXT> {};
-template<> struct fex_gen_config<glUniform3ui> {};
+template<> struct fex_gen_config<glUniform3ui> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform3uivEXT> {};
 template<> struct fex_gen_config<glUniform3uiv> {};
 template<> struct fex_gen_config<glUniform4d> {};
 template<> struct fex_gen_config<glUniform4dv> {};
 template<> struct fex_gen_config<glUniform4fARB> {};
-template<> struct fex_gen_config<glUniform4f> {};
+template<> struct fex_gen_config<glUniform4f> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform4fvARB> {};
 template<> struct fex_gen_config<glUniform4fv> {};
 template<> struct fex_gen_config<glUniform4i64ARB> {};
@@ -2603,7 +2603,7 @@ template<> struct fex_gen_config<glUniform4i64NV> {};
 template<> struct fex_gen_config<glUniform4i64vARB> {};
 template<> struct fex_gen_config<glUniform4i64vNV> {};
 template<> struct fex_gen_config<glUniform4iARB> {};
-template<> struct fex_gen_config<glUniform4i> {};
+template<> struct fex_gen_config<glUniform4i> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform4ivARB> {};
 template<> struct fex_gen_config<glUniform4iv> {};
 template<> struct fex_gen_config<glUniform4ui64ARB> {};
@@ -2611,7 +2611,7 @@ template<> struct fex_gen_config<glUniform4ui64NV> {};
 template<> struct fex_gen_config<glUniform4ui64vARB> {};
 template<> struct fex_gen_config<glUniform4ui64vNV> {};
 template<> struct fex_gen_config<glUniform4uiEXT> {};
-template<> struct fex_gen_config<glUniform4ui> {};
+template<> struct fex_gen_config<glUniform4ui> : fexgen::batchable {};
 template<> struct fex_gen_config<glUniform4uivEXT> {};
 template<> struct fex_gen_config<glUniform4uiv> {};
 template<> struct fex_gen_config<glUniformBlockBinding> {};
@@ -2649,7 +2649,7 @@ template<> struct fex_gen_config<glUnmapObjectBufferATI> {};
 template<> struct fex_gen_config<glUnmapTexture2DINTEL> {};
 template<> struct fex_gen_config<glUpdateObjectBufferATI> {};
 template<> struct fex_gen_config<glUploadGpuMaskNVX> {};
-template<> struct fex_gen_config<glUseProgram> {};
+template<> struct fex_gen_config<glUseProgram> : fexgen::batchable {};
 template<> struct fex_gen_config<glUseProgramObjectARB> {};
 template<> struct fex_gen_config<glUseProgramStages> {};
 template<> struct fex_gen_config<glUseShaderProgramEXT> {};
@@ -3018,7 +3018,7 @@ template<> struct fex_gen_config<glVideoCaptureStreamParameterdvNV> {};
 template<> struct fex_gen_config<glVideoCaptureStreamParameterfvNV> {};
 template<> struct fex_gen_config<glVideoCaptureStreamParameterivNV> {};
 template<> struct fex_gen_config<glViewportArrayv> {};
-template<> struct fex_gen_config<glViewport> {};
+template<> struct fex_gen_config<glViewport> : fexgen::batchable {};
 template<> struct fex_gen_config<glViewportIndexedf> {};
 template<> struct fex_gen_config<glViewportIndexedfv> {};
 template<> struct fex_gen_config<glViewportPositionWScaleNV> {};
@@ -12,6 +12,7 @@ $end_info$
 #include <dlfcn.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <cstring>
 #include <map>
 #include <string>
@@ -44,7 +45,111 @@ void SDL_LogMessageV(int, SDL_LogPriority, const char*, __va_list_tag*) { printf
 int SDL_vsnprintf(char*, size_t, const char*, __va_list_tag*) { return printf("SDL2: SDL_vsnprintf\n");}
 int SDL_vsscanf(const char*, const char*, __va_list_tag*) { return printf("SDL2: SDL_vsscanf\n");}
 
+// ---- Audio callback batching ----
+// Every audio callback is a full guest<->host crossing, so with small periods
+// the crossing rate alone can cause underruns. FEX_SDL2_AUDIO_BATCH=N asks the
+// host for a buffer covering N periods and slices it up on this side: the
+// guest callback still sees the period size the application requested, but one
+// crossing now fills N periods worth of audio. Trades N-1 periods of extra
+// output latency for a proportionally lower crossing rate.
+namespace {
+struct AudioBatchState {
+    SDL_AudioDeviceID Device;
+    SDL_AudioCallback GuestCallback;
+    void *GuestUserdata;
+    int PeriodBytes;
+};
+
+// SDL allows a handful of simultaneously open devices; a fixed table avoids
+// allocation concerns in the shim.
+AudioBatchState AudioBatchStates[16]{};
+
+int AudioBatchFactor() {
+    static const int Factor = [] {
+        const char *Env = getenv("FEX_SDL2_AUDIO_BATCH");
+        const int Value = Env ? atoi(Env) : 1;
+        return Value < 1 ? 1 : (Value > 16 ? 16 : Value);
+    }();
+    return Factor;
+}
+
+void AudioBatchTrampoline(void *userdata, Uint8 *stream, int len) {
+    auto *State = static_cast<AudioBatchState *>(userdata);
+    // Feed the guest callback its original period size so the application's
+    // timing assumptions hold; the driver may round the big buffer to a
+    // non-multiple, in which case the final chunk is short.
+    while (len > 0) {
+        const int Chunk = len < State->PeriodBytes ? len : State->PeriodBytes;
+        State->GuestCallback(State->GuestUserdata, stream, Chunk);
+        stream += Chunk;
+        len -= Chunk;
+    }
+}
+}
+
 extern "C" {
+    SDL_AudioDeviceID SDL_OpenAudioDevice(const char *device, int iscapture, const SDL_AudioSpec *desired, SDL_AudioSpec *obtained, int allowed_changes) {
+        const int Factor = AudioBatchFactor();
+        if (Factor == 1 || !desired || !desired->callback || iscapture) {
+            return fexfn_pack_SDL_OpenAudioDevice(device, iscapture, desired, obtained, allowed_changes);
+        }
+
+        AudioBatchState *State = nullptr;
+        for (auto &Slot : AudioBatchStates) {
+            if (!Slot.GuestCallback) {
+                State = &Slot;
+                break;
+            }
+        }
+        if (!State) {
+            // Table full, fall back to unbatched delivery.
+            return fexfn_pack_SDL_OpenAudioDevice(device, iscapture, desired, obtained, allowed_changes);
+        }
+
+        SDL_AudioSpec HostSpec = *desired;
+        HostSpec.samples = desired->samples * Factor;
+        HostSpec.callback = AudioBatchTrampoline;
+        HostSpec.userdata = State;
+        State->GuestCallback = desired->callback;
+        State->GuestUserdata = desired->userdata;
+
+        SDL_AudioSpec HostObtained{};
+        const SDL_AudioDeviceID Device = fexfn_pack_SDL_OpenAudioDevice(device, iscapture, &HostSpec, &HostObtained, allowed_changes);
+        if (Device == 0) {
+            *State = {};
+            return 0;
+        }
+
+        // Period size from what the device actually granted, not what we asked.
+        int PeriodSamples = HostObtained.samples / Factor;
+        if (PeriodSamples < 1) {
+            PeriodSamples = HostObtained.samples;
+        }
+        State->Device = Device;
+        State->PeriodBytes = (SDL_AUDIO_BITSIZE(HostObtained.format) / 8) * HostObtained.channels * PeriodSamples;
+
+        if (obtained) {
+            // The application sees per-callback values, not the batched buffer.
+            *obtained = HostObtained;
+            obtained->samples = PeriodSamples;
+            obtained->size = State->PeriodBytes;
+            obtained->callback = desired->callback;
+            obtained->userdata = desired->userdata;
+        }
+
+        return Device;
+    }
+
+    void SDL_CloseAudioDevice(SDL_AudioDeviceID dev) {
+        fexfn_pack_SDL_CloseAudioDevice(dev);
+        for (auto &Slot : AudioBatchStates) {
+            if (Slot.GuestCallback && Slot.Device == dev) {
+                Slot = {};
+                break;
+            }
+        }
+    }
+
     void* SDL_GL_GetProcAddress(const char* name) {
 		// TODO: Fix this HACK
 		return (void*)glXGetProcAddress((const GLubyte*)name);
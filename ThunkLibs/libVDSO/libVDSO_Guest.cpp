@@ -24,6 +24,7 @@ int __vdso_gettimeofday(struct timeval *tv, struct timezone *tz) __attribute__((
 int __vdso_clock_gettime(clockid_t, struct timespec *) __attribute__((alias("fexfn_pack_clock_gettime")));
 int __vdso_clock_getres(clockid_t, struct timespec *) __attribute__((alias("fexfn_pack_clock_getres")));
 int __vdso_getcpu(uint32_t *, uint32_t *) __attribute__((alias("fexfn_pack_getcpu")));
+ssize_t __vdso_getrandom(void *, size_t, unsigned int, void *, size_t) __attribute__((alias("fexfn_pack_getrandom")));
 
 #if __SIZEOF_POINTER__ == 4
 int __vdso_clock_gettime64(clockid_t, struct timespec64 *) __attribute__((alias("fexfn_pack_clock_gettime64")));
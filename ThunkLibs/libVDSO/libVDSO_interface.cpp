@@ -16,6 +16,10 @@ template<> struct fex_gen_config<clock_gettime> {};
 template<> struct fex_gen_config<clock_getres> {};
 template<> struct fex_gen_config<getcpu> {};
 
+// vDSO getrandom ABI, five arguments unlike the libc wrapper
+extern ssize_t getrandom (void *__buffer, size_t __length, unsigned int __flags, void *__opaque_state, size_t __opaque_len) __THROW;
+template<> struct fex_gen_config<getrandom> {};
+
 #if __SIZEOF_POINTER__ == 4
 extern int clock_gettime64 (clockid_t __clock_id, struct timespec64 *__tp) __THROW;
 template<> struct fex_gen_config<clock_gettime64> {};
@@ -258,7 +258,7 @@ template<> struct fex_gen_config<snd_pcm_set_params> {};
 template<> struct fex_gen_config<snd_pcm_get_params> {};
 template<> struct fex_gen_config<snd_pcm_info_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_info_malloc> {};
-template<> struct fex_gen_config<snd_pcm_info_free> {};
+template<> struct fex_gen_config<snd_pcm_info_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_info_copy> {};
 template<> struct fex_gen_config<snd_pcm_info_get_device> {};
 template<> struct fex_gen_config<snd_pcm_info_get_subdevice> {};
@@ -295,7 +295,7 @@ template<> struct fex_gen_config<snd_pcm_hw_params_get_sbits> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_get_fifo_size> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_malloc> {};
-template<> struct fex_gen_config<snd_pcm_hw_params_free> {};
+template<> struct fex_gen_config<snd_pcm_hw_params_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_hw_params_copy> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_get_access> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_test_access> {};
@@ -406,7 +406,7 @@ template<> struct fex_gen_config<snd_pcm_hw_params_set_buffer_size_last> {};
 template<> struct fex_gen_config<snd_pcm_hw_params_get_min_align> {};
 template<> struct fex_gen_config<snd_pcm_sw_params_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_sw_params_malloc> {};
-template<> struct fex_gen_config<snd_pcm_sw_params_free> {};
+template<> struct fex_gen_config<snd_pcm_sw_params_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_sw_params_copy> {};
 template<> struct fex_gen_config<snd_pcm_sw_params_get_boundary> {};
 template<> struct fex_gen_config<snd_pcm_sw_params_set_tstamp_mode> {};
@@ -427,7 +427,7 @@ template<> struct fex_gen_config<snd_pcm_sw_params_set_silence_size> {};
 template<> struct fex_gen_config<snd_pcm_sw_params_get_silence_size> {};
 template<> struct fex_gen_config<snd_pcm_access_mask_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_access_mask_malloc> {};
-template<> struct fex_gen_config<snd_pcm_access_mask_free> {};
+template<> struct fex_gen_config<snd_pcm_access_mask_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_access_mask_copy> {};
 template<> struct fex_gen_config<snd_pcm_access_mask_none> {};
 template<> struct fex_gen_config<snd_pcm_access_mask_any> {};
@@ -437,7 +437,7 @@ template<> struct fex_gen_config<snd_pcm_access_mask_set> {};
 template<> struct fex_gen_config<snd_pcm_access_mask_reset> {};
 template<> struct fex_gen_config<snd_pcm_format_mask_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_format_mask_malloc> {};
-template<> struct fex_gen_config<snd_pcm_format_mask_free> {};
+template<> struct fex_gen_config<snd_pcm_format_mask_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_format_mask_copy> {};
 template<> struct fex_gen_config<snd_pcm_format_mask_none> {};
 template<> struct fex_gen_config<snd_pcm_format_mask_any> {};
@@ -447,7 +447,7 @@ template<> struct fex_gen_config<snd_pcm_format_mask_set> {};
 template<> struct fex_gen_config<snd_pcm_format_mask_reset> {};
 template<> struct fex_gen_config<snd_pcm_subformat_mask_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_subformat_mask_malloc> {};
-template<> struct fex_gen_config<snd_pcm_subformat_mask_free> {};
+template<> struct fex_gen_config<snd_pcm_subformat_mask_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_subformat_mask_copy> {};
 template<> struct fex_gen_config<snd_pcm_subformat_mask_none> {};
 template<> struct fex_gen_config<snd_pcm_subformat_mask_any> {};
@@ -457,7 +457,7 @@ template<> struct fex_gen_config<snd_pcm_subformat_mask_set> {};
 template<> struct fex_gen_config<snd_pcm_subformat_mask_reset> {};
 template<> struct fex_gen_config<snd_pcm_status_sizeof> {};
 template<> struct fex_gen_config<snd_pcm_status_malloc> {};
-template<> struct fex_gen_config<snd_pcm_status_free> {};
+template<> struct fex_gen_config<snd_pcm_status_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_pcm_status_copy> {};
 template<> struct fex_gen_config<snd_pcm_status_get_state> {};
 template<> struct fex_gen_config<snd_pcm_status_get_trigger_tstamp> {};
@@ -552,7 +552,7 @@ template<> struct fex_gen_config<snd_rawmidi_poll_descriptors_revents> {};
 template<> struct fex_gen_config<snd_rawmidi_nonblock> {};
 template<> struct fex_gen_config<snd_rawmidi_info_sizeof> {};
 template<> struct fex_gen_config<snd_rawmidi_info_malloc> {};
-template<> struct fex_gen_config<snd_rawmidi_info_free> {};
+template<> struct fex_gen_config<snd_rawmidi_info_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_rawmidi_info_copy> {};
 template<> struct fex_gen_config<snd_rawmidi_info_get_device> {};
 template<> struct fex_gen_config<snd_rawmidi_info_get_subdevice> {};
@@ -570,7 +570,7 @@ template<> struct fex_gen_config<snd_rawmidi_info_set_stream> {};
 template<> struct fex_gen_config<snd_rawmidi_info> {};
 template<> struct fex_gen_config<snd_rawmidi_params_sizeof> {};
 template<> struct fex_gen_config<snd_rawmidi_params_malloc> {};
-template<> struct fex_gen_config<snd_rawmidi_params_free> {};
+template<> struct fex_gen_config<snd_rawmidi_params_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_rawmidi_params_copy> {};
 template<> struct fex_gen_config<snd_rawmidi_params_set_buffer_size> {};
 template<> struct fex_gen_config<snd_rawmidi_params_get_buffer_size> {};
@@ -582,7 +582,7 @@ template<> struct fex_gen_config<snd_rawmidi_params> {};
 template<> struct fex_gen_config<snd_rawmidi_params_current> {};
 template<> struct fex_gen_config<snd_rawmidi_status_sizeof> {};
 template<> struct fex_gen_config<snd_rawmidi_status_malloc> {};
-template<> struct fex_gen_config<snd_rawmidi_status_free> {};
+template<> struct fex_gen_config<snd_rawmidi_status_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_rawmidi_status_copy> {};
 template<> struct fex_gen_config<snd_rawmidi_status_get_tstamp> {};
 template<> struct fex_gen_config<snd_rawmidi_status_get_avail> {};
@@ -619,7 +619,7 @@ template<> struct fex_gen_config<snd_timer_continue> {};
 template<> struct fex_gen_config<snd_timer_read> {};
 template<> struct fex_gen_config<snd_timer_id_sizeof> {};
 template<> struct fex_gen_config<snd_timer_id_malloc> {};
-template<> struct fex_gen_config<snd_timer_id_free> {};
+template<> struct fex_gen_config<snd_timer_id_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_timer_id_copy> {};
 template<> struct fex_gen_config<snd_timer_id_set_class> {};
 template<> struct fex_gen_config<snd_timer_id_get_class> {};
@@ -633,7 +633,7 @@ template<> struct fex_gen_config<snd_timer_id_set_subdevice> {};
 template<> struct fex_gen_config<snd_timer_id_get_subdevice> {};
 template<> struct fex_gen_config<snd_timer_ginfo_sizeof> {};
 template<> struct fex_gen_config<snd_timer_ginfo_malloc> {};
-template<> struct fex_gen_config<snd_timer_ginfo_free> {};
+template<> struct fex_gen_config<snd_timer_ginfo_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_timer_ginfo_copy> {};
 template<> struct fex_gen_config<snd_timer_ginfo_set_tid> {};
 template<> struct fex_gen_config<snd_timer_ginfo_get_tid> {};
@@ -647,7 +647,7 @@ template<> struct fex_gen_config<snd_timer_ginfo_get_resolution_max> {};
 template<> struct fex_gen_config<snd_timer_ginfo_get_clients> {};
 template<> struct fex_gen_config<snd_timer_info_sizeof> {};
 template<> struct fex_gen_config<snd_timer_info_malloc> {};
-template<> struct fex_gen_config<snd_timer_info_free> {};
+template<> struct fex_gen_config<snd_timer_info_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_timer_info_copy> {};
 template<> struct fex_gen_config<snd_timer_info_is_slave> {};
 template<> struct fex_gen_config<snd_timer_info_get_card> {};
@@ -656,7 +656,7 @@ template<> struct fex_gen_config<snd_timer_info_get_name> {};
 template<> struct fex_gen_config<snd_timer_info_get_resolution> {};
 template<> struct fex_gen_config<snd_timer_params_sizeof> {};
 template<> struct fex_gen_config<snd_timer_params_malloc> {};
-template<> struct fex_gen_config<snd_timer_params_free> {};
+template<> struct fex_gen_config<snd_timer_params_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_timer_params_copy> {};
 template<> struct fex_gen_config<snd_timer_params_set_auto_start> {};
 template<> struct fex_gen_config<snd_timer_params_get_auto_start> {};
@@ -672,7 +672,7 @@ template<> struct fex_gen_config<snd_timer_params_set_filter> {};
 template<> struct fex_gen_config<snd_timer_params_get_filter> {};
 template<> struct fex_gen_config<snd_timer_status_sizeof> {};
 template<> struct fex_gen_config<snd_timer_status_malloc> {};
-template<> struct fex_gen_config<snd_timer_status_free> {};
+template<> struct fex_gen_config<snd_timer_status_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_timer_status_copy> {};
 template<> struct fex_gen_config<snd_timer_status_get_timestamp> {};
 template<> struct fex_gen_config<snd_timer_status_get_resolution> {};
@@ -694,7 +694,7 @@ template<> struct fex_gen_config<snd_hwdep_write> {};
 template<> struct fex_gen_config<snd_hwdep_read> {};
 template<> struct fex_gen_config<snd_hwdep_info_sizeof> {};
 template<> struct fex_gen_config<snd_hwdep_info_malloc> {};
-template<> struct fex_gen_config<snd_hwdep_info_free> {};
+template<> struct fex_gen_config<snd_hwdep_info_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_hwdep_info_copy> {};
 template<> struct fex_gen_config<snd_hwdep_info_get_device> {};
 template<> struct fex_gen_config<snd_hwdep_info_get_card> {};
@@ -704,7 +704,7 @@ template<> struct fex_gen_config<snd_hwdep_info_get_iface> {};
 template<> struct fex_gen_config<snd_hwdep_info_set_device> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_status_sizeof> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_status_malloc> {};
-template<> struct fex_gen_config<snd_hwdep_dsp_status_free> {};
+template<> struct fex_gen_config<snd_hwdep_dsp_status_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_hwdep_dsp_status_copy> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_status_get_version> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_status_get_id> {};
@@ -713,7 +713,7 @@ template<> struct fex_gen_config<snd_hwdep_dsp_status_get_dsp_loaded> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_status_get_chip_ready> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_image_sizeof> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_image_malloc> {};
-template<> struct fex_gen_config<snd_hwdep_dsp_image_free> {};
+template<> struct fex_gen_config<snd_hwdep_dsp_image_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_hwdep_dsp_image_copy> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_image_get_index> {};
 template<> struct fex_gen_config<snd_hwdep_dsp_image_get_name> {};
@@ -784,7 +784,7 @@ template<> struct fex_gen_config<snd_ctl_ascii_elem_id_parse> {};
 template<> struct fex_gen_config<snd_ctl_ascii_value_parse> {};
 template<> struct fex_gen_config<snd_ctl_elem_id_sizeof> {};
 template<> struct fex_gen_config<snd_ctl_elem_id_malloc> {};
-template<> struct fex_gen_config<snd_ctl_elem_id_free> {};
+template<> struct fex_gen_config<snd_ctl_elem_id_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_ctl_elem_id_clear> {};
 template<> struct fex_gen_config<snd_ctl_elem_id_copy> {};
 template<> struct fex_gen_config<snd_ctl_elem_id_get_numid> {};
@@ -801,7 +801,7 @@ template<> struct fex_gen_config<snd_ctl_elem_id_set_name> {};
 template<> struct fex_gen_config<snd_ctl_elem_id_set_index> {};
 template<> struct fex_gen_config<snd_ctl_card_info_sizeof> {};
 template<> struct fex_gen_config<snd_ctl_card_info_malloc> {};
-template<> struct fex_gen_config<snd_ctl_card_info_free> {};
+template<> struct fex_gen_config<snd_ctl_card_info_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_ctl_card_info_clear> {};
 template<> struct fex_gen_config<snd_ctl_card_info_copy> {};
 template<> struct fex_gen_config<snd_ctl_card_info_get_card> {};
@@ -813,13 +813,13 @@ template<> struct fex_gen_config<snd_ctl_card_info_get_mixername> {};
 template<> struct fex_gen_config<snd_ctl_card_info_get_components> {};
 template<> struct fex_gen_config<snd_ctl_event_sizeof> {};
 template<> struct fex_gen_config<snd_ctl_event_malloc> {};
-template<> struct fex_gen_config<snd_ctl_event_free> {};
+template<> struct fex_gen_config<snd_ctl_event_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_ctl_event_clear> {};
 template<> struct fex_gen_config<snd_ctl_event_copy> {};
 template<> struct fex_gen_config<snd_ctl_event_get_type> {};
 template<> struct fex_gen_config<snd_ctl_elem_list_sizeof> {};
 template<> struct fex_gen_config<snd_ctl_elem_list_malloc> {};
-template<> struct fex_gen_config<snd_ctl_elem_list_free> {};
+template<> struct fex_gen_config<snd_ctl_elem_list_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_ctl_elem_list_clear> {};
 template<> struct fex_gen_config<snd_ctl_elem_list_copy> {};
 template<> struct fex_gen_config<snd_ctl_elem_list_set_offset> {};
@@ -834,7 +834,7 @@ template<> struct fex_gen_config<snd_ctl_elem_list_get_name> {};
 template<> struct fex_gen_config<snd_ctl_elem_list_get_index> {};
 template<> struct fex_gen_config<snd_ctl_elem_info_sizeof> {};
 template<> struct fex_gen_config<snd_ctl_elem_info_malloc> {};
-template<> struct fex_gen_config<snd_ctl_elem_info_free> {};
+template<> struct fex_gen_config<snd_ctl_elem_info_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_ctl_elem_info_clear> {};
 template<> struct fex_gen_config<snd_ctl_elem_info_copy> {};
 template<> struct fex_gen_config<snd_ctl_elem_info_get_type> {};
@@ -889,7 +889,7 @@ template<> struct fex_gen_config<snd_ctl_elem_add_iec958> {};
 template<> struct fex_gen_config<snd_ctl_elem_remove> {};
 template<> struct fex_gen_config<snd_ctl_elem_value_sizeof> {};
 template<> struct fex_gen_config<snd_ctl_elem_value_malloc> {};
-template<> struct fex_gen_config<snd_ctl_elem_value_free> {};
+template<> struct fex_gen_config<snd_ctl_elem_value_free> : fexgen::batchable {};
 template<> struct fex_gen_config<snd_ctl_elem_value_clear> {};
 template<> struct fex_gen_config<snd_ctl_elem_value_copy> {};
 template<> struct fex_gen_config<snd_ctl_elem_value_compare> {};
@@ -0,0 +1,21 @@
+/*
+$info$
+tags: thunklibs|crypto
+$end_info$
+*/
+
+extern "C" {
+#include <openssl/evp.h>
+}
+
+#include <stdio.h>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "common/Guest.h"
+#include <stdarg.h>
+
+#include "thunkgen_guest_libcrypto.inl"
+
+LOAD_LIB(libcrypto)
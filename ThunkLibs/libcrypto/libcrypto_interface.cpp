@@ -0,0 +1,72 @@
+#include <common/GeneratorInterface.h>
+
+extern "C" {
+#include <openssl/evp.h>
+}
+
+template<auto>
+struct fex_gen_config {
+    unsigned version = 3;
+};
+
+template<typename>
+struct fex_gen_type {};
+
+// All EVP state lives behind opaque handles that only the host library ever
+// dereferences, so the contexts and algorithm descriptors thunk cleanly.
+template<> struct fex_gen_type<EVP_MD_CTX> : fexgen::opaque_type {};
+template<> struct fex_gen_type<EVP_MD> : fexgen::opaque_type {};
+template<> struct fex_gen_type<EVP_CIPHER_CTX> : fexgen::opaque_type {};
+template<> struct fex_gen_type<EVP_CIPHER> : fexgen::opaque_type {};
+template<> struct fex_gen_type<ENGINE> : fexgen::opaque_type {};
+
+// Message digests
+template<> struct fex_gen_config<EVP_MD_CTX_new> {};
+template<> struct fex_gen_config<EVP_MD_CTX_free> {};
+template<> struct fex_gen_config<EVP_MD_CTX_reset> {};
+template<> struct fex_gen_config<EVP_MD_CTX_copy_ex> {};
+template<> struct fex_gen_config<EVP_DigestInit> {};
+template<> struct fex_gen_config<EVP_DigestInit_ex> {};
+template<> struct fex_gen_config<EVP_DigestUpdate> {};
+template<> struct fex_gen_config<EVP_DigestFinal> {};
+template<> struct fex_gen_config<EVP_DigestFinal_ex> {};
+template<> struct fex_gen_config<EVP_Digest> {};
+template<> struct fex_gen_config<EVP_get_digestbyname> {};
+
+template<> struct fex_gen_config<EVP_md5> {};
+template<> struct fex_gen_config<EVP_sha1> {};
+template<> struct fex_gen_config<EVP_sha224> {};
+template<> struct fex_gen_config<EVP_sha256> {};
+template<> struct fex_gen_config<EVP_sha384> {};
+template<> struct fex_gen_config<EVP_sha512> {};
+
+// Symmetric ciphers. EVP_CIPHER_CTX_ctrl covers the AEAD tag handling GCM and
+// chacha20-poly1305 users go through.
+template<> struct fex_gen_config<EVP_CIPHER_CTX_new> {};
+template<> struct fex_gen_config<EVP_CIPHER_CTX_free> {};
+template<> struct fex_gen_config<EVP_CIPHER_CTX_reset> {};
+template<> struct fex_gen_config<EVP_CIPHER_CTX_ctrl> {};
+template<> struct fex_gen_config<EVP_CIPHER_CTX_set_padding> {};
+template<> struct fex_gen_config<EVP_CIPHER_CTX_set_key_length> {};
+template<> struct fex_gen_config<EVP_EncryptInit_ex> {};
+template<> struct fex_gen_config<EVP_EncryptUpdate> {};
+template<> struct fex_gen_config<EVP_EncryptFinal_ex> {};
+template<> struct fex_gen_config<EVP_DecryptInit_ex> {};
+template<> struct fex_gen_config<EVP_DecryptUpdate> {};
+template<> struct fex_gen_config<EVP_DecryptFinal_ex> {};
+template<> struct fex_gen_config<EVP_CipherInit_ex> {};
+template<> struct fex_gen_config<EVP_CipherUpdate> {};
+template<> struct fex_gen_config<EVP_CipherFinal_ex> {};
+template<> struct fex_gen_config<EVP_get_cipherbyname> {};
+
+template<> struct fex_gen_config<EVP_aes_128_ecb> {};
+template<> struct fex_gen_config<EVP_aes_128_cbc> {};
+template<> struct fex_gen_config<EVP_aes_128_ctr> {};
+template<> struct fex_gen_config<EVP_aes_128_gcm> {};
+template<> struct fex_gen_config<EVP_aes_192_cbc> {};
+template<> struct fex_gen_config<EVP_aes_256_ecb> {};
+template<> struct fex_gen_config<EVP_aes_256_cbc> {};
+template<> struct fex_gen_config<EVP_aes_256_ctr> {};
+template<> struct fex_gen_config<EVP_aes_256_gcm> {};
+template<> struct fex_gen_config<EVP_chacha20> {};
+template<> struct fex_gen_config<EVP_chacha20_poly1305> {};
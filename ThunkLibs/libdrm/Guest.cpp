@@ -6,7 +6,9 @@ $end_info$
 
 #include <xf86drm.h>
 
+#include <errno.h>
 #include <stdio.h>
+#include <sys/ioctl.h>
 #include <cstring>
 #include <map>
 #include <string>
@@ -30,6 +32,56 @@ extern "C" {
     return args.rv;
   }
 
+  // Implemented guest-side rather than thunked: GPU command submission is one
+  // ioctl per call no matter who issues it, so forwarding these to host libdrm
+  // only added a thunk crossing per submission. The fd table is shared with
+  // the host and the guest ioctl path carries the DRM compat translation for
+  // 32-bit processes. Matches the drmIoctl restart behavior of libdrm.
+  int drmIoctl(int fd, unsigned long request, void *arg) {
+    int ret;
+
+    do {
+      ret = ioctl(fd, request, arg);
+    } while (ret == -1 && (errno == EINTR || errno == EAGAIN));
+    return ret;
+  }
+
+  int drmCommandNone(int fd, unsigned long drmCommandIndex) {
+    unsigned long request = DRM_IO(DRM_COMMAND_BASE + drmCommandIndex);
+
+    if (drmIoctl(fd, request, nullptr)) {
+      return -errno;
+    }
+    return 0;
+  }
+
+  int drmCommandRead(int fd, unsigned long drmCommandIndex, void *data, unsigned long size) {
+    unsigned long request = _IOC(_IOC_READ, DRM_IOCTL_BASE, DRM_COMMAND_BASE + drmCommandIndex, size);
+
+    if (drmIoctl(fd, request, data)) {
+      return -errno;
+    }
+    return 0;
+  }
+
+  int drmCommandWrite(int fd, unsigned long drmCommandIndex, void *data, unsigned long size) {
+    unsigned long request = _IOC(_IOC_WRITE, DRM_IOCTL_BASE, DRM_COMMAND_BASE + drmCommandIndex, size);
+
+    if (drmIoctl(fd, request, data)) {
+      return -errno;
+    }
+    return 0;
+  }
+
+  int drmCommandWriteRead(int fd, unsigned long drmCommandIndex, void *data, unsigned long size) {
+    unsigned long request = _IOC(_IOC_READ | _IOC_WRITE, DRM_IOCTL_BASE, DRM_COMMAND_BASE + drmCommandIndex, size);
+
+    if (drmIoctl(fd, request, data)) {
+      return -errno;
+    }
+    return 0;
+  }
+
   void drmMsg(const char *format,...){
     va_list ap;
     if (1) {
@@ -27,7 +27,11 @@ void FEX_free_on_host(void*);
 
 template<> struct fex_gen_config<FEX_usable_size> : fexgen::custom_host_impl, fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<FEX_free_on_host> : fexgen::custom_host_impl, fexgen::custom_guest_entrypoint {};
-template<> struct fex_gen_config<drmIoctl> {};
+// drmIoctl and the drmCommand* wrappers are implemented guest-side in
+// Guest.cpp. Command submission is one ioctl per call no matter who issues
+// it, and the guest's own ioctl path already carries the DRM compat
+// translation for 32-bit processes, so crossing into host libdrm here only
+// added a thunk round trip per submission.
 template<> struct fex_gen_config<drmGetHashTable> {};
 template<> struct fex_gen_config<drmGetEntry> {};
 template<> struct fex_gen_config<drmAvailable> {};
@@ -47,10 +51,6 @@ template<> struct fex_gen_config<drmGetMap> {};
 template<> struct fex_gen_config<drmGetClient> {};
 template<> struct fex_gen_config<drmGetStats> {};
 template<> struct fex_gen_config<drmSetInterfaceVersion> {};
-template<> struct fex_gen_config<drmCommandNone> {};
-template<> struct fex_gen_config<drmCommandRead> {};
-template<> struct fex_gen_config<drmCommandWrite> {};
-template<> struct fex_gen_config<drmCommandWriteRead> {};
 template<> struct fex_gen_config<drmFreeBusid> {};
 template<> struct fex_gen_config<drmSetBusid> {};
 template<> struct fex_gen_config<drmAuthMagic> {};
@@ -5,41 +5,114 @@ desc: Handles allocations between guest and host thunks
 $end_info$
 */
 
-#include <cstring>
-#include <map>
-#include <string>
+#include <cstddef>
 
 #include "common/Guest.h"
-#include <stdarg.h>
 
 #include "Types.h"
 
-#include "thunkgen_guest_libfex_malloc.inl"
-
-#include <vector>
+// Thunks and packing glue are written by hand here. The generated loader init
+// would try to dlopen a native library of the same name, but the host side of
+// this library implements every entry point itself.
+MAKE_THUNK(libfex_malloc, malloc, "0x2d, 0x2d, 0x30, 0xb4, 0x83, 0xdd, 0x8d, 0xe8, 0x89, 0x26, 0x38, 0x7a, 0x93, 0x43, 0x2e, 0x8f, 0x79, 0x86, 0x2a, 0x93, 0x72, 0x19, 0x97, 0x25, 0x53, 0x84, 0x50, 0x7e, 0xbc, 0xf3, 0xbf, 0xd5")
+MAKE_THUNK(libfex_malloc, free, "0x0e, 0x26, 0x73, 0x37, 0x56, 0xf0, 0x69, 0xae, 0xe0, 0xd1, 0x21, 0xf4, 0x76, 0xd3, 0x11, 0xf3, 0x96, 0xd3, 0x81, 0x22, 0x4e, 0xab, 0x66, 0x2f, 0xa5, 0xac, 0x14, 0x5a, 0x54, 0x37, 0x5c, 0xd9")
+MAKE_THUNK(libfex_malloc, calloc, "0xc1, 0xc7, 0x79, 0xf1, 0x15, 0xd6, 0xc6, 0x8c, 0xe0, 0x38, 0x46, 0xdb, 0xa2, 0x7e, 0xbc, 0x9a, 0xc8, 0xe0, 0x90, 0xf6, 0x11, 0xe1, 0xd2, 0x4d, 0x3b, 0xb5, 0x8e, 0x9d, 0x19, 0xff, 0x8a, 0x66")
+MAKE_THUNK(libfex_malloc, memalign, "0xa8, 0xf7, 0x6d, 0xff, 0xd0, 0x89, 0x31, 0x57, 0x9f, 0x65, 0x04, 0xee, 0xd3, 0x9b, 0x3c, 0x92, 0xb4, 0x81, 0x88, 0x03, 0xf9, 0x41, 0x9b, 0x97, 0x0f, 0x44, 0x81, 0x27, 0x94, 0xeb, 0xd4, 0xb4")
+MAKE_THUNK(libfex_malloc, realloc, "0x5e, 0x9e, 0xbe, 0x3a, 0x22, 0xc0, 0x9f, 0xbf, 0x8d, 0xdd, 0xd0, 0xb0, 0x49, 0x13, 0x3f, 0x10, 0xf4, 0xe5, 0x19, 0x1f, 0xb6, 0x62, 0xeb, 0xb9, 0x78, 0x77, 0xa2, 0x6f, 0xc0, 0x50, 0xbe, 0x86")
+MAKE_THUNK(libfex_malloc, valloc, "0x10, 0xcd, 0x28, 0x6e, 0x7f, 0x4b, 0xa4, 0x0b, 0x69, 0x03, 0xf3, 0x26, 0x53, 0xf0, 0x27, 0xa3, 0x81, 0x67, 0x28, 0x6b, 0xca, 0xfa, 0xa2, 0xf1, 0xe5, 0x0e, 0xb3, 0x8d, 0xe0, 0x5b, 0xd6, 0x49")
+MAKE_THUNK(libfex_malloc, posix_memalign, "0x16, 0x5d, 0x3e, 0x34, 0xd3, 0x1d, 0x84, 0x7a, 0x22, 0xd8, 0x51, 0x61, 0xb2, 0xe1, 0xc6, 0x3f, 0xe0, 0x12, 0xea, 0x83, 0x73, 0xfe, 0x66, 0x60, 0x55, 0x87, 0xd2, 0x45, 0x6b, 0x84, 0x55, 0x8d")
+MAKE_THUNK(libfex_malloc, aligned_alloc, "0x22, 0xbb, 0xcf, 0xdc, 0x27, 0x35, 0x69, 0x39, 0xaf, 0xa4, 0xc4, 0x09, 0x64, 0xc2, 0x96, 0xfc, 0x1a, 0xfa, 0x6c, 0x4f, 0x6b, 0x5e, 0xe8, 0x08, 0x01, 0x91, 0x68, 0x88, 0x3f, 0x6f, 0x42, 0x57")
+MAKE_THUNK(libfex_malloc, malloc_usable_size, "0x27, 0xe6, 0x6d, 0xe5, 0x2e, 0x9e, 0x8e, 0xd3, 0x3a, 0xa4, 0xb6, 0xdc, 0x26, 0xb4, 0x68, 0xc6, 0x73, 0x3a, 0x7a, 0x67, 0x08, 0x7a, 0xba, 0x28, 0x5f, 0x0c, 0xf3, 0x88, 0x24, 0xfb, 0xd7, 0xdd")
+MAKE_THUNK(libfex_malloc, fex_get_allocation_ptrs, "0x6f, 0x73, 0x76, 0x64, 0x56, 0x2e, 0xac, 0xcd, 0x65, 0x9b, 0xcd, 0x42, 0x75, 0x85, 0xbc, 0x63, 0x1e, 0x7d, 0x2b, 0x22, 0x0e, 0x19, 0xcf, 0xe5, 0xed, 0xff, 0xdf, 0x3b, 0x28, 0xf1, 0xc6, 0x06")
 
 extern "C" {
   void fex_malloc_NoOptimize() {
     // Does nothing, just ensures our libraries pull it in
   }
 
+FEX_PACKFN_LINKAGE void *fexfn_pack_malloc(size_t size) {
+  struct {size_t a_0;void * rv;} args = {size};
+  fexthunks_libfex_malloc_malloc(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE void fexfn_pack_free(void *ptr) {
+  struct {void* a_0;} args = {ptr};
+  fexthunks_libfex_malloc_free(&args);
+}
+
+FEX_PACKFN_LINKAGE void *fexfn_pack_calloc(size_t n, size_t size) {
+  struct {size_t a_0;size_t a_1;void * rv;} args = {n, size};
+  fexthunks_libfex_malloc_calloc(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE void *fexfn_pack_memalign(size_t align, size_t s) {
+  struct {size_t a_0;size_t a_1;void * rv;} args = {align, s};
+  fexthunks_libfex_malloc_memalign(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE void *fexfn_pack_realloc(void *ptr, size_t size) {
+  struct {void* a_0;size_t a_1;void * rv;} args = {ptr, size};
+  fexthunks_libfex_malloc_realloc(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE void *fexfn_pack_valloc(size_t size) {
+  struct {size_t a_0;void * rv;} args = {size};
+  fexthunks_libfex_malloc_valloc(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE int fexfn_pack_posix_memalign(void **r, size_t a, size_t s) {
+  struct {void** a_0;size_t a_1;size_t a_2;int rv;} args = {r, a, s};
+  fexthunks_libfex_malloc_posix_memalign(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE void *fexfn_pack_aligned_alloc(size_t a, size_t s) {
+  struct {size_t a_0;size_t a_1;void * rv;} args = {a, s};
+  fexthunks_libfex_malloc_aligned_alloc(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE size_t fexfn_pack_malloc_usable_size(void *ptr) {
+  struct {void * a_0;size_t rv;} args = {ptr};
+  fexthunks_libfex_malloc_malloc_usable_size(&args);
+  return args.rv;
+}
+
+FEX_PACKFN_LINKAGE void fexfn_pack_fex_get_allocation_ptrs(AllocationPtrs *Ptrs) {
+  struct {AllocationPtrs * a_0;} args = {Ptrs};
+  fexthunks_libfex_malloc_fex_get_allocation_ptrs(&args);
+}
+
 #    define ALIAS(fn)	__attribute__((alias (#fn), used))
 #    define PREALIAS(fn)	ALIAS(fn)
 
-
 void *__libc_calloc(size_t n, size_t size) PREALIAS(fexfn_pack_calloc);
+void *calloc(size_t n, size_t size) PREALIAS(fexfn_pack_calloc);
 
 void __libc_free(void* ptr) PREALIAS(fexfn_pack_free);
+void free(void* ptr) PREALIAS(fexfn_pack_free);
 
 void *__libc_malloc(size_t size) PREALIAS(fexfn_pack_malloc);
+void *malloc(size_t size) PREALIAS(fexfn_pack_malloc);
 
 void *__libc_memalign(size_t align, size_t s) PREALIAS(fexfn_pack_memalign);
+void *memalign(size_t align, size_t s) PREALIAS(fexfn_pack_memalign);
 
 void *__libc_realloc(void* ptr, size_t size) PREALIAS(fexfn_pack_realloc);
+void *realloc(void* ptr, size_t size) PREALIAS(fexfn_pack_realloc);
 
 void *__libc_valloc(size_t size) PREALIAS(fexfn_pack_valloc);
+void *valloc(size_t size) PREALIAS(fexfn_pack_valloc);
 
 int __posix_memalign(void** r, size_t a, size_t s) PREALIAS(fexfn_pack_posix_memalign);
+int posix_memalign(void** r, size_t a, size_t s) PREALIAS(fexfn_pack_posix_memalign);
+
+void *aligned_alloc(size_t a, size_t s) PREALIAS(fexfn_pack_aligned_alloc);
 
 // If we replace libc malloc and an application calls the malloc_usable_size then we can get a crash
 // Symbol doesn't alias exactly so just wrap it
@@ -47,6 +120,9 @@ int __posix_memalign(void** r, size_t a, size_t s) PREALIAS(fexfn_pack_posix_mem
 size_t __malloc_usable_size(void *ptr) {
   return fexfn_pack_malloc_usable_size(ptr);
 }
+size_t malloc_usable_size(void *ptr) {
+  return fexfn_pack_malloc_usable_size(ptr);
+}
 }
 
 LOAD_LIB(libfex_malloc)
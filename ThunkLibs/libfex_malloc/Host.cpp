@@ -5,108 +5,264 @@ desc: Handles allocations between guest and host thunks
 $end_info$
 */
 
+#include <array>
+#include <cerrno>
+#include <cstdint>
 #include <cstring>
-#include <cstdlib>
-#include <stdio.h>
-#include <memory.h>
+#include <mutex>
+
+#include <sys/mman.h>
+#include <sys/types.h>
 
 #include "common/Host.h"
-#include <dlfcn.h>
 
 #include "Types.h"
 
-#include "thunkgen_host_libfex_malloc.inl"
-
-void fexfn_impl_libfex_malloc_fex_get_allocation_ptrs(AllocationPtrs *Ptrs);
+// Imported from the FEX executable, following the same weak-import scheme as
+// the trampoline helpers in common/Host.h.
+//
+// Memory mapped through these hooks comes from the emulator's own VA
+// allocator: it is guest-addressable, but it never passes through the guest
+// mmap syscall path. Servicing a guest allocation from here therefore skips
+// the guest's VMA tracking and all of its emulated allocator metadata work.
+namespace FEXCore::Allocator {
+  using MMAP_Hook = void *(*)(void*, size_t, int, int, int, off_t);
+  using MUNMAP_Hook = int (*)(void*, size_t);
 
-extern "C" {
-  // FEX allocation routines
-  extern MallocPtr FEX_Malloc_Ptr;
-  extern FreePtr FEX_Free_Ptr;
-  extern CallocPtr FEX_Calloc_Ptr;
-  extern MemalignPtr FEX_Memalign_Ptr;
-  extern ReallocPtr FEX_Realloc_Ptr;
-  extern VallocPtr FEX_Valloc_Ptr;
-  extern PosixMemalignPtr FEX_PosixMemalign_Ptr;
-  extern AlignedAllocPtr FEX_AlignedAlloc_Ptr;
-  extern MallocUsablePtr FEX_MallocUsable_Ptr;
+  __attribute__((weak)) extern MMAP_Hook mmap;
+  __attribute__((weak)) extern MUNMAP_Hook munmap;
 }
 
-extern "C" {
-  AllocationPtrs AllocationPointers {
-    .Malloc = FEX_Malloc_Ptr,
-    .Free = FEX_Free_Ptr,
-    .Calloc = FEX_Calloc_Ptr,
-    .Memalign = FEX_Memalign_Ptr,
-    .Realloc = FEX_Realloc_Ptr,
-    .Valloc = FEX_Valloc_Ptr,
-    .PosixMemalign = FEX_PosixMemalign_Ptr,
-    .AlignedAlloc = FEX_AlignedAlloc_Ptr,
-    .MallocUsable = FEX_MallocUsable_Ptr,
+namespace {
+  // Sized-class arena backing guest allocations with host memory.
+  //
+  // Every allocation is preceded by a small header so free and
+  // malloc_usable_size work without any global lookup structure. Small
+  // requests are carved from per-class slabs and recycled through per-class
+  // free lists, so the steady state never enters the kernel at all.
+  // Everything else gets its own mapping.
+
+  struct AllocationHeader {
+    uint64_t ClassIndex; // Size class index, or LARGE_ALLOCATION
+    uint64_t UsableSize;
+  };
+  static_assert(sizeof(AllocationHeader) == 16, "Header must preserve minimum alignment");
+
+  // Large allocations additionally remember their backing mapping directly in
+  // front of the common header.
+  struct LargeHeader {
+    void *MapBase;
+    uint64_t MapSize;
+    AllocationHeader Common;
   };
 
-  // Our allocators
-#    define ALIAS(fn)	__attribute__((alias (#fn), used))
-#    define PREALIAS(fn)	ALIAS(fn)
+  constexpr uint64_t LARGE_ALLOCATION = ~0ULL;
+  constexpr size_t MINIMUM_ALIGNMENT = 16;
+  constexpr size_t ARENA_PAGE_SIZE = 4096;
+  constexpr size_t SLAB_SIZE = 256 * 1024;
+
+  // All multiples of 16 so slots stay aligned with the header in front.
+  constexpr std::array<size_t, 14> SizeClasses = {{
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048,
+  }};
+
+  struct FreeSlot {
+    FreeSlot *Next;
+  };
+
+  struct SizeClassBin {
+    std::mutex Lock;
+    FreeSlot *FreeList{};
+    uint8_t *SlabCursor{};
+    size_t SlabRemaining{};
+  };
+
+  std::array<SizeClassBin, SizeClasses.size()> Bins{};
+
+  void *MapPages(size_t Size) {
+    void *Ptr = FEXCore::Allocator::mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Ptr == MAP_FAILED) {
+      return nullptr;
+    }
+    return Ptr;
+  }
+
+  void *AllocateSmall(size_t ClassIndex) {
+    auto &Bin = Bins[ClassIndex];
+    const size_t SlotSize = sizeof(AllocationHeader) + SizeClasses[ClassIndex];
+
+    uint8_t *Slot{};
+    {
+      std::lock_guard lk {Bin.Lock};
+      if (Bin.FreeList) {
+        Slot = reinterpret_cast<uint8_t*>(Bin.FreeList);
+        Bin.FreeList = Bin.FreeList->Next;
+      }
+      else {
+        if (Bin.SlabRemaining < SlotSize) {
+          // Freed slots go back on the free list rather than to the kernel, so
+          // abandoning a slab tail smaller than one slot leaks nothing long-term.
+          uint8_t *Slab = static_cast<uint8_t*>(MapPages(SLAB_SIZE));
+          if (!Slab) {
+            errno = ENOMEM;
+            return nullptr;
+          }
+          Bin.SlabCursor = Slab;
+          Bin.SlabRemaining = SLAB_SIZE;
+        }
+        Slot = Bin.SlabCursor;
+        Bin.SlabCursor += SlotSize;
+        Bin.SlabRemaining -= SlotSize;
+      }
+    }
 
-  void *fex_malloc(size_t Size) {
-    return AllocationPointers.Malloc(Size);
+    auto *Header = reinterpret_cast<AllocationHeader*>(Slot);
+    Header->ClassIndex = ClassIndex;
+    Header->UsableSize = SizeClasses[ClassIndex];
+    return Slot + sizeof(AllocationHeader);
   }
-  void *__libc_malloc (size_t Size) __attribute__((alias ("fex_malloc"), used));
-  void *malloc (size_t Size) __attribute__((alias ("fex_malloc"), used));
 
-  void fex_free(void *p) {
-    AllocationPointers.Free(p);
+  void *AllocateLarge(size_t Alignment, size_t Size) {
+    const size_t MapSize = (sizeof(LargeHeader) + Alignment + Size + ARENA_PAGE_SIZE - 1) & ~(ARENA_PAGE_SIZE - 1);
+    uint8_t *Base = static_cast<uint8_t*>(MapPages(MapSize));
+    if (!Base) {
+      errno = ENOMEM;
+      return nullptr;
+    }
+
+    // Aligning up past the header always leaves the full LargeHeader inside
+    // the mapping since Alignment is at least MINIMUM_ALIGNMENT.
+    uint8_t *Ptr = reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(Base) + sizeof(LargeHeader) + Alignment - 1) & ~(Alignment - 1));
+    auto *Header = reinterpret_cast<LargeHeader*>(Ptr - sizeof(LargeHeader));
+    Header->MapBase = Base;
+    Header->MapSize = MapSize;
+    Header->Common.ClassIndex = LARGE_ALLOCATION;
+    Header->Common.UsableSize = static_cast<uint64_t>(Base + MapSize - Ptr);
+    return Ptr;
   }
-  void __libc_free(void* ptr) PREALIAS(fex_free);
-  void __GI___libc_free(void* ptr) PREALIAS(fex_free);
-  void free(void* ptr) PREALIAS(fex_free);
 
-  void *fex_calloc(size_t n, size_t size) {
-    return AllocationPointers.Calloc(n, size);
+  void *Arena_Malloc(size_t Size) {
+    if (Size == 0) {
+      // Zero-size requests still return a unique pointer, matching glibc.
+      Size = 1;
+    }
+    for (size_t i = 0; i < SizeClasses.size(); ++i) {
+      if (Size <= SizeClasses[i]) {
+        return AllocateSmall(i);
+      }
+    }
+    return AllocateLarge(MINIMUM_ALIGNMENT, Size);
   }
-  void *__libc_calloc(size_t n, size_t size) PREALIAS(fex_calloc);
-  void *calloc(size_t n, size_t size) PREALIAS(fex_calloc);
 
-  void *fex_memalign(size_t align, size_t s) {
-    return AllocationPointers.Memalign(align, s);
+  void Arena_Free(void *Ptr) {
+    if (!Ptr) {
+      return;
+    }
+    auto *Header = reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(Ptr) - sizeof(AllocationHeader));
+    if (Header->ClassIndex == LARGE_ALLOCATION) {
+      auto *Large = reinterpret_cast<LargeHeader*>(static_cast<uint8_t*>(Ptr) - sizeof(LargeHeader));
+      FEXCore::Allocator::munmap(Large->MapBase, Large->MapSize);
+      return;
+    }
+
+    auto &Bin = Bins[Header->ClassIndex];
+    auto *Slot = reinterpret_cast<FreeSlot*>(Header);
+    std::lock_guard lk {Bin.Lock};
+    Slot->Next = Bin.FreeList;
+    Bin.FreeList = Slot;
   }
-  void *__libc_memalign(size_t align, size_t s) PREALIAS(fex_memalign);
-  void *memalign(size_t align, size_t s) PREALIAS(fex_memalign);
 
-  void *fex_realloc(void* ptr, size_t size) {
-    return AllocationPointers.Realloc(ptr, size);
+  size_t Arena_MallocUsableSize(void *Ptr) {
+    if (!Ptr) {
+      return 0;
+    }
+    return reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(Ptr) - sizeof(AllocationHeader))->UsableSize;
   }
-  void *__libc_realloc(void* ptr, size_t size) PREALIAS(fex_realloc);
-  void *realloc(void* ptr, size_t size) PREALIAS(fex_realloc);
 
-  void *fex_valloc(size_t size) {
-    return AllocationPointers.Valloc(size);
+  void *Arena_Memalign(size_t Alignment, size_t Size) {
+    if (Alignment & (Alignment - 1)) {
+      errno = EINVAL;
+      return nullptr;
+    }
+    if (Alignment <= MINIMUM_ALIGNMENT) {
+      return Arena_Malloc(Size);
+    }
+    return AllocateLarge(Alignment, Size ? Size : 1);
   }
-  void *__libc_valloc(size_t size) PREALIAS(fex_valloc);
-  void *valloc(size_t size) PREALIAS(fex_valloc);
 
-  int fex_posix_memalign(void** r, size_t a, size_t s) {
-    return AllocationPointers.PosixMemalign(r, a, s);
+  void *Arena_Calloc(size_t Count, size_t Size) {
+    if (Size && Count > SIZE_MAX / Size) {
+      errno = ENOMEM;
+      return nullptr;
+    }
+    const size_t Total = Count * Size;
+    void *Ptr = Arena_Malloc(Total);
+    if (Ptr) {
+      // Recycled small slots aren't scrubbed on free, clear unconditionally.
+      memset(Ptr, 0, Total);
+    }
+    return Ptr;
   }
-  int __posix_memalign(void** r, size_t a, size_t s) PREALIAS(fex_posix_memalign);
-  int posix_memalign(void** r, size_t a, size_t s) PREALIAS(fex_posix_memalign);
 
-  void *fex_aligned_alloc(size_t a, size_t s) {
-    return AllocationPointers.AlignedAlloc(a, s);
+  void *Arena_Realloc(void *Ptr, size_t Size) {
+    if (!Ptr) {
+      return Arena_Malloc(Size);
+    }
+    if (Size == 0) {
+      Arena_Free(Ptr);
+      return nullptr;
+    }
+
+    auto *Header = reinterpret_cast<AllocationHeader*>(static_cast<uint8_t*>(Ptr) - sizeof(AllocationHeader));
+    if (Size <= Header->UsableSize) {
+      return Ptr;
+    }
+
+    void *NewPtr = Arena_Malloc(Size);
+    if (!NewPtr) {
+      return nullptr;
+    }
+    memcpy(NewPtr, Ptr, Header->UsableSize);
+    Arena_Free(Ptr);
+    return NewPtr;
   }
-  void *aligned_alloc(size_t a, size_t s) PREALIAS(fex_aligned_alloc);
 
-  size_t fex_malloc_usable_size(void *ptr) {
-    return AllocationPointers.MallocUsable(ptr);
+  void *Arena_Valloc(size_t Size) {
+    return Arena_Memalign(ARENA_PAGE_SIZE, Size);
   }
 
-  size_t __malloc_usable_size(void *ptr) {
-    return fex_malloc_usable_size(ptr);
+  int Arena_PosixMemalign(void **Result, size_t Alignment, size_t Size) {
+    if ((Alignment & (Alignment - 1)) || Alignment < sizeof(void*)) {
+      return EINVAL;
+    }
+    void *Ptr = Arena_Memalign(Alignment, Size);
+    if (!Ptr) {
+      return ENOMEM;
+    }
+    *Result = Ptr;
+    return 0;
   }
-  size_t malloc_usable_size(void *ptr) {
-    return fex_malloc_usable_size(ptr);
+
+  void *Arena_AlignedAlloc(size_t Alignment, size_t Size) {
+    return Arena_Memalign(Alignment, Size);
   }
+}
+
+void fexfn_impl_libfex_malloc_fex_get_allocation_ptrs(AllocationPtrs *Ptrs);
+
+extern "C" {
+  AllocationPtrs AllocationPointers {
+    .Malloc = Arena_Malloc,
+    .Free = Arena_Free,
+    .Calloc = Arena_Calloc,
+    .Memalign = Arena_Memalign,
+    .Realloc = Arena_Realloc,
+    .Valloc = Arena_Valloc,
+    .PosixMemalign = Arena_PosixMemalign,
+    .AlignedAlloc = Arena_AlignedAlloc,
+    .MallocUsable = Arena_MallocUsableSize,
+  };
 
   static void fexfn_unpack_libfex_malloc_malloc(void *argsv) {
     struct arg_t {size_t a_0;void * rv;};
@@ -173,30 +329,36 @@ extern "C" {
       AllocationPointers.MallocUsable
       (args->a_0);
   }
+  static void fexfn_unpack_libfex_malloc_fex_get_allocation_ptrs(void *argsv){
+    struct arg_t {AllocationPtrs * a_0;};
+    auto args = (arg_t*)argsv;
 
-void (*__free_hook)(void *ptr) = fex_free;
-void *(*__malloc_hook)(size_t size) = fex_malloc;
-void *(*__realloc_hook)(void *ptr, size_t size) = fex_realloc;
-void *(*__memalign_hook)(size_t alignment, size_t size) =
-    fex_memalign;
+    fexfn_impl_libfex_malloc_fex_get_allocation_ptrs(args->a_0);
+  }
 }
 
 void fexfn_impl_libfex_malloc_fex_get_allocation_ptrs(AllocationPtrs *Ptrs) {
   *Ptrs = AllocationPointers;
 }
 
-static void init_lib() {
-  // Set pointers
-  AllocationPointers.Malloc = FEX_Malloc_Ptr;
-  AllocationPointers.Free = FEX_Free_Ptr;
-  AllocationPointers.Calloc = FEX_Calloc_Ptr;
-  AllocationPointers.Memalign = FEX_Memalign_Ptr;
-  AllocationPointers.Realloc = FEX_Realloc_Ptr;
-  AllocationPointers.Valloc = FEX_Valloc_Ptr;
-  AllocationPointers.PosixMemalign = FEX_PosixMemalign_Ptr;
-  AllocationPointers.AlignedAlloc = FEX_AlignedAlloc_Ptr;
-  AllocationPointers.MallocUsable = FEX_MallocUsable_Ptr;
+static ExportEntry exports[] = {
+  {(uint8_t*)"\x2d\x2d\x30\xb4\x83\xdd\x8d\xe8\x89\x26\x38\x7a\x93\x43\x2e\x8f\x79\x86\x2a\x93\x72\x19\x97\x25\x53\x84\x50\x7e\xbc\xf3\xbf\xd5", &fexfn_unpack_libfex_malloc_malloc}, // malloc
+  {(uint8_t*)"\x0e\x26\x73\x37\x56\xf0\x69\xae\xe0\xd1\x21\xf4\x76\xd3\x11\xf3\x96\xd3\x81\x22\x4e\xab\x66\x2f\xa5\xac\x14\x5a\x54\x37\x5c\xd9", &fexfn_unpack_libfex_malloc_free}, // free
+  {(uint8_t*)"\xc1\xc7\x79\xf1\x15\xd6\xc6\x8c\xe0\x38\x46\xdb\xa2\x7e\xbc\x9a\xc8\xe0\x90\xf6\x11\xe1\xd2\x4d\x3b\xb5\x8e\x9d\x19\xff\x8a\x66", &fexfn_unpack_libfex_malloc_calloc}, // calloc
+  {(uint8_t*)"\xa8\xf7\x6d\xff\xd0\x89\x31\x57\x9f\x65\x04\xee\xd3\x9b\x3c\x92\xb4\x81\x88\x03\xf9\x41\x9b\x97\x0f\x44\x81\x27\x94\xeb\xd4\xb4", &fexfn_unpack_libfex_malloc_memalign}, // memalign
+  {(uint8_t*)"\x5e\x9e\xbe\x3a\x22\xc0\x9f\xbf\x8d\xdd\xd0\xb0\x49\x13\x3f\x10\xf4\xe5\x19\x1f\xb6\x62\xeb\xb9\x78\x77\xa2\x6f\xc0\x50\xbe\x86", &fexfn_unpack_libfex_malloc_realloc}, // realloc
+  {(uint8_t*)"\x10\xcd\x28\x6e\x7f\x4b\xa4\x0b\x69\x03\xf3\x26\x53\xf0\x27\xa3\x81\x67\x28\x6b\xca\xfa\xa2\xf1\xe5\x0e\xb3\x8d\xe0\x5b\xd6\x49", &fexfn_unpack_libfex_malloc_valloc}, // valloc
+  {(uint8_t*)"\x16\x5d\x3e\x34\xd3\x1d\x84\x7a\x22\xd8\x51\x61\xb2\xe1\xc6\x3f\xe0\x12\xea\x83\x73\xfe\x66\x60\x55\x87\xd2\x45\x6b\x84\x55\x8d", &fexfn_unpack_libfex_malloc_posix_memalign}, // posix_memalign
+  {(uint8_t*)"\x22\xbb\xcf\xdc\x27\x35\x69\x39\xaf\xa4\xc4\x09\x64\xc2\x96\xfc\x1a\xfa\x6c\x4f\x6b\x5e\xe8\x08\x01\x91\x68\x88\x3f\x6f\x42\x57", &fexfn_unpack_libfex_malloc_aligned_alloc}, // aligned_alloc
+  {(uint8_t*)"\x27\xe6\x6d\xe5\x2e\x9e\x8e\xd3\x3a\xa4\xb6\xdc\x26\xb4\x68\xc6\x73\x3a\x7a\x67\x08\x7a\xba\x28\x5f\x0c\xf3\x88\x24\xfb\xd7\xdd", &fexfn_unpack_libfex_malloc_malloc_usable_size}, // malloc_usable_size
+  {(uint8_t*)"\x6f\x73\x76\x64\x56\x2e\xac\xcd\x65\x9b\xcd\x42\x75\x85\xbc\x63\x1e\x7d\x2b\x22\x0e\x19\xcf\xe5\xed\xff\xdf\x3b\x28\xf1\xc6\x06", &fexfn_unpack_libfex_malloc_fex_get_allocation_ptrs}, // fex_get_allocation_ptrs
+  { nullptr, nullptr }
+};
+
+// The arena above services every entry point itself, there is no native host
+// library to load.
+extern "C" bool fexldr_init_libfex_malloc() {
+  return true;
 }
 
 EXPORTS(libfex_malloc)
-LOAD_LIB_INIT(init_lib)
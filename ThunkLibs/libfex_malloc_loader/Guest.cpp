@@ -5,13 +5,13 @@ desc: Delays malloc symbol replacement until it is safe to run constructors
 $end_info$
 */
 
-#include <stdio.h>
 #include <dlfcn.h>
 extern "C" {
   __attribute__((constructor))
   static void loadlib()
   {
-    fprintf(stderr, "Time to load mallocs\n");
-    dlopen("/mnt/Work/Work/work/FEXNew/Build/Guest/libfex_malloc-guest.so", RTLD_GLOBAL | RTLD_NOW | RTLD_NODELETE | RTLD_DEEPBIND);
+    // Resolved through the thunk overlay for libfex_malloc, which redirects
+    // the open to the guest thunk library.
+    dlopen("libfex_malloc.so", RTLD_GLOBAL | RTLD_NOW | RTLD_NODELETE | RTLD_DEEPBIND);
   }
 }
@@ -31,14 +31,21 @@ extern "C" const wl_interface wl_callback_interface {};
 #include <charconv>
 #include <cstdio>
 #include <cstdarg>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "common/Guest.h"
 
 #include "thunkgen_guest_libwayland-client.inl"
 
+#include "WaylandEventBatch.h"
+#include "WaylandRequestBatch.h"
+
 struct wl_proxy_private {
   wl_interface* interface;
   // Other data members omitted
@@ -55,12 +62,153 @@ template<> struct ArgType<'a'> { using type = wl_array*; };
 template<> struct ArgType<'f'> { using type = wl_fixed_t; };
 template<> struct ArgType<'h'> { using type = int32_t; }; // fd?
 
+// Batched event delivery (see WaylandEventBatch.h). Opt-in via the
+// FEX_WAYLAND_EVENT_BATCHING environment variable since it slightly changes
+// delivery timing: batched callbacks run after the host-side dispatch call
+// returns instead of interleaved with it.
+static bool batch_events_enabled = false;
+
+struct batch_listener_entry {
+  void (*invoke)(void (*callback)(), fex_wl_event_record& record);
+  void (*callback)();
+};
+
+// Original guest listener callbacks for batched delivery, keyed like
+// proxy_listeners below. Guarded by a mutex since listeners may be registered
+// and events dispatched on different threads.
+static std::mutex batch_listener_mutex;
+static std::unordered_map<wl_proxy*, std::array<batch_listener_entry, FEX_WL_MAX_INTERFACE_EVENTS>> proxy_batch_listeners;
+
+// Wayland dispatches each queue on the thread that polls it, so every
+// dispatching thread registers its own batch with the host.
+static thread_local std::unique_ptr<fex_wl_event_batch> thread_event_batch;
+
+static void fex_wl_setup_thread_event_batch();
+static void fex_wl_drain_event_batch();
+
+template<char Type> static typename ArgType<Type>::type UnpackEventArg(uint64_t arg);
+template<> const char* UnpackEventArg<'s'>(uint64_t arg) { return reinterpret_cast<const char*>(arg); }
+template<> uint32_t UnpackEventArg<'u'>(uint64_t arg) { return static_cast<uint32_t>(arg); }
+template<> int32_t UnpackEventArg<'i'>(uint64_t arg) { return static_cast<int32_t>(arg); }
+template<> wl_proxy* UnpackEventArg<'o'>(uint64_t arg) { return reinterpret_cast<wl_proxy*>(arg); }
+template<> wl_proxy* UnpackEventArg<'n'>(uint64_t arg) { return reinterpret_cast<wl_proxy*>(arg); }
+template<> wl_array* UnpackEventArg<'a'>(uint64_t arg) { return reinterpret_cast<wl_array*>(arg); }
+template<> wl_fixed_t UnpackEventArg<'f'>(uint64_t arg) { return static_cast<wl_fixed_t>(arg); }
+template<> int32_t UnpackEventArg<'h'>(uint64_t arg) { return static_cast<int32_t>(arg); }
+
+template<char... Signature, size_t... ArgIndex>
+static void InvokeBatchedEventImpl(void (*callback)(), fex_wl_event_record& record, std::index_sequence<ArgIndex...>) {
+  using cb = void(void*, wl_proxy*, typename ArgType<Signature>::type...);
+  reinterpret_cast<cb*>(callback)(record.data, record.proxy, UnpackEventArg<Signature>(record.args[ArgIndex])...);
+}
+
 template<char... Signature>
-static void* WaylandAllocateHostTrampolineForGuestListener(void (*callback)()) {
+static void InvokeBatchedEvent(void (*callback)(), fex_wl_event_record& record) {
+  InvokeBatchedEventImpl<Signature...>(callback, record, std::make_index_sequence<sizeof...(Signature)> {});
+}
+
+template<char... Signature>
+static void* WaylandAllocateHostTrampolineForGuestListener(wl_proxy* proxy, int index, void (*callback)()) {
   using cb = void(void*, wl_proxy*, typename ArgType<Signature>::type...);
+  if (batch_events_enabled) {
+    // The host replaces the table entry with its event recorder. Keep the
+    // original callback here and invoke it while draining the batch, no
+    // per-event trampoline is needed.
+    std::lock_guard lock {batch_listener_mutex};
+    auto& entry = proxy_batch_listeners[proxy][index];
+    entry.invoke = InvokeBatchedEvent<Signature...>;
+    entry.callback = callback;
+    return (void*)callback;
+  }
   return (void*)AllocateHostTrampolineForGuestFunction((cb*)callback);
 }
 
+// Coalesced request submission (see WaylandRequestBatch.h). Opt-in via the
+// FEX_WAYLAND_REQUEST_BATCHING environment variable since it reorders
+// batchable wl_surface state requests relative to requests on other proxies:
+// pending state reaches the host in one crossing at commit time.
+static bool request_batching_enabled = false;
+
+// Per-surface pending state requests. Guarded by a mutex since surfaces may
+// be updated from different threads.
+static std::mutex surface_batch_mutex;
+static std::unordered_map<wl_proxy*, fex_wl_request_batch> surface_request_batches;
+
+// Argument count of a batchable wl_surface request, or -1 if the request
+// must cross immediately (destroy, frame, region setters, unknown additions).
+static int fex_wl_batchable_request_args(uint32_t opcode) {
+  switch (opcode) {
+  case FEX_WL_SURFACE_ATTACH: return 3;
+  case FEX_WL_SURFACE_DAMAGE:
+  case FEX_WL_SURFACE_DAMAGE_BUFFER: return 4;
+  case FEX_WL_SURFACE_SET_BUFFER_TRANSFORM:
+  case FEX_WL_SURFACE_SET_BUFFER_SCALE: return 1;
+  case FEX_WL_SURFACE_OFFSET: return 2;
+  default: return -1;
+  }
+}
+
+// Queues a wl_surface state request into the surface's pending batch instead
+// of crossing into the host. Returns false if the request is not batchable
+// and must be forwarded normally.
+static bool fex_wl_try_queue_surface_request(wl_proxy* proxy, uint32_t opcode, wl_argument* args) {
+  if (!request_batching_enabled) {
+    return false;
+  }
+  auto interface = ((wl_proxy_private*)proxy)->interface;
+  if (!interface->name || strcmp(interface->name, "wl_surface") != 0) {
+    return false;
+  }
+
+  std::lock_guard lock {surface_batch_mutex};
+  if (opcode == FEX_WL_SURFACE_COMMIT) {
+    auto it = surface_request_batches.find(proxy);
+    if (it == surface_request_batches.end() || it->second.num_records == 0) {
+      // Nothing pending, let the commit cross on its own
+      return false;
+    }
+    fex_wl_surface_commit_batch(proxy, &it->second, 1);
+    it->second.num_records = 0;
+    return true;
+  }
+
+  auto num_args = fex_wl_batchable_request_args(opcode);
+  auto& batch = surface_request_batches[proxy];
+  if (num_args < 0) {
+    // Pending state must reach the host before a request it may be ordered
+    // against (e.g. a region attached through set_opaque_region)
+    if (batch.num_records) {
+      fex_wl_surface_commit_batch(proxy, &batch, 0);
+      batch.num_records = 0;
+    }
+    return false;
+  }
+
+  if (batch.num_records == FEX_WL_REQUEST_BATCH_CAPACITY) {
+    fex_wl_surface_commit_batch(proxy, &batch, 0);
+    batch.num_records = 0;
+  }
+  auto& record = batch.records[batch.num_records++];
+  record.opcode = opcode;
+  record.num_args = num_args;
+  // wl_argument is 8 bytes on 64-bit, matching the record layout
+  memcpy(record.args, args, num_args * sizeof(record.args[0]));
+  return true;
+}
+
+// Submits every surface's pending state without committing. Proxy destruction
+// runs this so no queued request can reference a proxy the host has already
+// torn down.
+static void fex_wl_flush_all_surface_batches() {
+  std::lock_guard lock {surface_batch_mutex};
+  for (auto& [surface, batch] : surface_request_batches) {
+    if (batch.num_records) {
+      fex_wl_surface_commit_batch(surface, &batch, 0);
+      batch.num_records = 0;
+    }
+  }
+}
+
 #define WL_CLOSURE_MAX_ARGS 20
 
 // Per-proxy list of callbacks set up via wl_proxy_add_listener.
@@ -77,6 +225,9 @@ extern "C" int wl_proxy_add_listener(wl_proxy *proxy,
       void (**callback)(void), void *data) {
   auto interface = ((wl_proxy_private*)proxy)->interface;
 
+  // The host-side handler setup checks for a registered batch on this thread
+  fex_wl_setup_thread_event_batch();
+
   // NOTE: This table must remain valid past the return of this function.
   auto& host_callbacks = proxy_listeners[proxy];
 
@@ -93,97 +244,97 @@ extern "C" int wl_proxy_add_listener(wl_proxy *proxy,
 
     if (signature == "") {
       // E.g. xdg_toplevel::close
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<>(proxy, i, callback[i]);
     } else if (signature == "a") {
       // E.g. xdg_toplevel::wm_capabilities
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'a'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'a'>(proxy, i, callback[i]);
     } else if (signature == "hu") {
       // E.g. zwp_linux_dmabuf_feedback_v1::format_table
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'h', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'h', 'u'>(proxy, i, callback[i]);
     } else if (signature == "i") {
       // E.g. wl_output_listener::scale
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i'>(proxy, i, callback[i]);
     } else if (signature == "if") {
       // E.g. wl_touch_listener::orientation
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'f'>(proxy, i, callback[i]);
     } else if (signature == "iff") {
       // E.g. wl_touch_listener::shape
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'f', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'f', 'f'>(proxy, i, callback[i]);
     } else if (signature == "ii") {
       // E.g. xdg_toplevel::configure_bounds
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'i'>(proxy, i, callback[i]);
     } else if (signature == "iia") {
       // E.g. xdg_toplevel::configure
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'i', 'a'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'i', 'a'>(proxy, i, callback[i]);
     } else if (signature == "iiiiissi") {
       // E.g. wl_output_listener::geometry
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'i', 'i', 'i', 'i', 's', 's', 'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'i', 'i', 'i', 'i', 'i', 's', 's', 'i'>(proxy, i, callback[i]);
     } else if (signature == "n") {
       // E.g. wl_data_device_listener::data_offer
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'n'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'n'>(proxy, i, callback[i]);
     } else if (signature == "o") {
       // E.g. wl_data_device_listener::selection
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'o'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'o'>(proxy, i, callback[i]);
     } else if (signature == "u") {
       // E.g. wl_registry::global_remove
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u'>(proxy, i, callback[i]);
     } else if (signature == "uff") {
       // E.g. wl_pointer_listener::motion
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'f', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'f', 'f'>(proxy, i, callback[i]);
     } else if (signature == "uhu") {
       // E.g. wl_keyboard_listener::keymap
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'h', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'h', 'u'>(proxy, i, callback[i]);
     } else if (signature == "ui") {
       // E.g. wl_pointer_listener::axis_discrete
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'i'>(proxy, i, callback[i]);
     } else if (signature == "uiff") {
       // E.g. wl_touch_listener::motion
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'i', 'f', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'i', 'f', 'f'>(proxy, i, callback[i]);
     } else if (signature == "uiii") {
       // E.g. wl_output_listener::mode
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'i', 'i', 'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'i', 'i', 'i'>(proxy, i, callback[i]);
     } else if (signature == "uo") {
       // E.g. wl_pointer_listener::leave
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o'>(proxy, i, callback[i]);
     } else if (signature == "uoa") {
       // E.g. wl_keyboard_listener::enter
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o', 'a'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o', 'a'>(proxy, i, callback[i]);
     } else if (signature == "uoff") {
       // E.g. wl_pointer_listener::enter
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o', 'f', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o', 'f', 'f'>(proxy, i, callback[i]);
     } else if (signature == "uoffo") {
       // E.g. wl_data_device_listener::enter
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o', 'f', 'f', 'o'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'o', 'f', 'f', 'o'>(proxy, i, callback[i]);
     } else if (signature == "usu") {
       // E.g. wl_registry::global
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 's', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 's', 'u'>(proxy, i, callback[i]);
     } else if (signature == "uu") {
       // E.g. wl_pointer_listener::axis_stop
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u'>(proxy, i, callback[i]);
     } else if (signature == "uuf") {
       // E.g. wl_pointer_listener::axis
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'f'>(proxy, i, callback[i]);
     } else if (signature == "uui") {
       // E.g. wl_touch_listener::up
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'i'>(proxy, i, callback[i]);
     } else if (signature == "uuoiff") {
       // E.g. wl_touch_listener::down
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'o', 'i', 'f', 'f'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'o', 'i', 'f', 'f'>(proxy, i, callback[i]);
     } else if (signature == "uuu") {
       // E.g. zwp_linux_dmabuf_v1::modifier
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'u'>(proxy, i, callback[i]);
     } else if (signature == "uuuu") {
       // E.g. wl_pointer_listener::button
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'u', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'u', 'u'>(proxy, i, callback[i]);
     } else if (signature == "uuuuu") {
       // E.g. wl_keyboard_listener::modifiers
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'u', 'u', 'u'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'u', 'u', 'u', 'u', 'u'>(proxy, i, callback[i]);
     } else if (signature == "s") {
       // E.g. wl_seat::name
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'s'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'s'>(proxy, i, callback[i]);
     } else if (signature == "sii") {
       // E.g. zwp_text_input_v3::preedit_string
-      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'s', 'i', 'i'>(callback[i]);
+      host_callbacks[i] = WaylandAllocateHostTrampolineForGuestListener<'s', 'i', 'i'>(proxy, i, callback[i]);
     } else {
       fprintf(stderr, "Unknown wayland signature descriptor \"%s\" for event \"%s\" in interface \"%s\"\n", signature.data(), interface->events[i].name, interface->name);
       std::abort();
@@ -195,9 +346,111 @@ extern "C" int wl_proxy_add_listener(wl_proxy *proxy,
 
 extern "C" void wl_proxy_destroy(struct wl_proxy *proxy) {
   proxy_listeners.erase(proxy);
+  if (batch_events_enabled) {
+    std::lock_guard lock {batch_listener_mutex};
+    proxy_batch_listeners.erase(proxy);
+  }
+  if (request_batching_enabled) {
+    fex_wl_flush_all_surface_batches();
+    std::lock_guard lock {surface_batch_mutex};
+    surface_request_batches.erase(proxy);
+  }
   return fexfn_pack_wl_proxy_destroy(proxy);
 }
 
+// Registers this thread's event batch with the host before the first
+// dispatching call or listener registration made on it.
+static void fex_wl_setup_thread_event_batch() {
+  if (!batch_events_enabled || thread_event_batch) {
+    return;
+  }
+  thread_event_batch = std::make_unique<fex_wl_event_batch>();
+  // A single host-callable trampoline is shared by every thread, the drain
+  // always operates on the batch of the thread it is called on.
+  static auto drain_trampoline = AllocateHostTrampolineForGuestFunction(fex_wl_drain_event_batch);
+  fex_wl_setup_event_batching(thread_event_batch.get(), drain_trampoline);
+}
+
+// Drains the current thread's event batch. Called at the end of each
+// dispatching entry point, and by the host through the trampoline above when
+// a batch fills up or an event needs immediate delivery.
+static void fex_wl_drain_event_batch() {
+  auto* batch = thread_event_batch.get();
+  if (!batch) {
+    return;
+  }
+
+  // A callback may dispatch re-entrantly (e.g. wl_display_roundtrip), which
+  // consumes the remaining records through the shared cursor before any new
+  // ones are appended behind them.
+  while (batch->drain_cursor < batch->num_records) {
+    auto& record = batch->records[batch->drain_cursor++];
+
+    std::unique_lock lock {batch_listener_mutex};
+    auto it = proxy_batch_listeners.find(record.proxy);
+    if (it == proxy_batch_listeners.end()) {
+      // The proxy was destroyed by an earlier callback in this batch
+      continue;
+    }
+    auto entry = it->second[record.event_index];
+    lock.unlock();
+
+    if (entry.invoke) {
+      entry.invoke(entry.callback, record);
+    }
+  }
+
+  // Every record was consumed, including any that a re-entrant dispatch
+  // appended, so the batch can be reset wholesale.
+  batch->num_records = 0;
+  batch->drain_cursor = 0;
+  batch->arena_used = 0;
+}
+
+// Dispatching entry points drain the event batch after the host call returns
+// so all pending events reach the application before control does.
+extern "C" int wl_display_dispatch(wl_display* display) {
+  fex_wl_setup_thread_event_batch();
+  int ret = fexfn_pack_wl_display_dispatch(display);
+  fex_wl_drain_event_batch();
+  return ret;
+}
+
+extern "C" int wl_display_dispatch_pending(wl_display* display) {
+  fex_wl_setup_thread_event_batch();
+  int ret = fexfn_pack_wl_display_dispatch_pending(display);
+  fex_wl_drain_event_batch();
+  return ret;
+}
+
+extern "C" int wl_display_dispatch_queue(wl_display* display, wl_event_queue* queue) {
+  fex_wl_setup_thread_event_batch();
+  int ret = fexfn_pack_wl_display_dispatch_queue(display, queue);
+  fex_wl_drain_event_batch();
+  return ret;
+}
+
+extern "C" int wl_display_dispatch_queue_pending(wl_display* display, wl_event_queue* queue) {
+  fex_wl_setup_thread_event_batch();
+  int ret = fexfn_pack_wl_display_dispatch_queue_pending(display, queue);
+  fex_wl_drain_event_batch();
+  return ret;
+}
+
+extern "C" int wl_display_roundtrip(wl_display* display) {
+  fex_wl_setup_thread_event_batch();
+  int ret = fexfn_pack_wl_display_roundtrip(display);
+  fex_wl_drain_event_batch();
+  return ret;
+}
+
+extern "C" int wl_display_roundtrip_queue(wl_display* display, wl_event_queue* queue) {
+  fex_wl_setup_thread_event_batch();
+  int ret = fexfn_pack_wl_display_roundtrip_queue(display, queue);
+  fex_wl_drain_event_batch();
+  return ret;
+}
+
 // Adapted from the Wayland sources
 static const char* get_next_argument_type(const char *signature, char &type)
 {
@@ -304,7 +557,34 @@ extern "C" wl_proxy *wl_proxy_marshal_flags(wl_proxy *proxy, uint32_t opcode,
 #endif
 }
 
+extern "C" void wl_proxy_marshal_array(wl_proxy *proxy, uint32_t opcode, wl_argument *args) {
+  if (fex_wl_try_queue_surface_request(proxy, opcode, args)) {
+    return;
+  }
+  fexfn_pack_wl_proxy_marshal_array(proxy, opcode, args);
+}
+
+#if WAYLAND_VERSION_MAJOR * 10000 + WAYLAND_VERSION_MINOR * 100 + WAYLAND_VERSION_MICRO >= 11991
+extern "C" wl_proxy *wl_proxy_marshal_array_flags(wl_proxy *proxy, uint32_t opcode,
+           const wl_interface *interface,
+           uint32_t version,
+           uint32_t flags, wl_argument *args) {
+  // Constructor and lifetime-affecting requests pass an interface or flags
+  // and always cross immediately
+  if (!interface && !flags && fex_wl_try_queue_surface_request(proxy, opcode, args)) {
+    return nullptr;
+  }
+  return fexfn_pack_wl_proxy_marshal_array_flags(proxy, opcode, interface, version, flags, args);
+}
+#endif
+
 void OnInit() {
+#ifndef IS_32BIT_THUNK
+  // The batch records store raw 64-bit pointers, keep batching off on 32-bit
+  batch_events_enabled = getenv("FEX_WAYLAND_EVENT_BATCHING") != nullptr;
+  request_batching_enabled = getenv("FEX_WAYLAND_REQUEST_BATCHING") != nullptr;
+#endif
+
   fex_wl_exchange_interface_pointer(const_cast<wl_interface*>(&wl_output_interface), "wl_output");
   fex_wl_exchange_interface_pointer(const_cast<wl_interface*>(&wl_shm_pool_interface), "wl_shm_pool");
   fex_wl_exchange_interface_pointer(const_cast<wl_interface*>(&wl_pointer_interface), "wl_pointer");
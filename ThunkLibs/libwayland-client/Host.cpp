@@ -20,9 +20,13 @@ $end_info$
 #include <cstring>
 #include <map>
 #include <string>
+#include <utility>
 
 #include "thunkgen_host_libwayland-client.inl"
 
+#include "WaylandEventBatch.h"
+#include "WaylandRequestBatch.h"
+
 struct wl_proxy_private {
   wl_interface* interface;
   // Other data members omitted
@@ -39,8 +43,118 @@ template<> struct ArgType<'a'> { using type = wl_array*; };
 template<> struct ArgType<'f'> { using type = wl_fixed_t; };
 template<> struct ArgType<'h'> { using type = int32_t; }; // fd?
 
+// Batched event delivery (see WaylandEventBatch.h). The guest registers a
+// batch per dispatching thread through fex_wl_setup_event_batching; the
+// pointer stays null when batching is disabled.
+static thread_local fex_wl_event_batch* EventBatch {};
+static void (*GuestEventDrain)() {};
+
+static void FlushEventBatch() {
+  if (!EventBatch->num_records) {
+    return;
+  }
+  // The guest consumes every record and resets the batch before returning
+  GuestEventDrain();
+}
+
+static void* AllocateFromEventArena(size_t size) {
+  auto* batch = EventBatch;
+  // Keep payloads naturally aligned for wl_array
+  batch->arena_used = (batch->arena_used + 7) & ~uint32_t { 7 };
+  if (batch->arena_used + size > FEX_WL_EVENT_ARENA_SIZE) {
+    fprintf(stderr, "Wayland event payload of %zu bytes does not fit the event batch arena\n", size);
+    std::abort();
+  }
+  auto* alloc = batch->arena + batch->arena_used;
+  batch->arena_used += size;
+  return alloc;
+}
+
+static uint64_t PackEventArg(uint32_t value) {
+  return value;
+}
+
+static uint64_t PackEventArg(int32_t value) {
+  return static_cast<uint32_t>(value);
+}
+
+static uint64_t PackEventArg(wl_proxy* proxy) {
+  return reinterpret_cast<uintptr_t>(proxy);
+}
+
+static uint64_t PackEventArg(const char* str) {
+  if (!str) {
+    return 0;
+  }
+  auto size = strlen(str) + 1;
+  auto* copy = AllocateFromEventArena(size);
+  memcpy(copy, str, size);
+  return reinterpret_cast<uintptr_t>(copy);
+}
+
+static uint64_t PackEventArg(wl_array* array) {
+  if (!array) {
+    return 0;
+  }
+  auto* copy = static_cast<wl_array*>(AllocateFromEventArena(sizeof(wl_array) + array->size));
+  copy->size = array->size;
+  copy->alloc = array->size;
+  copy->data = copy + 1;
+  memcpy(copy->data, array->data, array->size);
+  return reinterpret_cast<uintptr_t>(copy);
+}
+
+// Registered with the host wayland library in place of the guest listener
+// callback. Appends the event to the current thread's batch instead of
+// crossing into the guest.
+template<uint32_t Index, char... Signature>
+static void RecordGuestEvent(void* data, wl_proxy* proxy, typename ArgType<Signature>::type... args) {
+  static_assert(sizeof...(Signature) <= FEX_WL_EVENT_MAX_ARGS);
+
+  auto* batch = EventBatch;
+  if (batch->num_records == FEX_WL_EVENT_BATCH_CAPACITY ||
+      batch->arena_used > FEX_WL_EVENT_ARENA_SIZE - FEX_WL_EVENT_MAX_PAYLOAD) {
+    FlushEventBatch();
+  }
+
+  auto& record = batch->records[batch->num_records];
+  record.proxy = proxy;
+  record.data = data;
+  record.event_index = Index;
+  record.num_args = sizeof...(Signature);
+  [[maybe_unused]] uint32_t arg_index = 0;
+  ((record.args[arg_index++] = PackEventArg(args)), ...);
+  batch->num_records++;
+
+  // 'n' arguments carry a freshly created proxy. Deliver immediately so the
+  // guest can register its listener before the host dispatches any of the new
+  // proxy's events.
+  if constexpr (((Signature == 'n') || ...)) {
+    FlushEventBatch();
+  }
+}
+
+template<char... Signature, uint32_t... Index>
+static std::array<void*, FEX_WL_MAX_INTERFACE_EVENTS> MakeEventRecorderTable(std::integer_sequence<uint32_t, Index...>) {
+  return {{reinterpret_cast<void*>(RecordGuestEvent<Index, Signature...>)...}};
+}
+
 template<char... Signature>
-static void WaylandFinalizeHostTrampolineForGuestListener(void (*callback)()) {
+static void WaylandSetupHostEventHandler(guest_layout<void (**)(void)> callback_table, int index) {
+  if (EventBatch) {
+    // Batched delivery: route the event to a host-side recorder. The guest
+    // kept the original callback and invokes it itself while draining the
+    // batch, so no per-event trampoline is needed.
+    if (index >= FEX_WL_MAX_INTERFACE_EVENTS) {
+      fprintf(stderr, "Wayland interface has more events than the batch recorder table supports\n");
+      std::abort();
+    }
+    static auto RecorderTable = MakeEventRecorderTable<Signature...>(std::make_integer_sequence<uint32_t, FEX_WL_MAX_INTERFACE_EVENTS> {});
+    callback_table.get_pointer()[index].data = reinterpret_cast<uintptr_t>(RecorderTable[index]);
+    return;
+  }
+
+  auto callback = reinterpret_cast<void (*)()>(uintptr_t { callback_table.get_pointer()[index].data });
   using cb = void(void*, wl_proxy*, typename ArgType<Signature>::type...);
   FinalizeHostTrampolineForGuestFunction((cb*)callback);
 }
@@ -60,101 +174,99 @@ extern "C" int fexfn_impl_libwayland_client_wl_proxy_add_listener(struct wl_prox
     // ? just indicates that the argument may be null, so it doesn't change the signature
     signature.erase(std::remove(signature.begin(), signature.end(), '?'), signature.end());
 
-    auto callback = reinterpret_cast<void(*)()>(uintptr_t { callback_raw.get_pointer()[i].data });
-
     if (signature == "") {
       // E.g. xdg_toplevel::close
-      WaylandFinalizeHostTrampolineForGuestListener<>(callback);
+      WaylandSetupHostEventHandler<>(callback_raw, i);
     } else if (signature == "a") {
       // E.g. xdg_toplevel::wm_capabilities
-      WaylandFinalizeHostTrampolineForGuestListener<'a'>(callback);
+      WaylandSetupHostEventHandler<'a'>(callback_raw, i);
     } else if (signature == "hu") {
       // E.g. zwp_linux_dmabuf_feedback_v1::format_table
-      WaylandFinalizeHostTrampolineForGuestListener<'h', 'u'>(callback);
+      WaylandSetupHostEventHandler<'h', 'u'>(callback_raw, i);
     } else if (signature == "i") {
       // E.g. wl_output_listener::scale
-      WaylandFinalizeHostTrampolineForGuestListener<'i'>(callback);
+      WaylandSetupHostEventHandler<'i'>(callback_raw, i);
     } else if (signature == "if") {
       // E.g. wl_touch_listener::orientation
-      WaylandFinalizeHostTrampolineForGuestListener<'i', 'f'>(callback);
+      WaylandSetupHostEventHandler<'i', 'f'>(callback_raw, i);
     } else if (signature == "iff") {
       // E.g. wl_touch_listener::shape
-      WaylandFinalizeHostTrampolineForGuestListener<'i', 'f', 'f'>(callback);
+      WaylandSetupHostEventHandler<'i', 'f', 'f'>(callback_raw, i);
     } else if (signature == "ii") {
       // E.g. xdg_toplevel::configure_bounds
-      WaylandFinalizeHostTrampolineForGuestListener<'i', 'i'>(callback);
+      WaylandSetupHostEventHandler<'i', 'i'>(callback_raw, i);
     } else if (signature == "iia") {
       // E.g. xdg_toplevel::configure
-      WaylandFinalizeHostTrampolineForGuestListener<'i', 'i', 'a'>(callback);
+      WaylandSetupHostEventHandler<'i', 'i', 'a'>(callback_raw, i);
     } else if (signature == "iiiiissi") {
       // E.g. wl_output_listener::geometry
-      WaylandFinalizeHostTrampolineForGuestListener<'i', 'i', 'i', 'i', 'i', 's', 's', 'i'>(callback);
+      WaylandSetupHostEventHandler<'i', 'i', 'i', 'i', 'i', 's', 's', 'i'>(callback_raw, i);
     } else if (signature == "n") {
       // E.g. wl_data_device_listener::data_offer
-      WaylandFinalizeHostTrampolineForGuestListener<'n'>(callback);
+      WaylandSetupHostEventHandler<'n'>(callback_raw, i);
     } else if (signature == "o") {
       // E.g. wl_data_device_listener::selection
-      WaylandFinalizeHostTrampolineForGuestListener<'o'>(callback);
+      WaylandSetupHostEventHandler<'o'>(callback_raw, i);
     } else if (signature == "u") {
       // E.g. wl_registry::global_remove
-      WaylandFinalizeHostTrampolineForGuestListener<'u'>(callback);
+      WaylandSetupHostEventHandler<'u'>(callback_raw, i);
     } else if (signature == "uff") {
       // E.g. wl_pointer_listener::motion
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'f', 'f'>(callback);
+      WaylandSetupHostEventHandler<'u', 'f', 'f'>(callback_raw, i);
     } else if (signature == "uhu") {
       // E.g. wl_keyboard_listener::keymap
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'h', 'u'>(callback);
+      WaylandSetupHostEventHandler<'u', 'h', 'u'>(callback_raw, i);
     } else if (signature == "ui") {
       // E.g. wl_pointer_listener::axis_discrete
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'i'>(callback);
+      WaylandSetupHostEventHandler<'u', 'i'>(callback_raw, i);
     } else if (signature == "uiff") {
       // E.g. wl_touch_listener::motion
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'i', 'f', 'f'>(callback);
+      WaylandSetupHostEventHandler<'u', 'i', 'f', 'f'>(callback_raw, i);
     } else if (signature == "uiii") {
       // E.g. wl_output_listener::mode
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'i', 'i', 'i'>(callback);
+      WaylandSetupHostEventHandler<'u', 'i', 'i', 'i'>(callback_raw, i);
     } else if (signature == "uo") {
       // E.g. wl_pointer_listener::leave
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'o'>(callback);
+      WaylandSetupHostEventHandler<'u', 'o'>(callback_raw, i);
     } else if (signature == "uoa") {
       // E.g. wl_keyboard_listener::enter
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'o', 'a'>(callback);
+      WaylandSetupHostEventHandler<'u', 'o', 'a'>(callback_raw, i);
     } else if (signature == "uoff") {
       // E.g. wl_pointer_listener::enter
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'o', 'f', 'f'>(callback);
+      WaylandSetupHostEventHandler<'u', 'o', 'f', 'f'>(callback_raw, i);
     } else if (signature == "uoffo") {
       // E.g. wl_data_device_listener::enter
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'o', 'f', 'f', 'o'>(callback);
+      WaylandSetupHostEventHandler<'u', 'o', 'f', 'f', 'o'>(callback_raw, i);
     } else if (signature == "usu") {
       // E.g. wl_registry::global
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 's', 'u'>(callback);
+      WaylandSetupHostEventHandler<'u', 's', 'u'>(callback_raw, i);
     } else if (signature == "uu") {
       // E.g. wl_pointer_listener::axis_stop
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u'>(callback_raw, i);
     } else if (signature == "uuf") {
       // E.g. wl_pointer_listener::axis
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u', 'f'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u', 'f'>(callback_raw, i);
     } else if (signature == "uui") {
       // E.g. wl_touch_listener::up
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u', 'i'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u', 'i'>(callback_raw, i);
     } else if (signature == "uuoiff") {
       // E.g. wl_touch_listener::down
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u', 'o', 'i', 'f', 'f'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u', 'o', 'i', 'f', 'f'>(callback_raw, i);
     } else if (signature == "uuu") {
       // E.g. zwp_linux_dmabuf_v1::modifier
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u', 'u'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u', 'u'>(callback_raw, i);
     } else if (signature == "uuuu") {
       // E.g. wl_pointer_listener::button
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u', 'u', 'u'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u', 'u', 'u'>(callback_raw, i);
     } else if (signature == "uuuuu") {
       // E.g. wl_keyboard_listener::modifiers
-      WaylandFinalizeHostTrampolineForGuestListener<'u', 'u', 'u', 'u', 'u'>(callback);
+      WaylandSetupHostEventHandler<'u', 'u', 'u', 'u', 'u'>(callback_raw, i);
     } else if (signature == "s") {
       // E.g. wl_seat::name
-      WaylandFinalizeHostTrampolineForGuestListener<'s'>(callback);
+      WaylandSetupHostEventHandler<'s'>(callback_raw, i);
     } else if (signature == "sii") {
       // E.g. zwp_text_input_v3::preedit_string
-      WaylandFinalizeHostTrampolineForGuestListener<'s', 'i', 'i'>(callback);
+      WaylandSetupHostEventHandler<'s', 'i', 'i'>(callback_raw, i);
     } else {
       fprintf(stderr, "TODO: Unknown wayland event signature descriptor %s\n", signature.data());
       std::abort();
@@ -197,4 +309,83 @@ wl_interface* fexfn_impl_libwayland_client_fex_wl_exchange_interface_pointer(wl_
   return host_interface;
 }
 
+// Replays a surface's coalesced state requests (see WaylandRequestBatch.h).
+// Damage rectangles are merged into one bounding rectangle per coordinate
+// space so a surface damaged in many small regions submits a single damage
+// request per frame.
+void fexfn_impl_libwayland_client_fex_wl_surface_commit_batch(wl_proxy* surface, fex_wl_request_batch* batch, uint32_t commit) {
+#ifdef IS_32BIT_THUNK
+  // The batch records store raw 64-bit values, so the guest never enables batching on 32-bit
+  std::abort();
+#else
+  struct DamageBounds {
+    int64_t x1, y1, x2, y2;
+    bool valid = false;
+
+    void Merge(const fex_wl_request_record& record) {
+      auto x = int64_t { static_cast<int32_t>(record.args[0]) };
+      auto y = int64_t { static_cast<int32_t>(record.args[1]) };
+      // Apps commonly damage (0, 0, INT32_MAX, INT32_MAX) for "everything",
+      // so extents are tracked in 64-bit and clamped on submission
+      auto max_x = x + static_cast<int32_t>(record.args[2]);
+      auto max_y = y + static_cast<int32_t>(record.args[3]);
+      if (!valid) {
+        x1 = x; y1 = y; x2 = max_x; y2 = max_y;
+        valid = true;
+      } else {
+        x1 = std::min(x1, x); y1 = std::min(y1, y);
+        x2 = std::max(x2, max_x); y2 = std::max(y2, max_y);
+      }
+    }
+  } surface_damage, buffer_damage;
+
+  wl_argument args[FEX_WL_REQUEST_MAX_ARGS] {};
+  for (uint32_t i = 0; i < batch->num_records; ++i) {
+    auto& record = batch->records[i];
+    if (record.opcode == FEX_WL_SURFACE_DAMAGE) {
+      surface_damage.Merge(record);
+      continue;
+    }
+    if (record.opcode == FEX_WL_SURFACE_DAMAGE_BUFFER) {
+      buffer_damage.Merge(record);
+      continue;
+    }
+    memcpy(args, record.args, record.num_args * sizeof(record.args[0]));
+    fexldr_ptr_libwayland_client_wl_proxy_marshal_array(surface, record.opcode, args);
+  }
+
+  auto EmitDamage = [&](uint32_t opcode, const DamageBounds& bounds) {
+    if (!bounds.valid) {
+      return;
+    }
+    args[0].i = static_cast<int32_t>(bounds.x1);
+    args[1].i = static_cast<int32_t>(bounds.y1);
+    args[2].i = static_cast<int32_t>(std::min(bounds.x2 - bounds.x1, int64_t { INT32_MAX }));
+    args[3].i = static_cast<int32_t>(std::min(bounds.y2 - bounds.y1, int64_t { INT32_MAX }));
+    fexldr_ptr_libwayland_client_wl_proxy_marshal_array(surface, opcode, args);
+  };
+  EmitDamage(FEX_WL_SURFACE_DAMAGE, surface_damage);
+  EmitDamage(FEX_WL_SURFACE_DAMAGE_BUFFER, buffer_damage);
+
+  if (commit) {
+    fexldr_ptr_libwayland_client_wl_proxy_marshal_array(surface, FEX_WL_SURFACE_COMMIT, args);
+  }
+  batch->num_records = 0;
+#endif
+}
+
+void fexfn_impl_libwayland_client_fex_wl_setup_event_batching(fex_wl_event_batch* batch, guest_layout<void (*)()> drain) {
+#ifdef IS_32BIT_THUNK
+  // The batch records store raw 64-bit pointers, so the guest never enables batching on 32-bit
+  std::abort();
+#else
+  // Every thread passes the same guest drain function. Finalizing it
+  // repeatedly is harmless, the same happens when a guest listener callback
+  // is registered on multiple proxies.
+  FinalizeHostTrampolineForGuestFunction(drain);
+  GuestEventDrain = reinterpret_cast<void (*)()>(uintptr_t { drain.data });
+  EventBatch = batch;
+#endif
+}
+
 EXPORTS(libwayland_client)
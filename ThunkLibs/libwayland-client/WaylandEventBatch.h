@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+
+struct wl_proxy;
+
+// Shared between the guest and host sides of the wayland-client thunk for
+// batched event delivery. Instead of crossing into the guest once per listener
+// callback, the host records events into a per-thread batch and the guest
+// drains the whole batch after the dispatching call returns.
+//
+// Both sides see the same address space on 64-bit, so records store raw
+// pointers. Transient event payloads (strings and arrays) are only valid for
+// the duration of the host-side dispatch, so the host copies them into the
+// arena to keep them alive until the guest drains the batch.
+
+// Upper bound on events per interface. Must cover every interface the guest
+// registers listeners for; wl_pointer is the current record holder at 11.
+#define FEX_WL_MAX_INTERFACE_EVENTS 32
+
+// Largest known event signature is wl_output::geometry with 8 arguments
+#define FEX_WL_EVENT_MAX_ARGS 8
+
+#define FEX_WL_EVENT_BATCH_CAPACITY 128
+#define FEX_WL_EVENT_ARENA_SIZE (64 * 1024)
+
+// Payload space a single record may use. The host flushes the batch once the
+// arena crosses this headroom boundary, so a record never straddles a flush.
+#define FEX_WL_EVENT_MAX_PAYLOAD (16 * 1024)
+
+struct fex_wl_event_record {
+  wl_proxy* proxy;
+  // User data registered through wl_proxy_add_listener
+  void* data;
+  uint32_t event_index;
+  uint32_t num_args;
+  // Argument values in event order. 'u'/'i'/'f'/'h' arguments store the value
+  // itself, 'o'/'n' the proxy pointer, 's' and 'a' a pointer into the arena
+  // (or null for nullable arguments).
+  uint64_t args[FEX_WL_EVENT_MAX_ARGS];
+};
+
+struct fex_wl_event_batch {
+  uint32_t num_records;
+  // Next record to be consumed by the guest. Kept in the shared batch so that
+  // nested dispatches continue where the interrupted drain left off.
+  uint32_t drain_cursor;
+  uint32_t arena_used;
+  fex_wl_event_record records[FEX_WL_EVENT_BATCH_CAPACITY];
+  char arena[FEX_WL_EVENT_ARENA_SIZE];
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+
+// Shared between the guest and host sides of the wayland-client thunk for
+// coalesced request submission. wl_surface state requests are double-buffered
+// by the protocol and only take effect at commit, so instead of crossing into
+// the host once per request the guest records them per surface and submits the
+// whole frame's worth of state in a single crossing together with the commit.
+// The host additionally merges damage rectangles into one bounding rectangle
+// per coordinate space before replaying.
+//
+// Both sides see the same address space on 64-bit, so records store raw
+// argument values. Batchable requests only carry 'i'/'u'/'o' arguments, so no
+// payload copying is needed.
+
+#define FEX_WL_REQUEST_BATCH_CAPACITY 64
+
+// wl_surface.damage is the widest batchable request at 4 arguments
+#define FEX_WL_REQUEST_MAX_ARGS 4
+
+// wl_surface request opcodes. The core protocol is frozen, so these are stable.
+#define FEX_WL_SURFACE_ATTACH 1
+#define FEX_WL_SURFACE_DAMAGE 2
+#define FEX_WL_SURFACE_COMMIT 6
+#define FEX_WL_SURFACE_SET_BUFFER_TRANSFORM 7
+#define FEX_WL_SURFACE_SET_BUFFER_SCALE 8
+#define FEX_WL_SURFACE_DAMAGE_BUFFER 9
+#define FEX_WL_SURFACE_OFFSET 10
+
+struct fex_wl_request_record {
+  uint32_t opcode;
+  uint32_t num_args;
+  // Raw wl_argument values in request order
+  uint64_t args[FEX_WL_REQUEST_MAX_ARGS];
+};
+
+struct fex_wl_request_batch {
+  uint32_t num_records;
+  fex_wl_request_record records[FEX_WL_REQUEST_BATCH_CAPACITY];
+};
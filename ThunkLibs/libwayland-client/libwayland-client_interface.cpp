@@ -30,16 +30,16 @@ template<> struct fex_gen_config<wl_display_cancel_read> {};
 template<> struct fex_gen_config<wl_display_connect> {};
 template<> struct fex_gen_config<wl_display_create_queue> {};
 template<> struct fex_gen_config<wl_display_disconnect> {};
-template<> struct fex_gen_config<wl_display_dispatch> {};
-template<> struct fex_gen_config<wl_display_dispatch_pending> {};
-template<> struct fex_gen_config<wl_display_dispatch_queue> {};
-template<> struct fex_gen_config<wl_display_dispatch_queue_pending> {};
+template<> struct fex_gen_config<wl_display_dispatch> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<wl_display_dispatch_pending> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<wl_display_dispatch_queue> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<wl_display_dispatch_queue_pending> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<wl_display_flush> {};
 template<> struct fex_gen_config<wl_display_prepare_read> {};
 template<> struct fex_gen_config<wl_display_prepare_read_queue> {};
 template<> struct fex_gen_config<wl_display_read_events> {};
-template<> struct fex_gen_config<wl_display_roundtrip> {};
-template<> struct fex_gen_config<wl_display_roundtrip_queue> {};
+template<> struct fex_gen_config<wl_display_roundtrip> : fexgen::custom_guest_entrypoint {};
+template<> struct fex_gen_config<wl_display_roundtrip_queue> : fexgen::custom_guest_entrypoint {};
 template<> struct fex_gen_config<wl_display_get_fd> {};
 
 template<> struct fex_gen_config<wl_event_queue_destroy> {};
@@ -60,12 +60,28 @@ template<> struct fex_gen_config<wl_proxy_set_tag> {};
 template<> struct fex_gen_config<wl_proxy_set_user_data> {};
 template<> struct fex_gen_config<wl_proxy_wrapper_destroy> {};
 
-template<> struct fex_gen_config<wl_proxy_marshal_array> {};
+template<> struct fex_gen_config<wl_proxy_marshal_array> : fexgen::custom_guest_entrypoint {};
 // wl_proxy_marshal_array_flags is only available starting from Wayland 1.19.91
 #if WAYLAND_VERSION_MAJOR * 10000 + WAYLAND_VERSION_MINOR * 100 + WAYLAND_VERSION_MICRO >= 11991
-template<> struct fex_gen_config<wl_proxy_marshal_array_flags> {};
+template<> struct fex_gen_config<wl_proxy_marshal_array_flags> : fexgen::custom_guest_entrypoint {};
 #endif
 
 // Guest notifies host about its interface. Host returns its corresponding interface pointer
 wl_interface* fex_wl_exchange_interface_pointer(wl_interface*, const char* name);
 template<> struct fex_gen_config<fex_wl_exchange_interface_pointer> : fexgen::custom_host_impl {};
+
+// Guest registers a per-thread event batch and the trampoline used to drain
+// it for batched listener event delivery (see WaylandEventBatch.h)
+struct fex_wl_event_batch;
+template<> struct fex_gen_type<fex_wl_event_batch> : fexgen::opaque_type {};
+void fex_wl_setup_event_batching(fex_wl_event_batch*, void (*)());
+template<> struct fex_gen_config<fex_wl_setup_event_batching> : fexgen::custom_host_impl {};
+// Drain trampoline allocated by the guest, finalized on the host side
+template<> struct fex_gen_param<fex_wl_setup_event_batching, 1, void (*)()> : fexgen::ptr_passthrough {};
+
+// Guest submits a surface's coalesced double-buffered state requests in a
+// single crossing, optionally followed by the commit (see WaylandRequestBatch.h)
+struct fex_wl_request_batch;
+template<> struct fex_gen_type<fex_wl_request_batch> : fexgen::opaque_type {};
+void fex_wl_surface_commit_batch(wl_proxy*, fex_wl_request_batch*, uint32_t commit);
+template<> struct fex_gen_config<fex_wl_surface_commit_batch> : fexgen::custom_host_impl {};
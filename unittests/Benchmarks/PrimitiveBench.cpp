@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: MIT
+#include "DummyHandlers.h"
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/File.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/fextl/fmt.h>
+#include <FEXCore/fextl/string.h>
+#include <FEXCore/fextl/vector.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+// Microbenchmarks for FEXCore's compilation primitives.
+//
+// Measures block compile latency, hot code cache lookup and SMC invalidation
+// cost through the public Context API, using the same dummy handler setup as
+// CodeSizeValidation. Results are printed as JSON so CI can archive them and
+// diff across releases.
+//
+// Guest execution round-trips (dispatcher entry/exit, syscall trampolines,
+// thunk crossings) need a real guest environment with signal delegation and a
+// Linux syscall handler - those are measured from inside the guest with
+// FEXLinuxTests style binaries, not from this harness.
+
+namespace {
+void MsgHandler(LogMan::DebugLevels Level, char const *Message) {
+  // Only errors are interesting while benchmarking.
+  if (Level == LogMan::ERROR || Level == LogMan::ASSERT) {
+    fextl::fmt::print("[{}] {}\n", LogMan::DebugLevelStr(Level), Message);
+  }
+}
+
+void AssertHandler(char const *Message) {
+  fextl::fmt::print("[ASSERT] {}\n", Message);
+
+  // make sure buffers are flushed
+  fflush(nullptr);
+}
+
+struct BenchResult {
+  fextl::string Name;
+  uint64_t Iterations;
+  double MeanNanoseconds;
+};
+
+fextl::vector<BenchResult> Results{};
+
+uint64_t TimeNS(auto Body) {
+  auto Begin = std::chrono::steady_clock::now();
+  Body();
+  auto End = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(End - Begin).count();
+}
+
+// Number of distinct guest blocks generated for the compile benchmarks.
+constexpr size_t NumBlocks = 512;
+// Guest instructions per generated block, excluding the terminating ret.
+constexpr size_t InstructionsPerBlock = 16;
+// Encoded size of one `add rax, imm32`.
+constexpr size_t AddInstSize = 6;
+constexpr size_t BlockStride = InstructionsPerBlock * AddInstSize + 1;
+
+// Fills the buffer with NumBlocks runs of `add rax, imm32` terminated by ret.
+// Each block gets unique immediates so the compiled output can't alias.
+void GenerateGuestCode(fextl::vector<uint8_t> &Code) {
+  Code.resize(NumBlocks * BlockStride);
+  uint8_t *Cursor = Code.data();
+  for (size_t Block = 0; Block < NumBlocks; ++Block) {
+    for (size_t Inst = 0; Inst < InstructionsPerBlock; ++Inst) {
+      const uint32_t Immediate = static_cast<uint32_t>(Block * InstructionsPerBlock + Inst);
+      *Cursor++ = 0x48; // REX.W
+      *Cursor++ = 0x05; // add rax, imm32
+      memcpy(Cursor, &Immediate, sizeof(Immediate));
+      Cursor += sizeof(Immediate);
+    }
+    *Cursor++ = 0xC3; // ret
+  }
+}
+
+void BenchBlockCompile(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, const fextl::vector<uint8_t> &Code) {
+  // Warm one pass so allocator pools and lookup tables are primed, then
+  // measure cold compiles from an empty code cache.
+  for (size_t Block = 0; Block < NumBlocks; ++Block) {
+    CTX->CompileRIP(Thread, reinterpret_cast<uint64_t>(&Code[Block * BlockStride]));
+  }
+  CTX->ClearCodeCache(Thread);
+
+  const uint64_t Elapsed = TimeNS([&]() {
+    for (size_t Block = 0; Block < NumBlocks; ++Block) {
+      CTX->CompileRIP(Thread, reinterpret_cast<uint64_t>(&Code[Block * BlockStride]));
+    }
+  });
+
+  Results.emplace_back(BenchResult {
+    .Name = "BlockCompile",
+    .Iterations = NumBlocks,
+    .MeanNanoseconds = static_cast<double>(Elapsed) / NumBlocks,
+  });
+}
+
+void BenchCodeCacheLookup(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, const fextl::vector<uint8_t> &Code) {
+  // Every block is already compiled, so this exercises the lookup cache hit
+  // path that CompileRIP takes before falling back to a fresh compile.
+  constexpr size_t Passes = 64;
+  const uint64_t Elapsed = TimeNS([&]() {
+    for (size_t Pass = 0; Pass < Passes; ++Pass) {
+      for (size_t Block = 0; Block < NumBlocks; ++Block) {
+        CTX->CompileRIP(Thread, reinterpret_cast<uint64_t>(&Code[Block * BlockStride]));
+      }
+    }
+  });
+
+  Results.emplace_back(BenchResult {
+    .Name = "CodeCacheLookup",
+    .Iterations = Passes * NumBlocks,
+    .MeanNanoseconds = static_cast<double>(Elapsed) / (Passes * NumBlocks),
+  });
+}
+
+void BenchSMCInvalidation(FEXCore::Context::Context *CTX, FEXCore::Core::InternalThreadState *Thread, const fextl::vector<uint8_t> &Code) {
+  // Invalidate the full compiled range block by block - the pattern a guest
+  // JIT rewriting its own code produces - then recompile for the next rep.
+  constexpr size_t Reps = 8;
+  uint64_t Elapsed{};
+  for (size_t Rep = 0; Rep < Reps; ++Rep) {
+    for (size_t Block = 0; Block < NumBlocks; ++Block) {
+      CTX->CompileRIP(Thread, reinterpret_cast<uint64_t>(&Code[Block * BlockStride]));
+    }
+    Elapsed += TimeNS([&]() {
+      for (size_t Block = 0; Block < NumBlocks; ++Block) {
+        CTX->InvalidateGuestCodeRange(Thread, reinterpret_cast<uint64_t>(&Code[Block * BlockStride]), BlockStride);
+      }
+    });
+  }
+
+  Results.emplace_back(BenchResult {
+    .Name = "SMCInvalidation",
+    .Iterations = Reps * NumBlocks,
+    .MeanNanoseconds = static_cast<double>(Elapsed) / (Reps * NumBlocks),
+  });
+}
+
+bool WriteResults(const char *Path) {
+  FEXCore::File::File FD(Path, FEXCore::File::FileModes::WRITE | FEXCore::File::FileModes::CREATE | FEXCore::File::FileModes::TRUNCATE);
+  if (!FD.IsValid()) {
+    LogMan::Msg::EFmt("Couldn't open {} for benchmark results", Path);
+    return false;
+  }
+
+  FD.Write("{\n\t\"benchmarks\": [\n", strlen("{\n\t\"benchmarks\": [\n"));
+  for (auto it = Results.begin(); it != Results.end(); ++it) {
+    FD.Write(fextl::fmt::format("\t\t{{ \"name\": \"{}\", \"iterations\": {}, \"mean_ns\": {:.1f} }}{}\n",
+                                it->Name, it->Iterations, it->MeanNanoseconds,
+                                it + 1 != Results.end() ? "," : ""));
+  }
+  FD.Write("\t]\n}\n", strlen("\t]\n}\n"));
+  return true;
+}
+}
+
+int main(int argc, char **argv, char **const envp) {
+  FEXCore::Allocator::GLIBCScopedFault GLIBFaultScope;
+  LogMan::Throw::InstallHandler(AssertHandler);
+  LogMan::Msg::InstallHandler(MsgHandler);
+  FEXCore::Config::Initialize();
+  FEXCore::Config::Load();
+
+  // Setup configurations that this tool needs
+  // IRJIT. Only works on JITs.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_CORE, fextl::fmt::format("{}", static_cast<uint64_t>(FEXCore::Config::CONFIG_IRJIT)));
+  // The generated code is 64-bit only.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_IS64BIT_MODE, "1");
+  // Disable telemetry, it adds variance.
+  FEXCore::Config::EraseSet(FEXCore::Config::CONFIG_DISABLETELEMETRY, "1");
+
+  // Initialize static tables.
+  FEXCore::Context::InitializeStaticTables(FEXCore::Context::MODE_64BIT);
+
+  // Create FEXCore context.
+  auto CTX = FEXCore::Context::Context::CreateNewContext();
+
+  auto SignalDelegation = FEX::DummyHandlers::CreateSignalDelegator();
+  auto SyscallHandler = FEX::DummyHandlers::CreateSyscallHandler();
+
+  CTX->SetSignalDelegator(SignalDelegation.get());
+  CTX->SetSyscallHandler(SyscallHandler.get());
+  if (!CTX->InitCore()) {
+    return -1;
+  }
+  auto ParentThread = CTX->CreateThread(0, 0);
+
+  fextl::vector<uint8_t> Code{};
+  GenerateGuestCode(Code);
+
+  BenchBlockCompile(CTX.get(), ParentThread, Code);
+  BenchCodeCacheLookup(CTX.get(), ParentThread, Code);
+  BenchSMCInvalidation(CTX.get(), ParentThread, Code);
+
+  for (auto const &Result : Results) {
+    fextl::fmt::print("{}: {:.1f}ns mean over {} iterations\n", Result.Name, Result.MeanNanoseconds, Result.Iterations);
+  }
+
+  int ExitCode = 0;
+  if (argc >= 2) {
+    ExitCode = WriteResults(argv[1]) ? 0 : 1;
+  }
+
+  CTX->DestroyThread(ParentThread);
+  return ExitCode;
+}